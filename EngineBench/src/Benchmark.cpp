@@ -0,0 +1,176 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#include "EngineCore/Core/JsonWriter.hpp"
+
+namespace Bench {
+
+	using Clock = std::chrono::steady_clock;
+
+	/// Верхняя граница итераций: защищает от замеров, которые оптимизатор свёл к нулю.
+	static constexpr uint64_t MaxIterations = uint64_t(1) << 32;
+
+	static double measureNs(const BenchmarkFunc& func, const uint64_t iterations) {
+		const Clock::time_point start = Clock::now();
+		func(iterations);
+		return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+	}
+
+	void BenchmarkContext::setCounter(const std::string& name, const double value) {
+		for (auto& counter : m_counters) {
+			if (counter.first == name) {
+				counter.second = value;
+				return;
+			}
+		}
+		m_counters.emplace_back(name, value);
+	}
+
+	void BenchmarkRunner::add(std::string name, BenchmarkFunc func, std::function<void()> afterRepetition) {
+		m_cases.push_back({ std::move(name), std::move(func), {}, std::move(afterRepetition) });
+	}
+
+	void BenchmarkRunner::addWithSetup(std::string name, BenchmarkSetup setup, std::function<void()> afterRepetition) {
+		m_cases.push_back({ std::move(name), {}, std::move(setup), std::move(afterRepetition) });
+	}
+
+	std::vector<BenchmarkResult> BenchmarkRunner::run(const BenchmarkParams& params) const {
+		std::vector<BenchmarkResult> results;
+		const double minRepetitionNs = static_cast<double>(params.minRepetitionMs) * 1e6;
+
+		std::printf("%-44s %12s %12s %12s %10s %7s\n", "Benchmark", "Median ns", "Mean ns", "Min ns", "Iterations", "CV");
+		for (const Case& benchmarkCase : m_cases) {
+			if (!params.filter.empty() && benchmarkCase.name.find(params.filter) == std::string::npos) {
+				continue;
+			}
+
+			// Подготовка не измеряется; данные живут до конца замера вместе с `func`.
+			BenchmarkContext context;
+			const BenchmarkFunc func = benchmarkCase.setup ? benchmarkCase.setup(context) : benchmarkCase.func;
+
+			// Калибровка: итерации растут, пока замер не станет достаточно длинным.
+			uint64_t iterations = 1;
+			for (;;) {
+				const double elapsedNs = measureNs(func, iterations);
+				if (benchmarkCase.afterRepetition) {
+					benchmarkCase.afterRepetition();
+				}
+				if (elapsedNs >= minRepetitionNs || iterations >= MaxIterations) {
+					break;
+				}
+				const double scale = elapsedNs > 0.0 ? minRepetitionNs * 1.2 / elapsedNs : 100.0;
+				iterations = std::min(MaxIterations, static_cast<uint64_t>(static_cast<double>(iterations) * std::clamp(scale, 2.0, 100.0)));
+			}
+
+			for (uint32_t i = 0; i < params.warmupRepetitions; ++i) {
+				measureNs(func, iterations);
+				if (benchmarkCase.afterRepetition) {
+					benchmarkCase.afterRepetition();
+				}
+			}
+
+			std::vector<double> samples;
+			samples.reserve(params.repetitions);
+			for (uint32_t i = 0; i < std::max<uint32_t>(params.repetitions, 1); ++i) {
+				samples.push_back(measureNs(func, iterations) / static_cast<double>(iterations));
+				if (benchmarkCase.afterRepetition) {
+					benchmarkCase.afterRepetition();
+				}
+			}
+
+			BenchmarkResult result;
+			result.name = benchmarkCase.name;
+			result.iterations = iterations;
+			result.repetitions = static_cast<uint32_t>(samples.size());
+			result.itemsPerIteration = context.m_itemsPerIteration;
+			result.counters = context.m_counters;
+
+			double sum = 0.0;
+			for (const double sample : samples) {
+				sum += sample;
+			}
+			result.meanNs = sum / static_cast<double>(samples.size());
+			double variance = 0.0;
+			for (const double sample : samples) {
+				variance += (sample - result.meanNs) * (sample - result.meanNs);
+			}
+			result.stddevNs = samples.size() > 1 ? std::sqrt(variance / static_cast<double>(samples.size() - 1)) : 0.0;
+
+			std::sort(samples.begin(), samples.end());
+			const size_t middle = samples.size() / 2;
+			result.medianNs = samples.size() % 2 ? samples[middle] : (samples[middle - 1] + samples[middle]) * 0.5;
+			result.minNs = samples.front();
+			result.maxNs = samples.back();
+
+			std::printf(
+				"%-44s %12.2f %12.2f %12.2f %10llu %6.1f%%\n",
+				result.name.c_str(), result.medianNs, result.meanNs, result.minNs,
+				static_cast<unsigned long long>(result.iterations), result.getVariation() * 100.0
+			);
+			if (result.itemsPerIteration > 0.0) {
+				std::printf("    %.0f items per iteration, %.3f ms per 1M items\n", result.itemsPerIteration, result.getNsPerMillionItems() * 1e-6);
+			}
+			for (const auto& [counterName, value] : result.counters) {
+				std::printf("    %s: %.10g\n", counterName.c_str(), value);
+			}
+			results.push_back(std::move(result));
+		}
+		return results;
+	}
+
+	bool writeJson(
+		const std::string& path,
+		const std::vector<BenchmarkResult>& results,
+		const std::vector<std::pair<std::string, std::string>>& context
+	) {
+		std::ofstream file(path);
+		if (!file) {
+			std::fprintf(stderr, "Can not open %s for benchmark results\n", path.c_str());
+			return false;
+		}
+
+		Engine::JsonWriter json(file);
+		json.beginObject();
+		json.key("context").beginObject();
+		for (const auto& [key, value] : context) {
+			json.key(key).value(value);
+		}
+		json.endObject();
+
+		json.key("benchmarks").beginArray();
+		for (const BenchmarkResult& result : results) {
+			json.beginObject();
+			json.key("name").value(result.name);
+			json.key("iterations").value(result.iterations);
+			json.key("repetitions").value(result.repetitions);
+			json.key("medianNs").value(result.medianNs);
+			json.key("meanNs").value(result.meanNs);
+			json.key("stddevNs").value(result.stddevNs);
+			json.key("minNs").value(result.minNs);
+			json.key("maxNs").value(result.maxNs);
+			json.key("cv").value(result.getVariation());
+			if (result.itemsPerIteration > 0.0) {
+				json.key("itemsPerIteration").value(result.itemsPerIteration);
+				json.key("nsPerMillionItems").value(result.getNsPerMillionItems());
+			}
+			if (!result.counters.empty()) {
+				json.key("counters").beginObject();
+				for (const auto& [counterName, value] : result.counters) {
+					json.key(counterName).value(value);
+				}
+				json.endObject();
+			}
+			json.endObject();
+		}
+		json.endArray();
+		json.endObject();
+		file << '\n';
+		return true;
+	}
+
+} // namespace Bench
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Bench {
+
+	/// @brief Тело замера: выполняет измеряемую операцию `iterations` раз.
+	using BenchmarkFunc = std::function<void(uint64_t iterations)>;
+
+	/**
+	 * @brief Данные замера вне измеряемого времени: объём работы итерации и счётчики.
+	 *
+	 * Живёт, пока выполняется замер, поэтому тело может ссылаться на него.
+	 */
+	class BenchmarkContext {
+	public:
+		/// @brief Объём работы одной итерации (например, треугольников): к результату
+		/// добавляется время на миллион единиц.
+		void setItemsPerIteration(double items) noexcept { m_itemsPerIteration = items; }
+
+		/// @brief Задаёт величину, которая печатается под строкой замера и пишется в JSON.
+		void setCounter(const std::string& name, double value);
+
+	private:
+		friend class BenchmarkRunner;
+
+		double										m_itemsPerIteration	= 0.0;
+		std::vector<std::pair<std::string, double>>	m_counters;
+	};
+
+	/// @brief Подготовка замера: строит данные (не измеряется) и возвращает тело, которое ими владеет.
+	using BenchmarkSetup = std::function<BenchmarkFunc(BenchmarkContext& context)>;
+
+	/**
+	 * @brief Параметры запуска.
+	 */
+	struct BenchmarkParams {
+		uint32_t	repetitions			= 15;		///< Замеров на результат.
+		uint32_t	warmupRepetitions	= 2;		///< Прогревочных прогонов (не учитываются).
+		float		minRepetitionMs		= 25.f;		///< Минимальная длительность одного замера.
+		std::string	filter;							///< Подстрока имени, пусто - все.
+	};
+
+	/**
+	 * @brief Результат замера в наносекундах на одну операцию.
+	 */
+	struct BenchmarkResult {
+		std::string	name;
+		uint64_t	iterations		= 0;	///< Операций в одном замере.
+		uint32_t	repetitions		= 0;
+		double		meanNs			= 0.0;
+		double		medianNs		= 0.0;
+		double		stddevNs		= 0.0;
+		double		minNs			= 0.0;
+		double		maxNs			= 0.0;
+		double		itemsPerIteration	= 0.0;	///< 0 - не задан (см. `BenchmarkContext`).
+		std::vector<std::pair<std::string, double>>	counters;
+
+		/// @brief Медиана на миллион единиц работы (0, если объём итерации не задан).
+		double getNsPerMillionItems() const noexcept { return itemsPerIteration > 0.0 ? medianNs / itemsPerIteration * 1e6 : 0.0; }
+
+		/// @brief Коэффициент вариации: выше ~5% результат шумный.
+		double getVariation() const noexcept { return meanNs > 0.0 ? stddevNs / meanNs : 0.0; }
+	};
+
+	/**
+	 * @brief Набор замеров с калибровкой числа итераций и статистикой.
+	 *
+	 * Число итераций подбирается так, чтобы один замер длился не меньше
+	 * `minRepetitionMs` (погрешность таймера и планировщика становится малой),
+	 * затем после прогрева выполняется `repetitions` замеров с одинаковым
+	 * числом итераций. Сравнивать между коммитами следует медиану.
+	 *
+	 * Пример использования
+	 * @code
+	 * BenchmarkRunner runner;
+	 * runner.add("Math/Sqrt", [](uint64_t iterations) {
+	 * 	for (uint64_t i = 0; i < iterations; ++i) {
+	 * 		doNotOptimize(std::sqrt(static_cast<float>(i)));
+	 * 	}
+	 * });
+	 * runner.addWithSetup("Scene/Update", [](BenchmarkContext& context) -> BenchmarkFunc {
+	 * 	auto pScene = std::make_shared<Scene>(100000);	// не входит во время
+	 * 	context.setItemsPerIteration(100000);
+	 * 	return [pScene](uint64_t iterations) {
+	 * 		for (uint64_t i = 0; i < iterations; ++i) {
+	 * 			pScene->update();
+	 * 		}
+	 * 	};
+	 * });
+	 * const std::vector<BenchmarkResult> results = runner.run(params);
+	 * @endcode
+	 */
+	class BenchmarkRunner {
+	public:
+		/// @brief Добавляет замер.
+		/// @param afterRepetition Вызывается после каждого замера вне измеряемого
+		/// времени (например, `glFinish()`, чтобы очередь драйвера не росла).
+		void add(std::string name, BenchmarkFunc func, std::function<void()> afterRepetition = {});
+
+		/// @brief Добавляет замер с подготовкой: `setup` вызывается один раз перед калибровкой
+		/// вне измеряемого времени, данные освобождаются после замера. Тяжёлые данные
+		/// (сцены, пулы потоков, шейдеры) строятся здесь, а не в теле.
+		void addWithSetup(std::string name, BenchmarkSetup setup, std::function<void()> afterRepetition = {});
+
+		/// @brief Выполняет замеры, имя которых содержит `params.filter`, и печатает таблицу.
+		std::vector<BenchmarkResult> run(const BenchmarkParams& params) const;
+
+	private:
+		struct Case {
+			std::string				name;
+			BenchmarkFunc			func;
+			BenchmarkSetup			setup;
+			std::function<void()>	afterRepetition;
+		};
+
+		std::vector<Case>	m_cases;
+	};
+
+	/// @brief Записывает результаты и описание окружения в JSON.
+	/// @param context Пары ключ-значение (сборка, GPU, метка коммита).
+	bool writeJson(
+		const std::string& path,
+		const std::vector<BenchmarkResult>& results,
+		const std::vector<std::pair<std::string, std::string>>& context
+	);
+
+	/// @brief Не даёт компилятору удалить вычисление `value`.
+	template<typename T>
+	inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void* s_pSink;
+		s_pSink = &value;
+#endif
+	}
+
+	void registerCoreBenchmarks(BenchmarkRunner& runner);
+
+	/// @brief Добавляет замеры GL обёрток, если контекст OpenGL создан.
+	void registerGLBenchmarks(BenchmarkRunner& runner);
+
+	/// @brief Добавляет замеры упрощения мешей.
+	void registerMeshBenchmarks(BenchmarkRunner& runner);
+
+	/// @brief Добавляет замеры программного отсечения перекрытых объектов.
+	void registerOcclusionBenchmarks(BenchmarkRunner& runner);
+
+	/// @brief Добавляет замер декодирования небольшого PNG.
+	void registerImageBenchmarks(BenchmarkRunner& runner);
+
+	/// @brief Добавляет замеры частиц на CPU и, при наличии compute шейдеров, на GPU.
+	void registerParticleBenchmarks(BenchmarkRunner& runner, bool bHasGL);
+
+	/// @brief Добавляет замеры построения кластеров и кадра с 10-4000 источниками
+	/// (кластерное освещение против перебора всех источников).
+	void registerLightBenchmarks(BenchmarkRunner& runner, bool bHasGL);
+
+	/// @brief Добавляет замеры обновления иерархии из 500k узлов с 5% изменённых за кадр.
+	void registerSceneBenchmarks(BenchmarkRunner& runner);
+
+	/// @brief Добавляет замер кадра `SpriteBatch` из 200k спрайтов.
+	void registerSpriteBenchmarks(BenchmarkRunner& runner, bool bHasGL);
+
+	/// @brief Упрощает тор до нескольких целей без предела ошибки.
+	/// @return false, если результат не достиг цели или содержит вырожденные треугольники.
+	bool verifyMeshLod();
+
+	/// @brief Растеризует стену и проверяет боксы за ней, перед ней и рядом с ней.
+	/// @return false, если бокс за стеной не отсечён или видимый бокс отсечён.
+	bool verifyOcclusion();
+
+	/// @brief Декодирует PNG, JPEG и HDR с известными пикселями, файлы с огромными размерами
+	/// в заголовке, а также обрезанные и испорченные файлы.
+	/// @return false, если пиксели расходятся или файл с неверным заголовком декодирован.
+	bool verifyImageDecoders();
+
+	/// @brief Обновляет иерархию из 500k узлов несколько кадров и печатает время обновления.
+	/// @return false, если мировая матрица хотя бы одного узла не равна произведению матрицы родителя
+	/// на локальную или (в Release) медиана обновления больше 1 мс.
+	bool verifyTransformHierarchy();
+
+	/// @brief Компилирует и выполняет граф из пяти проходов: цепочка с совмещаемыми
+	/// временными текстурами, записью через image load/store и один ненужный проход.
+	/// @return false, если порядок, совмещение, барьеры или отброшенные проходы не те или нет OpenGL 4.2.
+	bool verifyFrameGraph();
+
+	/// @brief Рисует сцену с 10, 100 и 1000 источниками через кластеры и перебором всех источников.
+	/// @return false, если изображения отличаются хотя бы в одном пикселе или нет OpenGL 4.5.
+	bool verifyLights();
+
+	/// @brief Рисует кадры из 200k спрайтов с тремя кадрами в пути и печатает время CPU.
+	/// @return false, если `SpriteBatch` ждал GPU перед записью в часть кольца или нет OpenGL 4.6.
+	bool verifySprites();
+
+	/// @brief Сравнивает частицы GPU с `ParticleSimulatorCpu` после `steps` шагов.
+	/// @return false, если множества частиц или их значения расходятся или нет compute шейдеров.
+	bool verifyParticles(uint32_t steps);
+
+} // namespace Bench
@@ -0,0 +1,141 @@
+#include "Benchmark.hpp"
+
+#include <memory>
+
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/spdlog.h>
+
+#include "EngineCore/Event.hpp"
+#include "EngineCore/Log.hpp"
+#include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
+#include "EngineCore/Render/OpenGL/VertexLayout.hpp"
+
+namespace Bench {
+
+	/// Вершина меша в типичном квантованном формате.
+	struct MeshVertex {
+		float		position[3];
+		uint32_t	normal;
+		uint16_t	uv[2];
+	};
+
+} // namespace Bench
+
+namespace Engine {
+
+	template<>
+	struct VertexLayout<Bench::MeshVertex> {
+		static constexpr VertexAttribute attributes[] = {
+			ENGINE_VERTEX_ATTRIBUTE(Bench::MeshVertex, position,	ShaderDataType::Float3),
+			ENGINE_VERTEX_ATTRIBUTE(Bench::MeshVertex, normal,		ShaderDataType::SNorm10_10_10_2),
+			ENGINE_VERTEX_ATTRIBUTE(Bench::MeshVertex, uv,			ShaderDataType::UNorm16x2)
+		};
+	};
+
+} // namespace Engine
+
+namespace Bench {
+
+	using namespace Engine;
+
+	/// Логгер без вывода: замеряется форматирование и диспетчеризация, а не консоль.
+	static std::shared_ptr<spdlog::logger> createNullLogger(spdlog::level::level_enum level) {
+		auto pLogger = std::make_shared<spdlog::logger>("bench", std::make_shared<spdlog::sinks::null_sink_mt>());
+		pLogger->set_level(level);
+		return pLogger;
+	}
+
+	/// Подменяет логгер по умолчанию на время замера.
+	static BenchmarkFunc withLogger(spdlog::level::level_enum level, BenchmarkFunc func) {
+		return [level, func = std::move(func)](uint64_t iterations) {
+			const std::shared_ptr<spdlog::logger> pPrevious = spdlog::default_logger();
+			spdlog::set_default_logger(createNullLogger(level));
+			func(iterations);
+			spdlog::set_default_logger(pPrevious);
+		};
+	}
+
+	void registerCoreBenchmarks(BenchmarkRunner& runner) {
+		runner.add("BufferLayout/InitializerList", [](uint64_t iterations) {
+			for (uint64_t i = 0; i < iterations; ++i) {
+				BufferLayout layout {
+					ShaderDataType::Float3,
+					ShaderDataType::Float3,
+					ShaderDataType::Float2
+				};
+				doNotOptimize(layout.getStride());
+			}
+		});
+
+		runner.add("BufferLayout/VertexLayout", [](uint64_t iterations) {
+			for (uint64_t i = 0; i < iterations; ++i) {
+				doNotOptimize(getBufferLayout<MeshVertex>().getStride());
+			}
+		});
+
+		runner.add("BufferLayout/Compare", [](uint64_t iterations) {
+			const BufferLayout lhs { ShaderDataType::Float3, ShaderDataType::UNorm8x4, ShaderDataType::Float2 };
+			const BufferLayout rhs { ShaderDataType::Float3, ShaderDataType::UNorm8x4, ShaderDataType::Float2 };
+			for (uint64_t i = 0; i < iterations; ++i) {
+				doNotOptimize(lhs == rhs);
+			}
+		});
+
+		runner.add("EventDispatcher/AddListener", [](uint64_t iterations) {
+			EventDispatcher dispatcher;
+			for (uint64_t i = 0; i < iterations; ++i) {
+				dispatcher.addListener<EventMouseMove>([](EventMouseMove& event) {
+					doNotOptimize(event.x);
+				});
+			}
+		});
+
+		runner.add("EventDispatcher/Dispatch", [](uint64_t iterations) {
+			EventDispatcher dispatcher;
+			double sum = 0.0;
+			dispatcher.addListener<EventMouseMove>([&sum](EventMouseMove& event) {
+				sum += event.x;
+			});
+			EventMouseMove event(1.0, 2.0);
+			for (uint64_t i = 0; i < iterations; ++i) {
+				dispatcher.dispatch(event);
+			}
+			doNotOptimize(sum);
+		});
+
+		runner.add("EventDispatcher/DispatchNoListener", [](uint64_t iterations) {
+			EventDispatcher dispatcher;
+			EventWindowResize event(800, 600);
+			for (uint64_t i = 0; i < iterations; ++i) {
+				dispatcher.dispatch(event);
+			}
+		});
+
+		// В Release (NDEBUG) макросы пусты, и замеры показывают стоимость цикла.
+		runner.add("Log/InfoNullSink", withLogger(spdlog::level::trace, [](uint64_t iterations) {
+			for (uint64_t i = 0; i < iterations; ++i) {
+				LOG_INFO("[Event] mouse moved to {0}x{1}", 640.0, 480.0);
+			}
+		}));
+
+		runner.add("Log/WarnNullSink", withLogger(spdlog::level::trace, [](uint64_t iterations) {
+			for (uint64_t i = 0; i < iterations; ++i) {
+				LOG_WARN("Frame {0} took {1:.2f} ms", i, 16.7);
+			}
+		}));
+
+		runner.add("Log/InfoFilteredOut", withLogger(spdlog::level::err, [](uint64_t iterations) {
+			for (uint64_t i = 0; i < iterations; ++i) {
+				LOG_INFO("[Event] mouse moved to {0}x{1}", 640.0, 480.0);
+			}
+		}));
+
+		// Уровень проверяется до форматирования: отфильтрованный LOG_WARN не выделяет память.
+		runner.add("Log/WarnFilteredOut", withLogger(spdlog::level::err, [](uint64_t iterations) {
+			for (uint64_t i = 0; i < iterations; ++i) {
+				LOG_WARN("Frame {0} took {1:.2f} ms", i, 16.7);
+			}
+		}));
+	}
+
+} // namespace Bench
@@ -0,0 +1,227 @@
+#include "Benchmark.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "EngineCore/Render/FrameGraph.hpp"
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+#include "EngineCore/Render/OpenGL/IndexBuffer.hpp"
+#include "EngineCore/Render/OpenGL/ShaderProgram.hpp"
+#include "EngineCore/Render/OpenGL/VertexArray.hpp"
+#include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
+
+namespace Bench {
+
+	using namespace Engine;
+
+	// GLSL 3.30: программный растеризатор (llvmpipe) может не поддерживать 4.60.
+	static const char* s_vertexShader =
+		"#version 330 core\n"
+		"layout(location = 0) in vec3 position;\n"
+		"layout(location = 1) in vec4 color;\n"
+		"out vec4 vColor;\n"
+		"void main() {\n"
+		"	vColor = color;\n"
+		"	gl_Position = vec4(position, 1.0);\n"
+		"}\n";
+
+	static const char* s_fragmentShader =
+		"#version 330 core\n"
+		"in vec4 vColor;\n"
+		"out vec4 fragmentColor;\n"
+		"void main() {\n"
+		"	fragmentColor = vColor;\n"
+		"}\n";
+
+	/// Размер данных буфера в замерах создания (типичный небольшой меш).
+	static constexpr size_t BufferBytes = 64 * 1024;
+
+	/// Очередь драйвера не должна расти от замера к замеру. Удаление объектов
+	/// отложено, поэтому замеры создания учитывают только постановку в очередь.
+	static void finish() {
+		glFinish();
+		GpuDeletionQueue::update();
+	}
+
+	static BufferLayout createLayout() {
+		return BufferLayout { ShaderDataType::Float3, ShaderDataType::UNorm8x4 };
+	}
+
+	void registerGLBenchmarks(BenchmarkRunner& runner) {
+		runner.add("GL/VertexBuffer/CreateStatic", [](uint64_t iterations) {
+			const std::vector<uint8_t> data(BufferBytes, 0);
+			const BufferLayout layout = createLayout();
+			for (uint64_t i = 0; i < iterations; ++i) {
+				VertexBuffer buffer(data.data(), data.size(), layout);
+				doNotOptimize(buffer.getId());
+			}
+		}, finish);
+
+		runner.add("GL/VertexBuffer/CreateStream", [](uint64_t iterations) {
+			const BufferLayout layout = createLayout();
+			for (uint64_t i = 0; i < iterations; ++i) {
+				VertexBuffer buffer(nullptr, BufferBytes, layout, VertexBuffer::EUsage::Stream);
+				doNotOptimize(buffer.getId());
+			}
+		}, finish);
+
+		runner.add("GL/VertexBuffer/SetData4K", [](uint64_t iterations) {
+			const std::vector<uint8_t> data(4096, 1);
+			VertexBuffer buffer(nullptr, BufferBytes, createLayout(), VertexBuffer::EUsage::Dynamic);
+			for (uint64_t i = 0; i < iterations; ++i) {
+				buffer.setData(data.data(), data.size(), (i * data.size()) % BufferBytes);
+			}
+		}, finish);
+
+		runner.add("GL/VertexArray/CreateWithBuffer", [](uint64_t iterations) {
+			const std::vector<uint8_t> data(BufferBytes, 0);
+			const VertexBuffer buffer(data.data(), data.size(), createLayout());
+			for (uint64_t i = 0; i < iterations; ++i) {
+				VertexArray vertexArray;
+				vertexArray.addBuffer(buffer);
+			}
+		}, finish);
+
+		runner.add("GL/IndexBuffer/Create", [](uint64_t iterations) {
+			const std::vector<uint16_t> indices(6 * 1024, 0);
+			for (uint64_t i = 0; i < iterations; ++i) {
+				IndexBuffer buffer(indices.data(), indices.size());
+				doNotOptimize(buffer.getId());
+			}
+		}, finish);
+
+		runner.add("GL/ShaderProgram/CompileLink", [](uint64_t iterations) {
+			for (uint64_t i = 0; i < iterations; ++i) {
+				ShaderProgram program(s_vertexShader, s_fragmentShader);
+				doNotOptimize(program.isCompiled());
+			}
+		}, finish);
+
+		// Две попеременно привязываемые копии: драйвер не может пропустить повторную привязку.
+		runner.add("GL/VertexArray/Bind", [](uint64_t iterations) {
+			const std::vector<uint8_t> data(BufferBytes, 0);
+			const VertexBuffer buffer(data.data(), data.size(), createLayout());
+			VertexArray vertexArrays[2];
+			vertexArrays[0].addBuffer(buffer);
+			vertexArrays[1].addBuffer(buffer);
+			for (uint64_t i = 0; i < iterations; ++i) {
+				vertexArrays[i & 1].bind();
+			}
+			VertexArray::unbind();
+		}, finish);
+
+		runner.add("GL/ShaderProgram/Bind", [](uint64_t iterations) {
+			const ShaderProgram programs[2] = {
+				ShaderProgram(s_vertexShader, s_fragmentShader),
+				ShaderProgram(s_vertexShader, s_fragmentShader)
+			};
+			for (uint64_t i = 0; i < iterations; ++i) {
+				programs[i & 1].bind();
+			}
+			ShaderProgram::unbind();
+		}, finish);
+
+		runner.add("GL/VertexBuffer/Bind", [](uint64_t iterations) {
+			const std::vector<uint8_t> data(4096, 0);
+			const VertexBuffer buffers[2] = {
+				VertexBuffer(data.data(), data.size(), createLayout()),
+				VertexBuffer(data.data(), data.size(), createLayout())
+			};
+			for (uint64_t i = 0; i < iterations; ++i) {
+				buffers[i & 1].bind();
+			}
+			VertexBuffer::unbind();
+		}, finish);
+	}
+
+	bool verifyFrameGraph() {
+		if (!GLAD_GL_VERSION_4_2) {
+			std::fprintf(stderr, "Frame graph check failed: OpenGL 4.2 is not available\n");
+			return false;
+		}
+
+		// Цепочка Shadow -> Blur -> Compose -> Present объявлена не по порядку. Время жизни
+		// "Shadow map" (проходы 0-1) и "Composite" (2-3) не пересекается: одна текстура.
+		// "Blurred" пишется через image load/store, поэтому перед Compose нужен барьер.
+		// "Debug overlay" никто не читает, и проход Debug отбрасывается.
+		constexpr uint32_t Size = 64;
+		const FrameGraphTextureDesc desc = { Size, Size, GL_RGBA8 };
+		std::vector<std::string> executed;
+		const auto record = [&executed](const char* pName) {
+			return [&executed, pName](const FrameGraph&) { executed.emplace_back(pName); };
+		};
+
+		bool bPassed = true;
+		{
+			FrameGraph graph;
+			const FrameGraphResource backbuffer = graph.importBackbuffer("Backbuffer", Size, Size);
+
+			FrameGraph::PassBuilder present = graph.addPass("Present", record("Present"));
+			FrameGraph::PassBuilder compose = graph.addPass("Compose", record("Compose"));
+			FrameGraph::PassBuilder blur = graph.addPass("Blur", record("Blur"));
+			FrameGraph::PassBuilder shadow = graph.addPass("Shadow", record("Shadow"));
+			FrameGraph::PassBuilder debug = graph.addPass("Debug", record("Debug"));
+
+			const FrameGraphResource shadowMap = shadow.write(shadow.create("Shadow map", desc));
+			const FrameGraphResource blurred = blur.create("Blurred", desc);
+			blur.read(shadowMap);
+			blur.write(blurred, FrameGraph::EAccess::Image);
+			const FrameGraphResource composite = compose.create("Composite", desc);
+			compose.read(blurred);
+			compose.write(composite);
+			present.read(composite);
+			present.write(backbuffer);
+			debug.read(shadowMap);
+			debug.write(debug.create("Debug overlay", desc));
+
+			graph.compile();
+			graph.execute();
+			finish();
+
+			const FrameGraphStats& stats = graph.getStats();
+			const std::vector<std::string> expectedOrder = { "Shadow", "Blur", "Compose", "Present" };
+			if (executed != expectedOrder) {
+				std::string order;
+				for (const std::string& name : executed) {
+					order += " " + name;
+				}
+				std::fprintf(stderr, "Frame graph check failed: passes ran as%s\n", order.c_str());
+				bPassed = false;
+			}
+			if (stats.culledPasses != 1) {
+				std::fprintf(stderr, "Frame graph check failed: %u passes culled, expected 1\n", stats.culledPasses);
+				bPassed = false;
+			}
+			if (graph.getTexture(shadowMap) == 0 || graph.getTexture(shadowMap) != graph.getTexture(composite)
+				|| graph.getTexture(blurred) == graph.getTexture(shadowMap)
+				|| stats.transientTextures != 3 || stats.physicalTextures != 2) {
+				std::fprintf(stderr, "Frame graph check failed: %u transient textures in %u physical, expected 3 in 2\n",
+					stats.transientTextures, stats.physicalTextures);
+				bPassed = false;
+			}
+			const uint32_t expectedBarriers[] = { 0, 0, GL_TEXTURE_FETCH_BARRIER_BIT, 0 };
+			for (size_t position = 0; position < executed.size() && position < 4; ++position) {
+				if (graph.getBarrierBits(position) != expectedBarriers[position]) {
+					std::fprintf(stderr, "Frame graph check failed: barrier bits 0x%x before %s, expected 0x%x\n",
+						graph.getBarrierBits(position), executed[position].c_str(), expectedBarriers[position]);
+					bPassed = false;
+				}
+			}
+			if (stats.barriers != 1) {
+				std::fprintf(stderr, "Frame graph check failed: %u barriers, expected 1\n", stats.barriers);
+				bPassed = false;
+			}
+			if (bPassed) {
+				std::printf("Frame graph check passed: 4 of 5 passes, 3 transient textures in 2 (%llu KB saved), barrier before Compose\n",
+					static_cast<unsigned long long>((stats.transientBytes - stats.physicalBytes) / 1024));
+			}
+		}
+		finish();
+		return bPassed;
+	}
+
+} // namespace Bench
@@ -0,0 +1,500 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/spdlog.h>
+
+#include "EngineCore/Core/Hash.hpp"
+#include "EngineCore/Image/Image.hpp"
+
+namespace Bench {
+
+	using namespace Engine;
+
+	/*
+	 * PNG файлы сгенерированы Python (zlib): 16x16 RGBA без фильтров (динамический Хаффман),
+	 * 13x9 RGB с Adam7 и всеми фильтрами по очереди (фиксированный Хаффман), 11x5 палитра
+	 * 4 бита с tRNS, 7x3 16-битный серый без сжатия. Значения пикселей - см. функции ниже.
+	 */
+	static const uint8_t s_pngRgba[] = {
+		0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+		0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x08, 0x06, 0x00, 0x00, 0x00, 0x1F, 0xF3, 0xFF,
+		0x61, 0x00, 0x00, 0x02, 0xA4, 0x49, 0x44, 0x41, 0x54, 0x78, 0xDA, 0xA5, 0xD3, 0xD7, 0x3F, 0xD7,
+		0x71, 0x1C, 0xC5, 0xF1, 0x4F, 0x92, 0xA4, 0x25, 0x21, 0x44, 0x21, 0x49, 0x5A, 0xC8, 0xFE, 0x51,
+		0x92, 0x24, 0x2D, 0x09, 0xA1, 0x94, 0x24, 0x49, 0x4B, 0xB2, 0x4B, 0x24, 0x09, 0x2D, 0x09, 0xA1,
+		0x94, 0x24, 0x49, 0x4B, 0x42, 0x28, 0x25, 0x49, 0x68, 0x49, 0x08, 0xA5, 0x90, 0x24, 0x95, 0x24,
+		0xBB, 0xA4, 0x73, 0xF1, 0xBE, 0xFA, 0xDE, 0xF6, 0x27, 0xBC, 0x9E, 0x8F, 0x73, 0x18, 0xD3, 0xF3,
+		0xCE, 0x10, 0x5E, 0x16, 0x52, 0x28, 0xBB, 0x2E, 0xA6, 0x42, 0x65, 0x7B, 0x4A, 0x93, 0xC1, 0xBE,
+		0xEC, 0x4E, 0xB3, 0xA3, 0xC5, 0xFC, 0xF6, 0x67, 0xAB, 0x45, 0x5D, 0xAF, 0xB5, 0x28, 0x04, 0xDC,
+		0xEB, 0x55, 0x0F, 0x7F, 0x26, 0x68, 0x94, 0xF0, 0x4E, 0xC2, 0x22, 0xED, 0x9B, 0x92, 0x63, 0xFE,
+		0x1F, 0x6D, 0xF7, 0xB2, 0x51, 0x26, 0x41, 0xF5, 0xD2, 0xD6, 0x91, 0xED, 0x33, 0x9D, 0x93, 0xD8,
+		0xB8, 0xE5, 0xA1, 0x8F, 0x87, 0xE8, 0xFB, 0x64, 0xAA, 0xEE, 0xB8, 0xF2, 0x49, 0xCE, 0x2E, 0xB6,
+		0x72, 0xD5, 0xB1, 0x92, 0x61, 0x0B, 0xFC, 0x72, 0xBA, 0x76, 0x5F, 0xFF, 0x32, 0x75, 0x63, 0x7C,
+		0x8D, 0xD8, 0xC9, 0xE7, 0x23, 0x16, 0x1D, 0xC8, 0xEB, 0xD3, 0xB8, 0xF5, 0x7D, 0xFA, 0xE6, 0x0B,
+		0x75, 0x92, 0x96, 0xAF, 0x46, 0x2F, 0x39, 0xF4, 0x70, 0x40, 0xC7, 0xE3, 0xE7, 0xAC, 0xAD, 0x97,
+		0x1A, 0x64, 0x6C, 0xA2, 0x98, 0xFC, 0xFA, 0xB8, 0x2A, 0xB5, 0x9D, 0xA9, 0xCD, 0x7C, 0xF3, 0x7C,
+		0xB3, 0x44, 0x56, 0x84, 0x15, 0x39, 0x9C, 0xAB, 0x15, 0x77, 0xBB, 0xD1, 0xAA, 0x68, 0xB8, 0x3F,
+		0xB7, 0xDB, 0xFC, 0x78, 0xA9, 0x40, 0xE2, 0x7B, 0x29, 0xAB, 0xF4, 0x36, 0x65, 0xA7, 0xC0, 0xFB,
+		0xFD, 0x9A, 0x11, 0x2F, 0x84, 0x8C, 0x1B, 0x27, 0xD9, 0x46, 0x77, 0xCC, 0x76, 0x49, 0x2E, 0xF8,
+		0xAB, 0xEB, 0x59, 0x3E, 0xC6, 0x34, 0x98, 0xCD, 0xDD, 0x75, 0xF5, 0xF3, 0x94, 0x0D, 0x67, 0xDE,
+		0x8C, 0x5F, 0x79, 0xE4, 0xC9, 0xD0, 0xF9, 0x7B, 0xEF, 0xEC, 0xB9, 0xF9, 0x75, 0xDA, 0xA6, 0xF3,
+		0x6F, 0x27, 0xAC, 0x3E, 0xF1, 0x74, 0xF8, 0x42, 0xFF, 0xBB, 0x3D, 0xB7, 0x7F, 0xCC, 0xD8, 0x72,
+		0xF1, 0xC3, 0xC4, 0x35, 0xA7, 0x5E, 0x8E, 0x5C, 0x7C, 0xF0, 0xC1, 0x6F, 0xAD, 0x5F, 0x73, 0xB6,
+		0x5D, 0xFE, 0x38, 0x79, 0xED, 0xE9, 0xD7, 0x63, 0x97, 0x1E, 0x7E, 0x34, 0xC8, 0xF3, 0x62, 0x46,
+		0x88, 0xB4, 0x40, 0xA4, 0x23, 0x22, 0xDD, 0x11, 0xC9, 0x0F, 0x04, 0x51, 0x20, 0x28, 0x00, 0x41,
+		0x1D, 0x08, 0x85, 0x40, 0xAA, 0x00, 0x52, 0x13, 0x90, 0x3A, 0x81, 0x14, 0x04, 0x84, 0x48, 0x20,
+		0x24, 0x01, 0x21, 0x03, 0x08, 0xCC, 0x92, 0x22, 0x3D, 0x28, 0x52, 0x8C, 0x10, 0x34, 0x08, 0xA1,
+		0x92, 0x90, 0xBA, 0x08, 0x29, 0x8A, 0x10, 0x32, 0x09, 0x81, 0x39, 0x21, 0xD2, 0x13, 0x91, 0xC6,
+		0x88, 0xB4, 0x42, 0xA4, 0x22, 0x10, 0x34, 0x81, 0x20, 0x00, 0x04, 0x71, 0x20, 0x34, 0x03, 0xA9,
+		0x1B, 0x48, 0x45, 0x40, 0xAA, 0x02, 0x52, 0x32, 0x10, 0xB2, 0x80, 0x10, 0x0C, 0x84, 0x68, 0x20,
+		0x30, 0x2F, 0x6E, 0x24, 0x17, 0x81, 0x8B, 0xC4, 0x41, 0x60, 0x21, 0x88, 0x8C, 0x41, 0x64, 0x0A,
+		0x22, 0xB3, 0x11, 0x59, 0x0C, 0x84, 0x6A, 0x20, 0xB4, 0x00, 0xA1, 0x17, 0x08, 0x82, 0x40, 0x92,
+		0x00, 0x92, 0x12, 0x90, 0xB4, 0x81, 0x64, 0x02, 0x04, 0x6B, 0x20, 0x38, 0x03, 0xC1, 0x1B, 0x08,
+		0x2C, 0x96, 0x22, 0x73, 0x28, 0xB2, 0x86, 0x10, 0xFA, 0x08, 0x41, 0x92, 0x90, 0x74, 0x08, 0xC9,
+		0x86, 0x10, 0x7C, 0x08, 0x81, 0xA5, 0x22, 0x32, 0x17, 0x91, 0x61, 0x88, 0x8C, 0x43, 0x64, 0x2B,
+		0x10, 0xFA, 0x81, 0x50, 0x0A, 0x84, 0x5A, 0x20, 0x28, 0x03, 0x49, 0x17, 0x48, 0x42, 0x40, 0x92,
+		0x02, 0x92, 0x0B, 0x10, 0x7C, 0x81, 0x60, 0x0A, 0x04, 0x5B, 0x20, 0x30, 0x6E, 0x24, 0x17, 0x81,
+		0xC7, 0x41, 0xE2, 0x22, 0x30, 0xCC, 0x3C, 0x00, 0x33, 0x0F, 0xC7, 0xCC, 0x13, 0x30, 0xF3, 0x34,
+		0xDC, 0xC0, 0x00, 0x37, 0x30, 0xC3, 0x0D, 0xEC, 0x71, 0x03, 0x57, 0xDC, 0x84, 0xE1, 0x26, 0xC2,
+		0xB8, 0x89, 0x2C, 0x6E, 0xA2, 0x82, 0x1B, 0xE4, 0xE3, 0x06, 0x65, 0xB8, 0x41, 0x3D, 0x6E, 0xD4,
+		0xCE, 0xEA, 0x28, 0x72, 0x80, 0x22, 0xE3, 0x09, 0x21, 0x8F, 0x10, 0xEC, 0x08, 0xC9, 0x8F, 0x90,
+		0x64, 0x08, 0x41, 0x9F, 0x10, 0x18, 0x66, 0x9E, 0x88, 0x59, 0xA7, 0x63, 0xE6, 0x81, 0x98, 0x7D,
+		0x04, 0x6E, 0xE0, 0x80, 0xD9, 0xBB, 0xE1, 0x06, 0x86, 0xB8, 0x85, 0x39, 0x6E, 0x22, 0x8F, 0x5B,
+		0xA8, 0xE1, 0x26, 0x7C, 0xB8, 0x8D, 0x08, 0x6E, 0xD0, 0x88, 0xDB, 0x74, 0xE0, 0x06, 0x05, 0xB8,
+		0x45, 0x39, 0x1B, 0xE4, 0xFD, 0xDF, 0x12, 0xFE, 0x01, 0x2B, 0xA6, 0xFE, 0x10, 0x1C, 0x20, 0xD4,
+		0x15, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
+	};
+	static const uint8_t s_pngRgbAdam7[] = {
+		0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+		0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x09, 0x08, 0x02, 0x00, 0x00, 0x01, 0x11, 0x1F, 0x01,
+		0xAB, 0x00, 0x00, 0x01, 0x15, 0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0x63, 0x60, 0xB0, 0xA9, 0x68,
+		0xD8, 0xF3, 0x83, 0xB1, 0xE3, 0x08, 0x43, 0x43, 0x43, 0x03, 0x83, 0x43, 0xCD, 0x8E, 0x03, 0x7F,
+		0x2C, 0x18, 0x4F, 0xB0, 0x38, 0x80, 0x78, 0x2E, 0x0D, 0x7B, 0x58, 0x1C, 0x6A, 0x8E, 0x30, 0xD8,
+		0xB4, 0x1C, 0xF8, 0xC3, 0xA0, 0x10, 0x33, 0x23, 0x61, 0xCE, 0x8D, 0x05, 0x77, 0x24, 0x18, 0x53,
+		0x16, 0xDC, 0x39, 0x00, 0x06, 0x4C, 0x2E, 0x2E, 0x2E, 0x47, 0x8E, 0x1C, 0x01, 0x92, 0x0C, 0x4A,
+		0x71, 0xB3, 0x98, 0xEC, 0xAA, 0x92, 0xE6, 0xDD, 0x72, 0xAA, 0xDB, 0xB5, 0xE8, 0x9E, 0x54, 0xD3,
+		0xBE, 0x5F, 0x8F, 0xE4, 0xA2, 0x18, 0xD3, 0x16, 0xDD, 0x7B, 0x80, 0x01, 0x18, 0x04, 0x7C, 0x3A,
+		0x0C, 0x72, 0x56, 0x04, 0xF4, 0x9C, 0x28, 0x58, 0xF3, 0x62, 0xC2, 0x19, 0x8E, 0x0D, 0x6F, 0x34,
+		0x18, 0x8D, 0xF2, 0x56, 0x01, 0xD5, 0x25, 0x24, 0x24, 0xC0, 0x49, 0x26, 0x25, 0x25, 0xA5, 0xA4,
+		0xA4, 0xA4, 0x45, 0x8B, 0x16, 0x3D, 0x7A, 0xF4, 0x08, 0xC2, 0x66, 0xF6, 0xC9, 0xEA, 0x78, 0xF8,
+		0xF0, 0x21, 0x23, 0x23, 0x23, 0x90, 0x6C, 0x04, 0x93, 0x2C, 0x40, 0x19, 0x27, 0x27, 0x05, 0x28,
+		0x50, 0x52, 0x52, 0x70, 0x72, 0x62, 0x10, 0xF4, 0xED, 0x64, 0xB4, 0xAD, 0x34, 0xCC, 0x5D, 0xA9,
+		0x18, 0x3B, 0x33, 0xB0, 0xF7, 0xA4, 0x63, 0xED, 0xCE, 0xC2, 0xB5, 0x2F, 0x13, 0xE7, 0xDE, 0x9C,
+		0x78, 0x96, 0xB3, 0x71, 0xEF, 0xCF, 0x8D, 0x6F, 0x35, 0x17, 0xDE, 0x95, 0xBC, 0xC8, 0xEB, 0xC9,
+		0x68, 0x9C, 0xBF, 0xFA, 0x03, 0x0C, 0x14, 0x14, 0x14, 0xC0, 0x98, 0x1F, 0xD0, 0xD8, 0x4C, 0x40,
+		0x2B, 0x80, 0x00, 0xE8, 0x16, 0x20, 0x00, 0x3A, 0x07, 0x08, 0x80, 0x2E, 0x02, 0x02, 0xB0, 0xB0,
+		0x12, 0x58, 0x38, 0x09, 0x28, 0xC8, 0xEC, 0x9B, 0xDD, 0xC9, 0xC9, 0xC9, 0xF9, 0x12, 0x0C, 0x80,
+		0x0C, 0x38, 0xBB, 0x13, 0x89, 0xCD, 0xD9, 0xC9, 0x09, 0x00, 0xE6, 0x3F, 0xBA, 0x9B, 0x9A, 0x87,
+		0x3B, 0xB3, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
+	};
+	static const uint8_t s_pngPalette[] = {
+		0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+		0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x05, 0x04, 0x03, 0x00, 0x00, 0x00, 0x61, 0x88, 0x0B,
+		0x65, 0x00, 0x00, 0x00, 0x24, 0x50, 0x4C, 0x54, 0x45, 0x00, 0xFF, 0x00, 0x14, 0xEB, 0x07, 0x28,
+		0xD7, 0x0E, 0x3C, 0xC3, 0x15, 0x50, 0xAF, 0x1C, 0x64, 0x9B, 0x23, 0x78, 0x87, 0x2A, 0x8C, 0x73,
+		0x31, 0xA0, 0x5F, 0x38, 0xB4, 0x4B, 0x3F, 0xC8, 0x37, 0x46, 0xDC, 0x23, 0x4D, 0x83, 0x2B, 0x0A,
+		0x70, 0x00, 0x00, 0x00, 0x0C, 0x74, 0x52, 0x4E, 0x53, 0x00, 0x15, 0x2A, 0x3F, 0x54, 0x69, 0x7E,
+		0x93, 0xA8, 0xBD, 0xD2, 0xE7, 0x29, 0x32, 0xA5, 0xA1, 0x00, 0x00, 0x00, 0x23, 0x49, 0x44, 0x41,
+		0x54, 0x78, 0xDA, 0x63, 0x60, 0x54, 0x76, 0x4D, 0xEF, 0x5C, 0xC0, 0xA8, 0xAC, 0x04, 0x04, 0xA1,
+		0x4C, 0x20, 0x32, 0x4C, 0x81, 0xD9, 0x15, 0x48, 0x2A, 0xC9, 0xB3, 0x80, 0x48, 0x25, 0x69, 0x00,
+		0x75, 0x5A, 0x06, 0x1B, 0xF5, 0xCE, 0x57, 0x08, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44,
+		0xAE, 0x42, 0x60, 0x82,
+	};
+	static const uint8_t s_pngGray16[] = {
+		0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+		0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x03, 0x10, 0x00, 0x00, 0x00, 0x00, 0x2A, 0x38, 0x96,
+		0x5A, 0x00, 0x00, 0x00, 0x38, 0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0x01, 0x2D, 0x00, 0xD2, 0xFF,
+		0x00, 0x00, 0x4D, 0x04, 0x35, 0x08, 0x1D, 0x0C, 0x05, 0x0F, 0xED, 0x13, 0xD5, 0x17, 0xBD, 0x01,
+		0x4E, 0x6D, 0x04, 0xE8, 0x04, 0xE8, 0x04, 0xE8, 0x04, 0xE8, 0x03, 0xE8, 0x04, 0xE8, 0x02, 0x4E,
+		0x20, 0x4E, 0x20, 0x4E, 0x20, 0x4E, 0x20, 0x4E, 0x20, 0x4F, 0x20, 0x4E, 0x20, 0x19, 0x1C, 0x0C,
+		0xBD, 0x3A, 0xF7, 0xFF, 0xDA, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60,
+		0x82,
+	};
+
+	static float pngPatternPixel(uint32_t x, uint32_t y, uint32_t c) {
+		return static_cast<uint8_t>((x ^ y) * 16 + c * 60 + y);
+	}
+
+	static float pngPalettePixel(uint32_t x, uint32_t y, uint32_t c) {
+		const uint32_t index = (x + 2 * y) % 12;
+		const uint32_t palette[4] = { index * 20, 255 - index * 20, index * 7, index * 21 };
+		return static_cast<float>(palette[c]);
+	}
+
+	static float pngGray16Pixel(uint32_t x, uint32_t y, uint32_t) {
+		return static_cast<float>(((x * 1000 + y * 20000 + 77) & 0xFFFF) >> 8);
+	}
+
+	/// RGB Adam7 с tRNS по цвету пикселя (0, 0): прозрачен только он.
+	static float pngRgbKeyPixel(uint32_t x, uint32_t y, uint32_t c) {
+		if (c == 3) {
+			return x == 0 && y == 0 ? 0.f : 255.f;
+		}
+		return pngPatternPixel(x, y, c);
+	}
+
+	/// 16-битный серый с tRNS по значению пикселя (1, 0).
+	static float pngGrayKeyPixel(uint32_t x, uint32_t y, uint32_t c) {
+		if (c == 1) {
+			return x == 1 && y == 0 ? 0.f : 255.f;
+		}
+		return pngGray16Pixel(x, y, c);
+	}
+
+	/// Битовая запись энтропийных данных JPEG (старшие биты первыми, после 0xFF вставляется 0x00).
+	struct JpegBitWriter {
+		std::vector<uint8_t>&	out;
+		uint32_t				buffer	= 0;
+		uint32_t				count	= 0;
+
+		void write(uint32_t bits, uint32_t bitCount) {
+			for (uint32_t i = bitCount; i-- > 0;) {
+				buffer = (buffer << 1) | ((bits >> i) & 1);
+				if (++count == 8) {
+					flushByte();
+				}
+			}
+		}
+
+		void flush() {
+			while (count != 0) {
+				write(1, 1);
+			}
+		}
+
+	private:
+		void flushByte() {
+			out.push_back(static_cast<uint8_t>(buffer));
+			if (buffer == 0xFF) {
+				out.push_back(0x00);
+			}
+			buffer = 0;
+			count = 0;
+		}
+	};
+
+	static void appendJpegSegment(std::vector<uint8_t>& out, uint8_t marker, const std::vector<uint8_t>& payload) {
+		const size_t length = payload.size() + 2;
+		out.insert(out.end(), { 0xFF, marker, static_cast<uint8_t>(length >> 8), static_cast<uint8_t>(length) });
+		out.insert(out.end(), payload.begin(), payload.end());
+	}
+
+	/// Блок только с DC: разность DC и код конца блока.
+	static void writeJpegDcBlock(JpegBitWriter& writer, int difference) {
+		// Коды DC таблицы: категория 0 - 00, 5 - 01, 6 - 10, 8 - 110.
+		uint32_t category = 0;
+		for (int magnitude = std::abs(difference); magnitude != 0; magnitude >>= 1) {
+			++category;
+		}
+		switch (category) {
+		case 0:	writer.write(0b00, 2); break;
+		case 5:	writer.write(0b01, 2); break;
+		case 6:	writer.write(0b10, 2); break;
+		case 8:	writer.write(0b110, 3); break;
+		default: break;
+		}
+		writer.write(static_cast<uint32_t>(difference > 0 ? difference : difference + (1 << category) - 1), category);
+		writer.write(0b0, 1);	// конец блока
+	}
+
+	/// DC блоков 8x8 яркости (построчно); пиксель блока равен 128 + DC.
+	static const int s_jpegLuma[4] = { 0, 16, -32, 100 };
+	static const int s_jpegBlue = 16;
+	static const int s_jpegRed = -32;
+
+	/// Собирает baseline JPEG 16x16 из блоков с одним DC: серый или YCbCr 4:2:0.
+	static std::vector<uint8_t> createJpeg(bool bColor) {
+		std::vector<uint8_t> file = { 0xFF, 0xD8 };
+
+		std::vector<uint8_t> quant(65, 8);
+		quant[0] = 0;
+		appendJpegSegment(file, 0xDB, quant);
+
+		if (bColor) {
+			appendJpegSegment(file, 0xC0, { 8, 0, 16, 0, 16, 3, 1, 0x22, 0, 2, 0x11, 0, 3, 0x11, 0 });
+		}
+		else {
+			appendJpegSegment(file, 0xC0, { 8, 0, 16, 0, 16, 1, 1, 0x11, 0 });
+		}
+
+		std::vector<uint8_t> tables = { 0x00, 0, 3, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 6, 8 };
+		const uint8_t acTable[] = { 0x10, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x00 };
+		tables.insert(tables.end(), std::begin(acTable), std::end(acTable));
+		appendJpegSegment(file, 0xC4, tables);
+
+		if (bColor) {
+			appendJpegSegment(file, 0xDA, { 3, 1, 0x00, 2, 0x00, 3, 0x00, 0, 63, 0 });
+		}
+		else {
+			appendJpegSegment(file, 0xDA, { 1, 1, 0x00, 0, 63, 0 });
+		}
+
+		// В цветном файле одно MCU: 4 блока яркости и по блоку Cb и Cr. В сером - 4 MCU по блоку.
+		JpegBitWriter writer{ file };
+		int previous = 0;
+		for (const int luma : s_jpegLuma) {
+			writeJpegDcBlock(writer, luma - previous);
+			previous = luma;
+		}
+		if (bColor) {
+			writeJpegDcBlock(writer, s_jpegBlue);
+			writeJpegDcBlock(writer, s_jpegRed);
+		}
+		writer.flush();
+
+		file.insert(file.end(), { 0xFF, 0xD9 });
+		return file;
+	}
+
+	static float jpegLuma(uint32_t x, uint32_t y) {
+		return 128.f + s_jpegLuma[(y / 8) * 2 + x / 8];
+	}
+
+	static float jpegGrayPixel(uint32_t x, uint32_t y, uint32_t) {
+		return jpegLuma(x, y);
+	}
+
+	static float jpegColorPixel(uint32_t x, uint32_t y, uint32_t c) {
+		const float luma = jpegLuma(x, y);
+		const float rgb[3] = {
+			luma + 1.402f * s_jpegRed,
+			luma - 0.344136f * s_jpegBlue - 0.714136f * s_jpegRed,
+			luma + 1.772f * s_jpegBlue
+		};
+		return std::clamp(std::round(rgb[c]), 0.f, 255.f);
+	}
+
+	static constexpr uint32_t HdrWidth = 9;
+	static constexpr uint32_t HdrHeight = 3;
+
+	/// RGBE пикселя HDR: мантиссы не меньше 128, экспонента 129 (значение = мантисса / 128).
+	static uint8_t hdrComponent(uint32_t x, uint32_t y, uint32_t c) {
+		const uint32_t rgbe[4] = { 128 + x * 8 + y, 255 - x * 4, 128 + y * 16, 129 };
+		return static_cast<uint8_t>(rgbe[c]);
+	}
+
+	static float hdrPixel(uint32_t x, uint32_t y, uint32_t c) {
+		return hdrComponent(x, y, c) / 128.f;
+	}
+
+	/// Собирает Radiance HDR без сжатия или с новым RLE (экспонента - повтором, остальное - литералами).
+	static std::vector<uint8_t> createHdr(bool bRle) {
+		const std::string header = "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y " + std::to_string(HdrHeight)
+			+ " +X " + std::to_string(HdrWidth) + "\n";
+		std::vector<uint8_t> file(header.begin(), header.end());
+
+		for (uint32_t y = 0; y < HdrHeight; ++y) {
+			if (!bRle) {
+				for (uint32_t x = 0; x < HdrWidth; ++x) {
+					for (uint32_t c = 0; c < 4; ++c) {
+						file.push_back(hdrComponent(x, y, c));
+					}
+				}
+				continue;
+			}
+
+			file.insert(file.end(), { 2, 2, 0, static_cast<uint8_t>(HdrWidth) });
+			for (uint32_t c = 0; c < 3; ++c) {
+				file.push_back(static_cast<uint8_t>(HdrWidth));
+				for (uint32_t x = 0; x < HdrWidth; ++x) {
+					file.push_back(hdrComponent(x, y, c));
+				}
+			}
+			file.insert(file.end(), { static_cast<uint8_t>(128 + HdrWidth), hdrComponent(0, y, 3) });
+		}
+		return file;
+	}
+
+	using PixelFunc = std::function<float(uint32_t x, uint32_t y, uint32_t c)>;
+
+	/// Декодирует файл и сравнивает каждый компонент с ожидаемым значением.
+	static bool checkDecodedImage(const char* name, const std::vector<uint8_t>& file,
+		uint32_t width, uint32_t height, uint32_t channels, const PixelFunc& expected, float tolerance) {
+		Image image;
+		if (!decodeImage(file.data(), file.size(), image)) {
+			std::fprintf(stderr, "Image check failed: %s is not decoded\n", name);
+			return false;
+		}
+		if (image.getWidth() != width || image.getHeight() != height || image.channels != channels) {
+			std::fprintf(stderr, "Image check failed: %s is %ux%u x%u, expected %ux%u x%u\n", name,
+				image.getWidth(), image.getHeight(), image.channels, width, height, channels);
+			return false;
+		}
+
+		const bool bFloat = image.pixelType == PixelType::Float32;
+		const uint8_t* pPixels = image.levels[0].pixels.data();
+		for (uint32_t y = 0; y < height; ++y) {
+			for (uint32_t x = 0; x < width; ++x) {
+				for (uint32_t c = 0; c < channels; ++c) {
+					const size_t index = (static_cast<size_t>(y) * width + x) * channels + c;
+					float value;
+					if (bFloat) {
+						std::memcpy(&value, pPixels + index * sizeof(float), sizeof(float));
+					}
+					else {
+						value = pPixels[index];
+					}
+					if (std::abs(value - expected(x, y, c)) > tolerance) {
+						std::fprintf(stderr, "Image check failed: %s pixel (%u, %u) channel %u is %g, expected %g\n",
+							name, x, y, c, value, expected(x, y, c));
+						return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	static void writeBigEndian32(std::vector<uint8_t>& file, size_t offset, uint32_t value) {
+		file[offset + 0] = static_cast<uint8_t>(value >> 24);
+		file[offset + 1] = static_cast<uint8_t>(value >> 16);
+		file[offset + 2] = static_cast<uint8_t>(value >> 8);
+		file[offset + 3] = static_cast<uint8_t>(value);
+	}
+
+	/// Пересчитывает CRC чанка PNG, начинающегося с `offset` (после правки его данных).
+	static void updatePngCrc(std::vector<uint8_t>& file, size_t offset) {
+		const uint32_t length = (static_cast<uint32_t>(file[offset]) << 24) | (file[offset + 1] << 16) | (file[offset + 2] << 8) | file[offset + 3];
+		writeBigEndian32(file, offset + 8 + length, crc32(file.data() + offset + 4, static_cast<size_t>(length) + 4));
+	}
+
+	/// Вставляет чанк PNG в позицию `offset`.
+	static void insertPngChunk(std::vector<uint8_t>& file, size_t offset, const char* type, const std::vector<uint8_t>& payload) {
+		std::vector<uint8_t> chunk(12 + payload.size());
+		writeBigEndian32(chunk, 0, static_cast<uint32_t>(payload.size()));
+		std::memcpy(chunk.data() + 4, type, 4);
+		std::copy(payload.begin(), payload.end(), chunk.begin() + 8);
+		updatePngCrc(chunk, 0);
+		file.insert(file.begin() + offset, chunk.begin(), chunk.end());
+	}
+
+	/// Файл с заведомо неверным заголовком должен отклоняться без выделения памяти под пиксели.
+	static bool checkRejected(const char* name, const std::vector<uint8_t>& file) {
+		Image image;
+		if (decodeImage(file.data(), file.size(), image) || !image.levels.empty()) {
+			std::fprintf(stderr, "Image check failed: %s is decoded\n", name);
+			return false;
+		}
+		return true;
+	}
+
+	void registerImageBenchmarks(BenchmarkRunner& runner) {
+		runner.add("Image/DecodePng16x16", [](uint64_t iterations) {
+			Image image;
+			for (uint64_t i = 0; i < iterations; ++i) {
+				decodeImage(s_pngRgba, sizeof(s_pngRgba), image);
+				doNotOptimize(image.levels);
+			}
+		});
+	}
+
+	bool verifyImageDecoders() {
+		const auto toVector = [](const uint8_t* pData, size_t size) { return std::vector<uint8_t>(pData, pData + size); };
+		const std::vector<std::vector<uint8_t>> files = {
+			toVector(s_pngRgba, sizeof(s_pngRgba)),
+			toVector(s_pngRgbAdam7, sizeof(s_pngRgbAdam7)),
+			toVector(s_pngPalette, sizeof(s_pngPalette)),
+			toVector(s_pngGray16, sizeof(s_pngGray16)),
+			createJpeg(false),
+			createJpeg(true),
+			createHdr(false),
+			createHdr(true)
+		};
+
+		bool bPassed = true;
+		bPassed = checkDecodedImage("PNG RGBA", files[0], 16, 16, 4, pngPatternPixel, 0.f) && bPassed;
+		bPassed = checkDecodedImage("PNG RGB Adam7", files[1], 13, 9, 3, pngPatternPixel, 0.f) && bPassed;
+		bPassed = checkDecodedImage("PNG palette", files[2], 11, 5, 4, pngPalettePixel, 0.f) && bPassed;
+		bPassed = checkDecodedImage("PNG gray 16 bit", files[3], 7, 3, 1, pngGray16Pixel, 0.f) && bPassed;
+
+		// Цветовой ключ tRNS для RGB и серого; чанк вставляется сразу после IHDR.
+		constexpr size_t ChunksOffset = 33;
+		std::vector<uint8_t> keyed = files[1];
+		insertPngChunk(keyed, ChunksOffset, "tRNS", { 0, 0, 0, 60, 0, 120 });
+		bPassed = checkDecodedImage("PNG RGB with tRNS", keyed, 13, 9, 4, pngRgbKeyPixel, 0.f) && bPassed;
+		keyed = files[3];
+		insertPngChunk(keyed, ChunksOffset, "tRNS", { 0x04, 0x35 });
+		bPassed = checkDecodedImage("PNG gray 16 bit with tRNS", keyed, 7, 3, 2, pngGrayKeyPixel, 0.f) && bPassed;
+		bPassed = checkDecodedImage("JPEG gray", files[4], 16, 16, 1, jpegGrayPixel, 0.f) && bPassed;
+		bPassed = checkDecodedImage("JPEG YCbCr 4:2:0", files[5], 16, 16, 3, jpegColorPixel, 1.f) && bPassed;
+		bPassed = checkDecodedImage("HDR", files[6], HdrWidth, HdrHeight, 3, hdrPixel, 0.f) && bPassed;
+		bPassed = checkDecodedImage("HDR RLE", files[7], HdrWidth, HdrHeight, 3, hdrPixel, 0.f) && bPassed;
+
+		// Размеры из заголовка: больше предела или больше, чем могут дать сжатые данные.
+		// CRC IHDR пересчитывается, чтобы файл отклонялся из-за заголовка, а не из-за CRC.
+		std::vector<uint8_t> png = files[0];
+		writeBigEndian32(png, 16, 1u << 24);
+		writeBigEndian32(png, 20, 1u << 24);
+		updatePngCrc(png, 8);
+		bPassed = checkRejected("PNG 2^24 x 2^24", png) && bPassed;
+		writeBigEndian32(png, 16, 8192);
+		writeBigEndian32(png, 20, 8192);
+		updatePngCrc(png, 8);
+		bPassed = checkRejected("PNG 8192x8192 with 16x16 data", png) && bPassed;
+		png = files[0];
+		png[24] = 3;
+		updatePngCrc(png, 8);
+		bPassed = checkRejected("PNG with bit depth 3", png) && bPassed;
+		png = files[1];
+		png[28] = 2;
+		updatePngCrc(png, 8);
+		bPassed = checkRejected("PNG with interlace method 2", png) && bPassed;
+		png = files[0];
+		png[29] ^= 1;
+		bPassed = checkRejected("PNG with a wrong IHDR CRC", png) && bPassed;
+		// PLTE палитрового файла - 36 байт данных сразу после IHDR.
+		png = files[2];
+		png.erase(png.begin() + ChunksOffset, png.begin() + ChunksOffset + 12 + 36);
+		bPassed = checkRejected("PNG palette image without PLTE", png) && bPassed;
+
+		// Высота и ширина JPEG лежат в SOF0 сразу после байта точности.
+		const size_t sofOffset = 2 + 4 + 65;
+		std::vector<uint8_t> jpeg = files[4];
+		jpeg[sofOffset + 5] = jpeg[sofOffset + 6] = jpeg[sofOffset + 7] = jpeg[sofOffset + 8] = 0xFF;
+		bPassed = checkRejected("JPEG 65535x65535", jpeg) && bPassed;
+		jpeg[sofOffset + 5] = jpeg[sofOffset + 7] = 0x0F;
+		jpeg[sofOffset + 6] = jpeg[sofOffset + 8] = 0xA0;
+		bPassed = checkRejected("JPEG 4000x4000 with 4 blocks of data", jpeg) && bPassed;
+
+		const std::string hdrHeader = "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n";
+		for (const char* pSize : { "-Y 60000 +X 60000\n", "-Y 4000 +X 4000\n" }) {
+			std::string hdr = hdrHeader + pSize + std::string(16, '\x80');
+			bPassed = checkRejected(pSize, std::vector<uint8_t>(hdr.begin(), hdr.end())) && bPassed;
+		}
+
+		// Обрезанные и испорченные файлы: результат не важен, важно отсутствие падений.
+		const std::shared_ptr<spdlog::logger> pPrevious = spdlog::default_logger();
+		spdlog::set_default_logger(std::make_shared<spdlog::logger>("verify", std::make_shared<spdlog::sinks::null_sink_mt>()));
+		size_t corruptedCount = 0;
+		Image image;
+		for (const std::vector<uint8_t>& file : files) {
+			for (size_t size = 0; size < file.size(); ++size) {
+				decodeImage(file.data(), size, image);
+				++corruptedCount;
+			}
+			std::vector<uint8_t> corrupted = file;
+			for (size_t i = 0; i < corrupted.size(); ++i) {
+				for (const uint8_t value : { static_cast<uint8_t>(file[i] ^ 0x55), uint8_t(0x00), uint8_t(0xFF) }) {
+					corrupted[i] = value;
+					decodeImage(corrupted.data(), corrupted.size(), image);
+					++corruptedCount;
+				}
+				corrupted[i] = file[i];
+			}
+		}
+		spdlog::set_default_logger(pPrevious);
+
+		if (bPassed) {
+			std::printf("Image decoder check passed: %zu files decoded, %zu corrupted files handled\n", files.size(), corruptedCount);
+		}
+		return bPassed;
+	}
+
+} // namespace Bench
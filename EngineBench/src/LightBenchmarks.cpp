@@ -0,0 +1,261 @@
+#include "Benchmark.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "EngineCore/Core/JobSystem.hpp"
+#include "EngineCore/Render/ClusteredLighting.hpp"
+#include "EngineCore/Render/LightClusters.hpp"
+#include "EngineCore/Render/OpenGL/Framebuffer.hpp"
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+#include "EngineCore/Render/OpenGL/ShaderProgram.hpp"
+#include "EngineCore/Render/OpenGL/VertexArray.hpp"
+
+namespace Bench {
+
+	using namespace Engine;
+
+	static constexpr uint32_t LightCounts[] = { 10, 100, 1000, 4000 };
+
+	static constexpr uint32_t TargetWidth = 1280;
+	static constexpr uint32_t TargetHeight = 720;
+
+	// Уровень растёт вместе с числом источников при постоянной плотности: один источник
+	// на LightSpacing x LightSpacing метров пола. Камера стоит у края и видит часть уровня,
+	// поэтому начиная с ~1000 источников на экран попадает примерно одно и то же их число.
+	static constexpr float LightSpacing = 4.f;
+	static constexpr float LightRadius = 4.f;
+	static constexpr float LightHeight = 0.5f;
+
+	struct LightScene {
+		Mat4					view;
+		Mat4					projection;
+		std::vector<PointLight>	lights;
+	};
+
+	static LightScene createScene(const uint32_t lightCount) {
+		LightScene scene;
+		scene.view = Mat4::lookAt({ 0.f, 6.f, 0.f }, { 0.f, 0.f, -30.f }, { 0.f, 1.f, 0.f });
+		scene.projection = Mat4::perspective(1.f, static_cast<float>(TargetWidth) / TargetHeight, 0.1f, 100.f);
+
+		// Квадрат пола перед камерой: x в [-size / 2, size / 2], z в [-size, 0].
+		const float size = std::sqrt(static_cast<float>(lightCount)) * LightSpacing;
+
+		uint32_t state = 12345u;
+		const auto random = [&state]() {
+			state = state * 1664525u + 1013904223u;
+			return static_cast<float>(state >> 8) * (1.f / 16777216.f);
+		};
+
+		scene.lights.resize(lightCount);
+		for (PointLight& light : scene.lights) {
+			light.position[0] = (random() - 0.5f) * size;
+			light.position[1] = LightHeight;
+			light.position[2] = -random() * size;
+			light.radius = LightRadius;
+			light.color[0] = 0.5f + 0.5f * random();
+			light.color[1] = 0.5f + 0.5f * random();
+			light.color[2] = 0.5f + 0.5f * random();
+			light.intensity = 1.f;
+		}
+		return scene;
+	}
+
+	// Полноэкранный треугольник; фрагмент пересекает луч камеры с полом.
+	static const char* s_vertexShader =
+		"#version 450\n"
+		"void main() {\n"
+		"	vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2) * 2.0 - 1.0;\n"
+		"	gl_Position = vec4(position, 0.0, 1.0);\n"
+		"}\n";
+
+	static const char* s_fragmentMain =
+		"layout(location = 0) uniform vec4 floorPlane;\n"		// плоскость пола в пространстве вида
+		"layout(location = 1) uniform vec4 projectionScale;\n"	// P00, P11, far, 1 - кластеры, 0 - все источники
+		"layout(location = 2) uniform vec4 viewportSize;\n"
+		"out vec4 fragmentColor;\n"
+		"void main() {\n"
+		"	vec2 ndc = gl_FragCoord.xy / viewportSize.xy * 2.0 - 1.0;\n"
+		"	vec3 direction = vec3(ndc / projectionScale.xy, -1.0);\n"
+		"	float t = -floorPlane.w / dot(floorPlane.xyz, direction);\n"
+		"	if (t <= 0.0 || t > projectionScale.z) {\n"
+		"		fragmentColor = vec4(0.0, 0.0, 0.0, 1.0);\n"
+		"		return;\n"
+		"	}\n"
+		"	vec3 viewPosition = direction * t;\n"
+		"	vec3 light = projectionScale.w > 0.5\n"
+		"		? shadeClusteredLights(gl_FragCoord.xy, viewPosition, floorPlane.xyz)\n"
+		"		: shadeAllLights(viewPosition, floorPlane.xyz);\n"
+		"	fragmentColor = vec4(0.05 + light, 1.0);\n"
+		"}\n";
+
+	/// Рисует сцену в `target`; `bClustered` выбирает перебор кластера или всех источников.
+	class LightSceneRenderer {
+	public:
+		explicit LightSceneRenderer(const uint32_t lightCount, JobSystem* pJobSystem = nullptr)
+			: m_scene(createScene(lightCount))
+			, m_lighting({}, pJobSystem)
+			, m_program(s_vertexShader, (std::string("#version 450\n") + ClusteredLighting::ShaderSource + s_fragmentMain).c_str())
+			, m_target({ TargetWidth, TargetHeight, { GL_RGBA8 }, 0, false })
+		{
+			const Vec3 normal = m_scene.view.transformVector({ 0.f, 1.f, 0.f });
+			const Vec3 point = m_scene.view.transformPoint({ 0.f, 0.f, 0.f });
+			m_floorPlane = Vec4(normal, -dot(normal, point));
+		}
+
+		/// Кадр: построение кластеров, загрузка и отрисовка.
+		void render(const bool bClustered) {
+			m_lighting.update(m_scene.view, m_scene.projection, TargetWidth, TargetHeight,
+				m_scene.lights.data(), static_cast<uint32_t>(m_scene.lights.size()));
+
+			m_target.bind();
+			m_program.bind();
+			m_program.setFloat4(0, m_floorPlane.x, m_floorPlane.y, m_floorPlane.z, m_floorPlane.w);
+			m_program.setFloat4(1, m_scene.projection.m[0], m_scene.projection.m[5], 100.f, bClustered ? 1.f : 0.f);
+			m_program.setFloat4(2, static_cast<float>(TargetWidth), static_cast<float>(TargetHeight), 0.f, 0.f);
+			m_lighting.bind();
+			m_emptyVertexArray.bind();
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+			Framebuffer::bindDefault();
+		}
+
+		/// Пиксели RGBA8 последнего кадра (ждёт GPU).
+		std::vector<uint8_t> readPixels() const {
+			std::vector<uint8_t> pixels(static_cast<size_t>(TargetWidth) * TargetHeight * 4);
+			m_target.bind();
+			glReadPixels(0, 0, TargetWidth, TargetHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+			Framebuffer::bindDefault();
+			return pixels;
+		}
+
+	private:
+		LightScene			m_scene;
+		ClusteredLighting	m_lighting;
+		ShaderProgram		m_program;
+		Framebuffer			m_target;
+		VertexArray			m_emptyVertexArray;
+		Vec4				m_floorPlane;
+	};
+
+	static void finish() {
+		glFinish();
+		GpuDeletionQueue::update();
+	}
+
+	/// Сцена и пул потоков строятся вне замера; итерация - построение кластеров.
+	static BenchmarkSetup clusterBuild(const uint32_t lightCount, const bool bJobs) {
+		struct Fixture {
+			explicit Fixture(const uint32_t lightCount, const bool bJobs)
+				: scene(createScene(lightCount))
+				, pJobSystem(bJobs ? std::make_unique<JobSystem>() : nullptr)
+				, builder({}, pJobSystem.get())
+			{}
+
+			LightScene					scene;
+			std::unique_ptr<JobSystem>	pJobSystem;
+			LightClusterBuilder			builder;
+		};
+
+		return [lightCount, bJobs](BenchmarkContext&) -> BenchmarkFunc {
+			auto pFixture = std::make_shared<Fixture>(lightCount, bJobs);
+			return [pFixture, lightCount](uint64_t iterations) {
+				for (uint64_t i = 0; i < iterations; ++i) {
+					pFixture->builder.build(pFixture->scene.view, pFixture->scene.projection, pFixture->scene.lights.data(), lightCount);
+				}
+				doNotOptimize(pFixture->builder.getStats().indexCount);
+			};
+		};
+	}
+
+	/// Шейдер, цель 1280x720 и пул потоков создаются вне замера; итерация - кадр с ожиданием GPU.
+	static BenchmarkSetup lightFrame(const uint32_t lightCount, const bool bClustered) {
+		struct Fixture {
+			explicit Fixture(const uint32_t lightCount, const bool bClustered)
+				: pJobSystem(bClustered ? std::make_unique<JobSystem>() : nullptr)
+				, renderer(lightCount, pJobSystem.get())
+			{}
+
+			std::unique_ptr<JobSystem>	pJobSystem;
+			LightSceneRenderer			renderer;
+		};
+
+		return [lightCount, bClustered](BenchmarkContext&) -> BenchmarkFunc {
+			auto pFixture = std::make_shared<Fixture>(lightCount, bClustered);
+			// Первый кадр выделяет буферы кластеров и прогревает драйвер.
+			pFixture->renderer.render(bClustered);
+			finish();
+			return [pFixture, bClustered](uint64_t iterations) {
+				for (uint64_t i = 0; i < iterations; ++i) {
+					pFixture->renderer.render(bClustered);
+					glFinish();
+				}
+			};
+		};
+	}
+
+	void registerLightBenchmarks(BenchmarkRunner& runner, const bool bHasGL) {
+		for (const uint32_t lightCount : LightCounts) {
+			const std::string suffix = "/" + std::to_string(lightCount);
+			runner.addWithSetup("Lights/ClusterBuild" + suffix, clusterBuild(lightCount, false));
+			runner.addWithSetup("Lights/ClusterBuildJobs" + suffix, clusterBuild(lightCount, true));
+		}
+
+		if (!bHasGL || !GLAD_GL_VERSION_4_5) {
+			return;
+		}
+
+		// Полный кадр с ожиданием GPU. Clustered должен оставаться почти постоянным,
+		// Forward (перебор всех источников во фрагменте) растёт линейно.
+		for (const uint32_t lightCount : LightCounts) {
+			const std::string suffix = "/" + std::to_string(lightCount);
+			runner.addWithSetup("Lights/ClusteredFrame" + suffix, lightFrame(lightCount, true), finish);
+			runner.addWithSetup("Lights/ForwardFrame" + suffix, lightFrame(lightCount, false), finish);
+		}
+	}
+
+	bool verifyLights() {
+		if (!GLAD_GL_VERSION_4_5) {
+			std::fprintf(stderr, "Lighting check failed: OpenGL 4.5 is not available\n");
+			return false;
+		}
+
+		// Списки кластеров консервативны, а источники вне радиуса дают точный ноль,
+		// поэтому сумма по кластеру совпадает с суммой по всем источникам побитно.
+		// С ~1000 источников на экран попадает почти столько же, сколько при 4000,
+		// а перебор всех 4000 на программном растеризаторе занимает десятки секунд.
+		bool bPassed = true;
+		JobSystem jobSystem;
+		for (const uint32_t lightCount : { 10u, 100u, 1000u }) {
+			LightSceneRenderer renderer(lightCount, &jobSystem);
+			renderer.render(true);
+			const std::vector<uint8_t> clustered = renderer.readPixels();
+			renderer.render(false);
+			const std::vector<uint8_t> forward = renderer.readPixels();
+			GpuDeletionQueue::update();
+
+			size_t differentPixels = 0;
+			size_t litPixels = 0;
+			for (size_t pixel = 0; pixel < clustered.size(); pixel += 4) {
+				differentPixels += std::memcmp(&clustered[pixel], &forward[pixel], 4) != 0 ? 1 : 0;
+				// Фон и неосвещённый пол: 0 и 0.05 * 255.
+				litPixels += forward[pixel] > 13 ? 1 : 0;
+			}
+			if (differentPixels != 0 || litPixels == 0) {
+				std::fprintf(stderr, "Lighting check failed: %u lights, %zu pixels differ, %zu lit\n",
+					lightCount, differentPixels, litPixels);
+				bPassed = false;
+			}
+		}
+		if (bPassed) {
+			std::printf("Lighting check passed: clustered and all-lights images match for 10-1000 lights\n");
+		}
+		return bPassed;
+	}
+
+} // namespace Bench
@@ -0,0 +1,170 @@
+#include "Benchmark.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EngineCore/Render/MeshLod.hpp"
+
+namespace Bench {
+
+	using namespace Engine;
+
+	/// Замкнутый меш без границ: все вершины можно удалять.
+	struct TorusMesh {
+		std::vector<float>		positions;
+		std::vector<uint32_t>	indices;
+	};
+
+	static TorusMesh createTorus(const uint32_t segments, const uint32_t sides) {
+		static constexpr float Pi = 3.14159265358979f;
+		static constexpr float MajorRadius = 1.f;
+		static constexpr float MinorRadius = 0.4f;
+
+		TorusMesh mesh;
+		mesh.positions.reserve(static_cast<size_t>(segments) * sides * 3);
+		for (uint32_t segment = 0; segment < segments; ++segment) {
+			const float u = 2.f * Pi * segment / segments;
+			for (uint32_t side = 0; side < sides; ++side) {
+				const float v = 2.f * Pi * side / sides;
+				const float ring = MajorRadius + MinorRadius * std::cos(v);
+				mesh.positions.push_back(ring * std::cos(u));
+				mesh.positions.push_back(MinorRadius * std::sin(v));
+				mesh.positions.push_back(ring * std::sin(u));
+			}
+		}
+
+		mesh.indices.reserve(static_cast<size_t>(segments) * sides * 6);
+		for (uint32_t segment = 0; segment < segments; ++segment) {
+			const uint32_t nextSegment = (segment + 1) % segments;
+			for (uint32_t side = 0; side < sides; ++side) {
+				const uint32_t nextSide = (side + 1) % sides;
+				const uint32_t a = segment * sides + side;
+				const uint32_t b = nextSegment * sides + side;
+				const uint32_t c = nextSegment * sides + nextSide;
+				const uint32_t d = segment * sides + nextSide;
+				mesh.indices.insert(mesh.indices.end(), { a, b, c, a, c, d });
+			}
+		}
+		return mesh;
+	}
+
+	/// Торус строится вне замера; время нормируется на 1M треугольников исходного меша.
+	static BenchmarkSetup simplifyTorus() {
+		return [](BenchmarkContext& context) -> BenchmarkFunc {
+			auto pMesh = std::make_shared<TorusMesh>(createTorus(128, 32));
+			context.setItemsPerIteration(static_cast<double>(pMesh->indices.size() / 3));
+			auto pResult = std::make_shared<std::vector<uint32_t>>(pMesh->indices.size());
+			return [pMesh, pResult](uint64_t iterations) {
+				for (uint64_t i = 0; i < iterations; ++i) {
+					doNotOptimize(simplifyMesh(pMesh->positions.data(), pMesh->positions.size() / 3, 3 * sizeof(float),
+						pMesh->indices.data(), pMesh->indices.size(), pMesh->indices.size() / 4, 1.f, pResult->data()));
+				}
+			};
+		};
+	}
+
+	/// Поле торусов с общей цепочкой LOD; камера стоит у края поля и смотрит вглубь.
+	class LodField {
+	public:
+		static constexpr uint32_t FieldSize = 64;			// 64 x 64 объекта
+		static constexpr float ObjectSpacing = 4.f;
+		static constexpr float ViewportHeight = 720.f;
+
+		LodField() {
+			const TorusMesh mesh = createTorus(128, 32);
+			m_chain = buildMeshLodChain(mesh.positions.data(), mesh.positions.size() / 3, 3 * sizeof(float),
+				mesh.indices.data(), mesh.indices.size());
+
+			const float halfWidth = 0.5f * ObjectSpacing * (FieldSize - 1);
+			m_centers.reserve(FieldSize * FieldSize);
+			for (uint32_t row = 0; row < FieldSize; ++row) {
+				for (uint32_t column = 0; column < FieldSize; ++column) {
+					m_centers.push_back({ column * ObjectSpacing - halfWidth, 0.f, -static_cast<float>(row + 1) * ObjectSpacing });
+				}
+			}
+			m_levels.assign(m_centers.size(), 0);
+			m_projection = Mat4::perspective(1.f, 16.f / 9.f, 0.1f, 500.f);
+		}
+
+		/// Кадр: выбор уровня для каждого объекта.
+		void selectFrame() noexcept {
+			m_selector.newFrame({ 0.f, 2.f, 0.f }, m_projection, ViewportHeight);
+			for (size_t i = 0; i < m_centers.size(); ++i) {
+				m_levels[i] = m_selector.select(m_chain, m_centers[i], 1.f, m_levels[i]);
+			}
+		}
+
+		const LodSelector& getSelector() const noexcept { return m_selector; }
+		size_t getObjectCount() const noexcept { return m_centers.size(); }
+
+	private:
+		MeshLodChain			m_chain;
+		LodSelector				m_selector;
+		Mat4					m_projection;
+		std::vector<Vec3>		m_centers;
+		std::vector<uint32_t>	m_levels;
+	};
+
+	/// Итерация - кадр выбора LOD для всего поля; счётчики - треугольники кадра
+	/// с LOD и без него.
+	static BenchmarkSetup lodSelectFrame() {
+		return [](BenchmarkContext& context) -> BenchmarkFunc {
+			auto pField = std::make_shared<LodField>();
+			// Статистика выдаётся за прошлый кадр; к третьему кадру уровни устоялись.
+			for (int i = 0; i < 3; ++i) {
+				pField->selectFrame();
+			}
+			const LodSelector& selector = pField->getSelector();
+			context.setItemsPerIteration(static_cast<double>(pField->getObjectCount()));
+			context.setCounter("submittedTriangles", static_cast<double>(selector.getSubmittedTriangles()));
+			context.setCounter("fullDetailTriangles", static_cast<double>(selector.getFullDetailTriangles()));
+			return [pField](uint64_t iterations) {
+				for (uint64_t i = 0; i < iterations; ++i) {
+					pField->selectFrame();
+				}
+				doNotOptimize(pField->getSelector().getSubmittedTriangles());
+			};
+		};
+	}
+
+	void registerMeshBenchmarks(BenchmarkRunner& runner) {
+		runner.addWithSetup("Mesh/SimplifyTorus8K", simplifyTorus());
+		runner.addWithSetup("Mesh/LodSelectField4K", lodSelectFrame());
+	}
+
+	bool verifyMeshLod() {
+		const TorusMesh mesh = createTorus(64, 32);
+		const size_t vertexCount = mesh.positions.size() / 3;
+		std::vector<uint32_t> result(mesh.indices.size());
+
+		// Без предела ошибки упрощение останавливается только по числу треугольников.
+		bool bPassed = true;
+		for (const size_t targetTriangles : { size_t(1024), size_t(409), size_t(64) }) {
+			const size_t indexCount = simplifyMesh(mesh.positions.data(), vertexCount, 3 * sizeof(float),
+				mesh.indices.data(), mesh.indices.size(), targetTriangles * 3, 1e10f, result.data());
+			const size_t triangleCount = indexCount / 3;
+
+			size_t degenerate = 0;
+			for (size_t triangle = 0; triangle < triangleCount; ++triangle) {
+				const uint32_t* pCorners = &result[triangle * 3];
+				degenerate += (pCorners[0] == pCorners[1] || pCorners[1] == pCorners[2] || pCorners[0] == pCorners[2]) ? 1 : 0;
+			}
+
+			// Схлопывание удаляет два треугольника, поэтому цель может быть пройдена на один.
+			const bool bReached = triangleCount <= targetTriangles && triangleCount + 2 >= targetTriangles;
+			if (!bReached || degenerate != 0) {
+				std::fprintf(stderr, "Mesh LOD check failed: target %zu triangles, got %zu (%zu degenerate)\n",
+					targetTriangles, triangleCount, degenerate);
+				bPassed = false;
+			}
+		}
+		if (bPassed) {
+			std::printf("Mesh LOD check passed: torus of %zu triangles\n", mesh.indices.size() / 3);
+		}
+		return bPassed;
+	}
+
+} // namespace Bench
@@ -0,0 +1,126 @@
+#include "Benchmark.hpp"
+
+#include <cstdio>
+#include <vector>
+
+#include "EngineCore/Core/JobSystem.hpp"
+#include "EngineCore/Render/OcclusionCuller.hpp"
+
+namespace Bench {
+
+	using namespace Engine;
+
+	static constexpr float Aspect = 2.f;	// как у буфера глубины 256x128 по умолчанию
+
+	/// Окклюдеры одним мешем и проверяемые боксы.
+	struct OcclusionScene {
+		std::vector<float>				positions;
+		std::vector<uint32_t>			indices;
+		std::vector<OcclusionBounds>	boxes;
+		Mat4							viewProjection;
+	};
+
+	/// Стена в плоскости z, лицевой стороной к камере в начале координат.
+	static void addWall(OcclusionScene& scene, const float x0, const float y0, const float x1, const float y1, const float z) {
+		const uint32_t base = static_cast<uint32_t>(scene.positions.size() / 3);
+		scene.positions.insert(scene.positions.end(), { x0, y0, z, x1, y0, z, x1, y1, z, x0, y1, z });
+		scene.indices.insert(scene.indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+	}
+
+	static void addBox(OcclusionScene& scene, const Vec3& center, const float halfSize) {
+		scene.boxes.push_back({ center - Vec3(halfSize), center + Vec3(halfSize) });
+	}
+
+	static Mat4 createViewProjection() {
+		return Mat4::perspective(1.f, Aspect, 0.1f, 200.f)
+			* Mat4::lookAt({ 0.f, 0.f, 0.f }, { 0.f, 0.f, -1.f }, { 0.f, 1.f, 0.f });
+	}
+
+	/// Ряд стен на z = -20 с просветами и сетка из 64x64 боксов за ними.
+	static OcclusionScene createBenchmarkScene() {
+		OcclusionScene scene;
+		scene.viewProjection = createViewProjection();
+		for (int wall = -4; wall < 4; ++wall) {
+			addWall(scene, wall * 5.f, -8.f, wall * 5.f + 4.f, 8.f, -20.f);
+		}
+		for (uint32_t y = 0; y < 64; ++y) {
+			for (uint32_t x = 0; x < 64; ++x) {
+				addBox(scene, { (x - 31.5f) * 0.6f, (y - 31.5f) * 0.25f, -40.f - (x + y) % 8 }, 0.2f);
+			}
+		}
+		return scene;
+	}
+
+	static void cullScene(OcclusionCuller& culler, const OcclusionScene& scene, uint8_t* pVisible) {
+		culler.beginFrame(scene.viewProjection);
+		culler.addOccluder(scene.positions.data(), scene.positions.size() / 3, 3 * sizeof(float),
+			scene.indices.data(), scene.indices.size(), Mat4::identity());
+		culler.rasterize();
+		culler.cull(scene.boxes.data(), scene.boxes.size(), pVisible);
+	}
+
+	void registerOcclusionBenchmarks(BenchmarkRunner& runner) {
+		runner.add("Occlusion/Frame4K", [](uint64_t iterations) {
+			const OcclusionScene scene = createBenchmarkScene();
+			OcclusionCuller culler;
+			std::vector<uint8_t> visible(scene.boxes.size());
+			for (uint64_t i = 0; i < iterations; ++i) {
+				cullScene(culler, scene, visible.data());
+			}
+			doNotOptimize(culler.getStats().occludedObjects);
+		});
+
+		runner.add("Occlusion/Frame4KJobs", [](uint64_t iterations) {
+			const OcclusionScene scene = createBenchmarkScene();
+			JobSystem jobSystem;
+			OcclusionCuller culler(&jobSystem);
+			std::vector<uint8_t> visible(scene.boxes.size());
+			for (uint64_t i = 0; i < iterations; ++i) {
+				cullScene(culler, scene, visible.data());
+			}
+			doNotOptimize(culler.getStats().occludedObjects);
+		});
+	}
+
+	bool verifyOcclusion() {
+		// Стена 10x10 на z = -10 закрывает сектор примерно в +-0.5 по тангенсу угла.
+		OcclusionScene scene;
+		scene.viewProjection = createViewProjection();
+		addWall(scene, -5.f, -5.f, 5.f, 5.f, -10.f);
+
+		// Первые `occludedCount` боксов целиком за стеной, остальные должны остаться видимыми.
+		for (int y = -3; y <= 3; y += 3) {
+			for (int x = -6; x <= 6; x += 3) {
+				addBox(scene, { float(x), float(y), -20.f }, 0.5f);
+			}
+		}
+		const size_t occludedCount = scene.boxes.size();
+		addBox(scene, { 0.f, 0.f, -5.f }, 0.5f);		// перед стеной
+		addBox(scene, { 15.f, 0.f, -20.f }, 0.5f);		// за стеной, но сбоку
+		addBox(scene, { 10.f, 0.f, -20.f }, 1.f);		// закрыт частично
+		addBox(scene, { 0.f, 0.f, -10.5f }, 1.f);		// пересекает стену
+
+		bool bPassed = true;
+		JobSystem jobSystem;
+		for (JobSystem* pJobSystem : { static_cast<JobSystem*>(nullptr), &jobSystem }) {
+			OcclusionCuller culler(pJobSystem);
+			std::vector<uint8_t> visible(scene.boxes.size());
+			cullScene(culler, scene, visible.data());
+
+			for (size_t box = 0; box < scene.boxes.size(); ++box) {
+				const bool bExpectVisible = box >= occludedCount;
+				if ((visible[box] != 0) != bExpectVisible) {
+					std::fprintf(stderr, "Occlusion check failed%s: box %zu is %s, expected %s\n",
+						pJobSystem ? " (jobs)" : "", box, visible[box] ? "visible" : "occluded",
+						bExpectVisible ? "visible" : "occluded");
+					bPassed = false;
+				}
+			}
+		}
+		if (bPassed) {
+			std::printf("Occlusion check passed: %zu of %zu boxes occluded\n", occludedCount, scene.boxes.size());
+		}
+		return bPassed;
+	}
+
+} // namespace Bench
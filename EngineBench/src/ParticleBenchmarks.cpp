@@ -0,0 +1,152 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "EngineCore/Core/JobSystem.hpp"
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+#include "EngineCore/Render/ParticleSimulation.hpp"
+#include "EngineCore/Render/ParticleSystem.hpp"
+
+namespace Bench {
+
+	using namespace Engine;
+
+	static constexpr uint32_t ParticleCapacity = 1024 * 1024;
+	static constexpr float StepSeconds = 1.f / 60.f;
+
+	/// Установившееся число частиц: rate * среднее время жизни (2 с) ~ 1M.
+	static ParticleEmitterDesc createEmitter() {
+		ParticleEmitterDesc desc;
+		desc.rate = 500000.f;
+		return desc;
+	}
+
+	/// Прогоняет источник до заполнения, чтобы замер шёл на ~1M живых частиц.
+	template<typename StepFunc>
+	static void warmUp(const StepFunc& step) {
+		for (uint32_t i = 0; i < 180; ++i) {
+			step();
+		}
+	}
+
+	static void finish() {
+		glFinish();
+		GpuDeletionQueue::update();
+	}
+
+	/// Симуляция на CPU, прогретая до ~1M живых частиц (строится вне замера).
+	struct CpuParticleFixture {
+		explicit CpuParticleFixture(const bool bJobs)
+			: pJobSystem(bJobs ? std::make_unique<JobSystem>() : nullptr)
+			, simulator(ParticleCapacity, pJobSystem.get())
+		{
+			warmUp([this]() { step(); });
+		}
+
+		void step() { simulator.step(emitter.next(desc, StepSeconds, ParticleCapacity)); }
+
+		const ParticleEmitterDesc		desc = createEmitter();
+		std::unique_ptr<JobSystem>		pJobSystem;
+		ParticleEmitter					emitter;
+		ParticleSimulatorCpu			simulator;
+	};
+
+	static BenchmarkSetup cpuStep(const bool bJobs) {
+		return [bJobs](BenchmarkContext& context) -> BenchmarkFunc {
+			auto pFixture = std::make_shared<CpuParticleFixture>(bJobs);
+			context.setItemsPerIteration(pFixture->simulator.getAliveCount());
+			return [pFixture](uint64_t iterations) {
+				for (uint64_t i = 0; i < iterations; ++i) {
+					pFixture->step();
+				}
+				doNotOptimize(pFixture->simulator.getAliveCount());
+			};
+		};
+	}
+
+	void registerParticleBenchmarks(BenchmarkRunner& runner, const bool bHasGL) {
+		// Итерация - один шаг; построение и прогрев до 1M частиц не измеряются.
+		runner.addWithSetup("Particles/CpuStep1M", cpuStep(false));
+		runner.addWithSetup("Particles/CpuStep1MJobs", cpuStep(true));
+
+		if (!bHasGL || !GLAD_GL_VERSION_4_5) {
+			return;
+		}
+
+		// Каждая итерация дожидается GPU: замеряется шаг симуляции, а не постановка в очередь.
+		runner.addWithSetup("Particles/GpuStep1M", [](BenchmarkContext&) -> BenchmarkFunc {
+			ParticleSystemParams params;
+			params.capacity = ParticleCapacity;
+			auto pParticles = std::make_shared<ParticleSystem>(params);
+			pParticles->getEmitter() = createEmitter();
+			warmUp([&]() { pParticles->update(StepSeconds); });
+			glFinish();
+			return [pParticles](uint64_t iterations) {
+				for (uint64_t i = 0; i < iterations; ++i) {
+					pParticles->update(StepSeconds);
+					glFinish();
+				}
+			};
+		}, finish);
+	}
+
+	bool verifyParticles(const uint32_t steps) {
+		if (!GLAD_GL_VERSION_4_5) {
+			std::fprintf(stderr, "Particle check failed: compute shaders (OpenGL 4.5) are not available\n");
+			return false;
+		}
+
+		// Ёмкость меньше установившегося числа частиц: проверяется и отбрасывание лишних.
+		ParticleSystemParams params;
+		params.capacity = 256 * 1024;
+		ParticleSystem gpu(params);
+		gpu.getEmitter() = createEmitter();
+
+		ParticleEmitter emitter;
+		ParticleSimulatorCpu cpu(params.capacity);
+		for (uint32_t i = 0; i < steps; ++i) {
+			gpu.update(StepSeconds);
+			cpu.step(emitter.next(gpu.getEmitter(), StepSeconds, params.capacity));
+		}
+
+		// Порядок частиц после уплотнения на GPU не определён.
+		const auto byId = [](const Particle& lhs, const Particle& rhs) { return lhs.id < rhs.id; };
+		std::vector<Particle> gpuParticles = gpu.readParticles();
+		std::vector<Particle> cpuParticles(cpu.getParticles(), cpu.getParticles() + cpu.getAliveCount());
+		std::sort(gpuParticles.begin(), gpuParticles.end(), byId);
+		std::sort(cpuParticles.begin(), cpuParticles.end(), byId);
+
+		if (gpuParticles.size() != cpuParticles.size()) {
+			std::fprintf(stderr, "Particle check failed: %zu alive on GPU, %zu on CPU\n", gpuParticles.size(), cpuParticles.size());
+			return false;
+		}
+
+		float maxError = 0.f;
+		for (size_t i = 0; i < gpuParticles.size(); ++i) {
+			const Particle& lhs = gpuParticles[i];
+			const Particle& rhs = cpuParticles[i];
+			if (lhs.id != rhs.id) {
+				std::fprintf(stderr, "Particle check failed: id %u on GPU, %u on CPU\n", lhs.id, rhs.id);
+				return false;
+			}
+			for (int axis = 0; axis < 3; ++axis) {
+				maxError = std::max(maxError, std::fabs(lhs.position[axis] - rhs.position[axis]));
+				maxError = std::max(maxError, std::fabs(lhs.velocity[axis] - rhs.velocity[axis]));
+			}
+			maxError = std::max(maxError, std::fabs(lhs.life - rhs.life));
+		}
+
+		// Оба пути считают без FMA в одном порядке, поэтому расхождение - ошибка, а не округление.
+		const bool bPassed = maxError == 0.f;
+		std::printf("Particle check %s: %zu particles after %u steps, max error %g\n",
+			bPassed ? "passed" : "failed", gpuParticles.size(), steps, maxError);
+		return bPassed;
+	}
+
+} // namespace Bench
@@ -0,0 +1,146 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "EngineCore/Core/JobSystem.hpp"
+#include "EngineCore/Scene/TransformHierarchy.hpp"
+
+namespace Bench {
+
+	using namespace Engine;
+
+	static constexpr uint32_t LevelSizes[] = { 1000, 9000, 40000, 150000, 300000 };	// 500k узлов
+	static constexpr uint32_t DirtyPerFrame = 25000;									// 5% узлов
+	static constexpr double TargetUpdateMs = 1.0;										// медиана кадра с пулом потоков
+
+	/// Иерархия из 500k узлов: родитель каждого узла - случайный узел предыдущего уровня.
+	class TransformFrameRunner {
+	public:
+		TransformFrameRunner() {
+			uint32_t nodeCount = 0;
+			for (const uint32_t levelSize : LevelSizes) {
+				nodeCount += levelSize;
+			}
+			m_hierarchy.reserve(nodeCount);
+			m_ids.reserve(nodeCount);
+
+			uint32_t levelBegin = 0;
+			uint32_t previousBegin = 0;
+			for (const uint32_t levelSize : LevelSizes) {
+				const uint32_t previousSize = levelBegin - previousBegin;
+				for (uint32_t i = 0; i < levelSize; ++i) {
+					const TransformId parent = previousSize > 0
+						? m_ids[previousBegin + nextRandom() % previousSize]
+						: InvalidTransformId;
+					LocalTransform local;
+					local.position = { randomFloat(), randomFloat(), randomFloat() };
+					local.rotation = Quat::fromAxisAngle({ randomFloat(), 1.f, randomFloat() }, randomFloat());
+					m_ids.push_back(m_hierarchy.create(parent, local));
+				}
+				previousBegin = levelBegin;
+				levelBegin += levelSize;
+			}
+			m_hierarchy.update();
+		}
+
+		/// Меняет позицию `DirtyPerFrame` случайных узлов и пересчитывает мировые матрицы.
+		void updateFrame(JobSystem* pJobSystem) {
+			for (uint32_t i = 0; i < DirtyPerFrame; ++i) {
+				const TransformId id = m_ids[nextRandom() % m_ids.size()];
+				m_hierarchy.setPosition(id, { randomFloat(), randomFloat(), randomFloat() });
+			}
+			m_hierarchy.update(pJobSystem);
+		}
+
+		const TransformHierarchy& getHierarchy() const noexcept { return m_hierarchy; }
+		const std::vector<TransformId>& getIds() const noexcept { return m_ids; }
+
+	private:
+		uint32_t nextRandom() noexcept {
+			m_random = m_random * 1664525u + 1013904223u;
+			return m_random >> 8;
+		}
+
+		float randomFloat() noexcept { return static_cast<float>(nextRandom() % 2001) * 0.001f - 1.f; }
+
+		TransformHierarchy			m_hierarchy;
+		std::vector<TransformId>	m_ids;
+		uint32_t					m_random = 12345;
+	};
+
+	/// Иерархия (и пул потоков) строятся вне замера; итерация - кадр: 5% узлов
+	/// изменено, пересчитываются они и их поддеревья.
+	static BenchmarkSetup transformUpdate(const bool bJobs) {
+		return [bJobs](BenchmarkContext& context) -> BenchmarkFunc {
+			auto pFrames = std::make_shared<TransformFrameRunner>();
+			std::shared_ptr<JobSystem> pJobSystem = bJobs ? std::make_shared<JobSystem>() : nullptr;
+			pFrames->updateFrame(pJobSystem.get());
+			context.setCounter("recomputedPerFrame", pFrames->getHierarchy().getChangedCount());
+			return [pFrames, pJobSystem](uint64_t iterations) {
+				for (uint64_t i = 0; i < iterations; ++i) {
+					pFrames->updateFrame(pJobSystem.get());
+				}
+				doNotOptimize(pFrames->getHierarchy().getChangedCount());
+			};
+		};
+	}
+
+	void registerSceneBenchmarks(BenchmarkRunner& runner) {
+		runner.addWithSetup("Scene/TransformUpdate500K", transformUpdate(false));
+		runner.addWithSetup("Scene/TransformUpdate500KJobs", transformUpdate(true));
+	}
+
+	bool verifyTransformHierarchy() {
+		constexpr uint32_t FrameCount = 30;
+		TransformFrameRunner frames;
+		JobSystem jobSystem;
+		std::vector<double> updateMs;
+		updateMs.reserve(FrameCount);
+		uint64_t changedCount = 0;
+		for (uint32_t i = 0; i < FrameCount; ++i) {
+			const auto start = std::chrono::steady_clock::now();
+			frames.updateFrame(&jobSystem);
+			updateMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+			changedCount += frames.getHierarchy().getChangedCount();
+		}
+
+		// Мировая матрица каждого узла должна совпадать побитово с произведением
+		// мировой матрицы родителя на локальную (тот же порядок операций, что в `update()`).
+		const TransformHierarchy& hierarchy = frames.getHierarchy();
+		uint32_t wrongMatrices = 0;
+		for (const TransformId id : frames.getIds()) {
+			const LocalTransform& local = hierarchy.getLocal(id);
+			const Mat4 localMatrix = Mat4::fromTRS(local.position, local.rotation, local.scale);
+			const TransformId parent = hierarchy.getParent(id);
+			const Mat4 expected = parent == InvalidTransformId
+				? localMatrix
+				: multiplyAffine(hierarchy.getWorld(parent), localMatrix);
+			wrongMatrices += std::memcmp(expected.data(), hierarchy.getWorld(id).data(), sizeof(Mat4)) != 0 ? 1 : 0;
+		}
+
+		std::sort(updateMs.begin(), updateMs.end());
+		const double medianMs = updateMs[updateMs.size() / 2];
+		if (wrongMatrices != 0) {
+			std::fprintf(stderr, "Transform hierarchy check failed: %u of %zu world matrices are wrong\n",
+				wrongMatrices, frames.getIds().size());
+			return false;
+		}
+#ifdef NDEBUG
+		// Цель задана для оптимизированной сборки; в Debug время только печатается.
+		if (medianMs > TargetUpdateMs) {
+			std::fprintf(stderr, "Transform hierarchy check failed: update %.2f ms (median) exceeds the %.1f ms target\n",
+				medianMs, TargetUpdateMs);
+			return false;
+		}
+#endif
+		std::printf("Transform hierarchy check passed: %zu nodes, %u dirtied and %llu recomputed per frame, update %.2f ms (median)\n",
+			frames.getIds().size(), DirtyPerFrame, static_cast<unsigned long long>(changedCount / FrameCount), medianMs);
+		return true;
+	}
+
+} // namespace Bench
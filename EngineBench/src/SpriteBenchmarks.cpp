@@ -0,0 +1,144 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+#include "EngineCore/Render/SpriteBatch.hpp"
+
+namespace Bench {
+
+	using namespace Engine;
+
+	/// Целевая нагрузка `SpriteBatch`: 200k спрайтов за кадр.
+	static constexpr uint32_t SpriteCount = 200000;
+
+	static constexpr float ScreenWidth = 1280.f;
+	static constexpr float ScreenHeight = 720.f;
+
+	/// Кадр из `SpriteCount` спрайтов, темп которого ограничен как при обмене буферов:
+	/// CPU не уходит вперёд GPU больше чем на `SpriteBatchParams::framesInFlight` кадров.
+	class SpriteFrameRunner {
+	public:
+		SpriteFrameRunner()
+			: m_fences(SpriteBatchParams{}.framesInFlight, nullptr)
+		{
+			uint32_t state = 12345u;
+			const auto random = [&state]() {
+				state = state * 1664525u + 1013904223u;
+				return static_cast<float>(state >> 8) * (1.f / 16777216.f);
+			};
+
+			m_sprites.resize(SpriteCount);
+			for (Sprite& sprite : m_sprites) {
+				sprite.x = random() * ScreenWidth;
+				sprite.y = random() * ScreenHeight;
+				sprite.width = 2.f + random() * 6.f;
+				sprite.height = 2.f + random() * 6.f;
+				// Четверть спрайтов повёрнута: проверяется и путь с sin/cos.
+				sprite.rotation = random() < 0.25f ? random() * 6.28f : 0.f;
+				sprite.color = 0xFF000000u | (static_cast<uint32_t>(random() * 16777215.f) & 0xFFFFFFu);
+			}
+		}
+
+		~SpriteFrameRunner() {
+			for (GLsync fence : m_fences) {
+				if (fence) {
+					glDeleteSync(fence);
+				}
+			}
+		}
+
+		SpriteFrameRunner(const SpriteFrameRunner&)				= delete;
+		SpriteFrameRunner& operator=(const SpriteFrameRunner&)	= delete;
+
+		void renderFrame() {
+			GLsync& fence = m_fences[m_frame % m_fences.size()];
+			if (fence) {
+				glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+				glDeleteSync(fence);
+			}
+
+			m_batch.begin(Mat4::ortho(0.f, ScreenWidth, ScreenHeight, 0.f, -1.f, 1.f));
+			for (const Sprite& sprite : m_sprites) {
+				m_batch.draw(sprite);
+			}
+			m_batch.end();
+
+			fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			++m_frame;
+			m_chunkWaits += m_batch.getLastStats().chunkWaits;
+		}
+
+		const SpriteBatchStats& getLastStats() const noexcept { return m_batch.getLastStats(); }
+		uint64_t getChunkWaits() const noexcept { return m_chunkWaits; }
+
+	private:
+		SpriteBatch			m_batch;
+		std::vector<Sprite>	m_sprites;
+		std::vector<GLsync>	m_fences;	///< Кадры в пути.
+		uint64_t			m_frame			= 0;
+		uint64_t			m_chunkWaits	= 0;
+	};
+
+	static void finish() {
+		glFinish();
+		GpuDeletionQueue::update();
+	}
+
+	void registerSpriteBenchmarks(BenchmarkRunner& runner, const bool bHasGL) {
+		if (!bHasGL || !GLAD_GL_VERSION_4_6) {
+			return;
+		}
+
+		// Итерация - кадр из 200k спрайтов. Ожидание части кольца значит, что кольцо
+		// меньше целевой нагрузки, и время кадра уже не показательно.
+		runner.add("Sprites/Batch200K", [](uint64_t iterations) {
+			SpriteFrameRunner frames;
+			for (uint64_t i = 0; i < iterations; ++i) {
+				frames.renderFrame();
+			}
+			if (frames.getChunkWaits() != 0) {
+				std::fprintf(stderr, "Sprites/Batch200K: %llu chunk waits at the target load\n",
+					static_cast<unsigned long long>(frames.getChunkWaits()));
+				std::abort();
+			}
+		}, finish);
+	}
+
+	bool verifySprites() {
+		if (!GLAD_GL_VERSION_4_6) {
+			std::fprintf(stderr, "Sprite check failed: OpenGL 4.6 is not available\n");
+			return false;
+		}
+
+		// Кадров больше, чем частей в кольце: кольцо успевает обернуться несколько раз.
+		constexpr uint32_t FrameCount = 30;
+		SpriteFrameRunner frames;
+		std::vector<float> cpuMs;
+		cpuMs.reserve(FrameCount);
+		uint32_t badFrames = 0;
+		for (uint32_t i = 0; i < FrameCount; ++i) {
+			frames.renderFrame();
+			cpuMs.push_back(frames.getLastStats().cpuMs);
+			badFrames += frames.getLastStats().sprites != SpriteCount ? 1 : 0;
+		}
+		finish();
+
+		std::sort(cpuMs.begin(), cpuMs.end());
+		const float medianMs = cpuMs[cpuMs.size() / 2];
+		if (frames.getChunkWaits() != 0 || badFrames != 0) {
+			std::fprintf(stderr, "Sprite check failed: %llu chunk waits, %u frames with a wrong sprite count\n",
+				static_cast<unsigned long long>(frames.getChunkWaits()), badFrames);
+			return false;
+		}
+		std::printf("Sprite check passed: %u sprites per frame, CPU %.2f ms (median), no chunk waits\n",
+			SpriteCount, medianMs);
+		return true;
+	}
+
+} // namespace Bench
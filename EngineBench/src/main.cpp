@@ -0,0 +1,148 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "Benchmark.hpp"
+
+/**
+ * Замеры горячих путей EngineCore.
+ *
+ * Параметры:
+ *   --json <file>          записать результаты в JSON
+ *   --filter <text>        только замеры, имя которых содержит text
+ *   --repetitions <n>      замеров на результат (по умолчанию 15)
+ *   --min-time-ms <ms>     минимальная длительность замера (по умолчанию 25)
+ *   --label <text>         метка прогона в JSON (например, хеш коммита)
+ *   --no-gl                не создавать контекст OpenGL (проверки, которым он нужен, пропускаются)
+ *   --verify               вместо замеров выполнить проверки корректности (код возврата 1 при ошибке,
+ *                          а также если без --no-gl контекст OpenGL не создан)
+ *
+ * Контекст OpenGL создаётся в скрытом окне. На машине без GPU используется
+ * программный растеризатор Mesa: `LIBGL_ALWAYS_SOFTWARE=1 xvfb-run EngineBench`.
+ */
+int main(int argc, char** argv) {
+	Bench::BenchmarkParams params;
+	std::string jsonPath;
+	std::string label;
+	bool bUseGL = true;
+	bool bVerify = false;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string option = argv[i];
+		const bool bHasValue = i + 1 < argc;
+		if (option == "--json" && bHasValue) {
+			jsonPath = argv[++i];
+		}
+		else if (option == "--filter" && bHasValue) {
+			params.filter = argv[++i];
+		}
+		else if (option == "--repetitions" && bHasValue) {
+			params.repetitions = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (option == "--min-time-ms" && bHasValue) {
+			params.minRepetitionMs = std::strtof(argv[++i], nullptr);
+		}
+		else if (option == "--label" && bHasValue) {
+			label = argv[++i];
+		}
+		else if (option == "--no-gl") {
+			bUseGL = false;
+		}
+		else if (option == "--verify") {
+			bVerify = true;
+		}
+		else {
+			std::fprintf(stderr, "Unknown option %s\n", option.c_str());
+			return 1;
+		}
+	}
+
+	std::vector<std::pair<std::string, std::string>> context;
+#ifdef NDEBUG
+	context.emplace_back("build", "Release");
+#else
+	context.emplace_back("build", "Debug");
+#endif
+#ifdef __VERSION__
+	context.emplace_back("compiler", __VERSION__);
+#endif
+	if (!label.empty()) {
+		context.emplace_back("label", label);
+	}
+
+	Bench::BenchmarkRunner runner;
+	Bench::registerCoreBenchmarks(runner);
+	Bench::registerMeshBenchmarks(runner);
+	Bench::registerOcclusionBenchmarks(runner);
+	Bench::registerImageBenchmarks(runner);
+	Bench::registerSceneBenchmarks(runner);
+
+	GLFWwindow* pWindow = nullptr;
+	bool bHasGL = false;
+	if (bUseGL && glfwInit()) {
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		pWindow = glfwCreateWindow(64, 64, "EngineBench", nullptr, nullptr);
+		if (pWindow) {
+			glfwMakeContextCurrent(pWindow);
+			// Без vsync: замеры не должны ждать обмена буферов.
+			glfwSwapInterval(0);
+		}
+		if (pWindow && gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress))) {
+			context.emplace_back("glVendor", reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+			context.emplace_back("glRenderer", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+			context.emplace_back("glVersion", reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+			Bench::registerGLBenchmarks(runner);
+			bHasGL = true;
+		}
+		else {
+			std::fprintf(stderr, "OpenGL context is not available, GL benchmarks are skipped\n");
+		}
+	}
+
+	Bench::registerSpriteBenchmarks(runner, bHasGL);
+	Bench::registerParticleBenchmarks(runner, bHasGL);
+	Bench::registerLightBenchmarks(runner, bHasGL);
+
+	bool bVerified = true;
+	if (bVerify) {
+		bVerified = Bench::verifyMeshLod() && bVerified;
+		bVerified = Bench::verifyOcclusion() && bVerified;
+		bVerified = Bench::verifyImageDecoders() && bVerified;
+		bVerified = Bench::verifyTransformHierarchy() && bVerified;
+		if (bHasGL) {
+			bVerified = Bench::verifyFrameGraph() && bVerified;
+			bVerified = Bench::verifySprites() && bVerified;
+			bVerified = Bench::verifyParticles(240) && bVerified;
+			bVerified = Bench::verifyLights() && bVerified;
+		}
+		else {
+			// Без контекста проверки не выполнялись: успех допустим, только если GL отключён явно.
+			std::fprintf(stderr, "Skipped checks without OpenGL: frame graph (ordering, aliasing, barriers, culling), sprites (200k without chunk waits), particles (GPU vs CPU), lighting (clustered vs all lights)\n");
+			bVerified = !bUseGL && bVerified;
+		}
+	}
+
+	const std::vector<Bench::BenchmarkResult> results = bVerify
+		? std::vector<Bench::BenchmarkResult>()
+		: runner.run(params);
+
+	if (pWindow) {
+		glfwDestroyWindow(pWindow);
+	}
+	if (bUseGL) {
+		glfwTerminate();
+	}
+
+	if (!bVerified) {
+		return 1;
+	}
+	if (!jsonPath.empty() && !Bench::writeJson(jsonPath, results, context)) {
+		return 1;
+	}
+	return 0;
+}
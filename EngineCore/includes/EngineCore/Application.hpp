@@ -5,6 +5,7 @@
 #include <memory>
 
 #include "EngineCore/Event.hpp"
+#include "EngineCore/Layer.hpp"
 
 namespace Engine {
 
@@ -15,6 +16,7 @@ namespace Engine {
 	 * - Создание окна `Window`
 	 * - Подписка и обработка событий (движение курсора, нажатие клавиш и т.д.)
 	 * - Основной цикл обновления окна и логики приложения
+	 * - Стек слоёв `LayerStack` и отладочный интерфейс ImGui поверх них
 	 */
 	class Application {
 	public:
@@ -54,11 +56,119 @@ namespace Engine {
 		 * @note Метод вызывается каждый кадр в основном цыкле в методе `run()`.
 		 */
 		virtual void update() {};
+
+		/**
+		 * @brief Добавляет слой над остальными слоями, но под оверлеями.
+		 * 
+		 * Слои, добавленные до `run()`, подключаются после создания окна.
+		 * 
+		 * @return Указатель на слой; слоем владеет приложение.
+		 */
+		Layer* pushLayer(std::unique_ptr<Layer> pLayer) { return m_layerStack.pushLayer(std::move(pLayer)); }
+
+		/**
+		 * @brief Добавляет оверлей поверх всех слоёв.
+		 * 
+		 * @return Указатель на слой; слоем владеет приложение.
+		 */
+		Layer* pushOverlay(std::unique_ptr<Layer> pLayer) { return m_layerStack.pushOverlay(std::move(pLayer)); }
+
+		/**
+		 * @brief Удаляет слой и возвращает владение им.
+		 */
+		std::unique_ptr<Layer> popLayer(Layer* pLayer) { return m_layerStack.popLayer(pLayer); }
+
+		/**
+		 * @brief Включает отладочный интерфейс ImGui (включён по умолчанию).
+		 * 
+		 * Без интерфейса контекст ImGui не создаётся и кадр не тратит на него время.
+		 * 
+		 * @note Вызывается до `run()`.
+		 */
+		void setImGuiEnabled(bool bEnabled) noexcept { m_bImGuiEnabled = bEnabled; }
+
+		/**
+		 * @brief Показывает или скрывает интерфейс ImGui; скрытый интерфейс не строится.
+		 */
+		void setImGuiVisible(bool bVisible);
+
+		/**
+		 * @brief Задаёт частоту перестроения интерфейса ImGui, когда нет ввода.
+		 * 
+		 * Интерфейс рисуется каждый кадр, но перестраивается с этой частотой
+		 * или сразу после ввода.
+		 * 
+		 * @param rate частота в Гц; 0 - каждый кадр.
+		 */
+		void setImGuiUpdateRate(float rate);
+
+		/**
+		 * @brief Включает запись событий окна в файл.
+		 * 
+		 * Все события, переданные в `EventDispatcher`, записываются вместе с номером
+		 * кадра и временем. Запись завершается при выходе из `run()`.
+		 * 
+		 * @note Вызывается до `run()`.
+		 */
+		void setInputRecording(const std::string& path) { m_inputRecordingPath = path; }
+
+		/**
+		 * @brief Включает воспроизведение записанных событий.
+		 * 
+		 * В режиме воспроизведения события окна (кроме закрытия) игнорируются,
+		 * записанные события передаются в `EventDispatcher` в тех же кадрах,
+		 * `getDeltaTime()` возвращает фиксированный шаг, а `run()` завершается
+		 * после последнего кадра записи. Два прогона одной записи выполняют
+		 * одинаковую работу и сравнимы покадрово.
+		 * 
+		 * @param path файл, созданный при `setInputRecording()`.
+		 * @param fixedDeltaTime шаг времени кадра в секундах.
+		 * 
+		 * @note Вызывается до `run()`.
+		 */
+		void setInputReplay(const std::string& path, float fixedDeltaTime = 1.f / 60.f) {
+			m_inputReplayPath = path;
+			m_fixedDeltaTime = fixedDeltaTime;
+		}
+
+		/**
+		 * @brief Включает запись времени каждого кадра в JSON при выходе из `run()`.
+		 * 
+		 * @note Вызывается до `run()`.
+		 */
+		void setFrameTimingDump(const std::string& path) { m_frameTimingPath = path; }
+
+		/**
+		 * @brief Возвращает время прошлого кадра в секундах (фиксированное при воспроизведении).
+		 */
+		float getDeltaTime() const noexcept { return m_deltaTime; }
+
+		/**
+		 * @brief Возвращает номер текущего кадра.
+		 */
+		uint64_t getFrameIndex() const noexcept { return m_frameIndex; }
 	
 	private:
-		std::unique_ptr<class Window>	m_pWindow;
-		EventDispatcher 				m_eventDispatcher;
-		bool 							m_bCloseWindow 		= false;
+		std::unique_ptr<class Window>			m_pWindow;
+		EventDispatcher 						m_eventDispatcher;
+		bool 									m_bCloseWindow 		= false;
+
+		// Слои уничтожаются раньше окна.
+		LayerStack								m_layerStack;
+		class ImGuiLayer*						m_pImGuiLayer		= nullptr;
+		bool									m_bImGuiEnabled		= true;
+		bool									m_bImGuiVisible		= true;
+		float									m_imGuiUpdateRate	= 30.f;	///< Как `ImGuiLayer::DefaultUpdateRate`.
+
+		std::unique_ptr<class InputRecorder>	m_pInputRecorder;
+		std::unique_ptr<class InputPlayer>		m_pInputPlayer;
+		std::unique_ptr<class FrameTimingLog>	m_pFrameTimingLog;
+		std::string								m_inputRecordingPath;
+		std::string								m_inputReplayPath;
+		std::string								m_frameTimingPath;
+		float									m_fixedDeltaTime	= 1.f / 60.f;
+		float									m_deltaTime			= 0.f;
+		uint64_t								m_frameIndex		= 0;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EngineCore/Event.hpp"
+
+namespace Engine {
+
+	/**
+	 * @brief Слой приложения: часть логики и отрисовки кадра.
+	 *
+	 * Слои хранятся в `LayerStack` приложения. Каждый кадр `onUpdate()` и
+	 * `onRender()` вызываются снизу вверх (3D сцена, затем оверлеи), а события
+	 * передаются сверху вниз, пока какой-нибудь слой их не обработает.
+	 *
+	 * Пример использования
+	 * @code
+	 * class GameLayer : public Engine::Layer {
+	 * public:
+	 *     GameLayer() : Layer("Game") {}
+	 *
+	 *     void onUpdate(float deltaTime) override { m_time += deltaTime; }
+	 *     bool onEvent(Engine::Event& event) override { return false; }
+	 *
+	 * private:
+	 *     float m_time = 0.f;
+	 * };
+	 *
+	 * app->pushLayer(std::make_unique<GameLayer>());
+	 * @endcode
+	 */
+	class Layer {
+	public:
+		explicit Layer(std::string name) : m_name(std::move(name)) {}
+		virtual ~Layer() = default;
+
+		Layer(const Layer&)				= delete;
+		Layer& operator=(const Layer&)	= delete;
+
+		/**
+		 * @brief Вызывается при добавлении в стек, когда окно и контекст OpenGL уже созданы.
+		 */
+		virtual void onAttach() {}
+
+		/**
+		 * @brief Вызывается при удалении из стека или перед закрытием окна.
+		 */
+		virtual void onDetach() {}
+
+		/**
+		 * @brief Обновляет логику слоя.
+		 * @param deltaTime время прошлого кадра в секундах.
+		 */
+		virtual void onUpdate(float /*deltaTime*/) {}
+
+		/**
+		 * @brief Рисует слой поверх слоёв ниже.
+		 */
+		virtual void onRender() {}
+
+		/**
+		 * @brief Рисует ImGui окна слоя.
+		 *
+		 * Вызывается слоем ImGui только в кадрах, когда интерфейс перестраивается,
+		 * и не вызывается вовсе, если ImGui выключен или скрыт.
+		 */
+		virtual void onImGuiRender() {}
+
+		/**
+		 * @brief Обрабатывает событие.
+		 * @return true, если событие обработано и не передаётся слоям ниже.
+		 */
+		virtual bool onEvent(Event& /*event*/) { return false; }
+
+		const std::string& getName() const noexcept { return m_name; }
+
+		/**
+		 * @brief Выключенный слой пропускается в обновлении, отрисовке и событиях.
+		 */
+		void setEnabled(bool bEnabled) noexcept { m_bEnabled = bEnabled; }
+		bool isEnabled() const noexcept { return m_bEnabled; }
+
+	private:
+		std::string	m_name;
+		bool		m_bEnabled	= true;
+	};
+
+	/**
+	 * @brief Время слоя в прошлом кадре.
+	 */
+	struct LayerTiming {
+		const Layer*	pLayer		= nullptr;
+		float			updateMs	= 0.f;
+		float			renderMs	= 0.f;
+		bool			bOverlay	= false;
+	};
+
+	/**
+	 * @brief Стек слоёв: обычные слои снизу, оверлеи (интерфейс) всегда сверху.
+	 *
+	 * Стек владеет слоями. Время `onUpdate()` и `onRender()` каждого слоя
+	 * измеряется и доступно через `getTimings()`.
+	 */
+	class LayerStack {
+	public:
+		LayerStack() = default;
+		~LayerStack();
+
+		LayerStack(const LayerStack&)				= delete;
+		LayerStack& operator=(const LayerStack&)	= delete;
+
+		/**
+		 * @brief Добавляет слой над обычными слоями, но под оверлеями.
+		 * @return Указатель на добавленный слой (владеет стек).
+		 */
+		Layer* pushLayer(std::unique_ptr<Layer> pLayer);
+
+		/**
+		 * @brief Добавляет оверлей поверх всех слоёв.
+		 * @return Указатель на добавленный слой (владеет стек).
+		 */
+		Layer* pushOverlay(std::unique_ptr<Layer> pLayer);
+
+		/**
+		 * @brief Удаляет слой из стека и возвращает владение им.
+		 */
+		std::unique_ptr<Layer> popLayer(Layer* pLayer);
+
+		/**
+		 * @brief Вызывает `onAttach()` всех слоёв; слои, добавленные позже, подключаются сразу.
+		 */
+		void attach();
+
+		/**
+		 * @brief Вызывает `onDetach()` всех слоёв сверху вниз.
+		 */
+		void detach();
+
+		void update(float deltaTime);
+		void render();
+
+		/**
+		 * @brief Передаёт событие слоям сверху вниз.
+		 * @return true, если какой-то слой обработал событие.
+		 */
+		bool dispatch(Event& event);
+
+		/**
+		 * @brief Вызывает `onImGuiRender()` включённых слоёв снизу вверх.
+		 */
+		void drawImGui();
+
+		const std::vector<LayerTiming>& getTimings() const noexcept { return m_timings; }
+		size_t getSize() const noexcept { return m_layers.size(); }
+
+	private:
+		std::vector<std::unique_ptr<Layer>>	m_layers;
+		std::vector<LayerTiming>			m_timings;		///< Параллелен `m_layers`.
+		size_t								m_overlayStart	= 0;	///< Индекс первого оверлея.
+		bool								m_bAttached		= false;
+	};
+
+} // namespace Engine
@@ -13,10 +13,14 @@ namespace Engine {
 
 #else
 
-#define LOG_INFO(...)	spdlog::info(__VA_ARGS__)
-#define LOG_WARN(...)	spdlog::warn("[{}:{}]" __VA_ARGS__, __FILE__, __LINE__)
-#define LOG_ERR(...)	spdlog::error("[{}:{}]" __VA_ARGS__, __FILE__, __LINE__)
-#define LOG_CRIT(...)	spdlog::critical("[{}:{}]" __VA_ARGS__, __FILE__, __LINE__)
+// Место вызова передаётся через `source_loc` (в шаблоне вывода `%s:%#`): spdlog
+// проверяет уровень до форматирования, отфильтрованный вызов не обращается к куче.
+#define ENGINE_LOG(level, ...)	spdlog::log(spdlog::source_loc{ __FILE__, __LINE__, SPDLOG_FUNCTION }, level, __VA_ARGS__)
+
+#define LOG_INFO(...)	ENGINE_LOG(spdlog::level::info, __VA_ARGS__)
+#define LOG_WARN(...)	ENGINE_LOG(spdlog::level::warn, __VA_ARGS__)
+#define LOG_ERR(...)	ENGINE_LOG(spdlog::level::err, __VA_ARGS__)
+#define LOG_CRIT(...)	ENGINE_LOG(spdlog::level::critical, __VA_ARGS__)
 
 #endif
 
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace Engine {
+
+	/**
+	 * @brief Трёхкомпонентный вектор.
+	 */
+	struct Vec3 {
+		float x = 0.f, y = 0.f, z = 0.f;
+
+		constexpr Vec3() = default;
+		constexpr Vec3(const float _x, const float _y, const float _z) : x(_x), y(_y), z(_z) {}
+		constexpr explicit Vec3(const float v) : x(v), y(v), z(v) {}
+
+		constexpr Vec3 operator+(const Vec3& rhs) const noexcept { return { x + rhs.x, y + rhs.y, z + rhs.z }; }
+		constexpr Vec3 operator-(const Vec3& rhs) const noexcept { return { x - rhs.x, y - rhs.y, z - rhs.z }; }
+		constexpr Vec3 operator*(const Vec3& rhs) const noexcept { return { x * rhs.x, y * rhs.y, z * rhs.z }; }
+		constexpr Vec3 operator*(const float s) const noexcept { return { x * s, y * s, z * s }; }
+		constexpr Vec3 operator-() const noexcept { return { -x, -y, -z }; }
+
+		Vec3& operator+=(const Vec3& rhs) noexcept { x += rhs.x; y += rhs.y; z += rhs.z; return *this; }
+		Vec3& operator-=(const Vec3& rhs) noexcept { x -= rhs.x; y -= rhs.y; z -= rhs.z; return *this; }
+		Vec3& operator*=(const float s) noexcept { x *= s; y *= s; z *= s; return *this; }
+	};
+
+	/**
+	 * @brief Четырёхкомпонентный вектор.
+	 */
+	struct Vec4 {
+		float x = 0.f, y = 0.f, z = 0.f, w = 0.f;
+
+		constexpr Vec4() = default;
+		constexpr Vec4(const float _x, const float _y, const float _z, const float _w)
+			: x(_x), y(_y), z(_z), w(_w) {}
+		constexpr Vec4(const Vec3& v, const float _w) : x(v.x), y(v.y), z(v.z), w(_w) {}
+
+		constexpr Vec3 xyz() const noexcept { return { x, y, z }; }
+	};
+
+	constexpr float dot(const Vec3& a, const Vec3& b) noexcept { return a.x * b.x + a.y * b.y + a.z * b.z; }
+	constexpr float dot(const Vec4& a, const Vec4& b) noexcept { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+
+	constexpr Vec3 cross(const Vec3& a, const Vec3& b) noexcept {
+		return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+	}
+
+	inline float length(const Vec3& v) noexcept { return std::sqrt(dot(v, v)); }
+
+	inline Vec3 normalize(const Vec3& v) noexcept {
+		const float len = length(v);
+		return len > 0.f ? v * (1.f / len) : v;
+	}
+
+	/**
+	 * @brief Кватернион вращения (x, y, z - векторная часть, w - скалярная).
+	 */
+	struct Quat {
+		float x = 0.f, y = 0.f, z = 0.f, w = 1.f;
+
+		constexpr Quat() = default;
+		constexpr Quat(const float _x, const float _y, const float _z, const float _w)
+			: x(_x), y(_y), z(_z), w(_w) {}
+
+		/// @brief Создаёт кватернион поворота на угол `radians` вокруг оси `axis`.
+		/// @param axis Ось вращения (нормализуется внутри).
+		/// @param radians Угол в радианах.
+		static Quat fromAxisAngle(const Vec3& axis, const float radians) noexcept {
+			const Vec3 n = normalize(axis);
+			const float s = std::sin(radians * 0.5f);
+			return { n.x * s, n.y * s, n.z * s, std::cos(radians * 0.5f) };
+		}
+
+		constexpr Quat operator*(const Quat& q) const noexcept {
+			return {
+				w * q.x + x * q.w + y * q.z - z * q.y,
+				w * q.y - x * q.z + y * q.w + z * q.x,
+				w * q.z + x * q.y - y * q.x + z * q.w,
+				w * q.w - x * q.x - y * q.y - z * q.z
+			};
+		}
+	};
+
+	/**
+	 * @brief Матрица 4x4, хранящаяся по столбцам (column-major), как ожидает OpenGL.
+	 *
+	 * Элемент строки `row` столбца `col` находится в `m[col * 4 + row]`, поэтому
+	 * массив `m` можно напрямую передавать в `glUniformMatrix4fv` или копировать в буфер.
+	 */
+	struct Mat4 {
+		float m[16] = {
+			1.f, 0.f, 0.f, 0.f,
+			0.f, 1.f, 0.f, 0.f,
+			0.f, 0.f, 1.f, 0.f,
+			0.f, 0.f, 0.f, 1.f
+		};
+
+		float& operator()(const int row, const int col) noexcept { return m[col * 4 + row]; }
+		float operator()(const int row, const int col) const noexcept { return m[col * 4 + row]; }
+
+		const float* data() const noexcept { return m; }
+
+		static Mat4 identity() noexcept { return Mat4{}; }
+
+		/// @brief Собирает матрицу из переноса, вращения и масштаба (T * R * S).
+		static Mat4 fromTRS(const Vec3& t, const Quat& r, const Vec3& s) noexcept {
+			const float xx = r.x * r.x, yy = r.y * r.y, zz = r.z * r.z;
+			const float xy = r.x * r.y, xz = r.x * r.z, yz = r.y * r.z;
+			const float wx = r.w * r.x, wy = r.w * r.y, wz = r.w * r.z;
+
+			Mat4 res;
+			res.m[0]  = (1.f - 2.f * (yy + zz)) * s.x;
+			res.m[1]  = (2.f * (xy + wz)) * s.x;
+			res.m[2]  = (2.f * (xz - wy)) * s.x;
+			res.m[3]  = 0.f;
+			res.m[4]  = (2.f * (xy - wz)) * s.y;
+			res.m[5]  = (1.f - 2.f * (xx + zz)) * s.y;
+			res.m[6]  = (2.f * (yz + wx)) * s.y;
+			res.m[7]  = 0.f;
+			res.m[8]  = (2.f * (xz + wy)) * s.z;
+			res.m[9]  = (2.f * (yz - wx)) * s.z;
+			res.m[10] = (1.f - 2.f * (xx + yy)) * s.z;
+			res.m[11] = 0.f;
+			res.m[12] = t.x;
+			res.m[13] = t.y;
+			res.m[14] = t.z;
+			res.m[15] = 1.f;
+			return res;
+		}
+
+		static Mat4 translation(const Vec3& t) noexcept {
+			Mat4 res;
+			res.m[12] = t.x; res.m[13] = t.y; res.m[14] = t.z;
+			return res;
+		}
+
+		static Mat4 scale(const Vec3& s) noexcept {
+			Mat4 res;
+			res.m[0] = s.x; res.m[5] = s.y; res.m[10] = s.z;
+			return res;
+		}
+
+		/// @brief Перспективная проекция (правосторонняя система, глубина в [-1, 1]).
+		/// @param fovY Вертикальный угол обзора в радианах.
+		/// @param aspect Отношение ширины к высоте.
+		/// @param zNear Ближняя плоскость отсечения.
+		/// @param zFar Дальняя плоскость отсечения.
+		static Mat4 perspective(const float fovY, const float aspect, const float zNear, const float zFar) noexcept {
+			const float f = 1.f / std::tan(fovY * 0.5f);
+			Mat4 res;
+			res.m[0]  = f / aspect;
+			res.m[5]  = f;
+			res.m[10] = (zFar + zNear) / (zNear - zFar);
+			res.m[11] = -1.f;
+			res.m[14] = (2.f * zFar * zNear) / (zNear - zFar);
+			res.m[15] = 0.f;
+			return res;
+		}
+
+		/// @brief Ортографическая проекция (глубина в [-1, 1]).
+		static Mat4 ortho(
+			const float left,	const float right,
+			const float bottom,	const float top,
+			const float zNear,	const float zFar
+		) noexcept {
+			Mat4 res;
+			res.m[0]  = 2.f / (right - left);
+			res.m[5]  = 2.f / (top - bottom);
+			res.m[10] = -2.f / (zFar - zNear);
+			res.m[12] = -(right + left) / (right - left);
+			res.m[13] = -(top + bottom) / (top - bottom);
+			res.m[14] = -(zFar + zNear) / (zFar - zNear);
+			return res;
+		}
+
+		/// @brief Матрица вида камеры, расположенной в `eye` и смотрящей на `target`.
+		static Mat4 lookAt(const Vec3& eye, const Vec3& target, const Vec3& up) noexcept {
+			const Vec3 f = normalize(target - eye);
+			const Vec3 s = normalize(cross(f, up));
+			const Vec3 u = cross(s, f);
+
+			Mat4 res;
+			res.m[0] = s.x;  res.m[4] = s.y;  res.m[8]  = s.z;
+			res.m[1] = u.x;  res.m[5] = u.y;  res.m[9]  = u.z;
+			res.m[2] = -f.x; res.m[6] = -f.y; res.m[10] = -f.z;
+			res.m[12] = -dot(s, eye);
+			res.m[13] = -dot(u, eye);
+			res.m[14] = dot(f, eye);
+			return res;
+		}
+
+		Mat4 operator*(const Mat4& rhs) const noexcept {
+			Mat4 res;
+			for (int col = 0; col < 4; ++col) {
+				const float b0 = rhs.m[col * 4 + 0];
+				const float b1 = rhs.m[col * 4 + 1];
+				const float b2 = rhs.m[col * 4 + 2];
+				const float b3 = rhs.m[col * 4 + 3];
+				for (int row = 0; row < 4; ++row) {
+					res.m[col * 4 + row] =
+						m[row] * b0 + m[4 + row] * b1 + m[8 + row] * b2 + m[12 + row] * b3;
+				}
+			}
+			return res;
+		}
+
+		Vec4 operator*(const Vec4& v) const noexcept {
+			return {
+				m[0] * v.x + m[4] * v.y + m[8]  * v.z + m[12] * v.w,
+				m[1] * v.x + m[5] * v.y + m[9]  * v.z + m[13] * v.w,
+				m[2] * v.x + m[6] * v.y + m[10] * v.z + m[14] * v.w,
+				m[3] * v.x + m[7] * v.y + m[11] * v.z + m[15] * v.w
+			};
+		}
+
+		/// @brief Преобразует точку (w = 1) без перспективного деления.
+		Vec3 transformPoint(const Vec3& p) const noexcept {
+			return {
+				m[0] * p.x + m[4] * p.y + m[8]  * p.z + m[12],
+				m[1] * p.x + m[5] * p.y + m[9]  * p.z + m[13],
+				m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]
+			};
+		}
+
+		/// @brief Преобразует направление (w = 0).
+		Vec3 transformVector(const Vec3& v) const noexcept {
+			return {
+				m[0] * v.x + m[4] * v.y + m[8]  * v.z,
+				m[1] * v.x + m[5] * v.y + m[9]  * v.z,
+				m[2] * v.x + m[6] * v.y + m[10] * v.z
+			};
+		}
+	};
+
+	/// @brief Произведение двух аффинных матриц (нижняя строка обеих равна 0 0 0 1).
+	///
+	/// Не читает нижнюю строку `b`, что позволяет компилятору развернуть и
+	/// векторизовать вычисление по столбцам. Используется там, где матрицы гарантированно
+	/// аффинные (например, при обходе иерархии трансформаций).
+	inline Mat4 multiplyAffine(const Mat4& a, const Mat4& b) noexcept {
+		Mat4 res;
+		for (int col = 0; col < 4; ++col) {
+			const float b0 = b.m[col * 4 + 0];
+			const float b1 = b.m[col * 4 + 1];
+			const float b2 = b.m[col * 4 + 2];
+			const float b3 = col == 3 ? 1.f : 0.f;
+			for (int row = 0; row < 4; ++row) {
+				res.m[col * 4 + row] =
+					a.m[row] * b0 + a.m[4 + row] * b1 + a.m[8 + row] * b2 + a.m[12 + row] * b3;
+			}
+		}
+		return res;
+	}
+
+	/// @brief Обратная матрица общего вида (метод алгебраических дополнений).
+	///
+	/// Для вырожденной матрицы возвращает единичную. Нужна, например, чтобы
+	/// получить углы пирамиды видимости из матрицы вида-проекции.
+	inline Mat4 inverse(const Mat4& a) noexcept {
+		const float* m = a.m;
+		Mat4 inv;
+		float* r = inv.m;
+
+		r[0]  =  m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+		r[4]  = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+		r[8]  =  m[4] * m[9]  * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+		r[12] = -m[4] * m[9]  * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+		r[1]  = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+		r[5]  =  m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+		r[9]  = -m[0] * m[9]  * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+		r[13] =  m[0] * m[9]  * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+		r[2]  =  m[1] * m[6]  * m[15] - m[1] * m[7]  * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7]  - m[13] * m[3] * m[6];
+		r[6]  = -m[0] * m[6]  * m[15] + m[0] * m[7]  * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7]  + m[12] * m[3] * m[6];
+		r[10] =  m[0] * m[5]  * m[15] - m[0] * m[7]  * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7]  - m[12] * m[3] * m[5];
+		r[14] = -m[0] * m[5]  * m[14] + m[0] * m[6]  * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6]  + m[12] * m[2] * m[5];
+		r[3]  = -m[1] * m[6]  * m[11] + m[1] * m[7]  * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9]  * m[2] * m[7]  + m[9]  * m[3] * m[6];
+		r[7]  =  m[0] * m[6]  * m[11] - m[0] * m[7]  * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8]  * m[2] * m[7]  - m[8]  * m[3] * m[6];
+		r[11] = -m[0] * m[5]  * m[11] + m[0] * m[7]  * m[9]  + m[4] * m[1] * m[11] - m[4] * m[3] * m[9]  - m[8]  * m[1] * m[7]  + m[8]  * m[3] * m[5];
+		r[15] =  m[0] * m[5]  * m[10] - m[0] * m[6]  * m[9]  - m[4] * m[1] * m[10] + m[4] * m[2] * m[9]  + m[8]  * m[1] * m[6]  - m[8]  * m[2] * m[5];
+
+		const float det = m[0] * r[0] + m[1] * r[4] + m[2] * r[8] + m[3] * r[12];
+		if (det == 0.f) {
+			return Mat4::identity();
+		}
+		const float invDet = 1.f / det;
+		for (float& value : inv.m) {
+			value *= invDet;
+		}
+		return inv;
+	}
+
+} // namespace Engine
@@ -1,11 +1,19 @@
 #include "EngineCore/Application.hpp"
 
+#include <chrono>
+
+#include "EngineCore/Core/FrameTimingLog.hpp"
+#include "EngineCore/Core/InputRecording.hpp"
+#include "EngineCore/ImGuiLayer.hpp"
 #include "EngineCore/Log.hpp"
+#include "EngineCore/Render/RenderStats.hpp"
 #include "EngineCore/Window.hpp"
 
 namespace Engine {
 
 	Application::Application() {
+		// `[%s:%#]` - файл и строка из LOG_* макросов.
+		spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [%s:%#] %v");
         LOG_INFO("Starting application");
 	};
 
@@ -13,6 +21,20 @@ namespace Engine {
         LOG_INFO("Closing application");
 	};
 
+	void Application::setImGuiVisible(const bool bVisible) {
+		m_bImGuiVisible = bVisible;
+		if (m_pImGuiLayer) {
+			m_pImGuiLayer->setVisible(bVisible);
+		}
+	}
+
+	void Application::setImGuiUpdateRate(const float rate) {
+		m_imGuiUpdateRate = rate;
+		if (m_pImGuiLayer) {
+			m_pImGuiLayer->setUpdateRate(rate);
+		}
+	}
+
 	int8_t Application::run(
 		uint16_t			windowWidth,
 		uint16_t			windowHeight,
@@ -23,6 +45,11 @@ namespace Engine {
             windowWidth,
             windowHeight
         );
+        if (!m_pWindow->isInitialized()) {
+            LOG_CRIT("Window initialization failed");
+            m_pWindow.reset();
+            return -1;
+        }
 
         m_eventDispatcher.addListener<EventMouseMove>(
             [](EventMouseMove& e) { 
@@ -42,15 +69,109 @@ namespace Engine {
             }
         );
 
+        if (!m_inputReplayPath.empty()) {
+            m_pInputPlayer = std::make_unique<InputPlayer>();
+            if (!m_pInputPlayer->load(m_inputReplayPath)) {
+                return -1;
+            }
+        }
+        else if (!m_inputRecordingPath.empty()) {
+            m_pInputRecorder = std::make_unique<InputRecorder>();
+            if (!m_pInputRecorder->start(m_inputRecordingPath)) {
+                m_pInputRecorder.reset();
+            }
+        }
+        if (!m_frameTimingPath.empty()) {
+            m_pFrameTimingLog = std::make_unique<FrameTimingLog>();
+        }
+
         m_pWindow->setEventCallback(
             [&](Event& event) {
-                m_eventDispatcher.dispatch(event);
+                if (m_pInputPlayer) {
+                    // При воспроизведении живой ввод не влияет на кадр, но окно можно закрыть.
+                    if (event.getType() == EventType::WindowClose) {
+                        m_bCloseWindow = true;
+                    }
+                    return;
+                }
+                if (m_pInputRecorder) {
+                    m_pInputRecorder->record(event, m_frameIndex);
+                }
+                // Слои получают событие сверху вниз; необработанное уходит в EventDispatcher.
+                if (!m_layerStack.dispatch(event)) {
+                    m_eventDispatcher.dispatch(event);
+                }
             }
         );
 
+        if (m_bImGuiEnabled) {
+            auto pImGuiLayer = std::make_unique<ImGuiLayer>(*m_pWindow, m_layerStack);
+            pImGuiLayer->setVisible(m_bImGuiVisible);
+            pImGuiLayer->setUpdateRate(m_imGuiUpdateRate);
+            m_pImGuiLayer = pImGuiLayer.get();
+            m_layerStack.pushOverlay(std::move(pImGuiLayer));
+        }
+        m_layerStack.attach();
+
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point lastFrameTime = Clock::now();
+
         while (!m_bCloseWindow) {
+            const Clock::time_point frameStart = Clock::now();
+            m_deltaTime = m_pInputPlayer
+                ? m_fixedDeltaTime
+                : std::chrono::duration<float>(frameStart - lastFrameTime).count();
+            lastFrameTime = frameStart;
+
             m_pWindow->update();
+            const Clock::time_point windowEnd = Clock::now();
+
+            m_layerStack.update(m_deltaTime);
+            m_layerStack.render();
+            const Clock::time_point layersEnd = Clock::now();
+
             update();
+            const Clock::time_point updateEnd = Clock::now();
+
+            // События кадра N записываются в glfwPollEvents() в `Window::present()`
+            // и воспроизводятся в той же точке кадра.
+            m_pWindow->present();
+            if (m_pInputPlayer) {
+                m_pInputPlayer->dispatchFrame(m_frameIndex, [&](Event& event) {
+                    if (!m_layerStack.dispatch(event)) {
+                        m_eventDispatcher.dispatch(event);
+                    }
+                });
+            }
+            const Clock::time_point frameEnd = Clock::now();
+
+            if (m_pFrameTimingLog) {
+                FrameTiming timing;
+                timing.frameIndex = m_frameIndex;
+                timing.frameMs = std::chrono::duration<float, std::milli>(frameEnd - frameStart).count();
+                timing.windowMs = std::chrono::duration<float, std::milli>((windowEnd - frameStart) + (frameEnd - updateEnd)).count();
+                timing.layersMs = std::chrono::duration<float, std::milli>(layersEnd - windowEnd).count();
+                timing.updateMs = std::chrono::duration<float, std::milli>(updateEnd - layersEnd).count();
+                timing.drawCalls = RenderStats::getLastFrameStats().drawCalls;
+                m_pFrameTimingLog->addFrame(timing);
+            }
+
+            ++m_frameIndex;
+            if (m_pInputPlayer && m_pInputPlayer->isFinished(m_frameIndex)) {
+                LOG_INFO("Input replay finished after {0} frames", m_frameIndex);
+                m_bCloseWindow = true;
+            }
+        }
+
+        // Слои могут держать GL объекты и контекст ImGui: отключаются до закрытия окна.
+        m_layerStack.detach();
+        m_pImGuiLayer = nullptr;
+
+        if (m_pInputRecorder) {
+            m_pInputRecorder->stop(m_frameIndex);
+        }
+        if (m_pFrameTimingLog) {
+            m_pFrameTimingLog->write(m_frameTimingPath);
         }
         
         return 0;
@@ -0,0 +1,519 @@
+#include "EngineCore/Assets/AssetManager.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include <imgui/imgui.h>
+
+#include "EngineCore/Core/Hash.hpp"
+#include "EngineCore/Core/JobSystem.hpp"
+#include "EngineCore/Core/MappedFile.hpp"
+#include "EngineCore/Log.hpp"
+#include "EngineCore/Render/OpenGL/ShaderProgram.hpp"
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Смешивает параметры загрузки текстуры в хеш содержимого:
+	/// один файл с разными параметрами - разные ресурсы.
+	static uint64_t getTextureParamsSeed(const TextureLoadParams& params) noexcept {
+		const uint8_t bytes[3] = {
+			static_cast<uint8_t>(params.bSRGB),
+			static_cast<uint8_t>(params.bGenerateMips),
+			static_cast<uint8_t>(params.compression)
+		};
+		return hash64(bytes, sizeof(bytes));
+	}
+
+	static bool readTextFile(const std::string& path, std::string& text) {
+		MappedFile file;
+		if (!file.open(path)) {
+			LOG_ERR("Can not open file {0}", path);
+			return false;
+		}
+		text.assign(reinterpret_cast<const char*>(file.getData()), file.getSize());
+		return true;
+	}
+
+	static const char* getAssetTypeName(AssetType type) noexcept {
+		switch (type) {
+		case AssetType::Texture:	return "Texture";
+		case AssetType::Shader:		return "Shader";
+		case AssetType::Count:		break;
+		}
+		return "Unknown";
+	}
+
+	static const char* getAssetStateName(AssetState state) noexcept {
+		switch (state) {
+		case AssetState::Queued:	return "Queued";
+		case AssetState::Loading:	return "Loading";
+		case AssetState::Prepared:	return "Prepared";
+		case AssetState::Ready:		return "Ready";
+		case AssetState::Failed:	return "Failed";
+		}
+		return "Unknown";
+	}
+
+	AssetManager::AssetManager(JobSystem& jobSystem, TextureLoader& textureLoader)
+		: m_jobSystem(jobSystem)
+		, m_textureLoader(textureLoader)
+	{}
+
+	AssetManager::~AssetManager() {
+		// Задачи загрузки обращаются к менеджеру, дожидаемся их завершения.
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_preparedCondition.wait(lock, [this]() { return m_inFlight == 0; });
+		m_slots.clear();
+	}
+
+	uint32_t AssetManager::acquireSlot(AssetType type, const std::string& key, AssetPriority priority, bool& bExisting) {
+		auto& byKey = m_byKey[static_cast<size_t>(type)];
+		const auto it = byKey.find(key);
+		if (it != byKey.end()) {
+			Slot& slot = m_slots[it->second];
+			++slot.refCount;
+			++m_pathHits;
+
+			// Ресурс ещё в очереди: повышаем приоритет, если новый запрос важнее.
+			if (priority < slot.priority && slot.state == AssetState::Queued) {
+				slot.priority = priority;
+				m_queues[static_cast<size_t>(priority)].push_back({ it->second, slot.generation });
+			}
+			bExisting = true;
+			return it->second;
+		}
+
+		uint32_t index;
+		if (!m_freeSlots.empty()) {
+			index = m_freeSlots.back();
+			m_freeSlots.pop_back();
+		}
+		else {
+			index = static_cast<uint32_t>(m_slots.size());
+			m_slots.emplace_back();
+		}
+
+		Slot& slot = m_slots[index];
+		slot.bUsed = true;
+		slot.refCount = 1;
+		slot.type = type;
+		slot.priority = priority;
+		slot.state = AssetState::Queued;
+		slot.key = key;
+		byKey.emplace(key, index);
+
+		bExisting = false;
+		return index;
+	}
+
+	void AssetManager::freeSlot(uint32_t index) {
+		Slot& slot = m_slots[index];
+		const size_t type = static_cast<size_t>(slot.type);
+
+		const auto keyIt = m_byKey[type].find(slot.key);
+		if (keyIt != m_byKey[type].end() && keyIt->second == index) {
+			m_byKey[type].erase(keyIt);
+		}
+		const auto hashIt = m_byHash[type].find(slot.contentHash);
+		if (slot.contentHash != 0 && hashIt != m_byHash[type].end() && hashIt->second == index) {
+			m_byHash[type].erase(hashIt);
+		}
+
+		const uint32_t generation = slot.generation + 1;
+		slot = Slot{};
+		slot.generation = generation != 0 ? generation : 1;
+		m_freeSlots.push_back(index);
+	}
+
+	TextureRef AssetManager::loadTexture(const std::string& path, const TextureLoadParams& params, AssetPriority priority) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		bool bExisting;
+		const uint32_t index = acquireSlot(AssetType::Texture, path, priority, bExisting);
+		Slot& slot = m_slots[index];
+		if (!bExisting) {
+			slot.paths[0] = path;
+			slot.textureParams = params;
+			m_queues[static_cast<size_t>(priority)].push_back({ index, slot.generation });
+		}
+		return TextureRef(this, { index, slot.generation });
+	}
+
+	ShaderRef AssetManager::loadShader(const std::string& vertexPath, const std::string& fragmentPath, AssetPriority priority) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		bool bExisting;
+		const uint32_t index = acquireSlot(AssetType::Shader, vertexPath + "|" + fragmentPath, priority, bExisting);
+		Slot& slot = m_slots[index];
+		if (!bExisting) {
+			slot.paths[0] = vertexPath;
+			slot.paths[1] = fragmentPath;
+			m_queues[static_cast<size_t>(priority)].push_back({ index, slot.generation });
+		}
+		return ShaderRef(this, { index, slot.generation });
+	}
+
+	ShaderRef AssetManager::createShader(const std::string& name, std::string vertexSource, std::string fragmentSource, AssetPriority priority) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		bool bExisting;
+		const uint32_t index = acquireSlot(AssetType::Shader, name, priority, bExisting);
+		Slot& slot = m_slots[index];
+		if (!bExisting) {
+			// Исходники уже в памяти: чтение файлов пропускается, остаётся только компиляция.
+			slot.contentHash = hash64(fragmentSource, hash64(vertexSource));
+			slot.pPrepared = std::make_unique<PreparedData>();
+			slot.pPrepared->vertexSource = std::move(vertexSource);
+			slot.pPrepared->fragmentSource = std::move(fragmentSource);
+			slot.state = AssetState::Prepared;
+			m_prepared.push_back(index);
+		}
+		return ShaderRef(this, { index, slot.generation });
+	}
+
+	void AssetManager::dispatch() {
+		for (size_t priority = 0; priority < static_cast<size_t>(AssetPriority::Count); ++priority) {
+			std::deque<QueueEntry>& queue = m_queues[priority];
+			while (m_inFlight < m_maxInFlight && !queue.empty()) {
+				const QueueEntry entry = queue.front();
+				queue.pop_front();
+
+				Slot& slot = m_slots[entry.index];
+				// Устаревшие записи: слот освобождён или приоритет ресурса повышен.
+				if (slot.generation != entry.generation || slot.state != AssetState::Queued ||
+					static_cast<size_t>(slot.priority) != priority) {
+					continue;
+				}
+				if (slot.refCount == 0) {
+					++m_cancelled;
+					freeSlot(entry.index);
+					continue;
+				}
+
+				slot.state = AssetState::Loading;
+				++m_inFlight;
+				m_jobSystem.submit([this, entry]() { prepare(entry.index, entry.generation); });
+			}
+		}
+	}
+
+	void AssetManager::prepare(uint32_t index, uint32_t generation) {
+		AssetType type;
+		std::string paths[2];
+		TextureLoadParams params;
+		bool bDedupe;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			const Slot& slot = m_slots[index];
+			type = slot.type;
+			paths[0] = slot.paths[0];
+			paths[1] = slot.paths[1];
+			params = slot.textureParams;
+			bDedupe = !slot.bNoDedupe && slot.refCount > 0;
+		}
+
+		auto pPrepared = std::make_unique<PreparedData>();
+		auto pFile = std::make_shared<MappedFile>();
+		uint64_t contentHash = 0;
+		bool bLoaded;
+
+		if (type == AssetType::Texture) {
+			bLoaded = pFile->open(paths[0]);
+			if (bLoaded) {
+				contentHash = hash64(pFile->getData(), pFile->getSize(), getTextureParamsSeed(params));
+			}
+		}
+		else {
+			bLoaded = readTextFile(paths[0], pPrepared->vertexSource) && readTextFile(paths[1], pPrepared->fragmentSource);
+			if (bLoaded) {
+				contentHash = hash64(pPrepared->fragmentSource, hash64(pPrepared->vertexSource));
+			}
+		}
+
+		// Файл с таким же содержимым уже загружается или загружен: декодировать его не нужно,
+		// ресурс будет разделён в `share()`. Иначе этот слот становится владельцем хеша.
+		bool bDuplicate = false;
+		if (bLoaded && bDedupe) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto& byHash = m_byHash[static_cast<size_t>(type)];
+			const auto it = byHash.find(contentHash);
+			bDuplicate = it != byHash.end() && it->second != index;
+			if (!bDuplicate) {
+				byHash[contentHash] = index;
+			}
+		}
+
+		if (bLoaded && !bDuplicate && type == AssetType::Texture) {
+			bLoaded = m_textureLoader.prepareImage(std::move(pFile), paths[0], params, pPrepared->image, pPrepared->source);
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		--m_inFlight;
+		m_preparedCondition.notify_all();
+
+		Slot& slot = m_slots[index];
+		if (slot.generation != generation) {
+			return;
+		}
+		slot.contentHash = contentHash;
+
+		if (slot.refCount == 0) {
+			// Все владельцы отказались от ресурса во время загрузки.
+			++m_cancelled;
+			freeSlot(index);
+			return;
+		}
+		if (!bLoaded) {
+			LOG_ERR("Failed to load {0} '{1}'", getAssetTypeName(type), slot.key);
+			slot.state = AssetState::Failed;
+			return;
+		}
+
+		if (!bDuplicate) {
+			slot.pPrepared = std::move(pPrepared);
+		}
+		slot.state = AssetState::Prepared;
+		m_prepared.push_back(index);
+	}
+
+	AssetManager::ECreateResult AssetManager::share(uint32_t index) {
+		// Данные не декодировались: ресурс разделяется с владельцем того же содержимого.
+		Slot& slot = m_slots[index];
+		const size_t type = static_cast<size_t>(slot.type);
+		const auto it = m_byHash[type].find(slot.contentHash);
+		if (it == m_byHash[type].end() || m_slots[it->second].state == AssetState::Failed) {
+			// Владелец выгружен или отменён до создания: загружаем самостоятельно.
+			slot.bNoDedupe = true;
+			slot.state = AssetState::Queued;
+			m_queues[static_cast<size_t>(slot.priority)].push_back({ index, slot.generation });
+			return ECreateResult::Requeued;
+		}
+
+		const Slot& owner = m_slots[it->second];
+		if (!owner.pResource) {
+			return ECreateResult::Deferred;
+		}
+
+		slot.pResource = owner.pResource;
+		slot.state = AssetState::Ready;
+		++m_contentHits;
+		return ECreateResult::Created;
+	}
+
+	std::shared_ptr<void> AssetManager::create(PendingCreate& entry) {
+		PreparedData& prepared = *entry.pPrepared;
+		if (entry.type == AssetType::Texture) {
+			Texture2DPtr pTexture = m_textureLoader.load(std::move(prepared.image), entry.textureParams, prepared.source);
+			pTexture->setLabel(entry.key);
+			return pTexture;
+		}
+
+		auto pProgram = std::make_shared<ShaderProgram>(prepared.vertexSource.c_str(), prepared.fragmentSource.c_str());
+		if (!pProgram->isCompiled()) {
+			LOG_ERR("Failed to compile shader '{0}'", entry.key);
+			return nullptr;
+		}
+		pProgram->setLabel(entry.key);
+		return pProgram;
+	}
+
+	void AssetManager::update() {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		++m_frame;
+
+		dispatch();
+
+		// GL объекты создаются порцией в порядке приоритета.
+		std::stable_sort(m_prepared.begin(), m_prepared.end(), [this](uint32_t lhs, uint32_t rhs) {
+			return m_slots[lhs].priority < m_slots[rhs].priority;
+		});
+
+		uint32_t created = 0;
+		size_t kept = 0;
+		for (size_t i = 0; i < m_prepared.size(); ++i) {
+			const uint32_t index = m_prepared[i];
+			Slot& slot = m_slots[index];
+			if (slot.refCount == 0) {
+				++m_cancelled;
+				freeSlot(index);
+				continue;
+			}
+			if (created < m_createBudget) {
+				if (slot.pPrepared) {
+					m_creating.push_back({ index, slot.type, slot.key, slot.textureParams, std::move(slot.pPrepared), nullptr });
+					++created;
+					continue;
+				}
+				const ECreateResult result = share(index);
+				if (result == ECreateResult::Created) {
+					++created;
+					continue;
+				}
+				if (result == ECreateResult::Requeued) {
+					continue;
+				}
+			}
+			m_prepared[kept++] = index;
+		}
+		m_prepared.resize(kept);
+
+		// Компиляция шейдера или создание текстуры идут без блокировки: запросы из других
+		// потоков и завершение задач загрузки их не ждут. Слот в состоянии Prepared
+		// освобождается только в `update()`, поэтому индекс остаётся действительным.
+		lock.unlock();
+		for (PendingCreate& entry : m_creating) {
+			entry.pResource = create(entry);
+		}
+		lock.lock();
+
+		for (PendingCreate& entry : m_creating) {
+			Slot& slot = m_slots[entry.index];
+			slot.pResource = std::move(entry.pResource);
+			slot.state = slot.pResource ? AssetState::Ready : AssetState::Failed;
+			m_byHash[static_cast<size_t>(slot.type)].emplace(slot.contentHash, entry.index);
+		}
+		m_creating.clear();
+
+		// Отложенная выгрузка: ресурс освобождается, если ссылки не появились за `m_unloadDelay` кадров.
+		kept = 0;
+		for (size_t i = 0; i < m_pendingUnload.size(); ++i) {
+			const QueueEntry entry = m_pendingUnload[i];
+			Slot& slot = m_slots[entry.index];
+			if (slot.generation != entry.generation || slot.refCount > 0) {
+				continue;
+			}
+			// Загружаемые ресурсы освобождаются по завершении задачи, ожидающие создания - выше.
+			if (slot.state != AssetState::Ready && slot.state != AssetState::Failed && slot.state != AssetState::Queued) {
+				continue;
+			}
+			if (m_frame - slot.releasedFrame < m_unloadDelay && slot.state != AssetState::Queued) {
+				m_pendingUnload[kept++] = entry;
+				continue;
+			}
+
+			if (slot.state == AssetState::Ready) {
+				++m_unloaded;
+			}
+			else {
+				++m_cancelled;
+			}
+			freeSlot(entry.index);
+		}
+		m_pendingUnload.resize(kept);
+	}
+
+	uint32_t AssetManager::getCriticalPendingCount() {
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		uint32_t count = 0;
+		for (const Slot& slot : m_slots) {
+			if (!slot.bUsed || slot.refCount == 0 || slot.priority != AssetPriority::Critical) {
+				continue;
+			}
+			if (slot.state == AssetState::Ready) {
+				// Текстура создана, но её данные ещё передаются на GPU.
+				if (slot.type == AssetType::Texture && static_cast<const Texture2D*>(slot.pResource.get())->getState() == Texture2D::EState::Pending) {
+					++count;
+				}
+			}
+			else if (slot.state != AssetState::Failed) {
+				++count;
+			}
+		}
+		return count;
+	}
+
+	void AssetManager::waitForCritical() {
+		const auto startTime = std::chrono::steady_clock::now();
+
+		while (true) {
+			update();
+			m_textureLoader.update();
+			if (getCriticalPendingCount() == 0) {
+				break;
+			}
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_preparedCondition.wait_for(lock, std::chrono::milliseconds(1));
+		}
+
+		const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+		LOG_INFO("Critical assets loaded in {0:.1f} ms", ms);
+	}
+
+	void AssetManager::addRef(uint32_t index, uint32_t generation) noexcept {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Slot& slot = m_slots[index];
+		if (slot.generation == generation) {
+			++slot.refCount;
+		}
+	}
+
+	void AssetManager::release(uint32_t index, uint32_t generation) noexcept {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Slot& slot = m_slots[index];
+		if (slot.generation != generation || slot.refCount == 0) {
+			return;
+		}
+		if (--slot.refCount == 0) {
+			slot.releasedFrame = m_frame;
+			m_pendingUnload.push_back({ index, generation });
+		}
+	}
+
+	void* AssetManager::getResource(uint32_t index, uint32_t generation, AssetType type) const noexcept {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const Slot& slot = m_slots[index];
+		if (slot.generation != generation || slot.type != type || slot.state != AssetState::Ready) {
+			return nullptr;
+		}
+		return slot.pResource.get();
+	}
+
+	AssetState AssetManager::getState(uint32_t index, uint32_t generation) const noexcept {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const Slot& slot = m_slots[index];
+		return slot.generation == generation ? slot.state : AssetState::Failed;
+	}
+
+	void AssetManager::drawImGuiPanel() {
+		ImGui::Begin("Ресурсы");
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		ImGui::Text("Загружается: %u, ожидает создания: %zu", m_inFlight, m_prepared.size());
+		ImGui::Text("Повторных запросов: %u, совпадений по содержимому: %u", m_pathHits, m_contentHits);
+		ImGui::Text("Отменено: %u, выгружено: %u", m_cancelled, m_unloaded);
+
+		if (ImGui::BeginTable("assets", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY, ImVec2(0.f, 300.f))) {
+			ImGui::TableSetupColumn("Тип");
+			ImGui::TableSetupColumn("Состояние");
+			ImGui::TableSetupColumn("Ссылок");
+			ImGui::TableSetupColumn("Приоритет");
+			ImGui::TableSetupColumn("Ключ");
+			ImGui::TableHeadersRow();
+
+			for (const Slot& slot : m_slots) {
+				if (!slot.bUsed) {
+					continue;
+				}
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(getAssetTypeName(slot.type));
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(getAssetStateName(slot.state));
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", slot.refCount);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", static_cast<uint32_t>(slot.priority));
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(slot.key.c_str());
+			}
+			ImGui::EndTable();
+		}
+
+		ImGui::End();
+	}
+
+} // namespace Engine
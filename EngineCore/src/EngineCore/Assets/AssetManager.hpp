@@ -0,0 +1,367 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "EngineCore/Image/Image.hpp"
+#include "EngineCore/Render/TextureLoader.hpp"
+
+namespace Engine {
+
+	class JobSystem;
+	class ShaderProgram;
+	class AssetManager;
+
+	/**
+	 * @internal
+	 * @brief Тип ресурса.
+	 */
+	enum class AssetType : uint8_t {
+		Texture,	///< `Texture2D` из файла изображения.
+		Shader,		///< `ShaderProgram` из пары файлов или строк.
+		Count
+	};
+
+	/**
+	 * @internal
+	 * @brief Приоритет загрузки.
+	 *
+	 * Ресурсы с большим приоритетом раньше уходят на рабочие потоки и раньше
+	 * создаются на GPU. `Critical` - ресурсы первого кадра, их ожидает `waitForCritical()`.
+	 */
+	enum class AssetPriority : uint8_t {
+		Critical = 0,
+		High,
+		Normal,
+		Low,
+		Count
+	};
+
+	/**
+	 * @internal
+	 * @brief Состояние ресурса.
+	 */
+	enum class AssetState : uint8_t {
+		Queued,		///< Ожидает свободного рабочего потока.
+		Loading,	///< Файл читается и декодируется.
+		Prepared,	///< Данные готовы, ожидается создание GL объекта.
+		Ready,		///< GL объект создан.
+		Failed		///< Загрузка не удалась.
+	};
+
+	/**
+	 * @internal
+	 * @brief Идентификатор ресурса: индекс слота и поколение.
+	 *
+	 * При выгрузке ресурса поколение слота увеличивается, поэтому устаревший
+	 * идентификатор не указывает на ресурс, загруженный позже в тот же слот.
+	 * Поколение 0 не используется и обозначает пустой идентификатор.
+	 */
+	template<typename T>
+	struct AssetHandle {
+		uint32_t	index		= 0;
+		uint32_t	generation	= 0;
+
+		bool isValid() const noexcept { return generation != 0; }
+		bool operator==(const AssetHandle& rhs) const noexcept { return index == rhs.index && generation == rhs.generation; }
+		bool operator!=(const AssetHandle& rhs) const noexcept { return !(*this == rhs); }
+	};
+
+	/**
+	 * @internal
+	 * @brief Владеющая ссылка на ресурс.
+	 *
+	 * Копирование увеличивает счётчик ссылок ресурса, уничтожение - уменьшает.
+	 * Когда ссылок не остаётся, незагруженный ресурс отменяется, а загруженный
+	 * выгружается через несколько кадров (`AssetManager::setUnloadDelay()`), поэтому
+	 * повторный запрос в этом интервале не загружает его заново.
+	 *
+	 * @note Ссылка не должна переживать `AssetManager`.
+	 */
+	template<typename T>
+	class AssetRef {
+	public:
+		AssetRef() = default;
+		AssetRef(AssetManager* pManager, AssetHandle<T> handle) noexcept : m_pManager(pManager), m_handle(handle) {}
+		AssetRef(const AssetRef& rhs) noexcept;
+		AssetRef(AssetRef&& rhs) noexcept;
+		AssetRef& operator=(const AssetRef& rhs) noexcept;
+		AssetRef& operator=(AssetRef&& rhs) noexcept;
+		~AssetRef() { reset(); }
+
+		/// @internal
+		/// @brief Отпускает ресурс.
+		void reset() noexcept;
+
+		/// @internal
+		/// @brief Возвращает ресурс или nullptr, если он ещё не создан или загрузка не удалась.
+		T* get() const noexcept;
+		T* operator->() const noexcept { return get(); }
+
+		AssetState getState() const noexcept;
+		bool isReady() const noexcept { return getState() == AssetState::Ready; }
+
+		AssetHandle<T> getHandle() const noexcept { return m_handle; }
+		bool isValid() const noexcept { return m_handle.isValid(); }
+
+	private:
+		AssetManager*	m_pManager	= nullptr;
+		AssetHandle<T>	m_handle;
+	};
+
+	using TextureRef	= AssetRef<Texture2D>;
+	using ShaderRef		= AssetRef<ShaderProgram>;
+
+	/**
+	 * @internal
+	 * @brief Менеджер ресурсов: загрузка, разделение и выгрузка текстур и шейдеров.
+	 *
+	 * - Ресурсы адресуются идентификаторами с поколением (`AssetHandle`), а
+	 *   владение выражается ссылками со счётчиком (`AssetRef`).
+	 * - Повторный запрос того же пути возвращает тот же ресурс. Файлы с одинаковым
+	 *   содержимым (по XXH64) разделяют один GL объект.
+	 * - Файлы читаются и декодируются на рабочих потоках `JobSystem`. Одновременно
+	 *   выполняется не больше `maxInFlight` задач, а очередь упорядочена по приоритету,
+	 *   поэтому важные ресурсы не ждут за массой второстепенных.
+	 * - Ресурс, от которого отказались все владельцы до начала загрузки, не загружается;
+	 *   если загрузка уже идёт, её результат отбрасывается.
+	 * - GL объекты создаются в `update()` в потоке с контекстом, не больше
+	 *   `createBudget` штук за кадр.
+	 *
+	 * Пример использования
+	 * @code
+	 * ShaderRef pShader = assets.loadShader("shaders/sprite.vert", "shaders/sprite.frag", AssetPriority::Critical);
+	 * TextureRef pAlbedo = assets.loadTexture("textures/brick.png");
+	 * assets.waitForCritical();	// при старте ждём только ресурсы первого кадра
+	 * // ... каждый кадр:
+	 * assets.update();
+	 * if (pAlbedo.isReady()) { pAlbedo->bind(0); }
+	 * @endcode
+	 *
+	 * @note Загрузку можно запрашивать из любого потока, `update()` и `waitForCritical()`
+	 * вызываются только из потока с контекстом OpenGL.
+	 */
+	class AssetManager {
+	public:
+		/// @internal
+		/// @param jobSystem Пул потоков для чтения и декодирования файлов.
+		/// @param textureLoader Загрузчик, передающий текстуры на GPU.
+		AssetManager(JobSystem& jobSystem, TextureLoader& textureLoader);
+		~AssetManager();
+
+		AssetManager(const AssetManager&)				= delete;
+		AssetManager& operator=(const AssetManager&)	= delete;
+		AssetManager(AssetManager&&)					= delete;
+		AssetManager& operator=(AssetManager&&)			= delete;
+
+		/// @internal
+		/// @brief Запрашивает загрузку текстуры.
+		/// @param path Путь к файлу изображения.
+		/// @param params Параметры загрузки (учитываются только при первом запросе пути).
+		/// @param priority Приоритет загрузки.
+		TextureRef loadTexture(const std::string& path, const TextureLoadParams& params = {}, AssetPriority priority = AssetPriority::Normal);
+
+		/// @internal
+		/// @brief Запрашивает загрузку шейдерной программы из двух файлов.
+		ShaderRef loadShader(const std::string& vertexPath, const std::string& fragmentPath, AssetPriority priority = AssetPriority::Normal);
+
+		/// @internal
+		/// @brief Регистрирует шейдерную программу из строк (например, встроенные шейдеры движка).
+		/// @param name Имя ресурса (ключ дедупликации).
+		ShaderRef createShader(const std::string& name, std::string vertexSource, std::string fragmentSource, AssetPriority priority = AssetPriority::Normal);
+
+		/// @internal
+		/// @brief Запускает загрузки, создаёт GL объекты готовых ресурсов и выгружает неиспользуемые.
+		///
+		/// Вызывается каждый кадр в потоке с контекстом OpenGL.
+		void update();
+
+		/// @internal
+		/// @brief Блокирует поток, пока не будут загружены все ресурсы с приоритетом `Critical`
+		/// (включая передачу данных текстур на GPU).
+		void waitForCritical();
+
+		/// @internal
+		/// @brief Задаёт кол-во кадров между освобождением последней ссылки и выгрузкой ресурса.
+		void setUnloadDelay(uint32_t frames) noexcept { m_unloadDelay = frames; }
+
+		/// @internal
+		/// @brief Задаёт максимальное кол-во одновременно выполняемых задач загрузки.
+		void setMaxInFlight(uint32_t count) noexcept { m_maxInFlight = count > 0 ? count : 1; }
+
+		/// @internal
+		/// @brief Задаёт максимальное кол-во GL объектов, создаваемых за кадр.
+		void setCreateBudget(uint32_t count) noexcept { m_createBudget = count > 0 ? count : 1; }
+
+		/// @internal
+		/// @brief Отрисовывает ImGui окно со списком ресурсов.
+		void drawImGuiPanel();
+
+		// Доступ для `AssetRef`.
+		void addRef(uint32_t index, uint32_t generation) noexcept;
+		void release(uint32_t index, uint32_t generation) noexcept;
+		void* getResource(uint32_t index, uint32_t generation, AssetType type) const noexcept;
+		AssetState getState(uint32_t index, uint32_t generation) const noexcept;
+
+	private:
+		/// Данные, подготовленные рабочим потоком.
+		struct PreparedData {
+			Image					image;
+			TextureLoader::ESource	source			= TextureLoader::ESource::Uncompressed;
+			std::string				vertexSource;
+			std::string				fragmentSource;
+		};
+
+		/// Запись очереди: индекс слота и его поколение на момент постановки.
+		struct QueueEntry {
+			uint32_t	index;
+			uint32_t	generation;
+		};
+
+		/// Ресурс, GL объект которого создаётся в `update()` без блокировки.
+		struct PendingCreate {
+			uint32_t						index;
+			AssetType						type;
+			std::string						key;
+			TextureLoadParams				textureParams;
+			std::unique_ptr<PreparedData>	pPrepared;
+			std::shared_ptr<void>			pResource;	///< Результат; nullptr, если создать не удалось.
+		};
+
+		enum class ECreateResult : uint8_t {
+			Created,	///< Ресурс разделён с владельцем того же содержимого.
+			Deferred,	///< Ресурс с тем же содержимым ещё не создан, повтор в следующем кадре.
+			Requeued	///< Ресурс с тем же содержимым пропал, файл загружается заново.
+		};
+
+		struct Slot {
+			uint32_t				generation		= 1;
+			uint32_t				refCount		= 0;
+			AssetType				type			= AssetType::Texture;
+			AssetPriority			priority		= AssetPriority::Normal;
+			AssetState				state			= AssetState::Queued;
+			bool					bUsed			= false;
+			bool					bNoDedupe		= false;	///< Не искать совпадения по содержимому.
+			std::string				key;			///< Путь (или пара путей) - ключ дедупликации.
+			std::string				paths[2];
+			TextureLoadParams		textureParams;
+			uint64_t				contentHash		= 0;
+			uint64_t				releasedFrame	= 0;	///< Кадр, в котором отпущена последняя ссылка.
+			std::unique_ptr<PreparedData>	pPrepared;
+			std::shared_ptr<void>	pResource;
+		};
+
+		uint32_t	acquireSlot(AssetType type, const std::string& key, AssetPriority priority, bool& bExisting);
+		void		freeSlot(uint32_t index);
+		void		dispatch();
+		void		prepare(uint32_t index, uint32_t generation);
+		ECreateResult	share(uint32_t index);
+		std::shared_ptr<void>	create(PendingCreate& entry);
+		uint32_t	getCriticalPendingCount();
+
+		template<typename T>
+		static constexpr AssetType getAssetType() noexcept;
+
+		template<typename T>
+		friend class AssetRef;
+
+		JobSystem&							m_jobSystem;
+		TextureLoader&						m_textureLoader;
+
+		mutable std::mutex					m_mutex;
+		std::condition_variable				m_preparedCondition;
+		std::vector<Slot>					m_slots;
+		std::vector<uint32_t>				m_freeSlots;
+		std::unordered_map<std::string, uint32_t>	m_byKey[static_cast<size_t>(AssetType::Count)];
+		std::unordered_map<uint64_t, uint32_t>		m_byHash[static_cast<size_t>(AssetType::Count)];
+		std::deque<QueueEntry>				m_queues[static_cast<size_t>(AssetPriority::Count)];
+		std::vector<uint32_t>				m_prepared;
+		std::vector<PendingCreate>			m_creating;		///< Только для `update()`.
+		std::vector<QueueEntry>				m_pendingUnload;
+		uint32_t							m_inFlight			= 0;
+
+		uint64_t							m_frame				= 0;
+		uint32_t							m_unloadDelay		= 120;
+		uint32_t							m_maxInFlight		= 4;
+		uint32_t							m_createBudget		= 8;
+
+		// Статистика.
+		uint32_t							m_pathHits			= 0;
+		uint32_t							m_contentHits		= 0;
+		uint32_t							m_cancelled			= 0;
+		uint32_t							m_unloaded			= 0;
+	};
+
+	template<>
+	constexpr AssetType AssetManager::getAssetType<Texture2D>() noexcept { return AssetType::Texture; }
+
+	template<>
+	constexpr AssetType AssetManager::getAssetType<ShaderProgram>() noexcept { return AssetType::Shader; }
+
+	template<typename T>
+	AssetRef<T>::AssetRef(const AssetRef& rhs) noexcept : m_pManager(rhs.m_pManager), m_handle(rhs.m_handle) {
+		if (m_pManager) {
+			m_pManager->addRef(m_handle.index, m_handle.generation);
+		}
+	}
+
+	template<typename T>
+	AssetRef<T>::AssetRef(AssetRef&& rhs) noexcept : m_pManager(rhs.m_pManager), m_handle(rhs.m_handle) {
+		rhs.m_pManager = nullptr;
+		rhs.m_handle = {};
+	}
+
+	template<typename T>
+	AssetRef<T>& AssetRef<T>::operator=(const AssetRef& rhs) noexcept {
+		if (this != &rhs) {
+			if (rhs.m_pManager) {
+				rhs.m_pManager->addRef(rhs.m_handle.index, rhs.m_handle.generation);
+			}
+			reset();
+			m_pManager = rhs.m_pManager;
+			m_handle = rhs.m_handle;
+		}
+		return *this;
+	}
+
+	template<typename T>
+	AssetRef<T>& AssetRef<T>::operator=(AssetRef&& rhs) noexcept {
+		if (this != &rhs) {
+			reset();
+			m_pManager = rhs.m_pManager;
+			m_handle = rhs.m_handle;
+			rhs.m_pManager = nullptr;
+			rhs.m_handle = {};
+		}
+		return *this;
+	}
+
+	template<typename T>
+	void AssetRef<T>::reset() noexcept {
+		if (m_pManager) {
+			m_pManager->release(m_handle.index, m_handle.generation);
+		}
+		m_pManager = nullptr;
+		m_handle = {};
+	}
+
+	template<typename T>
+	T* AssetRef<T>::get() const noexcept {
+		if (!m_pManager) {
+			return nullptr;
+		}
+		return static_cast<T*>(m_pManager->getResource(m_handle.index, m_handle.generation, AssetManager::getAssetType<T>()));
+	}
+
+	template<typename T>
+	AssetState AssetRef<T>::getState() const noexcept {
+		return m_pManager ? m_pManager->getState(m_handle.index, m_handle.generation) : AssetState::Failed;
+	}
+
+} // namespace Engine
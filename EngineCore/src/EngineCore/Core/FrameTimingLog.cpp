@@ -0,0 +1,83 @@
+#include "EngineCore/Core/FrameTimingLog.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+#include "EngineCore/Core/JsonWriter.hpp"
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	/// Перцентиль по отсортированному массиву (ближайший ранг).
+	static float getPercentile(const std::vector<float>& sorted, const float percentile) noexcept {
+		const size_t index = static_cast<size_t>(percentile * static_cast<float>(sorted.size() - 1) + 0.5f);
+		return sorted[std::min(index, sorted.size() - 1)];
+	}
+
+	FrameTimingSummary FrameTimingLog::getSummary() const {
+		FrameTimingSummary summary;
+		if (m_frames.empty()) {
+			return summary;
+		}
+
+		std::vector<float> sorted;
+		sorted.reserve(m_frames.size());
+		double total = 0.0;
+		for (const FrameTiming& frame : m_frames) {
+			sorted.push_back(frame.frameMs);
+			total += frame.frameMs;
+		}
+		std::sort(sorted.begin(), sorted.end());
+
+		summary.frameCount = m_frames.size();
+		summary.averageMs = static_cast<float>(total / static_cast<double>(m_frames.size()));
+		summary.p50Ms = getPercentile(sorted, 0.50f);
+		summary.p95Ms = getPercentile(sorted, 0.95f);
+		summary.p99Ms = getPercentile(sorted, 0.99f);
+		summary.maxMs = sorted.back();
+		return summary;
+	}
+
+	bool FrameTimingLog::write(const std::string& path) const {
+		std::ofstream file(path);
+		if (!file) {
+			LOG_ERR("Can not open {0} for frame timings", path);
+			return false;
+		}
+
+		const FrameTimingSummary summary = getSummary();
+
+		JsonWriter json(file);
+		json.beginObject();
+		json.key("summary").beginObject();
+		json.key("frames").value(summary.frameCount);
+		json.key("averageMs").value(static_cast<double>(summary.averageMs));
+		json.key("p50Ms").value(static_cast<double>(summary.p50Ms));
+		json.key("p95Ms").value(static_cast<double>(summary.p95Ms));
+		json.key("p99Ms").value(static_cast<double>(summary.p99Ms));
+		json.key("maxMs").value(static_cast<double>(summary.maxMs));
+		json.endObject();
+
+		json.key("frames").beginArray();
+		for (const FrameTiming& frame : m_frames) {
+			json.beginObject();
+			json.key("frame").value(frame.frameIndex);
+			json.key("frameMs").value(static_cast<double>(frame.frameMs));
+			json.key("windowMs").value(static_cast<double>(frame.windowMs));
+			json.key("layersMs").value(static_cast<double>(frame.layersMs));
+			json.key("updateMs").value(static_cast<double>(frame.updateMs));
+			json.key("drawCalls").value(frame.drawCalls);
+			json.endObject();
+		}
+		json.endArray();
+		json.endObject();
+		file << '\n';
+
+		LOG_INFO(
+			"[FrameTimingLog] {0} frames: avg {1:.2f} ms, p50 {2:.2f} ms, p95 {3:.2f} ms, p99 {4:.2f} ms -> {5}",
+			summary.frameCount, summary.averageMs, summary.p50Ms, summary.p95Ms, summary.p99Ms, path
+		);
+		return true;
+	}
+
+} // namespace Engine
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Время одного кадра.
+	 */
+	struct FrameTiming {
+		uint64_t	frameIndex		= 0;
+		float		frameMs			= 0.f;	///< Полное время кадра на CPU.
+		float		windowMs		= 0.f;	///< `Window::update()` и `present()`: сцена, обмен буферов, события.
+		float		layersMs		= 0.f;	///< Обновление и отрисовка слоёв, включая ImGui.
+		float		updateMs		= 0.f;	///< `Application::update()`.
+		uint32_t	drawCalls		= 0;	///< Из `RenderStats` прошлого кадра.
+	};
+
+	/**
+	 * @internal
+	 * @brief Сводка по записанным кадрам.
+	 */
+	struct FrameTimingSummary {
+		uint64_t	frameCount	= 0;
+		float		averageMs	= 0.f;
+		float		p50Ms		= 0.f;
+		float		p95Ms		= 0.f;
+		float		p99Ms		= 0.f;
+		float		maxMs		= 0.f;
+	};
+
+	/**
+	 * @internal
+	 * @brief Журнал времени кадров для сравнения сборок.
+	 *
+	 * Кадры копятся в памяти (память резервируется заранее) и записываются
+	 * в JSON один раз в конце сессии. При воспроизведении записи ввода номера
+	 * кадров двух прогонов совпадают, поэтому файлы можно сравнивать покадрово.
+	 */
+	class FrameTimingLog {
+	public:
+		explicit FrameTimingLog(size_t reserveFrames = 16 * 1024) { m_frames.reserve(reserveFrames); }
+
+		void addFrame(const FrameTiming& timing) { m_frames.push_back(timing); }
+
+		/// @internal
+		/// @brief Считает среднее и перцентили полного времени кадра.
+		FrameTimingSummary getSummary() const;
+
+		/// @internal
+		/// @brief Записывает сводку и все кадры в JSON.
+		/// @return false, если файл не удалось создать.
+		bool write(const std::string& path) const;
+
+		const std::vector<FrameTiming>& getFrames() const noexcept { return m_frames; }
+
+	private:
+		std::vector<FrameTiming>	m_frames;
+	};
+
+} // namespace Engine
@@ -0,0 +1,122 @@
+#include "EngineCore/Core/Hash.hpp"
+
+#include <cstring>
+
+namespace Engine {
+
+	static constexpr uint64_t Prime1 = 11400714785074694791ULL;
+	static constexpr uint64_t Prime2 = 14029467366897019727ULL;
+	static constexpr uint64_t Prime3 = 1609587929392839161ULL;
+	static constexpr uint64_t Prime4 = 9650029242287828579ULL;
+	static constexpr uint64_t Prime5 = 2870177450012600261ULL;
+
+	static inline uint64_t rotateLeft(uint64_t value, int bits) noexcept {
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	static inline uint64_t read64(const uint8_t* p) noexcept {
+		uint64_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	static inline uint32_t read32(const uint8_t* p) noexcept {
+		uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	static inline uint64_t round(uint64_t acc, uint64_t input) noexcept {
+		acc += input * Prime2;
+		acc = rotateLeft(acc, 31);
+		return acc * Prime1;
+	}
+
+	static inline uint64_t mergeRound(uint64_t acc, uint64_t value) noexcept {
+		acc ^= round(0, value);
+		return acc * Prime1 + Prime4;
+	}
+
+	uint64_t hash64(const void* pData, size_t size, uint64_t seed) noexcept {
+		const uint8_t* p = static_cast<const uint8_t*>(pData);
+		const uint8_t* const pEnd = p + size;
+		uint64_t hash;
+
+		if (size >= 32) {
+			uint64_t v1 = seed + Prime1 + Prime2;
+			uint64_t v2 = seed + Prime2;
+			uint64_t v3 = seed;
+			uint64_t v4 = seed - Prime1;
+
+			const uint8_t* const pLimit = pEnd - 32;
+			do {
+				v1 = round(v1, read64(p));
+				v2 = round(v2, read64(p + 8));
+				v3 = round(v3, read64(p + 16));
+				v4 = round(v4, read64(p + 24));
+				p += 32;
+			} while (p <= pLimit);
+
+			hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+			hash = mergeRound(hash, v1);
+			hash = mergeRound(hash, v2);
+			hash = mergeRound(hash, v3);
+			hash = mergeRound(hash, v4);
+		}
+		else {
+			hash = seed + Prime5;
+		}
+
+		hash += static_cast<uint64_t>(size);
+
+		while (p + 8 <= pEnd) {
+			hash ^= round(0, read64(p));
+			hash = rotateLeft(hash, 27) * Prime1 + Prime4;
+			p += 8;
+		}
+		if (p + 4 <= pEnd) {
+			hash ^= static_cast<uint64_t>(read32(p)) * Prime1;
+			hash = rotateLeft(hash, 23) * Prime2 + Prime3;
+			p += 4;
+		}
+		while (p < pEnd) {
+			hash ^= *p * Prime5;
+			hash = rotateLeft(hash, 11) * Prime1;
+			++p;
+		}
+
+		hash ^= hash >> 33;
+		hash *= Prime2;
+		hash ^= hash >> 29;
+		hash *= Prime3;
+		hash ^= hash >> 32;
+		return hash;
+	}
+
+	/// Таблица CRC-32 по байту, строится при компиляции.
+	struct Crc32Table {
+		uint32_t values[256] = {};
+
+		constexpr Crc32Table() {
+			for (uint32_t i = 0; i < 256; ++i) {
+				uint32_t value = i;
+				for (int bit = 0; bit < 8; ++bit) {
+					value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+				}
+				values[i] = value;
+			}
+		}
+	};
+
+	static constexpr Crc32Table s_crc32Table;
+
+	uint32_t crc32(const void* pData, size_t size, uint32_t crc) noexcept {
+		const uint8_t* p = static_cast<const uint8_t*>(pData);
+		crc = ~crc;
+		for (size_t i = 0; i < size; ++i) {
+			crc = s_crc32Table.values[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+		}
+		return ~crc;
+	}
+
+} // namespace Engine
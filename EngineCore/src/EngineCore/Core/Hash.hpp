@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Engine {
+
+	/// @internal
+	/// @brief 64-битный некриптографический хеш данных (алгоритм XXH64).
+	///
+	/// Используется для ключей кешей по содержимому файлов. Скорость - несколько
+	/// гигабайт в секунду, поэтому хешировать исходные файлы дешевле, чем декодировать их.
+	///
+	/// @param pData Данные.
+	/// @param size Размер данных в байтах.
+	/// @param seed Начальное значение (позволяет смешать хеш с параметрами).
+	uint64_t hash64(const void* pData, size_t size, uint64_t seed = 0) noexcept;
+
+	inline uint64_t hash64(std::string_view text, uint64_t seed = 0) noexcept {
+		return hash64(text.data(), text.size(), seed);
+	}
+
+	/// @internal
+	/// @brief CRC-32 (полином 0xEDB88320, как в PNG и zlib).
+	///
+	/// @param pData Данные.
+	/// @param size Размер данных в байтах.
+	/// @param crc CRC предыдущих данных: позволяет считать CRC по частям.
+	uint32_t crc32(const void* pData, size_t size, uint32_t crc = 0) noexcept;
+
+} // namespace Engine
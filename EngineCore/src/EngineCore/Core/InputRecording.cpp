@@ -0,0 +1,305 @@
+#include "EngineCore/Core/InputRecording.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <iterator>
+
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	/// Размер блока, после которого записи сбрасываются на диск.
+	static constexpr size_t FlushThreshold = 64 * 1024;
+	static constexpr size_t FileHeaderSize = 8;
+
+	static uint64_t getMicroseconds() noexcept {
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()
+		).count());
+	}
+
+	static void writeLE16(std::vector<uint8_t>& out, uint16_t value) {
+		out.insert(out.end(), { static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8) });
+	}
+
+	static void writeLE32(std::vector<uint8_t>& out, uint32_t value) {
+		out.insert(out.end(), {
+			static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+			static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)
+		});
+	}
+
+	static void writeDouble(std::vector<uint8_t>& out, double value) {
+		uint64_t bits = 0;
+		std::memcpy(&bits, &value, sizeof(bits));
+		writeLE32(out, static_cast<uint32_t>(bits));
+		writeLE32(out, static_cast<uint32_t>(bits >> 32));
+	}
+
+	/// Беззнаковый LEB128: приращения кадров и времени обычно умещаются в 1-2 байта.
+	static void writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+		while (value >= 0x80) {
+			out.push_back(static_cast<uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+		out.push_back(static_cast<uint8_t>(value));
+	}
+
+	/// Последовательное чтение с проверкой границ.
+	class RecordingReader {
+	public:
+		RecordingReader(const uint8_t* pData, size_t size) : m_pData(pData), m_size(size) {}
+
+		bool isEnd() const noexcept { return m_offset >= m_size; }
+		bool isValid() const noexcept { return m_bValid; }
+
+		uint8_t readU8() {
+			if (!require(1)) {
+				return 0;
+			}
+			return m_pData[m_offset++];
+		}
+
+		uint16_t readLE16() {
+			if (!require(2)) {
+				return 0;
+			}
+			const uint16_t value = static_cast<uint16_t>(m_pData[m_offset] | (m_pData[m_offset + 1] << 8));
+			m_offset += 2;
+			return value;
+		}
+
+		uint32_t readLE32() {
+			if (!require(4)) {
+				return 0;
+			}
+			const uint8_t* p = m_pData + m_offset;
+			m_offset += 4;
+			return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+				(static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+		}
+
+		double readDouble() {
+			const uint64_t low = readLE32();
+			const uint64_t bits = low | (static_cast<uint64_t>(readLE32()) << 32);
+			double value = 0.0;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		uint64_t readVarint() {
+			uint64_t value = 0;
+			for (uint32_t shift = 0; shift < 64; shift += 7) {
+				const uint8_t byte = readU8();
+				value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0) {
+					return value;
+				}
+			}
+			m_bValid = false;
+			return value;
+		}
+
+	private:
+		bool require(size_t bytes) noexcept {
+			if (m_offset + bytes > m_size) {
+				m_bValid = false;
+				m_offset = m_size;
+				return false;
+			}
+			return true;
+		}
+
+		const uint8_t*	m_pData;
+		size_t			m_size;
+		size_t			m_offset	= 0;
+		bool			m_bValid	= true;
+	};
+
+	InputRecorder::~InputRecorder() {
+		if (isRecording()) {
+			stop(m_lastFrame + 1);
+		}
+	}
+
+	bool InputRecorder::start(const std::string& path) {
+		m_file.open(path, std::ios::binary | std::ios::trunc);
+		if (!m_file) {
+			LOG_ERR("Can not create {0}", path);
+			return false;
+		}
+
+		m_buffer.clear();
+		m_buffer.reserve(FlushThreshold + 64);
+		writeLE32(m_buffer, InputRecordingMagic);
+		writeLE16(m_buffer, InputRecordingVersion);
+		writeLE16(m_buffer, 0);
+
+		m_startMicroseconds = getMicroseconds();
+		m_lastFrame = 0;
+		m_lastMicroseconds = 0;
+		m_eventCount = 0;
+
+		LOG_INFO("[InputRecorder] Recording input to {0}", path);
+		return true;
+	}
+
+	void InputRecorder::writeRecordHeader(const uint8_t type, const uint64_t frameIndex) {
+		const uint64_t microseconds = getMicroseconds() - m_startMicroseconds;
+		m_buffer.push_back(type);
+		writeVarint(m_buffer, frameIndex - m_lastFrame);
+		writeVarint(m_buffer, microseconds - m_lastMicroseconds);
+		m_lastFrame = frameIndex;
+		m_lastMicroseconds = microseconds;
+	}
+
+	void InputRecorder::record(const Event& event, const uint64_t frameIndex) {
+		if (!isRecording()) {
+			return;
+		}
+
+		const EventType type = event.getType();
+		switch (type) {
+		case EventType::WindowResize: {
+			const EventWindowResize& resize = static_cast<const EventWindowResize&>(event);
+			writeRecordHeader(static_cast<uint8_t>(type), frameIndex);
+			writeLE16(m_buffer, resize.width);
+			writeLE16(m_buffer, resize.height);
+			break;
+		}
+		case EventType::MouseMove: {
+			const EventMouseMove& move = static_cast<const EventMouseMove&>(event);
+			writeRecordHeader(static_cast<uint8_t>(type), frameIndex);
+			writeDouble(m_buffer, move.x);
+			writeDouble(m_buffer, move.y);
+			break;
+		}
+		case EventType::WindowClose:
+			writeRecordHeader(static_cast<uint8_t>(type), frameIndex);
+			break;
+		default:
+			// У остальных типов пока нет структур событий.
+			return;
+		}
+
+		++m_eventCount;
+		if (m_buffer.size() >= FlushThreshold) {
+			flush();
+		}
+	}
+
+	void InputRecorder::stop(const uint64_t frameCount) {
+		if (!isRecording()) {
+			return;
+		}
+		writeRecordHeader(InputRecordingEnd, frameCount);
+		flush();
+		m_file.close();
+
+		LOG_INFO("[InputRecorder] Recorded {0} events in {1} frames", m_eventCount, frameCount);
+	}
+
+	void InputRecorder::flush() {
+		m_file.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+		m_buffer.clear();
+	}
+
+	bool InputPlayer::load(const std::string& path) {
+		m_events.clear();
+		m_cursor = 0;
+		m_frameCount = 0;
+
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			LOG_ERR("Can not open {0}", path);
+			return false;
+		}
+		const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		RecordingReader reader(data.data(), data.size());
+		if (data.size() < FileHeaderSize || reader.readLE32() != InputRecordingMagic) {
+			LOG_ERR("[InputPlayer] {0} is not an input recording", path);
+			return false;
+		}
+		const uint16_t version = reader.readLE16();
+		reader.readLE16();
+		if (version != InputRecordingVersion) {
+			LOG_ERR("[InputPlayer] {0} has unsupported version {1}", path, version);
+			return false;
+		}
+
+		uint64_t frameIndex = 0;
+		uint64_t microseconds = 0;
+		bool bEnd = false;
+		while (!reader.isEnd() && !bEnd) {
+			const uint8_t type = reader.readU8();
+			frameIndex += reader.readVarint();
+			microseconds += reader.readVarint();
+
+			RecordedEvent event;
+			event.frameIndex = frameIndex;
+			event.microseconds = microseconds;
+			switch (type) {
+			case static_cast<uint8_t>(EventType::WindowResize):
+				event.type = EventType::WindowResize;
+				event.width = reader.readLE16();
+				event.height = reader.readLE16();
+				break;
+			case static_cast<uint8_t>(EventType::MouseMove):
+				event.type = EventType::MouseMove;
+				event.x = reader.readDouble();
+				event.y = reader.readDouble();
+				break;
+			case static_cast<uint8_t>(EventType::WindowClose):
+				event.type = EventType::WindowClose;
+				break;
+			case InputRecordingEnd:
+				m_frameCount = frameIndex;
+				bEnd = true;
+				continue;
+			default:
+				LOG_ERR("[InputPlayer] Unknown event type {0} in {1}", type, path);
+				return false;
+			}
+			if (!reader.isValid()) {
+				break;
+			}
+			m_events.push_back(event);
+		}
+
+		if (!bEnd) {
+			// Сессия прервана без `stop()`: воспроизводим до последнего события.
+			LOG_WARN("[InputPlayer] {0} is truncated", path);
+			m_frameCount = m_events.empty() ? 0 : m_events.back().frameIndex + 1;
+		}
+
+		LOG_INFO("[InputPlayer] Loaded {0} events in {1} frames from {2}", m_events.size(), m_frameCount, path);
+		return true;
+	}
+
+	void InputPlayer::dispatchFrame(const uint64_t frameIndex, const EventCallback& callback) {
+		while (m_cursor < m_events.size() && m_events[m_cursor].frameIndex <= frameIndex) {
+			const RecordedEvent& recorded = m_events[m_cursor++];
+			switch (recorded.type) {
+			case EventType::WindowResize: {
+				EventWindowResize event(recorded.width, recorded.height);
+				callback(event);
+				break;
+			}
+			case EventType::MouseMove: {
+				EventMouseMove event(recorded.x, recorded.y);
+				callback(event);
+				break;
+			}
+			case EventType::WindowClose: {
+				EventCloseWindow event;
+				callback(event);
+				break;
+			}
+			default:
+				break;
+			}
+		}
+	}
+
+} // namespace Engine
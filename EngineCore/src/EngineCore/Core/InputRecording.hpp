@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "EngineCore/Event.hpp"
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Запись событий окна в компактный бинарный файл.
+	 *
+	 * Формат файла (little-endian):
+	 * - заголовок: `InputRecordingMagic` (4 байта), версия (2 байта), резерв (2 байта);
+	 * - записи: тип события (1 байт), приращение номера кадра и приращение времени
+	 *   в микросекундах (LEB128), затем данные события:
+	 *   - `WindowResize`: ширина и высота (2 x uint16);
+	 *   - `MouseMove`: координаты (2 x double, без потерь для точного воспроизведения);
+	 *   - `WindowClose`: нет данных;
+	 * - завершающая запись `InputRecordingEnd`: приращение номера кадра до общего
+	 *   числа кадров сессии.
+	 *
+	 * Записи копятся в памяти и сбрасываются на диск блоками, поэтому запись
+	 * не добавляет системных вызовов в каждый кадр.
+	 *
+	 * Пример использования
+	 * @code
+	 * InputRecorder recorder;
+	 * recorder.start("session.input");
+	 * // в обработчике событий окна
+	 * recorder.record(event, frameIndex);
+	 * // при выходе
+	 * recorder.stop(frameCount);
+	 * @endcode
+	 */
+	class InputRecorder {
+	public:
+		InputRecorder() = default;
+		~InputRecorder();
+
+		InputRecorder(const InputRecorder&)				= delete;
+		InputRecorder& operator=(const InputRecorder&)	= delete;
+
+		/// @internal
+		/// @brief Создаёт файл записи и пишет заголовок.
+		/// @return false, если файл не удалось создать.
+		bool start(const std::string& path);
+
+		/// @internal
+		/// @brief Записывает событие, полученное в кадре `frameIndex`.
+		void record(const Event& event, uint64_t frameIndex);
+
+		/// @internal
+		/// @brief Записывает маркер конца сессии из `frameCount` кадров и закрывает файл.
+		void stop(uint64_t frameCount);
+
+		bool isRecording() const noexcept { return m_file.is_open(); }
+		uint64_t getEventCount() const noexcept { return m_eventCount; }
+
+	private:
+		void writeRecordHeader(uint8_t type, uint64_t frameIndex);
+		void flush();
+
+		std::ofstream			m_file;
+		std::vector<uint8_t>	m_buffer;
+		uint64_t				m_startMicroseconds	= 0;
+		uint64_t				m_lastFrame			= 0;
+		uint64_t				m_lastMicroseconds	= 0;
+		uint64_t				m_eventCount		= 0;
+	};
+
+	/**
+	 * @internal
+	 * @brief Событие, прочитанное из записи.
+	 */
+	struct RecordedEvent {
+		uint64_t	frameIndex		= 0;
+		uint64_t	microseconds	= 0;	///< Время от начала записи.
+		EventType	type			= EventType::WindowClose;
+		uint16_t	width			= 0;	///< Для `WindowResize`.
+		uint16_t	height			= 0;
+		double		x				= 0.0;	///< Для `MouseMove`.
+		double		y				= 0.0;
+	};
+
+	/**
+	 * @internal
+	 * @brief Воспроизведение записи `InputRecorder`.
+	 *
+	 * Файл читается целиком при загрузке. `dispatchFrame()` вызывается раз в кадр
+	 * и передаёт события, записанные в этом кадре, в том же порядке.
+	 */
+	class InputPlayer {
+	public:
+		/// @internal
+		/// @brief Читает файл записи.
+		/// @return false, если файл не найден или повреждён.
+		bool load(const std::string& path);
+
+		/// @internal
+		/// @brief Передаёт в `callback` все события кадра `frameIndex`.
+		void dispatchFrame(uint64_t frameIndex, const EventCallback& callback);
+
+		/// @internal
+		/// @brief Возвращает true, когда воспроизведены все кадры записи.
+		bool isFinished(uint64_t frameIndex) const noexcept { return frameIndex >= m_frameCount; }
+
+		uint64_t getFrameCount() const noexcept { return m_frameCount; }
+		const std::vector<RecordedEvent>& getEvents() const noexcept { return m_events; }
+
+	private:
+		std::vector<RecordedEvent>	m_events;
+		size_t						m_cursor		= 0;
+		uint64_t					m_frameCount	= 0;
+	};
+
+	/// Сигнатура файла записи ввода ("EIR1").
+	static constexpr uint32_t InputRecordingMagic		= 0x31524945;
+	static constexpr uint16_t InputRecordingVersion		= 1;
+	/// Тип завершающей записи.
+	static constexpr uint8_t InputRecordingEnd			= 0xFF;
+
+} // namespace Engine
@@ -0,0 +1,187 @@
+#include "EngineCore/Core/JobSystem.hpp"
+
+#include <algorithm>
+
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Общее состояние одного вызова `parallelFor`.
+	///
+	/// Вспомогательные задачи могут дойти до рабочего потока уже после возврата
+	/// из `parallelFor`, поэтому состояние возвращается в пул тем, кто отпустит
+	/// последнюю ссылку (`refCount`).
+	struct JobSystem::ParallelForState {
+		RangeJob					func;
+		uint32_t					count;
+		uint32_t					grainSize;
+		uint32_t					chunkCount;
+		std::atomic<uint32_t>		nextChunk		{ 0 };
+		std::atomic<uint32_t>		doneChunks		{ 0 };
+		std::atomic<uint32_t>		refCount		{ 0 };
+		std::mutex					mutex;
+		std::condition_variable		condition;
+
+		explicit ParallelForState(RangeJob rangeJob) : func(rangeJob) {}
+
+		/// Забирает и выполняет части диапазона, пока они не закончатся.
+		void run() {
+			uint32_t chunk;
+			while ((chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunkCount) {
+				const uint32_t begin = chunk * grainSize;
+				const uint32_t end = std::min(begin + grainSize, count);
+				func(begin, end);
+
+				if (doneChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == chunkCount) {
+					std::lock_guard<std::mutex> lock(mutex);
+					condition.notify_all();
+				}
+			}
+		}
+	};
+
+	/// @internal
+	/// @brief Узел очереди задач: фоновая задача `submit` либо помощь в `parallelFor`.
+	struct JobSystem::JobNode {
+		JobNode*			pNext		= nullptr;
+		Job					job;
+		ParallelForState*	pState		= nullptr;
+	};
+
+	JobSystem::JobSystem(uint32_t workerCount)
+		: m_nodePool(64, "Job nodes")
+		, m_statePool(16, "parallelFor states")
+	{
+		if (workerCount == 0) {
+			const uint32_t cores = std::thread::hardware_concurrency();
+			workerCount = cores > 1 ? cores - 1 : 1;
+		}
+
+		m_workers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; ++i) {
+			m_workers.emplace_back(&JobSystem::workerLoop, this);
+		}
+
+		LOG_INFO("Job system started with {0} worker threads", workerCount);
+	}
+
+	JobSystem::~JobSystem() {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_bStop = true;
+		}
+		m_condition.notify_all();
+
+		for (std::thread& worker : m_workers) {
+			worker.join();
+		}
+	}
+
+	void JobSystem::submit(Job job) {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			JobNode* pNode = m_nodePool.create();
+			pNode->job = std::move(job);
+			pushJob(pNode, false);
+		}
+		m_condition.notify_one();
+	}
+
+	void JobSystem::pushJob(JobNode* pNode, const bool bFront) {
+		if (!m_pHead) {
+			m_pHead = m_pTail = pNode;
+		}
+		else if (bFront) {
+			pNode->pNext = m_pHead;
+			m_pHead = pNode;
+		}
+		else {
+			m_pTail->pNext = pNode;
+			m_pTail = pNode;
+		}
+	}
+
+	void JobSystem::releaseState(ParallelForState* pState) {
+		if (pState->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_statePool.destroy(pState);
+		}
+	}
+
+	void JobSystem::parallelFor(uint32_t count, uint32_t grainSize, const RangeJob func) {
+		if (count == 0) {
+			return;
+		}
+
+		grainSize = std::max<uint32_t>(grainSize, 1);
+		const uint32_t chunkCount = (count + grainSize - 1) / grainSize;
+
+		if (chunkCount == 1 || m_workers.empty()) {
+			func(0, count);
+			return;
+		}
+
+		const uint32_t helpers = std::min<uint32_t>(chunkCount - 1, getWorkerCount());
+		ParallelForState* pState;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			pState = m_statePool.create(func);
+			pState->count 		= count;
+			pState->grainSize 	= grainSize;
+			pState->chunkCount 	= chunkCount;
+			pState->refCount.store(helpers + 1, std::memory_order_relaxed);
+
+			for (uint32_t i = 0; i < helpers; ++i) {
+				JobNode* pNode = m_nodePool.create();
+				pNode->pState = pState;
+				pushJob(pNode, true);
+			}
+		}
+		m_condition.notify_all();
+
+		pState->run();
+
+		{
+			std::unique_lock<std::mutex> lock(pState->mutex);
+			pState->condition.wait(lock, [pState]() {
+				return pState->doneChunks.load(std::memory_order_acquire) == pState->chunkCount;
+			});
+		}
+		releaseState(pState);
+	}
+
+	void JobSystem::workerLoop() {
+		while (true) {
+			Job job;
+			ParallelForState* pState;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [this]() { return m_bStop || m_pHead; });
+
+				if (m_bStop && !m_pHead) {
+					return;
+				}
+
+				JobNode* pNode = m_pHead;
+				m_pHead = pNode->pNext;
+				if (!m_pHead) {
+					m_pTail = nullptr;
+				}
+				job = std::move(pNode->job);
+				pState = pNode->pState;
+				m_nodePool.destroy(pNode);
+			}
+
+			if (pState) {
+				// Если все части уже разобраны, run() сразу вернётся, не трогая функцию.
+				pState->run();
+				releaseState(pState);
+			}
+			else {
+				job();
+			}
+		}
+	}
+
+} // namespace Engine
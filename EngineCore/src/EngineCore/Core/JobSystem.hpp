@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "EngineCore/Memory/PoolAllocator.hpp"
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Невладеющая ссылка на функцию `void(uint32_t begin, uint32_t end)`.
+	 *
+	 * В отличие от `std::function` не выделяет память для лямбды с захватом,
+	 * поэтому `parallelFor` можно вызывать каждый кадр. Ссылка действительна,
+	 * пока жив исходный функциональный объект.
+	 */
+	class RangeJobRef {
+	public:
+		template<
+			typename Func,
+			typename = std::enable_if_t<!std::is_same_v<std::decay_t<Func>, RangeJobRef>>
+		>
+		RangeJobRef(Func&& func) noexcept
+			: m_pObject(const_cast<void*>(static_cast<const void*>(std::addressof(func))))
+			, m_pInvoke([](void* pObject, const uint32_t begin, const uint32_t end) {
+				(*static_cast<std::remove_reference_t<Func>*>(pObject))(begin, end);
+			})
+		{}
+
+		void operator()(uint32_t begin, uint32_t end) const { m_pInvoke(m_pObject, begin, end); }
+
+	private:
+		void*	m_pObject;
+		void	(*m_pInvoke)(void* pObject, uint32_t begin, uint32_t end);
+	};
+
+	/**
+	 * @internal
+	 * @brief Пул рабочих потоков движка.
+	 *
+	 * Позволяет:
+	 * - Запускать фоновые задачи (`submit`).
+	 * - Распараллеливать циклы по диапазону индексов (`parallelFor`).
+	 *
+	 * Поток, вызвавший `parallelFor`, сам участвует в обработке диапазона,
+	 * поэтому вызов завершается корректно, даже если все рабочие потоки
+	 * заняты долгими фоновыми задачами.
+	 *
+	 * Узлы очереди и состояние `parallelFor` берутся из пулов, поэтому после
+	 * прогрева `parallelFor` не обращается к куче.
+	 *
+	 * @note Копирование и перемещение запрещено.
+	 */
+	class JobSystem {
+	public:
+		using Job 		= std::function<void()>;
+		using RangeJob 	= RangeJobRef;
+
+		/// @internal
+		/// @brief Создаёт пул потоков.
+		/// @param workerCount Кол-во рабочих потоков (0 - по кол-ву ядер минус один).
+		explicit JobSystem(uint32_t workerCount = 0);
+		~JobSystem();
+
+		JobSystem(const JobSystem&)				= delete;
+		JobSystem& operator=(const JobSystem&)	= delete;
+		JobSystem(JobSystem&&)					= delete;
+		JobSystem& operator=(JobSystem&&)		= delete;
+
+		/// @internal
+		/// @brief Ставит задачу в очередь на выполнение рабочим потоком.
+		/// @param job Задача.
+		void submit(Job job);
+
+		/// @internal
+		/// @brief Выполняет `func` для диапазона [0, count), разбитого на части по `grainSize`.
+		///
+		/// Блокирует вызывающий поток до обработки всего диапазона.
+		///
+		/// @param count Размер диапазона.
+		/// @param grainSize Минимальный размер части диапазона.
+		/// @param func Функция, обрабатывающая диапазон [begin, end).
+		void parallelFor(uint32_t count, uint32_t grainSize, RangeJob func);
+
+		/// @internal
+		/// @brief Возвращает кол-во рабочих потоков (без учёта вызывающего).
+		uint32_t getWorkerCount() const noexcept { return static_cast<uint32_t>(m_workers.size()); }
+
+	private:
+		struct ParallelForState;
+		struct JobNode;
+
+		void workerLoop();
+
+		/// Ставит узел в очередь. Вызывается под `m_mutex`.
+		void pushJob(JobNode* pNode, bool bFront);
+
+		/// Отпускает ссылку на состояние и возвращает его в пул после последней.
+		void releaseState(ParallelForState* pState);
+
+		std::vector<std::thread>		m_workers;
+		JobNode*						m_pHead				= nullptr;
+		JobNode*						m_pTail				= nullptr;
+		ObjectPool<JobNode>				m_nodePool;			///< Под `m_mutex`.
+		ObjectPool<ParallelForState>	m_statePool;		///< Под `m_mutex`.
+		std::mutex						m_mutex;
+		std::condition_variable			m_condition;
+		bool							m_bStop				= false;
+	};
+
+} // namespace Engine
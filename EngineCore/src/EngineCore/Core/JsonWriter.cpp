@@ -0,0 +1,133 @@
+#include "EngineCore/Core/JsonWriter.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+namespace Engine {
+
+	JsonWriter& JsonWriter::beginObject() {
+		beforeValue();
+		m_stream << '{';
+		m_hasElements.push_back(false);
+		return *this;
+	}
+
+	JsonWriter& JsonWriter::endObject() {
+		const bool bHadElements = m_hasElements.back();
+		m_hasElements.pop_back();
+		if (bHadElements) {
+			newLine();
+		}
+		m_stream << '}';
+		return *this;
+	}
+
+	JsonWriter& JsonWriter::beginArray() {
+		beforeValue();
+		m_stream << '[';
+		m_hasElements.push_back(false);
+		return *this;
+	}
+
+	JsonWriter& JsonWriter::endArray() {
+		const bool bHadElements = m_hasElements.back();
+		m_hasElements.pop_back();
+		if (bHadElements) {
+			newLine();
+		}
+		m_stream << ']';
+		return *this;
+	}
+
+	JsonWriter& JsonWriter::key(std::string_view name) {
+		beforeValue();
+		writeString(name);
+		m_stream << ": ";
+		m_bAfterKey = true;
+		return *this;
+	}
+
+	JsonWriter& JsonWriter::value(std::string_view text) {
+		beforeValue();
+		writeString(text);
+		return *this;
+	}
+
+	JsonWriter& JsonWriter::value(double number) {
+		beforeValue();
+		if (!std::isfinite(number)) {
+			m_stream << "null";
+			return *this;
+		}
+
+		char buffer[32];
+		std::snprintf(buffer, sizeof(buffer), "%.9g", number);
+		m_stream << buffer;
+		return *this;
+	}
+
+	JsonWriter& JsonWriter::value(int64_t number) {
+		beforeValue();
+		m_stream << number;
+		return *this;
+	}
+
+	JsonWriter& JsonWriter::value(uint64_t number) {
+		beforeValue();
+		m_stream << number;
+		return *this;
+	}
+
+	JsonWriter& JsonWriter::value(bool flag) {
+		beforeValue();
+		m_stream << (flag ? "true" : "false");
+		return *this;
+	}
+
+	void JsonWriter::beforeValue() {
+		// Значение после ключа пишется в той же строке.
+		if (m_bAfterKey) {
+			m_bAfterKey = false;
+			return;
+		}
+
+		if (!m_hasElements.empty()) {
+			if (m_hasElements.back()) {
+				m_stream << ',';
+			}
+			m_hasElements.back() = true;
+			newLine();
+		}
+	}
+
+	void JsonWriter::newLine() {
+		m_stream << '\n';
+		for (size_t i = 0; i < m_hasElements.size(); ++i) {
+			m_stream << '\t';
+		}
+	}
+
+	void JsonWriter::writeString(std::string_view text) {
+		m_stream << '"';
+		for (const char c : text) {
+			switch (c) {
+			case '"':	m_stream << "\\\""; break;
+			case '\\':	m_stream << "\\\\"; break;
+			case '\n':	m_stream << "\\n"; break;
+			case '\r':	m_stream << "\\r"; break;
+			case '\t':	m_stream << "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20) {
+					char buffer[8];
+					std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+					m_stream << buffer;
+				}
+				else {
+					m_stream << c;
+				}
+			}
+		}
+		m_stream << '"';
+	}
+
+} // namespace Engine
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Потоковая запись JSON.
+	 *
+	 * Расставляет запятые и отступы автоматически, экранирует строки.
+	 *
+	 * Пример использования
+	 * @code
+	 * std::ofstream file("snapshot.json");
+	 * JsonWriter json(file);
+	 * json.beginObject();
+	 * json.key("frame").value(42);
+	 * json.key("items").beginArray();
+	 * json.value("first");
+	 * json.endArray();
+	 * json.endObject();
+	 * @endcode
+	 */
+	class JsonWriter {
+	public:
+		explicit JsonWriter(std::ostream& stream) : m_stream(stream) {}
+
+		JsonWriter& beginObject();
+		JsonWriter& endObject();
+		JsonWriter& beginArray();
+		JsonWriter& endArray();
+
+		/// @internal
+		/// @brief Записывает ключ; следующий вызов записывает его значение.
+		JsonWriter& key(std::string_view name);
+
+		JsonWriter& value(std::string_view text);
+		JsonWriter& value(const char* text) { return value(std::string_view(text)); }
+		JsonWriter& value(double number);
+		JsonWriter& value(int64_t number);
+		JsonWriter& value(uint64_t number);
+		JsonWriter& value(int32_t number) { return value(static_cast<int64_t>(number)); }
+		JsonWriter& value(uint32_t number) { return value(static_cast<uint64_t>(number)); }
+		JsonWriter& value(bool flag);
+
+	private:
+		void beforeValue();
+		void newLine();
+		void writeString(std::string_view text);
+
+		std::ostream&		m_stream;
+		std::vector<bool>	m_hasElements;
+		bool				m_bAfterKey		= false;
+	};
+
+} // namespace Engine
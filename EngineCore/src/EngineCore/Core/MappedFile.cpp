@@ -0,0 +1,111 @@
+#include "EngineCore/Core/MappedFile.hpp"
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	MappedFile::~MappedFile() {
+		close();
+	}
+
+#ifdef _WIN32
+
+	bool MappedFile::open(const std::string& path) {
+		close();
+
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping) {
+			LOG_ERR("Can not map file {0}", path);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_pData = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		if (!m_pData) {
+			LOG_ERR("Can not map file {0}", path);
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_size = static_cast<size_t>(size.QuadPart);
+		m_file = file;
+		m_mapping = mapping;
+		return true;
+	}
+
+	void MappedFile::close() noexcept {
+		if (m_pData) {
+			UnmapViewOfFile(m_pData);
+			CloseHandle(m_mapping);
+			CloseHandle(m_file);
+		}
+		m_pData = nullptr;
+		m_size = 0;
+		m_file = nullptr;
+		m_mapping = nullptr;
+	}
+
+#else
+
+	bool MappedFile::open(const std::string& path) {
+		close();
+
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			return false;
+		}
+
+		struct stat info;
+		if (fstat(fd, &info) != 0 || info.st_size == 0) {
+			::close(fd);
+			return false;
+		}
+
+		// Отображение остаётся валидным и после закрытия дескриптора.
+		void* pMapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (pMapped == MAP_FAILED) {
+			LOG_ERR("Can not map file {0}", path);
+			return false;
+		}
+
+		m_pData = static_cast<const uint8_t*>(pMapped);
+		m_size = static_cast<size_t>(info.st_size);
+		return true;
+	}
+
+	void MappedFile::close() noexcept {
+		if (m_pData) {
+			munmap(const_cast<uint8_t*>(m_pData), m_size);
+		}
+		m_pData = nullptr;
+		m_size = 0;
+	}
+
+#endif
+
+} // namespace Engine
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Файл, отображённый в память только для чтения.
+	///
+	/// Страницы подгружаются ОС по мере обращения, поэтому данные можно
+	/// передавать в GPU без промежуточного копирования в буфер процесса.
+	///
+	/// @note Копирование и перемещение запрещено, файл разделяется через `std::shared_ptr`.
+	class MappedFile {
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&)				= delete;
+		MappedFile& operator=(const MappedFile&)	= delete;
+		MappedFile(MappedFile&&)					= delete;
+		MappedFile& operator=(MappedFile&&)			= delete;
+
+		/// @internal
+		/// @brief Отображает файл в память.
+		/// @return false, если файл не существует, пуст или не может быть отображён.
+		bool open(const std::string& path);
+
+		/// @internal
+		/// @brief Снимает отображение.
+		void close() noexcept;
+
+		const uint8_t* getData() const noexcept { return m_pData; }
+		size_t getSize() const noexcept { return m_size; }
+		bool isOpen() const noexcept { return m_pData != nullptr; }
+
+	private:
+		const uint8_t*	m_pData		= nullptr;
+		size_t			m_size		= 0;
+#ifdef _WIN32
+		void*			m_file		= nullptr;
+		void*			m_mapping	= nullptr;
+#endif
+	};
+
+} // namespace Engine
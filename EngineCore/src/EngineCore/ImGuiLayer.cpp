@@ -0,0 +1,137 @@
+#include "EngineCore/ImGuiLayer.hpp"
+
+#include <imgui/imgui.h>
+#include <imgui/backends/imgui_impl_opengl3.h>
+#include <imgui/backends/imgui_impl_glfw.h>
+
+#include "EngineCore/Log.hpp"
+#include "EngineCore/Memory/AllocationTracker.hpp"
+#include "EngineCore/Window.hpp"
+
+namespace Engine {
+
+	/// Как часто скрытый слой открывает пустой кадр, чтобы разобрать очередь ввода ImGui, с.
+	static constexpr float HiddenDrainInterval = 0.5f;
+
+	ImGuiLayer::ImGuiLayer(Window& window, LayerStack& layerStack)
+		: Layer("ImGui")
+		, m_window(window)
+		, m_layerStack(layerStack)
+	{
+
+	}
+
+	void ImGuiLayer::onAttach() {
+		IMGUI_CHECKVERSION();
+		AllocationTracker::installImGuiAllocator();
+		ImGui::CreateContext();
+		ImGui_ImplOpenGL3_Init();
+		// Обработчики ImGui вызывают ранее установленные обработчики окна.
+		ImGui_ImplGlfw_InitForOpenGL(m_window.getNativeWindow(), true);
+
+		LOG_INFO("ImGui was successfully initialized");
+	}
+
+	void ImGuiLayer::onDetach() {
+		ImGui_ImplOpenGL3_Shutdown();
+		ImGui_ImplGlfw_Shutdown();
+		ImGui::DestroyContext();
+		m_bHasDrawData = false;
+	}
+
+	void ImGuiLayer::onUpdate(const float deltaTime) {
+		m_timeSinceBuild += deltaTime;
+	}
+
+	void ImGuiLayer::onRender() {
+		++m_frameCount;
+
+		if (!m_bVisible) {
+			if (m_timeSinceBuild >= HiddenDrainInterval) {
+				ImGui_ImplGlfw_NewFrame();
+				ImGui::NewFrame();
+				ImGui::EndFrame();
+				m_timeSinceBuild = 0.f;
+				m_bHasDrawData = false;
+			}
+			return;
+		}
+
+		// Состояние мыши и текстовых полей - с прошлого перестроения.
+		const ImGuiIO& io = ImGui::GetIO();
+		const bool bInteracting = io.WantTextInput || ImGui::IsAnyMouseDown();
+		const bool bRateElapsed = m_updateRate <= 0.f || m_timeSinceBuild * m_updateRate >= 1.f;
+		if (m_bDirty || bInteracting || bRateElapsed || !m_bHasDrawData) {
+			build();
+		}
+
+		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+	}
+
+	void ImGuiLayer::build() {
+		ImGuiIO& io = ImGui::GetIO();
+		io.DisplaySize.x = static_cast<float>(m_window.getWidth());
+		io.DisplaySize.y = static_cast<float>(m_window.getHeight());
+
+		ImGui_ImplOpenGL3_NewFrame();
+		ImGui_ImplGlfw_NewFrame();
+		ImGui::NewFrame();
+
+		m_window.drawImGuiPanels();
+		m_layerStack.drawImGui();
+
+		ImGui::Render();
+
+		m_timeSinceBuild = 0.f;
+		m_bDirty = false;
+		m_bHasDrawData = true;
+		++m_buildCount;
+	}
+
+	void ImGuiLayer::onImGuiRender() {
+		if (ImGui::Begin("Слои")) {
+			for (const LayerTiming& timing : m_layerStack.getTimings()) {
+				ImGui::Text("%s%s: update %.3f ms, render %.3f ms",
+					timing.pLayer->getName().c_str(),
+					timing.bOverlay ? " (оверлей)" : "",
+					timing.updateMs,
+					timing.renderMs);
+			}
+
+			ImGui::Separator();
+			ImGui::Text("Перестроений интерфейса: %.0f%% кадров",
+				m_frameCount > 0 ? 100.0 * static_cast<double>(m_buildCount) / static_cast<double>(m_frameCount) : 0.0);
+			ImGui::SliderFloat("Частота, Гц", &m_updateRate, 0.f, 120.f, "%.0f");
+#ifdef ENGINE_IMGUI_DEMO
+			ImGui::Checkbox("Демо ImGui", &m_bShowDemo);
+#endif
+		}
+		ImGui::End();
+
+#ifdef ENGINE_IMGUI_DEMO
+		if (m_bShowDemo) {
+			ImGui::ShowDemoWindow(&m_bShowDemo);
+		}
+#endif
+	}
+
+	bool ImGuiLayer::onEvent(Event& event) {
+		switch (event.getType()) {
+		case EventType::MouseMove:
+			m_bDirty = true;
+			// Ввод над окнами интерфейса не доходит до слоёв сцены.
+			return m_bVisible && ImGui::GetIO().WantCaptureMouse;
+		case EventType::WindowResize:
+			m_bDirty = true;
+			return false;
+		default:
+			return false;
+		}
+	}
+
+	void ImGuiLayer::setVisible(const bool bVisible) noexcept {
+		m_bVisible = bVisible;
+		m_bDirty = true;
+	}
+
+} // namespace Engine
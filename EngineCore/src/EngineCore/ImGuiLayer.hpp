@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+#include "EngineCore/Layer.hpp"
+
+namespace Engine {
+
+	class Window;
+
+	/**
+	 * @internal
+	 * @brief Оверлей с отладочным интерфейсом ImGui.
+	 *
+	 * Построение интерфейса (панели всех систем движка) стоит заметно больше,
+	 * чем отрисовка готовых данных, поэтому слой перестраивает интерфейс не каждый
+	 * кадр, а:
+	 * - сразу после ввода (движение мыши, изменение размера окна);
+	 * - каждый кадр, пока зажата кнопка мыши или активно текстовое поле
+	 *   (нажатия без движения мыши ImGui получает сам и обрабатывает при следующем перестроении);
+	 * - иначе с частотой `setUpdateRate()` - достаточно для обновления статистики.
+	 *
+	 * В остальных кадрах повторно отправляются данные последнего `ImGui::Render()`
+	 * (они действительны до следующего `ImGui::NewFrame()`), потому что сцена
+	 * под интерфейсом перерисовывается каждый кадр.
+	 *
+	 * Скрытый слой не строит и не рисует интерфейс, а лишь изредка открывает
+	 * пустой кадр, чтобы очередь ввода ImGui не росла.
+	 */
+	class ImGuiLayer final : public Layer {
+	public:
+		/// Частота перестроения интерфейса по умолчанию, Гц.
+		static constexpr float DefaultUpdateRate = 30.f;
+
+		ImGuiLayer(Window& window, LayerStack& layerStack);
+
+		void onAttach() override;
+		void onDetach() override;
+		void onUpdate(float deltaTime) override;
+		void onRender() override;
+		void onImGuiRender() override;
+		bool onEvent(Event& event) override;
+
+		void setVisible(bool bVisible) noexcept;
+		bool isVisible() const noexcept { return m_bVisible; }
+
+		/**
+		 * @internal
+		 * @brief Задаёт частоту перестроения интерфейса без ввода.
+		 * @param rate частота в Гц; 0 - перестраивать каждый кадр.
+		 */
+		void setUpdateRate(float rate) noexcept { m_updateRate = rate; }
+
+	private:
+		void build();
+
+		Window&		m_window;
+		LayerStack&	m_layerStack;
+		float		m_updateRate		= DefaultUpdateRate;
+		float		m_timeSinceBuild	= 0.f;
+		uint64_t	m_frameCount		= 0;
+		uint64_t	m_buildCount		= 0;
+		bool		m_bVisible			= true;
+		bool		m_bDirty			= true;
+		bool		m_bHasDrawData		= false;
+		bool		m_bShowDemo			= false;
+	};
+
+} // namespace Engine
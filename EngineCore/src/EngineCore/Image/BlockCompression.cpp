@@ -0,0 +1,564 @@
+#include "EngineCore/Image/BlockCompression.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "EngineCore/Core/JobSystem.hpp"
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	BlockInfo getBlockInfo(CompressedFormat format) noexcept {
+		switch (format) {
+		case CompressedFormat::BC1:			return { 4, 4, 8 };
+		case CompressedFormat::BC3:			return { 4, 4, 16 };
+		case CompressedFormat::BC4:			return { 4, 4, 8 };
+		case CompressedFormat::BC5:			return { 4, 4, 16 };
+		case CompressedFormat::BC7:			return { 4, 4, 16 };
+		case CompressedFormat::ASTC_4x4:	return { 4, 4, 16 };
+		case CompressedFormat::ASTC_6x6:	return { 6, 6, 16 };
+		case CompressedFormat::ASTC_8x8:	return { 8, 8, 16 };
+		case CompressedFormat::None:		break;
+		}
+		return { 1, 1, 0 };
+	}
+
+	const char* getCompressedFormatName(CompressedFormat format) noexcept {
+		switch (format) {
+		case CompressedFormat::None:		return "none";
+		case CompressedFormat::BC1:			return "BC1";
+		case CompressedFormat::BC3:			return "BC3";
+		case CompressedFormat::BC4:			return "BC4";
+		case CompressedFormat::BC5:			return "BC5";
+		case CompressedFormat::BC7:			return "BC7";
+		case CompressedFormat::ASTC_4x4:	return "ASTC 4x4";
+		case CompressedFormat::ASTC_6x6:	return "ASTC 6x6";
+		case CompressedFormat::ASTC_8x8:	return "ASTC 8x8";
+		}
+		return "unknown";
+	}
+
+	size_t getCompressedLevelSize(CompressedFormat format, uint32_t width, uint32_t height) noexcept {
+		const BlockInfo block = getBlockInfo(format);
+		const size_t blocksX = (width + block.width - 1) / block.width;
+		const size_t blocksY = (height + block.height - 1) / block.height;
+		return blocksX * blocksY * block.bytes;
+	}
+
+	namespace {
+
+		/// Главная ось облака точек (степенной метод по ковариационной матрице).
+		template<int Dims>
+		void findPrincipalAxis(const float (*pPoints)[Dims], float* pMean, float* pAxis) {
+			for (int d = 0; d < Dims; ++d) {
+				pMean[d] = 0.f;
+				for (int i = 0; i < 16; ++i) {
+					pMean[d] += pPoints[i][d];
+				}
+				pMean[d] /= 16.f;
+			}
+
+			float covariance[Dims][Dims] = {};
+			for (int i = 0; i < 16; ++i) {
+				for (int a = 0; a < Dims; ++a) {
+					for (int b = a; b < Dims; ++b) {
+						covariance[a][b] += (pPoints[i][a] - pMean[a]) * (pPoints[i][b] - pMean[b]);
+					}
+				}
+			}
+			for (int a = 0; a < Dims; ++a) {
+				for (int b = 0; b < a; ++b) {
+					covariance[a][b] = covariance[b][a];
+				}
+			}
+
+			// Начальное приближение - диагональ ограничивающего параллелепипеда.
+			for (int d = 0; d < Dims; ++d) {
+				float lo = FLT_MAX, hi = -FLT_MAX;
+				for (int i = 0; i < 16; ++i) {
+					lo = std::min(lo, pPoints[i][d]);
+					hi = std::max(hi, pPoints[i][d]);
+				}
+				pAxis[d] = hi - lo;
+			}
+
+			for (int iteration = 0; iteration < 8; ++iteration) {
+				float next[Dims] = {};
+				for (int a = 0; a < Dims; ++a) {
+					for (int b = 0; b < Dims; ++b) {
+						next[a] += covariance[a][b] * pAxis[b];
+					}
+				}
+
+				float length = 0.f;
+				for (int d = 0; d < Dims; ++d) {
+					length += next[d] * next[d];
+				}
+				if (length < 1e-12f) {
+					break;
+				}
+				length = 1.f / std::sqrt(length);
+				for (int d = 0; d < Dims; ++d) {
+					pAxis[d] = next[d] * length;
+				}
+			}
+		}
+
+		/// Концы отрезка вдоль главной оси, покрывающего все точки блока.
+		template<int Dims>
+		void findEndpoints(const float (*pPoints)[Dims], float* pLow, float* pHigh) {
+			float mean[Dims], axis[Dims];
+			findPrincipalAxis<Dims>(pPoints, mean, axis);
+
+			float tMin = FLT_MAX, tMax = -FLT_MAX;
+			for (int i = 0; i < 16; ++i) {
+				float t = 0.f;
+				for (int d = 0; d < Dims; ++d) {
+					t += (pPoints[i][d] - mean[d]) * axis[d];
+				}
+				tMin = std::min(tMin, t);
+				tMax = std::max(tMax, t);
+			}
+
+			for (int d = 0; d < Dims; ++d) {
+				pLow[d] = std::clamp(mean[d] + axis[d] * tMin, 0.f, 255.f);
+				pHigh[d] = std::clamp(mean[d] + axis[d] * tMax, 0.f, 255.f);
+			}
+		}
+
+		/// Уточняет концы методом наименьших квадратов при фиксированных весах интерполяции.
+		/// @param pWeights Вес второго конца для каждой точки (0 - первый конец, 1 - второй).
+		/// @return false, если система вырождена.
+		template<int Dims>
+		bool refineEndpoints(const float (*pPoints)[Dims], const float* pWeights, float* pFirst, float* pSecond) {
+			float aa = 0.f, ab = 0.f, bb = 0.f;
+			float ax[Dims] = {}, bx[Dims] = {};
+			for (int i = 0; i < 16; ++i) {
+				const float b = pWeights[i];
+				const float a = 1.f - b;
+				aa += a * a;
+				ab += a * b;
+				bb += b * b;
+				for (int d = 0; d < Dims; ++d) {
+					ax[d] += a * pPoints[i][d];
+					bx[d] += b * pPoints[i][d];
+				}
+			}
+
+			const float det = aa * bb - ab * ab;
+			if (std::fabs(det) < 1e-6f) {
+				return false;
+			}
+
+			const float inv = 1.f / det;
+			for (int d = 0; d < Dims; ++d) {
+				pFirst[d] = std::clamp((ax[d] * bb - bx[d] * ab) * inv, 0.f, 255.f);
+				pSecond[d] = std::clamp((bx[d] * aa - ax[d] * ab) * inv, 0.f, 255.f);
+			}
+			return true;
+		}
+
+		uint16_t packRgb565(const float* pColor) {
+			const uint32_t r = static_cast<uint32_t>(std::lround(pColor[0] * 31.f / 255.f));
+			const uint32_t g = static_cast<uint32_t>(std::lround(pColor[1] * 63.f / 255.f));
+			const uint32_t b = static_cast<uint32_t>(std::lround(pColor[2] * 31.f / 255.f));
+			return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+		}
+
+		void unpackRgb565(uint16_t packed, int* pColor) {
+			const int r = packed >> 11;
+			const int g = (packed >> 5) & 63;
+			const int b = packed & 31;
+			pColor[0] = (r << 3) | (r >> 2);
+			pColor[1] = (g << 2) | (g >> 4);
+			pColor[2] = (b << 3) | (b >> 2);
+		}
+
+		/// Подбирает индексы BC1 (4-цветный режим) и считает ошибку для пары концов.
+		uint32_t evaluateBC1(const float (*pPoints)[3], uint16_t& c0, uint16_t& c1, uint32_t& indices) {
+			// В 4-цветном режиме первый конец должен быть больше второго.
+			if (c0 < c1) {
+				std::swap(c0, c1);
+			}
+
+			int palette[4][3];
+			unpackRgb565(c0, palette[0]);
+			unpackRgb565(c1, palette[1]);
+			for (int d = 0; d < 3; ++d) {
+				palette[2][d] = (2 * palette[0][d] + palette[1][d]) / 3;
+				palette[3][d] = (palette[0][d] + 2 * palette[1][d]) / 3;
+			}
+			// При равных концах декодер включает 3-цветный режим: используется только индекс 0.
+			const int paletteSize = c0 == c1 ? 1 : 4;
+
+			uint32_t error = 0;
+			indices = 0;
+			for (int i = 0; i < 16; ++i) {
+				uint32_t best = UINT32_MAX;
+				uint32_t bestIndex = 0;
+				for (int p = 0; p < paletteSize; ++p) {
+					uint32_t distance = 0;
+					for (int d = 0; d < 3; ++d) {
+						const int diff = static_cast<int>(pPoints[i][d]) - palette[p][d];
+						distance += diff * diff;
+					}
+					if (distance < best) {
+						best = distance;
+						bestIndex = p;
+					}
+				}
+				error += best;
+				indices |= bestIndex << (i * 2);
+			}
+			return error;
+		}
+
+		void encodeColorBC1(const uint8_t* pRgba, uint8_t* pOut) {
+			float points[16][3];
+			for (int i = 0; i < 16; ++i) {
+				for (int d = 0; d < 3; ++d) {
+					points[i][d] = pRgba[i * 4 + d];
+				}
+			}
+
+			float high[3], low[3];
+			findEndpoints<3>(points, low, high);
+
+			uint16_t bestC0 = 0, bestC1 = 0;
+			uint32_t bestIndices = 0;
+			uint32_t bestError = UINT32_MAX;
+
+			static const float s_weights[4] = { 0.f, 1.f, 1.f / 3.f, 2.f / 3.f };
+			for (int iteration = 0; iteration < 3; ++iteration) {
+				uint16_t c0 = packRgb565(high);
+				uint16_t c1 = packRgb565(low);
+				uint32_t indices;
+				const uint32_t error = evaluateBC1(points, c0, c1, indices);
+				if (error < bestError) {
+					bestError = error;
+					bestC0 = c0;
+					bestC1 = c1;
+					bestIndices = indices;
+				}
+				if (error == 0) {
+					break;
+				}
+
+				float weights[16];
+				for (int i = 0; i < 16; ++i) {
+					weights[i] = s_weights[(indices >> (i * 2)) & 3];
+				}
+				// Концы после evaluateBC1 упорядочены: c0 - первый, c1 - второй.
+				if (!refineEndpoints<3>(points, weights, high, low)) {
+					break;
+				}
+			}
+
+			pOut[0] = static_cast<uint8_t>(bestC0);
+			pOut[1] = static_cast<uint8_t>(bestC0 >> 8);
+			pOut[2] = static_cast<uint8_t>(bestC1);
+			pOut[3] = static_cast<uint8_t>(bestC1 >> 8);
+			std::memcpy(pOut + 4, &bestIndices, 4);
+		}
+
+		/// Запись битового потока блока BC7 (младшие биты первыми).
+		class BlockBitWriter {
+		public:
+			explicit BlockBitWriter(uint8_t* pOut) : m_pOut(pOut) { std::memset(pOut, 0, 16); }
+
+			void write(uint32_t value, uint32_t bits) {
+				for (uint32_t i = 0; i < bits; ++i, ++m_position) {
+					if (value & (1u << i)) {
+						m_pOut[m_position >> 3] |= static_cast<uint8_t>(1u << (m_position & 7));
+					}
+				}
+			}
+
+		private:
+			uint8_t*	m_pOut;
+			uint32_t	m_position	= 0;
+		};
+
+		/// Квантует конец BC7 режима 6 (7 бит + общий p-бит) и возвращает восстановленное значение.
+		void quantizeBC7Endpoint(const float* pValue, uint32_t* pQuantized, uint32_t& pBit, int* pRestored) {
+			float bestError = FLT_MAX;
+			for (uint32_t p = 0; p < 2; ++p) {
+				uint32_t quantized[4];
+				float error = 0.f;
+				for (int d = 0; d < 4; ++d) {
+					const long q = std::lround((pValue[d] - static_cast<float>(p)) * 0.5f);
+					quantized[d] = static_cast<uint32_t>(std::clamp<long>(q, 0, 127));
+					const float diff = static_cast<float>((quantized[d] << 1) | p) - pValue[d];
+					error += diff * diff;
+				}
+				if (error < bestError) {
+					bestError = error;
+					pBit = p;
+					std::memcpy(pQuantized, quantized, sizeof(quantized));
+				}
+			}
+			for (int d = 0; d < 4; ++d) {
+				pRestored[d] = static_cast<int>((pQuantized[d] << 1) | pBit);
+			}
+		}
+
+		const int s_bc7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		/// Подбирает индексы BC7 режима 6 и считает ошибку.
+		uint32_t evaluateBC7(const float (*pPoints)[4], const int* pFirst, const int* pSecond, uint8_t* pIndices) {
+			int palette[16][4];
+			for (int i = 0; i < 16; ++i) {
+				for (int d = 0; d < 4; ++d) {
+					palette[i][d] = ((64 - s_bc7Weights4[i]) * pFirst[d] + s_bc7Weights4[i] * pSecond[d] + 32) >> 6;
+				}
+			}
+
+			uint32_t error = 0;
+			for (int i = 0; i < 16; ++i) {
+				uint32_t best = UINT32_MAX;
+				for (uint8_t p = 0; p < 16; ++p) {
+					uint32_t distance = 0;
+					for (int d = 0; d < 4; ++d) {
+						const int diff = static_cast<int>(pPoints[i][d]) - palette[p][d];
+						distance += diff * diff;
+					}
+					if (distance < best) {
+						best = distance;
+						pIndices[i] = p;
+					}
+				}
+				error += best;
+			}
+			return error;
+		}
+
+		/// Приводит пиксель с 1-4 каналами к RGBA.
+		void fetchPixel(const uint8_t* pPixel, uint32_t channels, bool bTwoChannel, uint8_t* pRgba) {
+			switch (channels) {
+			case 1:
+				pRgba[0] = pRgba[1] = pRgba[2] = pPixel[0];
+				pRgba[3] = 255;
+				break;
+			case 2:
+				if (bTwoChannel) {
+					pRgba[0] = pPixel[0];
+					pRgba[1] = pPixel[1];
+					pRgba[2] = 0;
+					pRgba[3] = 255;
+				}
+				else {
+					pRgba[0] = pRgba[1] = pRgba[2] = pPixel[0];
+					pRgba[3] = pPixel[1];
+				}
+				break;
+			case 3:
+				std::memcpy(pRgba, pPixel, 3);
+				pRgba[3] = 255;
+				break;
+			default:
+				std::memcpy(pRgba, pPixel, 4);
+				break;
+			}
+		}
+
+	} // namespace
+
+	void encodeBlockBC1(const uint8_t* pRgba, uint8_t* pOut) noexcept {
+		encodeColorBC1(pRgba, pOut);
+	}
+
+	void encodeBlockBC4(const uint8_t* pRgba, uint32_t channel, uint8_t* pOut) noexcept {
+		uint8_t lo = 255, hi = 0;
+		for (int i = 0; i < 16; ++i) {
+			lo = std::min(lo, pRgba[i * 4 + channel]);
+			hi = std::max(hi, pRgba[i * 4 + channel]);
+		}
+
+		std::memset(pOut, 0, 8);
+		pOut[0] = hi;
+		pOut[1] = lo;
+		if (hi == lo) {
+			return;
+		}
+
+		// 8-значный режим (первый конец больше второго): 0 - hi, 1 - lo, 2..7 - промежуточные.
+		int palette[8];
+		palette[0] = hi;
+		palette[1] = lo;
+		for (int i = 2; i < 8; ++i) {
+			palette[i] = ((8 - i) * hi + (i - 1) * lo) / 7;
+		}
+
+		uint64_t bits = 0;
+		for (int i = 0; i < 16; ++i) {
+			const int value = pRgba[i * 4 + channel];
+			int best = 256;
+			uint64_t bestIndex = 0;
+			for (int p = 0; p < 8; ++p) {
+				const int distance = std::abs(value - palette[p]);
+				if (distance < best) {
+					best = distance;
+					bestIndex = p;
+				}
+			}
+			bits |= bestIndex << (i * 3);
+		}
+
+		for (int i = 0; i < 6; ++i) {
+			pOut[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+		}
+	}
+
+	void encodeBlockBC3(const uint8_t* pRgba, uint8_t* pOut) noexcept {
+		encodeBlockBC4(pRgba, 3, pOut);
+		encodeColorBC1(pRgba, pOut + 8);
+	}
+
+	void encodeBlockBC5(const uint8_t* pRgba, uint8_t* pOut) noexcept {
+		encodeBlockBC4(pRgba, 0, pOut);
+		encodeBlockBC4(pRgba, 1, pOut + 8);
+	}
+
+	void encodeBlockBC7(const uint8_t* pRgba, uint8_t* pOut) noexcept {
+		float points[16][4];
+		for (int i = 0; i < 16; ++i) {
+			for (int d = 0; d < 4; ++d) {
+				points[i][d] = pRgba[i * 4 + d];
+			}
+		}
+
+		float first[4], second[4];
+		findEndpoints<4>(points, first, second);
+
+		uint32_t bestQuantized[2][4] = {};
+		uint32_t bestPBits[2] = {};
+		uint8_t bestIndices[16] = {};
+		uint32_t bestError = UINT32_MAX;
+
+		for (int iteration = 0; iteration < 3; ++iteration) {
+			uint32_t quantized[2][4];
+			uint32_t pBits[2];
+			int restored[2][4];
+			quantizeBC7Endpoint(first, quantized[0], pBits[0], restored[0]);
+			quantizeBC7Endpoint(second, quantized[1], pBits[1], restored[1]);
+
+			uint8_t indices[16];
+			const uint32_t error = evaluateBC7(points, restored[0], restored[1], indices);
+			if (error < bestError) {
+				bestError = error;
+				std::memcpy(bestQuantized, quantized, sizeof(quantized));
+				std::memcpy(bestPBits, pBits, sizeof(pBits));
+				std::memcpy(bestIndices, indices, sizeof(indices));
+			}
+			if (error == 0) {
+				break;
+			}
+
+			float weights[16];
+			for (int i = 0; i < 16; ++i) {
+				weights[i] = s_bc7Weights4[indices[i]] / 64.f;
+			}
+			if (!refineEndpoints<4>(points, weights, first, second)) {
+				break;
+			}
+		}
+
+		// Старший бит индекса первого пикселя не хранится и должен быть равен 0.
+		if (bestIndices[0] & 8) {
+			std::swap(bestQuantized[0], bestQuantized[1]);
+			std::swap(bestPBits[0], bestPBits[1]);
+			for (uint8_t& index : bestIndices) {
+				index = static_cast<uint8_t>(15 - index);
+			}
+		}
+
+		BlockBitWriter writer(pOut);
+		writer.write(1u << 6, 7);	// Режим 6.
+		for (int d = 0; d < 4; ++d) {
+			writer.write(bestQuantized[0][d], 7);
+			writer.write(bestQuantized[1][d], 7);
+		}
+		writer.write(bestPBits[0], 1);
+		writer.write(bestPBits[1], 1);
+		writer.write(bestIndices[0], 3);
+		for (int i = 1; i < 16; ++i) {
+			writer.write(bestIndices[i], 4);
+		}
+	}
+
+	bool compressImage(const Image& source, CompressedFormat format, Image& result, JobSystem* pJobSystem) {
+		if (!source.isValid() || source.pixelType != PixelType::UNorm8 || source.compression != CompressedFormat::None) {
+			LOG_ERR("Only uncompressed 8-bit images can be block-compressed");
+			return false;
+		}
+
+		void (*encodeBlock)(const uint8_t*, uint8_t*) = nullptr;
+		uint8_t channels = 4;
+		switch (format) {
+		case CompressedFormat::BC1:	encodeBlock = encodeBlockBC1; channels = 3; break;
+		case CompressedFormat::BC3:	encodeBlock = encodeBlockBC3; break;
+		case CompressedFormat::BC4:	encodeBlock = [](const uint8_t* pRgba, uint8_t* pOut) { encodeBlockBC4(pRgba, 0, pOut); }; channels = 1; break;
+		case CompressedFormat::BC5:	encodeBlock = encodeBlockBC5; channels = 2; break;
+		case CompressedFormat::BC7:	encodeBlock = encodeBlockBC7; break;
+		default:
+			LOG_ERR("Encoding to {0} is not supported", getCompressedFormatName(format));
+			return false;
+		}
+
+		const BlockInfo block = getBlockInfo(format);
+		const uint32_t sourceChannels = source.channels;
+		// Двухканальные изображения для BC5 - это RG (нормали), для остальных форматов - яркость с альфой.
+		const bool bTwoChannel = format == CompressedFormat::BC5;
+
+		result = Image{};
+		result.channels = channels;
+		result.pixelType = PixelType::UNorm8;
+		result.compression = format;
+		result.colorSpace = source.colorSpace;
+		result.levels.resize(source.levels.size());
+
+		for (size_t levelIndex = 0; levelIndex < source.levels.size(); ++levelIndex) {
+			const ImageLevel& src = source.levels[levelIndex];
+			ImageLevel& dst = result.levels[levelIndex];
+			dst.width = src.width;
+			dst.height = src.height;
+			dst.pixels.resize(getCompressedLevelSize(format, src.width, src.height));
+
+			const uint32_t blocksX = (src.width + 3) / 4;
+			const uint32_t blocksY = (src.height + 3) / 4;
+			const uint8_t* pSrc = src.getData();
+
+			auto encodeRows = [&](uint32_t begin, uint32_t end) {
+				uint8_t rgba[16 * 4];
+				for (uint32_t by = begin; by < end; ++by) {
+					uint8_t* pOut = dst.pixels.data() + static_cast<size_t>(by) * blocksX * block.bytes;
+					for (uint32_t bx = 0; bx < blocksX; ++bx, pOut += block.bytes) {
+						// Пиксели за краем изображения повторяют крайние.
+						for (uint32_t y = 0; y < 4; ++y) {
+							const uint32_t sy = std::min(by * 4 + y, src.height - 1);
+							for (uint32_t x = 0; x < 4; ++x) {
+								const uint32_t sx = std::min(bx * 4 + x, src.width - 1);
+								const uint8_t* pPixel = pSrc + (static_cast<size_t>(sy) * src.width + sx) * sourceChannels;
+								uint8_t* pBlock = rgba + (y * 4 + x) * 4;
+								fetchPixel(pPixel, sourceChannels, bTwoChannel, pBlock);
+							}
+						}
+						encodeBlock(rgba, pOut);
+					}
+				}
+			};
+
+			if (pJobSystem) {
+				pJobSystem->parallelFor(blocksY, std::max<uint32_t>(1, 1024 / blocksX), encodeRows);
+			}
+			else {
+				encodeRows(0, blocksY);
+			}
+		}
+
+		return true;
+	}
+
+} // namespace Engine
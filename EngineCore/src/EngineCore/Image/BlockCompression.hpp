@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "EngineCore/Image/Image.hpp"
+
+namespace Engine {
+
+	class JobSystem;
+
+	/**
+	 * @internal
+	 * @brief Размеры блока сжатого формата.
+	 */
+	struct BlockInfo {
+		uint8_t		width;		///< Ширина блока в пикселях.
+		uint8_t		height;		///< Высота блока в пикселях.
+		uint8_t		bytes;		///< Размер блока в байтах (0 - формат без сжатия).
+	};
+
+	/// @internal
+	/// @brief Возвращает размеры блока формата.
+	BlockInfo getBlockInfo(CompressedFormat format) noexcept;
+
+	/// @internal
+	/// @brief Возвращает название формата для логов и статистики.
+	const char* getCompressedFormatName(CompressedFormat format) noexcept;
+
+	/// @internal
+	/// @brief Размер уровня `width` x `height` в сжатом формате.
+	size_t getCompressedLevelSize(CompressedFormat format, uint32_t width, uint32_t height) noexcept;
+
+	/// @internal
+	/// @brief Сжимает блок 4x4 в BC1 (цвет без альфы).
+	/// @param pRgba 16 пикселей RGBA построчно.
+	/// @param [out] pOut 8 байт блока.
+	void encodeBlockBC1(const uint8_t* pRgba, uint8_t* pOut) noexcept;
+
+	/// @internal
+	/// @brief Сжимает один канал блока 4x4 в BC4.
+	/// @param pRgba 16 пикселей RGBA построчно.
+	/// @param channel Индекс сжимаемого канала (0-3).
+	/// @param [out] pOut 8 байт блока.
+	void encodeBlockBC4(const uint8_t* pRgba, uint32_t channel, uint8_t* pOut) noexcept;
+
+	/// @internal
+	/// @brief Сжимает блок 4x4 в BC3 (BC4 для альфы + BC1 для цвета), 16 байт.
+	void encodeBlockBC3(const uint8_t* pRgba, uint8_t* pOut) noexcept;
+
+	/// @internal
+	/// @brief Сжимает каналы R и G блока 4x4 в BC5, 16 байт.
+	void encodeBlockBC5(const uint8_t* pRgba, uint8_t* pOut) noexcept;
+
+	/// @internal
+	/// @brief Сжимает блок 4x4 в BC7 (режим 6: одна пара RGBA концов, 16 уровней), 16 байт.
+	void encodeBlockBC7(const uint8_t* pRgba, uint8_t* pOut) noexcept;
+
+	/// @internal
+	/// @brief Сжимает все уровни 8-битного изображения в блочный формат.
+	///
+	/// Строки блоков распределяются между потоками `pJobSystem`.
+	///
+	/// @param source Несжатое изображение (1-4 канала, `PixelType::UNorm8`).
+	/// @param format Формат BC1, BC3, BC4, BC5 или BC7 (ASTC не кодируется).
+	/// @param [out] result Сжатое изображение.
+	/// @param pJobSystem Пул потоков (может быть nullptr).
+	/// @return false, если формат или исходное изображение не поддерживаются.
+	bool compressImage(const Image& source, CompressedFormat format, Image& result, JobSystem* pJobSystem = nullptr);
+
+} // namespace Engine
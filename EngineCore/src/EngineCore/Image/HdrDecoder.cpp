@@ -0,0 +1,179 @@
+#include "EngineCore/Image/ImageDecoders.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	bool isHdr(const uint8_t* pData, size_t size) noexcept {
+		return (size >= 10 && std::memcmp(pData, "#?RADIANCE", 10) == 0)
+			|| (size >= 6 && std::memcmp(pData, "#?RGBE", 6) == 0);
+	}
+
+	/// @internal
+	/// @brief Читает строку заголовка до '\n'.
+	static bool readLine(const uint8_t* pData, size_t size, size_t& offset, std::string& line) {
+		line.clear();
+		while (offset < size) {
+			const char c = static_cast<char>(pData[offset++]);
+			if (c == '\n') {
+				return true;
+			}
+			line.push_back(c);
+		}
+		return false;
+	}
+
+	/// @internal
+	/// @brief Распаковывает одну строку в формате RGBE (4 байта на пиксель).
+	///
+	/// Поддерживается новое RLE (каналы раздельно), старое RLE (повтор 1,1,1,n)
+	/// и несжатые строки.
+	static bool readScanline(const uint8_t* pData, size_t size, size_t& offset, uint32_t width, uint8_t* pOut) {
+		if (offset + 4 > size) {
+			return false;
+		}
+
+		const uint8_t* p = pData + offset;
+		const bool bNewRle = width >= 8 && width < 32768 && p[0] == 2 && p[1] == 2 && (p[2] & 0x80) == 0;
+		if (bNewRle) {
+			if (((static_cast<uint32_t>(p[2]) << 8) | p[3]) != width) {
+				return false;
+			}
+			offset += 4;
+
+			for (uint32_t channel = 0; channel < 4; ++channel) {
+				uint32_t x = 0;
+				while (x < width) {
+					if (offset >= size) {
+						return false;
+					}
+					uint32_t count = pData[offset++];
+					if (count > 128) {
+						count -= 128;
+						if (offset >= size || x + count > width) {
+							return false;
+						}
+						const uint8_t value = pData[offset++];
+						for (uint32_t i = 0; i < count; ++i) {
+							pOut[(x++) * 4 + channel] = value;
+						}
+					}
+					else {
+						if (count == 0 || offset + count > size || x + count > width) {
+							return false;
+						}
+						for (uint32_t i = 0; i < count; ++i) {
+							pOut[(x++) * 4 + channel] = pData[offset++];
+						}
+					}
+				}
+			}
+			return true;
+		}
+
+		uint32_t x = 0;
+		uint32_t shift = 0;
+		while (x < width) {
+			if (offset + 4 > size) {
+				return false;
+			}
+			const uint8_t* pPixel = pData + offset;
+			offset += 4;
+
+			if (pPixel[0] == 1 && pPixel[1] == 1 && pPixel[2] == 1) {
+				if (x == 0) {
+					return false;
+				}
+				const uint32_t count = static_cast<uint32_t>(pPixel[3]) << shift;
+				if (x + count > width) {
+					return false;
+				}
+				for (uint32_t i = 0; i < count; ++i, ++x) {
+					std::memcpy(pOut + x * 4, pOut + (x - 1) * 4, 4);
+				}
+				shift += 8;
+			}
+			else {
+				std::memcpy(pOut + x * 4, pPixel, 4);
+				++x;
+				shift = 0;
+			}
+		}
+		return true;
+	}
+
+	bool decodeHdr(const uint8_t* pData, size_t size, Image& image) {
+		if (!isHdr(pData, size)) {
+			return false;
+		}
+
+		size_t offset = 0;
+		std::string line;
+		bool bFormatOk = true;
+		while (readLine(pData, size, offset, line) && !line.empty()) {
+			if (line.compare(0, 7, "FORMAT=") == 0) {
+				bFormatOk = line == "FORMAT=32-bit_rle_rgbe";
+			}
+		}
+		if (!bFormatOk) {
+			LOG_ERR("Unsupported HDR pixel format");
+			return false;
+		}
+
+		int width = 0;
+		int height = 0;
+		if (!readLine(pData, size, offset, line) || std::sscanf(line.c_str(), "-Y %d +X %d", &height, &width) != 2) {
+			LOG_ERR("Unsupported HDR orientation '{0}'", line);
+			return false;
+		}
+		if (width <= 0 || height <= 0 || static_cast<uint64_t>(width) * height > MaxDecodedPixels) {
+			LOG_ERR("Invalid HDR size {0}x{1}", width, height);
+			return false;
+		}
+		// Любая строка занимает хотя бы 4 байта.
+		if ((size - offset) / 4 < static_cast<size_t>(height)) {
+			LOG_ERR("HDR data is too short for {0}x{1}", width, height);
+			return false;
+		}
+
+		ImageLevel level;
+		level.width = static_cast<uint32_t>(width);
+		level.height = static_cast<uint32_t>(height);
+		level.pixels.resize(static_cast<size_t>(width) * height * 3 * sizeof(float));
+
+		std::vector<uint8_t> scanline(static_cast<size_t>(width) * 4);
+		float* pOut = reinterpret_cast<float*>(level.pixels.data());
+		for (int y = 0; y < height; ++y) {
+			if (!readScanline(pData, size, offset, level.width, scanline.data())) {
+				LOG_ERR("Corrupted HDR scanline {0}", y);
+				return false;
+			}
+
+			for (int x = 0; x < width; ++x) {
+				const uint8_t* pRgbe = scanline.data() + x * 4;
+				if (pRgbe[3] == 0) {
+					pOut[0] = pOut[1] = pOut[2] = 0.f;
+				}
+				else {
+					const float scale = std::ldexp(1.f, static_cast<int>(pRgbe[3]) - (128 + 8));
+					pOut[0] = pRgbe[0] * scale;
+					pOut[1] = pRgbe[1] * scale;
+					pOut[2] = pRgbe[2] * scale;
+				}
+				pOut += 3;
+			}
+		}
+
+		image.levels.clear();
+		image.levels.push_back(std::move(level));
+		image.channels = 3;
+		image.pixelType = PixelType::Float32;
+		return true;
+	}
+
+} // namespace Engine
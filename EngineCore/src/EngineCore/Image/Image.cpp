@@ -0,0 +1,233 @@
+#include "EngineCore/Image/Image.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <new>
+
+#include "EngineCore/Core/MappedFile.hpp"
+#include "EngineCore/Image/ImageDecoders.hpp"
+#include "EngineCore/Image/Ktx2.hpp"
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	size_t Image::getTotalBytes() const noexcept {
+		size_t total = 0;
+		for (const ImageLevel& level : levels) {
+			total += level.getSize();
+		}
+		return total;
+	}
+
+	/// @internal
+	/// @brief Выбирает декодер по сигнатуре данных.
+	static bool decodeBySignature(const uint8_t* pData, size_t size, Image& image) {
+		if (isPng(pData, size)) {
+			return decodePng(pData, size, image);
+		}
+		if (isJpeg(pData, size)) {
+			return decodeJpeg(pData, size, image);
+		}
+		if (isHdr(pData, size)) {
+			return decodeHdr(pData, size, image);
+		}
+		if (isKtx2(pData, size)) {
+			// Данные не принадлежат изображению, поэтому уровни копируются.
+			if (!readKtx2(pData, size, image)) {
+				return false;
+			}
+			for (ImageLevel& level : image.levels) {
+				level.pixels.assign(level.pExternal, level.pExternal + level.externalSize);
+				level.pExternal = nullptr;
+				level.externalSize = 0;
+			}
+			return true;
+		}
+
+		LOG_ERR("Unknown image format");
+		return false;
+	}
+
+	bool decodeImage(const uint8_t* pData, size_t size, Image& image) {
+		image = Image{};
+
+		// Декодирование идёт в задачах JobSystem: исключение, вышедшее из задачи, завершило бы процесс.
+		bool bDecoded = false;
+		try {
+			bDecoded = decodeBySignature(pData, size, image);
+		}
+		catch (const std::bad_alloc&) {
+			LOG_ERR("Not enough memory to decode image ({0} bytes)", size);
+		}
+		if (!bDecoded) {
+			image = Image{};
+		}
+		return bDecoded;
+	}
+
+	bool loadImageFile(const std::string& path, Image& image) {
+		auto pFile = std::make_shared<MappedFile>();
+		if (!pFile->open(path)) {
+			LOG_ERR("Can not open image {0}", path);
+			return false;
+		}
+
+		if (isKtx2(pFile->getData(), pFile->getSize())) {
+			image = Image{};
+			if (!readKtx2(pFile->getData(), pFile->getSize(), image)) {
+				LOG_ERR("Can not read KTX2 image {0}", path);
+				return false;
+			}
+			image.pStorage = std::move(pFile);
+			return true;
+		}
+
+		if (!decodeImage(pFile->getData(), pFile->getSize(), image)) {
+			LOG_ERR("Can not decode image {0}", path);
+			return false;
+		}
+		return true;
+	}
+
+	void expandToRGBA(Image& image) {
+		if (image.channels != 3 || image.pixelType != PixelType::UNorm8 || image.compression != CompressedFormat::None) {
+			return;
+		}
+
+		for (ImageLevel& level : image.levels) {
+			const size_t pixelCount = static_cast<size_t>(level.width) * level.height;
+			std::vector<uint8_t> rgba(pixelCount * 4);
+			for (size_t i = 0; i < pixelCount; ++i) {
+				rgba[i * 4 + 0] = level.pixels[i * 3 + 0];
+				rgba[i * 4 + 1] = level.pixels[i * 3 + 1];
+				rgba[i * 4 + 2] = level.pixels[i * 3 + 2];
+				rgba[i * 4 + 3] = 255;
+			}
+			level.pixels = std::move(rgba);
+		}
+		image.channels = 4;
+	}
+
+	uint32_t getMipLevelCount(uint32_t width, uint32_t height) noexcept {
+		uint32_t levels = 1;
+		uint32_t size = std::max(width, height);
+		while (size > 1) {
+			size >>= 1;
+			++levels;
+		}
+		return levels;
+	}
+
+	/// @internal
+	/// @brief Таблицы перевода между sRGB и линейным пространством.
+	struct SRGBTables {
+		static constexpr uint32_t LinearResolution = 4096;
+
+		std::array<float, 256>					toLinear;
+		std::array<uint8_t, LinearResolution>	fromLinear;
+
+		SRGBTables() {
+			for (uint32_t i = 0; i < 256; ++i) {
+				const float c = i / 255.f;
+				toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+			for (uint32_t i = 0; i < LinearResolution; ++i) {
+				const float l = i / static_cast<float>(LinearResolution - 1);
+				const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.f / 2.4f) - 0.055f;
+				fromLinear[i] = static_cast<uint8_t>(std::clamp(c * 255.f + 0.5f, 0.f, 255.f));
+			}
+		}
+	};
+
+	/// @internal
+	/// @brief Уменьшает уровень `src` вдвое фильтром 2x2.
+	template<typename T, typename ToFloat, typename FromFloat>
+	static void downsample(
+		const ImageLevel&	src,
+		ImageLevel&			dst,
+		uint32_t			channels,
+		uint32_t			linearChannels,
+		ToFloat				toFloat,
+		FromFloat			fromFloat
+	) {
+		dst.width = std::max(src.width / 2, 1u);
+		dst.height = std::max(src.height / 2, 1u);
+		dst.pixels.resize(static_cast<size_t>(dst.width) * dst.height * channels * sizeof(T));
+
+		const T* pSrc = reinterpret_cast<const T*>(src.getData());
+		T* pDst = reinterpret_cast<T*>(dst.pixels.data());
+
+		for (uint32_t y = 0; y < dst.height; ++y) {
+			const uint32_t y0 = std::min(y * 2, src.height - 1);
+			const uint32_t y1 = std::min(y * 2 + 1, src.height - 1);
+
+			for (uint32_t x = 0; x < dst.width; ++x) {
+				const uint32_t x0 = std::min(x * 2, src.width - 1);
+				const uint32_t x1 = std::min(x * 2 + 1, src.width - 1);
+
+				const size_t i00 = (static_cast<size_t>(y0) * src.width + x0) * channels;
+				const size_t i01 = (static_cast<size_t>(y0) * src.width + x1) * channels;
+				const size_t i10 = (static_cast<size_t>(y1) * src.width + x0) * channels;
+				const size_t i11 = (static_cast<size_t>(y1) * src.width + x1) * channels;
+				const size_t o = (static_cast<size_t>(y) * dst.width + x) * channels;
+
+				for (uint32_t c = 0; c < channels; ++c) {
+					// Каналы цвета усредняются в линейном пространстве, альфа - как есть.
+					const bool bLinear = c < linearChannels;
+					const float sum =
+						toFloat(pSrc[i00 + c], bLinear) + toFloat(pSrc[i01 + c], bLinear) +
+						toFloat(pSrc[i10 + c], bLinear) + toFloat(pSrc[i11 + c], bLinear);
+					pDst[o + c] = fromFloat(sum * 0.25f, bLinear);
+				}
+			}
+		}
+	}
+
+	void generateMipChain(Image& image, bool bSRGB) {
+		if (!image.isValid() || image.compression != CompressedFormat::None) {
+			return;
+		}
+
+		image.levels.resize(1);
+		const uint32_t levelCount = getMipLevelCount(image.getWidth(), image.getHeight());
+		image.levels.reserve(levelCount);
+
+		const uint32_t channels = image.channels;
+
+		if (image.pixelType == PixelType::Float32) {
+			for (uint32_t level = 1; level < levelCount; ++level) {
+				image.levels.emplace_back();
+				downsample<float>(
+					image.levels[level - 1], image.levels[level], channels, 0,
+					[](float v, bool) { return v; },
+					[](float v, bool) { return v; }
+				);
+			}
+			return;
+		}
+
+		static const SRGBTables s_tables;
+
+		// В 2- и 4-канальных изображениях последний канал - альфа.
+		const uint32_t colorChannels = bSRGB ? (channels == 2 || channels == 4 ? channels - 1 : channels) : 0;
+
+		for (uint32_t level = 1; level < levelCount; ++level) {
+			image.levels.emplace_back();
+			downsample<uint8_t>(
+				image.levels[level - 1], image.levels[level], channels, colorChannels,
+				[](uint8_t v, bool bLinear) {
+					return bLinear ? s_tables.toLinear[v] : v / 255.f;
+				},
+				[](float v, bool bLinear) -> uint8_t {
+					if (bLinear) {
+						const float scaled = v * (SRGBTables::LinearResolution - 1) + 0.5f;
+						return s_tables.fromLinear[std::min<uint32_t>(static_cast<uint32_t>(scaled), SRGBTables::LinearResolution - 1)];
+					}
+					return static_cast<uint8_t>(std::clamp(v * 255.f + 0.5f, 0.f, 255.f));
+				}
+			);
+		}
+	}
+
+} // namespace Engine
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Тип компонента пикселя.
+	 */
+	enum class PixelType : uint8_t {
+		UNorm8,		///< 8 бит на компонент, [0, 255] -> [0, 1].
+		Float32		///< 32-битное число с плавающей точкой (HDR).
+	};
+
+	/**
+	 * @internal
+	 * @brief Блочный формат сжатия.
+	 *
+	 * Данные уровня хранятся блоками (4x4 для BC), строки блоков идут сверху вниз.
+	 */
+	enum class CompressedFormat : uint8_t {
+		None,		///< Без сжатия.
+		BC1,		///< RGB, 8 байт на блок 4x4.
+		BC3,		///< RGBA, 16 байт на блок (BC1 для цвета + BC4 для альфы).
+		BC4,		///< Один канал, 8 байт на блок.
+		BC5,		///< Два канала (например, нормали), 16 байт на блок.
+		BC7,		///< RGBA высокого качества, 16 байт на блок.
+		ASTC_4x4,	///< ASTC LDR, 16 байт на блок 4x4 (только чтение из KTX2).
+		ASTC_6x6,	///< ASTC LDR, 16 байт на блок 6x6 (только чтение из KTX2).
+		ASTC_8x8	///< ASTC LDR, 16 байт на блок 8x8 (только чтение из KTX2).
+	};
+
+	/**
+	 * @internal
+	 * @brief Цветовое пространство данных изображения.
+	 */
+	enum class ColorSpace : uint8_t {
+		Unknown,	///< Не указано в файле (решает вызывающий код).
+		Linear,		///< Линейные данные (нормали, маски, HDR).
+		SRGB		///< Цвет в sRGB.
+	};
+
+	/**
+	 * @internal
+	 * @brief Один уровень детализации изображения.
+	 *
+	 * Данные уровня лежат либо в `pixels`, либо во внешней памяти
+	 * (например, в отображённом файле), которой владеет `Image::pStorage`.
+	 */
+	struct ImageLevel {
+		uint32_t				width			= 0;
+		uint32_t				height			= 0;
+		std::vector<uint8_t>	pixels;					///< Пиксели построчно, без выравнивания строк.
+		const uint8_t*			pExternal		= nullptr;	///< Данные во внешней памяти (если заданы).
+		size_t					externalSize	= 0;
+
+		const uint8_t* getData() const noexcept { return pExternal ? pExternal : pixels.data(); }
+		size_t getSize() const noexcept { return pExternal ? externalSize : pixels.size(); }
+	};
+
+	/**
+	 * @internal
+	 * @brief Декодированное изображение с цепочкой mip-уровней.
+	 *
+	 * `levels[0]` - исходное изображение, следующие уровни (если есть) вдвое меньше предыдущего.
+	 */
+	struct Image {
+		std::vector<ImageLevel>	levels;
+		uint8_t					channels	= 0;
+		PixelType				pixelType	= PixelType::UNorm8;
+		CompressedFormat		compression	= CompressedFormat::None;
+		ColorSpace				colorSpace	= ColorSpace::Unknown;
+		std::shared_ptr<void>	pStorage;	///< Владелец внешней памяти уровней.
+
+		uint32_t getWidth() const noexcept { return levels.empty() ? 0 : levels[0].width; }
+		uint32_t getHeight() const noexcept { return levels.empty() ? 0 : levels[0].height; }
+		size_t getBytesPerPixel() const noexcept { return channels * (pixelType == PixelType::Float32 ? 4 : 1); }
+		bool isValid() const noexcept { return !levels.empty() && channels > 0; }
+
+		/// @internal
+		/// @brief Суммарный размер всех уровней в байтах.
+		size_t getTotalBytes() const noexcept;
+	};
+
+	/// @internal
+	/// @brief Декодирует изображение из памяти (PNG, JPEG, Radiance HDR).
+	///
+	/// Формат определяется по сигнатуре данных.
+	///
+	/// @param pData Данные файла.
+	/// @param size Размер данных в байтах.
+	/// @param [out] image Декодированное изображение (только уровень 0).
+	/// @return true, если изображение успешно декодировано. При ошибке, в том числе нехватке памяти,
+	/// возвращается false и пустое изображение, исключения наружу не выходят.
+	bool decodeImage(const uint8_t* pData, size_t size, Image& image);
+
+	/// @internal
+	/// @brief Читает файл и декодирует изображение.
+	///
+	/// Файлы KTX2 отображаются в память и не копируются: уровни изображения
+	/// ссылаются на отображение, которым владеет `image.pStorage`.
+	bool loadImageFile(const std::string& path, Image& image);
+
+	/// @internal
+	/// @brief Дополняет 3-канальное 8-битное изображение до 4 каналов (альфа = 255).
+	///
+	/// Формат RGBA8 копируется в текстуру без выравнивания строк и хранится GPU напрямую.
+	void expandToRGBA(Image& image);
+
+	/// @internal
+	/// @brief Строит цепочку mip-уровней фильтром 2x2 до размера 1x1.
+	/// @param image Изображение с заполненным уровнем 0.
+	/// @param bSRGB Усреднять ли цветовые каналы в линейном пространстве.
+	void generateMipChain(Image& image, bool bSRGB);
+
+	/// @internal
+	/// @brief Кол-во mip-уровней для текстуры заданного размера.
+	uint32_t getMipLevelCount(uint32_t width, uint32_t height) noexcept;
+
+} // namespace Engine
@@ -0,0 +1,74 @@
+#include "EngineCore/Image/ImageCache.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+
+#include "EngineCore/Core/Hash.hpp"
+#include "EngineCore/Core/MappedFile.hpp"
+#include "EngineCore/Image/Ktx2.hpp"
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Версия формата записей: увеличивается при изменении кодировщиков,
+	/// чтобы старые записи перестали совпадать по ключу.
+	static constexpr uint32_t CacheVersion = 1;
+
+	ImageCache::ImageCache(std::string directory)
+		: m_directory(std::move(directory))
+	{
+	}
+
+	uint64_t ImageCache::makeKey(
+		const uint8_t*		pSource,
+		size_t				size,
+		CompressedFormat	format,
+		ColorSpace			colorSpace,
+		bool				bMips
+	) noexcept {
+		const uint8_t params[] = {
+			static_cast<uint8_t>(CacheVersion),
+			static_cast<uint8_t>(format),
+			static_cast<uint8_t>(colorSpace),
+			static_cast<uint8_t>(bMips)
+		};
+		return hash64(pSource, size, hash64(params, sizeof(params)));
+	}
+
+	std::string ImageCache::getPath(uint64_t key) const {
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.ktx2", static_cast<unsigned long long>(key));
+		return (std::filesystem::path(m_directory) / name).string();
+	}
+
+	bool ImageCache::load(uint64_t key, Image& image) const {
+		auto pFile = std::make_shared<MappedFile>();
+		if (!pFile->open(getPath(key))) {
+			return false;
+		}
+
+		image = Image{};
+		if (!readKtx2(pFile->getData(), pFile->getSize(), image)) {
+			LOG_WARN("Corrupted texture cache entry {0}", getPath(key));
+			return false;
+		}
+		image.pStorage = std::move(pFile);
+		return true;
+	}
+
+	bool ImageCache::store(uint64_t key, const Image& image) const {
+		std::error_code error;
+		std::filesystem::create_directories(m_directory, error);
+		if (error) {
+			LOG_ERR("Can not create cache directory {0}: {1}", m_directory, error.message());
+			return false;
+		}
+
+		// `writeKtx2()` пишет во временный файл и переименовывает его целиком: после сбоя
+		// или при одновременном чтении в кеше не бывает обрезанных записей.
+		return writeKtx2(getPath(key), image);
+	}
+
+} // namespace Engine
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "EngineCore/Image/Image.hpp"
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Дисковый кеш подготовленных (сжатых) изображений.
+	 *
+	 * Результат дорогой обработки исходного файла (декодирование, mip-уровни,
+	 * блочное сжатие) сохраняется в KTX2 под ключом, вычисленным по содержимому
+	 * файла и параметрам обработки. При следующих запусках файл кеша отображается
+	 * в память и уровни загружаются на GPU без копирования и повторного сжатия.
+	 *
+	 * Изменение исходного файла меняет ключ, поэтому устаревшие записи не используются
+	 * (и могут быть удалены вместе с каталогом кеша в любой момент).
+	 *
+	 * @note Методы можно вызывать из любого потока.
+	 */
+	class ImageCache {
+	public:
+		explicit ImageCache(std::string directory);
+
+		/// @internal
+		/// @brief Вычисляет ключ кеша.
+		/// @param pSource Содержимое исходного файла.
+		/// @param size Размер исходного файла.
+		/// @param format Целевой формат сжатия.
+		/// @param colorSpace Цветовое пространство (влияет на построение mip-уровней).
+		/// @param bMips Строились ли mip-уровни.
+		static uint64_t makeKey(
+			const uint8_t*		pSource,
+			size_t				size,
+			CompressedFormat	format,
+			ColorSpace			colorSpace,
+			bool				bMips
+		) noexcept;
+
+		/// @internal
+		/// @brief Отображает запись кеша в память.
+		/// @return false, если записи нет или она повреждена.
+		bool load(uint64_t key, Image& image) const;
+
+		/// @internal
+		/// @brief Сохраняет изображение под ключом `key`.
+		bool store(uint64_t key, const Image& image) const;
+
+		/// @internal
+		/// @brief Путь к файлу записи.
+		std::string getPath(uint64_t key) const;
+
+		const std::string& getDirectory() const noexcept { return m_directory; }
+
+	private:
+		std::string		m_directory;
+	};
+
+} // namespace Engine
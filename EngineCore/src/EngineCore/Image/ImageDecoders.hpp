@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "EngineCore/Image/Image.hpp"
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Наибольшее кол-во пикселей декодируемого изображения (8192 x 8192).
+	///
+	/// Размеры берутся из заголовка файла: без предела заголовок в несколько десятков байт
+	/// заставил бы выделить под пиксели сотни гигабайт.
+	static constexpr uint64_t MaxDecodedPixels = uint64_t(1) << 26;
+
+	/// @internal
+	/// @brief Декодирует PNG (все типы цвета, глубина 1-16 бит, Adam7).
+	bool decodePng(const uint8_t* pData, size_t size, Image& image);
+
+	/// @internal
+	/// @brief Декодирует baseline JPEG (Хаффман, 8 бит, произвольная субдискретизация).
+	bool decodeJpeg(const uint8_t* pData, size_t size, Image& image);
+
+	/// @internal
+	/// @brief Декодирует Radiance HDR (RGBE, с RLE и без) в RGB float.
+	bool decodeHdr(const uint8_t* pData, size_t size, Image& image);
+
+	bool isPng(const uint8_t* pData, size_t size) noexcept;
+	bool isJpeg(const uint8_t* pData, size_t size) noexcept;
+	bool isHdr(const uint8_t* pData, size_t size) noexcept;
+
+} // namespace Engine
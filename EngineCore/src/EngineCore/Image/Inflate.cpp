@@ -0,0 +1,345 @@
+#include "EngineCore/Image/Inflate.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Кол-во бит, декодируемых за один поиск в таблице Хаффмана.
+	constexpr uint32_t HuffmanFastBits = 10;
+	constexpr uint32_t HuffmanMaxBits = 15;
+
+	/// @internal
+	/// @brief Читатель битов в порядке deflate (младшие биты первыми).
+	struct BitReader {
+		const uint8_t*	pData;
+		size_t			size;
+		size_t			position	= 0;
+		uint64_t		buffer		= 0;
+		uint32_t		bitCount	= 0;
+		bool			bOverrun	= false;
+
+		void refill() {
+			while (bitCount <= 56) {
+				uint64_t byte = 0;
+				if (position < size) {
+					byte = pData[position];
+				}
+				else if (position > size + 8) {
+					// Чтение далеко за концом данных - поток повреждён.
+					bOverrun = true;
+				}
+				++position;
+				buffer |= byte << bitCount;
+				bitCount += 8;
+			}
+		}
+
+		uint32_t peek(uint32_t count) {
+			if (bitCount < count) {
+				refill();
+			}
+			return static_cast<uint32_t>(buffer & ((1ull << count) - 1));
+		}
+
+		void consume(uint32_t count) {
+			buffer >>= count;
+			bitCount -= count;
+		}
+
+		uint32_t read(uint32_t count) {
+			if (count == 0) {
+				return 0;
+			}
+			const uint32_t value = peek(count);
+			consume(count);
+			return value;
+		}
+
+		/// Пропускает биты до границы байта.
+		void alignToByte() {
+			consume(bitCount & 7);
+		}
+	};
+
+	/// @internal
+	/// @brief Каноническая таблица Хаффмана с быстрым поиском по первым битам.
+	struct HuffmanTable {
+		// Быстрая таблица: символ в младших 16 битах, длина кода в старших (0 - длинный код).
+		uint32_t	fast[1 << HuffmanFastBits];
+		uint16_t	count[HuffmanMaxBits + 1];
+		uint16_t	symbols[320];
+
+		bool build(const uint8_t* lengths, uint32_t symbolCount) {
+			std::memset(count, 0, sizeof(count));
+			std::memset(fast, 0, sizeof(fast));
+
+			for (uint32_t i = 0; i < symbolCount; ++i) {
+				++count[lengths[i]];
+			}
+			count[0] = 0;
+
+			// Проверка на переполнение кодового пространства.
+			int left = 1;
+			for (uint32_t len = 1; len <= HuffmanMaxBits; ++len) {
+				left <<= 1;
+				left -= count[len];
+				if (left < 0) {
+					return false;
+				}
+			}
+
+			uint16_t offsets[HuffmanMaxBits + 2];
+			offsets[1] = 0;
+			for (uint32_t len = 1; len <= HuffmanMaxBits; ++len) {
+				offsets[len + 1] = offsets[len] + count[len];
+			}
+			for (uint32_t i = 0; i < symbolCount; ++i) {
+				if (lengths[i] != 0) {
+					symbols[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+				}
+			}
+
+			// Заполнение быстрой таблицы кодами длиной до HuffmanFastBits.
+			uint32_t code = 0;
+			uint32_t index = 0;
+			for (uint32_t len = 1; len <= HuffmanFastBits; ++len) {
+				for (uint32_t k = 0; k < count[len]; ++k, ++code, ++index) {
+					uint32_t reversed = 0;
+					for (uint32_t bit = 0; bit < len; ++bit) {
+						reversed |= ((code >> bit) & 1) << (len - 1 - bit);
+					}
+					for (uint32_t slot = reversed; slot < (1u << HuffmanFastBits); slot += 1u << len) {
+						fast[slot] = symbols[index] | (len << 16);
+					}
+				}
+				code <<= 1;
+			}
+			return true;
+		}
+
+		/// Декодирует один символ. Возвращает -1 при ошибке.
+		int decode(BitReader& reader) const {
+			const uint32_t entry = fast[reader.peek(HuffmanFastBits)];
+			if (entry >> 16) {
+				reader.consume(entry >> 16);
+				return static_cast<int>(entry & 0xFFFF);
+			}
+
+			// Медленный путь: побитовое декодирование длинных кодов.
+			int code = 0;
+			int first = 0;
+			int index = 0;
+			for (uint32_t len = 1; len <= HuffmanMaxBits; ++len) {
+				code |= static_cast<int>(reader.read(1));
+				const int countAtLen = count[len];
+				if (code - countAtLen < first) {
+					return symbols[index + (code - first)];
+				}
+				index += countAtLen;
+				first += countAtLen;
+				first <<= 1;
+				code <<= 1;
+			}
+			return -1;
+		}
+	};
+
+	static const uint16_t s_lengthBase[29] = {
+		3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+		35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+	};
+	static const uint8_t s_lengthExtra[29] = {
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+		3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+	};
+	static const uint16_t s_distanceBase[30] = {
+		1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+		257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+	};
+	static const uint8_t s_distanceExtra[30] = {
+		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+		7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+	};
+
+	/// @internal
+	/// @brief Распаковывает один сжатый блок по таблицам `lengths` и `distances`.
+	static bool inflateBlock(
+		BitReader&				reader,
+		const HuffmanTable&		lengths,
+		const HuffmanTable&		distances,
+		std::vector<uint8_t>&	output,
+		size_t					outputStart
+	) {
+		while (true) {
+			const int symbol = lengths.decode(reader);
+			if (symbol < 0 || reader.bOverrun) {
+				return false;
+			}
+
+			if (symbol < 256) {
+				output.push_back(static_cast<uint8_t>(symbol));
+				continue;
+			}
+			if (symbol == 256) {
+				return true;
+			}
+
+			const int lengthIndex = symbol - 257;
+			if (lengthIndex >= 29) {
+				return false;
+			}
+			const size_t length = s_lengthBase[lengthIndex] + reader.read(s_lengthExtra[lengthIndex]);
+
+			const int distanceIndex = distances.decode(reader);
+			if (distanceIndex < 0 || distanceIndex >= 30) {
+				return false;
+			}
+			const size_t distance = s_distanceBase[distanceIndex] + reader.read(s_distanceExtra[distanceIndex]);
+			if (distance > output.size() - outputStart) {
+				return false;
+			}
+
+			// Копирование по байту: источник и приёмник могут перекрываться.
+			size_t from = output.size() - distance;
+			output.resize(output.size() + length);
+			uint8_t* pOut = output.data() + output.size() - length;
+			const uint8_t* pFrom = output.data() + from;
+			for (size_t i = 0; i < length; ++i) {
+				pOut[i] = pFrom[i];
+			}
+		}
+	}
+
+	bool inflateZlib(const uint8_t* pData, size_t size, std::vector<uint8_t>& output, size_t sizeHint) {
+		if (size < 2) {
+			return false;
+		}
+
+		const uint8_t cmf = pData[0];
+		const uint8_t flg = pData[1];
+		if ((cmf & 0x0F) != 8 || ((cmf << 8) | flg) % 31 != 0 || (flg & 0x20)) {
+			LOG_ERR("Unsupported zlib header");
+			return false;
+		}
+
+		const size_t outputStart = output.size();
+		output.reserve(outputStart + std::min(sizeHint, (size - 2) * MaxDeflateRatio));
+
+		BitReader reader{ pData + 2, size - 2 };
+
+		HuffmanTable lengths;
+		HuffmanTable distances;
+
+		bool bFinal = false;
+		while (!bFinal) {
+			bFinal = reader.read(1) != 0;
+			const uint32_t type = reader.read(2);
+
+			if (type == 0) {
+				// Несжатый блок.
+				reader.alignToByte();
+				const uint32_t length = reader.read(16);
+				const uint32_t negLength = reader.read(16);
+				if ((length ^ 0xFFFF) != negLength) {
+					return false;
+				}
+				for (uint32_t i = 0; i < length; ++i) {
+					output.push_back(static_cast<uint8_t>(reader.read(8)));
+				}
+				if (reader.bOverrun) {
+					return false;
+				}
+				continue;
+			}
+
+			if (type == 1) {
+				// Фиксированные коды Хаффмана.
+				uint8_t codeLengths[288];
+				std::memset(codeLengths, 8, 144);
+				std::memset(codeLengths + 144, 9, 112);
+				std::memset(codeLengths + 256, 7, 24);
+				std::memset(codeLengths + 280, 8, 8);
+				lengths.build(codeLengths, 288);
+
+				uint8_t distanceLengths[30];
+				std::memset(distanceLengths, 5, 30);
+				distances.build(distanceLengths, 30);
+			}
+			else if (type == 2) {
+				// Динамические коды Хаффмана.
+				const uint32_t literalCount = reader.read(5) + 257;
+				const uint32_t distanceCount = reader.read(5) + 1;
+				const uint32_t codeLengthCount = reader.read(4) + 4;
+
+				static const uint8_t order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+				uint8_t codeLengthLengths[19] = {};
+				for (uint32_t i = 0; i < codeLengthCount; ++i) {
+					codeLengthLengths[order[i]] = static_cast<uint8_t>(reader.read(3));
+				}
+
+				HuffmanTable codeLengthTable;
+				if (!codeLengthTable.build(codeLengthLengths, 19)) {
+					return false;
+				}
+
+				uint8_t codeLengths[320] = {};
+				uint32_t index = 0;
+				while (index < literalCount + distanceCount) {
+					const int symbol = codeLengthTable.decode(reader);
+					if (symbol < 0) {
+						return false;
+					}
+
+					if (symbol < 16) {
+						codeLengths[index++] = static_cast<uint8_t>(symbol);
+						continue;
+					}
+
+					uint8_t value = 0;
+					uint32_t repeat;
+					if (symbol == 16) {
+						if (index == 0) {
+							return false;
+						}
+						value = codeLengths[index - 1];
+						repeat = 3 + reader.read(2);
+					}
+					else if (symbol == 17) {
+						repeat = 3 + reader.read(3);
+					}
+					else {
+						repeat = 11 + reader.read(7);
+					}
+
+					if (index + repeat > literalCount + distanceCount) {
+						return false;
+					}
+					while (repeat--) {
+						codeLengths[index++] = value;
+					}
+				}
+
+				if (!lengths.build(codeLengths, literalCount)
+					|| !distances.build(codeLengths + literalCount, distanceCount)
+				) {
+					return false;
+				}
+			}
+			else {
+				return false;
+			}
+
+			if (!inflateBlock(reader, lengths, distances, output, outputStart)) {
+				LOG_ERR("Corrupted deflate stream");
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+} // namespace Engine
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Наибольшая степень сжатия deflate (258 байт из одного кода длины и расстояния).
+	///
+	/// Распакованные данные не могут быть больше сжатых в это кол-во раз.
+	static constexpr size_t MaxDeflateRatio = 1032;
+
+	/// @internal
+	/// @brief Распаковывает поток zlib (RFC 1950/1951).
+	///
+	/// @param pData Сжатые данные (с zlib заголовком).
+	/// @param size Размер сжатых данных в байтах.
+	/// @param [out] output Распакованные данные (дописываются в конец).
+	/// @param sizeHint Ожидаемый размер распакованных данных (0 - неизвестен).
+	/// Резервируется не больше, чем могут дать `size` байт сжатых данных.
+	/// @return true, если поток корректен.
+	bool inflateZlib(const uint8_t* pData, size_t size, std::vector<uint8_t>& output, size_t sizeHint = 0);
+
+} // namespace Engine
@@ -0,0 +1,577 @@
+#include "EngineCore/Image/ImageDecoders.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	bool isJpeg(const uint8_t* pData, size_t size) noexcept {
+		return size >= 3 && pData[0] == 0xFF && pData[1] == 0xD8 && pData[2] == 0xFF;
+	}
+
+	namespace {
+
+		/// Порядок обхода коэффициентов блока 8x8 (зигзаг -> построчный индекс).
+		const uint8_t s_zigzag[64] = {
+			 0,  1,  8, 16,  9,  2,  3, 10,
+			17, 24, 32, 25, 18, 11,  4,  5,
+			12, 19, 26, 33, 40, 48, 41, 34,
+			27, 20, 13,  6,  7, 14, 21, 28,
+			35, 42, 49, 56, 57, 50, 43, 36,
+			29, 22, 15, 23, 30, 37, 44, 51,
+			58, 59, 52, 45, 38, 31, 39, 46,
+			53, 60, 61, 54, 47, 55, 62, 63
+		};
+
+		/// @internal
+		/// @brief Таблица Хаффмана JPEG с быстрым поиском по первым 9 битам.
+		struct JpegHuffman {
+			static constexpr int FastBits = 9;
+
+			uint8_t		fastLength[1 << FastBits]	= {};
+			uint8_t		fastSymbol[1 << FastBits]	= {};
+			int32_t		maxCode[18]					= {};
+			int32_t		valueOffset[17]				= {};
+			uint8_t		symbols[256]				= {};
+			bool		bDefined					= false;
+
+			bool build(const uint8_t* pCounts, const uint8_t* pSymbols, uint32_t symbolCount) {
+				std::memcpy(symbols, pSymbols, symbolCount);
+				std::memset(fastLength, 0, sizeof(fastLength));
+
+				int32_t code = 0;
+				uint32_t index = 0;
+				for (int len = 1; len <= 16; ++len) {
+					// Кодов длины len не может быть больше, чем свободных значений len бит.
+					if (code + pCounts[len - 1] > (1 << len)) {
+						return false;
+					}
+					valueOffset[len] = static_cast<int32_t>(index) - code;
+					for (uint32_t i = 0; i < pCounts[len - 1]; ++i, ++index, ++code) {
+						if (len <= FastBits) {
+							const int shift = FastBits - len;
+							for (int fill = 0; fill < (1 << shift); ++fill) {
+								fastLength[(code << shift) | fill] = static_cast<uint8_t>(len);
+								fastSymbol[(code << shift) | fill] = symbols[index];
+							}
+						}
+					}
+					// Коды длины len лежат в [code - count, code); maxCode хранит верхнюю границу.
+					maxCode[len] = code;
+					code <<= 1;
+				}
+				maxCode[17] = INT32_MAX;
+				bDefined = true;
+				return true;
+			}
+		};
+
+		/// @internal
+		/// @brief Чтение энтропийно-кодированных данных с учётом байтов-заполнителей 0xFF00.
+		class JpegBitReader {
+		public:
+			JpegBitReader(const uint8_t* pData, size_t size, size_t offset)
+				: m_pData(pData), m_size(size), m_pos(offset) {}
+
+			void fill() {
+				while (m_count <= 24) {
+					uint32_t byte = 0;
+					if (!m_bMarker && m_pos < m_size) {
+						byte = m_pData[m_pos++];
+						if (byte == 0xFF) {
+							const uint8_t next = m_pos < m_size ? m_pData[m_pos] : 0;
+							if (next == 0x00) {
+								++m_pos;
+							}
+							else {
+								// Маркер: дальше подаются нули, позиция остаётся на 0xFF.
+								m_bMarker = true;
+								--m_pos;
+								byte = 0;
+							}
+						}
+					}
+					m_buffer |= byte << (24 - m_count);
+					m_count += 8;
+				}
+			}
+
+			int decode(const JpegHuffman& table) {
+				fill();
+				const uint32_t look = m_buffer >> (32 - JpegHuffman::FastBits);
+				if (const uint8_t len = table.fastLength[look]) {
+					consume(len);
+					return table.fastSymbol[look];
+				}
+
+				const int32_t bits = static_cast<int32_t>(m_buffer >> 16);
+				for (int len = JpegHuffman::FastBits + 1; len <= 16; ++len) {
+					const int32_t code = bits >> (16 - len);
+					if (code < table.maxCode[len]) {
+						consume(len);
+						return table.symbols[table.valueOffset[len] + code];
+					}
+				}
+				return -1;
+			}
+
+			/// Читает `bits` бит и расширяет их до знакового значения (F.2.2.1).
+			int receiveExtend(int bits) {
+				if (bits == 0) {
+					return 0;
+				}
+				fill();
+				const int value = static_cast<int>(m_buffer >> (32 - bits));
+				consume(bits);
+				return value < (1 << (bits - 1)) ? value - (1 << bits) + 1 : value;
+			}
+
+			/// Пропускает маркер RSTn и сбрасывает состояние после интервала перезапуска.
+			void restart() {
+				m_buffer = 0;
+				m_count = 0;
+				m_bMarker = false;
+				while (m_pos + 1 < m_size && !(m_pData[m_pos] == 0xFF && m_pData[m_pos + 1] >= 0xD0 && m_pData[m_pos + 1] <= 0xD7)) {
+					++m_pos;
+				}
+				m_pos = std::min(m_pos + 2, m_size);
+			}
+
+			/// Позиция первого маркера после данных скана.
+			size_t findNextMarker() const {
+				size_t pos = m_pos;
+				while (pos + 1 < m_size && !(m_pData[pos] == 0xFF && m_pData[pos + 1] != 0x00 && !(m_pData[pos + 1] >= 0xD0 && m_pData[pos + 1] <= 0xD7))) {
+					++pos;
+				}
+				return pos;
+			}
+
+		private:
+			void consume(int bits) {
+				m_buffer <<= bits;
+				m_count -= bits;
+			}
+
+			const uint8_t*	m_pData;
+			size_t			m_size;
+			size_t			m_pos;
+			uint32_t		m_buffer	= 0;
+			int				m_count		= 0;
+			bool			m_bMarker	= false;
+		};
+
+		/// @internal
+		/// @brief Компонент изображения и его плоскость отсчётов.
+		struct JpegComponent {
+			uint8_t					id				= 0;
+			uint8_t					h				= 1;
+			uint8_t					v				= 1;
+			uint8_t					quantTable		= 0;
+			uint8_t					dcTable			= 0;
+			uint8_t					acTable			= 0;
+			int						dcPredictor		= 0;
+			uint32_t				planeWidth		= 0;	///< Ширина плоскости (кратна 8).
+			uint32_t				planeHeight		= 0;
+			uint32_t				width			= 0;	///< Ширина значимой части плоскости.
+			uint32_t				height			= 0;
+			std::vector<uint8_t>	plane;
+		};
+
+		/// @internal
+		/// @brief Таблица косинусов для разделимого обратного DCT.
+		struct IdctTable {
+			float c[8][8];
+
+			IdctTable() {
+				const float pi = 3.14159265358979f;
+				for (int x = 0; x < 8; ++x) {
+					for (int u = 0; u < 8; ++u) {
+						const float cu = u == 0 ? 1.f / std::sqrt(2.f) : 1.f;
+						c[x][u] = 0.5f * cu * std::cos((2.f * x + 1.f) * u * pi / 16.f);
+					}
+				}
+			}
+		};
+
+		/// @internal
+		/// @brief Обратный DCT блока и запись результата в плоскость компонента.
+		void inverseDct(const int32_t* pCoefs, uint8_t* pOut, size_t stride) {
+			static const IdctTable s_table;
+
+			float tmp[64];
+			for (int v = 0; v < 8; ++v) {
+				const int32_t* pRow = pCoefs + v * 8;
+				bool bOnlyDc = true;
+				for (int u = 1; u < 8; ++u) {
+					bOnlyDc &= pRow[u] == 0;
+				}
+				for (int x = 0; x < 8; ++x) {
+					float sum = s_table.c[x][0] * pRow[0];
+					if (!bOnlyDc) {
+						for (int u = 1; u < 8; ++u) {
+							sum += s_table.c[x][u] * pRow[u];
+						}
+					}
+					tmp[v * 8 + x] = sum;
+				}
+			}
+
+			for (int y = 0; y < 8; ++y) {
+				for (int x = 0; x < 8; ++x) {
+					float sum = 0.f;
+					for (int v = 0; v < 8; ++v) {
+						sum += s_table.c[y][v] * tmp[v * 8 + x];
+					}
+					const int value = static_cast<int>(std::lround(sum + 128.f));
+					pOut[y * stride + x] = static_cast<uint8_t>(std::clamp(value, 0, 255));
+				}
+			}
+		}
+
+		uint16_t readBigEndian16(const uint8_t* p) {
+			return static_cast<uint16_t>((p[0] << 8) | p[1]);
+		}
+
+		uint8_t clampToByte(float value) {
+			return static_cast<uint8_t>(std::clamp(static_cast<int>(value + 0.5f), 0, 255));
+		}
+
+	} // namespace
+
+	bool decodeJpeg(const uint8_t* pData, size_t size, Image& image) {
+		if (!isJpeg(pData, size)) {
+			return false;
+		}
+
+		std::array<std::array<uint16_t, 64>, 4> quant{};
+		std::array<JpegHuffman, 4> dcTables;
+		std::array<JpegHuffman, 4> acTables;
+		std::vector<JpegComponent> components;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t restartInterval = 0;
+		uint32_t maxH = 1;
+		uint32_t maxV = 1;
+		bool bFrameRead = false;
+		bool bScanRead = false;
+
+		size_t offset = 2;
+		while (offset + 4 <= size) {
+			if (pData[offset] != 0xFF) {
+				++offset;
+				continue;
+			}
+			const uint8_t marker = pData[offset + 1];
+			if (marker == 0xFF) {
+				++offset;
+				continue;
+			}
+			if (marker == 0xD9) {
+				break;
+			}
+
+			const uint16_t length = readBigEndian16(pData + offset + 2);
+			const uint8_t* pSegment = pData + offset + 4;
+			const size_t segmentEnd = offset + 2 + length;
+			if (length < 2 || segmentEnd > size) {
+				LOG_ERR("JPEG segment is out of bounds");
+				return false;
+			}
+
+			switch (marker) {
+			case 0xDB: {	// DQT
+				const uint8_t* p = pSegment;
+				while (p < pData + segmentEnd) {
+					const uint8_t precision = p[0] >> 4;
+					const uint8_t id = p[0] & 3;
+					++p;
+					if (p + (precision ? 128 : 64) > pData + segmentEnd) {
+						LOG_ERR("Invalid JPEG quantization table");
+						return false;
+					}
+					for (int i = 0; i < 64; ++i) {
+						quant[id][i] = precision ? readBigEndian16(p + i * 2) : p[i];
+					}
+					p += precision ? 128 : 64;
+				}
+				break;
+			}
+			case 0xC4: {	// DHT
+				const uint8_t* p = pSegment;
+				while (p + 17 <= pData + segmentEnd) {
+					const uint8_t tableClass = p[0] >> 4;
+					const uint8_t id = p[0] & 3;
+					uint32_t count = 0;
+					for (int i = 0; i < 16; ++i) {
+						count += p[1 + i];
+					}
+					if (count > 256 || p + 17 + count > pData + segmentEnd) {
+						LOG_ERR("Invalid JPEG Huffman table");
+						return false;
+					}
+					JpegHuffman& table = tableClass == 0 ? dcTables[id] : acTables[id];
+					if (!table.build(p + 1, p + 17, count)) {
+						LOG_ERR("Invalid JPEG Huffman table");
+						return false;
+					}
+					p += 17 + count;
+				}
+				break;
+			}
+			case 0xDD:		// DRI
+				if (length < 4) {
+					LOG_ERR("Invalid JPEG restart interval");
+					return false;
+				}
+				restartInterval = readBigEndian16(pSegment);
+				break;
+			case 0xC0:		// SOF0 baseline
+			case 0xC1: {	// SOF1 extended (Хаффман)
+				if (bFrameRead || length < 8) {
+					LOG_ERR("Invalid JPEG frame header");
+					return false;
+				}
+				if (pSegment[0] != 8) {
+					LOG_ERR("Unsupported JPEG precision {0}", pSegment[0]);
+					return false;
+				}
+				height = readBigEndian16(pSegment + 1);
+				width = readBigEndian16(pSegment + 3);
+				const uint8_t count = pSegment[5];
+				if (count != 1 && count != 3) {
+					LOG_ERR("Unsupported JPEG component count {0}", count);
+					return false;
+				}
+				if (length < 8 + 3 * count) {
+					LOG_ERR("Invalid JPEG frame header");
+					return false;
+				}
+				if (width == 0 || height == 0 || static_cast<uint64_t>(width) * height > MaxDecodedPixels) {
+					LOG_ERR("Invalid JPEG size {0}x{1}", width, height);
+					return false;
+				}
+				// Каждый блок 8x8 яркости занимает хотя бы 2 бита (коды DC и конца блока).
+				if (static_cast<uint64_t>(width) * height / 256 > size) {
+					LOG_ERR("JPEG data is too short for {0}x{1}", width, height);
+					return false;
+				}
+
+				components.resize(count);
+				for (uint8_t i = 0; i < count; ++i) {
+					const uint8_t* p = pSegment + 6 + i * 3;
+					components[i].id = p[0];
+					components[i].h = std::max<uint8_t>(1, p[1] >> 4);
+					components[i].v = std::max<uint8_t>(1, p[1] & 15);
+					components[i].quantTable = p[2] & 3;
+					maxH = std::max<uint32_t>(maxH, components[i].h);
+					maxV = std::max<uint32_t>(maxV, components[i].v);
+				}
+
+				const uint32_t mcusX = (width + 8 * maxH - 1) / (8 * maxH);
+				const uint32_t mcusY = (height + 8 * maxV - 1) / (8 * maxV);
+				for (JpegComponent& component : components) {
+					component.planeWidth = mcusX * component.h * 8;
+					component.planeHeight = mcusY * component.v * 8;
+					component.width = (width * component.h + maxH - 1) / maxH;
+					component.height = (height * component.v + maxV - 1) / maxV;
+					component.plane.assign(static_cast<size_t>(component.planeWidth) * component.planeHeight, 0);
+				}
+				bFrameRead = true;
+				break;
+			}
+			case 0xC2:
+			case 0xC3:
+			case 0xC5: case 0xC6: case 0xC7:
+			case 0xC9: case 0xCA: case 0xCB:
+			case 0xCD: case 0xCE: case 0xCF:
+				LOG_ERR("Unsupported JPEG coding (SOF{0}), only baseline is supported", marker - 0xC0);
+				return false;
+			case 0xDA: {	// SOS
+				if (!bFrameRead) {
+					LOG_ERR("JPEG scan before frame header");
+					return false;
+				}
+
+				if (length < 3 || length < 6 + 2 * pSegment[0]) {
+					LOG_ERR("Invalid JPEG scan header");
+					return false;
+				}
+				const uint8_t count = pSegment[0];
+				std::vector<JpegComponent*> scanComponents;
+				for (uint8_t i = 0; i < count; ++i) {
+					const uint8_t id = pSegment[1 + i * 2];
+					const uint8_t tables = pSegment[2 + i * 2];
+					for (JpegComponent& component : components) {
+						if (component.id == id) {
+							component.dcTable = (tables >> 4) & 3;
+							component.acTable = tables & 3;
+							component.dcPredictor = 0;
+							scanComponents.push_back(&component);
+						}
+					}
+				}
+				if (scanComponents.empty()) {
+					LOG_ERR("JPEG scan has no known components");
+					return false;
+				}
+				for (const JpegComponent* pComponent : scanComponents) {
+					if (!dcTables[pComponent->dcTable].bDefined || !acTables[pComponent->acTable].bDefined) {
+						LOG_ERR("JPEG scan references undefined Huffman table");
+						return false;
+					}
+				}
+
+				// Скан с одним компонентом не чередуется: MCU - один блок этого компонента.
+				const bool bInterleaved = scanComponents.size() > 1;
+				uint32_t mcusX, mcusY;
+				if (bInterleaved) {
+					mcusX = (width + 8 * maxH - 1) / (8 * maxH);
+					mcusY = (height + 8 * maxV - 1) / (8 * maxV);
+				}
+				else {
+					mcusX = (scanComponents[0]->width + 7) / 8;
+					mcusY = (scanComponents[0]->height + 7) / 8;
+				}
+
+				JpegBitReader reader(pData, size, segmentEnd);
+				int32_t coefs[64];
+				uint32_t mcusLeft = restartInterval;
+
+				auto decodeBlock = [&](JpegComponent& component, uint32_t blockX, uint32_t blockY) -> bool {
+					std::memset(coefs, 0, sizeof(coefs));
+					const uint16_t* pQuant = quant[component.quantTable].data();
+
+					const int dcBits = reader.decode(dcTables[component.dcTable]);
+					if (dcBits < 0 || dcBits > 16) {
+						return false;
+					}
+					component.dcPredictor += reader.receiveExtend(dcBits);
+					// Корректный DC укладывается в 16 бит; без проверки сумма разностей переполнила бы int.
+					if (component.dcPredictor < INT16_MIN || component.dcPredictor > INT16_MAX) {
+						return false;
+					}
+					coefs[0] = component.dcPredictor * pQuant[0];
+
+					const JpegHuffman& ac = acTables[component.acTable];
+					for (int k = 1; k < 64;) {
+						const int rs = reader.decode(ac);
+						if (rs < 0) {
+							return false;
+						}
+						const int run = rs >> 4;
+						const int bits = rs & 15;
+						if (bits == 0) {
+							if (run != 15) {
+								break;
+							}
+							k += 16;
+							continue;
+						}
+						k += run;
+						if (k > 63) {
+							return false;
+						}
+						coefs[s_zigzag[k]] = reader.receiveExtend(bits) * pQuant[k];
+						++k;
+					}
+
+					uint8_t* pOut = component.plane.data() + (static_cast<size_t>(blockY) * 8 * component.planeWidth + blockX * 8);
+					inverseDct(coefs, pOut, component.planeWidth);
+					return true;
+				};
+
+				for (uint32_t mcuY = 0; mcuY < mcusY; ++mcuY) {
+					for (uint32_t mcuX = 0; mcuX < mcusX; ++mcuX) {
+						if (restartInterval) {
+							if (mcusLeft == 0) {
+								reader.restart();
+								for (JpegComponent* pComponent : scanComponents) {
+									pComponent->dcPredictor = 0;
+								}
+								mcusLeft = restartInterval;
+							}
+							--mcusLeft;
+						}
+
+						bool bOk = true;
+						if (bInterleaved) {
+							for (JpegComponent* pComponent : scanComponents) {
+								for (uint32_t by = 0; by < pComponent->v && bOk; ++by) {
+									for (uint32_t bx = 0; bx < pComponent->h && bOk; ++bx) {
+										bOk = decodeBlock(*pComponent, mcuX * pComponent->h + bx, mcuY * pComponent->v + by);
+									}
+								}
+							}
+						}
+						else {
+							bOk = decodeBlock(*scanComponents[0], mcuX, mcuY);
+						}
+
+						if (!bOk) {
+							LOG_ERR("Corrupted JPEG entropy data");
+							return false;
+						}
+					}
+				}
+
+				bScanRead = true;
+				offset = reader.findNextMarker();
+				continue;
+			}
+			default:
+				break;
+			}
+
+			offset = segmentEnd;
+		}
+
+		if (!bScanRead) {
+			LOG_ERR("JPEG has no image data");
+			return false;
+		}
+
+		ImageLevel level;
+		level.width = width;
+		level.height = height;
+		const uint32_t channels = components.size() == 3 ? 3 : 1;
+		level.pixels.resize(static_cast<size_t>(width) * height * channels);
+
+		if (channels == 1) {
+			const JpegComponent& y = components[0];
+			for (uint32_t row = 0; row < height; ++row) {
+				std::memcpy(level.pixels.data() + static_cast<size_t>(row) * width, y.plane.data() + static_cast<size_t>(row) * y.planeWidth, width);
+			}
+		}
+		else {
+			// Субдискретизированные плоскости растягиваются повторением отсчётов.
+			const JpegComponent& cy = components[0];
+			const JpegComponent& cb = components[1];
+			const JpegComponent& cr = components[2];
+			uint8_t* pOut = level.pixels.data();
+			for (uint32_t row = 0; row < height; ++row) {
+				const uint8_t* pY = cy.plane.data() + static_cast<size_t>(row * cy.v / maxV) * cy.planeWidth;
+				const uint8_t* pCb = cb.plane.data() + static_cast<size_t>(row * cb.v / maxV) * cb.planeWidth;
+				const uint8_t* pCr = cr.plane.data() + static_cast<size_t>(row * cr.v / maxV) * cr.planeWidth;
+				for (uint32_t col = 0; col < width; ++col) {
+					const float luma = pY[col * cy.h / maxH];
+					const float blue = pCb[col * cb.h / maxH] - 128.f;
+					const float red = pCr[col * cr.h / maxH] - 128.f;
+					*pOut++ = clampToByte(luma + 1.402f * red);
+					*pOut++ = clampToByte(luma - 0.344136f * blue - 0.714136f * red);
+					*pOut++ = clampToByte(luma + 1.772f * blue);
+				}
+			}
+		}
+
+		image.levels.clear();
+		image.levels.push_back(std::move(level));
+		image.channels = static_cast<uint8_t>(channels);
+		image.pixelType = PixelType::UNorm8;
+		return true;
+	}
+
+} // namespace Engine
@@ -0,0 +1,344 @@
+#include "EngineCore/Image/Ktx2.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "EngineCore/Core/Hash.hpp"
+#include "EngineCore/Image/BlockCompression.hpp"
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	static const uint8_t s_ktx2Identifier[12] = {
+		0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+	};
+
+	/// @internal
+	/// @brief Соответствие значения VkFormat описанию изображения.
+	struct Ktx2Format {
+		uint32_t			vkFormat;
+		CompressedFormat	compression;
+		ColorSpace			colorSpace;
+		PixelType			pixelType;
+		uint8_t				channels;
+		uint8_t				dfdColorModel;	///< khr_df_model_e.
+	};
+
+	static const Ktx2Format s_formats[] = {
+		{   9, CompressedFormat::None,		ColorSpace::Linear,	PixelType::UNorm8,	1, 1 },		// R8_UNORM
+		{  15, CompressedFormat::None,		ColorSpace::SRGB,	PixelType::UNorm8,	1, 1 },		// R8_SRGB
+		{  16, CompressedFormat::None,		ColorSpace::Linear,	PixelType::UNorm8,	2, 1 },		// R8G8_UNORM
+		{  37, CompressedFormat::None,		ColorSpace::Linear,	PixelType::UNorm8,	4, 1 },		// R8G8B8A8_UNORM
+		{  43, CompressedFormat::None,		ColorSpace::SRGB,	PixelType::UNorm8,	4, 1 },		// R8G8B8A8_SRGB
+		{ 106, CompressedFormat::None,		ColorSpace::Linear,	PixelType::Float32,	3, 1 },		// R32G32B32_SFLOAT
+		{ 109, CompressedFormat::None,		ColorSpace::Linear,	PixelType::Float32,	4, 1 },		// R32G32B32A32_SFLOAT
+		{ 131, CompressedFormat::BC1,		ColorSpace::Linear,	PixelType::UNorm8,	3, 128 },	// BC1_RGB_UNORM
+		{ 132, CompressedFormat::BC1,		ColorSpace::SRGB,	PixelType::UNorm8,	3, 128 },	// BC1_RGB_SRGB
+		{ 137, CompressedFormat::BC3,		ColorSpace::Linear,	PixelType::UNorm8,	4, 130 },	// BC3_UNORM
+		{ 138, CompressedFormat::BC3,		ColorSpace::SRGB,	PixelType::UNorm8,	4, 130 },	// BC3_SRGB
+		{ 139, CompressedFormat::BC4,		ColorSpace::Linear,	PixelType::UNorm8,	1, 131 },	// BC4_UNORM
+		{ 141, CompressedFormat::BC5,		ColorSpace::Linear,	PixelType::UNorm8,	2, 132 },	// BC5_UNORM
+		{ 145, CompressedFormat::BC7,		ColorSpace::Linear,	PixelType::UNorm8,	4, 134 },	// BC7_UNORM
+		{ 146, CompressedFormat::BC7,		ColorSpace::SRGB,	PixelType::UNorm8,	4, 134 },	// BC7_SRGB
+		{ 157, CompressedFormat::ASTC_4x4,	ColorSpace::Linear,	PixelType::UNorm8,	4, 162 },	// ASTC_4x4_UNORM
+		{ 158, CompressedFormat::ASTC_4x4,	ColorSpace::SRGB,	PixelType::UNorm8,	4, 162 },	// ASTC_4x4_SRGB
+		{ 165, CompressedFormat::ASTC_6x6,	ColorSpace::Linear,	PixelType::UNorm8,	4, 162 },	// ASTC_6x6_UNORM
+		{ 166, CompressedFormat::ASTC_6x6,	ColorSpace::SRGB,	PixelType::UNorm8,	4, 162 },	// ASTC_6x6_SRGB
+		{ 171, CompressedFormat::ASTC_8x8,	ColorSpace::Linear,	PixelType::UNorm8,	4, 162 },	// ASTC_8x8_UNORM
+		{ 172, CompressedFormat::ASTC_8x8,	ColorSpace::SRGB,	PixelType::UNorm8,	4, 162 },	// ASTC_8x8_SRGB
+	};
+
+	/// @internal
+	/// @brief Размер заголовка KTX2 вместе с индексом (до массива уровней).
+	static constexpr size_t HeaderSize = 80;
+	static constexpr size_t LevelIndexEntrySize = 24;
+
+	static uint32_t readLE32(const uint8_t* p) {
+		uint32_t value;
+		std::memcpy(&value, p, 4);
+		return value;
+	}
+
+	static uint64_t readLE64(const uint8_t* p) {
+		uint64_t value;
+		std::memcpy(&value, p, 8);
+		return value;
+	}
+
+	static void writeLE32(std::vector<uint8_t>& out, uint32_t value) {
+		const uint8_t bytes[4] = {
+			static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+			static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)
+		};
+		out.insert(out.end(), bytes, bytes + 4);
+	}
+
+	static void writeLE64(std::vector<uint8_t>& out, uint64_t value) {
+		writeLE32(out, static_cast<uint32_t>(value));
+		writeLE32(out, static_cast<uint32_t>(value >> 32));
+	}
+
+	/// @internal
+	/// @brief Размер текселя (или блока) формата в байтах.
+	static size_t getTexelBlockBytes(const Ktx2Format& format) {
+		if (format.compression != CompressedFormat::None) {
+			return getBlockInfo(format.compression).bytes;
+		}
+		return format.channels * (format.pixelType == PixelType::Float32 ? 4 : 1);
+	}
+
+	static size_t getLevelSize(const Ktx2Format& format, uint32_t width, uint32_t height) {
+		if (format.compression != CompressedFormat::None) {
+			return getCompressedLevelSize(format.compression, width, height);
+		}
+		return static_cast<size_t>(width) * height * getTexelBlockBytes(format);
+	}
+
+	bool isKtx2(const uint8_t* pData, size_t size) noexcept {
+		return size >= sizeof(s_ktx2Identifier) && std::memcmp(pData, s_ktx2Identifier, sizeof(s_ktx2Identifier)) == 0;
+	}
+
+	bool readKtx2(const uint8_t* pData, size_t size, Image& image) {
+		if (!isKtx2(pData, size) || size < HeaderSize) {
+			LOG_ERR("Not a KTX2 file");
+			return false;
+		}
+
+		const uint32_t vkFormat		= readLE32(pData + 12);
+		const uint32_t width		= readLE32(pData + 20);
+		const uint32_t height		= readLE32(pData + 24);
+		const uint32_t depth		= readLE32(pData + 28);
+		const uint32_t layerCount	= readLE32(pData + 32);
+		const uint32_t faceCount	= readLE32(pData + 36);
+		const uint32_t levelCount	= std::max<uint32_t>(readLE32(pData + 40), 1);
+		const uint32_t scheme		= readLE32(pData + 44);
+
+		if (scheme != 0) {
+			LOG_ERR("KTX2 supercompression scheme {0} is not supported", scheme);
+			return false;
+		}
+		if (depth > 0 || layerCount > 1 || faceCount != 1 || width == 0 || height == 0) {
+			LOG_ERR("Only 2D KTX2 textures are supported");
+			return false;
+		}
+		if (levelCount > 32 || HeaderSize + levelCount * LevelIndexEntrySize > size) {
+			LOG_ERR("Corrupted KTX2 level index");
+			return false;
+		}
+
+		const Ktx2Format* pFormat = nullptr;
+		for (const Ktx2Format& format : s_formats) {
+			if (format.vkFormat == vkFormat) {
+				pFormat = &format;
+				break;
+			}
+		}
+		if (!pFormat) {
+			LOG_ERR("KTX2 format {0} is not supported", vkFormat);
+			return false;
+		}
+
+		image.levels.resize(levelCount);
+		image.channels = pFormat->channels;
+		image.pixelType = pFormat->pixelType;
+		image.compression = pFormat->compression;
+		image.colorSpace = pFormat->colorSpace;
+
+		for (uint32_t level = 0; level < levelCount; ++level) {
+			const uint8_t* pEntry = pData + HeaderSize + level * LevelIndexEntrySize;
+			const uint64_t offset = readLE64(pEntry);
+			const uint64_t length = readLE64(pEntry + 8);
+
+			ImageLevel& imageLevel = image.levels[level];
+			imageLevel.width = std::max<uint32_t>(width >> level, 1);
+			imageLevel.height = std::max<uint32_t>(height >> level, 1);
+
+			if (offset > size || length > size - offset || length < getLevelSize(*pFormat, imageLevel.width, imageLevel.height)) {
+				LOG_ERR("Corrupted KTX2 level {0}", level);
+				return false;
+			}
+			imageLevel.pExternal = pData + offset;
+			imageLevel.externalSize = static_cast<size_t>(length);
+		}
+
+		return true;
+	}
+
+	/// @internal
+	/// @brief Формирует Data Format Descriptor (базовый блок Khronos Data Format).
+	static std::vector<uint8_t> buildDfd(const Ktx2Format& format) {
+		struct Sample {
+			uint32_t	bitOffset;
+			uint32_t	bitLength;
+			uint32_t	channelType;	///< Идентификатор канала и флаги (F, S, E, L).
+			uint32_t	lower;
+			uint32_t	upper;
+		};
+
+		std::vector<Sample> samples;
+		const BlockInfo block = getBlockInfo(format.compression);
+		const bool bSRGB = format.colorSpace == ColorSpace::SRGB;
+
+		if (format.compression == CompressedFormat::None) {
+			const bool bFloat = format.pixelType == PixelType::Float32;
+			const uint32_t bits = bFloat ? 32 : 8;
+			static const uint32_t s_channelIds[4] = { 0, 1, 2, 15 };
+			for (uint32_t c = 0; c < format.channels; ++c) {
+				uint32_t channelType = s_channelIds[c];
+				if (bFloat) {
+					channelType |= 0x80 | 0x40;
+				}
+				else if (bSRGB && channelType == 15) {
+					channelType |= 0x10;	// Альфа в sRGB текстурах линейна.
+				}
+				samples.push_back({
+					c * bits, bits, channelType,
+					bFloat ? 0xBF800000u : 0u,
+					bFloat ? 0x3F800000u : 255u
+				});
+			}
+		}
+		else if (format.compression == CompressedFormat::BC3) {
+			samples.push_back({ 0, 64, 15, 0, UINT32_MAX });
+			samples.push_back({ 64, 64, 0, 0, UINT32_MAX });
+		}
+		else if (format.compression == CompressedFormat::BC5) {
+			samples.push_back({ 0, 64, 0, 0, UINT32_MAX });
+			samples.push_back({ 64, 64, 1, 0, UINT32_MAX });
+		}
+		else {
+			samples.push_back({ 0, block.bytes * 8u, 0, 0, UINT32_MAX });
+		}
+
+		const uint32_t blockSize = 24 + 16 * static_cast<uint32_t>(samples.size());
+		const uint32_t texelBytes = static_cast<uint32_t>(getTexelBlockBytes(format));
+
+		std::vector<uint8_t> dfd;
+		writeLE32(dfd, 4 + blockSize);								// dfdTotalSize
+		writeLE32(dfd, 0);											// vendorId = Khronos, descriptorType = basic
+		writeLE32(dfd, 2 | (blockSize << 16));						// versionNumber, descriptorBlockSize
+		writeLE32(dfd, format.dfdColorModel | (1u << 8) | ((bSRGB ? 2u : 1u) << 16));	// model, BT.709, transfer
+		writeLE32(dfd, (block.width - 1u) | ((block.height - 1u) << 8));				// texelBlockDimension
+		writeLE32(dfd, texelBytes);									// bytesPlane0..3
+		writeLE32(dfd, 0);											// bytesPlane4..7
+		for (const Sample& sample : samples) {
+			writeLE32(dfd, sample.bitOffset | ((sample.bitLength - 1) << 16) | (sample.channelType << 24));
+			writeLE32(dfd, 0);
+			writeLE32(dfd, sample.lower);
+			writeLE32(dfd, sample.upper);
+		}
+		return dfd;
+	}
+
+	bool writeKtx2(const std::string& path, const Image& image) {
+		const ColorSpace colorSpace = image.colorSpace == ColorSpace::SRGB ? ColorSpace::SRGB : ColorSpace::Linear;
+
+		const Ktx2Format* pFormat = nullptr;
+		for (const Ktx2Format& format : s_formats) {
+			if (format.compression == image.compression && format.colorSpace == colorSpace
+				&& format.pixelType == image.pixelType && format.channels == image.channels) {
+				pFormat = &format;
+				break;
+			}
+		}
+		if (!pFormat || !image.isValid()) {
+			LOG_ERR("Image format can not be stored in KTX2 ({0}, {1} channels)", getCompressedFormatName(image.compression), image.channels);
+			return false;
+		}
+
+		const uint32_t levelCount = static_cast<uint32_t>(image.levels.size());
+		const std::vector<uint8_t> dfd = buildDfd(*pFormat);
+		const size_t dfdOffset = HeaderSize + levelCount * LevelIndexEntrySize;
+
+		// Уровни выравниваются на НОК(размер текселя, 4) и хранятся от меньшего к большему.
+		const size_t alignment = std::lcm<size_t>(getTexelBlockBytes(*pFormat), 4);
+		std::vector<uint64_t> offsets(levelCount);
+		size_t offset = dfdOffset + dfd.size();
+		for (uint32_t level = levelCount; level-- > 0;) {
+			offset = (offset + alignment - 1) / alignment * alignment;
+			offsets[level] = offset;
+			offset += image.levels[level].getSize();
+		}
+
+		std::vector<uint8_t> header;
+		header.reserve(dfdOffset + dfd.size());
+		header.insert(header.end(), s_ktx2Identifier, s_ktx2Identifier + sizeof(s_ktx2Identifier));
+		writeLE32(header, pFormat->vkFormat);
+		writeLE32(header, pFormat->compression == CompressedFormat::None && pFormat->pixelType == PixelType::Float32 ? 4 : 1);
+		writeLE32(header, image.getWidth());
+		writeLE32(header, image.getHeight());
+		writeLE32(header, 0);				// pixelDepth
+		writeLE32(header, 0);				// layerCount
+		writeLE32(header, 1);				// faceCount
+		writeLE32(header, levelCount);
+		writeLE32(header, 0);				// supercompressionScheme
+		writeLE32(header, static_cast<uint32_t>(dfdOffset));
+		writeLE32(header, static_cast<uint32_t>(dfd.size()));
+		writeLE32(header, 0);				// kvdByteOffset
+		writeLE32(header, 0);				// kvdByteLength
+		writeLE64(header, 0);				// sgdByteOffset
+		writeLE64(header, 0);				// sgdByteLength
+		for (uint32_t level = 0; level < levelCount; ++level) {
+			const uint64_t length = image.levels[level].getSize();
+			writeLE64(header, offsets[level]);
+			writeLE64(header, length);
+			writeLE64(header, length);
+		}
+		header.insert(header.end(), dfd.begin(), dfd.end());
+
+		// Один и тот же файл могут писать параллельно несколько потоков и процессов,
+		// поэтому имя временного файла смешивает поток, счётчик вызовов и время.
+		static std::atomic<uint32_t> s_tempCounter{ 0 };
+		const uint64_t sources[] = {
+			std::hash<std::thread::id>()(std::this_thread::get_id()),
+			s_tempCounter.fetch_add(1, std::memory_order_relaxed),
+			static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())
+		};
+		char suffix[32];
+		std::snprintf(suffix, sizeof(suffix), ".%016llx.tmp", static_cast<unsigned long long>(hash64(sources, sizeof(sources))));
+		const std::string tempPath = path + suffix;
+		std::error_code error;
+		{
+			std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+			if (!file) {
+				LOG_ERR("Can not create {0}", tempPath);
+				return false;
+			}
+
+			file.write(reinterpret_cast<const char*>(header.data()), header.size());
+			size_t position = header.size();
+			static const char s_padding[16] = {};
+			for (uint32_t level = levelCount; level-- > 0;) {
+				file.write(s_padding, offsets[level] - position);
+				const ImageLevel& imageLevel = image.levels[level];
+				file.write(reinterpret_cast<const char*>(imageLevel.getData()), imageLevel.getSize());
+				position = offsets[level] + imageLevel.getSize();
+			}
+
+			if (!file) {
+				LOG_ERR("Can not write {0}", tempPath);
+				file.close();
+				std::filesystem::remove(tempPath, error);
+				return false;
+			}
+		}
+
+		std::filesystem::rename(tempPath, path, error);
+		if (error) {
+			LOG_ERR("Can not rename {0} to {1}: {2}", tempPath, path, error.message());
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+		return true;
+	}
+
+} // namespace Engine
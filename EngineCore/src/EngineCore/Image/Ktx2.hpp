@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "EngineCore/Image/Image.hpp"
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Проверяет сигнатуру контейнера KTX2.
+	bool isKtx2(const uint8_t* pData, size_t size) noexcept;
+
+	/// @internal
+	/// @brief Разбирает 2D текстуру в контейнере KTX2 без суперсжатия.
+	///
+	/// Данные не копируются: уровни изображения ссылаются на `pData`
+	/// (`ImageLevel::pExternal`), поэтому память должна жить дольше `image`.
+	///
+	/// Поддерживаются форматы R8, RG8, RGBA8 (UNORM/SRGB), RGB/RGBA float,
+	/// BC1, BC3, BC4, BC5, BC7 и ASTC 4x4/6x6/8x8.
+	///
+	/// @return false, если файл повреждён или формат не поддерживается.
+	bool readKtx2(const uint8_t* pData, size_t size, Image& image);
+
+	/// @internal
+	/// @brief Записывает изображение со всеми mip-уровнями в файл KTX2.
+	///
+	/// Файл сначала пишется во временный и затем переименовывается, поэтому
+	/// параллельные читатели никогда не видят его частично записанным.
+	bool writeKtx2(const std::string& path, const Image& image);
+
+} // namespace Engine
@@ -0,0 +1,336 @@
+#include "EngineCore/Image/ImageDecoders.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+#include "EngineCore/Core/Hash.hpp"
+#include "EngineCore/Image/Inflate.hpp"
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	static const uint8_t s_pngSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+	bool isPng(const uint8_t* pData, size_t size) noexcept {
+		return size >= 8 && std::memcmp(pData, s_pngSignature, 8) == 0;
+	}
+
+	static uint32_t readBigEndian32(const uint8_t* p) {
+		return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16)
+			| (static_cast<uint32_t>(p[2]) << 8) | p[3];
+	}
+
+	/// @internal
+	/// @brief Предсказатель Paeth из спецификации PNG.
+	static uint8_t paeth(int a, int b, int c) {
+		const int p = a + b - c;
+		const int pa = std::abs(p - a);
+		const int pb = std::abs(p - b);
+		const int pc = std::abs(p - c);
+		if (pa <= pb && pa <= pc) {
+			return static_cast<uint8_t>(a);
+		}
+		return static_cast<uint8_t>(pb <= pc ? b : c);
+	}
+
+	/// @internal
+	/// @brief Снимает фильтры строк одного (под)изображения.
+	/// @param pData Отфильтрованные строки (байт фильтра + данные строки).
+	/// @param [out] pOut Строки без фильтров.
+	/// @return false при неизвестном типе фильтра.
+	static bool unfilter(const uint8_t* pData, uint8_t* pOut, size_t rowBytes, uint32_t rows, uint32_t pixelBytes) {
+		const uint8_t* pPrev = nullptr;
+		for (uint32_t y = 0; y < rows; ++y) {
+			const uint8_t filter = *pData++;
+			uint8_t* pRow = pOut + y * rowBytes;
+
+			for (size_t x = 0; x < rowBytes; ++x) {
+				const int a = x >= pixelBytes ? pRow[x - pixelBytes] : 0;
+				const int b = pPrev ? pPrev[x] : 0;
+				const int c = pPrev && x >= pixelBytes ? pPrev[x - pixelBytes] : 0;
+				const uint8_t raw = pData[x];
+
+				switch (filter) {
+				case 0:	pRow[x] = raw; break;
+				case 1:	pRow[x] = static_cast<uint8_t>(raw + a); break;
+				case 2:	pRow[x] = static_cast<uint8_t>(raw + b); break;
+				case 3:	pRow[x] = static_cast<uint8_t>(raw + ((a + b) >> 1)); break;
+				case 4:	pRow[x] = static_cast<uint8_t>(raw + paeth(a, b, c)); break;
+				default:
+					return false;
+				}
+			}
+
+			pData += rowBytes;
+			pPrev = pRow;
+		}
+		return true;
+	}
+
+	/// @internal
+	/// @brief Параметры PNG, нужные для распаковки строк.
+	struct PngHeader {
+		uint32_t	width;
+		uint32_t	height;
+		uint8_t		bitDepth;
+		uint8_t		colorType;
+		uint8_t		interlace;
+		uint32_t	samples;		///< Кол-во компонентов в файле.
+		bool		bColorKey;		///< tRNS серого или RGB изображения: пиксели цвета `colorKey` прозрачны.
+		uint16_t	colorKey[3];	///< Значения компонентов в глубине файла.
+	};
+
+	/// @internal
+	/// @brief Переводит строки с произвольной глубиной в 8-битные компоненты.
+	///
+	/// Палитровые изображения раскрываются в RGB(A), 16-битные компоненты
+	/// округляются до старшего байта, глубина 1-4 бита масштабируется до 0-255.
+	/// С цветовым ключом (tRNS) к серому и RGB добавляется альфа: 0 у пикселей,
+	/// совпадающих с ключом в исходной глубине, иначе 255.
+	static void convertRows(
+		const PngHeader&	header,
+		const uint8_t*		pRows,
+		size_t				rowBytes,
+		uint32_t			width,
+		uint32_t			height,
+		const uint8_t*		pPalette,
+		uint32_t			paletteSize,
+		uint32_t			outChannels,
+		uint8_t*			pOut,
+		size_t				outStride,
+		uint32_t			xStart,
+		uint32_t			xStep,
+		uint32_t			yStart,
+		uint32_t			yStep
+	) {
+		const uint32_t depth = header.bitDepth;
+		const uint32_t maxValue = (1u << depth) - 1;
+
+		for (uint32_t y = 0; y < height; ++y) {
+			const uint8_t* pRow = pRows + y * rowBytes;
+			uint8_t* pDst = pOut + (yStart + y * yStep) * outStride;
+
+			for (uint32_t x = 0; x < width; ++x) {
+				uint8_t* pPixel = pDst + (xStart + x * xStep) * outChannels;
+				bool bKeyed = header.bColorKey;
+
+				for (uint32_t s = 0; s < header.samples; ++s) {
+					const size_t sampleIndex = static_cast<size_t>(x) * header.samples + s;
+					uint32_t value;
+					if (depth == 8) {
+						value = pRow[sampleIndex];
+					}
+					else if (depth == 16) {
+						bKeyed = bKeyed && ((pRow[sampleIndex * 2] << 8) | pRow[sampleIndex * 2 + 1]) == header.colorKey[s];
+						value = pRow[sampleIndex * 2];
+					}
+					else {
+						const size_t bit = sampleIndex * depth;
+						value = (pRow[bit >> 3] >> (8 - depth - (bit & 7))) & maxValue;
+						if (header.colorType != 3) {
+							bKeyed = bKeyed && value == header.colorKey[s];
+							value = value * 255 / maxValue;
+						}
+					}
+					if (depth == 8) {
+						bKeyed = bKeyed && value == header.colorKey[s];
+					}
+
+					if (header.colorType == 3) {
+						const uint32_t index = value < paletteSize ? value : 0;
+						for (uint32_t c = 0; c < outChannels; ++c) {
+							pPixel[c] = pPalette[index * 4 + c];
+						}
+					}
+					else {
+						pPixel[s] = static_cast<uint8_t>(value);
+					}
+				}
+				if (header.bColorKey) {
+					pPixel[header.samples] = bKeyed ? 0 : 255;
+				}
+			}
+		}
+	}
+
+	bool decodePng(const uint8_t* pData, size_t size, Image& image) {
+		if (!isPng(pData, size)) {
+			return false;
+		}
+
+		PngHeader header{};
+		std::vector<uint8_t> compressed;
+		// Индексы за пределами палитры дают чёрный цвет, а не содержимое стека.
+		uint8_t palette[256 * 4] = {};
+		uint32_t paletteSize = 0;
+		bool bHasTransparency = false;
+
+		for (uint32_t i = 0; i < 256; ++i) {
+			palette[i * 4 + 3] = 255;
+		}
+
+		size_t offset = 8;
+		bool bEnd = false;
+		while (!bEnd && offset + 12 <= size) {
+			const uint32_t length = readBigEndian32(pData + offset);
+			const uint8_t* pType = pData + offset + 4;
+			const uint8_t* pChunk = pData + offset + 8;
+			if (length > size - offset - 12) {
+				LOG_ERR("PNG chunk is out of bounds");
+				return false;
+			}
+			// CRC покрывает тип и данные чанка.
+			if (crc32(pType, static_cast<size_t>(length) + 4) != readBigEndian32(pChunk + length)) {
+				LOG_ERR("PNG chunk {0} has a wrong CRC", std::string_view(reinterpret_cast<const char*>(pType), 4));
+				return false;
+			}
+
+			if (std::memcmp(pType, "IHDR", 4) == 0 && length >= 13) {
+				header.width		= readBigEndian32(pChunk);
+				header.height		= readBigEndian32(pChunk + 4);
+				header.bitDepth		= pChunk[8];
+				header.colorType	= pChunk[9];
+				header.interlace	= pChunk[12];
+			}
+			else if (std::memcmp(pType, "PLTE", 4) == 0) {
+				paletteSize = std::min<uint32_t>(length / 3, 256);
+				for (uint32_t i = 0; i < paletteSize; ++i) {
+					palette[i * 4 + 0] = pChunk[i * 3 + 0];
+					palette[i * 4 + 1] = pChunk[i * 3 + 1];
+					palette[i * 4 + 2] = pChunk[i * 3 + 2];
+				}
+			}
+			else if (std::memcmp(pType, "tRNS", 4) == 0 && header.colorType == 3) {
+				for (uint32_t i = 0; i < std::min<uint32_t>(length, 256); ++i) {
+					palette[i * 4 + 3] = pChunk[i];
+				}
+				bHasTransparency = true;
+			}
+			else if (std::memcmp(pType, "tRNS", 4) == 0 && (header.colorType == 0 || header.colorType == 2)) {
+				// Ключ - 16-битные значения компонентов (серый или R, G, B).
+				const uint32_t keySamples = header.colorType == 0 ? 1 : 3;
+				if (length >= keySamples * 2) {
+					for (uint32_t i = 0; i < keySamples; ++i) {
+						header.colorKey[i] = static_cast<uint16_t>((pChunk[i * 2] << 8) | pChunk[i * 2 + 1]);
+					}
+					header.bColorKey = true;
+				}
+			}
+			else if (std::memcmp(pType, "IDAT", 4) == 0) {
+				compressed.insert(compressed.end(), pChunk, pChunk + length);
+			}
+			else if (std::memcmp(pType, "IEND", 4) == 0) {
+				bEnd = true;
+			}
+
+			offset += 12 + length;
+		}
+
+		switch (header.colorType) {
+		case 0:	header.samples = 1; break;
+		case 2:	header.samples = 3; break;
+		case 3:	header.samples = 1; break;
+		case 4:	header.samples = 2; break;
+		case 6:	header.samples = 4; break;
+		default:
+			LOG_ERR("Unsupported PNG color type {0}", header.colorType);
+			return false;
+		}
+
+		const uint8_t depth = header.bitDepth;
+		const bool bDepthValid = header.colorType == 0 ? (depth == 1 || depth == 2 || depth == 4 || depth == 8 || depth == 16)
+			: header.colorType == 3 ? (depth == 1 || depth == 2 || depth == 4 || depth == 8)
+			: (depth == 8 || depth == 16);
+		if (!bDepthValid) {
+			LOG_ERR("Unsupported PNG bit depth {0} for color type {1}", depth, header.colorType);
+			return false;
+		}
+
+		if (header.interlace > 1) {
+			LOG_ERR("Unsupported PNG interlace method {0}", header.interlace);
+			return false;
+		}
+		if (header.colorType == 3 && paletteSize == 0) {
+			LOG_ERR("PNG palette image has no PLTE chunk");
+			return false;
+		}
+
+		if (header.width == 0 || header.height == 0 || static_cast<uint64_t>(header.width) * header.height > MaxDecodedPixels) {
+			LOG_ERR("Invalid PNG size {0}x{1}", header.width, header.height);
+			return false;
+		}
+
+		const uint32_t bitsPerPixel = header.samples * header.bitDepth;
+		const uint32_t pixelBytes = (bitsPerPixel + 7) / 8;
+		const uint32_t outChannels = header.colorType == 3 ? (bHasTransparency ? 4 : 3)
+			: header.samples + (header.bColorKey ? 1 : 0);
+
+		std::vector<uint8_t> filtered;
+		const size_t expectedSize = (static_cast<size_t>(header.width) * bitsPerPixel / 8 + 2) * header.height;
+		if (expectedSize / MaxDeflateRatio > compressed.size()) {
+			LOG_ERR("PNG data is too short for {0}x{1}", header.width, header.height);
+			return false;
+		}
+		if (!inflateZlib(compressed.data(), compressed.size(), filtered, expectedSize)) {
+			LOG_ERR("PNG data decompression failed");
+			return false;
+		}
+
+		ImageLevel level;
+		level.width = header.width;
+		level.height = header.height;
+		level.pixels.resize(static_cast<size_t>(header.width) * header.height * outChannels);
+		const size_t outStride = static_cast<size_t>(header.width) * outChannels;
+
+		// Проходы Adam7: начало и шаг по X и Y. Без чередования - один проход на всё изображение.
+		static const uint32_t adam7[7][4] = {
+			{ 0, 8, 0, 8 }, { 4, 8, 0, 8 }, { 0, 4, 4, 8 }, { 2, 4, 0, 4 },
+			{ 0, 2, 2, 4 }, { 1, 2, 0, 2 }, { 0, 1, 1, 2 }
+		};
+		static const uint32_t noInterlace[1][4] = { { 0, 1, 0, 1 } };
+
+		const uint32_t (*passes)[4] = header.interlace ? adam7 : noInterlace;
+		const uint32_t passCount = header.interlace ? 7 : 1;
+
+		size_t consumed = 0;
+		std::vector<uint8_t> rows;
+		for (uint32_t pass = 0; pass < passCount; ++pass) {
+			const uint32_t xStart = passes[pass][0], xStep = passes[pass][1];
+			const uint32_t yStart = passes[pass][2], yStep = passes[pass][3];
+
+			if (xStart >= header.width || yStart >= header.height) {
+				continue;
+			}
+			const uint32_t passWidth = (header.width - xStart + xStep - 1) / xStep;
+			const uint32_t passHeight = (header.height - yStart + yStep - 1) / yStep;
+			const size_t rowBytes = (static_cast<size_t>(passWidth) * bitsPerPixel + 7) / 8;
+			const size_t passBytes = (rowBytes + 1) * passHeight;
+
+			if (consumed + passBytes > filtered.size()) {
+				LOG_ERR("PNG image data is truncated");
+				return false;
+			}
+
+			rows.resize(rowBytes * passHeight);
+			if (!unfilter(filtered.data() + consumed, rows.data(), rowBytes, passHeight, pixelBytes)) {
+				LOG_ERR("Unknown PNG filter");
+				return false;
+			}
+			consumed += passBytes;
+
+			convertRows(
+				header, rows.data(), rowBytes, passWidth, passHeight, palette, paletteSize,
+				outChannels, level.pixels.data(), outStride, xStart, xStep, yStart, yStep
+			);
+		}
+
+		image.levels.clear();
+		image.levels.push_back(std::move(level));
+		image.channels = static_cast<uint8_t>(outChannels);
+		image.pixelType = PixelType::UNorm8;
+		return true;
+	}
+
+} // namespace Engine
@@ -0,0 +1,39 @@
+#include "EngineCore/Image/Tga.hpp"
+
+#include <cstdio>
+
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	bool writeTga(const char* pPath, const uint32_t width, const uint32_t height, const uint8_t* pPixels, const bool bBottomUp) {
+		if (width == 0 || height == 0 || width > 0xFFFF || height > 0xFFFF) {
+			LOG_ERR("Can not write {0}: unsupported size {1}x{2}", pPath, width, height);
+			return false;
+		}
+
+		uint8_t header[18] = {};
+		header[2] = 2;									// Несжатое true-color изображение.
+		header[12] = static_cast<uint8_t>(width & 0xFF);
+		header[13] = static_cast<uint8_t>(width >> 8);
+		header[14] = static_cast<uint8_t>(height & 0xFF);
+		header[15] = static_cast<uint8_t>(height >> 8);
+		header[16] = 32;
+		header[17] = static_cast<uint8_t>(8 | (bBottomUp ? 0 : 0x20));	// 8 бит альфы, начало строк.
+
+		std::FILE* pFile = std::fopen(pPath, "wb");
+		if (!pFile) {
+			LOG_ERR("Can not create {0}", pPath);
+			return false;
+		}
+		const size_t pixelBytes = static_cast<size_t>(width) * height * 4;
+		const bool bWritten = std::fwrite(header, 1, sizeof(header), pFile) == sizeof(header)
+			&& std::fwrite(pPixels, 1, pixelBytes, pFile) == pixelBytes;
+		if (std::fclose(pFile) != 0 || !bWritten) {
+			LOG_ERR("Can not write {0}", pPath);
+			return false;
+		}
+		return true;
+	}
+
+} // namespace Engine
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Записывает несжатый 32-битный TGA.
+	///
+	/// Формат выбран потому, что хранит пиксели в порядке BGRA и строки снизу
+	/// вверх - так же, как их отдаёт `glReadPixels(GL_BGRA)`, поэтому кадр
+	/// записывается без преобразований. Запись через `std::FILE` не выделяет
+	/// память через `operator new` (захват в файл идёт каждый кадр).
+	///
+	/// @param pPath Путь к файлу.
+	/// @param width Ширина (не больше 65535).
+	/// @param height Высота (не больше 65535).
+	/// @param pPixels Пиксели BGRA8 без выравнивания строк.
+	/// @param bBottomUp Первая строка - нижняя.
+	/// @return true, если файл записан.
+	bool writeTga(const char* pPath, uint32_t width, uint32_t height, const uint8_t* pPixels, bool bBottomUp = true);
+
+} // namespace Engine
@@ -0,0 +1,123 @@
+#include "EngineCore/Layer.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace Engine {
+
+	using Clock = std::chrono::steady_clock;
+
+	static float getMs(const Clock::time_point start) noexcept {
+		return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	}
+
+	LayerStack::~LayerStack() {
+		detach();
+	}
+
+	Layer* LayerStack::pushLayer(std::unique_ptr<Layer> pLayer) {
+		Layer* pRaw = pLayer.get();
+		m_layers.insert(m_layers.begin() + static_cast<std::ptrdiff_t>(m_overlayStart), std::move(pLayer));
+		m_timings.insert(m_timings.begin() + static_cast<std::ptrdiff_t>(m_overlayStart), { pRaw, 0.f, 0.f, false });
+		++m_overlayStart;
+		if (m_bAttached) {
+			pRaw->onAttach();
+		}
+		return pRaw;
+	}
+
+	Layer* LayerStack::pushOverlay(std::unique_ptr<Layer> pLayer) {
+		Layer* pRaw = pLayer.get();
+		m_layers.push_back(std::move(pLayer));
+		m_timings.push_back({ pRaw, 0.f, 0.f, true });
+		if (m_bAttached) {
+			pRaw->onAttach();
+		}
+		return pRaw;
+	}
+
+	std::unique_ptr<Layer> LayerStack::popLayer(Layer* pLayer) {
+		const auto it = std::find_if(m_layers.begin(), m_layers.end(), [pLayer](const std::unique_ptr<Layer>& pItem) {
+			return pItem.get() == pLayer;
+		});
+		if (it == m_layers.end()) {
+			return nullptr;
+		}
+
+		const size_t index = static_cast<size_t>(it - m_layers.begin());
+		std::unique_ptr<Layer> pResult = std::move(*it);
+		m_layers.erase(it);
+		m_timings.erase(m_timings.begin() + static_cast<std::ptrdiff_t>(index));
+		if (index < m_overlayStart) {
+			--m_overlayStart;
+		}
+		if (m_bAttached) {
+			pResult->onDetach();
+		}
+		return pResult;
+	}
+
+	void LayerStack::attach() {
+		if (m_bAttached) {
+			return;
+		}
+		m_bAttached = true;
+		for (const std::unique_ptr<Layer>& pLayer : m_layers) {
+			pLayer->onAttach();
+		}
+	}
+
+	void LayerStack::detach() {
+		if (!m_bAttached) {
+			return;
+		}
+		m_bAttached = false;
+		for (auto it = m_layers.rbegin(); it != m_layers.rend(); ++it) {
+			(*it)->onDetach();
+		}
+	}
+
+	void LayerStack::update(const float deltaTime) {
+		for (size_t i = 0; i < m_layers.size(); ++i) {
+			Layer& layer = *m_layers[i];
+			if (!layer.isEnabled()) {
+				m_timings[i].updateMs = 0.f;
+				continue;
+			}
+			const Clock::time_point start = Clock::now();
+			layer.onUpdate(deltaTime);
+			m_timings[i].updateMs = getMs(start);
+		}
+	}
+
+	void LayerStack::render() {
+		for (size_t i = 0; i < m_layers.size(); ++i) {
+			Layer& layer = *m_layers[i];
+			if (!layer.isEnabled()) {
+				m_timings[i].renderMs = 0.f;
+				continue;
+			}
+			const Clock::time_point start = Clock::now();
+			layer.onRender();
+			m_timings[i].renderMs = getMs(start);
+		}
+	}
+
+	bool LayerStack::dispatch(Event& event) {
+		for (auto it = m_layers.rbegin(); it != m_layers.rend(); ++it) {
+			if ((*it)->isEnabled() && (*it)->onEvent(event)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void LayerStack::drawImGui() {
+		for (const std::unique_ptr<Layer>& pLayer : m_layers) {
+			if (pLayer->isEnabled()) {
+				pLayer->onImGuiRender();
+			}
+		}
+	}
+
+} // namespace Engine
@@ -0,0 +1,334 @@
+#include "EngineCore/Memory/AllocationTracker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#include <imgui/imgui.h>
+
+#include "EngineCore/Log.hpp"
+#include "EngineCore/Memory/LinearArena.hpp"
+#include "EngineCore/Memory/PoolAllocator.hpp"
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+	#define ENGINE_RETURN_ADDRESS() _ReturnAddress()
+	#define ENGINE_NOINLINE __declspec(noinline)
+#else
+	#define ENGINE_RETURN_ADDRESS() __builtin_return_address(0)
+	#define ENGINE_NOINLINE __attribute__((noinline))
+#endif
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Кол-во кадров прогрева, в течение которых выделения разрешены.
+	constexpr uint64_t AllocationWarmupFrames = 120;
+
+	/// @internal
+	/// @brief Размер таблицы мест вызова (степень двойки).
+	constexpr size_t CallSiteTableSize = 4096;
+
+	/// @internal
+	/// @brief Глобальные счётчики. Доступны из `operator new`, поэтому сами не выделяют память.
+	struct AllocationCounters {
+		std::atomic<uint64_t>	allocationCount	{ 0 };
+		std::atomic<uint64_t>	freeCount		{ 0 };
+		std::atomic<uint64_t>	allocatedBytes	{ 0 };
+		std::atomic<uint64_t>	liveBytes		{ 0 };
+		std::atomic<uint64_t>	peakLiveBytes	{ 0 };
+	};
+
+	/// @internal
+	/// @brief Запись таблицы мест вызова (открытая адресация, без блокировок).
+	struct CallSiteEntry {
+		std::atomic<const void*>	address		{ nullptr };
+		std::atomic<uint64_t>		count		{ 0 };
+		std::atomic<uint64_t>		bytes		{ 0 };
+	};
+
+	static AllocationCounters		s_counters;
+	static CallSiteEntry			s_callSites[CallSiteTableSize];
+	static FrameAllocationStats		s_lastFrame;
+	static FrameAllocationStats		s_frameStart;
+	static uint64_t					s_frameIndex		= 0;
+
+	static std::mutex							s_registryMutex;
+	static std::vector<const LinearArena*>		s_arenas;
+	static std::vector<const PoolAllocator*>	s_pools;
+
+#ifdef ENGINE_TRACK_ALLOCATIONS
+
+	/// @internal
+	/// @brief Учитывает выделение `size` байт из места `pCallSite`.
+	static void recordAllocation(size_t size, const void* pCallSite) noexcept {
+		s_counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+		s_counters.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+		const uint64_t live = s_counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+		uint64_t peak = s_counters.peakLiveBytes.load(std::memory_order_relaxed);
+		while (live > peak && !s_counters.peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+		if (!pCallSite) {
+			return;
+		}
+
+		size_t slot = (reinterpret_cast<uintptr_t>(pCallSite) >> 4) & (CallSiteTableSize - 1);
+		for (size_t probe = 0; probe < CallSiteTableSize; ++probe, slot = (slot + 1) & (CallSiteTableSize - 1)) {
+			CallSiteEntry& entry = s_callSites[slot];
+
+			const void* pExpected = nullptr;
+			if (entry.address.load(std::memory_order_relaxed) == pCallSite
+				|| entry.address.compare_exchange_strong(pExpected, pCallSite, std::memory_order_relaxed)
+				|| pExpected == pCallSite
+			) {
+				entry.count.fetch_add(1, std::memory_order_relaxed);
+				entry.bytes.fetch_add(size, std::memory_order_relaxed);
+				return;
+			}
+		}
+	}
+
+	static void recordFree(size_t size) noexcept {
+		s_counters.freeCount.fetch_add(1, std::memory_order_relaxed);
+		s_counters.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+	}
+
+	/// @internal
+	/// @brief Заголовок, хранящийся перед каждым отслеживаемым блоком.
+	struct AllocationHeader {
+		void*	pRaw;
+		size_t	size;
+	};
+
+	/// @internal
+	/// @brief Выделяет блок с заголовком, позволяющим узнать размер при освобождении.
+	static void* trackedAllocate(size_t size, size_t alignment, const void* pCallSite) noexcept {
+		alignment = std::max(alignment, alignof(std::max_align_t));
+
+		void* pRaw = std::malloc(size + alignment + sizeof(AllocationHeader));
+		if (!pRaw) {
+			return nullptr;
+		}
+
+		const uintptr_t user = (reinterpret_cast<uintptr_t>(pRaw) + sizeof(AllocationHeader) + alignment - 1)
+			& ~(static_cast<uintptr_t>(alignment) - 1);
+
+		AllocationHeader* pHeader = reinterpret_cast<AllocationHeader*>(user) - 1;
+		pHeader->pRaw = pRaw;
+		pHeader->size = size;
+
+		recordAllocation(size, pCallSite);
+		return reinterpret_cast<void*>(user);
+	}
+
+	static void trackedFree(void* pMemory) noexcept {
+		if (!pMemory) {
+			return;
+		}
+
+		AllocationHeader* pHeader = static_cast<AllocationHeader*>(pMemory) - 1;
+		recordFree(pHeader->size);
+		std::free(pHeader->pRaw);
+	}
+
+#endif
+
+	void AllocationTracker::newFrame() {
+		FrameAllocationStats current;
+		current.frameIndex		= s_frameIndex;
+		current.allocationCount	= s_counters.allocationCount.load(std::memory_order_relaxed);
+		current.freeCount		= s_counters.freeCount.load(std::memory_order_relaxed);
+		current.allocatedBytes	= s_counters.allocatedBytes.load(std::memory_order_relaxed);
+		current.liveBytes		= s_counters.liveBytes.load(std::memory_order_relaxed);
+		current.peakLiveBytes	= s_counters.peakLiveBytes.load(std::memory_order_relaxed);
+
+		s_lastFrame.frameIndex		= s_frameIndex;
+		s_lastFrame.allocationCount	= current.allocationCount - s_frameStart.allocationCount;
+		s_lastFrame.freeCount		= current.freeCount - s_frameStart.freeCount;
+		s_lastFrame.allocatedBytes	= current.allocatedBytes - s_frameStart.allocatedBytes;
+		s_lastFrame.liveBytes		= current.liveBytes;
+		s_lastFrame.peakLiveBytes	= current.peakLiveBytes;
+
+		s_frameStart = current;
+
+#ifdef ENGINE_ASSERT_NO_FRAME_ALLOCATIONS
+		if (s_frameIndex > AllocationWarmupFrames && s_lastFrame.allocationCount > 0) {
+			// Не LOG_CRIT и assert: оба исчезают с NDEBUG, а проверка нужна и в Release.
+			std::fprintf(
+				stderr,
+				"Frame %llu made %llu heap allocations (%llu bytes) in steady state\n",
+				static_cast<unsigned long long>(s_lastFrame.frameIndex),
+				static_cast<unsigned long long>(s_lastFrame.allocationCount),
+				static_cast<unsigned long long>(s_lastFrame.allocatedBytes)
+			);
+			for (const AllocationCallSite& site : getTopCallSites(8)) {
+				std::fprintf(stderr, "  call site %p: %llu allocations, %llu bytes\n", site.address,
+					static_cast<unsigned long long>(site.count), static_cast<unsigned long long>(site.bytes));
+			}
+			std::abort();
+		}
+
+		// Места вызова собираются по одному кадру, чтобы отчёт показывал именно виновников.
+		if (s_frameIndex >= AllocationWarmupFrames) {
+			resetCallSites();
+		}
+#endif
+
+		++s_frameIndex;
+	}
+
+	const FrameAllocationStats& AllocationTracker::getLastFrameStats() noexcept {
+		return s_lastFrame;
+	}
+
+	std::vector<AllocationCallSite> AllocationTracker::getTopCallSites(size_t maxCount) {
+		std::vector<AllocationCallSite> sites;
+		for (const CallSiteEntry& entry : s_callSites) {
+			const void* pAddress = entry.address.load(std::memory_order_relaxed);
+			const uint64_t count = entry.count.load(std::memory_order_relaxed);
+			if (pAddress && count > 0) {
+				sites.push_back({ pAddress, count, entry.bytes.load(std::memory_order_relaxed) });
+			}
+		}
+
+		std::sort(sites.begin(), sites.end(), [](const AllocationCallSite& a, const AllocationCallSite& b) {
+			return a.count > b.count;
+		});
+		if (sites.size() > maxCount) {
+			sites.resize(maxCount);
+		}
+		return sites;
+	}
+
+	void AllocationTracker::resetCallSites() {
+		for (CallSiteEntry& entry : s_callSites) {
+			entry.count.store(0, std::memory_order_relaxed);
+			entry.bytes.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	void AllocationTracker::registerArena(const LinearArena* pArena) {
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+		s_arenas.push_back(pArena);
+	}
+
+	void AllocationTracker::unregisterArena(const LinearArena* pArena) {
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+		s_arenas.erase(std::remove(s_arenas.begin(), s_arenas.end(), pArena), s_arenas.end());
+	}
+
+	void AllocationTracker::registerPool(const PoolAllocator* pPool) {
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+		s_pools.push_back(pPool);
+	}
+
+	void AllocationTracker::unregisterPool(const PoolAllocator* pPool) {
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+		s_pools.erase(std::remove(s_pools.begin(), s_pools.end(), pPool), s_pools.end());
+	}
+
+	void AllocationTracker::installImGuiAllocator() {
+#ifdef ENGINE_TRACK_ALLOCATIONS
+		ImGui::SetAllocatorFunctions(
+			[](size_t size, void*) { return trackedAllocate(size, alignof(std::max_align_t), nullptr); },
+			[](void* pMemory, void*) { trackedFree(pMemory); }
+		);
+#endif
+	}
+
+	void AllocationTracker::drawImGuiPanel() {
+		ImGui::Begin("Память");
+
+		if (isEnabled()) {
+			const FrameAllocationStats& stats = s_lastFrame;
+			ImGui::Text("Выделений за кадр: %llu (%llu байт)",
+				static_cast<unsigned long long>(stats.allocationCount),
+				static_cast<unsigned long long>(stats.allocatedBytes));
+			ImGui::Text("Освобождений за кадр: %llu", static_cast<unsigned long long>(stats.freeCount));
+			ImGui::Text("Занято в куче: %.2f МБ (пик %.2f МБ)",
+				stats.liveBytes / (1024.0 * 1024.0),
+				stats.peakLiveBytes / (1024.0 * 1024.0));
+		}
+		else {
+			ImGui::TextUnformatted("Учёт кучи выключен (ENGINE_TRACK_ALLOCATIONS)");
+		}
+
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+
+		ImGui::Separator();
+		for (const LinearArena* pArena : s_arenas) {
+			ImGui::Text("%s: %zu / %zu байт (пик %zu), %u выделений",
+				pArena->getName(), pArena->getUsed(), pArena->getCapacity(),
+				pArena->getPeak(), pArena->getAllocationCount());
+		}
+		for (const PoolAllocator* pPool : s_pools) {
+			ImGui::Text("%s: %zu / %zu блоков по %zu байт (пик %zu)",
+				pPool->getName(), pPool->getUsedBlocks(), pPool->getCapacityBlocks(),
+				pPool->getBlockSize(), pPool->getPeakBlocks());
+		}
+
+		ImGui::End();
+	}
+
+} // namespace Engine
+
+#ifdef ENGINE_TRACK_ALLOCATIONS
+
+// Замена глобальных операторов выделения памяти. Адрес возврата указывает на место вызова `new`.
+
+ENGINE_NOINLINE void* operator new(size_t size) {
+	void* pMemory = Engine::trackedAllocate(size, alignof(std::max_align_t), ENGINE_RETURN_ADDRESS());
+	if (!pMemory) {
+		throw std::bad_alloc();
+	}
+	return pMemory;
+}
+
+ENGINE_NOINLINE void* operator new[](size_t size) {
+	void* pMemory = Engine::trackedAllocate(size, alignof(std::max_align_t), ENGINE_RETURN_ADDRESS());
+	if (!pMemory) {
+		throw std::bad_alloc();
+	}
+	return pMemory;
+}
+
+ENGINE_NOINLINE void* operator new(size_t size, std::align_val_t alignment) {
+	void* pMemory = Engine::trackedAllocate(size, static_cast<size_t>(alignment), ENGINE_RETURN_ADDRESS());
+	if (!pMemory) {
+		throw std::bad_alloc();
+	}
+	return pMemory;
+}
+
+ENGINE_NOINLINE void* operator new[](size_t size, std::align_val_t alignment) {
+	void* pMemory = Engine::trackedAllocate(size, static_cast<size_t>(alignment), ENGINE_RETURN_ADDRESS());
+	if (!pMemory) {
+		throw std::bad_alloc();
+	}
+	return pMemory;
+}
+
+ENGINE_NOINLINE void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	return Engine::trackedAllocate(size, alignof(std::max_align_t), ENGINE_RETURN_ADDRESS());
+}
+
+ENGINE_NOINLINE void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+	return Engine::trackedAllocate(size, alignof(std::max_align_t), ENGINE_RETURN_ADDRESS());
+}
+
+void operator delete(void* pMemory) noexcept { Engine::trackedFree(pMemory); }
+void operator delete[](void* pMemory) noexcept { Engine::trackedFree(pMemory); }
+void operator delete(void* pMemory, size_t) noexcept { Engine::trackedFree(pMemory); }
+void operator delete[](void* pMemory, size_t) noexcept { Engine::trackedFree(pMemory); }
+void operator delete(void* pMemory, std::align_val_t) noexcept { Engine::trackedFree(pMemory); }
+void operator delete[](void* pMemory, std::align_val_t) noexcept { Engine::trackedFree(pMemory); }
+void operator delete(void* pMemory, size_t, std::align_val_t) noexcept { Engine::trackedFree(pMemory); }
+void operator delete[](void* pMemory, size_t, std::align_val_t) noexcept { Engine::trackedFree(pMemory); }
+void operator delete(void* pMemory, const std::nothrow_t&) noexcept { Engine::trackedFree(pMemory); }
+void operator delete[](void* pMemory, const std::nothrow_t&) noexcept { Engine::trackedFree(pMemory); }
+
+#endif
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+
+	class LinearArena;
+	class PoolAllocator;
+
+	/**
+	 * @internal
+	 * @brief Статистика обращений к куче за один кадр.
+	 */
+	struct FrameAllocationStats {
+		uint64_t	frameIndex			= 0;	///< Номер кадра.
+		uint64_t	allocationCount		= 0;	///< Кол-во выделений за кадр.
+		uint64_t	freeCount			= 0;	///< Кол-во освобождений за кадр.
+		uint64_t	allocatedBytes		= 0;	///< Байт выделено за кадр.
+		uint64_t	liveBytes			= 0;	///< Байт занято в куче на конец кадра.
+		uint64_t	peakLiveBytes		= 0;	///< Пиковый объём занятой памяти за всё время.
+	};
+
+	/**
+	 * @internal
+	 * @brief Место вызова, из которого выделялась память.
+	 */
+	struct AllocationCallSite {
+		const void*	address		= nullptr;	///< Адрес возврата из `operator new`.
+		uint64_t	count		= 0;		///< Кол-во выделений.
+		uint64_t	bytes		= 0;		///< Суммарный объём выделений в байтах.
+	};
+
+	/**
+	 * @internal
+	 * @brief Учёт выделений памяти движком.
+	 *
+	 * При включённой опции сборки `ENGINE_TRACK_ALLOCATIONS` глобальные
+	 * `operator new`/`operator delete` (и аллокатор ImGui) подсчитывают
+	 * выделения, объёмы и места вызова. Без опции все методы возвращают нули,
+	 * а накладных расходов нет.
+	 *
+	 * Опция `ENGINE_ASSERT_NO_FRAME_ALLOCATIONS` дополнительно проверяет, что
+	 * после прогрева основной цикл кадра не обращается к куче: при нарушении
+	 * места вызова печатаются в stderr и процесс завершается (в любой сборке).
+	 */
+	class AllocationTracker {
+	public:
+		/// @internal
+		/// @brief Завершает статистику прошлого кадра и начинает новый кадр.
+		///
+		/// Вызывается в начале `Window::update()`.
+		static void newFrame();
+
+		/// @internal
+		/// @brief Возвращает статистику последнего завершённого кадра.
+		static const FrameAllocationStats& getLastFrameStats() noexcept;
+
+		/// @internal
+		/// @brief Возвращает места вызова с наибольшим кол-вом выделений.
+		/// @param maxCount Максимальное кол-во записей.
+		static std::vector<AllocationCallSite> getTopCallSites(size_t maxCount);
+
+		/// @internal
+		/// @brief Сбрасывает статистику мест вызова.
+		static void resetCallSites();
+
+		/// @internal
+		/// @brief Регистрирует арену для отображения в статистике.
+		static void registerArena(const LinearArena* pArena);
+		static void unregisterArena(const LinearArena* pArena);
+
+		/// @internal
+		/// @brief Регистрирует пул для отображения в статистике.
+		static void registerPool(const PoolAllocator* pPool);
+		static void unregisterPool(const PoolAllocator* pPool);
+
+		/// @internal
+		/// @brief Перенаправляет выделения ImGui через счётчики трекера.
+		///
+		/// Должен вызываться до `ImGui::CreateContext()`.
+		static void installImGuiAllocator();
+
+		/// @internal
+		/// @brief Рисует ImGui окно со статистикой памяти.
+		///
+		/// Должен вызываться между `ImGui::NewFrame()` и `ImGui::Render()`.
+		static void drawImGuiPanel();
+
+		/// @internal
+		/// @brief Возвращает true, если движок собран с `ENGINE_TRACK_ALLOCATIONS`.
+		static constexpr bool isEnabled() noexcept {
+#ifdef ENGINE_TRACK_ALLOCATIONS
+			return true;
+#else
+			return false;
+#endif
+		}
+	};
+
+} // namespace Engine
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "EngineCore/Memory/LinearArena.hpp"
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Двойной буфер линейных арен для временных данных кадра.
+	 *
+	 * Каждый кадр `beginFrame()` переключается на другую арену и сбрасывает её.
+	 * Память, выделенная на кадре N, остаётся действительной в течение кадра N + 1,
+	 * поэтому её может безопасно читать поток рендеринга, отстающий на один кадр.
+	 *
+	 * Пример использования
+	 * @code
+	 * float* pVertices = frameAllocator.allocateArray<float>(vertexCount * 3);
+	 * // ... заполнение и загрузка в буфер, освобождать не нужно.
+	 * @endcode
+	 */
+	class FrameAllocator {
+	public:
+		/// @internal
+		/// @brief Создаёт аллокатор.
+		/// @param capacityPerFrame Начальный размер каждой из двух арен в байтах.
+		explicit FrameAllocator(size_t capacityPerFrame = 4 * 1024 * 1024)
+			: m_arenas{ {
+				LinearArenaSlot(capacityPerFrame, "Frame arena 0"),
+				LinearArenaSlot(capacityPerFrame, "Frame arena 1")
+			} }
+		{}
+
+		/// @internal
+		/// @brief Переключается на арену следующего кадра и сбрасывает её.
+		void beginFrame() {
+			m_current ^= 1;
+			m_arenas[m_current].arena.reset();
+		}
+
+		void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+			return m_arenas[m_current].arena.allocate(size, alignment);
+		}
+
+		template<typename T>
+		T* allocateArray(size_t count) { return m_arenas[m_current].arena.allocateArray<T>(count); }
+
+		template<typename T, typename... Args>
+		T* create(Args&&... args) { return m_arenas[m_current].arena.create<T>(std::forward<Args>(args)...); }
+
+		/// @internal
+		/// @brief Арена текущего кадра.
+		const LinearArena& getCurrent() const noexcept { return m_arenas[m_current].arena; }
+
+		/// @internal
+		/// @brief Арена предыдущего кадра (читается потоком рендеринга).
+		const LinearArena& getPrevious() const noexcept { return m_arenas[m_current ^ 1].arena; }
+
+	private:
+		/// Обёртка, позволяющая хранить некопируемые арены в `std::array`.
+		struct LinearArenaSlot {
+			LinearArenaSlot(size_t capacity, const char* name) : arena(capacity, name) {}
+			LinearArena arena;
+		};
+
+		std::array<LinearArenaSlot, 2>	m_arenas;
+		uint32_t						m_current	= 0;
+	};
+
+} // namespace Engine
@@ -0,0 +1,91 @@
+#include "EngineCore/Memory/LinearArena.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include "EngineCore/Log.hpp"
+#include "EngineCore/Memory/AllocationTracker.hpp"
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Выравнивает `value` вверх до кратного `alignment` (степень двойки).
+	constexpr uintptr_t alignUp(uintptr_t value, size_t alignment) {
+		return (value + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+	}
+
+	LinearArena::LinearArena(size_t capacity, const char* name)
+		: m_capacity(capacity)
+		, m_name(name)
+	{
+		m_pBlock = static_cast<std::byte*>(std::malloc(m_capacity));
+		if (!m_pBlock) {
+			LOG_ERR("Arena '{0}' can not allocate {1} bytes", m_name, m_capacity);
+			throw std::bad_alloc();
+		}
+		AllocationTracker::registerArena(this);
+	}
+
+	LinearArena::~LinearArena() {
+		AllocationTracker::unregisterArena(this);
+		// Не `reset()`: рост основного блока перед освобождением не нужен.
+		for (std::byte* pBlock : m_overflowBlocks) {
+			std::free(pBlock);
+		}
+		std::free(m_pBlock);
+	}
+
+	void* LinearArena::allocate(size_t size, size_t alignment) {
+		++m_allocationCount;
+
+		const uintptr_t base = reinterpret_cast<uintptr_t>(m_pBlock);
+		const uintptr_t aligned = alignUp(base + m_used, alignment);
+		if (aligned + size <= base + m_capacity) {
+			m_used = aligned + size - base;
+			m_peak = std::max(m_peak, getUsed());
+			return reinterpret_cast<void*>(aligned);
+		}
+
+		// Блок исчерпан: память берётся из кучи до следующего reset().
+		std::byte* pOverflow = static_cast<std::byte*>(std::malloc(size + alignment));
+		if (!pOverflow) {
+			LOG_ERR("Arena '{0}' can not allocate overflow block of {1} bytes", m_name, size + alignment);
+			throw std::bad_alloc();
+		}
+		m_overflowBlocks.push_back(pOverflow);
+		m_overflowUsed += size + alignment;
+		m_peak = std::max(m_peak, getUsed());
+
+		return reinterpret_cast<void*>(alignUp(reinterpret_cast<uintptr_t>(pOverflow), alignment));
+	}
+
+	void LinearArena::reset() {
+		if (!m_overflowBlocks.empty()) {
+			for (std::byte* pBlock : m_overflowBlocks) {
+				std::free(pBlock);
+			}
+			m_overflowBlocks.clear();
+
+			// Рост основного блока до пика с запасом, чтобы не переполняться снова.
+			// Старый блок освобождается только после выделения нового: при нехватке памяти
+			// арена остаётся рабочей и снова уйдёт в кучу при переполнении.
+			const size_t newCapacity = m_peak + m_peak / 2;
+			std::byte* pNewBlock = static_cast<std::byte*>(std::malloc(newCapacity));
+			if (pNewBlock) {
+				LOG_WARN("Arena '{0}' overflowed, growing {1} -> {2} bytes", m_name, m_capacity, newCapacity);
+				std::free(m_pBlock);
+				m_pBlock = pNewBlock;
+				m_capacity = newCapacity;
+			}
+			else {
+				LOG_ERR("Arena '{0}' overflowed and can not grow to {1} bytes", m_name, newCapacity);
+			}
+		}
+
+		m_used = 0;
+		m_overflowUsed = 0;
+		m_allocationCount = 0;
+	}
+
+} // namespace Engine
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Линейный (bump) аллокатор.
+	 *
+	 * Выделение памяти - сдвиг указателя внутри заранее выделенного блока,
+	 * освобождение отдельных объектов не поддерживается: вся память
+	 * освобождается разом вызовом `reset()`.
+	 *
+	 * Если блока не хватает, арена берёт дополнительный блок из кучи, а при
+	 * следующем `reset()` увеличивает основной блок до пикового размера,
+	 * поэтому в установившемся режиме обращений к куче нет.
+	 *
+	 * @note Не потокобезопасен.
+	 */
+	class LinearArena {
+	public:
+		/// @internal
+		/// @brief Создаёт арену.
+		/// @param capacity Начальный размер блока в байтах.
+		/// @param name Имя арены для статистики.
+		explicit LinearArena(size_t capacity, const char* name = "LinearArena");
+		~LinearArena();
+
+		LinearArena(const LinearArena&)				= delete;
+		LinearArena& operator=(const LinearArena&)	= delete;
+		LinearArena(LinearArena&&)					= delete;
+		LinearArena& operator=(LinearArena&&)		= delete;
+
+		/// @internal
+		/// @brief Выделяет `size` байт с выравниванием `alignment`.
+		/// @return Указатель на память (действителен до `reset()`).
+		/// Если куча не может выделить блок переполнения, бросает `std::bad_alloc`, как `operator new`.
+		void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		/// @internal
+		/// @brief Выделяет неинициализированный массив из `count` элементов `T`.
+		template<typename T>
+		T* allocateArray(size_t count) {
+			static_assert(std::is_trivially_destructible_v<T>, "Arena memory is never destructed");
+			return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		/// @internal
+		/// @brief Создаёт объект `T` в памяти арены.
+		///
+		/// Деструктор объекта не вызывается, поэтому `T` должен быть тривиально разрушаемым.
+		template<typename T, typename... Args>
+		T* create(Args&&... args) {
+			static_assert(std::is_trivially_destructible_v<T>, "Arena memory is never destructed");
+			return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		/// @internal
+		/// @brief Освобождает всю память арены.
+		void reset();
+
+		size_t getUsed() const noexcept { return m_used + m_overflowUsed; }
+		size_t getPeak() const noexcept { return m_peak; }
+		size_t getCapacity() const noexcept { return m_capacity; }
+		const char* getName() const noexcept { return m_name; }
+
+		/// @internal
+		/// @brief Кол-во выделений с последнего `reset()`.
+		uint32_t getAllocationCount() const noexcept { return m_allocationCount; }
+
+	private:
+		std::byte*				m_pBlock			= nullptr;
+		size_t					m_capacity			= 0;
+		size_t					m_used				= 0;
+		size_t					m_overflowUsed		= 0;
+		size_t					m_peak				= 0;
+		uint32_t				m_allocationCount	= 0;
+		const char*				m_name;
+		std::vector<std::byte*>	m_overflowBlocks;
+	};
+
+} // namespace Engine
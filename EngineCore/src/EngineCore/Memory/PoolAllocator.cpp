@@ -0,0 +1,78 @@
+#include "EngineCore/Memory/PoolAllocator.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "EngineCore/Log.hpp"
+#include "EngineCore/Memory/AllocationTracker.hpp"
+
+namespace Engine {
+
+	PoolAllocator::PoolAllocator(
+		size_t		blockSize,
+		size_t		blockAlignment,
+		size_t		blocksPerChunk,
+		const char*	name
+	)
+		: m_blockAlignment(std::max(blockAlignment, alignof(FreeBlock)))
+		, m_blocksPerChunk(std::max<size_t>(blocksPerChunk, 1))
+		, m_name(name)
+	{
+		// Блок должен вмещать указатель списка свободных блоков и сохранять выравнивание.
+		m_blockSize = std::max(blockSize, sizeof(FreeBlock));
+		m_blockSize = (m_blockSize + m_blockAlignment - 1) & ~(m_blockAlignment - 1);
+
+		AllocationTracker::registerPool(this);
+	}
+
+	PoolAllocator::~PoolAllocator() {
+		AllocationTracker::unregisterPool(this);
+
+		if (m_usedBlocks != 0) {
+			LOG_WARN("Pool '{0}' destroyed with {1} blocks still in use", m_name, m_usedBlocks);
+		}
+
+		for (void* pChunk : m_chunks) {
+			::operator delete(pChunk, std::align_val_t(m_blockAlignment));
+		}
+	}
+
+	void* PoolAllocator::allocate() {
+		if (!m_pFreeList) {
+			allocateChunk();
+		}
+
+		FreeBlock* pBlock = m_pFreeList;
+		m_pFreeList = pBlock->pNext;
+
+		++m_usedBlocks;
+		m_peakBlocks = std::max(m_peakBlocks, m_usedBlocks);
+		return pBlock;
+	}
+
+	void PoolAllocator::deallocate(void* pBlock) noexcept {
+		if (!pBlock) {
+			return;
+		}
+
+		FreeBlock* pFree = static_cast<FreeBlock*>(pBlock);
+		pFree->pNext = m_pFreeList;
+		m_pFreeList = pFree;
+		--m_usedBlocks;
+	}
+
+	void PoolAllocator::allocateChunk() {
+		std::byte* pChunk = static_cast<std::byte*>(
+			::operator new(m_blockSize * m_blocksPerChunk, std::align_val_t(m_blockAlignment))
+		);
+		m_chunks.push_back(pChunk);
+
+		// Блоки связываются в порядке адресов, чтобы первые выделения шли подряд.
+		for (size_t i = m_blocksPerChunk; i-- > 0;) {
+			FreeBlock* pBlock = reinterpret_cast<FreeBlock*>(pChunk + i * m_blockSize);
+			pBlock->pNext = m_pFreeList;
+			m_pFreeList = pBlock;
+		}
+	}
+
+} // namespace Engine
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Аллокатор блоков фиксированного размера.
+	 *
+	 * Память выделяется крупными кусками (chunk) по `blocksPerChunk` блоков,
+	 * свободные блоки связаны в список, поэтому `allocate()` и `deallocate()`
+	 * выполняются за O(1) без обращения к куче, пока хватает свободных блоков.
+	 *
+	 * @note Не потокобезопасен.
+	 */
+	class PoolAllocator {
+	public:
+		/// @internal
+		/// @brief Создаёт пул.
+		/// @param blockSize Размер одного блока в байтах.
+		/// @param blockAlignment Выравнивание блока.
+		/// @param blocksPerChunk Кол-во блоков, выделяемых за одно обращение к куче.
+		/// @param name Имя пула для статистики.
+		PoolAllocator(
+			size_t		blockSize,
+			size_t		blockAlignment,
+			size_t		blocksPerChunk = 256,
+			const char*	name = "PoolAllocator"
+		);
+		~PoolAllocator();
+
+		PoolAllocator(const PoolAllocator&)				= delete;
+		PoolAllocator& operator=(const PoolAllocator&)	= delete;
+		PoolAllocator(PoolAllocator&&)					= delete;
+		PoolAllocator& operator=(PoolAllocator&&)		= delete;
+
+		void* allocate();
+		void deallocate(void* pBlock) noexcept;
+
+		size_t getBlockSize() const noexcept { return m_blockSize; }
+		size_t getUsedBlocks() const noexcept { return m_usedBlocks; }
+		size_t getPeakBlocks() const noexcept { return m_peakBlocks; }
+		size_t getCapacityBlocks() const noexcept { return m_chunks.size() * m_blocksPerChunk; }
+		const char* getName() const noexcept { return m_name; }
+
+	private:
+		void allocateChunk();
+
+		struct FreeBlock {
+			FreeBlock* pNext;
+		};
+
+		std::vector<void*>	m_chunks;
+		FreeBlock*			m_pFreeList		= nullptr;
+		size_t				m_blockSize;
+		size_t				m_blockAlignment;
+		size_t				m_blocksPerChunk;
+		size_t				m_usedBlocks	= 0;
+		size_t				m_peakBlocks	= 0;
+		const char*			m_name;
+	};
+
+	/**
+	 * @internal
+	 * @brief Типизированная обёртка над `PoolAllocator` для небольших объектов движка.
+	 *
+	 * Пример использования
+	 * @code
+	 * ObjectPool<Node> pool(1024);
+	 * Node* pNode = pool.create(args...);
+	 * pool.destroy(pNode);
+	 * @endcode
+	 */
+	template<typename T>
+	class ObjectPool {
+	public:
+		explicit ObjectPool(size_t blocksPerChunk = 256, const char* name = "ObjectPool")
+			: m_pool(sizeof(T), alignof(T), blocksPerChunk, name)
+		{}
+
+		template<typename... Args>
+		T* create(Args&&... args) {
+			return new (m_pool.allocate()) T(std::forward<Args>(args)...);
+		}
+
+		void destroy(T* pObject) noexcept {
+			if (pObject) {
+				pObject->~T();
+				m_pool.deallocate(pObject);
+			}
+		}
+
+		const PoolAllocator& getAllocator() const noexcept { return m_pool; }
+
+	private:
+		PoolAllocator m_pool;
+	};
+
+} // namespace Engine
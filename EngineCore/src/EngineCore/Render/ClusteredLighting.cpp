@@ -0,0 +1,103 @@
+#include "EngineCore/Render/ClusteredLighting.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <imgui/imgui.h>
+
+#include "EngineCore/Render/OpenGL/StorageBuffer.hpp"
+
+namespace Engine {
+
+	/// Начальная ёмкость буферов источников и индексов (в элементах).
+	static constexpr size_t InitialCapacity = 256;
+
+	ClusteredLighting::ClusteredLighting(const LightClusterParams& params, JobSystem* pJobSystem)
+		: m_builder(params, pJobSystem)
+	{
+		// До первого `update()` шейдер видит пустые кластеры.
+		const ShaderParams shaderParams = { { params.tilesX, params.tilesY, params.slices, 0 }, { 0.f, 0.f, 0.f, 0.f } };
+		m_pParams = std::make_unique<StorageBuffer>(&shaderParams, sizeof(ShaderParams), StorageBuffer::EUsage::Dynamic);
+		m_pParams->setLabel("Light cluster params");
+
+		const std::vector<LightCluster> emptyClusters(m_builder.getClusterCount());
+		m_pClusters = std::make_unique<StorageBuffer>(emptyClusters.data(), emptyClusters.size() * sizeof(LightCluster), StorageBuffer::EUsage::Dynamic);
+		m_pClusters->setLabel("Light clusters");
+
+		reserve(m_pLights, InitialCapacity * sizeof(PointLight), "Cluster lights");
+		reserve(m_pIndices, InitialCapacity * sizeof(uint32_t), "Cluster light indices");
+	}
+
+	ClusteredLighting::~ClusteredLighting() = default;
+
+	void ClusteredLighting::reserve(std::unique_ptr<StorageBuffer>& pBuffer, const size_t size, const char* label) {
+		if (pBuffer && pBuffer->getSize() >= size) {
+			return;
+		}
+		// Хранилище неизменяемое: буфер пересоздаётся с удвоением, старый удаляется по fence кадра.
+		const size_t capacity = std::max(size, pBuffer ? pBuffer->getSize() * 2 : size);
+		pBuffer = std::make_unique<StorageBuffer>(nullptr, capacity, StorageBuffer::EUsage::Dynamic);
+		pBuffer->setLabel(label);
+	}
+
+	void ClusteredLighting::update(
+		const Mat4& view, const Mat4& projection,
+		const uint32_t viewportWidth, const uint32_t viewportHeight,
+		const PointLight* pLights, const uint32_t lightCount
+	) {
+		m_builder.build(view, projection, pLights, lightCount);
+
+		const auto startTime = std::chrono::steady_clock::now();
+		const LightClusterParams& params = m_builder.getParams();
+		const ShaderParams shaderParams = {
+			{ params.tilesX, params.tilesY, params.slices, lightCount },
+			{
+				static_cast<float>(params.tilesX) / static_cast<float>(std::max(viewportWidth, 1u)),
+				static_cast<float>(params.tilesY) / static_cast<float>(std::max(viewportHeight, 1u)),
+				m_builder.getSliceScale(),
+				m_builder.getSliceBias()
+			}
+		};
+		m_pParams->setData(&shaderParams, sizeof(ShaderParams));
+
+		const std::vector<LightCluster>& clusters = m_builder.getClusters();
+		m_pClusters->setData(clusters.data(), clusters.size() * sizeof(LightCluster));
+
+		const std::vector<PointLight>& lights = m_builder.getViewLights();
+		if (!lights.empty()) {
+			reserve(m_pLights, lights.size() * sizeof(PointLight), "Cluster lights");
+			m_pLights->setData(lights.data(), lights.size() * sizeof(PointLight));
+		}
+
+		const std::vector<uint32_t>& indices = m_builder.getLightIndices();
+		if (!indices.empty()) {
+			reserve(m_pIndices, indices.size() * sizeof(uint32_t), "Cluster light indices");
+			m_pIndices->setData(indices.data(), indices.size() * sizeof(uint32_t));
+		}
+		m_uploadMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	void ClusteredLighting::bind() const noexcept {
+		m_pParams->bindUniform(ParamsBinding);
+		m_pLights->bindBase(LightsBinding);
+		m_pClusters->bindBase(ClustersBinding);
+		m_pIndices->bindBase(IndicesBinding);
+	}
+
+	void ClusteredLighting::drawImGuiPanel() {
+		if (ImGui::Begin("Кластерное освещение")) {
+			const LightClusterParams& params = m_builder.getParams();
+			const LightClusterStats& stats = m_builder.getStats();
+			const uint32_t clusterCount = m_builder.getClusterCount();
+
+			ImGui::Text("Сетка: %u x %u x %u (%u кластеров)", params.tilesX, params.tilesY, params.slices, clusterCount);
+			ImGui::Text("Источников: %u (видимых %u)", stats.lightCount, stats.visibleLights);
+			ImGui::Text("Индексов: %u, в среднем %.2f на кластер, максимум %u",
+				stats.indexCount, clusterCount ? static_cast<float>(stats.indexCount) / clusterCount : 0.f, stats.maxLightsPerCluster);
+			ImGui::Text("Построение: %.3f ms, загрузка: %.3f ms", stats.buildMs, m_uploadMs);
+		}
+		ImGui::End();
+	}
+
+} // namespace Engine
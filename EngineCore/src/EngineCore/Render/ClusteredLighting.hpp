@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "EngineCore/Math.hpp"
+#include "EngineCore/Render/LightClusters.hpp"
+
+namespace Engine {
+
+	class JobSystem;
+	class StorageBuffer;
+
+	/**
+	 * @internal
+	 * @brief Кластерное прямое освещение точечными источниками.
+	 *
+	 * Каждый кадр `LightClusterBuilder` распределяет источники по кластерам
+	 * (параллельно в `JobSystem`), затем источники в пространстве вида, записи
+	 * кластеров и общий массив индексов загружаются в SSBO. Фрагментный шейдер
+	 * подключает `ShaderSource` и вызывает `shadeClusteredLights()`: функция
+	 * находит кластер фрагмента и перебирает только его короткий список.
+	 *
+	 * Пример использования
+	 * @code
+	 * shaderLibrary.getPreprocessor().addVirtualFile("engine/clustered_lighting.glsl", ClusteredLighting::ShaderSource);
+	 * // Фрагментный шейдер:
+	 * // #include "engine/clustered_lighting.glsl"
+	 * // color = albedo * (ambient + shadeClusteredLights(gl_FragCoord.xy, viewPosition, viewNormal));
+	 *
+	 * // Каждый кадр
+	 * lighting.update(camera.view, camera.projection, width, height, lights.data(), lights.size());
+	 * lighting.bind();
+	 * drawScene();
+	 * @endcode
+	 *
+	 * @note Методы вызываются только из потока с контекстом OpenGL.
+	 */
+	class ClusteredLighting {
+	public:
+		// Точки привязки: uniform блок параметров и три SSBO.
+		static constexpr unsigned int ParamsBinding		= 4;
+		static constexpr unsigned int LightsBinding		= 4;
+		static constexpr unsigned int ClustersBinding	= 5;
+		static constexpr unsigned int IndicesBinding	= 6;
+
+		/// @internal
+		/// @brief Блоки и функции GLSL (требуется GLSL 4.30 для SSBO).
+		///
+		/// `shadeClusteredLights(fragCoord, viewPosition, viewNormal)` возвращает сумму
+		/// диффузного вклада источников кластера; позиция и нормаль - в пространстве вида.
+		/// `shadeAllLights()` перебирает все источники и нужна для сравнения.
+		static constexpr const char* ShaderSource =
+			"struct PointLight {\n"
+			"	vec3 position;\n"
+			"	float radius;\n"
+			"	vec3 color;\n"
+			"	float intensity;\n"
+			"};\n"
+			"layout(std140, binding = 4) uniform ClusterParams {\n"
+			"	uvec4 clusterGrid;\n"		// tilesX, tilesY, slices, число источников
+			"	vec4 clusterScale;\n"		// tilesX / width, tilesY / height, sliceScale, sliceBias
+			"};\n"
+			"layout(std430, binding = 4) readonly buffer ClusterLights { PointLight clusterLights[]; };\n"
+			"layout(std430, binding = 5) readonly buffer ClusterRecords { uvec2 clusterRecords[]; };\n"
+			"layout(std430, binding = 6) readonly buffer ClusterIndices { uint clusterLightIndices[]; };\n"
+			"uint clusterIndex(vec2 fragCoord, float viewDepth) {\n"
+			"	uvec2 tile = min(uvec2(fragCoord * clusterScale.xy), clusterGrid.xy - 1u);\n"
+			"	float slice = clamp(floor(log(viewDepth) * clusterScale.z + clusterScale.w), 0.0, float(clusterGrid.z - 1u));\n"
+			"	return (uint(slice) * clusterGrid.y + tile.y) * clusterGrid.x + tile.x;\n"
+			"}\n"
+			"vec3 pointLightContribution(PointLight light, vec3 viewPosition, vec3 viewNormal) {\n"
+			"	vec3 toLight = light.position - viewPosition;\n"
+			"	float distanceSquared = dot(toLight, toLight);\n"
+			"	float falloff = clamp(1.0 - distanceSquared / (light.radius * light.radius), 0.0, 1.0);\n"
+			"	float diffuse = max(dot(viewNormal, toLight * inversesqrt(max(distanceSquared, 1e-8))), 0.0);\n"
+			"	return light.color * (light.intensity * diffuse * falloff * falloff);\n"
+			"}\n"
+			"vec3 shadeClusteredLights(vec2 fragCoord, vec3 viewPosition, vec3 viewNormal) {\n"
+			"	uvec2 record = clusterRecords[clusterIndex(fragCoord, -viewPosition.z)];\n"
+			"	vec3 result = vec3(0.0);\n"
+			"	for (uint i = 0u; i < record.y; ++i) {\n"
+			"		result += pointLightContribution(clusterLights[clusterLightIndices[record.x + i]], viewPosition, viewNormal);\n"
+			"	}\n"
+			"	return result;\n"
+			"}\n"
+			"vec3 shadeAllLights(vec3 viewPosition, vec3 viewNormal) {\n"
+			"	vec3 result = vec3(0.0);\n"
+			"	for (uint i = 0u; i < clusterGrid.w; ++i) {\n"
+			"		result += pointLightContribution(clusterLights[i], viewPosition, viewNormal);\n"
+			"	}\n"
+			"	return result;\n"
+			"}\n";
+
+		explicit ClusteredLighting(const LightClusterParams& params = {}, JobSystem* pJobSystem = nullptr);
+		~ClusteredLighting();
+
+		ClusteredLighting(const ClusteredLighting&)				= delete;
+		ClusteredLighting& operator=(const ClusteredLighting&)	= delete;
+		ClusteredLighting(ClusteredLighting&&)					= delete;
+		ClusteredLighting& operator=(ClusteredLighting&&)		= delete;
+
+		/// @internal
+		/// @brief Распределяет источники по кластерам и загружает списки на GPU.
+		/// @param view Матрица вида.
+		/// @param projection Перспективная проекция.
+		/// @param viewportWidth Ширина области вывода в пикселях (для плитки по `gl_FragCoord`).
+		/// @param viewportHeight Высота области вывода в пикселях.
+		/// @param pLights Источники в мировых координатах.
+		/// @param lightCount Число источников.
+		void update(
+			const Mat4& view, const Mat4& projection,
+			uint32_t viewportWidth, uint32_t viewportHeight,
+			const PointLight* pLights, uint32_t lightCount
+		);
+
+		/// @internal
+		/// @brief Привязывает буферы к точкам из `ShaderSource`.
+		void bind() const noexcept;
+
+		const LightClusterBuilder& getBuilder() const noexcept { return m_builder; }
+
+		/// @internal
+		/// @brief Рисует ImGui окно со статистикой сетки.
+		void drawImGuiPanel();
+
+	private:
+		/// Uniform блок `ClusterParams` (std140).
+		struct ShaderParams {
+			uint32_t	grid[4];
+			float		scale[4];
+		};
+
+		/// Пересоздаёт буфер с запасом, если `size` в него не помещается.
+		static void reserve(std::unique_ptr<StorageBuffer>& pBuffer, size_t size, const char* label);
+
+		LightClusterBuilder				m_builder;
+		std::unique_ptr<StorageBuffer>	m_pParams;
+		std::unique_ptr<StorageBuffer>	m_pLights;
+		std::unique_ptr<StorageBuffer>	m_pClusters;
+		std::unique_ptr<StorageBuffer>	m_pIndices;
+		float							m_uploadMs	= 0.f;
+	};
+
+} // namespace Engine
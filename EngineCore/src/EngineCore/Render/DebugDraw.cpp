@@ -0,0 +1,512 @@
+#include "EngineCore/Render/DebugDraw.hpp"
+
+#ifndef NDEBUG
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <glad/glad.h>
+#include <imgui/imgui.h>
+
+#include "EngineCore/Log.hpp"
+#include "EngineCore/Memory/FrameAllocator.hpp"
+#include "EngineCore/Render/OpenGL/ShaderProgram.hpp"
+#include "EngineCore/Render/OpenGL/VertexArray.hpp"
+#include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
+#include "EngineCore/Render/OpenGL/VertexLayout.hpp"
+#include "EngineCore/Render/RenderStats.hpp"
+
+namespace Engine {
+
+	/// Вершина отладочной геометрии (32 байта).
+	///
+	/// Линии рисуются треугольниками: отрезок - прямоугольник из шести вершин,
+	/// которые вершинный шейдер сдвигает на `offset` пикселей поперёк отрезка
+	/// к `other` на экране. У вершин треугольников `offset == 0`.
+	struct DebugVertex {
+		float		position[3];
+		float		other[3];	///< Другой конец отрезка.
+		uint32_t	color;
+		float		offset;		///< Сдвиг поперёк отрезка в пикселях (знак - сторона).
+	};
+
+	template<>
+	struct VertexLayout<DebugVertex> {
+		static constexpr VertexAttribute attributes[] = {
+			ENGINE_VERTEX_ATTRIBUTE(DebugVertex, position,	ShaderDataType::Float3),
+			ENGINE_VERTEX_ATTRIBUTE(DebugVertex, other,		ShaderDataType::Float3),
+			ENGINE_VERTEX_ATTRIBUTE(DebugVertex, color,		ShaderDataType::UNorm8x4),
+			ENGINE_VERTEX_ATTRIBUTE(DebugVertex, offset,	ShaderDataType::Float)
+		};
+	};
+
+	using Clock = std::chrono::steady_clock;
+
+	/// Пакет - режим глубины; линии и треугольники одного режима рисуются одним вызовом.
+	enum DebugBatch : uint8_t {
+		DepthTest = 0,
+		DepthOverlay,
+		BatchCount
+	};
+
+	/// Половина толщины линии в пикселях.
+	static constexpr float LineHalfWidth = 0.75f;
+
+	/// Кадров в кольце потокового буфера: запись в часть кадра ждёт только
+	/// отрисовку, отправленную `FramesInFlight` кадров назад.
+	static constexpr uint32_t FramesInFlight = 3;
+
+	/// Примитив с длительностью: вершины хранятся отдельно до истечения срока.
+	struct TimedPrimitive {
+		Clock::time_point	expiry;
+		uint32_t			first;
+		uint32_t			count;
+		uint8_t				batch;
+		bool				bDrawn;
+	};
+
+	/// Буфер одного потока. Блокировка захватывается владельцем на время записи
+	/// примитива и `render()` на время сбора, поэтому почти никогда не ждёт.
+	struct DebugThreadBuffer {
+		std::mutex					mutex;
+		std::vector<DebugVertex>	frame[BatchCount];
+		std::vector<DebugVertex>	timedVertices;
+		std::vector<TimedPrimitive>	timed;
+		bool						bThreadExited	= false;	///< Поток завершился, буфер удаляется после сбора.
+	};
+
+	static const char* s_debugVertexShader =
+	"#version 460\n"
+	"layout(location = 0) in vec3 vertex_position;\n"
+	"layout(location = 1) in vec3 vertex_other;\n"
+	"layout(location = 2) in vec4 vertex_color;\n"
+	"layout(location = 3) in float vertex_offset;\n"
+	"layout(location = 0) uniform mat4 u_viewProjection;\n"
+	"layout(location = 1) uniform vec4 u_viewport;\n"	// (ширина, высота, 1 / ширина, 1 / высота)
+	"out vec4 color;\n"
+	"void main() {\n"
+	"	color = vertex_color;\n"
+	"	gl_Position = u_viewProjection * vec4(vertex_position, 1.0);\n"
+	"	if (vertex_offset != 0.0) {\n"
+	"		vec4 other = u_viewProjection * vec4(vertex_other, 1.0);\n"
+	"		vec2 delta = (other.xy / other.w - gl_Position.xy / gl_Position.w) * u_viewport.xy;\n"
+	"		float len = length(delta);\n"
+	"		vec2 direction = len > 1e-6 ? delta / len : vec2(1.0, 0.0);\n"
+	"		vec2 normal = vec2(-direction.y, direction.x) * vertex_offset * 2.0 * u_viewport.zw;\n"
+	"		gl_Position.xy += normal * gl_Position.w;\n"
+	"	}\n"
+	"}\n";
+
+	static const char* s_debugFragmentShader =
+	"#version 460\n"
+	"in vec4 color;\n"
+	"out vec4 fragment_color;\n"
+	"void main() {\n"
+	"	fragment_color = color;\n"
+	"}\n";
+
+	/// Владелец буфера потока: при завершении потока помечает буфер для удаления.
+	struct DebugThreadBufferHandle {
+		DebugThreadBuffer* pBuffer = nullptr;
+		~DebugThreadBufferHandle();
+	};
+
+	static std::mutex										s_buffersMutex;
+	static std::vector<std::unique_ptr<DebugThreadBuffer>>	s_buffers;
+	static thread_local DebugThreadBufferHandle				s_threadBuffer;
+
+	static std::vector<DebugVertex>		s_persistentVertices;
+	static std::vector<TimedPrimitive>	s_persistent;
+	static uint32_t						s_batchFirst[BatchCount]	= {};
+	static uint32_t						s_batchCount[BatchCount]	= {};
+
+	static std::unique_ptr<VertexBuffer>	s_pVertices;
+	static std::unique_ptr<VertexArray>		s_pVertexArray;
+	static std::unique_ptr<ShaderProgram>	s_pProgram;
+	static uint32_t							s_binding			= 0;
+	static uint32_t							s_frameCapacity		= 0;	///< Вершин в части кольца одного кадра.
+	static GLsync							s_fences[FramesInFlight]	= {};
+	static uint32_t							s_frame				= 0;
+	static Mat4								s_viewProjection;
+	static bool								s_bEnabled			= true;
+	static uint32_t							s_lastVertexCount	= 0;
+	static uint32_t							s_lastDrawCalls		= 0;
+
+	DebugThreadBufferHandle::~DebugThreadBufferHandle() {
+		if (pBuffer) {
+			std::lock_guard<std::mutex> lock(s_buffersMutex);
+			pBuffer->bThreadExited = true;
+		}
+	}
+
+	static DebugThreadBuffer& getThreadBuffer() {
+		if (!s_threadBuffer.pBuffer) {
+			std::lock_guard<std::mutex> lock(s_buffersMutex);
+			s_threadBuffer.pBuffer = s_buffers.emplace_back(std::make_unique<DebugThreadBuffer>()).get();
+		}
+		return *s_threadBuffer.pBuffer;
+	}
+
+	/// Блокирует буферы всех потоков (под `s_buffersMutex`).
+	struct ThreadBuffersLock {
+		ThreadBuffersLock() {
+			for (auto& pBuffer : s_buffers) {
+				pBuffer->mutex.lock();
+			}
+		}
+		~ThreadBuffersLock() {
+			for (auto& pBuffer : s_buffers) {
+				pBuffer->mutex.unlock();
+			}
+		}
+		ThreadBuffersLock(const ThreadBuffersLock&)				= delete;
+		ThreadBuffersLock& operator=(const ThreadBuffersLock&)	= delete;
+	};
+
+	static void submit(
+		const DebugBatch	batch,
+		const DebugVertex*	pVertices,
+		const uint32_t		count,
+		const float			duration
+	) {
+		DebugThreadBuffer& buffer = getThreadBuffer();
+		std::lock_guard<std::mutex> lock(buffer.mutex);
+		if (duration <= 0.f) {
+			buffer.frame[batch].insert(buffer.frame[batch].end(), pVertices, pVertices + count);
+			return;
+		}
+
+		const auto expiry = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(duration));
+		buffer.timed.push_back({ expiry, static_cast<uint32_t>(buffer.timedVertices.size()), count, batch, false });
+		buffer.timedVertices.insert(buffer.timedVertices.end(), pVertices, pVertices + count);
+	}
+
+	static DebugBatch getBatch(const DebugDraw::EDepth depth) noexcept {
+		return depth == DebugDraw::EDepth::Test ? DepthTest : DepthOverlay;
+	}
+
+	static DebugVertex makeVertex(const Vec3& position, const uint32_t color) noexcept {
+		return { { position.x, position.y, position.z }, { position.x, position.y, position.z }, color, 0.f };
+	}
+
+	static DebugVertex makeLineVertex(const Vec3& position, const Vec3& other, const uint32_t color, const float offset) noexcept {
+		return { { position.x, position.y, position.z }, { other.x, other.y, other.z }, color, offset };
+	}
+
+	/// Отрезок - шесть вершин двух треугольников. Направление к `other` у концов
+	/// противоположное, поэтому одна сторона у `from` и у `to` - разные знаки сдвига.
+	static void writeLine(DebugVertex* pVertices, const Vec3& from, const Vec3& to, const uint32_t color) noexcept {
+		const DebugVertex fromLeft = makeLineVertex(from, to, color, LineHalfWidth);
+		const DebugVertex fromRight = makeLineVertex(from, to, color, -LineHalfWidth);
+		const DebugVertex toLeft = makeLineVertex(to, from, color, -LineHalfWidth);
+		const DebugVertex toRight = makeLineVertex(to, from, color, LineHalfWidth);
+		pVertices[0] = fromLeft;
+		pVertices[1] = fromRight;
+		pVertices[2] = toRight;
+		pVertices[3] = fromLeft;
+		pVertices[4] = toRight;
+		pVertices[5] = toLeft;
+	}
+
+	/// Рёбра куба по индексам углов (бит 0 - x, бит 1 - y, бит 2 - z).
+	static constexpr uint8_t s_cubeEdges[24] = {
+		0, 1,	2, 3,	4, 5,	6, 7,
+		0, 2,	1, 3,	4, 6,	5, 7,
+		0, 4,	1, 5,	2, 6,	3, 7
+	};
+
+	static void submitCube(const Vec3 (&corners)[8], const uint32_t color, const float duration, const DebugDraw::EDepth depth) {
+		DebugVertex vertices[12 * 6];
+		for (size_t edge = 0; edge < 12; ++edge) {
+			writeLine(vertices + edge * 6, corners[s_cubeEdges[edge * 2]], corners[s_cubeEdges[edge * 2 + 1]], color);
+		}
+		submit(getBatch(depth), vertices, 12 * 6, duration);
+	}
+
+	/// Создаёт кольцо из `FramesInFlight` частей по `frameCapacity` вершин.
+	static void createVertexRing(const uint32_t frameCapacity) {
+		for (GLsync& fence : s_fences) {
+			if (fence) {
+				glDeleteSync(fence);
+				fence = nullptr;
+			}
+		}
+		s_frameCapacity = frameCapacity;
+		// Старый буфер удаляется очередью после кадров, которые его ещё читают.
+		s_pVertices = std::make_unique<VertexBuffer>(
+			static_cast<const DebugVertex*>(nullptr), static_cast<size_t>(frameCapacity) * FramesInFlight, VertexBuffer::EUsage::Stream
+		);
+		s_pVertices->setLabel("Debug draw vertices");
+		s_pVertexArray->setVertexBuffer(s_binding, *s_pVertices);
+	}
+
+	void DebugDraw::init() {
+		s_pVertexArray = std::make_unique<VertexArray>();
+		s_binding = s_pVertexArray->addLayout<DebugVertex>();
+		s_pVertexArray->setLabel("Debug draw VAO");
+		createVertexRing(16384);
+		VertexArray::unbind();
+		s_pProgram = std::make_unique<ShaderProgram>(s_debugVertexShader, s_debugFragmentShader);
+		s_pProgram->setLabel("Debug draw program");
+	}
+
+	void DebugDraw::shutdown() {
+		for (GLsync& fence : s_fences) {
+			if (fence) {
+				glDeleteSync(fence);
+				fence = nullptr;
+			}
+		}
+		s_pProgram.reset();
+		s_pVertexArray.reset();
+		s_pVertices.reset();
+
+		std::lock_guard<std::mutex> lock(s_buffersMutex);
+		for (auto& pBuffer : s_buffers) {
+			std::lock_guard<std::mutex> bufferLock(pBuffer->mutex);
+			for (auto& vertices : pBuffer->frame) {
+				vertices.clear();
+			}
+			pBuffer->timed.clear();
+			pBuffer->timedVertices.clear();
+		}
+		s_buffers.erase(
+			std::remove_if(s_buffers.begin(), s_buffers.end(), [](const auto& pBuffer) { return pBuffer->bThreadExited; }),
+			s_buffers.end()
+		);
+		s_persistent.clear();
+		s_persistentVertices.clear();
+	}
+
+	void DebugDraw::setViewProjection(const Mat4& viewProjection) noexcept {
+		s_viewProjection = viewProjection;
+	}
+
+	void DebugDraw::render(FrameAllocator& frameAllocator) {
+		if (!s_pVertices) {
+			return;
+		}
+
+		// Вершины кадра собираются в арену кадра: установившийся кадр не обращается к куче.
+		DebugVertex* pStaging = nullptr;
+		uint32_t vertexCount = 0;
+		{
+			std::lock_guard<std::mutex> lock(s_buffersMutex);
+			{
+				// Буферы заблокированы все сразу: между подсчётом вершин и копированием
+				// потоки не добавляют новых. Потоки блокируют только свой буфер.
+				ThreadBuffersLock buffersLock;
+				for (auto& pBuffer : s_buffers) {
+					for (TimedPrimitive primitive : pBuffer->timed) {
+						const DebugVertex* pFirst = pBuffer->timedVertices.data() + primitive.first;
+						primitive.first = static_cast<uint32_t>(s_persistentVertices.size());
+						s_persistentVertices.insert(s_persistentVertices.end(), pFirst, pFirst + primitive.count);
+						s_persistent.push_back(primitive);
+					}
+					pBuffer->timed.clear();
+					pBuffer->timedVertices.clear();
+				}
+
+				// Истёкшие примитивы удаляются, но каждый успевает показаться хотя бы раз.
+				const Clock::time_point now = Clock::now();
+				size_t kept = 0;
+				size_t keptVertices = 0;
+				for (TimedPrimitive& primitive : s_persistent) {
+					if (primitive.bDrawn && primitive.expiry <= now) {
+						continue;
+					}
+					primitive.bDrawn = true;
+					std::copy_n(s_persistentVertices.begin() + primitive.first, primitive.count, s_persistentVertices.begin() + keptVertices);
+					primitive.first = static_cast<uint32_t>(keptVertices);
+					keptVertices += primitive.count;
+					s_persistent[kept++] = primitive;
+				}
+				s_persistent.resize(kept);
+				s_persistentVertices.resize(keptVertices);
+
+				for (uint8_t batch = 0; batch < BatchCount; ++batch) {
+					s_batchCount[batch] = 0;
+					for (const auto& pBuffer : s_buffers) {
+						s_batchCount[batch] += static_cast<uint32_t>(pBuffer->frame[batch].size());
+					}
+				}
+				for (const TimedPrimitive& primitive : s_persistent) {
+					s_batchCount[primitive.batch] += primitive.count;
+				}
+
+				for (uint8_t batch = 0; batch < BatchCount; ++batch) {
+					s_batchFirst[batch] = vertexCount;
+					vertexCount += s_batchCount[batch];
+				}
+				pStaging = frameAllocator.allocateArray<DebugVertex>(vertexCount);
+
+				for (uint8_t batch = 0; batch < BatchCount; ++batch) {
+					DebugVertex* pVertex = pStaging + s_batchFirst[batch];
+					for (auto& pBuffer : s_buffers) {
+						pVertex = std::copy(pBuffer->frame[batch].begin(), pBuffer->frame[batch].end(), pVertex);
+						pBuffer->frame[batch].clear();
+					}
+					for (const TimedPrimitive& primitive : s_persistent) {
+						if (primitive.batch == batch) {
+							pVertex = std::copy_n(s_persistentVertices.begin() + primitive.first, primitive.count, pVertex);
+						}
+					}
+				}
+			}
+			// Буферы завершившихся потоков уже собраны, новых записей в них не будет.
+			s_buffers.erase(
+				std::remove_if(s_buffers.begin(), s_buffers.end(), [](const auto& pBuffer) { return pBuffer->bThreadExited; }),
+				s_buffers.end()
+			);
+		}
+
+		s_lastVertexCount = vertexCount;
+		s_lastDrawCalls = 0;
+		if (!s_bEnabled || vertexCount == 0) {
+			return;
+		}
+
+		if (vertexCount > s_frameCapacity) {
+			uint32_t capacity = s_frameCapacity;
+			while (capacity < vertexCount) {
+				capacity *= 2;
+			}
+			createVertexRing(capacity);
+		}
+
+		// Часть кольца этого кадра GPU читал `FramesInFlight` кадров назад.
+		const uint32_t part = s_frame % FramesInFlight;
+		if (GLsync fence = s_fences[part]) {
+			glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+			glDeleteSync(fence);
+			s_fences[part] = nullptr;
+		}
+		const uint32_t partFirst = part * s_frameCapacity;
+		const size_t bytes = static_cast<size_t>(vertexCount) * sizeof(DebugVertex);
+		if (void* pMapped = s_pVertices->getMappedData()) {
+			std::memcpy(static_cast<DebugVertex*>(pMapped) + partFirst, pStaging, bytes);
+		}
+		else {
+			s_pVertices->setData(pStaging, bytes, static_cast<size_t>(partFirst) * sizeof(DebugVertex));
+		}
+
+		GLint viewport[4] = {};
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		const float width = static_cast<float>(std::max(viewport[2], 1));
+		const float height = static_cast<float>(std::max(viewport[3], 1));
+
+		s_pProgram->setMatrix4(0, s_viewProjection.data());
+		s_pProgram->setFloat4(1, width, height, 1.f / width, 1.f / height);
+		s_pProgram->bind();
+		s_pVertexArray->bind();
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glDepthMask(GL_FALSE);
+
+		for (uint8_t batch = 0; batch < BatchCount; ++batch) {
+			if (s_batchCount[batch] == 0) {
+				continue;
+			}
+			if (batch == DepthTest) {
+				glEnable(GL_DEPTH_TEST);
+			}
+			else {
+				glDisable(GL_DEPTH_TEST);
+			}
+			glDrawArrays(GL_TRIANGLES, static_cast<GLint>(partFirst + s_batchFirst[batch]), static_cast<GLsizei>(s_batchCount[batch]));
+			RenderStats::addDrawCall(s_batchCount[batch]);
+			++s_lastDrawCalls;
+		}
+		s_fences[part] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		++s_frame;
+
+		glDepthMask(GL_TRUE);
+		glDisable(GL_DEPTH_TEST);
+		glDisable(GL_BLEND);
+	}
+
+	void DebugDraw::line(const Vec3& from, const Vec3& to, const uint32_t color, const float duration, const EDepth depth) {
+		DebugVertex vertices[6];
+		writeLine(vertices, from, to, color);
+		submit(getBatch(depth), vertices, 6, duration);
+	}
+
+	void DebugDraw::triangle(const Vec3& a, const Vec3& b, const Vec3& c, const uint32_t color, const float duration, const EDepth depth) {
+		const DebugVertex vertices[3] = { makeVertex(a, color), makeVertex(b, color), makeVertex(c, color) };
+		submit(getBatch(depth), vertices, 3, duration);
+	}
+
+	void DebugDraw::aabb(const Vec3& min, const Vec3& max, const uint32_t color, const float duration, const EDepth depth) {
+		Vec3 corners[8];
+		for (uint8_t i = 0; i < 8; ++i) {
+			corners[i] = { (i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z };
+		}
+		submitCube(corners, color, duration, depth);
+	}
+
+	void DebugDraw::box(const Mat4& transform, const uint32_t color, const float duration, const EDepth depth) {
+		Vec3 corners[8];
+		for (uint8_t i = 0; i < 8; ++i) {
+			corners[i] = transform.transformPoint({ (i & 1) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, (i & 4) ? 0.5f : -0.5f });
+		}
+		submitCube(corners, color, duration, depth);
+	}
+
+	void DebugDraw::sphere(const Vec3& center, const float radius, const uint32_t color, const float duration, const EDepth depth) {
+		constexpr uint32_t Segments = 32;
+		constexpr float Step = 6.28318530718f / Segments;
+
+		DebugVertex vertices[Segments * 3 * 6];
+		DebugVertex* pVertex = vertices;
+		for (uint32_t i = 0; i < Segments; ++i) {
+			const float c0 = std::cos(Step * i) * radius, s0 = std::sin(Step * i) * radius;
+			const float c1 = std::cos(Step * (i + 1)) * radius, s1 = std::sin(Step * (i + 1)) * radius;
+			writeLine(pVertex, center + Vec3(c0, s0, 0.f), center + Vec3(c1, s1, 0.f), color);
+			writeLine(pVertex + 6, center + Vec3(c0, 0.f, s0), center + Vec3(c1, 0.f, s1), color);
+			writeLine(pVertex + 12, center + Vec3(0.f, c0, s0), center + Vec3(0.f, c1, s1), color);
+			pVertex += 18;
+		}
+		submit(getBatch(depth), vertices, Segments * 3 * 6, duration);
+	}
+
+	void DebugDraw::frustum(const Mat4& viewProjection, const uint32_t color, const float duration, const EDepth depth) {
+		// Углы куба NDC переводятся в мировое пространство обратной матрицей.
+		const Mat4 inverseViewProjection = inverse(viewProjection);
+		Vec3 corners[8];
+		for (uint8_t i = 0; i < 8; ++i) {
+			const Vec4 world = inverseViewProjection * Vec4((i & 1) ? 1.f : -1.f, (i & 2) ? 1.f : -1.f, (i & 4) ? 1.f : -1.f, 1.f);
+			corners[i] = world.xyz() * (1.f / world.w);
+		}
+		submitCube(corners, color, duration, depth);
+	}
+
+	void DebugDraw::axes(const Mat4& transform, const float size, const float duration, const EDepth depth) {
+		const Vec3 origin = transform.transformPoint({ 0.f, 0.f, 0.f });
+		DebugVertex vertices[3 * 6];
+		writeLine(vertices, origin, transform.transformPoint({ size, 0.f, 0.f }), DebugColor::Red);
+		writeLine(vertices + 6, origin, transform.transformPoint({ 0.f, size, 0.f }), DebugColor::Green);
+		writeLine(vertices + 12, origin, transform.transformPoint({ 0.f, 0.f, size }), DebugColor::Blue);
+		submit(getBatch(depth), vertices, 3 * 6, duration);
+	}
+
+	void DebugDraw::drawImGuiPanel() {
+		ImGui::Begin("Отладочная геометрия");
+
+		ImGui::Checkbox("Рисовать", &s_bEnabled);
+		ImGui::Text("Вершин: %u, вызовов отрисовки: %u", s_lastVertexCount, s_lastDrawCalls);
+		ImGui::Text("Примитивов с длительностью: %zu", s_persistent.size());
+		{
+			std::lock_guard<std::mutex> lock(s_buffersMutex);
+			ImGui::Text("Буферов потоков: %zu", s_buffers.size());
+		}
+
+		ImGui::End();
+	}
+
+} // namespace Engine
+
+#endif // NDEBUG
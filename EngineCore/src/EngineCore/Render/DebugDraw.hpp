@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+
+#include "EngineCore/Math.hpp"
+
+namespace Engine {
+
+	class FrameAllocator;
+
+	/// @internal
+	/// @brief Цвета отладочной геометрии (RGBA8, R в младшем байте).
+	namespace DebugColor {
+		constexpr uint32_t White	= 0xFFFFFFFF;
+		constexpr uint32_t Red		= 0xFF0000FF;
+		constexpr uint32_t Green	= 0xFF00FF00;
+		constexpr uint32_t Blue		= 0xFFFF0000;
+		constexpr uint32_t Yellow	= 0xFF00FFFF;
+		constexpr uint32_t Cyan		= 0xFFFFFF00;
+		constexpr uint32_t Magenta	= 0xFFFF00FF;
+	} // namespace DebugColor
+
+#ifndef NDEBUG
+
+	/**
+	 * @internal
+	 * @brief Отладочная геометрия в режиме immediate mode.
+	 *
+	 * Примитивы (линии, боксы, сферы, пирамиды видимости, треугольники) можно
+	 * добавлять из любого потока во время `update()`: каждый поток пишет в свой
+	 * буфер, и блокировка буфера не конкурирует с другими потоками. Буфер
+	 * завершившегося потока удаляется после очередного `render()`.
+	 *
+	 * `render()` собирает буферы всех потоков в кольцо потокового буфера (часть
+	 * на кадр, без ожидания GPU) и рисует их не более чем двумя вызовами: с проверкой
+	 * глубины и поверх сцены. Линии для этого рисуются треугольниками толщиной
+	 * в полтора пикселя.
+	 *
+	 * Примитив живёт один кадр или, если задана длительность, указанное время.
+	 *
+	 * Вызовы удобнее делать макросами `DEBUG_DRAW_*`: в релизной сборке (`NDEBUG`)
+	 * они пустые, аргументы не вычисляются, а сам класс не компилируется.
+	 * @code
+	 * DEBUG_DRAW_AABB(bounds.min, bounds.max, DebugColor::Green);
+	 * DEBUG_DRAW_FRUSTUM(camera.viewProjection, DebugColor::Yellow, 5.f);	// 5 секунд
+	 * DEBUG_DRAW_LINE(from, to, DebugColor::Red, 0.f, DebugDraw::EDepth::Overlay);
+	 * @endcode
+	 */
+	class DebugDraw {
+	public:
+		/**
+		 * @internal
+		 * @brief Режим проверки глубины примитива.
+		 */
+		enum class EDepth : uint8_t {
+			Test,		///< Скрывается геометрией сцены.
+			Overlay		///< Рисуется поверх сцены.
+		};
+
+		/// @internal
+		/// @brief Создаёт GL объекты. Вызывается в потоке с контекстом OpenGL.
+		static void init();
+
+		/// @internal
+		/// @brief Удаляет GL объекты и накопленные примитивы.
+		static void shutdown();
+
+		/// @internal
+		/// @brief Задаёт матрицу вида-проекции для следующих `render()`.
+		static void setViewProjection(const Mat4& viewProjection) noexcept;
+
+		/// @internal
+		/// @brief Рисует примитивы, добавленные с прошлого вызова, и ещё не истёкшие.
+		///
+		/// Вызывается в потоке с контекстом OpenGL после отрисовки сцены, когда
+		/// задачи, добавляющие примитивы, завершены.
+		/// @param frameAllocator Аллокатор кадра: в нём собираются вершины перед загрузкой в буфер.
+		static void render(FrameAllocator& frameAllocator);
+
+		static void line(const Vec3& from, const Vec3& to, uint32_t color, float duration = 0.f, EDepth depth = EDepth::Test);
+		static void triangle(const Vec3& a, const Vec3& b, const Vec3& c, uint32_t color, float duration = 0.f, EDepth depth = EDepth::Test);
+
+		/// @internal
+		/// @brief Бокс, выровненный по осям.
+		static void aabb(const Vec3& min, const Vec3& max, uint32_t color, float duration = 0.f, EDepth depth = EDepth::Test);
+
+		/// @internal
+		/// @brief Единичный куб [-0.5, 0.5], преобразованный матрицей `transform`.
+		static void box(const Mat4& transform, uint32_t color, float duration = 0.f, EDepth depth = EDepth::Test);
+
+		/// @internal
+		/// @brief Сфера тремя окружностями в плоскостях осей.
+		static void sphere(const Vec3& center, float radius, uint32_t color, float duration = 0.f, EDepth depth = EDepth::Test);
+
+		/// @internal
+		/// @brief Пирамида видимости камеры с матрицей вида-проекции `viewProjection`.
+		static void frustum(const Mat4& viewProjection, uint32_t color, float duration = 0.f, EDepth depth = EDepth::Test);
+
+		/// @internal
+		/// @brief Оси X, Y, Z (красная, зелёная, синяя) длиной `size` в пространстве `transform`.
+		static void axes(const Mat4& transform, float size = 1.f, float duration = 0.f, EDepth depth = EDepth::Test);
+
+		/// @internal
+		/// @brief Рисует ImGui окно со статистикой и переключателем отрисовки.
+		static void drawImGuiPanel();
+	};
+
+#define DEBUG_DRAW_LINE(...)		::Engine::DebugDraw::line(__VA_ARGS__)
+#define DEBUG_DRAW_TRIANGLE(...)	::Engine::DebugDraw::triangle(__VA_ARGS__)
+#define DEBUG_DRAW_AABB(...)		::Engine::DebugDraw::aabb(__VA_ARGS__)
+#define DEBUG_DRAW_BOX(...)			::Engine::DebugDraw::box(__VA_ARGS__)
+#define DEBUG_DRAW_SPHERE(...)		::Engine::DebugDraw::sphere(__VA_ARGS__)
+#define DEBUG_DRAW_FRUSTUM(...)		::Engine::DebugDraw::frustum(__VA_ARGS__)
+#define DEBUG_DRAW_AXES(...)		::Engine::DebugDraw::axes(__VA_ARGS__)
+
+#else
+
+#define DEBUG_DRAW_LINE(...)
+#define DEBUG_DRAW_TRIANGLE(...)
+#define DEBUG_DRAW_AABB(...)
+#define DEBUG_DRAW_BOX(...)
+#define DEBUG_DRAW_SPHERE(...)
+#define DEBUG_DRAW_FRUSTUM(...)
+#define DEBUG_DRAW_AXES(...)
+
+#endif
+
+} // namespace Engine
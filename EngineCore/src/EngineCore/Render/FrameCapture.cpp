@@ -0,0 +1,266 @@
+#include "EngineCore/Render/FrameCapture.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+#include <glad/glad.h>
+
+#include <imgui/imgui.h>
+
+#include "EngineCore/Core/JobSystem.hpp"
+#include "EngineCore/Image/Tga.hpp"
+#include "EngineCore/Log.hpp"
+#include "EngineCore/Render/OpenGL/Framebuffer.hpp"
+#include "EngineCore/Render/OpenGL/GpuResourceRegistry.hpp"
+
+namespace Engine {
+
+	FrameCapture::FrameCapture(JobSystem& jobSystem, const FrameCaptureParams& params)
+		: m_jobSystem(jobSystem)
+	{
+		m_slots.resize(std::max<uint32_t>(params.slotCount, 2));
+		for (std::unique_ptr<Slot>& pSlot : m_slots) {
+			pSlot = std::make_unique<Slot>();
+		}
+	}
+
+	FrameCapture::~FrameCapture() {
+		flush();
+		for (std::unique_ptr<Slot>& pSlot : m_slots) {
+			releaseSlot(*pSlot);
+		}
+	}
+
+	void FrameCapture::allocateSlot(Slot& slot, const size_t bytes) {
+		releaseSlot(slot);
+
+		// Постоянное отображение: рабочий поток читает буфер без вызовов OpenGL.
+		const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glGenBuffers(1, &slot.bufferId);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.bufferId);
+		glBufferStorage(GL_PIXEL_PACK_BUFFER, bytes, nullptr, flags);
+		slot.pMapped = static_cast<uint8_t*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, flags));
+		slot.capacity = bytes;
+
+		GpuResourceRegistry::add(GpuResourceCategory::Buffer, slot.bufferId, bytes, "readback");
+		GpuResourceRegistry::setLabel(GpuResourceCategory::Buffer, slot.bufferId, "Frame capture readback");
+	}
+
+	void FrameCapture::releaseSlot(Slot& slot) {
+		if (slot.fence) {
+			glDeleteSync(static_cast<GLsync>(slot.fence));
+			slot.fence = nullptr;
+		}
+		if (slot.bufferId != 0) {
+			GpuResourceRegistry::remove(GpuResourceCategory::Buffer, slot.bufferId);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.bufferId);
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+			glDeleteBuffers(1, &slot.bufferId);
+			slot.bufferId = 0;
+			slot.pMapped = nullptr;
+			slot.capacity = 0;
+		}
+	}
+
+	bool FrameCapture::issueCapture(
+		const unsigned int	framebuffer,
+		const uint32_t		width,
+		const uint32_t		height,
+		FrameCallback*		pCallback,
+		const char*			pPath,
+		const bool			bCreateDirectory
+	) {
+		const auto startTime = std::chrono::steady_clock::now();
+		++m_stats.requested;
+
+		if (width == 0 || height == 0) {
+			++m_stats.dropped;
+			return false;
+		}
+		if (pPath && std::strlen(pPath) >= MaxPathLength) {
+			LOG_ERR("[FrameCapture] Path is too long: {0}", pPath);
+			++m_stats.dropped;
+			return false;
+		}
+
+		// Кадр не ждёт освобождения PBO: при заторе он пропускается.
+		Slot& slot = *m_slots[m_nextSlot];
+		if (slot.state.load(std::memory_order_acquire) != ESlotState::Free) {
+			++m_stats.dropped;
+			return false;
+		}
+		m_nextSlot = (m_nextSlot + 1) % static_cast<uint32_t>(m_slots.size());
+
+		const size_t bytes = static_cast<size_t>(width) * height * 4;
+		if (slot.capacity < bytes) {
+			allocateSlot(slot, bytes);
+		}
+
+		slot.frame.frameIndex = m_frameIndex;
+		slot.frame.width = width;
+		slot.frame.height = height;
+		// Путь копируется в память слота: захват в файл каждый кадр не обращается к куче.
+		if (pCallback) {
+			slot.callback = std::move(*pCallback);
+			slot.path[0] = '\0';
+		}
+		else {
+			std::memcpy(slot.path, pPath, std::strlen(pPath) + 1);
+		}
+		slot.bCreateDirectory = bCreateDirectory;
+
+		// BGRA совпадает с внутренним порядком большинства драйверов, копия не требует перестановки.
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+		glReadBuffer(framebuffer == 0 ? GL_BACK : GL_COLOR_ATTACHMENT0);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.bufferId);
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		glReadPixels(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_BGRA, GL_UNSIGNED_BYTE, nullptr);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+		slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		slot.state.store(ESlotState::Copying, std::memory_order_release);
+
+		m_stats.issueMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+		return true;
+	}
+
+	bool FrameCapture::capture(const unsigned int framebuffer, const uint32_t width, const uint32_t height, FrameCallback callback) {
+		return issueCapture(framebuffer, width, height, &callback, nullptr, false);
+	}
+
+	bool FrameCapture::capture(const Framebuffer& framebuffer, FrameCallback callback) {
+		return capture(framebuffer.getId(), framebuffer.getWidth(), framebuffer.getHeight(), std::move(callback));
+	}
+
+	bool FrameCapture::captureToFile(const unsigned int framebuffer, const uint32_t width, const uint32_t height, const std::string& path) {
+		return issueCapture(framebuffer, width, height, nullptr, path.c_str(), true);
+	}
+
+	void FrameCapture::update(const unsigned int framebuffer, const uint32_t width, const uint32_t height) {
+		for (std::unique_ptr<Slot>& pSlotPtr : m_slots) {
+			Slot* pSlot = pSlotPtr.get();
+			if (pSlot->state.load(std::memory_order_acquire) != ESlotState::Copying) {
+				continue;
+			}
+			const GLenum result = glClientWaitSync(static_cast<GLsync>(pSlot->fence), 0, 0);
+			if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED) {
+				continue;
+			}
+			glDeleteSync(static_cast<GLsync>(pSlot->fence));
+			pSlot->fence = nullptr;
+			pSlot->state.store(ESlotState::Processing, std::memory_order_release);
+
+			m_jobSystem.submit([this, pSlot]() {
+				const auto startTime = std::chrono::steady_clock::now();
+
+				CapturedFrame& frame = pSlot->frame;
+				frame.pixels.resize(static_cast<size_t>(frame.width) * frame.height * 4);
+				std::memcpy(frame.pixels.data(), pSlot->pMapped, frame.pixels.size());
+				if (pSlot->path[0] != '\0') {
+					if (pSlot->bCreateDirectory) {
+						const std::filesystem::path parent = std::filesystem::path(pSlot->path).parent_path();
+						if (!parent.empty()) {
+							std::error_code error;
+							std::filesystem::create_directories(parent, error);
+						}
+					}
+					writeTga(pSlot->path, frame.width, frame.height, frame.pixels.data());
+				}
+				else if (pSlot->callback) {
+					pSlot->callback(frame);
+				}
+				pSlot->callback = nullptr;
+
+				const auto elapsed = std::chrono::steady_clock::now() - startTime;
+				m_workerMicroseconds.store(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()), std::memory_order_relaxed);
+				m_completed.fetch_add(1, std::memory_order_relaxed);
+				pSlot->state.store(ESlotState::Free, std::memory_order_release);
+			});
+		}
+
+		if (m_bContinuous || m_bScreenshotRequested) {
+			// Каталог создан в `setContinuous()` или при запросе снимка, здесь путь только форматируется.
+			char path[MaxPathLength];
+			if (m_bContinuous) {
+				std::snprintf(path, sizeof(path), "%s/frame_%06llu.tga", m_directory.c_str(), static_cast<unsigned long long>(m_frameIndex));
+			}
+			else {
+				std::snprintf(path, sizeof(path), "%s/screenshot_%03llu.tga", m_directory.c_str(), static_cast<unsigned long long>(m_screenshotIndex++));
+			}
+			issueCapture(framebuffer, width, height, nullptr, path, false);
+			m_bScreenshotRequested = false;
+		}
+
+		m_stats.inFlight = 0;
+		for (const std::unique_ptr<Slot>& pSlot : m_slots) {
+			m_stats.inFlight += pSlot->state.load(std::memory_order_relaxed) != ESlotState::Free ? 1 : 0;
+		}
+		m_stats.completed = m_completed.load(std::memory_order_relaxed);
+		m_stats.workerMs = static_cast<float>(m_workerMicroseconds.load(std::memory_order_relaxed)) / 1000.f;
+		++m_frameIndex;
+	}
+
+	void FrameCapture::flush() {
+		for (std::unique_ptr<Slot>& pSlot : m_slots) {
+			if (pSlot->state.load(std::memory_order_acquire) == ESlotState::Copying) {
+				// Ожидание допустимо: вызывается только на выходе или в тестах.
+				glClientWaitSync(static_cast<GLsync>(pSlot->fence), GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+			}
+		}
+		update(0, 0, 0);
+		for (std::unique_ptr<Slot>& pSlot : m_slots) {
+			while (pSlot->state.load(std::memory_order_acquire) != ESlotState::Free) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void FrameCapture::setContinuous(const bool bEnabled, const std::string& directory) {
+		m_bContinuous = bEnabled;
+		m_directory = directory;
+		if (bEnabled) {
+			createDirectory();
+			LOG_INFO("[FrameCapture] Continuous capture to {0}", directory);
+		}
+	}
+
+	void FrameCapture::createDirectory() {
+		std::error_code error;
+		std::filesystem::create_directories(m_directory, error);
+		if (error) {
+			LOG_ERR("[FrameCapture] Can not create {0}: {1}", m_directory, error.message());
+		}
+	}
+
+	void FrameCapture::drawImGuiPanel() {
+		ImGui::Begin("Захват кадров");
+
+		if (ImGui::Button("Снимок экрана")) {
+			if (m_directory.empty()) {
+				m_directory = "captures";
+			}
+			createDirectory();
+			m_bScreenshotRequested = true;
+		}
+		bool bContinuous = m_bContinuous;
+		if (ImGui::Checkbox("Непрерывный захват", &bContinuous)) {
+			setContinuous(bContinuous, m_directory.empty() ? "captures" : m_directory);
+		}
+
+		ImGui::Text("Запрошено: %llu, записано: %llu, пропущено: %llu",
+			static_cast<unsigned long long>(m_stats.requested),
+			static_cast<unsigned long long>(m_stats.completed),
+			static_cast<unsigned long long>(m_stats.dropped));
+		ImGui::Text("В пути: %u из %zu", m_stats.inFlight, m_slots.size());
+		ImGui::Text("Запрос: %.3f мс, рабочий поток: %.2f мс", m_stats.issueMs, m_stats.workerMs);
+
+		ImGui::End();
+	}
+
+} // namespace Engine
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+	class Framebuffer;
+	class JobSystem;
+
+	/**
+	 * @internal
+	 * @brief Захваченный кадр.
+	 */
+	struct CapturedFrame {
+		uint64_t				frameIndex	= 0;	///< Номер вызова `update()`, в котором кадр был запрошен.
+		uint32_t				width		= 0;
+		uint32_t				height		= 0;
+		std::vector<uint8_t>	pixels;				///< BGRA8, строки снизу вверх, без выравнивания.
+	};
+
+	/**
+	 * @internal
+	 * @brief Параметры `FrameCapture`.
+	 */
+	struct FrameCaptureParams {
+		uint32_t	slotCount	= 4;	///< PBO в кольце (кадров, которые могут быть в пути одновременно).
+	};
+
+	/**
+	 * @internal
+	 * @brief Статистика `FrameCapture`.
+	 */
+	struct FrameCaptureStats {
+		uint64_t	requested		= 0;	///< Запрошено кадров.
+		uint64_t	completed		= 0;	///< Обработано рабочими потоками.
+		uint64_t	dropped			= 0;	///< Пропущено: все PBO ещё заняты.
+		uint32_t	inFlight		= 0;	///< Кадров в пути (на GPU или в рабочем потоке).
+		float		issueMs			= 0.f;	///< Время последнего `capture()` в потоке рендера.
+		float		workerMs		= 0.f;	///< Время обработки последнего кадра в рабочем потоке.
+	};
+
+	/**
+	 * @internal
+	 * @brief Захват кадров без остановки конвейера.
+	 *
+	 * `glReadPixels` в память процесса ждёт, пока GPU дорисует кадр. Здесь кадр
+	 * копируется в один из PBO кольца (копирование выполняет GPU асинхронно),
+	 * после чего ставится fence. `update()` в следующих кадрах проверяет fence
+	 * без ожидания и, когда копия готова, отдаёт PBO рабочему потоку: тот
+	 * копирует пиксели из постоянно отображённого буфера и вызывает обработчик
+	 * (запись файла, кодирование видео, сравнение с эталоном). Поток рендера
+	 * не выполняет ни ожиданий, ни копирования пикселей.
+	 *
+	 * Если все PBO заняты (GPU или рабочие потоки не успевают), кадр пропускается
+	 * и учитывается в `FrameCaptureStats::dropped`, а частота кадров не падает.
+	 *
+	 * Пример использования
+	 * @code
+	 * capture.captureToFile(0, width, height, "screenshot.tga");	// экран
+	 * capture.capture(sceneFramebuffer, [](const CapturedFrame& frame) {
+	 * 	compareWithGolden(frame.pixels.data(), frame.width, frame.height);
+	 * });
+	 * // каждый кадр после отрисовки сцены
+	 * capture.update(0, width, height);
+	 * @endcode
+	 *
+	 * @note `capture()` и `update()` вызываются только из потока с контекстом OpenGL.
+	 */
+	class FrameCapture {
+	public:
+		/// @internal
+		/// @brief Обработчик кадра, вызывается в рабочем потоке.
+		using FrameCallback = std::function<void(const CapturedFrame& frame)>;
+
+		explicit FrameCapture(JobSystem& jobSystem, const FrameCaptureParams& params = {});
+
+		/// @internal
+		/// @brief Дожидается обработки кадров в пути и удаляет PBO.
+		~FrameCapture();
+
+		FrameCapture(const FrameCapture&)				= delete;
+		FrameCapture& operator=(const FrameCapture&)	= delete;
+		FrameCapture(FrameCapture&&)					= delete;
+		FrameCapture& operator=(FrameCapture&&)			= delete;
+
+		/// @internal
+		/// @brief Запрашивает захват цветового вложения 0 FBO (0 - экран).
+		/// @return false, если кадр пропущен (все PBO заняты).
+		bool capture(unsigned int framebuffer, uint32_t width, uint32_t height, FrameCallback callback);
+
+		/// @internal
+		/// @brief Запрашивает захват цветового вложения 0 `framebuffer`.
+		bool capture(const Framebuffer& framebuffer, FrameCallback callback);
+
+		/// @internal
+		/// @brief Запрашивает захват в файл TGA (каталоги создаются при необходимости).
+		bool captureToFile(unsigned int framebuffer, uint32_t width, uint32_t height, const std::string& path);
+
+		/// @internal
+		/// @brief Вызывается раз в кадр после отрисовки сцены.
+		///
+		/// Передаёт готовые копии рабочим потокам и захватывает `framebuffer`
+		/// при непрерывном захвате или запрошенном из ImGui снимке.
+		void update(unsigned int framebuffer, uint32_t width, uint32_t height);
+
+		/// @internal
+		/// @brief Дожидается обработки всех запрошенных кадров (для тестов и выхода).
+		void flush();
+
+		/// @internal
+		/// @brief Захватывать экран каждый кадр в `directory/frame_NNNNNN.tga`.
+		void setContinuous(bool bEnabled, const std::string& directory = "captures");
+		bool isContinuous() const noexcept { return m_bContinuous; }
+
+		const FrameCaptureStats& getStats() const noexcept { return m_stats; }
+
+		/// @internal
+		/// @brief Рисует ImGui окно: снимок экрана, непрерывный захват, статистика.
+		void drawImGuiPanel();
+
+	private:
+		/// Состояние PBO кольца.
+		enum class ESlotState : uint8_t {
+			Free,		///< Можно записывать.
+			Copying,	///< GPU копирует кадр, ждём fence.
+			Processing	///< Рабочий поток читает буфер.
+		};
+
+		/// Максимальная длина пути файла захвата, включая завершающий ноль.
+		static constexpr size_t MaxPathLength = 512;
+
+		struct Slot {
+			unsigned int				bufferId	= 0;
+			uint8_t*					pMapped		= nullptr;
+			size_t						capacity	= 0;
+			void*						fence		= nullptr;	///< GLsync копирования кадра.
+			std::atomic<ESlotState>		state		{ ESlotState::Free };
+			CapturedFrame				frame;					///< Пиксели переиспользуются между кадрами.
+			FrameCallback				callback;
+			char						path[MaxPathLength]	= {};	///< Файл TGA вместо `callback`, если не пуст.
+			bool						bCreateDirectory	= false;
+		};
+
+		/// Общая часть `capture()` и `captureToFile()`: ровно один из `pCallback` и `pPath` не пуст.
+		bool issueCapture(unsigned int framebuffer, uint32_t width, uint32_t height, FrameCallback* pCallback, const char* pPath, bool bCreateDirectory);
+
+		void allocateSlot(Slot& slot, size_t bytes);
+		void createDirectory();
+		void releaseSlot(Slot& slot);
+
+		JobSystem&							m_jobSystem;
+		std::vector<std::unique_ptr<Slot>>	m_slots;
+		uint32_t							m_nextSlot		= 0;
+		uint64_t							m_frameIndex	= 0;
+
+		bool								m_bContinuous			= false;
+		bool								m_bScreenshotRequested	= false;
+		std::string							m_directory;
+		uint64_t							m_screenshotIndex		= 0;
+
+		std::atomic<uint64_t>				m_completed		{ 0 };
+		std::atomic<uint32_t>				m_workerMicroseconds	{ 0 };
+		FrameCaptureStats					m_stats;
+	};
+
+} // namespace Engine
@@ -0,0 +1,494 @@
+#include "EngineCore/Render/FrameGraph.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <queue>
+
+#include <glad/glad.h>
+
+#include <imgui/imgui.h>
+
+#include "EngineCore/Log.hpp"
+#include "EngineCore/Render/OpenGL/Framebuffer.hpp"
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+#include "EngineCore/Render/OpenGL/GpuResourceRegistry.hpp"
+#include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
+
+namespace Engine {
+
+	FrameGraphResource FrameGraph::PassBuilder::create(const std::string& name, const FrameGraphTextureDesc& desc) {
+		Resource& resource = m_graph.m_resources.emplace_back();
+		resource.name = name;
+		resource.desc = desc;
+		return static_cast<FrameGraphResource>(m_graph.m_resources.size() - 1);
+	}
+
+	FrameGraphResource FrameGraph::PassBuilder::read(const FrameGraphResource resource, const EAccess access) {
+		if (access == EAccess::RenderTarget) {
+			LOG_ERR("[FrameGraph] Pass '{}' reads '{}' as a render target", m_graph.m_passes[m_pass].name, m_graph.m_resources[resource].name);
+		}
+		m_graph.m_passes[m_pass].reads.push_back({ resource, access });
+		return resource;
+	}
+
+	FrameGraphResource FrameGraph::PassBuilder::write(const FrameGraphResource resource, const EAccess access) {
+		if (access == EAccess::Sampled) {
+			LOG_ERR("[FrameGraph] Pass '{}' writes '{}' as a sampled texture", m_graph.m_passes[m_pass].name, m_graph.m_resources[resource].name);
+		}
+		m_graph.m_passes[m_pass].writes.push_back({ resource, access });
+		m_graph.m_resources[resource].writers.push_back(m_pass);
+		return resource;
+	}
+
+	void FrameGraph::PassBuilder::sideEffect() noexcept {
+		m_graph.m_passes[m_pass].bSideEffect = true;
+	}
+
+	FrameGraph::~FrameGraph() {
+		destroyFramebuffers();
+		destroyQueries();
+		for (const PhysicalTexture& texture : m_pool) {
+			GpuDeletionQueue::release(GpuResourceCategory::Texture, texture.id);
+		}
+	}
+
+	void FrameGraph::reset() {
+		destroyFramebuffers();
+		m_passes.clear();
+		m_resources.clear();
+		m_order.clear();
+		m_timings.clear();
+		m_bCompiled = false;
+	}
+
+	FrameGraphResource FrameGraph::importTexture(const std::string& name, const unsigned int id, const FrameGraphTextureDesc& desc) {
+		Resource& resource = m_resources.emplace_back();
+		resource.name = name;
+		resource.desc = desc;
+		resource.bImported = true;
+		resource.id = id;
+		return static_cast<FrameGraphResource>(m_resources.size() - 1);
+	}
+
+	FrameGraphResource FrameGraph::importBackbuffer(const std::string& name, const uint32_t width, const uint32_t height) {
+		const FrameGraphResource resource = importTexture(name, 0, { width, height, GL_RGBA8 });
+		m_resources[resource].bBackbuffer = true;
+		return resource;
+	}
+
+	FrameGraph::PassBuilder FrameGraph::addPass(const std::string& name, ExecuteFunc execute) {
+		Pass& pass = m_passes.emplace_back();
+		pass.name = name;
+		pass.execute = std::move(execute);
+		return PassBuilder(*this, static_cast<uint32_t>(m_passes.size() - 1));
+	}
+
+	void FrameGraph::compile() {
+		const auto startTime = std::chrono::steady_clock::now();
+
+		destroyFramebuffers();
+		destroyQueries();
+
+		cullPasses();
+		if (!sortPasses()) {
+			LOG_ERR("[FrameGraph] Dependency cycle, passes run in declaration order");
+			m_order.clear();
+			for (uint32_t pass = 0; pass < m_passes.size(); ++pass) {
+				if (!m_passes[pass].bCulled) {
+					m_order.push_back(pass);
+				}
+			}
+		}
+		assignTextures();
+		computeBarriers();
+		createFramebuffers();
+
+		m_timings.resize(m_order.size());
+		for (size_t i = 0; i < m_order.size(); ++i) {
+			m_timings[i].name = m_passes[m_order[i]].name;
+			m_timings[i].cpuMs = 0.f;
+			m_timings[i].gpuMs = 0.f;
+		}
+		m_queries.resize(QueryFrames * 2 * m_order.size());
+		if (!m_queries.empty()) {
+			glGenQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+		}
+		m_frameIndex = 0;
+		m_bCompiled = true;
+
+		m_stats.passes = static_cast<uint32_t>(m_passes.size());
+		m_stats.culledPasses = static_cast<uint32_t>(m_passes.size() - m_order.size());
+		m_stats.compileMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	void FrameGraph::cullPasses() {
+		// Обход от нужных проходов к писателям ресурсов, которые они читают.
+		std::vector<uint32_t> stack;
+		for (uint32_t pass = 0; pass < m_passes.size(); ++pass) {
+			Pass& info = m_passes[pass];
+			info.bCulled = true;
+			bool bRoot = info.bSideEffect;
+			for (const Access& write : info.writes) {
+				bRoot |= m_resources[write.resource].bImported;
+			}
+			if (bRoot) {
+				info.bCulled = false;
+				stack.push_back(pass);
+			}
+		}
+
+		while (!stack.empty()) {
+			const uint32_t pass = stack.back();
+			stack.pop_back();
+			for (const Access& read : m_passes[pass].reads) {
+				for (const uint32_t writer : m_resources[read.resource].writers) {
+					if (m_passes[writer].bCulled) {
+						m_passes[writer].bCulled = false;
+						stack.push_back(writer);
+					}
+				}
+			}
+		}
+	}
+
+	bool FrameGraph::sortPasses() {
+		// Рёбра: писатели ресурса - по порядку объявления, читатели - после всех писателей.
+		const size_t passCount = m_passes.size();
+		std::vector<std::vector<uint32_t>> edges(passCount);
+		std::vector<uint32_t> inDegree(passCount, 0);
+		const auto addEdge = [&](const uint32_t from, const uint32_t to) {
+			if (from != to && !m_passes[from].bCulled && !m_passes[to].bCulled) {
+				edges[from].push_back(to);
+				++inDegree[to];
+			}
+		};
+
+		for (const Resource& resource : m_resources) {
+			for (size_t i = 1; i < resource.writers.size(); ++i) {
+				addEdge(resource.writers[i - 1], resource.writers[i]);
+			}
+		}
+		for (uint32_t pass = 0; pass < passCount; ++pass) {
+			for (const Access& read : m_passes[pass].reads) {
+				const std::vector<uint32_t>& writers = m_resources[read.resource].writers;
+				// Проход, который и читает, и пишет ресурс, уже стоит в цепочке писателей.
+				const bool bAlsoWrites = std::find(writers.begin(), writers.end(), pass) != writers.end();
+				for (const uint32_t writer : writers) {
+					if (bAlsoWrites && writer > pass) {
+						break;
+					}
+					addEdge(writer, pass);
+				}
+			}
+		}
+
+		// Кан с приоритетом порядка объявления.
+		std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ready;
+		uint32_t activeCount = 0;
+		for (uint32_t pass = 0; pass < passCount; ++pass) {
+			if (!m_passes[pass].bCulled) {
+				++activeCount;
+				if (inDegree[pass] == 0) {
+					ready.push(pass);
+				}
+			}
+		}
+
+		m_order.clear();
+		while (!ready.empty()) {
+			const uint32_t pass = ready.top();
+			ready.pop();
+			m_order.push_back(pass);
+			for (const uint32_t next : edges[pass]) {
+				if (--inDegree[next] == 0) {
+					ready.push(next);
+				}
+			}
+		}
+		return m_order.size() == activeCount;
+	}
+
+	void FrameGraph::assignTextures() {
+		// Время жизни временных ресурсов в позициях порядка выполнения.
+		for (Resource& resource : m_resources) {
+			resource.firstUse = UINT32_MAX;
+			resource.lastUse = 0;
+		}
+		for (uint32_t position = 0; position < m_order.size(); ++position) {
+			const Pass& pass = m_passes[m_order[position]];
+			for (const std::vector<Access>* pAccesses : { &pass.reads, &pass.writes }) {
+				for (const Access& access : *pAccesses) {
+					Resource& resource = m_resources[access.resource];
+					resource.firstUse = std::min(resource.firstUse, position);
+					resource.lastUse = std::max(resource.lastUse, position);
+				}
+			}
+		}
+
+		std::vector<uint32_t> transient;
+		for (uint32_t i = 0; i < m_resources.size(); ++i) {
+			if (!m_resources[i].bImported && m_resources[i].firstUse != UINT32_MAX) {
+				transient.push_back(i);
+			}
+		}
+		std::sort(transient.begin(), transient.end(), [this](const uint32_t a, const uint32_t b) {
+			return m_resources[a].firstUse < m_resources[b].firstUse;
+		});
+
+		for (PhysicalTexture& texture : m_pool) {
+			texture.busyUntil = 0;
+			texture.bUsed = false;
+		}
+
+		m_stats.transientTextures = static_cast<uint32_t>(transient.size());
+		m_stats.transientBytes = 0;
+		for (const uint32_t index : transient) {
+			Resource& resource = m_resources[index];
+			const uint64_t bytes = static_cast<uint64_t>(resource.desc.width) * resource.desc.height * getAttachmentBytesPerPixel(resource.desc.format);
+			m_stats.transientBytes += bytes;
+
+			// Свободная текстура того же описания: её прошлый владелец уже не используется.
+			PhysicalTexture* pTexture = nullptr;
+			for (PhysicalTexture& texture : m_pool) {
+				if (texture.desc == resource.desc && texture.busyUntil <= resource.firstUse) {
+					pTexture = &texture;
+					break;
+				}
+			}
+			if (!pTexture) {
+				PhysicalTexture& texture = m_pool.emplace_back();
+				texture.desc = resource.desc;
+				texture.bytes = bytes;
+				texture.id = createAttachmentTexture(resource.desc.format, resource.desc.width, resource.desc.height, "frame graph");
+				pTexture = &texture;
+			}
+
+			pTexture->bUsed = true;
+			pTexture->busyUntil = resource.lastUse + 1;
+			resource.id = pTexture->id;
+			GpuResourceRegistry::setLabel(GpuResourceCategory::Texture, pTexture->id, resource.name);
+		}
+
+		// Текстуры, не нужные новому графу, удаляются.
+		m_stats.physicalTextures = 0;
+		m_stats.physicalBytes = 0;
+		for (size_t i = 0; i < m_pool.size();) {
+			if (!m_pool[i].bUsed) {
+				GpuDeletionQueue::release(GpuResourceCategory::Texture, m_pool[i].id);
+				m_pool[i] = m_pool.back();
+				m_pool.pop_back();
+				continue;
+			}
+			++m_stats.physicalTextures;
+			m_stats.physicalBytes += m_pool[i].bytes;
+			++i;
+		}
+	}
+
+	void FrameGraph::computeBarriers() {
+		// Запись через image load/store видна другим способам доступа только после барьера.
+		std::vector<bool> imageWritten(m_resources.size(), false);
+		m_stats.barriers = 0;
+		for (const uint32_t passIndex : m_order) {
+			Pass& pass = m_passes[passIndex];
+			pass.barrierBits = 0;
+			for (const Access& read : pass.reads) {
+				if (imageWritten[read.resource]) {
+					pass.barrierBits |= read.access == EAccess::Image ? GL_SHADER_IMAGE_ACCESS_BARRIER_BIT : GL_TEXTURE_FETCH_BARRIER_BIT;
+				}
+			}
+			for (const Access& write : pass.writes) {
+				if (imageWritten[write.resource]) {
+					pass.barrierBits |= write.access == EAccess::Image ? GL_SHADER_IMAGE_ACCESS_BARRIER_BIT : GL_FRAMEBUFFER_BARRIER_BIT;
+				}
+			}
+			for (const Access& read : pass.reads) {
+				imageWritten[read.resource] = false;
+			}
+			for (const Access& write : pass.writes) {
+				imageWritten[write.resource] = write.access == EAccess::Image;
+			}
+			if (pass.barrierBits != 0) {
+				++m_stats.barriers;
+			}
+		}
+	}
+
+	void FrameGraph::createFramebuffers() {
+		for (const uint32_t passIndex : m_order) {
+			Pass& pass = m_passes[passIndex];
+			pass.framebuffer = 0;
+			pass.bRenderTarget = false;
+
+			std::vector<const Resource*> colors;
+			const Resource* pDepth = nullptr;
+			bool bBackbuffer = false;
+			for (const Access& write : pass.writes) {
+				if (write.access != EAccess::RenderTarget) {
+					continue;
+				}
+				const Resource& resource = m_resources[write.resource];
+				pass.bRenderTarget = true;
+				pass.viewportWidth = resource.desc.width;
+				pass.viewportHeight = resource.desc.height;
+				if (resource.bBackbuffer) {
+					bBackbuffer = true;
+				}
+				else if (isDepthFormat(resource.desc.format)) {
+					pDepth = &resource;
+				}
+				else {
+					colors.push_back(&resource);
+				}
+			}
+			if (bBackbuffer) {
+				if (!colors.empty() || pDepth) {
+					LOG_ERR("[FrameGraph] Pass '{}' mixes the backbuffer with other render targets", pass.name);
+				}
+				continue;
+			}
+			if (!pass.bRenderTarget) {
+				continue;
+			}
+
+			GLenum drawBuffers[8];
+			const GLsizei colorCount = static_cast<GLsizei>(std::min<size_t>(colors.size(), 8));
+			for (GLsizei i = 0; i < colorCount; ++i) {
+				drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+			}
+			const GLenum depthAttachment = pDepth && hasStencil(pDepth->desc.format) ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+
+			unsigned int framebuffer = 0;
+			GLenum status = GL_FRAMEBUFFER_COMPLETE;
+			if (hasDirectStateAccess()) {
+				glCreateFramebuffers(1, &framebuffer);
+				for (GLsizei i = 0; i < colorCount; ++i) {
+					glNamedFramebufferTexture(framebuffer, drawBuffers[i], colors[i]->id, 0);
+				}
+				if (pDepth) {
+					glNamedFramebufferTexture(framebuffer, depthAttachment, pDepth->id, 0);
+				}
+				glNamedFramebufferDrawBuffers(framebuffer, colorCount, drawBuffers);
+				status = glCheckNamedFramebufferStatus(framebuffer, GL_FRAMEBUFFER);
+			}
+			else {
+				glGenFramebuffers(1, &framebuffer);
+				glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+				for (GLsizei i = 0; i < colorCount; ++i) {
+					glFramebufferTexture(GL_FRAMEBUFFER, drawBuffers[i], colors[i]->id, 0);
+				}
+				if (pDepth) {
+					glFramebufferTexture(GL_FRAMEBUFFER, depthAttachment, pDepth->id, 0);
+				}
+				glDrawBuffers(colorCount, drawBuffers);
+				status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+				glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			}
+
+			if (status != GL_FRAMEBUFFER_COMPLETE) {
+				LOG_ERR("[FrameGraph] Framebuffer of pass '{}' is incomplete (0x{:x})", pass.name, status);
+			}
+
+			GpuResourceRegistry::add(GpuResourceCategory::Framebuffer, framebuffer, 0, "frame graph");
+			GpuResourceRegistry::setLabel(GpuResourceCategory::Framebuffer, framebuffer, pass.name);
+			m_framebuffers.push_back(framebuffer);
+			pass.framebuffer = framebuffer;
+		}
+	}
+
+	void FrameGraph::destroyFramebuffers() {
+		for (const unsigned int framebuffer : m_framebuffers) {
+			GpuDeletionQueue::release(GpuResourceCategory::Framebuffer, framebuffer);
+		}
+		m_framebuffers.clear();
+	}
+
+	void FrameGraph::destroyQueries() {
+		if (!m_queries.empty()) {
+			glDeleteQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+			m_queries.clear();
+		}
+	}
+
+	void FrameGraph::execute() {
+		if (!m_bCompiled) {
+			compile();
+		}
+
+		const size_t passCount = m_order.size();
+		const size_t querySet = (m_frameIndex % QueryFrames) * 2 * passCount;
+
+		// Отметки времени, записанные QueryFrames кадров назад, читаются без ожидания.
+		if (m_frameIndex >= QueryFrames && passCount > 0) {
+			GLint bAvailable = 0;
+			glGetQueryObjectiv(m_queries[querySet + 2 * passCount - 1], GL_QUERY_RESULT_AVAILABLE, &bAvailable);
+			if (bAvailable) {
+				for (size_t i = 0; i < passCount; ++i) {
+					GLuint64 begin = 0;
+					GLuint64 end = 0;
+					glGetQueryObjectui64v(m_queries[querySet + 2 * i], GL_QUERY_RESULT, &begin);
+					glGetQueryObjectui64v(m_queries[querySet + 2 * i + 1], GL_QUERY_RESULT, &end);
+					m_timings[i].gpuMs = static_cast<float>(end - begin) * 1e-6f;
+				}
+			}
+		}
+
+		for (size_t i = 0; i < passCount; ++i) {
+			const Pass& pass = m_passes[m_order[i]];
+			if (pass.barrierBits != 0) {
+				glMemoryBarrier(pass.barrierBits);
+			}
+			if (pass.bRenderTarget) {
+				glBindFramebuffer(GL_FRAMEBUFFER, pass.framebuffer);
+				glViewport(0, 0, static_cast<GLsizei>(pass.viewportWidth), static_cast<GLsizei>(pass.viewportHeight));
+			}
+
+			glQueryCounter(m_queries[querySet + 2 * i], GL_TIMESTAMP);
+			const auto startTime = std::chrono::steady_clock::now();
+			if (pass.execute) {
+				pass.execute(*this);
+			}
+			m_timings[i].cpuMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+			glQueryCounter(m_queries[querySet + 2 * i + 1], GL_TIMESTAMP);
+		}
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		++m_frameIndex;
+	}
+
+	unsigned int FrameGraph::getTexture(const FrameGraphResource resource) const noexcept {
+		return resource < m_resources.size() ? m_resources[resource].id : 0;
+	}
+
+	void FrameGraph::drawImGuiPanel() {
+		ImGui::Begin("Граф кадра");
+
+		ImGui::Text("Проходов: %u (отброшено: %u), барьеров: %u", m_stats.passes, m_stats.culledPasses, m_stats.barriers);
+		ImGui::Text("Временных текстур: %u -> %u после совмещения", m_stats.transientTextures, m_stats.physicalTextures);
+		ImGui::Text("Видеопамять: %.2f МБ -> %.2f МБ (сэкономлено %.2f МБ)",
+			m_stats.transientBytes / (1024.0 * 1024.0),
+			m_stats.physicalBytes / (1024.0 * 1024.0),
+			(m_stats.transientBytes - m_stats.physicalBytes) / (1024.0 * 1024.0));
+		ImGui::Text("Компиляция: %.3f мс", m_stats.compileMs);
+
+		if (ImGui::BeginTable("passes", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+			ImGui::TableSetupColumn("Проход");
+			ImGui::TableSetupColumn("CPU, мс");
+			ImGui::TableSetupColumn("GPU, мс");
+			ImGui::TableHeadersRow();
+			for (const FrameGraphPassTiming& timing : m_timings) {
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(timing.name.c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", timing.cpuMs);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", timing.gpuMs);
+			}
+			ImGui::EndTable();
+		}
+
+		ImGui::End();
+	}
+
+} // namespace Engine
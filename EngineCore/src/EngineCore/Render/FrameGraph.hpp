@@ -0,0 +1,259 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Идентификатор ресурса в `FrameGraph`.
+	using FrameGraphResource = uint32_t;
+
+	constexpr FrameGraphResource InvalidFrameGraphResource = UINT32_MAX;
+
+	/**
+	 * @internal
+	 * @brief Описание текстуры графа кадра.
+	 */
+	struct FrameGraphTextureDesc {
+		uint32_t	width	= 0;
+		uint32_t	height	= 0;
+		uint32_t	format	= 0;	///< Внутренний формат (GLenum), например GL_RGBA16F или GL_DEPTH24_STENCIL8.
+
+		bool operator==(const FrameGraphTextureDesc& rhs) const noexcept {
+			return width == rhs.width && height == rhs.height && format == rhs.format;
+		}
+	};
+
+	/**
+	 * @internal
+	 * @brief Статистика `FrameGraph`.
+	 */
+	struct FrameGraphStats {
+		uint32_t	passes				= 0;	///< Проходов добавлено.
+		uint32_t	culledPasses		= 0;	///< Из них отброшено (результат никто не читает).
+		uint32_t	transientTextures	= 0;	///< Временных текстур объявлено.
+		uint32_t	physicalTextures	= 0;	///< Текстур OpenGL создано под них.
+		uint64_t	transientBytes		= 0;	///< Объём временных текстур без совмещения.
+		uint64_t	physicalBytes		= 0;	///< Фактический объём после совмещения.
+		uint32_t	barriers			= 0;	///< Вызовов glMemoryBarrier за кадр.
+		float		compileMs			= 0.f;
+	};
+
+	/**
+	 * @internal
+	 * @brief Время одного прохода.
+	 */
+	struct FrameGraphPassTiming {
+		std::string	name;
+		float		cpuMs	= 0.f;	///< Время функции прохода на CPU.
+		float		gpuMs	= 0.f;	///< Время на GPU (по запросам времени, с задержкой в несколько кадров).
+	};
+
+	/**
+	 * @internal
+	 * @brief Граф кадра: проходы рендера с объявленными входами и выходами.
+	 *
+	 * Проход объявляет текстуры, которые читает и пишет. При `compile()` граф:
+	 * - Отбрасывает проходы, чей результат не нужен: нужны проходы с побочным
+	 *   эффектом (`PassBuilder::sideEffect()`), пишущие в импортированные ресурсы
+	 *   (например, в экран) и, рекурсивно, пишущие то, что читают нужные проходы.
+	 * - Упорядочивает проходы: чтение ресурса выполняется после всех записей в него
+	 *   (записи - в порядке объявления), при прочих равных сохраняется порядок объявления.
+	 * - Расставляет барьеры: после записи через image load/store перед чтением
+	 *   вызывается `glMemoryBarrier` с нужными битами. Запись в FBO барьеров
+	 *   в OpenGL не требует.
+	 * - Совмещает временные текстуры: текстуры с одинаковым описанием, время жизни
+	 *   которых (от первого до последнего использующего прохода) не пересекается,
+	 *   получают один объект OpenGL. Поэтому содержимое временной текстуры
+	 *   в начале первого прохода не определено, и проход должен её очистить.
+	 * - Создаёт FBO для проходов, пишущих в render target.
+	 *
+	 * Граф строится один раз и выполняется каждый кадр (`execute()`) без
+	 * выделений памяти. Перестраивается он при изменении структуры
+	 * (например, размера окна): `reset()`, добавление проходов, `compile()`.
+	 * Созданные текстуры переиспользуются между перестроениями.
+	 *
+	 * Пример использования
+	 * @code
+	 * graph.reset();
+	 * const FrameGraphResource backbuffer = graph.importBackbuffer("Backbuffer", width, height);
+	 * FrameGraph::PassBuilder scene = graph.addPass("Scene", [this](const FrameGraph& graph) { drawScene(); });
+	 * m_sceneColor = scene.create("Scene color", { width, height, GL_RGBA16F });
+	 * scene.write(scene.create("Scene depth", { width, height, GL_DEPTH24_STENCIL8 }));
+	 * scene.write(m_sceneColor);
+	 * FrameGraph::PassBuilder tonemap = graph.addPass("Tonemap", [this](const FrameGraph& graph) {
+	 * 	glBindTextureUnit(0, graph.getTexture(m_sceneColor));
+	 * 	drawFullscreenTriangle();
+	 * });
+	 * tonemap.read(m_sceneColor);
+	 * tonemap.write(backbuffer);
+	 * graph.compile();
+	 * // каждый кадр
+	 * graph.execute();
+	 * @endcode
+	 *
+	 * @note Методы вызываются только из потока с контекстом OpenGL.
+	 */
+	class FrameGraph {
+	public:
+		/**
+		 * @internal
+		 * @brief Способ доступа прохода к текстуре.
+		 */
+		enum class EAccess : uint8_t {
+			RenderTarget,	///< Вложение FBO (только запись).
+			Sampled,		///< Выборка в шейдере (только чтение).
+			Image			///< Image load/store (чтение и запись).
+		};
+
+		using ExecuteFunc = std::function<void(const FrameGraph& graph)>;
+
+		/**
+		 * @internal
+		 * @brief Объявление ресурсов прохода.
+		 */
+		class PassBuilder {
+		public:
+			/// @internal
+			/// @brief Объявляет временную текстуру (живёт только внутри графа).
+			FrameGraphResource create(const std::string& name, const FrameGraphTextureDesc& desc);
+
+			/// @internal
+			/// @brief Проход читает ресурс.
+			FrameGraphResource read(FrameGraphResource resource, EAccess access = EAccess::Sampled);
+
+			/// @internal
+			/// @brief Проход пишет в ресурс.
+			FrameGraphResource write(FrameGraphResource resource, EAccess access = EAccess::RenderTarget);
+
+			/// @internal
+			/// @brief Проход не отбрасывается, даже если его результат не читают.
+			void sideEffect() noexcept;
+
+		private:
+			friend class FrameGraph;
+
+			PassBuilder(FrameGraph& graph, uint32_t pass) noexcept : m_graph(graph), m_pass(pass) {}
+
+			FrameGraph&	m_graph;
+			uint32_t	m_pass;
+		};
+
+		FrameGraph() = default;
+		~FrameGraph();
+
+		FrameGraph(const FrameGraph&)				= delete;
+		FrameGraph& operator=(const FrameGraph&)	= delete;
+		FrameGraph(FrameGraph&&)					= delete;
+		FrameGraph& operator=(FrameGraph&&)			= delete;
+
+		/// @internal
+		/// @brief Удаляет проходы и ресурсы (созданные текстуры остаются в пуле).
+		void reset();
+
+		/// @internal
+		/// @brief Импортирует внешнюю текстуру (граф её не создаёт и не совмещает).
+		FrameGraphResource importTexture(const std::string& name, unsigned int id, const FrameGraphTextureDesc& desc);
+
+		/// @internal
+		/// @brief Импортирует экран (FBO 0).
+		FrameGraphResource importBackbuffer(const std::string& name, uint32_t width, uint32_t height);
+
+		/// @internal
+		/// @brief Добавляет проход. Ресурсы прохода объявляются через возвращённый `PassBuilder`.
+		/// @param name Имя прохода (для статистики и отладчиков).
+		/// @param execute Функция, выполняющая проход; FBO и viewport уже установлены.
+		PassBuilder addPass(const std::string& name, ExecuteFunc execute);
+
+		/// @internal
+		/// @brief Отбрасывает лишние проходы, упорядочивает, совмещает текстуры и создаёт FBO.
+		void compile();
+
+		/// @internal
+		/// @brief Выполняет скомпилированный граф.
+		void execute();
+
+		/// @internal
+		/// @brief Идентификатор текстуры OpenGL ресурса (в функции прохода).
+		unsigned int getTexture(FrameGraphResource resource) const noexcept;
+
+		const FrameGraphTextureDesc& getDesc(FrameGraphResource resource) const noexcept { return m_resources[resource].desc; }
+
+		const FrameGraphStats& getStats() const noexcept { return m_stats; }
+		const std::vector<FrameGraphPassTiming>& getPassTimings() const noexcept { return m_timings; }
+
+		/// @internal
+		/// @brief Биты glMemoryBarrier перед `position`-м выполняемым проходом (после `compile()`).
+		uint32_t getBarrierBits(size_t position) const noexcept { return m_passes[m_order[position]].barrierBits; }
+
+		/// @internal
+		/// @brief Рисует ImGui окно с проходами, временем и сэкономленной памятью.
+		void drawImGuiPanel();
+
+	private:
+		struct Access {
+			FrameGraphResource	resource;
+			EAccess				access;
+		};
+
+		struct Pass {
+			std::string				name;
+			ExecuteFunc				execute;
+			std::vector<Access>		reads;
+			std::vector<Access>		writes;
+			bool					bSideEffect		= false;
+			bool					bCulled			= false;
+			uint32_t				barrierBits		= 0;	///< Биты glMemoryBarrier перед проходом.
+			unsigned int			framebuffer		= 0;	///< FBO прохода (0 - экран или нет вложений).
+			bool					bRenderTarget	= false;
+			uint32_t				viewportWidth	= 0;
+			uint32_t				viewportHeight	= 0;
+		};
+
+		struct Resource {
+			std::string				name;
+			FrameGraphTextureDesc	desc;
+			bool					bImported		= false;
+			bool					bBackbuffer		= false;
+			unsigned int			id				= 0;	///< Текстура OpenGL (после `compile()` для временных).
+			std::vector<uint32_t>	writers;				///< Проходы-писатели в порядке объявления.
+			uint32_t				firstUse		= UINT32_MAX;
+			uint32_t				lastUse			= 0;
+		};
+
+		/// Текстура пула, на которую отображаются временные ресурсы.
+		struct PhysicalTexture {
+			FrameGraphTextureDesc	desc;
+			unsigned int			id				= 0;
+			uint64_t				bytes			= 0;
+			uint32_t				busyUntil		= 0;	///< Последний проход текущего владельца + 1.
+			bool					bUsed			= false;
+		};
+
+		void cullPasses();
+		bool sortPasses();
+		void assignTextures();
+		void computeBarriers();
+		void createFramebuffers();
+		void destroyFramebuffers();
+		void destroyQueries();
+
+		std::vector<Pass>				m_passes;
+		std::vector<Resource>			m_resources;
+		std::vector<uint32_t>			m_order;		///< Выполняемые проходы по порядку.
+		std::vector<PhysicalTexture>	m_pool;
+		std::vector<unsigned int>		m_framebuffers;
+
+		static constexpr uint32_t		QueryFrames		= 3;	///< Кадров до чтения запросов времени.
+		std::vector<unsigned int>		m_queries;				///< QueryFrames x (2 x кол-во проходов) отметок времени.
+		uint64_t						m_frameIndex	= 0;
+		bool							m_bCompiled		= false;
+
+		FrameGraphStats					m_stats;
+		std::vector<FrameGraphPassTiming>	m_timings;		///< По проходам из `m_order`.
+	};
+
+} // namespace Engine
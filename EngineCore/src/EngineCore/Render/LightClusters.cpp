@@ -0,0 +1,241 @@
+#include "EngineCore/Render/LightClusters.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#include "EngineCore/Core/JobSystem.hpp"
+
+namespace Engine {
+
+	static constexpr uint32_t LightGrainSize = 256;	///< Источников в задаче перевода в пространство вида.
+
+	/// Запас на округление: плитка или слой на границе не должны теряться.
+	static constexpr float BoundsEpsilon = 1e-4f;
+
+	/// Квадрат расстояния от точки до AABB.
+	static inline float distanceSquared(const Vec3& point, const Vec3& boxMin, const Vec3& boxMax) noexcept {
+		const float dx = std::max(std::max(boxMin.x - point.x, 0.f), point.x - boxMax.x);
+		const float dy = std::max(std::max(boxMin.y - point.y, 0.f), point.y - boxMax.y);
+		const float dz = std::max(std::max(boxMin.z - point.z, 0.f), point.z - boxMax.z);
+		return dx * dx + dy * dy + dz * dz;
+	}
+
+	/// Плитка для координаты NDC в [-1, 1].
+	static inline uint16_t toTile(const float ndc, const uint32_t tileCount) noexcept {
+		const float tile = std::floor((ndc + 1.f) * 0.5f * static_cast<float>(tileCount));
+		return static_cast<uint16_t>(std::clamp(tile, 0.f, static_cast<float>(tileCount - 1)));
+	}
+
+	LightClusterBuilder::LightClusterBuilder(const LightClusterParams& params, JobSystem* pJobSystem)
+		: m_params(params)
+		, m_pJobSystem(pJobSystem)
+	{
+		m_clusterBounds.resize(static_cast<size_t>(getClusterCount()) * 2);
+		m_clusters.resize(getClusterCount());
+		m_slices.resize(params.slices);
+	}
+
+	uint32_t LightClusterBuilder::getSlice(const float depth) const noexcept {
+		const float slice = std::floor(std::log(depth) * m_sliceScale + m_sliceBias);
+		return static_cast<uint32_t>(std::clamp(slice, 0.f, static_cast<float>(m_params.slices - 1)));
+	}
+
+	void LightClusterBuilder::updateClusterBounds(const float scaleX, const float scaleY, const float zNear, const float zFar) {
+		m_scaleX = scaleX;
+		m_scaleY = scaleY;
+		m_zNear = zNear;
+		m_zFar = zFar;
+		m_sliceScale = static_cast<float>(m_params.slices) / std::log(zFar / zNear);
+		m_sliceBias = -std::log(zNear) * m_sliceScale;
+
+		const float depthRatio = zFar / zNear;
+		for (uint32_t slice = 0; slice < m_params.slices; ++slice) {
+			const float depthBegin = zNear * std::pow(depthRatio, static_cast<float>(slice) / m_params.slices);
+			const float depthEnd = zNear * std::pow(depthRatio, static_cast<float>(slice + 1) / m_params.slices);
+
+			for (uint32_t y = 0; y < m_params.tilesY; ++y) {
+				const float ndcBeginY = -1.f + 2.f * y / m_params.tilesY;
+				const float ndcEndY = -1.f + 2.f * (y + 1) / m_params.tilesY;
+
+				for (uint32_t x = 0; x < m_params.tilesX; ++x) {
+					const float ndcBeginX = -1.f + 2.f * x / m_params.tilesX;
+					const float ndcEndX = -1.f + 2.f * (x + 1) / m_params.tilesX;
+
+					// Грани плитки - плоскости через камеру, поэтому крайние точки лежат в углах.
+					Vec3& boxMin = m_clusterBounds[2 * ((slice * m_params.tilesY + y) * m_params.tilesX + x)];
+					Vec3& boxMax = m_clusterBounds[2 * ((slice * m_params.tilesY + y) * m_params.tilesX + x) + 1];
+					boxMin.x = std::min(ndcBeginX * depthBegin, ndcBeginX * depthEnd) / scaleX;
+					boxMax.x = std::max(ndcEndX * depthBegin, ndcEndX * depthEnd) / scaleX;
+					boxMin.y = std::min(ndcBeginY * depthBegin, ndcBeginY * depthEnd) / scaleY;
+					boxMax.y = std::max(ndcEndY * depthBegin, ndcEndY * depthEnd) / scaleY;
+					boxMin.z = -depthEnd;
+					boxMax.z = -depthBegin;
+				}
+			}
+		}
+	}
+
+	LightClusterBuilder::LightRange LightClusterBuilder::computeRange(const PointLight& light) const noexcept {
+		LightRange range = { 0, 0, 0, 0, 1, 0 };
+
+		const float radius = light.radius;
+		float depthMin = -light.position[2] - radius;
+		float depthMax = -light.position[2] + radius;
+		if (depthMax < m_zNear || depthMin > m_zFar) {
+			return range;
+		}
+		depthMin = std::max(depthMin, m_zNear);
+		depthMax = std::min(depthMax, m_zFar);
+
+		// Проекция AABB сферы: x / depth минимален на ближней глубине для x < 0 и на дальней для x > 0.
+		const auto project = [depthMin, depthMax](const float low, const float high, const float scale, float& ndcMin, float& ndcMax) {
+			ndcMin = scale * (low < 0.f ? low / depthMin : low / depthMax) - BoundsEpsilon;
+			ndcMax = scale * (high < 0.f ? high / depthMax : high / depthMin) + BoundsEpsilon;
+		};
+
+		float ndcMinX, ndcMaxX, ndcMinY, ndcMaxY;
+		project(light.position[0] - radius, light.position[0] + radius, m_scaleX, ndcMinX, ndcMaxX);
+		project(light.position[1] - radius, light.position[1] + radius, m_scaleY, ndcMinY, ndcMaxY);
+		if (ndcMaxX < -1.f || ndcMinX > 1.f || ndcMaxY < -1.f || ndcMinY > 1.f) {
+			return range;
+		}
+
+		range.tileBeginX = toTile(ndcMinX, m_params.tilesX);
+		range.tileEndX = toTile(ndcMaxX, m_params.tilesX);
+		range.tileBeginY = toTile(ndcMinY, m_params.tilesY);
+		range.tileEndY = toTile(ndcMaxY, m_params.tilesY);
+		range.sliceBegin = static_cast<uint16_t>(getSlice(depthMin * (1.f - BoundsEpsilon)));
+		range.sliceEnd = static_cast<uint16_t>(getSlice(depthMax * (1.f + BoundsEpsilon)));
+		return range;
+	}
+
+	void LightClusterBuilder::buildSlice(const uint32_t slice) {
+		const uint32_t tilesPerSlice = m_params.tilesX * m_params.tilesY;
+		LightCluster* pClusters = m_clusters.data() + static_cast<size_t>(slice) * tilesPerSlice;
+		const Vec3* pBounds = m_clusterBounds.data() + static_cast<size_t>(slice) * tilesPerSlice * 2;
+		SliceLists& lists = m_slices[slice];
+
+		lists.refs.clear();
+		for (uint32_t tile = 0; tile < tilesPerSlice; ++tile) {
+			pClusters[tile] = LightCluster();
+		}
+
+		// 1. Кандидаты из диапазона источника проверяются сферой против AABB кластера.
+		const uint32_t lightCount = static_cast<uint32_t>(m_viewLights.size());
+		for (uint32_t light = 0; light < lightCount; ++light) {
+			const LightRange& range = m_ranges[light];
+			if (slice < range.sliceBegin || slice > range.sliceEnd) {
+				continue;
+			}
+
+			const PointLight& viewLight = m_viewLights[light];
+			const Vec3 center(viewLight.position[0], viewLight.position[1], viewLight.position[2]);
+			const float radiusSquared = viewLight.radius * viewLight.radius;
+			for (uint32_t y = range.tileBeginY; y <= range.tileEndY; ++y) {
+				for (uint32_t x = range.tileBeginX; x <= range.tileEndX; ++x) {
+					const uint32_t tile = y * m_params.tilesX + x;
+					if (distanceSquared(center, pBounds[2 * tile], pBounds[2 * tile + 1]) <= radiusSquared) {
+						lists.refs.push_back({ tile, light });
+						++pClusters[tile].count;
+					}
+				}
+			}
+		}
+
+		// 2. Сортировка подсчётом: источники внутри кластера остаются по возрастанию.
+		uint32_t offset = 0;
+		for (uint32_t tile = 0; tile < tilesPerSlice; ++tile) {
+			pClusters[tile].offset = offset;
+			offset += pClusters[tile].count;
+		}
+
+		lists.indices.resize(lists.refs.size());
+		for (const ClusterLightRef& ref : lists.refs) {
+			LightCluster& cluster = pClusters[ref.tile];
+			// Смещение временно служит курсором записи и возвращается ниже.
+			lists.indices[cluster.offset++] = ref.light;
+		}
+		for (uint32_t tile = 0; tile < tilesPerSlice; ++tile) {
+			pClusters[tile].offset -= pClusters[tile].count;
+		}
+	}
+
+	void LightClusterBuilder::build(const Mat4& view, const Mat4& projection, const PointLight* pLights, const uint32_t lightCount) {
+		const auto startTime = std::chrono::steady_clock::now();
+
+		// Плоскости отсечения из Mat4::perspective(): m[10] = (f + n) / (n - f), m[14] = 2fn / (n - f).
+		const float zNear = projection.m[14] / (projection.m[10] - 1.f);
+		const float zFar = projection.m[14] / (projection.m[10] + 1.f);
+		if (projection.m[0] != m_scaleX || projection.m[5] != m_scaleY || zNear != m_zNear || zFar != m_zFar) {
+			updateClusterBounds(projection.m[0], projection.m[5], zNear, zFar);
+		}
+
+		const auto parallelFor = [this](const uint32_t count, const uint32_t grainSize, const JobSystem::RangeJob& func) {
+			if (m_pJobSystem && count > grainSize) {
+				m_pJobSystem->parallelFor(count, grainSize, func);
+			}
+			else {
+				func(0, count);
+			}
+		};
+
+		// 1. Пространство вида и диапазоны кластеров.
+		m_viewLights.resize(lightCount);
+		m_ranges.resize(lightCount);
+		parallelFor(lightCount, LightGrainSize, [&](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				const PointLight& light = pLights[i];
+				const Vec3 position = view.transformPoint({ light.position[0], light.position[1], light.position[2] });
+
+				PointLight& viewLight = m_viewLights[i];
+				viewLight = light;
+				viewLight.position[0] = position.x;
+				viewLight.position[1] = position.y;
+				viewLight.position[2] = position.z;
+				m_ranges[i] = computeRange(viewLight);
+			}
+		});
+
+		// 2. Списки слоёв.
+		parallelFor(m_params.slices, 1, [this](const uint32_t begin, const uint32_t end) {
+			for (uint32_t slice = begin; slice < end; ++slice) {
+				buildSlice(slice);
+			}
+		});
+
+		// 3. Общий массив индексов.
+		uint32_t indexCount = 0;
+		for (SliceLists& lists : m_slices) {
+			lists.base = indexCount;
+			indexCount += static_cast<uint32_t>(lists.indices.size());
+		}
+		m_lightIndices.resize(indexCount);
+
+		const uint32_t tilesPerSlice = m_params.tilesX * m_params.tilesY;
+		parallelFor(m_params.slices, 1, [this, tilesPerSlice](const uint32_t begin, const uint32_t end) {
+			for (uint32_t slice = begin; slice < end; ++slice) {
+				const SliceLists& lists = m_slices[slice];
+				LightCluster* pClusters = m_clusters.data() + static_cast<size_t>(slice) * tilesPerSlice;
+				for (uint32_t tile = 0; tile < tilesPerSlice; ++tile) {
+					pClusters[tile].offset += lists.base;
+				}
+				if (!lists.indices.empty()) {
+					std::memcpy(m_lightIndices.data() + lists.base, lists.indices.data(), lists.indices.size() * sizeof(uint32_t));
+				}
+			}
+		});
+
+		m_stats.lightCount = lightCount;
+		m_stats.visibleLights = static_cast<uint32_t>(std::count_if(m_ranges.begin(), m_ranges.end(),
+			[](const LightRange& range) { return range.sliceBegin <= range.sliceEnd; }));
+		m_stats.indexCount = indexCount;
+		m_stats.maxLightsPerCluster = 0;
+		for (const LightCluster& cluster : m_clusters) {
+			m_stats.maxLightsPerCluster = std::max(m_stats.maxLightsPerCluster, cluster.count);
+		}
+		m_stats.buildMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+} // namespace Engine
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "EngineCore/Math.hpp"
+
+namespace Engine {
+
+	class JobSystem;
+
+	/**
+	 * @internal
+	 * @brief Точечный источник света (std430, 32 байта).
+	 *
+	 * Совпадает со структурой `PointLight` в `ClusteredLighting::ShaderSource`.
+	 * В `LightClusterBuilder` передаются мировые координаты, на GPU уходят координаты вида.
+	 */
+	struct PointLight {
+		float		position[3];
+		float		radius;			///< Дальше радиуса источник не светит.
+		float		color[3];
+		float		intensity;
+	};
+
+	static_assert(sizeof(PointLight) == 32, "PointLight must match the std430 layout");
+
+	/**
+	 * @internal
+	 * @brief Размер сетки кластеров.
+	 *
+	 * Экран делится на `tilesX * tilesY` плиток, глубина между ближней и дальней
+	 * плоскостями - на `slices` слоёв, толщина которых растёт экспоненциально,
+	 * чтобы кластеры были близки к кубам на любом расстоянии.
+	 */
+	struct LightClusterParams {
+		uint32_t	tilesX	= 16;
+		uint32_t	tilesY	= 9;
+		uint32_t	slices	= 24;
+	};
+
+	/**
+	 * @internal
+	 * @brief Список источников кластера: `count` индексов начиная с `offset`.
+	 */
+	struct LightCluster {
+		uint32_t	offset	= 0;
+		uint32_t	count	= 0;
+	};
+
+	/**
+	 * @internal
+	 * @brief Статистика `LightClusterBuilder::build()`.
+	 */
+	struct LightClusterStats {
+		uint32_t	lightCount			= 0;
+		uint32_t	visibleLights		= 0;	///< Пересекают пирамиду видимости (консервативно).
+		uint32_t	indexCount			= 0;	///< Суммарная длина списков.
+		uint32_t	maxLightsPerCluster	= 0;
+		float		buildMs				= 0.f;
+	};
+
+	/**
+	 * @internal
+	 * @brief Распределяет точечные источники по кластерам пирамиды видимости.
+	 *
+	 * 1. Источники переводятся в пространство вида, для каждого по сфере
+	 *    консервативно находится диапазон плиток и слоёв;
+	 * 2. слои обрабатываются параллельно в `JobSystem`: каждый кандидат проверяется
+	 *    пересечением сферы с AABB кластера, списки слоя собираются сортировкой подсчётом;
+	 * 3. списки слоёв склеиваются в один массив индексов.
+	 *
+	 * Индексы внутри кластера идут по возрастанию, результат не зависит от числа потоков.
+	 * Фрагментный шейдер по `gl_FragCoord` и глубине находит свой кластер и
+	 * перебирает только его список, поэтому стоимость фрагмента зависит от числа
+	 * источников рядом с ним, а не от общего числа.
+	 *
+	 * Пример использования
+	 * @code
+	 * LightClusterBuilder builder({}, &jobSystem);
+	 * builder.build(camera.view, camera.projection, lights.data(), lights.size());
+	 * // builder.getClusters(), builder.getLightIndices(), builder.getViewLights()
+	 * @endcode
+	 */
+	class LightClusterBuilder {
+	public:
+		/// @param params Размер сетки.
+		/// @param pJobSystem Пул потоков (nullptr - в вызывающем потоке).
+		explicit LightClusterBuilder(const LightClusterParams& params = {}, JobSystem* pJobSystem = nullptr);
+
+		/// @internal
+		/// @brief Строит списки источников для кадра.
+		/// @param view Матрица вида.
+		/// @param projection Перспективная проекция (`Mat4::perspective()`), из неё берутся
+		/// угол обзора и плоскости отсечения.
+		/// @param pLights Источники в мировых координатах.
+		/// @param lightCount Число источников.
+		void build(const Mat4& view, const Mat4& projection, const PointLight* pLights, uint32_t lightCount);
+
+		/// @internal
+		/// @brief Номер слоя для глубины `depth` (расстояние вдоль оси взгляда), как в шейдере.
+		uint32_t getSlice(float depth) const noexcept;
+
+		const LightClusterParams& getParams() const noexcept { return m_params; }
+		uint32_t getClusterCount() const noexcept { return m_params.tilesX * m_params.tilesY * m_params.slices; }
+
+		/// @internal
+		/// @brief Кластеры в порядке (слой, плитка Y, плитка X).
+		const std::vector<LightCluster>& getClusters() const noexcept { return m_clusters; }
+		const std::vector<uint32_t>& getLightIndices() const noexcept { return m_lightIndices; }
+
+		/// @internal
+		/// @brief Источники в пространстве вида, индексы списков ссылаются на них.
+		const std::vector<PointLight>& getViewLights() const noexcept { return m_viewLights; }
+
+		/// @internal
+		/// @brief `slices / ln(far / near)` и `-ln(near) * sliceScale`: слой = `ln(depth) * scale + bias`.
+		float getSliceScale() const noexcept { return m_sliceScale; }
+		float getSliceBias() const noexcept { return m_sliceBias; }
+
+		const LightClusterStats& getStats() const noexcept { return m_stats; }
+
+	private:
+		/// Консервативный диапазон кластеров источника (включительно); `sliceBegin > sliceEnd` - не виден.
+		struct LightRange {
+			uint16_t	tileBeginX, tileEndX;
+			uint16_t	tileBeginY, tileEndY;
+			uint16_t	sliceBegin, sliceEnd;
+		};
+
+		/// Пара (кластер внутри слоя, источник) до сортировки подсчётом.
+		struct ClusterLightRef {
+			uint32_t	tile;
+			uint32_t	light;
+		};
+
+		/// Списки одного слоя до склейки: смещения его кластеров отсчитываются от начала `indices`.
+		struct SliceLists {
+			std::vector<ClusterLightRef>	refs;
+			std::vector<uint32_t>			indices;
+			uint32_t						base	= 0;	///< Смещение слоя в общем массиве.
+		};
+
+		/// Пересчитывает AABB кластеров при изменении проекции.
+		void updateClusterBounds(float scaleX, float scaleY, float zNear, float zFar);
+		LightRange computeRange(const PointLight& light) const noexcept;
+		void buildSlice(uint32_t slice);
+
+		LightClusterParams				m_params;
+		JobSystem*						m_pJobSystem;
+
+		float							m_scaleX		= 0.f;	///< P00 проекции.
+		float							m_scaleY		= 0.f;	///< P11 проекции.
+		float							m_zNear			= 0.f;
+		float							m_zFar			= 0.f;
+		float							m_sliceScale	= 0.f;
+		float							m_sliceBias		= 0.f;
+		std::vector<Vec3>				m_clusterBounds;		///< Пары min, max в пространстве вида.
+
+		std::vector<PointLight>			m_viewLights;
+		std::vector<LightRange>			m_ranges;
+		std::vector<SliceLists>			m_slices;
+		std::vector<LightCluster>		m_clusters;
+		std::vector<uint32_t>			m_lightIndices;
+		LightClusterStats				m_stats;
+	};
+
+} // namespace Engine
@@ -0,0 +1,455 @@
+#include "EngineCore/Render/MeshLod.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <queue>
+
+#include <imgui/imgui.h>
+
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	/// Суммарная статистика упрощения (цепочки могут строиться из разных потоков).
+	static std::atomic<uint64_t>	s_simplifiedTriangles	= 0;
+	static std::atomic<uint64_t>	s_simplifyMicroseconds	= 0;
+
+	/// Квадрика ошибки: сумма квадратов расстояний до плоскостей (симметричная 4x4).
+	struct Quadric {
+		double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+		double b2 = 0.0, bc = 0.0, bd = 0.0;
+		double c2 = 0.0, cd = 0.0;
+		double d2 = 0.0;
+
+		static Quadric fromPlane(const double a, const double b, const double c, const double d) noexcept {
+			return { a * a, a * b, a * c, a * d, b * b, b * c, b * d, c * c, c * d, d * d };
+		}
+
+		Quadric& operator+=(const Quadric& q) noexcept {
+			a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad;
+			b2 += q.b2; bc += q.bc; bd += q.bd;
+			c2 += q.c2; cd += q.cd;
+			d2 += q.d2;
+			return *this;
+		}
+
+		double evaluate(const float* p) const noexcept {
+			const double x = p[0], y = p[1], z = p[2];
+			const double error =
+				a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+				+ b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+				+ c2 * z * z + 2.0 * cd * z
+				+ d2;
+			return error > 0.0 ? error : 0.0;
+		}
+	};
+
+	/// Кандидат на схлопывание `from` -> `to`; устаревает при изменении любой из вершин.
+	struct Collapse {
+		float		cost;
+		uint32_t	from;
+		uint32_t	to;
+		uint32_t	fromVersion;
+		uint32_t	toVersion;
+
+		bool operator<(const Collapse& rhs) const noexcept { return cost > rhs.cost; }
+	};
+
+	/// Состояние упрощения одного меша.
+	class MeshSimplifier {
+	public:
+		MeshSimplifier(const float* pPositions, size_t vertexCount, size_t stride, const uint32_t* pIndices, size_t indexCount)
+			: m_pPositions(reinterpret_cast<const uint8_t*>(pPositions))
+			, m_stride(stride)
+			, m_triangles(pIndices, pIndices + indexCount)
+			, m_triangleAlive(indexCount / 3, true)
+			, m_quadrics(vertexCount)
+			, m_versions(vertexCount, 0)
+			, m_bLocked(vertexCount, false)
+			, m_vertexTriangles(vertexCount)
+		{
+			m_liveTriangles = indexCount / 3;
+
+			std::vector<uint32_t> degrees(vertexCount, 0);
+			for (const uint32_t vertex : m_triangles) {
+				++degrees[vertex];
+			}
+			for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+				m_vertexTriangles[vertex].reserve(degrees[vertex]);
+			}
+
+			for (uint32_t triangle = 0; triangle < m_liveTriangles; ++triangle) {
+				const uint32_t* pCorners = &m_triangles[triangle * 3];
+				for (uint32_t corner = 0; corner < 3; ++corner) {
+					m_vertexTriangles[pCorners[corner]].push_back(triangle);
+				}
+
+				const float* p0 = position(pCorners[0]);
+				const float* p1 = position(pCorners[1]);
+				const float* p2 = position(pCorners[2]);
+				const Vec3 normal = cross(
+					Vec3(p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]),
+					Vec3(p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2])
+				);
+				const float len = length(normal);
+				if (len == 0.f) {
+					continue;
+				}
+				const Vec3 n = normal * (1.f / len);
+				const Quadric plane = Quadric::fromPlane(n.x, n.y, n.z, -(n.x * p0[0] + n.y * p0[1] + n.z * p0[2]));
+				for (uint32_t corner = 0; corner < 3; ++corner) {
+					m_quadrics[pCorners[corner]] += plane;
+				}
+			}
+			lockOpenEdges();
+		}
+
+		/// Схлопывает рёбра, пока не достигнуто кол-во индексов или ошибка.
+		void run(const size_t targetIndexCount, const float targetError) {
+			const float maxCost = targetError * targetError;
+
+			std::vector<Collapse> initial;
+			initial.reserve(m_triangles.size());
+			for (uint32_t triangle = 0; triangle < m_triangleAlive.size(); ++triangle) {
+				const uint32_t* pCorners = &m_triangles[triangle * 3];
+				for (uint32_t corner = 0; corner < 3; ++corner) {
+					// Внутреннее ребро встречается в двух треугольниках в разных направлениях.
+					const uint32_t a = pCorners[corner];
+					const uint32_t b = pCorners[(corner + 1) % 3];
+					if (a < b || m_bLocked[a] || m_bLocked[b]) {
+						addCandidate(a, b, initial);
+					}
+				}
+			}
+			std::priority_queue<Collapse> queue(std::less<Collapse>(), std::move(initial));
+
+			std::vector<Collapse> candidates;
+			std::vector<uint32_t> neighbors;
+			while (m_liveTriangles * 3 > targetIndexCount && !queue.empty()) {
+				const Collapse collapse = queue.top();
+				queue.pop();
+				if (collapse.cost > maxCost) {
+					break;
+				}
+				if (collapse.fromVersion != m_versions[collapse.from] || collapse.toVersion != m_versions[collapse.to]) {
+					continue;
+				}
+				if (!isCollapseValid(collapse.from, collapse.to)) {
+					continue;
+				}
+
+				apply(collapse.from, collapse.to);
+				m_maxCost = std::max(m_maxCost, static_cast<double>(collapse.cost));
+
+				neighbors.clear();
+				for (const uint32_t triangle : m_vertexTriangles[collapse.to]) {
+					const uint32_t* pCorners = &m_triangles[triangle * 3];
+					for (uint32_t corner = 0; corner < 3; ++corner) {
+						if (pCorners[corner] != collapse.to) {
+							neighbors.push_back(pCorners[corner]);
+						}
+					}
+				}
+				std::sort(neighbors.begin(), neighbors.end());
+				neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+
+				candidates.clear();
+				for (const uint32_t neighbor : neighbors) {
+					addCandidate(collapse.to, neighbor, candidates);
+				}
+				for (const Collapse& candidate : candidates) {
+					queue.push(candidate);
+				}
+			}
+		}
+
+		size_t write(uint32_t* pOut) const {
+			size_t count = 0;
+			for (uint32_t triangle = 0; triangle < m_triangleAlive.size(); ++triangle) {
+				if (m_triangleAlive[triangle]) {
+					std::memcpy(pOut + count, &m_triangles[triangle * 3], 3 * sizeof(uint32_t));
+					count += 3;
+				}
+			}
+			assert(count == m_liveTriangles * 3);
+			return count;
+		}
+
+		float getError() const noexcept { return static_cast<float>(std::sqrt(m_maxCost)); }
+
+	private:
+		const float* position(const uint32_t vertex) const noexcept {
+			return reinterpret_cast<const float*>(m_pPositions + vertex * m_stride);
+		}
+
+		/// Ребро, принадлежащее одному треугольнику, - граница меша или шов
+		/// (по другую сторону шва стоят другие индексы вершин).
+		void lockOpenEdges() {
+			for (uint32_t vertex = 0; vertex < m_vertexTriangles.size(); ++vertex) {
+				const std::vector<uint32_t>& triangles = m_vertexTriangles[vertex];
+				for (const uint32_t triangle : triangles) {
+					const uint32_t* pCorners = &m_triangles[triangle * 3];
+					const uint32_t corner = pCorners[0] == vertex ? 0 : (pCorners[1] == vertex ? 1 : 2);
+					const uint32_t next = pCorners[(corner + 1) % 3];
+
+					// Ребро (vertex, next) открыто, если других треугольников с ним нет.
+					uint32_t sharing = 0;
+					for (const uint32_t other : triangles) {
+						const uint32_t* pOther = &m_triangles[other * 3];
+						sharing += (pOther[0] == next || pOther[1] == next || pOther[2] == next) ? 1 : 0;
+					}
+					if (sharing == 1) {
+						m_bLocked[vertex] = 1;
+						m_bLocked[next] = 1;
+					}
+				}
+			}
+		}
+
+		/// Добавляет более дешёвое из направлений схлопывания ребра (a, b).
+		void addCandidate(const uint32_t a, const uint32_t b, std::vector<Collapse>& out) const {
+			Quadric sum = m_quadrics[a];
+			sum += m_quadrics[b];
+			const double costAB = m_bLocked[a] ? -1.0 : sum.evaluate(position(b));
+			const double costBA = m_bLocked[b] ? -1.0 : sum.evaluate(position(a));
+			if (costAB < 0.0 && costBA < 0.0) {
+				return;
+			}
+			if (costBA < 0.0 || (costAB >= 0.0 && costAB <= costBA)) {
+				out.push_back({ static_cast<float>(costAB), a, b, m_versions[a], m_versions[b] });
+			}
+			else {
+				out.push_back({ static_cast<float>(costBA), b, a, m_versions[b], m_versions[a] });
+			}
+		}
+
+		/// Схлопывание не должно переворачивать треугольники вокруг `from`.
+		bool isCollapseValid(const uint32_t from, const uint32_t to) const {
+			const float* pTarget = position(to);
+			for (const uint32_t triangle : m_vertexTriangles[from]) {
+				const uint32_t* pCorners = &m_triangles[triangle * 3];
+				if (!m_triangleAlive[triangle] || pCorners[0] == to || pCorners[1] == to || pCorners[2] == to) {
+					continue;
+				}
+
+				const float* p[3] = { position(pCorners[0]), position(pCorners[1]), position(pCorners[2]) };
+				const Vec3 before = cross(
+					Vec3(p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2]),
+					Vec3(p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2])
+				);
+				for (uint32_t corner = 0; corner < 3; ++corner) {
+					if (pCorners[corner] == from) {
+						p[corner] = pTarget;
+					}
+				}
+				const Vec3 after = cross(
+					Vec3(p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2]),
+					Vec3(p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2])
+				);
+				if (dot(before, after) <= 0.f) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		void apply(const uint32_t from, const uint32_t to) {
+			std::vector<uint32_t>& toTriangles = m_vertexTriangles[to];
+			for (const uint32_t triangle : m_vertexTriangles[from]) {
+				// Удалённый треугольник остаётся в списке своей третьей вершины до её схлопывания.
+				if (!m_triangleAlive[triangle]) {
+					continue;
+				}
+				uint32_t* pCorners = &m_triangles[triangle * 3];
+				if (pCorners[0] == to || pCorners[1] == to || pCorners[2] == to) {
+					m_triangleAlive[triangle] = false;
+					--m_liveTriangles;
+					continue;
+				}
+				for (uint32_t corner = 0; corner < 3; ++corner) {
+					if (pCorners[corner] == from) {
+						pCorners[corner] = to;
+					}
+				}
+				toTriangles.push_back(triangle);
+			}
+			m_vertexTriangles[from].clear();
+			m_vertexTriangles[from].shrink_to_fit();
+
+			// Удалённые треугольники убираются из списка оставшейся вершины.
+			toTriangles.erase(
+				std::remove_if(toTriangles.begin(), toTriangles.end(), [this](const uint32_t triangle) {
+					return !m_triangleAlive[triangle];
+				}),
+				toTriangles.end()
+			);
+
+			m_quadrics[to] += m_quadrics[from];
+			++m_versions[from];
+			++m_versions[to];
+		}
+
+		const uint8_t*						m_pPositions;
+		size_t								m_stride;
+		std::vector<uint32_t>				m_triangles;
+		std::vector<uint8_t>				m_triangleAlive;
+		std::vector<Quadric>				m_quadrics;
+		std::vector<uint32_t>				m_versions;
+		std::vector<uint8_t>				m_bLocked;
+		std::vector<std::vector<uint32_t>>	m_vertexTriangles;
+		size_t								m_liveTriangles	= 0;
+		double								m_maxCost		= 0.0;
+	};
+
+	size_t simplifyMesh(
+		const float*	pPositions,
+		const size_t	vertexCount,
+		const size_t	stride,
+		const uint32_t*	pIndices,
+		const size_t	indexCount,
+		const size_t	targetIndexCount,
+		const float		targetError,
+		uint32_t*		pOut,
+		float*			pResultError
+	) {
+		MeshSimplifier simplifier(pPositions, vertexCount, stride, pIndices, indexCount);
+		simplifier.run(targetIndexCount, targetError);
+		if (pResultError) {
+			*pResultError = simplifier.getError();
+		}
+		return simplifier.write(pOut);
+	}
+
+	MeshLodChain buildMeshLodChain(
+		const float*			pPositions,
+		const size_t			vertexCount,
+		const size_t			stride,
+		const uint32_t*			pIndices,
+		const size_t			indexCount,
+		const MeshLodParams&	params
+	) {
+		const auto startTime = std::chrono::steady_clock::now();
+
+		MeshLodChain chain;
+		chain.indices.assign(pIndices, pIndices + indexCount);
+		chain.levels.push_back({ 0, static_cast<uint32_t>(indexCount), 0.f });
+
+		// Радиус меша задаёт масштаб предельной ошибки.
+		Vec3 min(INFINITY), max(-INFINITY);
+		for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+			const float* p = reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(pPositions) + vertex * stride);
+			min = { std::min(min.x, p[0]), std::min(min.y, p[1]), std::min(min.z, p[2]) };
+			max = { std::max(max.x, p[0]), std::max(max.y, p[1]), std::max(max.z, p[2]) };
+		}
+		const float radius = vertexCount > 0 ? length(max - min) * 0.5f : 0.f;
+		const float maxError = params.maxError * radius;
+
+		std::vector<uint32_t> source(pIndices, pIndices + indexCount);
+		std::vector<uint32_t> result(indexCount);
+		float error = 0.f;
+		while (chain.levels.size() < params.maxLevels) {
+			const size_t target = static_cast<size_t>(source.size() / 3 * params.reduction) * 3;
+			if (target / 3 < params.minTriangles) {
+				break;
+			}
+
+			float levelError = 0.f;
+			const size_t count = simplifyMesh(
+				pPositions, vertexCount, stride, source.data(), source.size(), target, maxError, result.data(), &levelError
+			);
+			// Уровень, уменьшившийся меньше чем на 10%, не оправдывает отдельного диапазона.
+			if (count == 0 || count > source.size() * 9 / 10) {
+				break;
+			}
+
+			// Ошибки уровней накапливаются: каждый упрощается из предыдущего.
+			error += levelError;
+			chain.levels.push_back({ static_cast<uint32_t>(chain.indices.size()), static_cast<uint32_t>(count), error });
+			chain.indices.insert(chain.indices.end(), result.begin(), result.begin() + count);
+			source.assign(result.begin(), result.begin() + count);
+		}
+
+		const auto elapsed = std::chrono::steady_clock::now() - startTime;
+		chain.simplifyMs = std::chrono::duration<float, std::milli>(elapsed).count();
+		s_simplifiedTriangles += indexCount / 3;
+		s_simplifyMicroseconds += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+		LOG_INFO(
+			"Mesh LOD chain: {0} levels, {1} -> {2} triangles in {3:.1f} ms",
+			chain.levels.size(), indexCount / 3, chain.levels.back().indexCount / 3, chain.simplifyMs
+		);
+		return chain;
+	}
+
+	LodSelector::LodSelector(const float maxPixelError, const float hysteresis)
+		: m_maxPixelError(maxPixelError)
+		, m_hysteresis(hysteresis)
+	{}
+
+	void LodSelector::newFrame(const Vec3& cameraPosition, const Mat4& projection, const float viewportHeight) noexcept {
+		m_lastSubmitted = m_submittedTriangles;
+		m_lastFull = m_fullTriangles;
+		m_lastSwitches = m_levelSwitches;
+		m_submittedTriangles = 0;
+		m_fullTriangles = 0;
+		m_levelSwitches = 0;
+
+		m_cameraPosition = cameraPosition;
+		// proj(1, 1) = 1 / tan(fovY / 2): пикселей на единицу на расстоянии 1.
+		m_projectionScale = projection(1, 1) * viewportHeight * 0.5f;
+	}
+
+	uint32_t LodSelector::select(const MeshLodChain& chain, const Vec3& center, const float scale, const uint32_t currentLevel) noexcept {
+		if (chain.levels.empty()) {
+			return 0;
+		}
+
+		const float distance = std::max(length(center - m_cameraPosition), 1e-4f);
+		const float pixelsPerError = scale * m_projectionScale / distance;
+		const float coarsenLimit = m_maxPixelError * (1.f - m_hysteresis);
+		const float refineLimit = m_maxPixelError * (1.f + m_hysteresis);
+
+		const uint32_t lastLevel = static_cast<uint32_t>(chain.levels.size() - 1);
+		uint32_t level = std::min(currentLevel, lastLevel);
+		while (level < lastLevel && chain.levels[level + 1].error * pixelsPerError <= coarsenLimit) {
+			++level;
+		}
+		while (level > 0 && chain.levels[level].error * pixelsPerError > refineLimit) {
+			--level;
+		}
+
+		m_submittedTriangles += chain.levels[level].indexCount / 3;
+		m_fullTriangles += chain.levels[0].indexCount / 3;
+		if (level != currentLevel) {
+			++m_levelSwitches;
+		}
+		return level;
+	}
+
+	void LodSelector::drawImGuiPanel() {
+		ImGui::Begin("LOD мешей");
+
+		ImGui::SliderFloat("Допустимая ошибка, пикс.", &m_maxPixelError, 0.1f, 16.f);
+		ImGui::Text("Треугольников за кадр: %llu (без LOD: %llu)",
+			static_cast<unsigned long long>(m_lastSubmitted), static_cast<unsigned long long>(m_lastFull));
+		if (m_lastFull > 0) {
+			ImGui::Text("Отправлено: %.1f%%", 100.0 * static_cast<double>(m_lastSubmitted) / static_cast<double>(m_lastFull));
+		}
+		ImGui::Text("Смен уровня: %u", m_lastSwitches);
+
+		const uint64_t triangles = s_simplifiedTriangles.load();
+		const uint64_t microseconds = s_simplifyMicroseconds.load();
+		if (triangles > 0) {
+			ImGui::Text("Упрощение: %.1f мс на 1M треугольников (всего %llu)",
+				static_cast<double>(microseconds) / 1000.0 * 1e6 / static_cast<double>(triangles),
+				static_cast<unsigned long long>(triangles));
+		}
+
+		ImGui::End();
+	}
+
+} // namespace Engine
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "EngineCore/Math.hpp"
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Упрощает индексированный меш схлопыванием рёбер по квадрикам ошибки (QEM).
+	 *
+	 * Ребро схлопывается в одну из своих вершин, поэтому результат ссылается на
+	 * исходные вершины, и все LOD могут разделять один вершинный буфер.
+	 * Вершины на открытых рёбрах (границы и швы UV/нормалей, где вершины
+	 * продублированы) не удаляются, поэтому швы и края не расходятся.
+	 * Схлопывания, переворачивающие треугольники, отклоняются.
+	 *
+	 * @param pPositions Позиции (3 float в начале каждой вершины).
+	 * @param vertexCount Кол-во вершин.
+	 * @param stride Размер вершины в байтах.
+	 * @param pIndices Индексы треугольников.
+	 * @param indexCount Кол-во индексов (кратно 3).
+	 * @param targetIndexCount Желаемое кол-во индексов результата.
+	 * @param targetError Максимальная ошибка схлопывания в единицах меша.
+	 * @param [out] pOut Индексы результата (не меньше `indexCount`).
+	 * @param [out] pResultError Достигнутая ошибка в единицах меша (может быть nullptr).
+	 * @return Кол-во индексов результата.
+	 */
+	size_t simplifyMesh(
+		const float*	pPositions,
+		size_t			vertexCount,
+		size_t			stride,
+		const uint32_t*	pIndices,
+		size_t			indexCount,
+		size_t			targetIndexCount,
+		float			targetError,
+		uint32_t*		pOut,
+		float*			pResultError = nullptr
+	);
+
+	/**
+	 * @internal
+	 * @brief Уровень детализации: диапазон в общем буфере индексов цепочки.
+	 */
+	struct MeshLod {
+		uint32_t	indexOffset	= 0;
+		uint32_t	indexCount	= 0;
+		float		error		= 0.f;	///< Геометрическая ошибка уровня в единицах меша.
+	};
+
+	/**
+	 * @internal
+	 * @brief Цепочка LOD меша: уровень 0 - исходный меш, далее по убыванию детализации.
+	 */
+	struct MeshLodChain {
+		std::vector<uint32_t>	indices;	///< Индексы всех уровней подряд.
+		std::vector<MeshLod>	levels;
+		float					simplifyMs	= 0.f;
+
+		uint32_t getTriangleCount(size_t level) const noexcept { return levels[level].indexCount / 3; }
+	};
+
+	/**
+	 * @internal
+	 * @brief Параметры построения цепочки LOD.
+	 */
+	struct MeshLodParams {
+		float		reduction		= 0.5f;		///< Доля треугольников следующего уровня от предыдущего.
+		uint32_t	maxLevels		= 6;		///< Максимум уровней, включая исходный.
+		uint32_t	minTriangles	= 64;		///< Уровни меньше этого не строятся.
+		float		maxError		= 0.05f;	///< Предельная ошибка относительно радиуса меша.
+	};
+
+	/**
+	 * @internal
+	 * @brief Строит цепочку LOD, упрощая каждый уровень из предыдущего.
+	 *
+	 * Функция не использует OpenGL и общие данные, поэтому может выполняться
+	 * офлайн или фоновой задачей:
+	 * @code
+	 * jobSystem.submit([pMesh]() {
+	 * 	pMesh->lods = buildMeshLodChain(pMesh->positions.data(), pMesh->vertexCount, sizeof(MeshVertex),
+	 * 		pMesh->indices.data(), pMesh->indices.size());
+	 * 	pMesh->bLodsReady = true;
+	 * });
+	 * @endcode
+	 *
+	 * Построение прекращается, когда уровень перестаёт заметно уменьшаться
+	 * (например, упёрся в `maxError` или в неудаляемые вершины швов).
+	 */
+	MeshLodChain buildMeshLodChain(
+		const float*			pPositions,
+		size_t					vertexCount,
+		size_t					stride,
+		const uint32_t*			pIndices,
+		size_t					indexCount,
+		const MeshLodParams&	params = {}
+	);
+
+	/**
+	 * @internal
+	 * @brief Выбор уровня детализации по экранной ошибке с гистерезисом.
+	 *
+	 * Ошибка уровня проецируется на экран: `error * scale * projectionScale / distance`
+	 * пикселей, где `projectionScale` - пикселей на единицу на расстоянии 1.
+	 * Выбирается самый грубый уровень с ошибкой не больше `maxPixelError`.
+	 * Чтобы объект на границе не переключался каждый кадр, огрубление требует
+	 * ошибки меньше порога на долю `hysteresis`, а уточнение - больше.
+	 *
+	 * Пример использования
+	 * @code
+	 * selector.newFrame(cameraPosition, projection, viewportHeight);
+	 * for (Object& object : objects) {
+	 * 	object.lod = selector.select(object.mesh->lods, object.center, object.scale, object.lod);
+	 * 	const MeshLod& lod = object.mesh->lods.levels[object.lod];
+	 * 	// glDrawElements(..., lod.indexCount, ..., lod.indexOffset * sizeof(uint32_t))
+	 * }
+	 * @endcode
+	 */
+	class LodSelector {
+	public:
+		explicit LodSelector(float maxPixelError = 1.f, float hysteresis = 0.25f);
+
+		/// @internal
+		/// @brief Задаёт камеру кадра и сбрасывает счётчики треугольников.
+		/// @param cameraPosition Позиция камеры.
+		/// @param projection Матрица проекции (используется масштаб по Y).
+		/// @param viewportHeight Высота области вывода в пикселях.
+		void newFrame(const Vec3& cameraPosition, const Mat4& projection, float viewportHeight) noexcept;
+
+		/// @internal
+		/// @brief Выбирает уровень объекта и учитывает его треугольники в статистике.
+		/// @param chain Цепочка LOD меша.
+		/// @param center Центр ограничивающей сферы объекта.
+		/// @param scale Масштаб объекта (ошибка уровня умножается на него).
+		/// @param currentLevel Уровень, выбранный для объекта в прошлом кадре.
+		/// @return Уровень для этого кадра.
+		uint32_t select(const MeshLodChain& chain, const Vec3& center, float scale, uint32_t currentLevel) noexcept;
+
+		void setMaxPixelError(float maxPixelError) noexcept { m_maxPixelError = maxPixelError; }
+
+		/// @internal
+		/// @brief Треугольники выбранных уровней за прошлый кадр.
+		uint64_t getSubmittedTriangles() const noexcept { return m_lastSubmitted; }
+
+		/// @internal
+		/// @brief Треугольники тех же объектов без LOD за прошлый кадр.
+		uint64_t getFullDetailTriangles() const noexcept { return m_lastFull; }
+
+		/// @internal
+		/// @brief Рисует ImGui окно со статистикой прошлого кадра и временем упрощения.
+		void drawImGuiPanel();
+
+	private:
+		Vec3		m_cameraPosition;
+		float		m_projectionScale		= 1.f;
+		float		m_maxPixelError;
+		float		m_hysteresis;
+
+		uint64_t	m_submittedTriangles	= 0;
+		uint64_t	m_fullTriangles			= 0;
+		uint32_t	m_levelSwitches			= 0;
+		uint64_t	m_lastSubmitted			= 0;
+		uint64_t	m_lastFull				= 0;
+		uint32_t	m_lastSwitches			= 0;
+	};
+
+} // namespace Engine
@@ -0,0 +1,535 @@
+#include "EngineCore/Render/OcclusionCuller.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#include <imgui/imgui.h>
+
+#include "EngineCore/Core/JobSystem.hpp"
+#include "EngineCore/Log.hpp"
+
+#if defined(__AVX2__)
+	#define ENGINE_OCCLUSION_AVX2 1
+	#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define ENGINE_OCCLUSION_SSE2 1
+	#include <emmintrin.h>
+#endif
+
+namespace Engine {
+
+	static constexpr uint32_t	TileSize			= 32;
+	static constexpr size_t		SetupBatchSize		= 1024;	///< Треугольников в пачке подготовки (кратно ширине SIMD).
+	static constexpr float		ClearDepth			= 1.f;
+
+	// Минимальный набор операций над SIMD регистром. Скалярная версия
+	// использует маски 0/1 вместо битовых, результат растеризации тот же.
+
+#if defined(ENGINE_OCCLUSION_AVX2)
+	using FloatV = __m256;
+	static constexpr uint32_t Lanes = 8;
+
+	static inline FloatV splat(float value) noexcept { return _mm256_set1_ps(value); }
+	static inline FloatV load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+	static inline void store(float* p, FloatV v) noexcept { _mm256_storeu_ps(p, v); }
+	static inline FloatV add(FloatV a, FloatV b) noexcept { return _mm256_add_ps(a, b); }
+	static inline FloatV sub(FloatV a, FloatV b) noexcept { return _mm256_sub_ps(a, b); }
+	static inline FloatV mul(FloatV a, FloatV b) noexcept { return _mm256_mul_ps(a, b); }
+	static inline FloatV div(FloatV a, FloatV b) noexcept { return _mm256_div_ps(a, b); }
+	static inline FloatV minV(FloatV a, FloatV b) noexcept { return _mm256_min_ps(a, b); }
+	static inline FloatV maxV(FloatV a, FloatV b) noexcept { return _mm256_max_ps(a, b); }
+	static inline FloatV greater(FloatV a, FloatV b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	static inline FloatV greaterEqual(FloatV a, FloatV b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+	static inline FloatV both(FloatV a, FloatV b) noexcept { return _mm256_and_ps(a, b); }
+	static inline FloatV select(FloatV mask, FloatV a, FloatV b) noexcept { return _mm256_blendv_ps(b, a, mask); }
+	static inline bool any(FloatV mask) noexcept { return _mm256_movemask_ps(mask) != 0; }
+	static inline FloatV laneOffsets() noexcept { return _mm256_setr_ps(0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f); }
+#elif defined(ENGINE_OCCLUSION_SSE2)
+	using FloatV = __m128;
+	static constexpr uint32_t Lanes = 4;
+
+	static inline FloatV splat(float value) noexcept { return _mm_set1_ps(value); }
+	static inline FloatV load(const float* p) noexcept { return _mm_loadu_ps(p); }
+	static inline void store(float* p, FloatV v) noexcept { _mm_storeu_ps(p, v); }
+	static inline FloatV add(FloatV a, FloatV b) noexcept { return _mm_add_ps(a, b); }
+	static inline FloatV sub(FloatV a, FloatV b) noexcept { return _mm_sub_ps(a, b); }
+	static inline FloatV mul(FloatV a, FloatV b) noexcept { return _mm_mul_ps(a, b); }
+	static inline FloatV div(FloatV a, FloatV b) noexcept { return _mm_div_ps(a, b); }
+	static inline FloatV minV(FloatV a, FloatV b) noexcept { return _mm_min_ps(a, b); }
+	static inline FloatV maxV(FloatV a, FloatV b) noexcept { return _mm_max_ps(a, b); }
+	static inline FloatV greater(FloatV a, FloatV b) noexcept { return _mm_cmpgt_ps(a, b); }
+	static inline FloatV greaterEqual(FloatV a, FloatV b) noexcept { return _mm_cmpge_ps(a, b); }
+	static inline FloatV both(FloatV a, FloatV b) noexcept { return _mm_and_ps(a, b); }
+	// В SSE2 нет blendv: (mask & a) | (~mask & b).
+	static inline FloatV select(FloatV mask, FloatV a, FloatV b) noexcept { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+	static inline bool any(FloatV mask) noexcept { return _mm_movemask_ps(mask) != 0; }
+	static inline FloatV laneOffsets() noexcept { return _mm_setr_ps(0.f, 1.f, 2.f, 3.f); }
+#else
+	using FloatV = float;
+	static constexpr uint32_t Lanes = 1;
+
+	static inline FloatV splat(float value) noexcept { return value; }
+	static inline FloatV load(const float* p) noexcept { return *p; }
+	static inline void store(float* p, FloatV v) noexcept { *p = v; }
+	static inline FloatV add(FloatV a, FloatV b) noexcept { return a + b; }
+	static inline FloatV sub(FloatV a, FloatV b) noexcept { return a - b; }
+	static inline FloatV mul(FloatV a, FloatV b) noexcept { return a * b; }
+	static inline FloatV div(FloatV a, FloatV b) noexcept { return a / b; }
+	static inline FloatV minV(FloatV a, FloatV b) noexcept { return std::min(a, b); }
+	static inline FloatV maxV(FloatV a, FloatV b) noexcept { return std::max(a, b); }
+	static inline FloatV greater(FloatV a, FloatV b) noexcept { return a > b ? 1.f : 0.f; }
+	static inline FloatV greaterEqual(FloatV a, FloatV b) noexcept { return a >= b ? 1.f : 0.f; }
+	static inline FloatV both(FloatV a, FloatV b) noexcept { return (a != 0.f && b != 0.f) ? 1.f : 0.f; }
+	static inline FloatV select(FloatV mask, FloatV a, FloatV b) noexcept { return mask != 0.f ? a : b; }
+	static inline bool any(FloatV mask) noexcept { return mask != 0.f; }
+	static inline FloatV laneOffsets() noexcept { return 0.f; }
+#endif
+
+	static float elapsedMs(const std::chrono::steady_clock::time_point startTime) noexcept {
+		return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	OcclusionCuller::OcclusionCuller(JobSystem* pJobSystem, const OcclusionCullerParams& params)
+		: m_pJobSystem(pJobSystem)
+		, m_width((std::max(params.width, TileSize) + TileSize - 1) / TileSize * TileSize)
+		, m_height((std::max(params.height, TileSize) + TileSize - 1) / TileSize * TileSize)
+		, m_tilesX(m_width / TileSize)
+		, m_tilesY(m_height / TileSize)
+		, m_viewProjection(Mat4::identity())
+	{
+		if (m_width != params.width || m_height != params.height) {
+			LOG_WARN("[OcclusionCuller] Resolution {}x{} rounded up to {}x{}", params.width, params.height, m_width, m_height);
+		}
+
+		uint32_t width = m_width;
+		uint32_t height = m_height;
+		for (;;) {
+			Level& level = m_levels.emplace_back();
+			level.width = width;
+			level.height = height;
+			level.maxDepth.assign(static_cast<size_t>(width) * height, ClearDepth);
+			// Уровень 0 хранит одну глубину, минимум совпадает с максимумом.
+			if (m_levels.size() > 1) {
+				level.minDepth.assign(level.maxDepth.size(), ClearDepth);
+			}
+			if (width == 1 && height == 1) {
+				break;
+			}
+			width = (width + 1) / 2;
+			height = (height + 1) / 2;
+		}
+
+		m_bins.resize(static_cast<size_t>(m_tilesX) * m_tilesY);
+		for (std::vector<float>& component : m_screen) {
+			component.resize(SetupBatchSize);
+		}
+	}
+
+	void OcclusionCuller::beginFrame(const Mat4& viewProjection) {
+		m_viewProjection = viewProjection;
+		m_lastStats = m_stats;
+		m_stats = {};
+
+		std::fill(m_levels[0].maxDepth.begin(), m_levels[0].maxDepth.end(), ClearDepth);
+		m_triangles.clear();
+		for (std::vector<uint32_t>& bin : m_bins) {
+			bin.clear();
+		}
+		m_screenCount = 0;
+	}
+
+	void OcclusionCuller::addOccluder(
+		const float*	pPositions,
+		const size_t	vertexCount,
+		const size_t	stride,
+		const uint32_t*	pIndices,
+		const size_t	indexCount,
+		const Mat4&		world
+	) {
+		const auto startTime = std::chrono::steady_clock::now();
+
+		const Mat4 transform = m_viewProjection * world;
+		m_clip.resize(vertexCount);
+		const uint8_t* pVertex = reinterpret_cast<const uint8_t*>(pPositions);
+		for (size_t i = 0; i < vertexCount; ++i, pVertex += stride) {
+			const float* p = reinterpret_cast<const float*>(pVertex);
+			m_clip[i] = transform * Vec4(p[0], p[1], p[2], 1.f);
+		}
+
+		const float halfWidth = 0.5f * static_cast<float>(m_width);
+		const float halfHeight = 0.5f * static_cast<float>(m_height);
+
+		for (size_t i = 0; i + 2 < indexCount; i += 3) {
+			const Vec4* corners[3] = { &m_clip[pIndices[i]], &m_clip[pIndices[i + 1]], &m_clip[pIndices[i + 2]] };
+
+			// Треугольник, пересекающий ближнюю плоскость, пропускается: без окклюдера
+			// отсечение только консервативнее, а обрезка полигона дороже выигрыша.
+			bool bBehindNear = false;
+			for (const Vec4* pCorner : corners) {
+				bBehindNear |= pCorner->w <= 0.f || pCorner->z < -pCorner->w;
+			}
+			if (bBehindNear) {
+				continue;
+			}
+
+			for (int corner = 0; corner < 3; ++corner) {
+				const Vec4& clip = *corners[corner];
+				const float invW = 1.f / clip.w;
+				m_screen[corner * 3 + 0][m_screenCount] = (clip.x * invW + 1.f) * halfWidth;
+				m_screen[corner * 3 + 1][m_screenCount] = (clip.y * invW + 1.f) * halfHeight;
+				m_screen[corner * 3 + 2][m_screenCount] = clip.z * invW * 0.5f + 0.5f;
+			}
+			if (++m_screenCount == SetupBatchSize) {
+				setupTriangles();
+			}
+		}
+		setupTriangles();
+
+		m_stats.occluderTriangles += static_cast<uint32_t>(indexCount / 3);
+		m_stats.setupMs += elapsedMs(startTime);
+	}
+
+	void OcclusionCuller::setupTriangles() {
+		if (m_screenCount == 0) {
+			return;
+		}
+
+		// Хвост пачки дополняется вырожденными треугольниками (нулевая площадь отбраковывается).
+		const size_t paddedCount = (m_screenCount + Lanes - 1) / Lanes * Lanes;
+		for (std::vector<float>& component : m_screen) {
+			std::fill(component.begin() + m_screenCount, component.begin() + paddedCount, 0.f);
+		}
+
+		// Результаты подготовки для одной группы из Lanes треугольников.
+		alignas(32) float area[Lanes];
+		alignas(32) float edgeA[3][Lanes];
+		alignas(32) float edgeB[3][Lanes];
+		alignas(32) float edgeC[3][Lanes];
+		alignas(32) float depthA[Lanes];
+		alignas(32) float depthB[Lanes];
+		alignas(32) float depthC[Lanes];
+		alignas(32) float boundsMin[2][Lanes];
+		alignas(32) float boundsMax[2][Lanes];
+
+		const float maxX = static_cast<float>(m_width - 1);
+		const float maxY = static_cast<float>(m_height - 1);
+
+		for (size_t first = 0; first < paddedCount; first += Lanes) {
+			const FloatV x0 = load(&m_screen[0][first]);
+			const FloatV y0 = load(&m_screen[1][first]);
+			const FloatV z0 = load(&m_screen[2][first]);
+			const FloatV x1 = load(&m_screen[3][first]);
+			const FloatV y1 = load(&m_screen[4][first]);
+			const FloatV z1 = load(&m_screen[5][first]);
+			const FloatV x2 = load(&m_screen[6][first]);
+			const FloatV y2 = load(&m_screen[7][first]);
+			const FloatV z2 = load(&m_screen[8][first]);
+
+			const FloatV dx1 = sub(x1, x0);
+			const FloatV dy1 = sub(y1, y0);
+			const FloatV dx2 = sub(x2, x0);
+			const FloatV dy2 = sub(y2, y0);
+			const FloatV twiceArea = sub(mul(dx1, dy2), mul(dx2, dy1));
+			store(area, twiceArea);
+
+			// Функция ребра a->b: E(x, y) = (ya - yb) x + (xb - xa) y + (xa yb - xb ya),
+			// положительна внутри треугольника, обходимого против часовой стрелки.
+			store(edgeA[0], sub(y0, y1));
+			store(edgeB[0], sub(x1, x0));
+			store(edgeC[0], sub(mul(x0, y1), mul(x1, y0)));
+			store(edgeA[1], sub(y1, y2));
+			store(edgeB[1], sub(x2, x1));
+			store(edgeC[1], sub(mul(x1, y2), mul(x2, y1)));
+			store(edgeA[2], sub(y2, y0));
+			store(edgeB[2], sub(x0, x2));
+			store(edgeC[2], sub(mul(x2, y0), mul(x0, y2)));
+
+			// Плоскость глубины z(x, y) = A x + B y + C (z/w линейна в экранных координатах).
+			const FloatV dz1 = sub(z1, z0);
+			const FloatV dz2 = sub(z2, z0);
+			const FloatV invArea = div(splat(1.f), select(greater(twiceArea, splat(0.f)), twiceArea, splat(1.f)));
+			const FloatV planeA = mul(sub(mul(dz1, dy2), mul(dz2, dy1)), invArea);
+			const FloatV planeB = mul(sub(mul(dz2, dx1), mul(dz1, dx2)), invArea);
+			store(depthA, planeA);
+			store(depthB, planeB);
+			store(depthC, sub(sub(z0, mul(planeA, x0)), mul(planeB, y0)));
+
+			store(boundsMin[0], minV(x0, minV(x1, x2)));
+			store(boundsMin[1], minV(y0, minV(y1, y2)));
+			store(boundsMax[0], maxV(x0, maxV(x1, x2)));
+			store(boundsMax[1], maxV(y0, maxV(y1, y2)));
+
+			const size_t laneCount = std::min<size_t>(Lanes, m_screenCount - std::min(first, m_screenCount));
+			for (size_t lane = 0; lane < laneCount; ++lane) {
+				// Обратные и вырожденные треугольники отбрасываются.
+				if (!(area[lane] > 0.f)) {
+					continue;
+				}
+				if (boundsMax[0][lane] < 0.f || boundsMax[1][lane] < 0.f || boundsMin[0][lane] > maxX || boundsMin[1][lane] > maxY) {
+					continue;
+				}
+
+				RasterTriangle triangle;
+				for (int edge = 0; edge < 3; ++edge) {
+					triangle.edgeA[edge] = edgeA[edge][lane];
+					triangle.edgeB[edge] = edgeB[edge][lane];
+					triangle.edgeC[edge] = edgeC[edge][lane];
+				}
+				triangle.depthA = depthA[lane];
+				triangle.depthB = depthB[lane];
+				triangle.depthC = depthC[lane];
+				triangle.minX = static_cast<int32_t>(std::max(boundsMin[0][lane], 0.f));
+				triangle.minY = static_cast<int32_t>(std::max(boundsMin[1][lane], 0.f));
+				triangle.maxX = static_cast<int32_t>(std::min(boundsMax[0][lane], maxX));
+				triangle.maxY = static_cast<int32_t>(std::min(boundsMax[1][lane], maxY));
+
+				const uint32_t index = static_cast<uint32_t>(m_triangles.size());
+				m_triangles.push_back(triangle);
+				for (int32_t tileY = triangle.minY / static_cast<int32_t>(TileSize); tileY <= triangle.maxY / static_cast<int32_t>(TileSize); ++tileY) {
+					for (int32_t tileX = triangle.minX / static_cast<int32_t>(TileSize); tileX <= triangle.maxX / static_cast<int32_t>(TileSize); ++tileX) {
+						m_bins[static_cast<size_t>(tileY) * m_tilesX + tileX].push_back(index);
+					}
+				}
+			}
+		}
+
+		m_screenCount = 0;
+	}
+
+	void OcclusionCuller::rasterize() {
+		const auto startTime = std::chrono::steady_clock::now();
+
+		const uint32_t tileCount = m_tilesX * m_tilesY;
+		if (m_pJobSystem) {
+			// Тайлы не пересекаются, поэтому потоки пишут в буфер без синхронизации.
+			m_pJobSystem->parallelFor(tileCount, 1, [this](const uint32_t begin, const uint32_t end) {
+				for (uint32_t tile = begin; tile < end; ++tile) {
+					rasterizeTile(tile);
+				}
+			});
+		}
+		else {
+			for (uint32_t tile = 0; tile < tileCount; ++tile) {
+				rasterizeTile(tile);
+			}
+		}
+		buildHierarchy();
+
+		m_stats.rasterTriangles = static_cast<uint32_t>(m_triangles.size());
+		m_stats.rasterMs += elapsedMs(startTime);
+	}
+
+	void OcclusionCuller::rasterizeTile(const uint32_t tile) {
+		const std::vector<uint32_t>& bin = m_bins[tile];
+		if (bin.empty()) {
+			return;
+		}
+
+		const int32_t tileMinX = static_cast<int32_t>((tile % m_tilesX) * TileSize);
+		const int32_t tileMinY = static_cast<int32_t>((tile / m_tilesX) * TileSize);
+		const int32_t tileMaxX = tileMinX + static_cast<int32_t>(TileSize) - 1;
+		const int32_t tileMaxY = tileMinY + static_cast<int32_t>(TileSize) - 1;
+		float* pDepth = m_levels[0].maxDepth.data();
+
+		const FloatV zero = splat(0.f);
+		const FloatV offsets = laneOffsets();
+
+		for (const uint32_t index : bin) {
+			const RasterTriangle& triangle = m_triangles[index];
+
+			// Начало строки выровнено на ширину SIMD, конец тайла кратен ей,
+			// поэтому обработка никогда не выходит за тайл.
+			const int32_t minX = std::max(triangle.minX, tileMinX) / static_cast<int32_t>(Lanes) * static_cast<int32_t>(Lanes);
+			const int32_t maxX = std::min(triangle.maxX, tileMaxX);
+			const int32_t minY = std::max(triangle.minY, tileMinY);
+			const int32_t maxY = std::min(triangle.maxY, tileMaxY);
+
+			const FloatV a0 = splat(triangle.edgeA[0]);
+			const FloatV a1 = splat(triangle.edgeA[1]);
+			const FloatV a2 = splat(triangle.edgeA[2]);
+			const FloatV depthA = splat(triangle.depthA);
+
+			for (int32_t y = minY; y <= maxY; ++y) {
+				// Проверяются центры пикселей.
+				const float centerY = static_cast<float>(y) + 0.5f;
+				const FloatV row0 = splat(triangle.edgeB[0] * centerY + triangle.edgeC[0]);
+				const FloatV row1 = splat(triangle.edgeB[1] * centerY + triangle.edgeC[1]);
+				const FloatV row2 = splat(triangle.edgeB[2] * centerY + triangle.edgeC[2]);
+				const FloatV rowDepth = splat(triangle.depthB * centerY + triangle.depthC);
+				float* pRow = pDepth + static_cast<size_t>(y) * m_width;
+
+				for (int32_t x = minX; x <= maxX; x += Lanes) {
+					const FloatV centerX = add(splat(static_cast<float>(x) + 0.5f), offsets);
+					const FloatV edge0 = add(mul(a0, centerX), row0);
+					const FloatV edge1 = add(mul(a1, centerX), row1);
+					const FloatV edge2 = add(mul(a2, centerX), row2);
+					// Центр на ребре считается покрытым: у соседних треугольников значения
+					// функций общего ребра равны с обратным знаком, и без этого по диагоналям
+					// остаются щели.
+					const FloatV inside = both(greaterEqual(edge0, zero), both(greaterEqual(edge1, zero), greaterEqual(edge2, zero)));
+					if (!any(inside)) {
+						continue;
+					}
+					const FloatV depth = add(mul(depthA, centerX), rowDepth);
+					const FloatV current = load(pRow + x);
+					store(pRow + x, select(inside, minV(current, depth), current));
+				}
+			}
+		}
+	}
+
+	void OcclusionCuller::buildHierarchy() {
+		for (size_t levelIndex = 1; levelIndex < m_levels.size(); ++levelIndex) {
+			const Level& source = m_levels[levelIndex - 1];
+			Level& target = m_levels[levelIndex];
+			const std::vector<float>& sourceMin = levelIndex == 1 ? source.maxDepth : source.minDepth;
+
+			for (uint32_t y = 0; y < target.height; ++y) {
+				const uint32_t y0 = y * 2;
+				const uint32_t y1 = std::min(y0 + 1, source.height - 1);
+				for (uint32_t x = 0; x < target.width; ++x) {
+					const uint32_t x0 = x * 2;
+					const uint32_t x1 = std::min(x0 + 1, source.width - 1);
+					const size_t i00 = static_cast<size_t>(y0) * source.width + x0;
+					const size_t i01 = static_cast<size_t>(y0) * source.width + x1;
+					const size_t i10 = static_cast<size_t>(y1) * source.width + x0;
+					const size_t i11 = static_cast<size_t>(y1) * source.width + x1;
+					const size_t targetIndex = static_cast<size_t>(y) * target.width + x;
+
+					target.minDepth[targetIndex] = std::min(std::min(sourceMin[i00], sourceMin[i01]), std::min(sourceMin[i10], sourceMin[i11]));
+					target.maxDepth[targetIndex] = std::max(std::max(source.maxDepth[i00], source.maxDepth[i01]), std::max(source.maxDepth[i10], source.maxDepth[i11]));
+				}
+			}
+		}
+	}
+
+	bool OcclusionCuller::isRegionVisible(
+		const uint32_t	levelIndex,
+		const int32_t	x0,
+		const int32_t	y0,
+		const int32_t	x1,
+		const int32_t	y1,
+		const float		nearestDepth
+	) const noexcept {
+		const Level& level = m_levels[levelIndex];
+		const std::vector<float>& minDepth = levelIndex == 0 ? level.maxDepth : level.minDepth;
+
+		for (int32_t texelY = y0 >> levelIndex; texelY <= (y1 >> levelIndex); ++texelY) {
+			for (int32_t texelX = x0 >> levelIndex; texelX <= (x1 >> levelIndex); ++texelX) {
+				const size_t texel = static_cast<size_t>(texelY) * level.width + texelX;
+				// Все окклюдеры блока ближе объекта.
+				if (level.maxDepth[texel] < nearestDepth) {
+					continue;
+				}
+				// Объект ближе всех окклюдеров блока: ни один вложенный тексель его не закроет.
+				if (levelIndex == 0 || minDepth[texel] >= nearestDepth) {
+					return true;
+				}
+				const int32_t childX0 = std::max(x0, texelX << levelIndex);
+				const int32_t childY0 = std::max(y0, texelY << levelIndex);
+				const int32_t childX1 = std::min(x1, ((texelX + 1) << levelIndex) - 1);
+				const int32_t childY1 = std::min(y1, ((texelY + 1) << levelIndex) - 1);
+				if (isRegionVisible(levelIndex - 1, childX0, childY0, childX1, childY1, nearestDepth)) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	bool OcclusionCuller::isVisible(const OcclusionBounds& bounds) const noexcept {
+		float minX = std::numeric_limits<float>::max();
+		float minY = std::numeric_limits<float>::max();
+		float maxX = std::numeric_limits<float>::lowest();
+		float maxY = std::numeric_limits<float>::lowest();
+		float nearestDepth = 1.f;
+
+		for (int corner = 0; corner < 8; ++corner) {
+			const Vec4 clip = m_viewProjection * Vec4(
+				(corner & 1) ? bounds.max.x : bounds.min.x,
+				(corner & 2) ? bounds.max.y : bounds.min.y,
+				(corner & 4) ? bounds.max.z : bounds.min.z,
+				1.f
+			);
+			// Бокс пересекает ближнюю плоскость: камера внутри или рядом, считаем видимым.
+			if (clip.w <= 0.f || clip.z < -clip.w) {
+				return true;
+			}
+			const float invW = 1.f / clip.w;
+			const float x = (clip.x * invW + 1.f) * 0.5f * static_cast<float>(m_width);
+			const float y = (clip.y * invW + 1.f) * 0.5f * static_cast<float>(m_height);
+			minX = std::min(minX, x);
+			minY = std::min(minY, y);
+			maxX = std::max(maxX, x);
+			maxY = std::max(maxY, y);
+			nearestDepth = std::min(nearestDepth, clip.z * invW * 0.5f + 0.5f);
+		}
+
+		// Бокс за пределами экрана - дело отсечения по пирамиде видимости, здесь он не перекрыт.
+		if (maxX < 0.f || maxY < 0.f || minX >= static_cast<float>(m_width) || minY >= static_cast<float>(m_height)) {
+			return true;
+		}
+
+		const int32_t x0 = static_cast<int32_t>(std::max(minX, 0.f));
+		const int32_t y0 = static_cast<int32_t>(std::max(minY, 0.f));
+		const int32_t x1 = static_cast<int32_t>(std::min(maxX, static_cast<float>(m_width - 1)));
+		const int32_t y1 = static_cast<int32_t>(std::min(maxY, static_cast<float>(m_height - 1)));
+
+		// Начальный уровень: прямоугольник бокса занимает не больше 2x2 текселей.
+		uint32_t levelIndex = 0;
+		while (levelIndex + 1 < m_levels.size() && (((x1 >> levelIndex) - (x0 >> levelIndex)) > 1 || ((y1 >> levelIndex) - (y0 >> levelIndex)) > 1)) {
+			++levelIndex;
+		}
+		return isRegionVisible(levelIndex, x0, y0, x1, y1, nearestDepth);
+	}
+
+	void OcclusionCuller::cull(const OcclusionBounds* pBounds, const size_t count, uint8_t* pVisible) {
+		const auto startTime = std::chrono::steady_clock::now();
+
+		const auto testRange = [this, pBounds, pVisible](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				pVisible[i] = isVisible(pBounds[i]) ? 1 : 0;
+			}
+		};
+		if (m_pJobSystem) {
+			m_pJobSystem->parallelFor(static_cast<uint32_t>(count), 256, testRange);
+		}
+		else {
+			testRange(0, static_cast<uint32_t>(count));
+		}
+
+		uint32_t occluded = 0;
+		for (size_t i = 0; i < count; ++i) {
+			occluded += pVisible[i] == 0 ? 1 : 0;
+		}
+		m_stats.testedObjects += static_cast<uint32_t>(count);
+		m_stats.occludedObjects += occluded;
+		m_stats.testMs += elapsedMs(startTime);
+	}
+
+	void OcclusionCuller::drawImGuiPanel() {
+		ImGui::Begin("Отсечение перекрытых");
+
+#if defined(ENGINE_OCCLUSION_AVX2)
+		ImGui::Text("Буфер глубины: %ux%u, AVX2", m_width, m_height);
+#elif defined(ENGINE_OCCLUSION_SSE2)
+		ImGui::Text("Буфер глубины: %ux%u, SSE2", m_width, m_height);
+#else
+		ImGui::Text("Буфер глубины: %ux%u, скалярный", m_width, m_height);
+#endif
+		ImGui::Text("Треугольников окклюдеров: %u (растеризовано: %u)", m_lastStats.occluderTriangles, m_lastStats.rasterTriangles);
+		ImGui::Text("Объектов: %u, перекрыто: %u", m_lastStats.testedObjects, m_lastStats.occludedObjects);
+		if (m_lastStats.testedObjects > 0) {
+			ImGui::Text("Отсечено: %.1f%%", 100.0 * m_lastStats.occludedObjects / m_lastStats.testedObjects);
+		}
+		ImGui::Text("Подготовка: %.3f мс", m_lastStats.setupMs);
+		ImGui::Text("Растеризация: %.3f мс", m_lastStats.rasterMs);
+		ImGui::Text("Проверка: %.3f мс", m_lastStats.testMs);
+		ImGui::Text("Всего: %.3f мс", m_lastStats.setupMs + m_lastStats.rasterMs + m_lastStats.testMs);
+
+		ImGui::End();
+	}
+
+} // namespace Engine
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "EngineCore/Math.hpp"
+
+namespace Engine {
+
+	class JobSystem;
+
+	/**
+	 * @internal
+	 * @brief Ограничивающий бокс объекта в мировых координатах.
+	 */
+	struct OcclusionBounds {
+		Vec3	min;
+		Vec3	max;
+	};
+
+	/**
+	 * @internal
+	 * @brief Параметры `OcclusionCuller`.
+	 */
+	struct OcclusionCullerParams {
+		uint32_t	width		= 256;	///< Ширина буфера глубины (кратна 32).
+		uint32_t	height		= 128;	///< Высота буфера глубины (кратна 32).
+	};
+
+	/**
+	 * @internal
+	 * @brief Статистика `OcclusionCuller` за кадр.
+	 */
+	struct OcclusionStats {
+		uint32_t	occluderTriangles	= 0;	///< Треугольников окклюдеров передано.
+		uint32_t	rasterTriangles		= 0;	///< Из них растеризовано (после отсечения и отбраковки).
+		uint32_t	testedObjects		= 0;
+		uint32_t	occludedObjects		= 0;
+		float		setupMs				= 0.f;	///< Преобразование, подготовка и распределение треугольников.
+		float		rasterMs			= 0.f;	///< Растеризация по тайлам и построение иерархии.
+		float		testMs				= 0.f;	///< Проверка объектов.
+	};
+
+	/**
+	 * @internal
+	 * @brief Программное отсечение перекрытых объектов на CPU.
+	 *
+	 * Каждый кадр:
+	 * 1. Небольшой набор мешей-окклюдеров (стены, крупные объекты) растеризуется
+	 *    в буфер глубины низкого разрешения. Подготовка треугольников идёт пачками
+	 *    по ширине SIMD регистра, растеризация - по тайлам 32x32 параллельно
+	 *    в `JobSystem`, строка тайла обрабатывается по 8 (AVX2, опция CMake `ENGINE_AVX2`)
+	 *    или 4 (SSE2) пикселя.
+	 * 2. Из буфера строится иерархия (min/max глубины по блокам 2x2, 4x4, ...).
+	 * 3. Бокс объекта проецируется на экран, и его ближайшая глубина сравнивается
+	 *    с дальней глубиной окклюдеров на уровне иерархии, где бокс занимает
+	 *    несколько текселей. Объект перекрыт, если он дальше везде.
+	 *
+	 * Треугольники окклюдеров, пересекающие ближнюю плоскость, пропускаются,
+	 * а бокс, пересекающий её, считается видимым, поэтому ошибки только
+	 * консервативные: видимый объект не отсекается.
+	 *
+	 * Класс не использует OpenGL, поэтому работает без контекста (тесты, бенчмарки).
+	 *
+	 * Пример использования
+	 * @code
+	 * culler.beginFrame(camera.viewProjection);
+	 * for (const Occluder& occluder : occluders) {
+	 * 	culler.addOccluder(occluder.positions, occluder.vertexCount, sizeof(Vertex), occluder.indices, occluder.indexCount, occluder.world);
+	 * }
+	 * culler.rasterize();
+	 * culler.cull(bounds.data(), bounds.size(), visible.data());
+	 * @endcode
+	 */
+	class OcclusionCuller {
+	public:
+		/// @param pJobSystem Пул потоков для растеризации и проверки (nullptr - в вызывающем потоке).
+		/// @param params Разрешение буфера глубины.
+		explicit OcclusionCuller(JobSystem* pJobSystem = nullptr, const OcclusionCullerParams& params = {});
+
+		/// @internal
+		/// @brief Очищает буфер глубины и задаёт камеру кадра.
+		void beginFrame(const Mat4& viewProjection);
+
+		/// @internal
+		/// @brief Добавляет меш-окклюдер.
+		///
+		/// Треугольники сразу преобразуются и распределяются по тайлам.
+		/// Учитываются только лицевые (против часовой стрелки) треугольники.
+		///
+		/// @param pPositions Позиции (3 float в начале каждой вершины).
+		/// @param vertexCount Кол-во вершин.
+		/// @param stride Размер вершины в байтах.
+		/// @param pIndices Индексы треугольников.
+		/// @param indexCount Кол-во индексов.
+		/// @param world Матрица объекта.
+		void addOccluder(
+			const float*	pPositions,
+			size_t			vertexCount,
+			size_t			stride,
+			const uint32_t*	pIndices,
+			size_t			indexCount,
+			const Mat4&		world
+		);
+
+		/// @internal
+		/// @brief Растеризует окклюдеры и строит иерархию глубины.
+		void rasterize();
+
+		/// @internal
+		/// @brief Виден ли бокс (не перекрыт окклюдерами).
+		/// @note Можно вызывать из нескольких потоков после `rasterize()`.
+		bool isVisible(const OcclusionBounds& bounds) const noexcept;
+
+		/// @internal
+		/// @brief Проверяет `count` боксов и учитывает результат в статистике.
+		/// @param [out] pVisible 1 - объект видим, 0 - перекрыт.
+		void cull(const OcclusionBounds* pBounds, size_t count, uint8_t* pVisible);
+
+		uint32_t getWidth() const noexcept { return m_width; }
+		uint32_t getHeight() const noexcept { return m_height; }
+
+		/// @internal
+		/// @brief Буфер глубины [0, 1] (строка 0 - низ экрана), 1 - пусто.
+		const std::vector<float>& getDepth() const noexcept { return m_levels[0].maxDepth; }
+
+		const OcclusionStats& getStats() const noexcept { return m_stats; }
+		const OcclusionStats& getLastStats() const noexcept { return m_lastStats; }
+
+		/// @internal
+		/// @brief Рисует ImGui окно со статистикой прошлого кадра.
+		void drawImGuiPanel();
+
+	private:
+		/// Треугольник после подготовки: функции рёбер и плоскость глубины в пикселях.
+		struct RasterTriangle {
+			float		edgeA[3];
+			float		edgeB[3];
+			float		edgeC[3];
+			float		depthA;
+			float		depthB;
+			float		depthC;
+			int32_t		minX, minY, maxX, maxY;
+		};
+
+		/// Уровень иерархии глубины.
+		struct Level {
+			uint32_t			width	= 0;
+			uint32_t			height	= 0;
+			std::vector<float>	minDepth;
+			std::vector<float>	maxDepth;
+		};
+
+		void setupTriangles();
+		void rasterizeTile(uint32_t tile);
+		void buildHierarchy();
+
+		/// Проверяет тексели уровня `level`, покрывающие прямоугольник пикселей [x0, x1] x [y0, y1].
+		bool isRegionVisible(uint32_t level, int32_t x0, int32_t y0, int32_t x1, int32_t y1, float nearestDepth) const noexcept;
+
+		JobSystem*							m_pJobSystem;
+		uint32_t							m_width;
+		uint32_t							m_height;
+		uint32_t							m_tilesX;
+		uint32_t							m_tilesY;
+		Mat4								m_viewProjection;
+
+		std::vector<Level>					m_levels;
+		std::vector<Vec4>					m_clip;			///< Вершины текущего окклюдера в пространстве отсечения.
+		std::vector<RasterTriangle>			m_triangles;
+		std::vector<std::vector<uint32_t>>	m_bins;			///< Индексы треугольников по тайлам.
+		std::vector<float>					m_screen[9];	///< Экранные x, y, z вершин 0..2 пачки треугольников (SoA).
+		size_t								m_screenCount	= 0;
+
+		OcclusionStats						m_stats;
+		OcclusionStats						m_lastStats;
+	};
+
+} // namespace Engine
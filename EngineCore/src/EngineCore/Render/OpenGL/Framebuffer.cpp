@@ -0,0 +1,197 @@
+#include "EngineCore/Render/OpenGL/Framebuffer.hpp"
+
+#include <glad/glad.h>
+
+#include "EngineCore/Event.hpp"
+#include "EngineCore/Log.hpp"
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+#include "EngineCore/Render/OpenGL/GpuResourceRegistry.hpp"
+#include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
+
+namespace Engine {
+
+	uint32_t getAttachmentBytesPerPixel(const uint32_t format) noexcept {
+		switch (format) {
+		case GL_R8:						return 1;
+		case GL_RG8:
+		case GL_R16F:
+		case GL_DEPTH_COMPONENT16:		return 2;
+		case GL_RGBA8:
+		case GL_SRGB8_ALPHA8:
+		case GL_RGB10_A2:
+		case GL_R11F_G11F_B10F:
+		case GL_RG16F:
+		case GL_R32F:
+		case GL_R32UI:
+		case GL_DEPTH_COMPONENT24:
+		case GL_DEPTH24_STENCIL8:
+		case GL_DEPTH_COMPONENT32F:		return 4;
+		case GL_RGBA16F:
+		case GL_RG32F:
+		case GL_DEPTH32F_STENCIL8:		return 8;
+		case GL_RGBA32F:				return 16;
+		default:						return 4;
+		}
+	}
+
+	bool isDepthFormat(const uint32_t format) noexcept {
+		return format == GL_DEPTH_COMPONENT16 || format == GL_DEPTH_COMPONENT24 || format == GL_DEPTH_COMPONENT32F
+			|| format == GL_DEPTH24_STENCIL8 || format == GL_DEPTH32F_STENCIL8;
+	}
+
+	bool hasStencil(const uint32_t format) noexcept {
+		return format == GL_DEPTH24_STENCIL8 || format == GL_DEPTH32F_STENCIL8;
+	}
+
+	unsigned int createAttachmentTexture(const uint32_t format, const uint32_t width, const uint32_t height, const char* usage) {
+		unsigned int id = 0;
+		if (hasDirectStateAccess()) {
+			glCreateTextures(GL_TEXTURE_2D, 1, &id);
+			glTextureStorage2D(id, 1, format, width, height);
+			glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		}
+		else {
+			glGenTextures(1, &id);
+			glBindTexture(GL_TEXTURE_2D, id);
+			glTexStorage2D(GL_TEXTURE_2D, 1, format, width, height);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		}
+		GpuResourceRegistry::add(
+			GpuResourceCategory::Texture, id,
+			static_cast<uint64_t>(width) * height * getAttachmentBytesPerPixel(format), usage
+		);
+		return id;
+	}
+
+	Framebuffer::Framebuffer(const FramebufferSpec& spec)
+		: m_spec(spec)
+	{
+		create();
+	}
+
+	Framebuffer::~Framebuffer() {
+		destroy();
+	}
+
+	void Framebuffer::create() {
+		if (m_spec.width == 0 || m_spec.height == 0) {
+			return;
+		}
+
+		for (const uint32_t format : m_spec.colorFormats) {
+			m_colorAttachments.push_back(createAttachmentTexture(format, m_spec.width, m_spec.height, "attachment"));
+		}
+		if (m_spec.depthFormat != 0) {
+			m_depthAttachment = createAttachmentTexture(m_spec.depthFormat, m_spec.width, m_spec.height, "attachment");
+		}
+
+		const GLenum depthAttachment = hasStencil(m_spec.depthFormat) ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+		std::vector<GLenum> drawBuffers(m_colorAttachments.size());
+		for (size_t i = 0; i < drawBuffers.size(); ++i) {
+			drawBuffers[i] = static_cast<GLenum>(GL_COLOR_ATTACHMENT0 + i);
+		}
+
+		GLenum status = GL_FRAMEBUFFER_COMPLETE;
+		if (hasDirectStateAccess()) {
+			glCreateFramebuffers(1, &m_id);
+			for (size_t i = 0; i < m_colorAttachments.size(); ++i) {
+				glNamedFramebufferTexture(m_id, drawBuffers[i], m_colorAttachments[i], 0);
+			}
+			if (m_depthAttachment != 0) {
+				glNamedFramebufferTexture(m_id, depthAttachment, m_depthAttachment, 0);
+			}
+			if (drawBuffers.empty()) {
+				glNamedFramebufferDrawBuffer(m_id, GL_NONE);
+			}
+			else {
+				glNamedFramebufferDrawBuffers(m_id, static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
+			}
+			status = glCheckNamedFramebufferStatus(m_id, GL_FRAMEBUFFER);
+		}
+		else {
+			glGenFramebuffers(1, &m_id);
+			glBindFramebuffer(GL_FRAMEBUFFER, m_id);
+			for (size_t i = 0; i < m_colorAttachments.size(); ++i) {
+				glFramebufferTexture(GL_FRAMEBUFFER, drawBuffers[i], m_colorAttachments[i], 0);
+			}
+			if (m_depthAttachment != 0) {
+				glFramebufferTexture(GL_FRAMEBUFFER, depthAttachment, m_depthAttachment, 0);
+			}
+			if (drawBuffers.empty()) {
+				glDrawBuffer(GL_NONE);
+			}
+			else {
+				glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
+			}
+			status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		}
+
+		if (status != GL_FRAMEBUFFER_COMPLETE) {
+			LOG_ERR("[Framebuffer] Framebuffer {}x{} is incomplete (0x{:x})", m_spec.width, m_spec.height, status);
+		}
+
+		GpuResourceRegistry::add(GpuResourceCategory::Framebuffer, m_id, 0);
+		if (!m_label.empty()) {
+			setLabel(m_label);
+		}
+	}
+
+	void Framebuffer::destroy() {
+		GpuDeletionQueue::release(GpuResourceCategory::Framebuffer, m_id);
+		m_id = 0;
+		for (const unsigned int attachment : m_colorAttachments) {
+			GpuDeletionQueue::release(GpuResourceCategory::Texture, attachment);
+		}
+		m_colorAttachments.clear();
+		GpuDeletionQueue::release(GpuResourceCategory::Texture, m_depthAttachment);
+		m_depthAttachment = 0;
+	}
+
+	void Framebuffer::bind() const noexcept {
+		glBindFramebuffer(GL_FRAMEBUFFER, m_id);
+		glViewport(0, 0, static_cast<GLsizei>(m_spec.width), static_cast<GLsizei>(m_spec.height));
+	}
+
+	void Framebuffer::bindDefault() noexcept {
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	void Framebuffer::resize(const uint32_t width, const uint32_t height) {
+		// Свёрнутое окно присылает нулевой размер: вложения сохраняются до восстановления.
+		if (width == 0 || height == 0 || (width == m_spec.width && height == m_spec.height)) {
+			return;
+		}
+		destroy();
+		m_spec.width = width;
+		m_spec.height = height;
+		create();
+	}
+
+	void Framebuffer::onWindowResize(const EventWindowResize& event) {
+		if (m_spec.bResizeWithWindow) {
+			resize(event.width, event.height);
+		}
+	}
+
+	void Framebuffer::setLabel(const std::string& label) {
+		m_label = label;
+		if (m_id == 0) {
+			return;
+		}
+		GpuResourceRegistry::setLabel(GpuResourceCategory::Framebuffer, m_id, label);
+		for (size_t i = 0; i < m_colorAttachments.size(); ++i) {
+			GpuResourceRegistry::setLabel(GpuResourceCategory::Texture, m_colorAttachments[i], label + " color " + std::to_string(i));
+		}
+		if (m_depthAttachment != 0) {
+			GpuResourceRegistry::setLabel(GpuResourceCategory::Texture, m_depthAttachment, label + " depth");
+		}
+	}
+
+} // namespace Engine
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+	struct EventWindowResize;
+
+	/**
+	 * @internal
+	 * @brief Описание `Framebuffer`.
+	 */
+	struct FramebufferSpec {
+		uint32_t				width				= 0;
+		uint32_t				height				= 0;
+		std::vector<uint32_t>	colorFormats;					///< Внутренние форматы (GLenum) цветовых вложений, например GL_RGBA8.
+		uint32_t				depthFormat			= 0;		///< Формат глубины (GLenum), 0 - без глубины.
+		bool					bResizeWithWindow	= true;		///< Менять размер в `onWindowResize()`.
+	};
+
+	/// @internal
+	/// @brief Оценка размера пикселя формата вложения (GLenum) в видеопамяти.
+	uint32_t getAttachmentBytesPerPixel(uint32_t format) noexcept;
+
+	/// @internal
+	/// @brief Формат глубины (с трафаретом или без).
+	bool isDepthFormat(uint32_t format) noexcept;
+
+	/// @internal
+	/// @brief Формат глубины с трафаретом: подключается к `GL_DEPTH_STENCIL_ATTACHMENT`.
+	bool hasStencil(uint32_t format) noexcept;
+
+	/// @internal
+	/// @brief Создаёт неизменяемую текстуру вложения из одного уровня (линейная фильтрация,
+	/// `GL_CLAMP_TO_EDGE`) и регистрирует её в `GpuResourceRegistry`.
+	/// @param usage Тип использования для реестра.
+	/// @return Идентификатор текстуры; удаляется через `GpuDeletionQueue::release()`.
+	unsigned int createAttachmentTexture(uint32_t format, uint32_t width, uint32_t height, const char* usage);
+
+	/// @internal
+	/// @brief Класс, инкапсулирующий FBO с текстурными вложениями цвета и глубины.
+	///
+	/// Вложения - неизменяемые текстуры одного уровня. При изменении размера они
+	/// пересоздаются, поэтому идентификаторы вложений после `resize()` меняются.
+	///
+	/// Размер следует за окном, если обработчик изменения размера передаёт событие:
+	/// @code
+	/// dispatcher.addListener<EventWindowResize>([&](EventWindowResize& event) {
+	/// 	sceneFramebuffer.onWindowResize(event);
+	/// });
+	/// @endcode
+	///
+	/// @note Копирование и перемещение запрещено.
+	class Framebuffer {
+	public:
+		explicit Framebuffer(const FramebufferSpec& spec);
+		~Framebuffer();
+
+		Framebuffer(const Framebuffer&)				= delete;
+		Framebuffer& operator=(const Framebuffer&)	= delete;
+		Framebuffer(Framebuffer&&)					= delete;
+		Framebuffer& operator=(Framebuffer&&)		= delete;
+
+		/// @internal
+		/// @brief Устанавливает FBO для отрисовки и задаёт viewport по его размеру.
+		void bind() const noexcept;
+
+		/// @internal
+		/// @brief Устанавливает экран (FBO 0) для отрисовки.
+		static void bindDefault() noexcept;
+
+		/// @internal
+		/// @brief Пересоздаёт вложения с новым размером (нулевой размер игнорируется).
+		void resize(uint32_t width, uint32_t height);
+
+		/// @internal
+		/// @brief Обработчик `EventWindowResize`: меняет размер, если `bResizeWithWindow`.
+		void onWindowResize(const EventWindowResize& event);
+
+		/// @internal
+		/// @brief Возвращает идентификатор FBO OpenGL.
+		unsigned int getId() const noexcept { return m_id; }
+
+		/// @internal
+		/// @brief Возвращает текстуру цветового вложения `index`.
+		unsigned int getColorAttachment(size_t index = 0) const noexcept { return index < m_colorAttachments.size() ? m_colorAttachments[index] : 0; }
+
+		/// @internal
+		/// @brief Возвращает текстуру глубины (0, если глубины нет).
+		unsigned int getDepthAttachment() const noexcept { return m_depthAttachment; }
+
+		uint32_t getWidth() const noexcept { return m_spec.width; }
+		uint32_t getHeight() const noexcept { return m_spec.height; }
+		const FramebufferSpec& getSpec() const noexcept { return m_spec; }
+
+		/// @internal
+		/// @brief Задаёт отладочное имя FBO и вложений (видно в реестре ресурсов и GL отладчиках).
+		void setLabel(const std::string& label);
+
+	private:
+		void create();
+		void destroy();
+
+		FramebufferSpec				m_spec;
+		unsigned int				m_id				= 0;
+		std::vector<unsigned int>	m_colorAttachments;
+		unsigned int				m_depthAttachment	= 0;
+		std::string					m_label;
+	};
+
+} // namespace Engine
@@ -0,0 +1,160 @@
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	struct GpuDeletionEntry {
+		GpuResourceCategory	category;
+		uint32_t			id;
+	};
+
+	/// Объекты одного кадра и fence после его последних команд.
+	struct GpuDeletionBatch {
+		GLsync							fence;
+		std::vector<GpuDeletionEntry>	entries;
+	};
+
+	static std::mutex								s_mutex;
+	static std::vector<GpuDeletionEntry>			s_pending;		///< Под s_mutex.
+
+	// Дальше - только поток с контекстом OpenGL.
+	static std::deque<GpuDeletionBatch>				s_batches;
+	static std::vector<std::vector<GpuDeletionEntry>>	s_freeLists;	///< Векторы для повторного использования.
+	static std::vector<GLuint>						s_buffers;
+	static std::vector<GLuint>						s_vertexArrays;
+	static std::vector<GLuint>						s_textures;
+	static std::vector<GLuint>						s_framebuffers;
+	static uint32_t									s_deletedLastFrame	= 0;
+	static uint64_t									s_deletedTotal		= 0;
+
+	static std::vector<GpuDeletionEntry> acquireList() {
+		if (s_freeLists.empty()) {
+			return {};
+		}
+		std::vector<GpuDeletionEntry> list = std::move(s_freeLists.back());
+		s_freeLists.pop_back();
+		return list;
+	}
+
+	static void recycleList(std::vector<GpuDeletionEntry>&& list) {
+		list.clear();
+		s_freeLists.push_back(std::move(list));
+	}
+
+	/// Удаляет объекты пачками по типу: один вызов glDelete* на категорию.
+	static void deleteEntries(const std::vector<GpuDeletionEntry>& entries) {
+		s_buffers.clear();
+		s_vertexArrays.clear();
+		s_textures.clear();
+		s_framebuffers.clear();
+
+		for (const GpuDeletionEntry& entry : entries) {
+			GpuResourceRegistry::remove(entry.category, entry.id);
+			switch (entry.category) {
+			case GpuResourceCategory::Buffer:		s_buffers.push_back(entry.id);			break;
+			case GpuResourceCategory::VertexArray:	s_vertexArrays.push_back(entry.id);		break;
+			case GpuResourceCategory::Texture:		s_textures.push_back(entry.id);			break;
+			case GpuResourceCategory::Framebuffer:	s_framebuffers.push_back(entry.id);		break;
+			case GpuResourceCategory::Program:		glDeleteProgram(entry.id);				break;
+			}
+		}
+
+		if (!s_buffers.empty()) {
+			glDeleteBuffers(static_cast<GLsizei>(s_buffers.size()), s_buffers.data());
+		}
+		if (!s_vertexArrays.empty()) {
+			glDeleteVertexArrays(static_cast<GLsizei>(s_vertexArrays.size()), s_vertexArrays.data());
+		}
+		if (!s_textures.empty()) {
+			glDeleteTextures(static_cast<GLsizei>(s_textures.size()), s_textures.data());
+		}
+		if (!s_framebuffers.empty()) {
+			glDeleteFramebuffers(static_cast<GLsizei>(s_framebuffers.size()), s_framebuffers.data());
+		}
+
+		s_deletedLastFrame += static_cast<uint32_t>(entries.size());
+		s_deletedTotal += entries.size();
+	}
+
+	void GpuDeletionQueue::release(const GpuResourceCategory category, const uint32_t id) {
+		if (id == 0) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(s_mutex);
+		s_pending.push_back({ category, id });
+	}
+
+	void GpuDeletionQueue::update() {
+		s_deletedLastFrame = 0;
+
+		// Обмен с пустым вектором: под блокировкой нет ни копирования, ни выделений.
+		std::vector<GpuDeletionEntry> entries = acquireList();
+		{
+			std::lock_guard<std::mutex> lock(s_mutex);
+			std::swap(entries, s_pending);
+		}
+		if (entries.empty()) {
+			recycleList(std::move(entries));
+		}
+		else {
+			s_batches.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), std::move(entries) });
+		}
+
+		while (!s_batches.empty()) {
+			GpuDeletionBatch& batch = s_batches.front();
+			const GLenum result = glClientWaitSync(batch.fence, 0, 0);
+			if (result == GL_TIMEOUT_EXPIRED) {
+				break;
+			}
+			if (result == GL_WAIT_FAILED) {
+				// glDelete* безопасен и без fence: драйвер сам отложит удаление, но может остановить поток.
+				LOG_WARN("[GpuDeletionQueue] Fence wait failed, deleting {0} objects without it", batch.entries.size());
+			}
+			glDeleteSync(batch.fence);
+			deleteEntries(batch.entries);
+			recycleList(std::move(batch.entries));
+			s_batches.pop_front();
+		}
+	}
+
+	void GpuDeletionQueue::flush() {
+		glFinish();
+		for (GpuDeletionBatch& batch : s_batches) {
+			glDeleteSync(batch.fence);
+			deleteEntries(batch.entries);
+		}
+		s_batches.clear();
+
+		std::vector<GpuDeletionEntry> entries;
+		{
+			std::lock_guard<std::mutex> lock(s_mutex);
+			std::swap(entries, s_pending);
+		}
+		deleteEntries(entries);
+		s_freeLists.clear();
+	}
+
+	GpuDeletionStats GpuDeletionQueue::getStats() {
+		GpuDeletionStats stats;
+		{
+			std::lock_guard<std::mutex> lock(s_mutex);
+			stats.pending = static_cast<uint32_t>(s_pending.size());
+		}
+		for (const GpuDeletionBatch& batch : s_batches) {
+			stats.inFlight += static_cast<uint32_t>(batch.entries.size());
+		}
+		stats.batches = static_cast<uint32_t>(s_batches.size());
+		stats.deletedLastFrame = s_deletedLastFrame;
+		stats.deletedTotal = s_deletedTotal;
+		return stats;
+	}
+
+} // namespace Engine
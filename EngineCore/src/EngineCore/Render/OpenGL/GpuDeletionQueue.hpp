@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+
+#include "EngineCore/Render/OpenGL/GpuResourceRegistry.hpp"
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Статистика очереди удаления.
+	 */
+	struct GpuDeletionStats {
+		uint32_t	pending			= 0;	///< Ожидают конца кадра.
+		uint32_t	inFlight		= 0;	///< Ожидают fence своего кадра.
+		uint32_t	batches			= 0;	///< Кадров с fence в очереди.
+		uint32_t	deletedLastFrame= 0;	///< Удалено в последнем `update()`.
+		uint64_t	deletedTotal	= 0;
+	};
+
+	/**
+	 * @internal
+	 * @brief Отложенное удаление объектов OpenGL.
+	 *
+	 * `glDelete*` сразу после последнего использования объекта может остановить
+	 * поток рендера, пока GPU не закончит кадр, и требует текущий контекст.
+	 * Обёртки (буферы, `VertexArray`, `ShaderProgram`, текстуры, `Framebuffer`)
+	 * и пул `FrameGraph` вместо этого передают идентификатор в очередь из любого потока.
+	 *
+	 * `update()` раз в кадр закрывает накопленные за прошлый кадр объекты fence-ом
+	 * (все команды, которые могли их использовать, к этому моменту отправлены)
+	 * и удаляет пачками объекты тех кадров, чьи fence уже сработали. Проверка
+	 * fence не ждёт GPU. Запись в `GpuResourceRegistry` удаляется вместе
+	 * с объектом, поэтому реестр учитывает память, которую GPU ещё держит.
+	 *
+	 * @note `release()` потокобезопасен, `update()` и `flush()` вызываются только
+	 * из потока с контекстом OpenGL.
+	 */
+	class GpuDeletionQueue {
+	public:
+		/// @internal
+		/// @brief Ставит объект в очередь на удаление (0 игнорируется).
+		/// @param category Категория объекта: определяет вызов `glDelete*`.
+		static void release(GpuResourceCategory category, uint32_t id);
+
+		/// @internal
+		/// @brief Ставит fence для объектов прошлого кадра и удаляет готовые.
+		///
+		/// Вызывается в начале `Window::update()`.
+		static void update();
+
+		/// @internal
+		/// @brief Дожидается GPU и удаляет всё (перед уничтожением контекста).
+		static void flush();
+
+		static GpuDeletionStats getStats();
+	};
+
+} // namespace Engine
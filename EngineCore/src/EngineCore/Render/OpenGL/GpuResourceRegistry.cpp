@@ -0,0 +1,349 @@
+#include "EngineCore/Render/OpenGL/GpuResourceRegistry.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
+#include <glad/glad.h>
+#include <imgui/imgui.h>
+
+#include "EngineCore/Core/JsonWriter.hpp"
+#include "EngineCore/Log.hpp"
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Бюджет категории и его текущее состояние.
+	struct GpuBudget {
+		uint64_t		bytes			= 0;
+		GpuBudgetAction	action			= GpuBudgetAction::Warn;
+		bool			bExceeded		= false;
+	};
+
+	/// @internal
+	/// @brief Зарегистрированный обработчик вытеснения.
+	struct EvictionHandler {
+		uint32_t								handle;
+		GpuResourceCategory						category;
+		GpuResourceRegistry::EvictionCallback	callback;
+	};
+
+	/// @internal
+	/// @brief Итоги по категории.
+	struct GpuCategoryTotals {
+		uint64_t	bytes	= 0;
+		uint32_t	count	= 0;
+	};
+
+	static std::mutex											s_mutex;
+	static std::unordered_map<uint64_t, GpuResourceInfo>		s_resources;
+	static std::array<GpuCategoryTotals, GpuResourceCategoryCount>	s_totals;
+	static std::array<GpuBudget, GpuResourceCategoryCount>		s_budgets;
+	static std::vector<EvictionHandler>							s_evictionHandlers;
+	static uint32_t												s_nextEvictionHandle	= 1;
+	static uint64_t												s_frame					= 0;
+
+	/// @internal
+	/// @brief Номер текущего кадра (читается под `s_mutex`: кадр меняется в `update()`).
+	static uint64_t getCurrentFrame() {
+		std::lock_guard<std::mutex> lock(s_mutex);
+		return s_frame;
+	}
+
+	/// @internal
+	/// @brief Ключ ресурса: категория в старших битах, идентификатор OpenGL - в младших.
+	static uint64_t makeKey(GpuResourceCategory category, uint32_t id) {
+		return (static_cast<uint64_t>(category) << 32) | id;
+	}
+
+	/// @internal
+	/// @brief Переводит категорию в пространство имён `glObjectLabel`.
+	static GLenum categoryToGLIdentifier(GpuResourceCategory category) {
+		switch (category)
+		{
+		case GpuResourceCategory::Buffer:		return GL_BUFFER;
+		case GpuResourceCategory::Texture:		return GL_TEXTURE;
+		case GpuResourceCategory::Program:		return GL_PROGRAM;
+		case GpuResourceCategory::VertexArray:	return GL_VERTEX_ARRAY;
+		case GpuResourceCategory::Framebuffer:	return GL_FRAMEBUFFER;
+		}
+		return GL_BUFFER;
+	}
+
+	const char* GpuResourceRegistry::getCategoryName(GpuResourceCategory category) noexcept {
+		switch (category)
+		{
+		case GpuResourceCategory::Buffer:		return "Buffer";
+		case GpuResourceCategory::Texture:		return "Texture";
+		case GpuResourceCategory::Program:		return "Program";
+		case GpuResourceCategory::VertexArray:	return "VertexArray";
+		case GpuResourceCategory::Framebuffer:	return "Framebuffer";
+		}
+		return "Unknown";
+	}
+
+	void GpuResourceRegistry::add(GpuResourceCategory category, uint32_t id, uint64_t bytes, const char* usage) {
+		if (id == 0) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(s_mutex);
+
+		GpuCategoryTotals& totals = s_totals[static_cast<size_t>(category)];
+		auto [it, bInserted] = s_resources.try_emplace(makeKey(category, id));
+		GpuResourceInfo& info = it->second;
+
+		if (bInserted) {
+			info.category		= category;
+			info.id				= id;
+			info.bytes			= 0;
+			info.createdFrame	= s_frame;
+			++totals.count;
+		}
+
+		totals.bytes = totals.bytes - info.bytes + bytes;
+		info.bytes = bytes;
+		info.usage = usage;
+	}
+
+	void GpuResourceRegistry::remove(GpuResourceCategory category, uint32_t id) {
+		if (id == 0) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(s_mutex);
+
+		auto it = s_resources.find(makeKey(category, id));
+		if (it == s_resources.end()) {
+			LOG_WARN("Removing unregistered {0} {1}", getCategoryName(category), id);
+			return;
+		}
+
+		GpuCategoryTotals& totals = s_totals[static_cast<size_t>(category)];
+		totals.bytes -= it->second.bytes;
+		--totals.count;
+		s_resources.erase(it);
+	}
+
+	void GpuResourceRegistry::setLabel(GpuResourceCategory category, uint32_t id, const std::string& label) {
+		{
+			std::lock_guard<std::mutex> lock(s_mutex);
+			auto it = s_resources.find(makeKey(category, id));
+			if (it != s_resources.end()) {
+				it->second.label = label;
+			}
+		}
+
+		// glObjectLabel доступен начиная с OpenGL 4.3.
+		if (glObjectLabel) {
+			glObjectLabel(categoryToGLIdentifier(category), id, static_cast<GLsizei>(label.size()), label.c_str());
+		}
+	}
+
+	void GpuResourceRegistry::setBudget(GpuResourceCategory category, uint64_t bytes, GpuBudgetAction action) {
+		std::lock_guard<std::mutex> lock(s_mutex);
+		GpuBudget& budget = s_budgets[static_cast<size_t>(category)];
+		budget.bytes = bytes;
+		budget.action = action;
+		budget.bExceeded = false;
+	}
+
+	uint32_t GpuResourceRegistry::addEvictionCallback(GpuResourceCategory category, EvictionCallback callback) {
+		std::lock_guard<std::mutex> lock(s_mutex);
+		const uint32_t handle = s_nextEvictionHandle++;
+		s_evictionHandlers.push_back({ handle, category, std::move(callback) });
+		return handle;
+	}
+
+	void GpuResourceRegistry::removeEvictionCallback(uint32_t handle) {
+		std::lock_guard<std::mutex> lock(s_mutex);
+		s_evictionHandlers.erase(
+			std::remove_if(s_evictionHandlers.begin(), s_evictionHandlers.end(),
+				[handle](const EvictionHandler& handler) { return handler.handle == handle; }),
+			s_evictionHandlers.end()
+		);
+	}
+
+	void GpuResourceRegistry::update() {
+		std::vector<std::pair<GpuResourceCategory, uint64_t>> evictions;
+		std::vector<EvictionHandler> handlers;
+		{
+			std::lock_guard<std::mutex> lock(s_mutex);
+			++s_frame;
+
+			for (uint8_t i = 0; i < GpuResourceCategoryCount; ++i) {
+				GpuBudget& budget = s_budgets[i];
+				const uint64_t total = s_totals[i].bytes;
+				const GpuResourceCategory category = static_cast<GpuResourceCategory>(i);
+
+				if (budget.bytes == 0 || total <= budget.bytes) {
+					budget.bExceeded = false;
+					continue;
+				}
+
+				// Предупреждение выводится один раз при пересечении границы.
+				if (!budget.bExceeded) {
+					LOG_WARN(
+						"GPU budget exceeded for {0}: {1} / {2} bytes",
+						getCategoryName(category), total, budget.bytes
+					);
+					budget.bExceeded = true;
+				}
+
+				if (budget.action == GpuBudgetAction::Evict) {
+					evictions.emplace_back(category, total - budget.bytes);
+				}
+			}
+
+			if (!evictions.empty()) {
+				handlers = s_evictionHandlers;
+			}
+		}
+
+		// Обработчики вызываются без блокировки: они освобождают ресурсы и обращаются к реестру.
+		for (const auto& [category, bytesOver] : evictions) {
+			for (const EvictionHandler& handler : handlers) {
+				if (handler.category == category) {
+					handler.callback(category, bytesOver);
+				}
+			}
+		}
+	}
+
+	uint64_t GpuResourceRegistry::getTotalBytes(GpuResourceCategory category) {
+		std::lock_guard<std::mutex> lock(s_mutex);
+		return s_totals[static_cast<size_t>(category)].bytes;
+	}
+
+	uint32_t GpuResourceRegistry::getCount(GpuResourceCategory category) {
+		std::lock_guard<std::mutex> lock(s_mutex);
+		return s_totals[static_cast<size_t>(category)].count;
+	}
+
+	std::vector<GpuResourceInfo> GpuResourceRegistry::getSnapshot() {
+		std::vector<GpuResourceInfo> snapshot;
+		{
+			std::lock_guard<std::mutex> lock(s_mutex);
+			snapshot.reserve(s_resources.size());
+			for (const auto& [key, info] : s_resources) {
+				snapshot.push_back(info);
+			}
+		}
+
+		// Стабильный порядок, чтобы снимки разных запусков можно было сравнивать diff-ом.
+		std::sort(snapshot.begin(), snapshot.end(), [](const GpuResourceInfo& a, const GpuResourceInfo& b) {
+			if (a.category != b.category) {
+				return a.category < b.category;
+			}
+			if (a.label != b.label) {
+				return a.label < b.label;
+			}
+			if (a.bytes != b.bytes) {
+				return a.bytes > b.bytes;
+			}
+			if (a.createdFrame != b.createdFrame) {
+				return a.createdFrame < b.createdFrame;
+			}
+			return a.id < b.id;
+		});
+		return snapshot;
+	}
+
+	bool GpuResourceRegistry::dumpSnapshot(const std::string& path) {
+		std::ofstream file(path);
+		if (!file) {
+			LOG_ERR("Can not open {0} for GPU resource snapshot", path);
+			return false;
+		}
+
+		const std::vector<GpuResourceInfo> snapshot = getSnapshot();
+		uint64_t frame = 0;
+		std::array<GpuCategoryTotals, GpuResourceCategoryCount> totals;
+		{
+			std::lock_guard<std::mutex> lock(s_mutex);
+			frame = s_frame;
+			totals = s_totals;
+		}
+
+		JsonWriter json(file);
+		json.beginObject();
+		json.key("frame").value(frame);
+
+		json.key("totals").beginObject();
+		for (uint8_t i = 0; i < GpuResourceCategoryCount; ++i) {
+			json.key(getCategoryName(static_cast<GpuResourceCategory>(i))).beginObject();
+			json.key("count").value(totals[i].count);
+			json.key("bytes").value(totals[i].bytes);
+			json.endObject();
+		}
+		json.endObject();
+
+		json.key("resources").beginArray();
+		for (const GpuResourceInfo& info : snapshot) {
+			json.beginObject();
+			json.key("category").value(getCategoryName(info.category));
+			json.key("id").value(info.id);
+			json.key("bytes").value(info.bytes);
+			json.key("usage").value(info.usage);
+			json.key("label").value(info.label);
+			json.key("createdFrame").value(info.createdFrame);
+			json.endObject();
+		}
+		json.endArray();
+		json.endObject();
+		file << '\n';
+
+		LOG_INFO("GPU resource snapshot ({0} resources) saved to {1}", snapshot.size(), path);
+		return true;
+	}
+
+	void GpuResourceRegistry::drawImGuiPanel() {
+		ImGui::Begin("Видеопамять");
+
+		if (ImGui::BeginTable("gpu_totals", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+			ImGui::TableSetupColumn("Категория");
+			ImGui::TableSetupColumn("Кол-во");
+			ImGui::TableSetupColumn("МБ");
+			ImGui::TableSetupColumn("Бюджет");
+			ImGui::TableHeadersRow();
+
+			std::lock_guard<std::mutex> lock(s_mutex);
+			for (uint8_t i = 0; i < GpuResourceCategoryCount; ++i) {
+				const GpuCategoryTotals& totals = s_totals[i];
+				const GpuBudget& budget = s_budgets[i];
+
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(getCategoryName(static_cast<GpuResourceCategory>(i)));
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", totals.count);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", totals.bytes / (1024.0 * 1024.0));
+				ImGui::TableNextColumn();
+				if (budget.bytes > 0) {
+					ImGui::ProgressBar(static_cast<float>(totals.bytes) / static_cast<float>(budget.bytes));
+				}
+				else {
+					ImGui::TextUnformatted("-");
+				}
+			}
+			ImGui::EndTable();
+		}
+
+		const GpuDeletionStats deletion = GpuDeletionQueue::getStats();
+		ImGui::Text(
+			"Ожидают удаления: %u (в пути %u, кадров %u), удалено за кадр: %u",
+			deletion.pending + deletion.inFlight, deletion.inFlight, deletion.batches, deletion.deletedLastFrame
+		);
+
+		if (ImGui::Button("Сохранить снимок в JSON")) {
+			dumpSnapshot("gpu_resources_" + std::to_string(getCurrentFrame()) + ".json");
+		}
+
+		ImGui::End();
+	}
+
+} // namespace Engine
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Категория GPU ресурса.
+	 */
+	enum class GpuResourceCategory : uint8_t {
+		Buffer = 0,		///< Буферы (VBO, IBO, UBO, SSBO, PBO).
+		Texture,		///< Текстуры.
+		Program,		///< Шейдерные программы.
+		VertexArray,	///< VAO (памяти почти не занимают, учитывается кол-во).
+		Framebuffer,	///< FBO и renderbuffer-ы.
+	};
+
+	constexpr uint8_t GpuResourceCategoryCount = 5;
+
+	/**
+	 * @internal
+	 * @brief Запись о GPU ресурсе.
+	 */
+	struct GpuResourceInfo {
+		GpuResourceCategory	category;		///< Категория ресурса.
+		uint32_t			id;				///< Идентификатор объекта OpenGL.
+		uint64_t			bytes;			///< Оценка занимаемой видеопамяти в байтах.
+		std::string			usage;			///< Тип использования (например, "static", "stream").
+		std::string			label;			///< Отладочное имя.
+		uint64_t			createdFrame;	///< Кадр создания.
+	};
+
+	/**
+	 * @internal
+	 * @brief Действие при превышении бюджета категории.
+	 */
+	enum class GpuBudgetAction : uint8_t {
+		Warn,	///< Только предупреждение в лог.
+		Evict	///< Предупреждение и вызов обработчиков вытеснения.
+	};
+
+	/**
+	 * @internal
+	 * @brief Реестр GPU ресурсов: учёт видеопамяти и контроль бюджетов.
+	 *
+	 * Каждая обёртка над объектом OpenGL (`VertexBuffer`, `VertexArray`,
+	 * `ShaderProgram`, текстуры) регистрирует себя при создании и удаляет
+	 * запись при уничтожении. Реестр позволяет:
+	 * - Видеть суммарный объём по категориям в ImGui окне.
+	 * - Задавать бюджеты, при превышении которых выводятся предупреждения
+	 *   или вызываются обработчики вытеснения.
+	 * - Сохранять снимок всех ресурсов в JSON для сравнения между запусками.
+	 *
+	 * @note Методы потокобезопасны.
+	 */
+	class GpuResourceRegistry {
+	public:
+		using EvictionCallback = std::function<void(GpuResourceCategory category, uint64_t bytesOverBudget)>;
+
+		/// @internal
+		/// @brief Регистрирует ресурс (или обновляет уже зарегистрированный).
+		/// @param category Категория ресурса.
+		/// @param id Идентификатор объекта OpenGL.
+		/// @param bytes Объём видеопамяти в байтах.
+		/// @param usage Тип использования.
+		static void add(GpuResourceCategory category, uint32_t id, uint64_t bytes, const char* usage = "");
+
+		/// @internal
+		/// @brief Удаляет запись о ресурсе.
+		static void remove(GpuResourceCategory category, uint32_t id);
+
+		/// @internal
+		/// @brief Задаёт отладочное имя ресурса (также передаётся в `glObjectLabel`).
+		static void setLabel(GpuResourceCategory category, uint32_t id, const std::string& label);
+
+		/// @internal
+		/// @brief Устанавливает бюджет категории.
+		/// @param category Категория ресурсов.
+		/// @param bytes Бюджет в байтах (0 - без ограничения).
+		/// @param action Действие при превышении.
+		static void setBudget(GpuResourceCategory category, uint64_t bytes, GpuBudgetAction action = GpuBudgetAction::Warn);
+
+		/// @internal
+		/// @brief Добавляет обработчик вытеснения для категории.
+		/// @return Идентификатор обработчика для `removeEvictionCallback()`.
+		static uint32_t addEvictionCallback(GpuResourceCategory category, EvictionCallback callback);
+		static void removeEvictionCallback(uint32_t handle);
+
+		/// @internal
+		/// @brief Проверяет бюджеты. Вызывается раз в кадр.
+		///
+		/// Обработчики вытеснения вызываются здесь, а не при регистрации ресурса,
+		/// чтобы они не срабатывали посреди конструктора другого ресурса.
+		static void update();
+
+		/// @internal
+		/// @brief Суммарный объём категории в байтах.
+		static uint64_t getTotalBytes(GpuResourceCategory category);
+
+		/// @internal
+		/// @brief Кол-во ресурсов категории.
+		static uint32_t getCount(GpuResourceCategory category);
+
+		/// @internal
+		/// @brief Возвращает копию всех записей.
+		static std::vector<GpuResourceInfo> getSnapshot();
+
+		/// @internal
+		/// @brief Сохраняет снимок реестра в JSON файл.
+		/// @return true, если файл записан.
+		static bool dumpSnapshot(const std::string& path);
+
+		/// @internal
+		/// @brief Рисует ImGui окно с объёмами по категориям.
+		static void drawImGuiPanel();
+
+		static const char* getCategoryName(GpuResourceCategory category) noexcept;
+	};
+
+} // namespace Engine
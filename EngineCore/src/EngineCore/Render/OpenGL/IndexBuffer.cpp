@@ -0,0 +1,79 @@
+#include "EngineCore/Render/OpenGL/IndexBuffer.hpp"
+
+#include <glad/glad.h>
+
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+#include "EngineCore/Render/OpenGL/GpuResourceRegistry.hpp"
+#include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
+
+namespace Engine {
+
+	IndexBuffer::IndexBuffer(const uint16_t* pIndices, const size_t count)
+		: m_count(count)
+		, m_type(EType::UInt16)
+	{
+		create(pIndices, count * sizeof(uint16_t));
+	}
+
+	IndexBuffer::IndexBuffer(const uint32_t* pIndices, const size_t count)
+		: m_count(count)
+		, m_type(EType::UInt32)
+	{
+		create(pIndices, count * sizeof(uint32_t));
+	}
+
+	void IndexBuffer::create(const void* pData, const size_t size) {
+		if (hasDirectStateAccess()) {
+			glCreateBuffers(1, &m_id);
+			glNamedBufferStorage(m_id, size, pData, 0);
+		}
+		else {
+			// Привязка GL_ELEMENT_ARRAY_BUFFER - состояние VAO, поэтому текущий VAO сбрасывается.
+			glBindVertexArray(0);
+			glGenBuffers(1, &m_id);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, pData, GL_STATIC_DRAW);
+		}
+
+		GpuResourceRegistry::add(GpuResourceCategory::Buffer, m_id, size, "index");
+	}
+
+	IndexBuffer::~IndexBuffer() {
+		GpuDeletionQueue::release(GpuResourceCategory::Buffer, m_id);
+	}
+
+	IndexBuffer::IndexBuffer(IndexBuffer&& rhs) noexcept
+		: m_id(rhs.m_id)
+		, m_count(rhs.m_count)
+		, m_type(rhs.m_type)
+	{
+		rhs.m_id = 0;
+		rhs.m_count = 0;
+	}
+
+	IndexBuffer& IndexBuffer::operator=(IndexBuffer&& rhs) noexcept {
+		if (this != &rhs) {
+			GpuDeletionQueue::release(GpuResourceCategory::Buffer, m_id);
+
+			m_id = rhs.m_id;
+			m_count = rhs.m_count;
+			m_type = rhs.m_type;
+			rhs.m_id = 0;
+			rhs.m_count = 0;
+		}
+		return *this;
+	}
+
+	void IndexBuffer::bind() const noexcept {
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
+	}
+
+	uint32_t IndexBuffer::getGLType() const noexcept {
+		return m_type == EType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	}
+
+	void IndexBuffer::setLabel(const std::string& label) {
+		GpuResourceRegistry::setLabel(GpuResourceCategory::Buffer, m_id, label);
+	}
+
+} // namespace Engine
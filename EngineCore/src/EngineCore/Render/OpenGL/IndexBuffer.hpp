@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Класс, инкапсулирующий буфер индексов (`GL_ELEMENT_ARRAY_BUFFER`).
+	///
+	/// Хранилище неизменяемое: индексы задаются при создании. Буфер подключается
+	/// к VAO через `VertexArray::setIndexBuffer()`.
+	class IndexBuffer {
+	public:
+		/// @internal
+		/// @brief Тип индекса.
+		enum class EType : uint8_t {
+			UInt16,		///< `GL_UNSIGNED_SHORT`, до 65536 вершин.
+			UInt32		///< `GL_UNSIGNED_INT`.
+		};
+
+		/// @internal
+		/// @brief Создаёт буфер из 16-битных индексов.
+		/// @param pIndices Индексы.
+		/// @param count Кол-во индексов.
+		IndexBuffer(const uint16_t* pIndices, size_t count);
+
+		/// @internal
+		/// @brief Создаёт буфер из 32-битных индексов.
+		/// @param pIndices Индексы.
+		/// @param count Кол-во индексов.
+		IndexBuffer(const uint32_t* pIndices, size_t count);
+
+		~IndexBuffer();
+
+		IndexBuffer(IndexBuffer&& rhs) noexcept;
+		IndexBuffer& operator=(IndexBuffer&& rhs) noexcept;
+
+		IndexBuffer(const IndexBuffer&)				= delete;
+		IndexBuffer& operator=(const IndexBuffer&)	= delete;
+
+		/// @internal
+		/// @brief Устанавливает буфер в контексте OpenGL (к текущему VAO).
+		void bind() const noexcept;
+
+		/// @internal
+		/// @brief Возвращает идентификатор буфера OpenGL.
+		unsigned int getId() const noexcept { return m_id; }
+
+		/// @internal
+		/// @brief Возвращает кол-во индексов.
+		size_t getCount() const noexcept { return m_count; }
+
+		EType getType() const noexcept { return m_type; }
+
+		/// @internal
+		/// @brief Возвращает тип индекса для `glDrawElements*` (GLenum).
+		uint32_t getGLType() const noexcept;
+
+		/// @internal
+		/// @brief Задаёт отладочное имя буфера (видно в реестре ресурсов и GL отладчиках).
+		void setLabel(const std::string& label);
+
+	private:
+		void create(const void* pData, size_t size);
+
+		unsigned int	m_id		= 0;
+		size_t			m_count		= 0;
+		EType			m_type		= EType::UInt16;
+	};
+
+} // namespace Engine
@@ -5,6 +5,9 @@
 #include <glad/glad.h>
 
 #include "EngineCore/Log.hpp"
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+#include "EngineCore/Render/OpenGL/GpuResourceRegistry.hpp"
+#include "EngineCore/Render/RenderStats.hpp"
 
 namespace Engine {
 
@@ -17,12 +20,15 @@ namespace Engine {
 	}
 
 	ShaderProgram& ShaderProgram::operator=(ShaderProgram&& rhs) {
-		glDeleteProgram(m_id);
-		m_id = rhs.m_id;
-		m_isCompiled = rhs.m_isCompiled;
+		if (this != &rhs) {
+			GpuDeletionQueue::release(GpuResourceCategory::Program, m_id);
 
-		rhs.m_id = 0;
-		rhs.m_isCompiled = false;
+			m_id = rhs.m_id;
+			m_isCompiled = rhs.m_isCompiled;
+
+			rhs.m_id = 0;
+			rhs.m_isCompiled = false;
+		}
 		return *this;
 	}
 
@@ -55,7 +61,7 @@ namespace Engine {
 	}
 	
 	ShaderProgram::~ShaderProgram() {
-		glDeleteProgram(m_id);
+		GpuDeletionQueue::release(GpuResourceCategory::Program, m_id);
 	}
 
 	ShaderProgram::ShaderProgram(
@@ -98,20 +104,98 @@ namespace Engine {
 
 		m_isCompiled = true;
 
+		// Точный объём программы в видеопамяти неизвестен, оценкой служит размер её бинарника.
+		GLint binaryLength = 0;
+		glGetProgramiv(m_id, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+		GpuResourceRegistry::add(GpuResourceCategory::Program, m_id, static_cast<uint64_t>(binaryLength));
+
 		glDetachShader(m_id, vertexShader);
 		glDetachShader(m_id, fragmentShader);
 		glDeleteShader(vertexShader);
 		glDeleteShader(fragmentShader);
 	}
 
+	ShaderProgram::ShaderProgram(const char* computeShaderSource) {
+		GLuint computeShader = 0;
+		if (!createShader(computeShaderSource, GL_COMPUTE_SHADER, computeShader)) {
+			LOG_CRIT("Compute shader comlile-time error!");
+			glDeleteShader(computeShader);
+			return;
+		}
+
+		m_id = glCreateProgram();
+		glAttachShader(m_id, computeShader);
+		glLinkProgram(m_id);
+
+		GLint success;
+		glGetProgramiv(m_id, GL_LINK_STATUS, &success);
+		if (success == GL_FALSE) {
+			char infoLog[1024];
+			glGetProgramInfoLog(m_id, 1024, nullptr, infoLog);
+
+			std::string log(infoLog);
+			LOG_CRIT("Compute program link error:\n{}", log);
+			glDeleteProgram(m_id);
+			m_id = 0;
+			glDeleteShader(computeShader);
+			return;
+		}
+
+		m_isCompiled = true;
+
+		GLint binaryLength = 0;
+		glGetProgramiv(m_id, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+		GpuResourceRegistry::add(GpuResourceCategory::Program, m_id, static_cast<uint64_t>(binaryLength), "compute");
+
+		glDetachShader(m_id, computeShader);
+		glDeleteShader(computeShader);
+	}
+
 	void ShaderProgram::bind() const noexcept {
 		glUseProgram(m_id);
+		RenderStats::addProgramBind();
 	}
 
 	void ShaderProgram::unbind() noexcept {
 		glUseProgram(0);
 	}
 
+	int ShaderProgram::getUniformLocation(const char* name) const noexcept {
+		return glGetUniformLocation(m_id, name);
+	}
+
+	void ShaderProgram::setMatrix4(const int location, const float* pMatrix) const noexcept {
+		if (!GLAD_GL_VERSION_4_1) {
+			bind();
+			glUniformMatrix4fv(location, 1, GL_FALSE, pMatrix);
+			return;
+		}
+		glProgramUniformMatrix4fv(m_id, location, 1, GL_FALSE, pMatrix);
+	}
+
+	void ShaderProgram::setFloat4(const int location, const float x, const float y, const float z, const float w) const noexcept {
+		if (!GLAD_GL_VERSION_4_1) {
+			bind();
+			glUniform4f(location, x, y, z, w);
+			return;
+		}
+		glProgramUniform4f(m_id, location, x, y, z, w);
+	}
+
+	void ShaderProgram::dispatch(const unsigned int x, const unsigned int y, const unsigned int z) const noexcept {
+		bind();
+		glDispatchCompute(x, y, z);
+	}
+
+	void ShaderProgram::dispatchIndirect(const size_t offset) const noexcept {
+		bind();
+		glDispatchComputeIndirect(static_cast<GLintptr>(offset));
+	}
+
+	void ShaderProgram::setLabel(const std::string& label) {
+		GpuResourceRegistry::setLabel(GpuResourceCategory::Program, m_id, label);
+	}
+
 	
 
 } // namespace Engine
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <string>
+
 namespace Engine {
 	
 	/**
@@ -27,6 +30,15 @@ namespace Engine {
 			const char* vertexShaderSource,
 			const char* FragmentShaderSource
 		);
+
+		/**
+		 * @internal
+		 * @brief Создаёт вычислительную программу из одного compute шейдера.
+		 * 
+		 * @param [in] computeShaderSource Код compute шейдера (OpenGL 4.3+).
+		 */
+		explicit ShaderProgram(const char* computeShaderSource);
+
 		ShaderProgram(ShaderProgram&&);
 		ShaderProgram& operator=(ShaderProgram&&);
 		~ShaderProgram();
@@ -48,6 +60,35 @@ namespace Engine {
 		/// @return Состояние компиляции (true - успешно).
 		bool isCompiled() const noexcept { return m_isCompiled; }
 
+		/// @internal
+		/// @brief Возвращает расположение uniform по имени (-1, если его нет).
+		/// @note Нужно шейдерам без `layout(location = N)` у uniform (GLSL до 4.30).
+		int getUniformLocation(const char* name) const noexcept;
+
+		/// @internal
+		/// @brief Задаёт uniform-матрицу 4x4 (column-major) без привязки программы.
+		/// @note До OpenGL 4.1 (без `glProgramUniform*`) программа привязывается.
+		/// @param location Расположение uniform (`layout(location = N)` в шейдере).
+		/// @param pMatrix 16 float, например `Mat4::data()`.
+		void setMatrix4(int location, const float* pMatrix) const noexcept;
+
+		/// @internal
+		/// @brief Задаёт uniform `vec4` без привязки программы (см. `setMatrix4()`).
+		void setFloat4(int location, float x, float y, float z, float w) const noexcept;
+
+		/// @internal
+		/// @brief Запускает вычислительную программу на сетке `x * y * z` групп.
+		void dispatch(unsigned int x, unsigned int y = 1, unsigned int z = 1) const noexcept;
+
+		/// @internal
+		/// @brief Запускает вычислительную программу с числом групп из `GL_DISPATCH_INDIRECT_BUFFER`.
+		/// @param offset Смещение аргументов (3 x uint) в буфере.
+		void dispatchIndirect(size_t offset) const noexcept;
+
+		/// @internal
+		/// @brief Задаёт отладочное имя программы (видно в реестре ресурсов и GL отладчиках).
+		void setLabel(const std::string& label);
+
 	private:
 		unsigned int	m_id 			= 0;
 		bool 			m_isCompiled	= false;
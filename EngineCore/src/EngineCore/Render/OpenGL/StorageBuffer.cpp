@@ -0,0 +1,144 @@
+#include "EngineCore/Render/OpenGL/StorageBuffer.hpp"
+
+#include <glad/glad.h>
+
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+#include "EngineCore/Render/OpenGL/GpuResourceRegistry.hpp"
+#include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
+
+namespace Engine {
+
+	static const char* usageToString(const StorageBuffer::EUsage usage) {
+		switch (usage)
+		{
+		case StorageBuffer::EUsage::GpuOnly :
+			return "storage";
+		case StorageBuffer::EUsage::Dynamic :
+			return "storage dynamic";
+		case StorageBuffer::EUsage::Readback :
+			return "readback";
+		}
+		return "unknown";
+	}
+
+	StorageBuffer::StorageBuffer(const void* data, const size_t size, const EUsage usage)
+		: m_size(size)
+	{
+		const GLbitfield mapFlags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		GLbitfield flags = 0;
+		switch (usage)
+		{
+		case EUsage::GpuOnly :
+			break;
+		case EUsage::Dynamic :
+			flags = GL_DYNAMIC_STORAGE_BIT;
+			break;
+		case EUsage::Readback :
+			flags = mapFlags | GL_CLIENT_STORAGE_BIT;
+			break;
+		}
+
+		if (hasDirectStateAccess()) {
+			glCreateBuffers(1, &m_id);
+			glNamedBufferStorage(m_id, static_cast<GLsizeiptr>(size), data, flags);
+			if (usage == EUsage::Readback) {
+				m_pMapped = glMapNamedBufferRange(m_id, 0, static_cast<GLsizeiptr>(size), mapFlags);
+			}
+		}
+		else {
+			glGenBuffers(1, &m_id);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_id);
+			glBufferStorage(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(size), data, flags);
+			if (usage == EUsage::Readback) {
+				m_pMapped = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>(size), mapFlags);
+			}
+		}
+
+		GpuResourceRegistry::add(GpuResourceCategory::Buffer, m_id, size, usageToString(usage));
+	}
+
+	StorageBuffer::StorageBuffer(StorageBuffer&& rhs)
+		: m_id(rhs.m_id)
+		, m_size(rhs.m_size)
+		, m_pMapped(rhs.m_pMapped)
+	{
+		rhs.m_id = 0;
+		rhs.m_size = 0;
+		rhs.m_pMapped = nullptr;
+	}
+
+	StorageBuffer& StorageBuffer::operator=(StorageBuffer&& rhs) {
+		if (this != &rhs) {
+			GpuDeletionQueue::release(GpuResourceCategory::Buffer, m_id);
+
+			m_id = rhs.m_id;
+			m_size = rhs.m_size;
+			m_pMapped = rhs.m_pMapped;
+			rhs.m_id = 0;
+			rhs.m_size = 0;
+			rhs.m_pMapped = nullptr;
+		}
+		return *this;
+	}
+
+	StorageBuffer::~StorageBuffer() {
+		// Постоянное отображение снимается при удалении буфера.
+		GpuDeletionQueue::release(GpuResourceCategory::Buffer, m_id);
+	}
+
+	void StorageBuffer::bindBase(const unsigned int binding) const noexcept {
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_id);
+	}
+
+	void StorageBuffer::bindRange(const unsigned int binding, const size_t offset, const size_t size) const noexcept {
+		glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, m_id, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+	}
+
+	void StorageBuffer::bindUniform(const unsigned int binding) const noexcept {
+		glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_id);
+	}
+
+	void StorageBuffer::bindIndirect() const noexcept {
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_id);
+		glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, m_id);
+	}
+
+	void StorageBuffer::setData(const void* data, const size_t size, const size_t offset) {
+		if (hasDirectStateAccess()) {
+			glNamedBufferSubData(m_id, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+		}
+		else {
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_id);
+			glBufferSubData(GL_SHADER_STORAGE_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+		}
+	}
+
+	void StorageBuffer::copyTo(const StorageBuffer& target, const size_t srcOffset, const size_t dstOffset, const size_t size) const noexcept {
+		if (hasDirectStateAccess()) {
+			glCopyNamedBufferSubData(m_id, target.m_id,
+				static_cast<GLintptr>(srcOffset), static_cast<GLintptr>(dstOffset), static_cast<GLsizeiptr>(size));
+		}
+		else {
+			glBindBuffer(GL_COPY_READ_BUFFER, m_id);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, target.m_id);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+				static_cast<GLintptr>(srcOffset), static_cast<GLintptr>(dstOffset), static_cast<GLsizeiptr>(size));
+		}
+	}
+
+	void StorageBuffer::readData(void* data, const size_t size, const size_t offset) const {
+		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+		if (hasDirectStateAccess()) {
+			glGetNamedBufferSubData(m_id, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+		}
+		else {
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_id);
+			glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+		}
+	}
+
+	void StorageBuffer::setLabel(const std::string& label) {
+		GpuResourceRegistry::setLabel(GpuResourceCategory::Buffer, m_id, label);
+	}
+
+} // namespace Engine
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Класс, инкапсулирующий буфер данных шейдеров (SSBO).
+	///
+	/// Один и тот же буфер можно привязать как SSBO (`bindBase()`), как источник
+	/// аргументов непрямых вызовов (`bindIndirect()`) или как UBO. Хранилище
+	/// неизменяемое; буфер `EUsage::Readback` постоянно отображён для чтения.
+	///
+	/// @note Копирование запрещено, перемещение разрешено.
+	class StorageBuffer {
+	public:
+		/**
+		 * @internal
+		 * @brief Кто и как часто меняет данные буфера.
+		 */
+		enum class EUsage {
+			GpuOnly,	///< Пишут только шейдеры (после начальных данных).
+			Dynamic,	///< CPU обновляет данные через `setData()`.
+			Readback	///< CPU читает результаты через `getMappedData()`.
+		};
+
+		/// @internal
+		/// @brief Создаёт буфер.
+		/// @param data Начальные данные (nullptr - неинициализированный буфер).
+		/// @param size Размер буфера в байтах.
+		/// @param usage Тип использования (`EUsage`).
+		StorageBuffer(const void* data, size_t size, EUsage usage = EUsage::GpuOnly);
+		~StorageBuffer();
+
+		StorageBuffer(StorageBuffer&& rhs);
+		StorageBuffer& operator=(StorageBuffer&& rhs);
+
+		StorageBuffer(const StorageBuffer&)				= delete;
+		StorageBuffer& operator=(const StorageBuffer&)	= delete;
+
+		/// @internal
+		/// @brief Привязывает буфер к точке `binding` (`layout(binding = N) buffer`).
+		void bindBase(unsigned int binding) const noexcept;
+
+		/// @internal
+		/// @brief Привязывает часть буфера к точке `binding`.
+		void bindRange(unsigned int binding, size_t offset, size_t size) const noexcept;
+
+		/// @internal
+		/// @brief Привязывает буфер как UBO к точке `binding`.
+		void bindUniform(unsigned int binding) const noexcept;
+
+		/// @internal
+		/// @brief Привязывает буфер к `GL_DRAW_INDIRECT_BUFFER` и `GL_DISPATCH_INDIRECT_BUFFER`.
+		void bindIndirect() const noexcept;
+
+		/// @internal
+		/// @brief Обновляет часть данных буфера (`EUsage::Dynamic`).
+		void setData(const void* data, size_t size, size_t offset = 0);
+
+		/// @internal
+		/// @brief Копирует часть буфера в другой буфер на GPU.
+		void copyTo(const StorageBuffer& target, size_t srcOffset, size_t dstOffset, size_t size) const noexcept;
+
+		/// @internal
+		/// @brief Читает данные буфера, дожидаясь GPU.
+		/// @note Останавливает конвейер: только для тестов и отладки.
+		void readData(void* data, size_t size, size_t offset = 0) const;
+
+		/// @internal
+		/// @brief Возвращает память буфера `EUsage::Readback` (nullptr для остальных).
+		///
+		/// Данные, записанные GPU, видны после срабатывания fence, поставленного
+		/// после записи.
+		const void* getMappedData() const noexcept { return m_pMapped; }
+
+		unsigned int getId() const noexcept { return m_id; }
+		size_t getSize() const noexcept { return m_size; }
+
+		/// @internal
+		/// @brief Задаёт отладочное имя буфера (видно в реестре ресурсов и GL отладчиках).
+		void setLabel(const std::string& label);
+
+	private:
+		unsigned int	m_id		= 0;
+		size_t			m_size		= 0;
+		void*			m_pMapped	= nullptr;
+	};
+
+} // namespace Engine
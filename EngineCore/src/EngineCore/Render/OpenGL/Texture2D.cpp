@@ -0,0 +1,158 @@
+#include "EngineCore/Render/OpenGL/Texture2D.hpp"
+
+#include <algorithm>
+
+#include <glad/glad.h>
+
+#include "EngineCore/Image/BlockCompression.hpp"
+#include "EngineCore/Image/Image.hpp"
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+#include "EngineCore/Render/OpenGL/GpuResourceRegistry.hpp"
+#include "EngineCore/Render/RenderStats.hpp"
+
+// Форматы расширений GL_EXT_texture_compression_s3tc(_srgb) и GL_KHR_texture_compression_astc_ldr.
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+	#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT					0x83F0
+	#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT				0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+	#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT				0x8C4C
+	#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT			0x8C4F
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+	#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR					0x93B0
+	#define GL_COMPRESSED_RGBA_ASTC_6x6_KHR					0x93B4
+	#define GL_COMPRESSED_RGBA_ASTC_8x8_KHR					0x93B7
+	#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR			0x93D0
+	#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR			0x93D4
+	#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR			0x93D7
+#endif
+
+namespace Engine {
+
+	unsigned int Texture2D::s_placeholderId = 0;
+
+	TextureFormat chooseTextureFormat(const Image& image) {
+		const bool bSRGB = image.colorSpace == ColorSpace::SRGB;
+		TextureFormat format;
+
+		if (image.compression != CompressedFormat::None) {
+			const BlockInfo block = getBlockInfo(image.compression);
+			format.blockWidth = block.width;
+			format.blockHeight = block.height;
+			format.blockBytes = block.bytes;
+
+			switch (image.compression) {
+			case CompressedFormat::BC1:			format.internalFormat = bSRGB ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT; break;
+			case CompressedFormat::BC3:			format.internalFormat = bSRGB ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+			case CompressedFormat::BC4:			format.internalFormat = GL_COMPRESSED_RED_RGTC1; break;
+			case CompressedFormat::BC5:			format.internalFormat = GL_COMPRESSED_RG_RGTC2; break;
+			case CompressedFormat::BC7:			format.internalFormat = bSRGB ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM; break;
+			case CompressedFormat::ASTC_4x4:	format.internalFormat = bSRGB ? GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR : GL_COMPRESSED_RGBA_ASTC_4x4_KHR; break;
+			case CompressedFormat::ASTC_6x6:	format.internalFormat = bSRGB ? GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR : GL_COMPRESSED_RGBA_ASTC_6x6_KHR; break;
+			case CompressedFormat::ASTC_8x8:	format.internalFormat = bSRGB ? GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR : GL_COMPRESSED_RGBA_ASTC_8x8_KHR; break;
+			case CompressedFormat::None:		break;
+			}
+			return format;
+		}
+
+		static const uint32_t s_dataFormats[4] = { GL_RED, GL_RG, GL_RGB, GL_RGBA };
+		format.dataFormat = s_dataFormats[image.channels - 1];
+
+		if (image.pixelType == PixelType::Float32) {
+			static const uint32_t s_floatFormats[4] = { GL_R16F, GL_RG16F, GL_RGB16F, GL_RGBA16F };
+			format.internalFormat = s_floatFormats[image.channels - 1];
+			format.dataType = GL_FLOAT;
+			// RGB16F драйверы хранят с выравниванием до 4 компонентов.
+			format.gpuBytesPerPixel = image.channels == 3 ? 8 : image.channels * 2;
+			return format;
+		}
+
+		static const uint32_t s_unormFormats[4] = { GL_R8, GL_RG8, GL_RGB8, GL_RGBA8 };
+		format.internalFormat = image.channels == 4 && bSRGB ? GL_SRGB8_ALPHA8 : s_unormFormats[image.channels - 1];
+		format.dataType = GL_UNSIGNED_BYTE;
+		format.gpuBytesPerPixel = image.channels == 3 ? 4 : image.channels;
+		return format;
+	}
+
+	Texture2D::~Texture2D() {
+		GpuDeletionQueue::release(GpuResourceCategory::Texture, m_id);
+	}
+
+	void Texture2D::allocate(uint32_t width, uint32_t height, uint32_t levels, const TextureFormat& format) {
+		m_width = width;
+		m_height = height;
+		m_levels = levels;
+		m_format = format;
+
+		glGenTextures(1, &m_id);
+		glBindTexture(GL_TEXTURE_2D, m_id);
+		glTexStorage2D(GL_TEXTURE_2D, levels, format.internalFormat, width, height);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+
+		m_gpuBytes = 0;
+		for (uint32_t level = 0; level < levels; ++level) {
+			const uint64_t levelWidth = std::max<uint32_t>(width >> level, 1);
+			const uint64_t levelHeight = std::max<uint32_t>(height >> level, 1);
+			if (format.isCompressed()) {
+				const uint64_t blocksX = (levelWidth + format.blockWidth - 1) / format.blockWidth;
+				const uint64_t blocksY = (levelHeight + format.blockHeight - 1) / format.blockHeight;
+				m_gpuBytes += blocksX * blocksY * format.blockBytes;
+			}
+			else {
+				m_gpuBytes += levelWidth * levelHeight * format.gpuBytesPerPixel;
+			}
+		}
+		const char* usage = format.isCompressed() ? (levels > 1 ? "compressed, mipmapped" : "compressed") : (levels > 1 ? "mipmapped" : "");
+		GpuResourceRegistry::add(GpuResourceCategory::Texture, m_id, m_gpuBytes, usage);
+		if (!m_label.empty()) {
+			GpuResourceRegistry::setLabel(GpuResourceCategory::Texture, m_id, m_label);
+		}
+	}
+
+	void Texture2D::bind(uint32_t slot) const noexcept {
+		glActiveTexture(GL_TEXTURE0 + slot);
+		glBindTexture(GL_TEXTURE_2D, getId());
+		RenderStats::addTextureBind();
+	}
+
+	void Texture2D::setLabel(const std::string& label) {
+		// Хранилище может ещё не существовать: имя применится в `allocate()`.
+		m_label = label;
+		if (m_id != 0) {
+			GpuResourceRegistry::setLabel(GpuResourceCategory::Texture, m_id, label);
+		}
+	}
+
+	void Texture2D::createPlaceholder() {
+		if (s_placeholderId != 0) {
+			return;
+		}
+
+		const uint8_t gray[4] = { 128, 128, 128, 255 };
+		glGenTextures(1, &s_placeholderId);
+		glBindTexture(GL_TEXTURE_2D, s_placeholderId);
+		glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, 1, 1);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, gray);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+		GpuResourceRegistry::add(GpuResourceCategory::Texture, s_placeholderId, 4);
+		GpuResourceRegistry::setLabel(GpuResourceCategory::Texture, s_placeholderId, "Texture placeholder");
+	}
+
+	void Texture2D::destroyPlaceholder() {
+		if (s_placeholderId == 0) {
+			return;
+		}
+
+		GpuDeletionQueue::release(GpuResourceCategory::Texture, s_placeholderId);
+		s_placeholderId = 0;
+	}
+
+} // namespace Engine
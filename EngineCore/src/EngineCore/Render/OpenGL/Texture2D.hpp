@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace Engine {
+
+	struct Image;
+
+	/**
+	 * @internal
+	 * @brief Формат хранения текстуры на GPU.
+	 *
+	 * Описывает внутренний формат (`glTexStorage2D`) и формат исходных данных
+	 * (`glTexSubImage2D`) одной текстуры.
+	 */
+	struct TextureFormat {
+		uint32_t	internalFormat		= 0;	///< Внутренний формат (GLenum), например GL_SRGB8_ALPHA8.
+		uint32_t	dataFormat			= 0;	///< Формат исходных данных (GLenum), например GL_RGBA.
+		uint32_t	dataType			= 0;	///< Тип компонента исходных данных (GLenum).
+		uint32_t	gpuBytesPerPixel	= 0;	///< Оценка размера пикселя в видеопамяти.
+		uint8_t		blockWidth			= 1;	///< Ширина блока сжатого формата.
+		uint8_t		blockHeight			= 1;	///< Высота блока сжатого формата.
+		uint8_t		blockBytes			= 0;	///< Размер блока в байтах (0 - формат без сжатия).
+
+		bool isCompressed() const noexcept { return blockBytes != 0; }
+	};
+
+	/// @internal
+	/// @brief Подбирает формат GPU под декодированное изображение.
+	///
+	/// Учитывает блочное сжатие, тип пикселей и цветовое пространство `image`.
+	TextureFormat chooseTextureFormat(const Image& image);
+
+	/// @internal
+	/// @brief Класс, инкапсулирующий неизменяемую (immutable) 2D текстуру OpenGL.
+	///
+	/// Текстура может создаваться асинхронно (см. `TextureLoader`): пока данные
+	/// не загружены, `getId()` и `bind()` используют общую текстуру-заглушку,
+	/// поэтому владелец может рисовать с ней сразу после запроса загрузки.
+	///
+	/// @note Копирование и перемещение запрещено, текстура разделяется через `std::shared_ptr`.
+	class Texture2D {
+	public:
+		/**
+		 * @internal
+		 * @brief Состояние данных текстуры.
+		 */
+		enum class EState : uint8_t {
+			Pending,	///< Данные ещё декодируются или загружаются, используется заглушка.
+			Ready,		///< Все mip-уровни загружены.
+			Failed		///< Загрузка не удалась, навсегда используется заглушка.
+		};
+
+		Texture2D() = default;
+		~Texture2D();
+
+		Texture2D(const Texture2D&)				= delete;
+		Texture2D& operator=(const Texture2D&)	= delete;
+		Texture2D(Texture2D&&)					= delete;
+		Texture2D& operator=(Texture2D&&)		= delete;
+
+		/// @internal
+		/// @brief Выделяет неизменяемое хранилище под все mip-уровни (`glTexStorage2D`).
+		///
+		/// Вызывается в потоке с контекстом OpenGL. Данные уровней заполняются позже.
+		///
+		/// @param width Ширина уровня 0.
+		/// @param height Высота уровня 0.
+		/// @param levels Кол-во mip-уровней.
+		/// @param format Формат текстуры.
+		void allocate(uint32_t width, uint32_t height, uint32_t levels, const TextureFormat& format);
+
+		/// @internal
+		/// @brief Помечает данные загруженными: с этого момента используется сама текстура.
+		void markReady() noexcept { m_state.store(EState::Ready, std::memory_order_release); }
+
+		/// @internal
+		/// @brief Помечает загрузку неудавшейся.
+		void markFailed() noexcept { m_state.store(EState::Failed, std::memory_order_release); }
+
+		/// @internal
+		/// @brief Привязывает текстуру (или заглушку) к текстурному блоку `slot`.
+		void bind(uint32_t slot = 0) const noexcept;
+
+		/// @internal
+		/// @brief Возвращает идентификатор текстуры или заглушки, если данные ещё не готовы.
+		unsigned int getId() const noexcept { return isReady() ? m_id : s_placeholderId; }
+
+		/// @internal
+		/// @brief Возвращает идентификатор выделенного хранилища (даже если оно ещё не заполнено).
+		unsigned int getStorageId() const noexcept { return m_id; }
+
+		EState getState() const noexcept { return m_state.load(std::memory_order_acquire); }
+		bool isReady() const noexcept { return getState() == EState::Ready; }
+
+		uint32_t getWidth() const noexcept { return m_width; }
+		uint32_t getHeight() const noexcept { return m_height; }
+		uint32_t getLevels() const noexcept { return m_levels; }
+		const TextureFormat& getFormat() const noexcept { return m_format; }
+		const std::string& getLabel() const noexcept { return m_label; }
+
+		/// @internal
+		/// @brief Объём видеопамяти, занимаемый всеми уровнями.
+		uint64_t getGpuBytes() const noexcept { return m_gpuBytes; }
+
+		/// @internal
+		/// @brief Задаёт отладочное имя текстуры (видно в реестре ресурсов и GL отладчиках).
+		void setLabel(const std::string& label);
+
+		/// @internal
+		/// @brief Создаёт общую текстуру-заглушку (серый пиксель 1x1).
+		/// Вызывается в потоке с контекстом OpenGL до первой асинхронной загрузки.
+		static void createPlaceholder();
+
+		/// @internal
+		/// @brief Удаляет текстуру-заглушку.
+		static void destroyPlaceholder();
+
+	private:
+		unsigned int			m_id		= 0;
+		uint32_t				m_width		= 0;
+		uint32_t				m_height	= 0;
+		uint32_t				m_levels	= 0;
+		TextureFormat			m_format;
+		uint64_t				m_gpuBytes	= 0;
+		std::string				m_label;
+		std::atomic<EState>		m_state		{ EState::Pending };
+
+		static unsigned int		s_placeholderId;
+	};
+
+} // namespace Engine
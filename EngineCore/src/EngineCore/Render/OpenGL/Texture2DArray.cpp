@@ -0,0 +1,137 @@
+#include "EngineCore/Render/OpenGL/Texture2DArray.hpp"
+
+#include <algorithm>
+
+#include <glad/glad.h>
+
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+#include "EngineCore/Render/OpenGL/GpuResourceRegistry.hpp"
+#include "EngineCore/Render/RenderStats.hpp"
+
+namespace Engine {
+
+	Texture2DArray::~Texture2DArray() {
+		destroy();
+	}
+
+	void Texture2DArray::destroy() noexcept {
+		GpuDeletionQueue::release(GpuResourceCategory::Texture, m_id);
+		m_id = 0;
+	}
+
+	unsigned int Texture2DArray::createStorage(uint32_t layers) {
+		GLuint id = 0;
+		glGenTextures(1, &id);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, id);
+		glTexStorage3D(GL_TEXTURE_2D_ARRAY, m_levels, m_format.internalFormat, m_width, m_height, layers);
+
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, m_levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, m_levels - 1);
+
+		uint64_t layerBytes = 0;
+		for (uint32_t level = 0; level < m_levels; ++level) {
+			const uint64_t levelWidth = std::max<uint32_t>(m_width >> level, 1);
+			const uint64_t levelHeight = std::max<uint32_t>(m_height >> level, 1);
+			if (m_format.isCompressed()) {
+				const uint64_t blocksX = (levelWidth + m_format.blockWidth - 1) / m_format.blockWidth;
+				const uint64_t blocksY = (levelHeight + m_format.blockHeight - 1) / m_format.blockHeight;
+				layerBytes += blocksX * blocksY * m_format.blockBytes;
+			}
+			else {
+				layerBytes += levelWidth * levelHeight * m_format.gpuBytesPerPixel;
+			}
+		}
+		m_gpuBytes = layerBytes * layers;
+
+		GpuResourceRegistry::add(GpuResourceCategory::Texture, id, m_gpuBytes, m_levels > 1 ? "array, mipmapped" : "array");
+		if (!m_label.empty()) {
+			GpuResourceRegistry::setLabel(GpuResourceCategory::Texture, id, m_label);
+		}
+		return id;
+	}
+
+	void Texture2DArray::allocate(uint32_t width, uint32_t height, uint32_t layers, uint32_t levels, const TextureFormat& format) {
+		destroy();
+
+		m_width = width;
+		m_height = height;
+		m_layers = layers;
+		m_levels = levels;
+		m_format = format;
+		m_id = createStorage(layers);
+	}
+
+	bool Texture2DArray::resize(uint32_t layers) {
+		if (layers <= m_layers || layers > getMaxLayers()) {
+			return false;
+		}
+
+		const GLuint newId = createStorage(layers);
+
+		// Копирование между текстурами выполняется на GPU без чтения данных в память процесса.
+		for (uint32_t level = 0; level < m_levels; ++level) {
+			const GLsizei levelWidth = std::max<uint32_t>(m_width >> level, 1);
+			const GLsizei levelHeight = std::max<uint32_t>(m_height >> level, 1);
+			glCopyImageSubData(
+				m_id, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+				newId, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+				levelWidth, levelHeight, m_layers
+			);
+		}
+
+		destroy();
+		m_id = newId;
+		m_layers = layers;
+		return true;
+	}
+
+	void Texture2DArray::upload(
+		uint32_t	layer,
+		uint32_t	level,
+		uint32_t	x,
+		uint32_t	y,
+		uint32_t	width,
+		uint32_t	height,
+		const void*	pData,
+		size_t		size
+	) {
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+		if (m_format.isCompressed()) {
+			glCompressedTexSubImage3D(
+				GL_TEXTURE_2D_ARRAY, level, x, y, layer, width, height, 1,
+				m_format.internalFormat, static_cast<GLsizei>(size), pData
+			);
+		}
+		else {
+			glTexSubImage3D(
+				GL_TEXTURE_2D_ARRAY, level, x, y, layer, width, height, 1,
+				m_format.dataFormat, m_format.dataType, pData
+			);
+		}
+	}
+
+	void Texture2DArray::bind(uint32_t slot) const noexcept {
+		glActiveTexture(GL_TEXTURE0 + slot);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+		RenderStats::addTextureBind();
+	}
+
+	void Texture2DArray::setLabel(const std::string& label) {
+		m_label = label;
+		if (m_id != 0) {
+			GpuResourceRegistry::setLabel(GpuResourceCategory::Texture, m_id, label);
+		}
+	}
+
+	uint32_t Texture2DArray::getMaxLayers() noexcept {
+		static GLint s_maxLayers = 0;
+		if (s_maxLayers == 0) {
+			glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &s_maxLayers);
+		}
+		return static_cast<uint32_t>(s_maxLayers);
+	}
+
+} // namespace Engine
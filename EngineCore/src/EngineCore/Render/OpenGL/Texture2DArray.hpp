@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "EngineCore/Render/OpenGL/Texture2D.hpp"
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Класс, инкапсулирующий неизменяемый массив 2D текстур OpenGL (`GL_TEXTURE_2D_ARRAY`).
+	///
+	/// Все слои имеют одинаковые размер, формат и кол-во mip-уровней. Шейдер выбирает
+	/// слой третьей координатой `sampler2DArray`, поэтому объекты с разными
+	/// текстурами одного формата рисуются без смены привязки.
+	///
+	/// Кол-во слоёв можно увеличить (`resize()`): создаётся новое хранилище, и старые
+	/// слои копируются в него на GPU. Идентификатор текстуры при этом меняется.
+	///
+	/// @note Копирование и перемещение запрещено.
+	class Texture2DArray {
+	public:
+		Texture2DArray() = default;
+		~Texture2DArray();
+
+		Texture2DArray(const Texture2DArray&)				= delete;
+		Texture2DArray& operator=(const Texture2DArray&)	= delete;
+		Texture2DArray(Texture2DArray&&)					= delete;
+		Texture2DArray& operator=(Texture2DArray&&)			= delete;
+
+		/// @internal
+		/// @brief Выделяет неизменяемое хранилище (`glTexStorage3D`).
+		/// @param width Ширина слоя на уровне 0.
+		/// @param height Высота слоя на уровне 0.
+		/// @param layers Кол-во слоёв.
+		/// @param levels Кол-во mip-уровней.
+		/// @param format Формат текстуры.
+		void allocate(uint32_t width, uint32_t height, uint32_t layers, uint32_t levels, const TextureFormat& format);
+
+		/// @internal
+		/// @brief Увеличивает кол-во слоёв, сохраняя содержимое существующих.
+		/// @return false, если `layers` не больше текущего кол-ва или превышает лимит GPU.
+		bool resize(uint32_t layers);
+
+		/// @internal
+		/// @brief Загружает прямоугольник данных в один слой.
+		///
+		/// Для сжатых форматов координаты и размеры задаются в пикселях и должны быть
+		/// выровнены по блоку (кроме правого и нижнего края уровня), а `size` - размер данных в байтах.
+		///
+		/// @param layer Слой.
+		/// @param level Mip-уровень.
+		/// @param x Левый край прямоугольника.
+		/// @param y Нижний край прямоугольника.
+		/// @param width Ширина прямоугольника.
+		/// @param height Высота прямоугольника.
+		/// @param pData Данные (строки подряд, без выравнивания).
+		/// @param size Размер данных в байтах.
+		void upload(
+			uint32_t	layer,
+			uint32_t	level,
+			uint32_t	x,
+			uint32_t	y,
+			uint32_t	width,
+			uint32_t	height,
+			const void*	pData,
+			size_t		size
+		);
+
+		/// @internal
+		/// @brief Привязывает массив к текстурному блоку `slot`.
+		void bind(uint32_t slot = 0) const noexcept;
+
+		unsigned int getId() const noexcept { return m_id; }
+		uint32_t getWidth() const noexcept { return m_width; }
+		uint32_t getHeight() const noexcept { return m_height; }
+		uint32_t getLayers() const noexcept { return m_layers; }
+		uint32_t getLevels() const noexcept { return m_levels; }
+		const TextureFormat& getFormat() const noexcept { return m_format; }
+		uint64_t getGpuBytes() const noexcept { return m_gpuBytes; }
+
+		/// @internal
+		/// @brief Задаёт отладочное имя текстуры.
+		void setLabel(const std::string& label);
+
+		/// @internal
+		/// @brief Максимальное кол-во слоёв, поддерживаемое GPU (`GL_MAX_ARRAY_TEXTURE_LAYERS`).
+		static uint32_t getMaxLayers() noexcept;
+
+	private:
+		unsigned int	createStorage(uint32_t layers);
+		void			destroy() noexcept;
+
+		unsigned int	m_id		= 0;
+		uint32_t		m_width		= 0;
+		uint32_t		m_height	= 0;
+		uint32_t		m_layers	= 0;
+		uint32_t		m_levels	= 0;
+		TextureFormat	m_format;
+		uint64_t		m_gpuBytes	= 0;
+		std::string		m_label;
+	};
+
+} // namespace Engine
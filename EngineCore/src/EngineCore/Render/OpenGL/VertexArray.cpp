@@ -2,20 +2,35 @@
 
 #include <glad/glad.h>
 
-#include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
 #include "EngineCore/Log.hpp"
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+#include "EngineCore/Render/OpenGL/GpuResourceRegistry.hpp"
+#include "EngineCore/Render/OpenGL/IndexBuffer.hpp"
+#include "EngineCore/Render/RenderStats.hpp"
 
 namespace Engine {
 
 	VertexArray::VertexArray() {
-		glGenVertexArrays(1, &m_id);
+		if (hasDirectStateAccess()) {
+			glCreateVertexArrays(1, &m_id);
+		}
+		else {
+			glGenVertexArrays(1, &m_id);
+		}
+		GpuResourceRegistry::add(GpuResourceCategory::VertexArray, m_id, 0);
 	}
 
 	VertexArray::~VertexArray() {
-		glDeleteVertexArrays(1, &m_id);
+		GpuDeletionQueue::release(GpuResourceCategory::VertexArray, m_id);
+	}
+
+	void VertexArray::setLabel(const std::string& label) {
+		GpuResourceRegistry::setLabel(GpuResourceCategory::VertexArray, m_id, label);
 	}
 
-	VertexArray::VertexArray(VertexArray&& rhs) noexcept {
+	VertexArray::VertexArray(VertexArray&& rhs) noexcept 
+		: m_bindings(std::move(rhs.m_bindings))
+	{
 		m_id = rhs.m_id;
 		m_elements_count = rhs.m_elements_count;
 
@@ -24,17 +39,22 @@ namespace Engine {
 	}
 
 	VertexArray& VertexArray::operator=(VertexArray&& rhs) noexcept {
-		m_id = rhs.m_id;
-		m_elements_count = rhs.m_elements_count;
+		if (this != &rhs) {
+			GpuDeletionQueue::release(GpuResourceCategory::VertexArray, m_id);
 
-		rhs.m_id = 0;
-		rhs.m_elements_count = 0;
+			m_id = rhs.m_id;
+			m_elements_count = rhs.m_elements_count;
+			m_bindings = std::move(rhs.m_bindings);
 
+			rhs.m_id = 0;
+			rhs.m_elements_count = 0;
+		}
 		return *this;
 	}
 
 	void VertexArray::bind() const noexcept {
 		glBindVertexArray(m_id);
+		RenderStats::addVertexArrayBind();
 	}
 
 	void VertexArray::unbind() noexcept {
@@ -42,22 +62,123 @@ namespace Engine {
 	}
 
 	void VertexArray::addBuffer(const VertexBuffer& vertexBuffer) {
-		bind();
-		vertexBuffer.bind();
+		setVertexBuffer(addLayout(vertexBuffer.getLayout()), vertexBuffer);
+	}
+
+	uint32_t VertexArray::addLayout(const BufferLayout& layout, const uint32_t divisor) {
+		const uint32_t bindingIndex = static_cast<uint32_t>(m_bindings.size());
+		m_bindings.push_back({ layout, m_elements_count, divisor });
+
+		if (hasDirectStateAccess()) {
+			// Формат задаётся один раз; смена буфера его не затрагивает.
+			for (const BufferElement& currentElement : layout.getElements()) {
+				glEnableVertexArrayAttrib(m_id, m_elements_count);
+				if (currentElement.bInteger) {
+					glVertexArrayAttribIFormat(
+						m_id,
+						m_elements_count,
+						static_cast<GLint>(currentElement.componentCount),
+						currentElement.componentType,
+						static_cast<GLuint>(currentElement.offset)
+					);
+				}
+				else {
+					glVertexArrayAttribFormat(
+						m_id,
+						m_elements_count,
+						static_cast<GLint>(currentElement.componentCount),
+						currentElement.componentType,
+						currentElement.bNormalized ? GL_TRUE : GL_FALSE,
+						static_cast<GLuint>(currentElement.offset)
+					);
+				}
+				glVertexArrayAttribBinding(m_id, m_elements_count, bindingIndex);
+				++m_elements_count;
+			}
+			glVertexArrayBindingDivisor(m_id, bindingIndex, divisor);
+		}
+		else {
+			// Без DSA формат задаётся вместе с буфером в `setVertexBuffer()`.
+			m_elements_count += static_cast<unsigned int>(layout.getElements().size());
+		}
+		return bindingIndex;
+	}
+
+	void VertexArray::setVertexBuffer(uint32_t binding, const VertexBuffer& vertexBuffer, size_t offset) {
+		if (binding >= m_bindings.size()) {
+			LOG_ERR("VertexArray has no binding {0}", binding);
+			return;
+		}
+		if (vertexBuffer.getLayout() != m_bindings[binding].layout) {
+			LOG_WARN("Vertex buffer layout does not match VertexArray binding {0}", binding);
+		}
 
-		for (const BufferElement& currentElement : vertexBuffer.getLayout().getElements()) {
-			glEnableVertexAttribArray(m_elements_count);
-			glVertexAttribPointer(
-				m_elements_count,
-				currentElement.componentCount,
-				currentElement.componentType,
-				GL_FALSE,
-				vertexBuffer.getLayout().getStride(),
-				(void*)(currentElement.offset)
+		if (hasDirectStateAccess()) {
+			glVertexArrayVertexBuffer(
+				m_id,
+				binding,
+				vertexBuffer.getId(),
+				static_cast<GLintptr>(offset),
+				static_cast<GLsizei>(m_bindings[binding].layout.getStride())
 			);
-			++m_elements_count;
+			return;
+		}
+
+		// Привязка для настройки, а не для рисования: в статистику кадра не попадает.
+		// Предыдущие VAO и GL_ARRAY_BUFFER восстанавливаются, чтобы не изменить чужое состояние.
+		GLint previousArray = 0;
+		GLint previousBuffer = 0;
+		glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previousArray);
+		glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &previousBuffer);
+		glBindVertexArray(m_id);
+		vertexBuffer.bind();
+		setAttributePointers(m_bindings[binding], offset);
+		glBindVertexArray(static_cast<GLuint>(previousArray));
+		glBindBuffer(GL_ARRAY_BUFFER, static_cast<GLuint>(previousBuffer));
+	}
+
+	void VertexArray::setIndexBuffer(const IndexBuffer& indexBuffer) {
+		if (hasDirectStateAccess()) {
+			glVertexArrayElementBuffer(m_id, indexBuffer.getId());
+			return;
 		}
 
+		// GL_ELEMENT_ARRAY_BUFFER - состояние VAO, поэтому достаточно вернуть прежний VAO.
+		GLint previousArray = 0;
+		glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previousArray);
+		glBindVertexArray(m_id);
+		indexBuffer.bind();
+		glBindVertexArray(static_cast<GLuint>(previousArray));
+	}
+
+	void VertexArray::setAttributePointers(const Binding& binding, size_t offset) const {
+		const GLsizei stride = static_cast<GLsizei>(binding.layout.getStride());
+		GLuint attribute = binding.firstAttribute;
+		for (const BufferElement& currentElement : binding.layout.getElements()) {
+			glEnableVertexAttribArray(attribute);
+			// Целые атрибуты без `I` варианта были бы преобразованы во float.
+			if (currentElement.bInteger) {
+				glVertexAttribIPointer(
+					attribute,
+					static_cast<GLint>(currentElement.componentCount),
+					currentElement.componentType,
+					stride,
+					reinterpret_cast<const void*>(offset + currentElement.offset)
+				);
+			}
+			else {
+				glVertexAttribPointer(
+					attribute,
+					static_cast<GLint>(currentElement.componentCount),
+					currentElement.componentType,
+					currentElement.bNormalized ? GL_TRUE : GL_FALSE,
+					stride,
+					reinterpret_cast<const void*>(offset + currentElement.offset)
+				);
+			}
+			glVertexAttribDivisor(attribute, binding.divisor);
+			++attribute;
+		}
 	}
 
 } // namespace Engine
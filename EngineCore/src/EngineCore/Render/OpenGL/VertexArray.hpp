@@ -1,13 +1,38 @@
-#pragma once 
+#pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
 
 namespace Engine {
 
-	class VertexBuffer;
-	
+	class IndexBuffer;
+
 	/// @internal
 	/// @brief Класс, инкапсулирующий реализацию объекта VAO.
+	///
+	/// Формат атрибутов и источник данных задаются раздельно: `addLayout()` описывает
+	/// атрибуты точки привязки, `setVertexBuffer()` подключает к ней буфер. Поэтому
+	/// меши с одинаковым `BufferLayout` могут использовать один VAO и менять только
+	/// буфер:
+	/// @code
+	/// VertexArray vao;
+	/// const uint32_t binding = vao.addLayout(layout);
+	/// for (const Mesh& mesh : meshes) {
+	/// 	vao.setVertexBuffer(binding, mesh.vertices);
+	/// 	vao.bind();
+	/// 	// ... отрисовка
+	/// }
+	/// @endcode
+	///
+	/// С DSA (`hasDirectStateAccess()`) VAO настраивается без привязки и не меняет
+	/// состояние контекста; без него используется `glVertexAttribPointer`,
+	/// `setVertexBuffer()` заново задаёт указатели атрибутов, а прежние привязки
+	/// VAO и GL_ARRAY_BUFFER после настройки восстанавливаются.
 	class VertexArray {
 	public:
 		VertexArray();
@@ -22,19 +47,57 @@ namespace Engine {
 		/// @internal
 		/// @brief Добавляет вершинный буфер к VAO и настраивает формат атрибутов вершин.
 		///
-		/// Функция привязывает переданный VertexBuffer и, опираясь на его BufferLayout,
-		/// вызывает glEnableVertexAttribArray и glVertexAttribPointer для каждого
-		/// атрибута. Таким образом VAO запоминает, как интерпретировать данные вершин.
+		/// Равносильно `setVertexBuffer(addLayout(vertexBuffer.getLayout()), vertexBuffer)`.
+		/// Атрибуты нумеруются подряд по всем добавленным буферам; целые атрибуты
+		/// читаются как целые, `UNorm`/`SNorm` нормализуются.
 		///
 		/// @param vertexBuffer Вершинный буфер, содержащий данные и их раскладку.
 		void addBuffer(const VertexBuffer& vertexBuffer);
+
+		/// @internal
+		/// @brief Описывает атрибуты новой точки привязки буфера.
+		/// @param layout Раскладка вершины.
+		/// @param divisor 0 - атрибуты читаются на вершину, N - один элемент на N экземпляров.
+		/// @return Индекс точки привязки.
+		uint32_t addLayout(const BufferLayout& layout, uint32_t divisor = 0);
+
+		/// @internal
+		/// @brief Описывает атрибуты точки привязки раскладкой `VertexLayout<Vertex>`.
+		/// @note Определён в `VertexLayout.hpp`.
+		template<typename Vertex>
+		uint32_t addLayout();
+
+		/// @internal
+		/// @brief Подключает буфер к точке привязки, не меняя формат атрибутов.
+		/// @param binding Индекс из `addLayout()`.
+		/// @param vertexBuffer Буфер с раскладкой, совпадающей с раскладкой точки привязки.
+		/// @param offset Смещение первой вершины в буфере в байтах.
+		void setVertexBuffer(uint32_t binding, const VertexBuffer& vertexBuffer, size_t offset = 0);
+
+		/// @internal
+		/// @brief Подключает буфер индексов (хранится в состоянии VAO).
+		void setIndexBuffer(const IndexBuffer& indexBuffer);
+
 		void bind() const noexcept;
 		static void unbind() noexcept;
 
+		/// @internal
+		/// @brief Задаёт отладочное имя VAO (видно в реестре ресурсов и GL отладчиках).
+		void setLabel(const std::string& label);
+
 	private:
-		unsigned int m_id 				= 0;
-		unsigned int m_elements_count 	= 0;
+		/// Точка привязки: раскладка и номер её первого атрибута.
+		struct Binding {
+			BufferLayout	layout;
+			uint32_t		firstAttribute;
+			uint32_t		divisor;
+		};
+
+		void setAttributePointers(const Binding& binding, size_t offset) const;
+
+		unsigned int 			m_id 				= 0;
+		unsigned int 			m_elements_count 	= 0;
+		std::vector<Binding>	m_bindings;
 	};
 
 } // namespace Engine
-
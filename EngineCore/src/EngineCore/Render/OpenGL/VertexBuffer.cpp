@@ -1,8 +1,12 @@
 #include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
 
+#include <cassert>
+
 #include <glad/glad.h>
 
 #include "EngineCore/Log.hpp"
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+#include "EngineCore/Render/OpenGL/GpuResourceRegistry.hpp"
 
 namespace Engine {
 
@@ -26,81 +30,108 @@ namespace Engine {
 	}
 
 	/// @internal
-	/// @brief Возвращает кол-во компонентов атрибута.
-	/// @param type Тип данных атрибута.
-	/// @return кол-во компонентов атрибута.
-	constexpr uint8_t getShaderDataComponentsCount(const ShaderDataType type) {
-		switch (type)
+	/// @brief Возвращает название `EUsage` для реестра ресурсов.
+	const char* usageToString(const VertexBuffer::EUsage usage) {
+		switch (usage)
 		{
-		case ShaderDataType::Float:
-		case ShaderDataType::Int:
-			return 1;		
-		case ShaderDataType::Float2:
-		case ShaderDataType::Int2:
-			return 2;		
-		case ShaderDataType::Float3:
-		case ShaderDataType::Int3:
-			return 3;		
-		case ShaderDataType::Float4:
-		case ShaderDataType::Int4:
-			return 4;		
+		case VertexBuffer::EUsage::Static :
+			return "static";
+		case VertexBuffer::EUsage::Dynamic :
+			return "dynamic";
+		case VertexBuffer::EUsage::Stream :
+			return "stream";
 		}
-
-		LOG_ERR("Unknown shader data type!");
-		return 0;
+		return "unknown";
 	}
-	
-	/// @internal
-	/// @brief Возвращает размер атрибута в байтах.
+
+	/// @brief Переводит тип данных атрибута `ShaderDataType` в тип OpenGL.
 	/// @param type Тип данных атрибута.
-	/// @return Размера атрибута в байтах.
-	constexpr size_t getShaderDataComponentsSize(const ShaderDataType type) {
+	/// @return Соответствующий `ShaderDataType` тип OpenGL.
+	constexpr unsigned int getOpenGLTypeFromShaderDataType(const ShaderDataType type) {
 		switch (type)
 		{
 		case ShaderDataType::Float:
 		case ShaderDataType::Float2:
 		case ShaderDataType::Float3:
 		case ShaderDataType::Float4:
-			return sizeof(GLfloat) * getShaderDataComponentsCount(type);
+			return GL_FLOAT;
 		case ShaderDataType::Int:
 		case ShaderDataType::Int2:
 		case ShaderDataType::Int3:
 		case ShaderDataType::Int4:
-			return sizeof(GLint) * getShaderDataComponentsCount(type);
+			return GL_INT;
+		case ShaderDataType::Half2:
+		case ShaderDataType::Half4:
+			return GL_HALF_FLOAT;
+		case ShaderDataType::UNorm8x4:
+		case ShaderDataType::UInt8x4:
+			return GL_UNSIGNED_BYTE;
+		case ShaderDataType::SNorm8x4:
+			return GL_BYTE;
+		case ShaderDataType::UNorm16x2:
+		case ShaderDataType::UNorm16x4:
+			return GL_UNSIGNED_SHORT;
+		case ShaderDataType::SNorm16x2:
+		case ShaderDataType::SNorm16x4:
+			return GL_SHORT;
+		case ShaderDataType::SNorm10_10_10_2:
+			return GL_INT_2_10_10_10_REV;
 		}
 
 		LOG_ERR("Unknown shader data type!");
 		return 0;
 	}
 
-	/// @brief Переводит тип данных атрибута `ShaderDataType` в тип OpenGL.
-	/// @param type Тип данных атрибута.
-	/// @return Соответствующий `ShaderDataType` тип OpenGL.
-	constexpr unsigned int getOpenGLTypeFromShaderDataType(const ShaderDataType type) {
+	/// @internal
+	/// @brief Приводятся ли целые значения атрибута к [0, 1] или [-1, 1].
+	constexpr bool isShaderDataNormalized(const ShaderDataType type) {
+		switch (type)
+		{
+		case ShaderDataType::UNorm8x4:
+		case ShaderDataType::SNorm8x4:
+		case ShaderDataType::UNorm16x2:
+		case ShaderDataType::UNorm16x4:
+		case ShaderDataType::SNorm16x2:
+		case ShaderDataType::SNorm16x4:
+		case ShaderDataType::SNorm10_10_10_2:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	/// @internal
+	/// @brief Читает ли шейдер атрибут как целые (`int`, `ivec*`, `uvec*`).
+	constexpr bool isShaderDataInteger(const ShaderDataType type) {
 		switch (type)
 		{
-		case ShaderDataType::Float:
-		case ShaderDataType::Float2:
-		case ShaderDataType::Float3:
-		case ShaderDataType::Float4:
-			return GL_FLOAT;
 		case ShaderDataType::Int:
 		case ShaderDataType::Int2:
 		case ShaderDataType::Int3:
 		case ShaderDataType::Int4:
-			return GL_INT;
+		case ShaderDataType::UInt8x4:
+			return true;
+		default:
+			return false;
 		}
+	}
 
-		LOG_ERR("Unknown shader data type!");
-		return 0;
+	bool hasDirectStateAccess() noexcept {
+#ifdef ENGINE_DISABLE_DSA
+		return false;
+#else
+		return GLAD_GL_VERSION_4_5 != 0;
+#endif
 	}
 
-	BufferElement::BufferElement(const ShaderDataType type) 
+	BufferElement::BufferElement(const ShaderDataType type, const size_t offset) 
 		: type(type)
-		, size(getShaderDataComponentsSize(type))
-		, componentCount(getShaderDataComponentsCount(type))
 		, componentType(getOpenGLTypeFromShaderDataType(type))
-		, offset(0)
+		, componentCount(getShaderDataComponentsCount(type))
+		, size(getShaderDataComponentsSize(type))
+		, offset(offset)
+		, bNormalized(isShaderDataNormalized(type))
+		, bInteger(isShaderDataInteger(type))
 	{}
 	
 	VertexBuffer::VertexBuffer(
@@ -109,28 +140,86 @@ namespace Engine {
 		BufferLayout 		layout,
 		const EUsage		usage
 	)	: m_layout(std::move(layout))
+		, m_size(size)
+		, m_usage(usage)
 	 {
-		glGenBuffers(1, &m_id);
-		glBindBuffer(GL_ARRAY_BUFFER, m_id);
-		glBufferData(GL_ARRAY_BUFFER, size, data, usageToGLenum(usage));
+		if (hasDirectStateAccess()) {
+			// Привязка GL_ARRAY_BUFFER не меняется. Статический буфер не обновляется,
+			// поэтому флаг записи нужен только остальным.
+			GLbitfield flags = usage == EUsage::Static ? 0 : GL_DYNAMIC_STORAGE_BIT;
+			// Потоковый буфер отображается один раз на всё время жизни.
+			const GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			if (usage == EUsage::Stream) {
+				flags |= mapFlags;
+			}
+			glCreateBuffers(1, &m_id);
+			glNamedBufferStorage(m_id, size, data, flags);
+			if (usage == EUsage::Stream) {
+				m_pMapped = glMapNamedBufferRange(m_id, 0, size, mapFlags);
+			}
+		}
+		else {
+			glGenBuffers(1, &m_id);
+			glBindBuffer(GL_ARRAY_BUFFER, m_id);
+			glBufferData(GL_ARRAY_BUFFER, size, data, usageToGLenum(usage));
+		}
+
+		GpuResourceRegistry::add(GpuResourceCategory::Buffer, m_id, size, usageToString(usage));
 	}
 
 	VertexBuffer::VertexBuffer(VertexBuffer&& rhs) 
 		: m_layout(std::move(rhs.m_layout))
+		, m_size(rhs.m_size)
+		, m_usage(rhs.m_usage)
+		, m_pMapped(rhs.m_pMapped)
 	{
 		m_id = rhs.m_id;
 		rhs.m_id = 0;
+		rhs.m_size = 0;
+		rhs.m_pMapped = nullptr;
 	} 	
 
 	VertexBuffer& VertexBuffer::operator=(VertexBuffer&& rhs) {
-		m_id = rhs.m_id;
-		rhs.m_id = 0;
-
+		if (this != &rhs) {
+			// Старый буфер мог использоваться в отправленных командах.
+			GpuDeletionQueue::release(GpuResourceCategory::Buffer, m_id);
+
+			m_id = rhs.m_id;
+			m_layout = std::move(rhs.m_layout);
+			m_size = rhs.m_size;
+			m_usage = rhs.m_usage;
+			m_pMapped = rhs.m_pMapped;
+			rhs.m_id = 0;
+			rhs.m_size = 0;
+			rhs.m_pMapped = nullptr;
+		}
 		return *this;
 	}
 
 	VertexBuffer::~VertexBuffer() {
-		glDeleteBuffers(1, &m_id);
+		GpuDeletionQueue::release(GpuResourceCategory::Buffer, m_id);
+	}
+
+	void VertexBuffer::setData(const void* data, const size_t size, const size_t offset) {
+		// С DSA хранилище статического буфера неизменяемо (GL_INVALID_OPERATION),
+		// поэтому без DSA обновление запрещено так же.
+		assert(m_usage != EUsage::Static && "Static vertex buffer can not be updated");
+		if (m_usage == EUsage::Static) {
+			LOG_ERR("Static vertex buffer {0} can not be updated, create it with EUsage::Dynamic", m_id);
+			return;
+		}
+
+		if (hasDirectStateAccess()) {
+			glNamedBufferSubData(m_id, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+		}
+		else {
+			glBindBuffer(GL_ARRAY_BUFFER, m_id);
+			glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+		}
+	}
+
+	void VertexBuffer::setLabel(const std::string& label) {
+		GpuResourceRegistry::setLabel(GpuResourceCategory::Buffer, m_id, label);
 	}
 
 	void VertexBuffer::bind() const noexcept {
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace Engine { 
@@ -15,20 +17,104 @@ namespace Engine {
 	 * Это перечисление не является типом OpenGL напрямую, но служит
 	 * абстракцией, на основе которой движок вычисляет:
 	 *  - количество компонент в атрибуте
-	 *  - используемый тип (GL_FLOAT, GL_INT)
+	 *  - используемый тип (GL_FLOAT, GL_INT, GL_HALF_FLOAT, ...)
 	 *  - размер данных в байтах
+	 *  - нормализуются ли значения и читает ли их шейдер как целые
+	 *
+	 * Сжатые типы (`Half*`, `UNorm*`, `SNorm*`, `SNorm10_10_10_2`) шейдер читает как
+	 * `float`/`vec*`: нормализованные целые приводятся к [0, 1] или [-1, 1].
+	 * Данные для них готовятся функциями из `VertexQuantization.hpp`.
 	 */
 	enum class ShaderDataType {
-		Float,		///< float
-		Float2,		///< vec2 (2 float)
-		Float3,		///< vec3 (3 float)	
-		Float4,		///< vec4 (4 float)
-		Int,		///< int
-		Int2,		///< vec2 (2 int)
-		Int3,		///< vec3 (3 int)
-		Int4		///< vec4 (4 int)
+		Float,				///< float
+		Float2,				///< vec2 (2 float)
+		Float3,				///< vec3 (3 float)	
+		Float4,				///< vec4 (4 float)
+		Int,				///< int
+		Int2,				///< ivec2 (2 int)
+		Int3,				///< ivec3 (3 int)
+		Int4,				///< ivec4 (4 int)
+		Half2,				///< vec2 (2 half float, 4 байта)
+		Half4,				///< vec4 (4 half float, 8 байт)
+		UNorm8x4,			///< vec4 в [0, 1] (4 uint8, 4 байта) - цвет.
+		SNorm8x4,			///< vec4 в [-1, 1] (4 int8, 4 байта) - нормаль, касательная.
+		UNorm16x2,			///< vec2 в [0, 1] (2 uint16, 4 байта) - UV.
+		UNorm16x4,			///< vec4 в [0, 1] (4 uint16, 8 байт) - веса скиннинга.
+		SNorm16x2,			///< vec2 в [-1, 1] (2 int16, 4 байта).
+		SNorm16x4,			///< vec4 в [-1, 1] (4 int16, 8 байт).
+		SNorm10_10_10_2,	///< vec4 в [-1, 1] (`GL_INT_2_10_10_10_REV`, 4 байта) - нормаль и знак касательной.
+		UInt8x4				///< uvec4 (4 uint8, 4 байта) - индексы костей.
 	};
 
+	/// @internal
+	/// @brief Возвращает кол-во компонентов атрибута.
+	/// @param type Тип данных атрибута.
+	/// @return кол-во компонентов атрибута.
+	constexpr uint8_t getShaderDataComponentsCount(const ShaderDataType type) noexcept {
+		switch (type)
+		{
+		case ShaderDataType::Float:
+		case ShaderDataType::Int:
+			return 1;		
+		case ShaderDataType::Float2:
+		case ShaderDataType::Int2:
+		case ShaderDataType::Half2:
+		case ShaderDataType::UNorm16x2:
+		case ShaderDataType::SNorm16x2:
+			return 2;		
+		case ShaderDataType::Float3:
+		case ShaderDataType::Int3:
+			return 3;		
+		case ShaderDataType::Float4:
+		case ShaderDataType::Int4:
+		case ShaderDataType::Half4:
+		case ShaderDataType::UNorm8x4:
+		case ShaderDataType::SNorm8x4:
+		case ShaderDataType::UNorm16x4:
+		case ShaderDataType::SNorm16x4:
+		case ShaderDataType::SNorm10_10_10_2:
+		case ShaderDataType::UInt8x4:
+			return 4;		
+		}
+
+		return 0;
+	}
+	
+	/// @internal
+	/// @brief Возвращает размер атрибута в байтах.
+	/// @param type Тип данных атрибута.
+	/// @return Размера атрибута в байтах.
+	constexpr size_t getShaderDataComponentsSize(const ShaderDataType type) noexcept {
+		switch (type)
+		{
+		case ShaderDataType::Float:
+		case ShaderDataType::Float2:
+		case ShaderDataType::Float3:
+		case ShaderDataType::Float4:
+			return sizeof(float) * getShaderDataComponentsCount(type);
+		case ShaderDataType::Int:
+		case ShaderDataType::Int2:
+		case ShaderDataType::Int3:
+		case ShaderDataType::Int4:
+			return sizeof(int32_t) * getShaderDataComponentsCount(type);
+		case ShaderDataType::Half2:
+		case ShaderDataType::Half4:
+		case ShaderDataType::UNorm16x2:
+		case ShaderDataType::UNorm16x4:
+		case ShaderDataType::SNorm16x2:
+		case ShaderDataType::SNorm16x4:
+			return sizeof(uint16_t) * getShaderDataComponentsCount(type);
+		case ShaderDataType::UNorm8x4:
+		case ShaderDataType::SNorm8x4:
+		case ShaderDataType::UInt8x4:
+			return sizeof(uint8_t) * getShaderDataComponentsCount(type);
+		case ShaderDataType::SNorm10_10_10_2:
+			return sizeof(uint32_t);
+		}
+
+		return 0;
+	}
+
 	/**
 	 * @brief Структура, описывающая атрибут вершины.
 	 * 
@@ -43,12 +129,15 @@ namespace Engine {
 		size_t			componentCount;		///< Кол-во компонентов в атрибуте
 		size_t			size;				///< Размер Атрибута в байтах.
 		size_t			offset;				///< Смещение в байтах внутри структуры вершины.
+		bool			bNormalized;		///< Целые значения приводятся к [0, 1] или [-1, 1].
+		bool			bInteger;			///< Шейдер читает значения как целые (`glVertexAttribIPointer`).
 
 		/// @brief Конструктор атрибута вершины.
 		/// Конструктор получает тип данных структуры вершин
 		/// и заполняет все поля, исходя из выбранного типа.
 		/// @param type Тип данных структуры вершины.
-		BufferElement(const ShaderDataType type);
+		/// @param offset Смещение внутри вершины (для `BufferLayout` из списка вычисляется заново).
+		BufferElement(const ShaderDataType type, const size_t offset = 0);
 	};
 
 	class BufferLayout {
@@ -65,16 +154,50 @@ namespace Engine {
 			}
 		}
 
+		/// @brief Раскладка с заданными смещениями атрибутов (см. `getBufferLayout<Vertex>()`).
+		/// @param elements Атрибуты с заполненным `offset`.
+		/// @param stride Размер вершины в байтах.
+		BufferLayout(std::vector<BufferElement> elements, size_t stride)
+			: m_elements(std::move(elements))
+			, m_stride(stride)
+		{}
+
 		const std::vector<BufferElement>& getElements() const noexcept { return m_elements; };
 		size_t getStride() const noexcept { return m_stride; }
 
+		/// @brief Совпадает ли формат вершин (буферы с одинаковой раскладкой могут разделять VAO).
+		bool operator==(const BufferLayout& rhs) const noexcept {
+			if (m_stride != rhs.m_stride || m_elements.size() != rhs.m_elements.size()) {
+				return false;
+			}
+			for (size_t i = 0; i < m_elements.size(); ++i) {
+				if (m_elements[i].type != rhs.m_elements[i].type || m_elements[i].offset != rhs.m_elements[i].offset) {
+					return false;
+				}
+			}
+			return true;
+		}
+		bool operator!=(const BufferLayout& rhs) const noexcept { return !(*this == rhs); }
+
 	private:
 		std::vector<BufferElement>	m_elements;
 		size_t 						m_stride;
 	};
 
+	/// @internal
+	/// @brief Доступен ли Direct State Access (OpenGL 4.5).
+	///
+	/// С DSA буферы и VAO создаются и настраиваются без привязки к контексту,
+	/// иначе используется путь с `glBind*`. Сборка с `ENGINE_DISABLE_DSA`
+	/// всегда выбирает второй путь.
+	bool hasDirectStateAccess() noexcept;
+
 	/// @internal
 	/// @brief Класс, инкапсулирующий реализацию объекта буфера вершин.
+	///
+	/// С DSA хранилище буфера неизменяемое (`glNamedBufferStorage`), а буфер
+	/// `EUsage::Stream` постоянно отображён в память (`getMappedData()`), и данные
+	/// пишутся в него без вызовов OpenGL.
 	class VertexBuffer {
 	public:
 		/**
@@ -103,6 +226,16 @@ namespace Engine {
 			BufferLayout	layout,
 			const EUsage	usage = EUsage::Static
 		);
+
+		/// @internal
+		/// @brief Создаёт буфер из массива вершин, раскладка берётся из `VertexLayout<Vertex>`.
+		/// @note Определён в `VertexLayout.hpp`.
+		/// @param pVertices Вершины.
+		/// @param count Кол-во вершин.
+		/// @param usage Тип использования буфера (`EUsage`)
+		template<typename Vertex>
+		VertexBuffer(const Vertex* pVertices, size_t count, const EUsage usage = EUsage::Static);
+
 		~VertexBuffer();
 
 		/** 
@@ -146,9 +279,44 @@ namespace Engine {
 		/// @return Возвращает `BufferLayout`
 		const BufferLayout& getLayout() const { return m_layout; }
 
+		/// @internal
+		/// @brief Возвращает идентификатор буфера OpenGL.
+		unsigned int getId() const noexcept { return m_id; }
+
+		/// @internal
+		/// @brief Возвращает размер буфера в байтах.
+		size_t getSize() const noexcept { return m_size; }
+
+		/// @internal
+		/// @brief Обновляет часть данных буфера (`glBufferSubData`).
+		/// @note Буфер `EUsage::Static` не изменяется: в отладочной сборке срабатывает assert,
+		/// в релизной данные не записываются.
+		/// @param data Новые данные.
+		/// @param size Размер данных в байтах.
+		/// @param offset Смещение в буфере в байтах.
+		void setData(const void* data, size_t size, size_t offset = 0);
+
+		/// @internal
+		/// @brief Возвращает постоянно отображённую память буфера `EUsage::Stream`.
+		///
+		/// Отображение когерентное: записанное видно GPU в следующих командах. Пока
+		/// GPU читает участок буфера, его нельзя перезаписывать - синхронизацию
+		/// (fence) обеспечивает владелец.
+		///
+		/// @return Указатель на начало буфера или nullptr, если отображение недоступно
+		/// (тогда данные передаются через `setData()`).
+		void* getMappedData() const noexcept { return m_pMapped; }
+
+		/// @internal
+		/// @brief Задаёт отладочное имя буфера (видно в реестре ресурсов и GL отладчиках).
+		void setLabel(const std::string& label);
+
 	private:
 		unsigned int 		m_id;
 		BufferLayout		m_layout;
+		size_t				m_size		= 0;
+		EUsage				m_usage		= EUsage::Static;
+		void*				m_pMapped	= nullptr;
 	};
 
 } // namespace Engine
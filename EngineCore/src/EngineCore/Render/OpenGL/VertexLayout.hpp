@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "EngineCore/Render/OpenGL/VertexArray.hpp"
+#include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Атрибут вершины, известный на этапе компиляции.
+	 *
+	 * Создаётся макросом `ENGINE_VERTEX_ATTRIBUTE`, который берёт смещение из поля
+	 * структуры и проверяет, что размер поля совпадает с размером `ShaderDataType`.
+	 */
+	struct VertexAttribute {
+		ShaderDataType	type;
+		uint32_t		offset;
+	};
+
+	/**
+	 * @internal
+	 * @brief Описание раскладки вершинной структуры.
+	 *
+	 * Специализируется рядом со структурой вершины, атрибуты перечисляются
+	 * в порядке location в шейдере:
+	 * @code
+	 * struct MeshVertex {
+	 * 	float		position[3];
+	 * 	uint32_t	normal;
+	 * 	uint16_t	uv[2];
+	 * };
+	 *
+	 * template<>
+	 * struct VertexLayout<MeshVertex> {
+	 * 	static constexpr VertexAttribute attributes[] = {
+	 * 		ENGINE_VERTEX_ATTRIBUTE(MeshVertex, position,	ShaderDataType::Float3),
+	 * 		ENGINE_VERTEX_ATTRIBUTE(MeshVertex, normal,		ShaderDataType::SNorm10_10_10_2),
+	 * 		ENGINE_VERTEX_ATTRIBUTE(MeshVertex, uv,			ShaderDataType::UNorm16x2)
+	 * 	};
+	 * };
+	 *
+	 * VertexBuffer vertices(meshVertices.data(), meshVertices.size());	// раскладка берётся из типа
+	 * @endcode
+	 */
+	template<typename Vertex>
+	struct VertexLayout;
+
+	/// @internal
+	/// @brief Создаёт атрибут, проверяя размер поля (используется `ENGINE_VERTEX_ATTRIBUTE`).
+	template<ShaderDataType Type, typename Member>
+	constexpr VertexAttribute makeVertexAttribute(size_t offset) noexcept {
+		static_assert(sizeof(Member) == getShaderDataComponentsSize(Type), "Vertex member size does not match its ShaderDataType");
+		return { Type, static_cast<uint32_t>(offset) };
+	}
+
+	/// @internal
+	/// @brief Атрибут поля `member` структуры `Vertex` типа `type`.
+	#define ENGINE_VERTEX_ATTRIBUTE(Vertex, member, type) \
+		::Engine::makeVertexAttribute<type, decltype(Vertex::member)>(offsetof(Vertex, member))
+
+	/// @internal
+	/// @brief Идут ли атрибуты по возрастанию смещений без перекрытий.
+	template<typename Vertex>
+	constexpr bool areVertexAttributesOrdered() noexcept {
+		size_t end = 0;
+		for (const VertexAttribute& attribute : VertexLayout<Vertex>::attributes) {
+			if (attribute.offset < end) {
+				return false;
+			}
+			end = attribute.offset + getShaderDataComponentsSize(attribute.type);
+		}
+		return end <= sizeof(Vertex);
+	}
+
+	/// @internal
+	/// @brief Выровнены ли атрибуты и размер вершины по 4 байтам (иначе выборка вершин замедляется).
+	template<typename Vertex>
+	constexpr bool areVertexAttributesAligned() noexcept {
+		for (const VertexAttribute& attribute : VertexLayout<Vertex>::attributes) {
+			if (attribute.offset % 4 != 0) {
+				return false;
+			}
+		}
+		return sizeof(Vertex) % 4 == 0;
+	}
+
+	/// @internal
+	/// @brief Возвращает раскладку структуры `Vertex`.
+	///
+	/// Раскладка проверяется при компиляции и создаётся один раз в статической памяти;
+	/// шаг вершины равен `sizeof(Vertex)`.
+	template<typename Vertex>
+	const BufferLayout& getBufferLayout() {
+		static_assert(std::size(VertexLayout<Vertex>::attributes) > 0, "Vertex layout has no attributes");
+		static_assert(areVertexAttributesOrdered<Vertex>(), "Vertex attributes overlap, are out of order or exceed sizeof(Vertex)");
+		static_assert(areVertexAttributesAligned<Vertex>(), "Vertex attributes and vertex size must be 4-byte aligned");
+
+		static const BufferLayout layout = []() {
+			std::vector<BufferElement> elements;
+			elements.reserve(std::size(VertexLayout<Vertex>::attributes));
+			for (const VertexAttribute& attribute : VertexLayout<Vertex>::attributes) {
+				elements.emplace_back(attribute.type, attribute.offset);
+			}
+			return BufferLayout(std::move(elements), sizeof(Vertex));
+		}();
+		return layout;
+	}
+
+	template<typename Vertex>
+	VertexBuffer::VertexBuffer(const Vertex* pVertices, size_t count, const EUsage usage)
+		: VertexBuffer(pVertices, count * sizeof(Vertex), getBufferLayout<Vertex>(), usage)
+	{}
+
+	template<typename Vertex>
+	uint32_t VertexArray::addLayout() {
+		return addLayout(getBufferLayout<Vertex>());
+	}
+
+} // namespace Engine
@@ -0,0 +1,226 @@
+#include "EngineCore/Render/ParticleSimulation.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#include "EngineCore/Core/JobSystem.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define ENGINE_PARTICLES_SSE2 1
+	#include <emmintrin.h>
+#endif
+
+namespace Engine {
+
+	static constexpr uint32_t ChunkSize = 16 * 1024;	///< Частиц в блоке параллельного шага.
+
+	/// PCG хеш: тот же, что `pcgHash()` в compute шейдере.
+	static inline uint32_t pcgHash(const uint32_t value) noexcept {
+		const uint32_t state = value * 747796405u + 2891336453u;
+		const uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+		return (word >> 22u) ^ word;
+	}
+
+	/// Старшие 24 бита в [0, 1): преобразование точное и на CPU, и на GPU.
+	static inline float toUnit(const uint32_t value) noexcept {
+		return static_cast<float>(value >> 8) * (1.f / 16777216.f);
+	}
+
+	ParticleStepParams ParticleEmitter::next(const ParticleEmitterDesc& desc, const float deltaTime, const uint32_t capacity) noexcept {
+		ParticleStepParams params;
+		params.origin[0] = desc.origin.x;
+		params.origin[1] = desc.origin.y;
+		params.origin[2] = desc.origin.z;
+		params.origin[3] = desc.spread;
+		params.gravity[0] = desc.gravity.x;
+		params.gravity[1] = desc.gravity.y;
+		params.gravity[2] = desc.gravity.z;
+		params.gravity[3] = deltaTime;
+		params.speedMin = desc.speedMin;
+		params.speedMax = desc.speedMax;
+		params.lifeMin = desc.lifeMin;
+		params.lifeMax = desc.lifeMax;
+		params.damping = std::max(0.f, 1.f - desc.drag * deltaTime);
+		params.capacity = capacity;
+
+		// После долгого кадра испускается не больше, чем помещается.
+		m_accumulator += desc.rate * deltaTime;
+		const float whole = std::min(std::floor(m_accumulator), static_cast<float>(capacity));
+		m_accumulator = std::min(m_accumulator - whole, 1.f);
+		params.emitCount = static_cast<uint32_t>(whole);
+		params.emitBase = m_emitted;
+		m_emitted += params.emitCount;
+		return params;
+	}
+
+	Particle makeParticle(const uint32_t id, const ParticleStepParams& params) noexcept {
+		const uint32_t h0 = pcgHash(id);
+		const uint32_t h1 = pcgHash(h0);
+		const uint32_t h2 = pcgHash(h1);
+		const uint32_t h3 = pcgHash(h2);
+
+		const float spread = params.origin[3];
+		const float directionX = (toUnit(h0) * 2.f - 1.f) * spread;
+		const float directionZ = (toUnit(h1) * 2.f - 1.f) * spread;
+		const float speed = params.speedMin + (params.speedMax - params.speedMin) * toUnit(h2);
+
+		Particle particle;
+		particle.position[0] = params.origin[0];
+		particle.position[1] = params.origin[1];
+		particle.position[2] = params.origin[2];
+		particle.life = params.lifeMin + (params.lifeMax - params.lifeMin) * toUnit(h3);
+		particle.velocity[0] = directionX * speed;
+		particle.velocity[1] = speed;
+		particle.velocity[2] = directionZ * speed;
+		particle.id = id;
+		return particle;
+	}
+
+	ParticleSimulatorCpu::ParticleSimulatorCpu(const uint32_t capacity, JobSystem* pJobSystem)
+		: m_pJobSystem(pJobSystem)
+		, m_capacity(capacity)
+	{
+		m_particles[0].resize(capacity);
+		m_particles[1].resize(capacity);
+		m_chunkAlive.resize((capacity + ChunkSize - 1) / ChunkSize);
+	}
+
+	uint32_t ParticleSimulatorCpu::simulateChunk(Particle* pParticles, const uint32_t count, const ParticleStepParams& params) noexcept {
+		const float dt = params.gravity[3];
+		uint32_t alive = 0;
+
+		const float gravityDt[3] = { params.gravity[0] * dt, params.gravity[1] * dt, params.gravity[2] * dt };
+		uint32_t i = 0;
+
+#if defined(ENGINE_PARTICLES_SSE2)
+		// Четыре частицы за итерацию: строки (позиция, life) и (скорость, id) транспонируются
+		// в SoA, после чего каждый регистр содержит одну компоненту четырёх частиц.
+		// Столбец id только переставляется, поэтому его биты не меняются.
+		const __m128 gravityX = _mm_set1_ps(gravityDt[0]);
+		const __m128 gravityY = _mm_set1_ps(gravityDt[1]);
+		const __m128 gravityZ = _mm_set1_ps(gravityDt[2]);
+		const __m128 damping = _mm_set1_ps(params.damping);
+		const __m128 stepDt = _mm_set1_ps(dt);
+		const __m128 zero = _mm_setzero_ps();
+
+		for (; i + 4 <= count; i += 4) {
+			float* pSource = pParticles[i].position;
+			__m128 positionX = _mm_loadu_ps(pSource);
+			__m128 positionY = _mm_loadu_ps(pSource + 8);
+			__m128 positionZ = _mm_loadu_ps(pSource + 16);
+			__m128 life = _mm_loadu_ps(pSource + 24);
+			__m128 velocityX = _mm_loadu_ps(pSource + 4);
+			__m128 velocityY = _mm_loadu_ps(pSource + 12);
+			__m128 velocityZ = _mm_loadu_ps(pSource + 20);
+			__m128 id = _mm_loadu_ps(pSource + 28);
+			_MM_TRANSPOSE4_PS(positionX, positionY, positionZ, life);
+			_MM_TRANSPOSE4_PS(velocityX, velocityY, velocityZ, id);
+
+			velocityX = _mm_mul_ps(_mm_add_ps(velocityX, gravityX), damping);
+			velocityY = _mm_mul_ps(_mm_add_ps(velocityY, gravityY), damping);
+			velocityZ = _mm_mul_ps(_mm_add_ps(velocityZ, gravityZ), damping);
+			positionX = _mm_add_ps(positionX, _mm_mul_ps(velocityX, stepDt));
+			positionY = _mm_add_ps(positionY, _mm_mul_ps(velocityY, stepDt));
+			positionZ = _mm_add_ps(positionZ, _mm_mul_ps(velocityZ, stepDt));
+			life = _mm_sub_ps(life, stepDt);
+			const int aliveMask = _mm_movemask_ps(_mm_cmpgt_ps(life, zero));
+
+			// Обратно в AoS. Запись идёт не дальше уже прочитанных частиц, поэтому уплотнение на месте безопасно.
+			_MM_TRANSPOSE4_PS(positionX, positionY, positionZ, life);
+			_MM_TRANSPOSE4_PS(velocityX, velocityY, velocityZ, id);
+			const __m128 positionLife[4] = { positionX, positionY, positionZ, life };
+			const __m128 velocityId[4] = { velocityX, velocityY, velocityZ, id };
+			for (int lane = 0; lane < 4; ++lane) {
+				if (aliveMask & (1 << lane)) {
+					float* pTarget = pParticles[alive].position;
+					_mm_storeu_ps(pTarget, positionLife[lane]);
+					_mm_storeu_ps(pTarget + 4, velocityId[lane]);
+					++alive;
+				}
+			}
+		}
+#endif
+
+		// Без SSE2 - все частицы, иначе остаток меньше четырёх.
+		for (; i < count; ++i) {
+			Particle particle = pParticles[i];
+			for (int axis = 0; axis < 3; ++axis) {
+				particle.velocity[axis] = (particle.velocity[axis] + gravityDt[axis]) * params.damping;
+				particle.position[axis] = particle.position[axis] + particle.velocity[axis] * dt;
+			}
+			particle.life = particle.life - dt;
+			if (particle.life > 0.f) {
+				pParticles[alive++] = particle;
+			}
+		}
+		return alive;
+	}
+
+	void ParticleSimulatorCpu::step(const ParticleStepParams& params) {
+		const auto startTime = std::chrono::steady_clock::now();
+
+		const uint32_t count = m_aliveCount;
+		Particle* pSource = m_particles[m_current].data();
+		Particle* pTarget = m_particles[1 - m_current].data();
+		const uint32_t chunkCount = (count + ChunkSize - 1) / ChunkSize;
+
+		const auto forEachChunk = [this, chunkCount](const JobSystem::RangeJob& func) {
+			if (m_pJobSystem && chunkCount > 1) {
+				m_pJobSystem->parallelFor(chunkCount, 1, func);
+			}
+			else {
+				func(0, chunkCount);
+			}
+		};
+
+		// 1. Интеграция и уплотнение внутри блоков.
+		forEachChunk([&](const uint32_t begin, const uint32_t end) {
+			for (uint32_t chunk = begin; chunk < end; ++chunk) {
+				const uint32_t first = chunk * ChunkSize;
+				m_chunkAlive[chunk] = simulateChunk(pSource + first, std::min(ChunkSize, count - first), params);
+			}
+		});
+
+		// 2. Смещения блоков в целевом буфере.
+		uint32_t survivors = 0;
+		for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+			const uint32_t alive = m_chunkAlive[chunk];
+			m_chunkAlive[chunk] = survivors;
+			survivors += alive;
+		}
+
+		// 3. Выжившие переносятся подряд, порядок сохраняется.
+		forEachChunk([&](const uint32_t begin, const uint32_t end) {
+			for (uint32_t chunk = begin; chunk < end; ++chunk) {
+				const uint32_t offset = m_chunkAlive[chunk];
+				const uint32_t next = chunk + 1 < chunkCount ? m_chunkAlive[chunk + 1] : survivors;
+				std::memcpy(pTarget + offset, pSource + chunk * ChunkSize, (next - offset) * sizeof(Particle));
+			}
+		});
+
+		// 4. Новые частицы за выжившими, лишние отбрасываются (как на GPU).
+		const uint32_t emitCount = std::min(params.emitCount, m_capacity - survivors);
+		const auto emit = [&](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				pTarget[survivors + i] = makeParticle(params.emitBase + i, params);
+			}
+		};
+		if (m_pJobSystem && emitCount > ChunkSize) {
+			m_pJobSystem->parallelFor(emitCount, ChunkSize, emit);
+		}
+		else {
+			emit(0, emitCount);
+		}
+
+		m_current = 1 - m_current;
+		m_aliveCount = survivors + emitCount;
+
+		m_stats.aliveCount = m_aliveCount;
+		m_stats.emitted = emitCount;
+		m_stats.died = count - survivors;
+		m_stats.stepMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+} // namespace Engine
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "EngineCore/Math.hpp"
+
+namespace Engine {
+
+	class JobSystem;
+
+	/**
+	 * @internal
+	 * @brief Частица в памяти CPU и в SSBO (std430, 32 байта).
+	 *
+	 * Совпадает со структурой `Particle` в шейдерах `ParticleSystem`.
+	 */
+	struct Particle {
+		float		position[3];
+		float		life;			///< Оставшееся время жизни, с; частица умирает при `life <= 0`.
+		float		velocity[3];
+		uint32_t	id;				///< Порядковый номер испускания, задаёт случайные параметры.
+	};
+
+	static_assert(sizeof(Particle) == 32, "Particle must match the std430 layout");
+
+	/**
+	 * @internal
+	 * @brief Входные данные одного шага симуляции (std430, 64 байта).
+	 *
+	 * Одна и та же структура загружается в SSBO для compute шейдеров
+	 * и передаётся в `ParticleSimulatorCpu::step()`, поэтому оба пути
+	 * получают одинаковые числа. Совпадает с блоком `ParticleStep` в шейдерах.
+	 */
+	struct alignas(16) ParticleStepParams {
+		float		origin[4]	= {};	///< xyz - точка испускания, w - разброс направления.
+		float		gravity[4]	= {};	///< xyz - ускорение, w - шаг времени, с.
+		float		speedMin	= 0.f;
+		float		speedMax	= 0.f;
+		float		lifeMin		= 0.f;
+		float		lifeMax		= 0.f;
+		float		damping		= 1.f;	///< Множитель скорости за шаг.
+		uint32_t	emitCount	= 0;	///< Новых частиц в этом шаге.
+		uint32_t	emitBase	= 0;	///< `id` первой новой частицы.
+		uint32_t	capacity	= 0;
+	};
+
+	static_assert(sizeof(ParticleStepParams) == 64, "ParticleStepParams must match the std430 layout");
+
+	/**
+	 * @internal
+	 * @brief Описание источника частиц.
+	 */
+	struct ParticleEmitterDesc {
+		Vec3		origin;
+		Vec3		gravity		= { 0.f, -9.8f, 0.f };
+		float		spread		= 0.4f;		///< Разброс направления по X и Z относительно оси Y.
+		float		speedMin	= 2.f;
+		float		speedMax	= 6.f;
+		float		lifeMin		= 1.f;
+		float		lifeMax		= 3.f;
+		float		drag		= 0.2f;		///< Доля скорости, теряемая за секунду.
+		float		rate		= 10000.f;	///< Частиц в секунду.
+	};
+
+	/**
+	 * @internal
+	 * @brief Превращает описание источника и шаг времени в `ParticleStepParams`.
+	 *
+	 * Дробная часть `rate * deltaTime` переносится на следующий шаг, номера
+	 * частиц идут подряд. Два эмиттера с одинаковыми входами выдают одинаковые
+	 * параметры, поэтому CPU и GPU симуляции можно сравнивать шаг за шагом.
+	 */
+	class ParticleEmitter {
+	public:
+		ParticleStepParams next(const ParticleEmitterDesc& desc, float deltaTime, uint32_t capacity) noexcept;
+
+		/// @internal
+		/// @brief Сколько частиц испущено за всё время (включая не поместившиеся).
+		uint32_t getEmittedCount() const noexcept { return m_emitted; }
+
+	private:
+		float		m_accumulator	= 0.f;
+		uint32_t	m_emitted		= 0;
+	};
+
+	/**
+	 * @internal
+	 * @brief Начальное состояние частицы `id` (то же, что `makeParticle()` в compute шейдере).
+	 */
+	Particle makeParticle(uint32_t id, const ParticleStepParams& params) noexcept;
+
+	/**
+	 * @internal
+	 * @brief Статистика шага `ParticleSimulatorCpu`.
+	 */
+	struct ParticleCpuStats {
+		uint32_t	aliveCount	= 0;
+		uint32_t	emitted		= 0;	///< Поместилось в этом шаге.
+		uint32_t	died		= 0;
+		float		stepMs		= 0.f;
+	};
+
+	/**
+	 * @internal
+	 * @brief Симуляция частиц на CPU: запасной путь `ParticleSystem` и эталон для проверки GPU.
+	 *
+	 * Шаг повторяет compute шейдеры:
+	 * 1. живые частицы интегрируются (`v = (v + g * dt) * damping`, `p += v * dt`,
+	 *    `life -= dt`) и выжившие уплотняются в начало второго буфера;
+	 * 2. новые частицы дописываются за выжившими, пока есть место;
+	 * 3. буферы меняются местами.
+	 *
+	 * С SSE2 частицы обрабатываются по четыре: блок транспонируется из AoS в SoA
+	 * (регистр на компоненту), считается и транспонируется обратно; остаток меньше
+	 * четырёх частиц считается скалярно. Массив делится на блоки, которые считаются параллельно
+	 * в `JobSystem`; уплотнение через префиксные суммы сохраняет порядок, поэтому
+	 * результат не зависит от числа потоков.
+	 *
+	 * Порядок частиц на GPU другой (уплотнение атомарным счётчиком), но множество
+	 * частиц то же: для сравнения их сортируют по `id`. Значения совпадают побитно:
+	 * шейдеры считают с `precise`, а этот файл собирается без объединения умножения
+	 * и сложения в FMA (`-ffp-contract=off`).
+	 */
+	class ParticleSimulatorCpu {
+	public:
+		/// @param capacity Максимум живых частиц.
+		/// @param pJobSystem Пул потоков (nullptr - в вызывающем потоке).
+		explicit ParticleSimulatorCpu(uint32_t capacity, JobSystem* pJobSystem = nullptr);
+
+		/// @internal
+		/// @brief Выполняет один шаг симуляции.
+		void step(const ParticleStepParams& params);
+
+		/// @internal
+		/// @brief Удаляет все частицы.
+		void clear() noexcept { m_aliveCount = 0; }
+
+		/// @internal
+		/// @brief Живые частицы: `getAliveCount()` элементов подряд.
+		const Particle* getParticles() const noexcept { return m_particles[m_current].data(); }
+		uint32_t getAliveCount() const noexcept { return m_aliveCount; }
+		uint32_t getCapacity() const noexcept { return m_capacity; }
+		const ParticleCpuStats& getStats() const noexcept { return m_stats; }
+
+	private:
+		/// Интегрирует блок на месте, уплотняет выживших к его началу и возвращает их число.
+		static uint32_t simulateChunk(Particle* pParticles, uint32_t count, const ParticleStepParams& params) noexcept;
+
+		JobSystem*				m_pJobSystem;
+		uint32_t				m_capacity;
+		std::vector<Particle>	m_particles[2];
+		std::vector<uint32_t>	m_chunkAlive;		///< Выживших в каждом блоке текущего шага.
+		uint32_t				m_current		= 0;
+		uint32_t				m_aliveCount	= 0;
+		ParticleCpuStats		m_stats;
+	};
+
+} // namespace Engine
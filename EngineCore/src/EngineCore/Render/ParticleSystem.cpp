@@ -0,0 +1,407 @@
+#include "EngineCore/Render/ParticleSystem.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include <glad/glad.h>
+#include <imgui/imgui.h>
+
+#include "EngineCore/Log.hpp"
+#include "EngineCore/Render/OpenGL/ShaderProgram.hpp"
+#include "EngineCore/Render/OpenGL/StorageBuffer.hpp"
+#include "EngineCore/Render/OpenGL/VertexArray.hpp"
+#include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
+#include "EngineCore/Render/RenderStats.hpp"
+
+namespace Engine {
+
+	static constexpr uint32_t GroupSize = 256;	///< `local_size_x` шейдеров simulate и emit.
+
+	// Точки привязки SSBO.
+	static constexpr unsigned int SourceBinding		= 0;
+	static constexpr unsigned int TargetBinding		= 1;
+	static constexpr unsigned int ControlBinding	= 2;
+	static constexpr unsigned int StepBinding		= 3;
+
+	// Шейдерам хватает 4.5 (compute, SSBO, непрямые вызовы): так GPU путь доступен и в Mesa.
+	// Структуры совпадают с `Particle`, `ParticleSystem::Control` и `ParticleStepParams`.
+	static const char* s_commonSource =
+	"#version 450\n"
+	"struct Particle {\n"
+	"	vec3 position;\n"
+	"	float life;\n"
+	"	vec3 velocity;\n"
+	"	uint id;\n"
+	"};\n"
+	"layout(std430, binding = 2) coherent buffer ParticleControl {\n"
+	"	uint dispatchX;\n"
+	"	uint dispatchY;\n"
+	"	uint dispatchZ;\n"
+	"	uint vertexCount;\n"
+	"	uint instanceCount;\n"
+	"	uint firstVertex;\n"
+	"	uint baseInstance;\n"
+	"	uint aliveCount;\n"
+	"	uint survivorCount;\n"
+	"};\n"
+	"layout(std430, binding = 3) readonly buffer ParticleStep {\n"
+	"	vec4 origin;\n"		// w - разброс направления
+	"	vec4 gravity;\n"	// w - шаг времени
+	"	float speedMin;\n"
+	"	float speedMax;\n"
+	"	float lifeMin;\n"
+	"	float lifeMax;\n"
+	"	float damping;\n"
+	"	uint emitCount;\n"
+	"	uint emitBase;\n"
+	"	uint capacity;\n"
+	"};\n";
+
+	// `precise` запрещает объединять умножение и сложение в FMA: результаты побитно совпадают с CPU.
+	static const char* s_simulateSource =
+	"layout(local_size_x = 256) in;\n"
+	"layout(std430, binding = 0) readonly buffer Source { Particle source[]; };\n"
+	"layout(std430, binding = 1) writeonly buffer Target { Particle target[]; };\n"
+	"void main() {\n"
+	"	uint index = gl_GlobalInvocationID.x;\n"
+	"	if (index >= aliveCount) {\n"
+	"		return;\n"
+	"	}\n"
+	"	Particle particle = source[index];\n"
+	"	float dt = gravity.w;\n"
+	"	precise vec3 velocity = (particle.velocity + gravity.xyz * dt) * damping;\n"
+	"	precise vec3 position = particle.position + velocity * dt;\n"
+	"	precise float life = particle.life - dt;\n"
+	"	if (life > 0.0) {\n"
+	"		target[atomicAdd(survivorCount, 1u)] = Particle(position, life, velocity, particle.id);\n"
+	"	}\n"
+	"}\n";
+
+	// Новые частицы идут сразу за выжившими: позиция не зависит от порядка потоков.
+	static const char* s_emitSource =
+	"layout(local_size_x = 256) in;\n"
+	"layout(std430, binding = 1) writeonly buffer Target { Particle target[]; };\n"
+	"uint pcgHash(uint value) {\n"
+	"	uint state = value * 747796405u + 2891336453u;\n"
+	"	uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;\n"
+	"	return (word >> 22u) ^ word;\n"
+	"}\n"
+	"float toUnit(uint value) {\n"
+	"	return float(value >> 8u) * (1.0 / 16777216.0);\n"
+	"}\n"
+	"void main() {\n"
+	"	uint i = gl_GlobalInvocationID.x;\n"
+	"	uint index = survivorCount + i;\n"
+	"	if (i >= emitCount || index >= capacity) {\n"
+	"		return;\n"
+	"	}\n"
+	"	uint id = emitBase + i;\n"
+	"	uint h0 = pcgHash(id);\n"
+	"	uint h1 = pcgHash(h0);\n"
+	"	uint h2 = pcgHash(h1);\n"
+	"	uint h3 = pcgHash(h2);\n"
+	"	precise float directionX = (toUnit(h0) * 2.0 - 1.0) * origin.w;\n"
+	"	precise float directionZ = (toUnit(h1) * 2.0 - 1.0) * origin.w;\n"
+	"	precise float speed = speedMin + (speedMax - speedMin) * toUnit(h2);\n"
+	"	precise float life = lifeMin + (lifeMax - lifeMin) * toUnit(h3);\n"
+	"	precise vec3 velocity = vec3(directionX * speed, speed, directionZ * speed);\n"
+	"	target[index] = Particle(origin.xyz, life, velocity, id);\n"
+	"}\n";
+
+	static const char* s_finalizeSource =
+	"layout(local_size_x = 1) in;\n"
+	"void main() {\n"
+	"	uint count = min(survivorCount + emitCount, capacity);\n"
+	"	aliveCount = count;\n"
+	"	survivorCount = 0u;\n"
+	"	dispatchX = (count + 255u) / 256u;\n"
+	"	dispatchY = 1u;\n"
+	"	dispatchZ = 1u;\n"
+	"	vertexCount = 4u;\n"
+	"	instanceCount = count;\n"
+	"	firstVertex = 0u;\n"
+	"	baseInstance = 0u;\n"
+	"}\n";
+
+	// Квадрат из gl_VertexID (полоса из 4 вершин), частица - из gl_InstanceID.
+	// Uniform без `layout(location)`: тот же код фрагмента собирается и для GLSL 3.30.
+	static const char* s_vertexSource =
+	"#version 450\n"
+	"struct Particle {\n"
+	"	vec3 position;\n"
+	"	float life;\n"
+	"	vec3 velocity;\n"
+	"	uint id;\n"
+	"};\n"
+	"layout(std430, binding = 0) readonly buffer Particles { Particle particles[]; };\n"
+	"uniform mat4 viewProjection;\n"
+	"uniform vec4 clipScale;\n"	// xy - половина размера в пространстве отсечения, z - 1 / lifeMax
+	"out vec2 vCorner;\n"
+	"out float vFade;\n"
+	"void main() {\n"
+	"	Particle particle = particles[gl_InstanceID];\n"
+	"	vCorner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0 - 1.0;\n"
+	"	vFade = clamp(particle.life * clipScale.z, 0.0, 1.0);\n"
+	"	gl_Position = viewProjection * vec4(particle.position, 1.0);\n"
+	"	gl_Position.xy += vCorner * clipScale.xy;\n"
+	"}\n";
+
+	// CPU путь: без SSBO, частица (позиция и время жизни) - атрибут экземпляра.
+	static const char* s_cpuVertexSource =
+	"#version 330 core\n"
+	"layout(location = 0) in vec4 particle;\n"
+	"uniform mat4 viewProjection;\n"
+	"uniform vec4 clipScale;\n"
+	"out vec2 vCorner;\n"
+	"out float vFade;\n"
+	"void main() {\n"
+	"	vCorner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0 - 1.0;\n"
+	"	vFade = clamp(particle.w * clipScale.z, 0.0, 1.0);\n"
+	"	gl_Position = viewProjection * vec4(particle.xyz, 1.0);\n"
+	"	gl_Position.xy += vCorner * clipScale.xy;\n"
+	"}\n";
+
+	static const char* s_fragmentSource =
+	"uniform vec4 color;\n"
+	"in vec2 vCorner;\n"
+	"in float vFade;\n"
+	"out vec4 fragmentColor;\n"
+	"void main() {\n"
+	"	float falloff = max(1.0 - dot(vCorner, vCorner), 0.0);\n"
+	"	fragmentColor = vec4(color.rgb * (color.a * vFade * falloff), 1.0);\n"
+	"}\n";
+
+	static std::unique_ptr<ShaderProgram> createComputeProgram(const char* source, const char* label) {
+		const std::string fullSource = std::string(s_commonSource) + source;
+		auto pProgram = std::make_unique<ShaderProgram>(fullSource.c_str());
+		pProgram->setLabel(label);
+		return pProgram;
+	}
+
+	ParticleSystem::ParticleSystem(const ParticleSystemParams& params, JobSystem* pJobSystem)
+		: m_params(params)
+	{
+		m_bGpu = !params.bForceCpu && GLAD_GL_VERSION_4_5;
+		if (!params.bForceCpu && !m_bGpu) {
+			LOG_WARN("[ParticleSystem] OpenGL 4.5 is not available, particles are simulated on the CPU");
+		}
+
+		const size_t particleBytes = static_cast<size_t>(params.capacity) * sizeof(Particle);
+		if (!m_bGpu) {
+			// Хватает OpenGL 3.3: живые частицы загружаются в вершинный буфер экземпляров.
+			const BufferLayout layout({ BufferElement(ShaderDataType::Float4, offsetof(Particle, position)) }, sizeof(Particle));
+			m_pInstanceBuffer = std::make_unique<VertexBuffer>(nullptr, particleBytes, layout, VertexBuffer::EUsage::Dynamic);
+			m_pInstanceBuffer->setLabel("Particle instances");
+			m_pVertexArray = std::make_unique<VertexArray>();
+			m_pVertexArray->setVertexBuffer(m_pVertexArray->addLayout(layout, 1), *m_pInstanceBuffer);
+
+			m_pRenderProgram = std::make_unique<ShaderProgram>(s_cpuVertexSource, (std::string("#version 330 core\n") + s_fragmentSource).c_str());
+			m_pRenderProgram->setLabel("Particle render program");
+			m_pCpuSimulator = std::make_unique<ParticleSimulatorCpu>(params.capacity, pJobSystem);
+			m_stats.bGpu = false;
+			initRenderLocations();
+			return;
+		}
+
+		for (uint32_t i = 0; i < 2; ++i) {
+			m_pParticles[i] = std::make_unique<StorageBuffer>(nullptr, particleBytes, StorageBuffer::EUsage::GpuOnly);
+			m_pParticles[i]->setLabel(i == 0 ? "Particles A" : "Particles B");
+		}
+		m_pRenderProgram = std::make_unique<ShaderProgram>(s_vertexSource, (std::string("#version 450\n") + s_fragmentSource).c_str());
+		m_pRenderProgram->setLabel("Particle render program");
+		m_pVertexArray = std::make_unique<VertexArray>();
+		initRenderLocations();
+
+		const Control control;
+		m_pControl = std::make_unique<StorageBuffer>(&control, sizeof(Control), StorageBuffer::EUsage::Dynamic);
+		m_pControl->setLabel("Particle control");
+		m_pStep = std::make_unique<StorageBuffer>(nullptr, sizeof(ParticleStepParams), StorageBuffer::EUsage::Dynamic);
+		m_pStep->setLabel("Particle step");
+		m_pReadback = std::make_unique<StorageBuffer>(nullptr, ReadbackSlots * sizeof(uint32_t), StorageBuffer::EUsage::Readback);
+		m_pReadback->setLabel("Particle count readback");
+
+		m_pSimulateProgram = createComputeProgram(s_simulateSource, "Particle simulate");
+		m_pEmitProgram = createComputeProgram(s_emitSource, "Particle emit");
+		m_pFinalizeProgram = createComputeProgram(s_finalizeSource, "Particle finalize");
+		m_stats.bGpu = true;
+	}
+
+	ParticleSystem::~ParticleSystem() {
+		for (void*& pFence : m_readbackFences) {
+			if (pFence) {
+				glDeleteSync(static_cast<GLsync>(pFence));
+				pFence = nullptr;
+			}
+		}
+	}
+
+	void ParticleSystem::update(const float deltaTime) {
+		const auto startTime = std::chrono::steady_clock::now();
+
+		const ParticleStepParams params = m_emitterState.next(m_emitter, deltaTime, m_params.capacity);
+		if (m_bGpu) {
+			updateGpu(params);
+		}
+		else {
+			updateCpu(params);
+		}
+
+		// Не поместившиеся в пул частицы отбрасываются. На CPU их число известно точно,
+		// на GPU свободное место оценивается по числу живых, прочитанному с задержкой.
+		const uint32_t freeCount = m_params.capacity - std::min(m_stats.aliveCount, m_params.capacity);
+		m_stats.emittedLastStep = m_bGpu ? std::min(params.emitCount, freeCount) : m_pCpuSimulator->getStats().emitted;
+		m_stats.emittedTotal += m_stats.emittedLastStep;
+		m_stats.cpuMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	void ParticleSystem::updateGpu(const ParticleStepParams& params) {
+		pollReadback();
+
+		StorageBuffer& source = *m_pParticles[m_current];
+		StorageBuffer& target = *m_pParticles[1 - m_current];
+		m_pStep->setData(&params, sizeof(params));
+
+		source.bindBase(SourceBinding);
+		target.bindBase(TargetBinding);
+		m_pControl->bindBase(ControlBinding);
+		m_pStep->bindBase(StepBinding);
+		m_pControl->bindIndirect();
+
+		// Число групп записал `finalize` прошлого шага.
+		m_pSimulateProgram->dispatchIndirect(offsetof(Control, dispatchX));
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+		if (params.emitCount > 0) {
+			m_pEmitProgram->dispatch((params.emitCount + GroupSize - 1) / GroupSize);
+			glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+		}
+
+		m_pFinalizeProgram->dispatch(1);
+		// Следующие читатели: непрямые вызовы, вершинный шейдер, следующий шаг и копия счётчика.
+		glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+		m_current = 1 - m_current;
+
+		// Счётчик копируется в свободный слот; если все заняты, кадр пропускается.
+		if (!m_readbackFences[m_readbackIndex]) {
+			m_pControl->copyTo(*m_pReadback, offsetof(Control, aliveCount), m_readbackIndex * sizeof(uint32_t), sizeof(uint32_t));
+			m_readbackFences[m_readbackIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			m_readbackIndex = (m_readbackIndex + 1) % ReadbackSlots;
+		}
+	}
+
+	void ParticleSystem::updateCpu(const ParticleStepParams& params) {
+		m_pCpuSimulator->step(params);
+		m_stats.aliveCount = m_pCpuSimulator->getAliveCount();
+		if (m_stats.aliveCount > 0) {
+			m_pInstanceBuffer->setData(m_pCpuSimulator->getParticles(), m_stats.aliveCount * sizeof(Particle));
+		}
+	}
+
+	void ParticleSystem::initRenderLocations() {
+		m_viewProjectionLocation = m_pRenderProgram->getUniformLocation("viewProjection");
+		m_clipScaleLocation = m_pRenderProgram->getUniformLocation("clipScale");
+		m_colorLocation = m_pRenderProgram->getUniformLocation("color");
+	}
+
+	void ParticleSystem::pollReadback() {
+		// Слоты проверяются от старого к новому, число живых берётся из последнего готового.
+		const uint32_t* pCounts = static_cast<const uint32_t*>(m_pReadback->getMappedData());
+		for (uint32_t i = 0; i < ReadbackSlots; ++i) {
+			const uint32_t slot = (m_readbackIndex + i) % ReadbackSlots;
+			GLsync fence = static_cast<GLsync>(m_readbackFences[slot]);
+			if (!fence || glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+				continue;
+			}
+			glDeleteSync(fence);
+			m_readbackFences[slot] = nullptr;
+			m_stats.aliveCount = pCounts[slot];
+		}
+	}
+
+	void ParticleSystem::render(const Mat4& viewProjection, const Mat4& projection) {
+		if (!m_bGpu && m_stats.aliveCount == 0) {
+			return;
+		}
+
+		const float halfSize = m_params.size * 0.5f;
+		const float lifeScale = m_emitter.lifeMax > 0.f ? 1.f / m_emitter.lifeMax : 1.f;
+
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_ONE, GL_ONE);
+		glDepthMask(GL_FALSE);
+
+		m_pRenderProgram->setMatrix4(m_viewProjectionLocation, viewProjection.data());
+		m_pRenderProgram->setFloat4(m_clipScaleLocation, projection(0, 0) * halfSize, projection(1, 1) * halfSize, lifeScale, 0.f);
+		m_pRenderProgram->setFloat4(m_colorLocation, m_params.color[0], m_params.color[1], m_params.color[2], m_params.color[3]);
+		m_pRenderProgram->bind();
+		m_pVertexArray->bind();
+
+		if (m_bGpu) {
+			m_pParticles[m_current]->bindBase(SourceBinding);
+			m_pControl->bindIndirect();
+			glDrawArraysIndirect(GL_TRIANGLE_STRIP, reinterpret_cast<const void*>(offsetof(Control, vertexCount)));
+		}
+		else {
+			glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(m_stats.aliveCount));
+		}
+		// На GPU пути число экземпляров известно с задержкой.
+		RenderStats::addDrawCall(4, m_stats.aliveCount);
+
+		glDepthMask(GL_TRUE);
+		glDisable(GL_BLEND);
+	}
+
+	void ParticleSystem::clear() {
+		if (m_bGpu) {
+			const Control control;
+			m_pControl->setData(&control, sizeof(control));
+		}
+		else {
+			m_pCpuSimulator->clear();
+		}
+		m_stats.aliveCount = 0;
+	}
+
+	std::vector<Particle> ParticleSystem::readParticles() const {
+		if (!m_bGpu) {
+			const Particle* pParticles = m_pCpuSimulator->getParticles();
+			return std::vector<Particle>(pParticles, pParticles + m_pCpuSimulator->getAliveCount());
+		}
+
+		uint32_t aliveCount = 0;
+		m_pControl->readData(&aliveCount, sizeof(aliveCount), offsetof(Control, aliveCount));
+		std::vector<Particle> particles(aliveCount);
+		if (aliveCount > 0) {
+			m_pParticles[m_current]->readData(particles.data(), aliveCount * sizeof(Particle));
+		}
+		return particles;
+	}
+
+	void ParticleSystem::drawImGuiPanel() {
+		if (ImGui::Begin("Частицы")) {
+			ImGui::Text("Режим: %s", m_bGpu ? "GPU (compute)" : "CPU");
+			ImGui::Text("Живых: %u / %u%s", m_stats.aliveCount, m_params.capacity, m_bGpu ? " (с задержкой)" : "");
+			ImGui::Text("Испущено: %llu", static_cast<unsigned long long>(m_stats.emittedTotal));
+			ImGui::Text("CPU: %.3f ms", m_stats.cpuMs);
+
+			ImGui::Separator();
+			ImGui::DragFloat3("Источник", &m_emitter.origin.x, 0.05f);
+			ImGui::DragFloat3("Гравитация", &m_emitter.gravity.x, 0.05f);
+			ImGui::SliderFloat("Частиц в секунду", &m_emitter.rate, 0.f, 1000000.f, "%.0f");
+			ImGui::SliderFloat("Разброс", &m_emitter.spread, 0.f, 2.f);
+			ImGui::SliderFloat("Скорость min", &m_emitter.speedMin, 0.f, 20.f);
+			ImGui::SliderFloat("Скорость max", &m_emitter.speedMax, 0.f, 20.f);
+			ImGui::SliderFloat("Жизнь min", &m_emitter.lifeMin, 0.f, 10.f);
+			ImGui::SliderFloat("Жизнь max", &m_emitter.lifeMax, 0.f, 10.f);
+			ImGui::SliderFloat("Сопротивление", &m_emitter.drag, 0.f, 5.f);
+			if (ImGui::Button("Очистить")) {
+				clear();
+			}
+		}
+		ImGui::End();
+	}
+
+} // namespace Engine
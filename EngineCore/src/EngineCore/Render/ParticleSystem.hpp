@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EngineCore/Math.hpp"
+#include "EngineCore/Render/ParticleSimulation.hpp"
+
+namespace Engine {
+
+	class JobSystem;
+	class ShaderProgram;
+	class StorageBuffer;
+	class VertexArray;
+	class VertexBuffer;
+
+	/**
+	 * @internal
+	 * @brief Параметры `ParticleSystem`.
+	 */
+	struct ParticleSystemParams {
+		uint32_t	capacity	= 1024 * 1024;	///< Максимум живых частиц.
+		float		size		= 0.05f;		///< Размер квадрата частицы в мировых единицах.
+		float		color[4]	= { 1.f, 0.6f, 0.2f, 1.f };
+		bool		bForceCpu	= false;		///< Считать на CPU даже при наличии compute шейдеров.
+	};
+
+	/**
+	 * @internal
+	 * @brief Статистика `ParticleSystem`.
+	 */
+	struct ParticleSystemStats {
+		uint32_t	aliveCount		= 0;	///< На GPU - с задержкой в несколько кадров.
+		uint32_t	emittedLastStep	= 0;	///< Поместилось в пул в прошлом шаге (на GPU - оценка).
+		uint64_t	emittedTotal	= 0;
+		float		cpuMs			= 0.f;	///< Время `update()` на CPU (на GPU - только отправка команд).
+		bool		bGpu			= false;
+	};
+
+	/**
+	 * @internal
+	 * @brief Система частиц, которая считается в compute шейдерах.
+	 *
+	 * Частицы живут в двух SSBO, между которыми каждый шаг переходит симуляция:
+	 * 1. `simulate` интегрирует живые частицы буфера A и дописывает выживших
+	 *    в буфер B через атомарный счётчик. Число групп берётся из буфера
+	 *    управления (`glDispatchComputeIndirect`);
+	 * 2. `emit` дописывает новые частицы за выжившими (позиция = счётчик + номер потока,
+	 *    поэтому при переполнении отбрасываются одни и те же частицы);
+	 * 3. `finalize` (один поток) записывает число живых, аргументы следующего
+	 *    `simulate` и команду `glDrawArraysIndirect`.
+	 *
+	 * CPU не читает ни частицы, ни счётчики: отрисовка идёт по непрямой команде,
+	 * вершинный шейдер строит квадрат из `gl_VertexID` и читает частицу
+	 * `gl_InstanceID` из SSBO. Число живых частиц для статистики копируется
+	 * в отображённый буфер и читается через несколько кадров по fence.
+	 *
+	 * Без OpenGL 4.5 (или с `bForceCpu`) шаг выполняет `ParticleSimulatorCpu`,
+	 * живые частицы загружаются в вершинный буфер экземпляров и рисуются
+	 * шейдером GLSL 3.30, поэтому этому пути достаточно OpenGL 3.3.
+	 *
+	 * Пример использования
+	 * @code
+	 * ParticleSystem sparks({}, &jobSystem);
+	 * ParticleEmitterDesc& emitter = sparks.getEmitter();
+	 * emitter.origin = { 0.f, 1.f, 0.f };
+	 *
+	 * // Каждый кадр
+	 * sparks.update(deltaTime);
+	 * sparks.render(camera.viewProjection, camera.projection);
+	 * @endcode
+	 */
+	class ParticleSystem {
+	public:
+		explicit ParticleSystem(const ParticleSystemParams& params = {}, JobSystem* pJobSystem = nullptr);
+		~ParticleSystem();
+
+		ParticleSystem(const ParticleSystem&)				= delete;
+		ParticleSystem& operator=(const ParticleSystem&)	= delete;
+		ParticleSystem(ParticleSystem&&)					= delete;
+		ParticleSystem& operator=(ParticleSystem&&)			= delete;
+
+		/// @internal
+		/// @brief Источник частиц; изменения действуют со следующего `update()`.
+		ParticleEmitterDesc& getEmitter() noexcept { return m_emitter; }
+
+		/// @internal
+		/// @brief Выполняет шаг симуляции.
+		void update(float deltaTime);
+
+		/// @internal
+		/// @brief Рисует частицы аддитивно, без записи глубины.
+		/// @param viewProjection Матрица камеры.
+		/// @param projection Матрица проекции (масштаб квадратов в пространстве отсечения).
+		void render(const Mat4& viewProjection, const Mat4& projection);
+
+		/// @internal
+		/// @brief Удаляет все частицы.
+		void clear();
+
+		/// @internal
+		/// @brief Читает живые частицы с GPU, дожидаясь конца симуляции.
+		/// @note Останавливает конвейер: только для тестов и сверки с `ParticleSimulatorCpu`.
+		std::vector<Particle> readParticles() const;
+
+		bool isGpu() const noexcept { return m_bGpu; }
+		const ParticleSystemStats& getStats() const noexcept { return m_stats; }
+
+		/// @internal
+		/// @brief Рисует ImGui окно с параметрами источника и статистикой.
+		void drawImGuiPanel();
+
+	private:
+		/// Буфер управления: аргументы непрямых вызовов и счётчики (std430, как `ParticleControl`).
+		struct Control {
+			uint32_t	dispatchX		= 0;
+			uint32_t	dispatchY		= 1;
+			uint32_t	dispatchZ		= 1;
+			uint32_t	vertexCount		= 4;
+			uint32_t	instanceCount	= 0;
+			uint32_t	firstVertex		= 0;
+			uint32_t	baseInstance	= 0;
+			uint32_t	aliveCount		= 0;
+			uint32_t	survivorCount	= 0;
+		};
+
+		/// Кадров, через которые читается число живых частиц.
+		static constexpr uint32_t ReadbackSlots = 3;
+
+		void updateGpu(const ParticleStepParams& params);
+		void updateCpu(const ParticleStepParams& params);
+		void pollReadback();
+		void initRenderLocations();
+
+		ParticleSystemParams					m_params;
+		ParticleEmitterDesc						m_emitter;
+		ParticleEmitter							m_emitterState;
+		bool									m_bGpu			= false;
+
+		std::unique_ptr<StorageBuffer>			m_pParticles[2];	///< Только на GPU пути.
+		std::unique_ptr<StorageBuffer>			m_pControl;
+		std::unique_ptr<StorageBuffer>			m_pStep;
+		std::unique_ptr<StorageBuffer>			m_pReadback;
+		std::unique_ptr<ShaderProgram>			m_pSimulateProgram;
+		std::unique_ptr<ShaderProgram>			m_pEmitProgram;
+		std::unique_ptr<ShaderProgram>			m_pFinalizeProgram;
+		std::unique_ptr<ShaderProgram>			m_pRenderProgram;
+		std::unique_ptr<VertexArray>			m_pVertexArray;		///< На GPU пути - без атрибутов.
+		std::unique_ptr<VertexBuffer>			m_pInstanceBuffer;	///< Только на CPU пути.
+		std::unique_ptr<ParticleSimulatorCpu>	m_pCpuSimulator;
+		int										m_viewProjectionLocation	= -1;
+		int										m_clipScaleLocation			= -1;
+		int										m_colorLocation				= -1;
+
+		void*									m_readbackFences[ReadbackSlots]	= {};	///< GLsync, по одному на слот `m_pReadback`.
+		uint32_t								m_readbackIndex	= 0;
+		uint32_t								m_current		= 0;	///< Буфер с живыми частицами.
+		ParticleSystemStats						m_stats;
+	};
+
+} // namespace Engine
@@ -0,0 +1,75 @@
+#include "EngineCore/Render/RenderStats.hpp"
+
+#include <cfloat>
+
+#include <imgui/imgui.h>
+
+namespace Engine {
+
+	/// Кол-во кадров в истории графика.
+	static constexpr int HistorySize = 120;
+
+	static RenderFrameStats	s_currentFrame;
+	static RenderFrameStats	s_lastFrame;
+	static float			s_drawCallHistory[HistorySize]		= {};
+	static float			s_textureBindHistory[HistorySize]	= {};
+	static int				s_historyOffset						= 0;
+
+	void RenderStats::newFrame() noexcept {
+		s_lastFrame = s_currentFrame;
+
+		s_drawCallHistory[s_historyOffset] = static_cast<float>(s_lastFrame.drawCalls);
+		s_textureBindHistory[s_historyOffset] = static_cast<float>(s_lastFrame.textureBinds);
+		s_historyOffset = (s_historyOffset + 1) % HistorySize;
+
+		s_currentFrame = RenderFrameStats{};
+		s_currentFrame.frameIndex = s_lastFrame.frameIndex + 1;
+	}
+
+	void RenderStats::addDrawCall(uint64_t vertices, uint32_t instances) noexcept {
+		++s_currentFrame.drawCalls;
+		s_currentFrame.vertices += vertices * instances;
+	}
+
+	void RenderStats::addTextureBind(uint32_t count) noexcept {
+		s_currentFrame.textureBinds += count;
+	}
+
+	void RenderStats::addProgramBind() noexcept {
+		++s_currentFrame.programBinds;
+	}
+
+	void RenderStats::addVertexArrayBind() noexcept {
+		++s_currentFrame.vertexArrayBinds;
+	}
+
+	const RenderFrameStats& RenderStats::getLastFrameStats() noexcept {
+		return s_lastFrame;
+	}
+
+	void RenderStats::drawImGuiOverlay() {
+		const ImGuiWindowFlags flags =
+			ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+			ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav;
+
+		// Оверлей прижат к правому верхнему углу окна.
+		const ImGuiIO& io = ImGui::GetIO();
+		ImGui::SetNextWindowPos(ImVec2(io.DisplaySize.x - 10.f, 10.f), ImGuiCond_Always, ImVec2(1.f, 0.f));
+		ImGui::SetNextWindowBgAlpha(0.35f);
+
+		if (ImGui::Begin("Статистика рендера", nullptr, flags)) {
+			const RenderFrameStats& stats = s_lastFrame;
+			ImGui::Text("Вызовов отрисовки: %u", stats.drawCalls);
+			ImGui::Text("Привязок текстур: %u", stats.textureBinds);
+			ImGui::Text("Привязок программ: %u, VAO: %u", stats.programBinds, stats.vertexArrayBinds);
+			ImGui::Text("Вершин: %llu", static_cast<unsigned long long>(stats.vertices));
+
+			ImGui::PlotLines("##drawCalls", s_drawCallHistory, HistorySize, s_historyOffset,
+				"draw calls", 0.f, FLT_MAX, ImVec2(200.f, 40.f));
+			ImGui::PlotLines("##textureBinds", s_textureBindHistory, HistorySize, s_historyOffset,
+				"texture binds", 0.f, FLT_MAX, ImVec2(200.f, 40.f));
+		}
+		ImGui::End();
+	}
+
+} // namespace Engine
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Счётчики команд рендера за один кадр.
+	 */
+	struct RenderFrameStats {
+		uint64_t	frameIndex		= 0;	///< Номер кадра.
+		uint32_t	drawCalls		= 0;	///< Кол-во вызовов glDraw*.
+		uint32_t	textureBinds	= 0;	///< Кол-во привязок текстур.
+		uint32_t	programBinds	= 0;	///< Кол-во привязок шейдерных программ.
+		uint32_t	vertexArrayBinds= 0;	///< Кол-во привязок VAO.
+		uint64_t	vertices		= 0;	///< Кол-во отправленных вершин (с учётом инстансов).
+	};
+
+	/**
+	 * @internal
+	 * @brief Статистика команд рендера по кадрам.
+	 *
+	 * Обёртки над объектами OpenGL (`Texture2D`, `Texture2DArray`, `ShaderProgram`,
+	 * `VertexArray`) сообщают о привязках, а код, вызывающий glDraw*, - о вызовах
+	 * отрисовки. Счётчики позволяют увидеть эффект батчинга: объединение текстур
+	 * в массивы и атласы (`TextureAtlas`) уменьшает кол-во привязок и вызовов.
+	 *
+	 * Команды самого ImGui не учитываются.
+	 *
+	 * @note Методы вызываются только из потока с контекстом OpenGL.
+	 */
+	class RenderStats {
+	public:
+		/// @internal
+		/// @brief Завершает статистику прошлого кадра и начинает новый кадр.
+		///
+		/// Вызывается в начале `Window::update()`.
+		static void newFrame() noexcept;
+
+		static void addDrawCall(uint64_t vertices, uint32_t instances = 1) noexcept;
+		static void addTextureBind(uint32_t count = 1) noexcept;
+		static void addProgramBind() noexcept;
+		static void addVertexArrayBind() noexcept;
+
+		/// @internal
+		/// @brief Возвращает статистику последнего завершённого кадра.
+		static const RenderFrameStats& getLastFrameStats() noexcept;
+
+		/// @internal
+		/// @brief Рисует полупрозрачный оверлей со счётчиками и графиком за последние кадры.
+		///
+		/// Должен вызываться между `ImGui::NewFrame()` и `ImGui::Render()`.
+		static void drawImGuiOverlay();
+	};
+
+} // namespace Engine
@@ -0,0 +1,287 @@
+#include "EngineCore/Render/ShaderLibrary.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#include <imgui/imgui.h>
+
+#include "EngineCore/Core/Hash.hpp"
+#include "EngineCore/Log.hpp"
+#include "EngineCore/Render/OpenGL/ShaderProgram.hpp"
+
+namespace Engine {
+
+	static std::string joinNames(const std::vector<std::string>& names) {
+		std::string text;
+		for (const std::string& name : names) {
+			if (!text.empty()) {
+				text += ' ';
+			}
+			text += name;
+		}
+		return text;
+	}
+
+	ShaderDefines::ShaderDefines(std::initializer_list<std::string_view> names) {
+		for (const std::string_view name : names) {
+			add(name);
+		}
+	}
+
+	ShaderDefines& ShaderDefines::add(std::string_view name) {
+		const auto it = std::lower_bound(m_names.begin(), m_names.end(), name);
+		if (it == m_names.end() || *it != name) {
+			m_names.emplace(it, name);
+			updateKey();
+		}
+		return *this;
+	}
+
+	void ShaderDefines::updateKey() noexcept {
+		uint64_t key = 0;
+		for (const std::string& name : m_names) {
+			// Длина входит в хеш, чтобы {"AB"} и {"A", "B"} не совпадали.
+			key = hash64(name, hash64(&key, sizeof(key), name.size()));
+		}
+		m_key = key;
+	}
+
+	ShaderLibrary::ShaderLibrary(std::string manifestPath)
+		: m_manifestPath(std::move(manifestPath))
+	{
+		loadManifest();
+	}
+
+	ShaderLibrary::~ShaderLibrary() = default;
+
+	void ShaderLibrary::loadManifest() {
+		std::ifstream file(m_manifestPath);
+		if (!file) {
+			return;
+		}
+
+		// Формат строки: "<имя шейдера>\t<слово> <слово> ...".
+		std::string line;
+		uint32_t count = 0;
+		while (std::getline(file, line)) {
+			const size_t separator = line.find('\t');
+			if (separator == std::string::npos) {
+				continue;
+			}
+
+			ShaderDefines defines;
+			size_t start = separator + 1;
+			while (start < line.size()) {
+				size_t end = line.find(' ', start);
+				if (end == std::string::npos) {
+					end = line.size();
+				}
+				if (end > start) {
+					defines.add(std::string_view(line).substr(start, end - start));
+				}
+				start = end + 1;
+			}
+			m_manifest[line.substr(0, separator)].push_back(std::move(defines));
+			++count;
+		}
+		LOG_INFO("Shader variant manifest {0}: {1} variants", m_manifestPath, count);
+	}
+
+	bool ShaderLibrary::saveManifest() const {
+		std::error_code error;
+		const std::filesystem::path directory = std::filesystem::path(m_manifestPath).parent_path();
+		if (!directory.empty()) {
+			std::filesystem::create_directories(directory, error);
+		}
+
+		std::ofstream file(m_manifestPath, std::ios::trunc);
+		if (!file) {
+			LOG_ERR("Can not write shader variant manifest {0}", m_manifestPath);
+			return false;
+		}
+		for (const Shader& shader : m_shaders) {
+			for (const Variant& variant : shader.variants) {
+				if (variant.bUsed && variant.pProgram) {
+					file << shader.name << '\t' << joinNames(variant.defines.getNames()) << '\n';
+				}
+			}
+		}
+		return true;
+	}
+
+	ShaderLibrary::ShaderId ShaderLibrary::add(const std::string& name, const std::string& vertexPath, const std::string& fragmentPath) {
+		const auto it = m_byName.find(name);
+		if (it != m_byName.end()) {
+			return it->second;
+		}
+
+		const ShaderId id = static_cast<ShaderId>(m_shaders.size());
+		Shader& shader = m_shaders.emplace_back();
+		shader.name = name;
+		shader.paths[0] = vertexPath;
+		shader.paths[1] = fragmentPath;
+		m_byName.emplace(name, id);
+
+		const auto manifestIt = m_manifest.find(name);
+		if (manifestIt != m_manifest.end()) {
+			for (ShaderDefines& defines : manifestIt->second) {
+				m_prewarmQueue.push_back({ id, std::move(defines) });
+			}
+			m_manifest.erase(manifestIt);
+		}
+		return id;
+	}
+
+	ShaderLibrary::ShaderId ShaderLibrary::find(const std::string& name) const noexcept {
+		const auto it = m_byName.find(name);
+		return it != m_byName.end() ? it->second : InvalidShader;
+	}
+
+	bool ShaderLibrary::loadSources(Shader& shader) {
+		for (size_t stage = 0; stage < 2; ++stage) {
+			if (!m_preprocessor.process(shader.paths[stage], shader.sources[stage])) {
+				LOG_ERR("Failed to load shader '{0}'", shader.name);
+				shader.bFailed = true;
+				++m_failed;
+				return false;
+			}
+			for (const std::string& keyword : shader.sources[stage].keywords) {
+				if (std::find(shader.keywords.begin(), shader.keywords.end(), keyword) == shader.keywords.end()) {
+					shader.keywords.push_back(keyword);
+				}
+			}
+		}
+		shader.bLoaded = true;
+		return true;
+	}
+
+	uint32_t ShaderLibrary::findVariant(Shader& shader, const ShaderDefines& defines) {
+		const auto lookupIt = shader.lookup.find(defines.getKey());
+		if (lookupIt != shader.lookup.end()) {
+			return lookupIt->second;
+		}
+		if (shader.bFailed || (!shader.bLoaded && !loadSources(shader))) {
+			return UINT32_MAX;
+		}
+
+		// Необъявленные слова не влияют на код, поэтому не порождают отдельный вариант.
+		ShaderDefines filtered;
+		if (shader.keywords.empty()) {
+			filtered = defines;
+		}
+		else {
+			for (const std::string& name : defines.getNames()) {
+				if (std::find(shader.keywords.begin(), shader.keywords.end(), name) != shader.keywords.end()) {
+					filtered.add(name);
+				}
+				else {
+					LOG_WARN("Shader '{0}' does not declare keyword {1}", shader.name, name);
+				}
+			}
+		}
+
+		uint32_t index = 0;
+		while (index < shader.variants.size() && shader.variants[index].defines.getKey() != filtered.getKey()) {
+			++index;
+		}
+
+		if (index == shader.variants.size()) {
+			Variant& variant = shader.variants.emplace_back();
+			variant.defines = std::move(filtered);
+
+			const auto startTime = std::chrono::steady_clock::now();
+			const std::string vertexSource = shader.sources[0].compose(variant.defines.getNames());
+			const std::string fragmentSource = shader.sources[1].compose(variant.defines.getNames());
+			auto pProgram = std::make_unique<ShaderProgram>(vertexSource.c_str(), fragmentSource.c_str());
+			variant.compileMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+			m_compileMs += variant.compileMs;
+
+			const std::string label = shader.name + " [" + joinNames(variant.defines.getNames()) + "]";
+			if (pProgram->isCompiled()) {
+				pProgram->setLabel(label);
+				variant.pProgram = std::move(pProgram);
+				++m_compiled;
+			}
+			else {
+				// Номера источников в логе компиляции - индексы в списках файлов стадий.
+				LOG_ERR("Failed to compile shader variant {0}; vertex sources: {1}; fragment sources: {2}",
+					label, joinNames(shader.sources[0].files), joinNames(shader.sources[1].files));
+				++m_failed;
+			}
+		}
+
+		shader.lookup.emplace(defines.getKey(), index);
+		return index;
+	}
+
+	ShaderProgram* ShaderLibrary::get(ShaderId id, const ShaderDefines& defines) {
+		if (id >= m_shaders.size()) {
+			return nullptr;
+		}
+
+		Shader& shader = m_shaders[id];
+		const uint32_t index = findVariant(shader, defines);
+		if (index == UINT32_MAX) {
+			return nullptr;
+		}
+
+		Variant& variant = shader.variants[index];
+		variant.bUsed = true;
+		return variant.pProgram.get();
+	}
+
+	uint32_t ShaderLibrary::prewarm(uint32_t maxCount) {
+		size_t processed = 0;
+		for (; processed < m_prewarmQueue.size() && processed < maxCount; ++processed) {
+			const PrewarmEntry& entry = m_prewarmQueue[processed];
+			Shader& shader = m_shaders[entry.shader];
+			const size_t variantCount = shader.variants.size();
+			findVariant(shader, entry.defines);
+			if (shader.variants.size() != variantCount) {
+				++m_prewarmed;
+			}
+		}
+		m_prewarmQueue.erase(m_prewarmQueue.begin(), m_prewarmQueue.begin() + processed);
+		return static_cast<uint32_t>(m_prewarmQueue.size());
+	}
+
+	void ShaderLibrary::drawImGuiPanel() {
+		ImGui::Begin("Шейдеры");
+
+		ImGui::Text("Скомпилировано вариантов: %u (заранее: %u), ошибок: %u", m_compiled, m_prewarmed, m_failed);
+		ImGui::Text("Время компиляции: %.1f мс, в очереди прогрева: %zu", m_compileMs, m_prewarmQueue.size());
+
+		if (ImGui::BeginTable("shaders", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY, ImVec2(0.f, 300.f))) {
+			ImGui::TableSetupColumn("Шейдер");
+			ImGui::TableSetupColumn("Ключевые слова");
+			ImGui::TableSetupColumn("Компиляция, мс");
+			ImGui::TableSetupColumn("Использован");
+			ImGui::TableHeadersRow();
+
+			for (const Shader& shader : m_shaders) {
+				for (const Variant& variant : shader.variants) {
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(shader.name.c_str());
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(joinNames(variant.defines.getNames()).c_str());
+					ImGui::TableNextColumn();
+					if (variant.pProgram) {
+						ImGui::Text("%.2f", variant.compileMs);
+					}
+					else {
+						ImGui::TextUnformatted("ошибка");
+					}
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(variant.bUsed ? "да" : "нет");
+				}
+			}
+			ImGui::EndTable();
+		}
+
+		ImGui::End();
+	}
+
+} // namespace Engine
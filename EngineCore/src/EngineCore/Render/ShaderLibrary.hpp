@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "EngineCore/Render/ShaderPreprocessor.hpp"
+
+namespace Engine {
+
+	class ShaderProgram;
+
+	/**
+	 * @internal
+	 * @brief Набор ключевых слов (`#define`) варианта шейдера.
+	 *
+	 * Имена хранятся отсортированными, поэтому порядок добавления не влияет на ключ.
+	 * Ключ вычисляется при изменении набора, а не при каждом поиске варианта, так что
+	 * набор стоит собрать один раз и переиспользовать.
+	 */
+	class ShaderDefines {
+	public:
+		ShaderDefines() = default;
+		ShaderDefines(std::initializer_list<std::string_view> names);
+
+		/// @internal
+		/// @brief Добавляет ключевое слово.
+		ShaderDefines& add(std::string_view name);
+
+		/// @internal
+		/// @brief Ключ варианта (XXH64 отсортированных имён), 0 - пустой набор.
+		uint64_t getKey() const noexcept { return m_key; }
+
+		const std::vector<std::string>& getNames() const noexcept { return m_names; }
+		bool isEmpty() const noexcept { return m_names.empty(); }
+
+	private:
+		void updateKey() noexcept;
+
+		std::vector<std::string>	m_names;
+		uint64_t					m_key	= 0;
+	};
+
+	/**
+	 * @internal
+	 * @brief Библиотека шейдеров с вариантами по ключевым словам.
+	 *
+	 * - Шейдер регистрируется парой файлов. Исходники читаются и проходят
+	 *   `ShaderPreprocessor` один раз, при первом запросе любого варианта.
+	 * - Вариант - программа, скомпилированная с набором `#define`. Он компилируется
+	 *   при первом запросе; слова, не объявленные в `#pragma keywords` шейдера,
+	 *   отбрасываются, чтобы не плодить одинаковые программы.
+	 * - Запрошенные варианты записываются в манифест (`saveManifest()`). При
+	 *   следующем запуске они компилируются заранее порциями (`prewarm()`), а не
+	 *   при первой отрисовке.
+	 *
+	 * Пример использования
+	 * @code
+	 * // lit.frag: #pragma keywords NORMAL_MAP ALPHA_TEST
+	 * const ShaderLibrary::ShaderId lit = shaders.add("lit", "shaders/lit.vert", "shaders/lit.frag");
+	 * const ShaderDefines defines{ "NORMAL_MAP" };
+	 * // ... каждый кадр:
+	 * if (ShaderProgram* pProgram = shaders.get(lit, defines)) { pProgram->bind(); }
+	 * @endcode
+	 *
+	 * @note Методы вызываются только из потока с контекстом OpenGL.
+	 */
+	class ShaderLibrary {
+	public:
+		using ShaderId = uint32_t;
+		static constexpr ShaderId InvalidShader = UINT32_MAX;
+
+		/// @internal
+		/// @param manifestPath Файл со списком использованных вариантов (читается сразу).
+		explicit ShaderLibrary(std::string manifestPath = "cache/shaders/variants.txt");
+		~ShaderLibrary();
+
+		ShaderLibrary(const ShaderLibrary&)				= delete;
+		ShaderLibrary& operator=(const ShaderLibrary&)	= delete;
+		ShaderLibrary(ShaderLibrary&&)					= delete;
+		ShaderLibrary& operator=(ShaderLibrary&&)		= delete;
+
+		/// @internal
+		/// @brief Препроцессор (встроенные файлы и каталоги поиска `#include`).
+		ShaderPreprocessor& getPreprocessor() noexcept { return m_preprocessor; }
+
+		/// @internal
+		/// @brief Регистрирует шейдер. Варианты из манифеста ставятся в очередь `prewarm()`.
+		/// @param name Уникальное имя шейдера.
+		/// @return Идентификатор шейдера (повторная регистрация имени возвращает прежний).
+		ShaderId add(const std::string& name, const std::string& vertexPath, const std::string& fragmentPath);
+
+		/// @internal
+		/// @brief Ищет шейдер по имени.
+		ShaderId find(const std::string& name) const noexcept;
+
+		/// @internal
+		/// @brief Возвращает вариант шейдера, компилируя его при первом запросе.
+		/// @return Программа или nullptr, если шейдер не найден или вариант не скомпилировался.
+		ShaderProgram* get(ShaderId id, const ShaderDefines& defines = {});
+		ShaderProgram* get(const std::string& name, const ShaderDefines& defines = {}) { return get(find(name), defines); }
+
+		/// @internal
+		/// @brief Компилирует варианты из манифеста, ещё не скомпилированные.
+		/// @param maxCount Максимальное кол-во программ за вызов.
+		/// @return Кол-во оставшихся в очереди вариантов.
+		uint32_t prewarm(uint32_t maxCount = UINT32_MAX);
+
+		/// @internal
+		/// @brief Сохраняет манифест: варианты, запрошенные через `get()` за время работы.
+		bool saveManifest() const;
+
+		/// @internal
+		/// @brief Отрисовывает ImGui окно с шейдерами и их вариантами.
+		void drawImGuiPanel();
+
+	private:
+		struct Variant {
+			ShaderDefines					defines;
+			std::unique_ptr<ShaderProgram>	pProgram;		///< nullptr, если компиляция не удалась.
+			float							compileMs	= 0.f;
+			bool							bUsed		= false;	///< Запрошен через `get()`.
+		};
+
+		struct Shader {
+			std::string								name;
+			std::string								paths[2];
+			ShaderSource							sources[2];
+			std::vector<std::string>				keywords;	///< Объявленные ключевые слова обеих стадий.
+			bool									bLoaded		= false;
+			bool									bFailed		= false;
+			std::vector<Variant>					variants;
+			std::unordered_map<uint64_t, uint32_t>	lookup;		///< Ключ запрошенного набора -> индекс варианта.
+		};
+
+		struct PrewarmEntry {
+			ShaderId		shader;
+			ShaderDefines	defines;
+		};
+
+		bool		loadSources(Shader& shader);
+		uint32_t	findVariant(Shader& shader, const ShaderDefines& defines);
+		void		loadManifest();
+
+		ShaderPreprocessor							m_preprocessor;
+		std::string									m_manifestPath;
+		std::vector<Shader>							m_shaders;
+		std::unordered_map<std::string, ShaderId>	m_byName;
+		std::unordered_map<std::string, std::vector<ShaderDefines>>	m_manifest;
+		std::vector<PrewarmEntry>					m_prewarmQueue;
+
+		// Статистика.
+		uint32_t									m_compiled		= 0;
+		uint32_t									m_prewarmed		= 0;
+		uint32_t									m_failed		= 0;
+		float										m_compileMs		= 0.f;
+	};
+
+} // namespace Engine
@@ -0,0 +1,233 @@
+#include "EngineCore/Render/ShaderPreprocessor.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+#include <unordered_set>
+
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	struct ShaderPreprocessor::Context {
+		ShaderSource&								source;
+		std::vector<std::string>					stack;		///< Цепочка включений (для поиска циклов).
+		std::unordered_set<std::string>				once;		///< Файлы с `#pragma once`, уже включённые.
+		std::unordered_map<std::string, uint32_t>	indices;	///< Номер источника по пути.
+	};
+
+	static bool isSpace(char c) noexcept {
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	static std::string_view trim(std::string_view text) noexcept {
+		while (!text.empty() && isSpace(text.front())) {
+			text.remove_prefix(1);
+		}
+		while (!text.empty() && isSpace(text.back())) {
+			text.remove_suffix(1);
+		}
+		return text;
+	}
+
+	/// @internal
+	/// @brief Отделяет первое слово строки.
+	static std::string_view nextToken(std::string_view& text) noexcept {
+		text = trim(text);
+		size_t end = 0;
+		while (end < text.size() && !isSpace(text[end])) {
+			++end;
+		}
+		const std::string_view token = text.substr(0, end);
+		text.remove_prefix(end);
+		return token;
+	}
+
+	static std::string normalizePath(const std::filesystem::path& path) {
+		return path.lexically_normal().generic_string();
+	}
+
+	std::string ShaderSource::compose(const std::vector<std::string>& defines) const {
+		std::string text;
+		text.reserve(version.size() + body.size() + defines.size() * 32 + 1);
+		if (!version.empty()) {
+			text += version;
+			text += '\n';
+		}
+		for (const std::string& define : defines) {
+			text += "#define ";
+			text += define;
+			text += " 1\n";
+		}
+		text += body;
+		return text;
+	}
+
+	void ShaderPreprocessor::addVirtualFile(const std::string& path, std::string source) {
+		m_virtualFiles[normalizePath(path)] = std::move(source);
+	}
+
+	void ShaderPreprocessor::addIncludeDirectory(const std::string& directory) {
+		m_includeDirectories.push_back(directory);
+	}
+
+	bool ShaderPreprocessor::read(const std::string& path, std::string& text) const {
+		const auto it = m_virtualFiles.find(path);
+		if (it != m_virtualFiles.end()) {
+			text = it->second;
+			return true;
+		}
+
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			return false;
+		}
+		std::ostringstream stream;
+		stream << file.rdbuf();
+		text = stream.str();
+		return true;
+	}
+
+	bool ShaderPreprocessor::resolve(const std::string& includer, const std::string& name, std::string& path) const {
+		std::error_code error;
+
+		const std::string relative = normalizePath(std::filesystem::path(includer).parent_path() / name);
+		if (m_virtualFiles.count(relative) || std::filesystem::is_regular_file(relative, error)) {
+			path = relative;
+			return true;
+		}
+
+		const std::string normalized = normalizePath(name);
+		if (m_virtualFiles.count(normalized)) {
+			path = normalized;
+			return true;
+		}
+
+		for (const std::string& directory : m_includeDirectories) {
+			std::string candidate = normalizePath(std::filesystem::path(directory) / name);
+			if (std::filesystem::is_regular_file(candidate, error)) {
+				path = std::move(candidate);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool ShaderPreprocessor::process(const std::string& path, ShaderSource& source) const {
+		source = ShaderSource{};
+
+		const std::string normalized = normalizePath(path);
+		std::string text;
+		if (!read(normalized, text)) {
+			LOG_ERR("Can not open shader file {0}", path);
+			return false;
+		}
+
+		Context context{ source, {}, {}, {} };
+		return processFile(context, normalized, text);
+	}
+
+	bool ShaderPreprocessor::processFile(Context& context, const std::string& path, const std::string& text) const {
+		if (std::find(context.stack.begin(), context.stack.end(), path) != context.stack.end()) {
+			LOG_ERR("Recursive shader include of {0} from {1}", path, context.stack.back());
+			return false;
+		}
+
+		const auto [indexIt, bInserted] = context.indices.emplace(path, static_cast<uint32_t>(context.source.files.size()));
+		if (bInserted) {
+			context.source.files.push_back(path);
+		}
+		const std::string fileIndex = std::to_string(indexIt->second);
+
+		std::string& body = context.source.body;
+		body += "#line 1 " + fileIndex + "\n";
+		context.stack.push_back(path);
+
+		// Обработанные директивы заменяются пустыми строками, чтобы не сбивать нумерацию.
+		uint32_t lineNumber = 0;
+		size_t lineStart = 0;
+		while (lineStart < text.size()) {
+			size_t lineEnd = text.find('\n', lineStart);
+			if (lineEnd == std::string::npos) {
+				lineEnd = text.size();
+			}
+			const std::string_view line(text.data() + lineStart, lineEnd - lineStart);
+			lineStart = lineEnd + 1;
+			++lineNumber;
+
+			std::string_view directive = trim(line);
+			if (directive.empty() || directive.front() != '#') {
+				body.append(line.data(), line.size());
+				body += '\n';
+				continue;
+			}
+			directive.remove_prefix(1);
+			const std::string_view name = nextToken(directive);
+
+			if (name == "version") {
+				if (context.stack.size() == 1 && context.source.version.empty()) {
+					context.source.version = std::string(trim(line));
+				}
+				else {
+					LOG_WARN("Ignoring #version in {0}:{1}", path, lineNumber);
+				}
+				body += '\n';
+				continue;
+			}
+
+			if (name == "pragma") {
+				std::string_view arguments = directive;
+				const std::string_view pragma = nextToken(arguments);
+				if (pragma == "once") {
+					context.once.insert(path);
+					body += '\n';
+					continue;
+				}
+				if (pragma == "keywords") {
+					std::vector<std::string>& keywords = context.source.keywords;
+					for (std::string_view keyword = nextToken(arguments); !keyword.empty(); keyword = nextToken(arguments)) {
+						if (std::find(keywords.begin(), keywords.end(), keyword) == keywords.end()) {
+							keywords.emplace_back(keyword);
+						}
+					}
+					body += '\n';
+					continue;
+				}
+			}
+
+			if (name != "include") {
+				body.append(line.data(), line.size());
+				body += '\n';
+				continue;
+			}
+
+			directive = trim(directive);
+			const char close = !directive.empty() && directive.front() == '<' ? '>' : '"';
+			const size_t nameEnd = directive.size() > 1 ? directive.find(close, 1) : std::string_view::npos;
+			if (directive.empty() || (directive.front() != '"' && directive.front() != '<') || nameEnd == std::string_view::npos) {
+				LOG_ERR("Malformed #include in {0}:{1}", path, lineNumber);
+				return false;
+			}
+			const std::string includeName(directive.substr(1, nameEnd - 1));
+
+			std::string includePath;
+			std::string includeText;
+			if (!resolve(path, includeName, includePath) || !read(includePath, includeText)) {
+				LOG_ERR("Can not find shader include '{0}' ({1}:{2})", includeName, path, lineNumber);
+				return false;
+			}
+			if (!context.once.count(includePath)) {
+				if (!processFile(context, includePath, includeText)) {
+					return false;
+				}
+			}
+			body += "#line " + std::to_string(lineNumber + 1) + " " + fileIndex + "\n";
+		}
+
+		context.stack.pop_back();
+		return true;
+	}
+
+} // namespace Engine
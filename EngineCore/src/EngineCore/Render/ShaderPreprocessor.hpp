@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Исходный код стадии шейдера после разрешения `#include`.
+	 *
+	 * Строка `#version` хранится отдельно, чтобы `compose()` мог вставить
+	 * `#define` варианта сразу после неё.
+	 */
+	struct ShaderSource {
+		std::string					version;	///< Строка `#version` (без перевода строки), может быть пустой.
+		std::string					body;		///< Код после `#version` с директивами `#line`.
+		std::vector<std::string>	files;		///< Файлы по номерам источников в `#line` (0 - основной файл).
+		std::vector<std::string>	keywords;	///< Ключевые слова из `#pragma keywords`.
+
+		/// @internal
+		/// @brief Собирает итоговый код стадии с заданными `#define` (каждый равен 1).
+		std::string compose(const std::vector<std::string>& defines) const;
+	};
+
+	/**
+	 * @internal
+	 * @brief Препроцессор исходников GLSL.
+	 *
+	 * Выполняет то, чего нет в самом GLSL:
+	 * - `#include "path"` и `#include <path>` - путь ищется среди встроенных файлов
+	 *   (`addVirtualFile()`), затем относительно включающего файла, затем в каталогах
+	 *   `addIncludeDirectory()`. Включения внутри `#if` разворачиваются всегда.
+	 * - `#pragma once` - файл включается один раз за вызов `process()`.
+	 * - `#pragma keywords A B ...` - объявляет ключевые слова вариантов шейдера.
+	 *
+	 * После каждого включения вставляется `#line N source`, поэтому номера строк
+	 * в логе компиляции указывают на исходный файл (`ShaderSource::files[source]`).
+	 *
+	 * @note Методы вызываются из одного потока.
+	 */
+	class ShaderPreprocessor {
+	public:
+		/// @internal
+		/// @brief Регистрирует встроенный файл, доступный для `#include` по имени `path`.
+		void addVirtualFile(const std::string& path, std::string source);
+
+		/// @internal
+		/// @brief Добавляет каталог поиска включаемых файлов.
+		void addIncludeDirectory(const std::string& directory);
+
+		/// @internal
+		/// @brief Читает файл и разрешает включения.
+		/// @param path Путь к файлу или имя встроенного файла.
+		/// @param [out] source Результат.
+		/// @return false, если файл или одно из включений не найдено, либо включения зациклены.
+		bool process(const std::string& path, ShaderSource& source) const;
+
+	private:
+		struct Context;
+
+		bool read(const std::string& path, std::string& text) const;
+		bool resolve(const std::string& includer, const std::string& name, std::string& path) const;
+		bool processFile(Context& context, const std::string& path, const std::string& text) const;
+
+		std::unordered_map<std::string, std::string>	m_virtualFiles;
+		std::vector<std::string>						m_includeDirectories;
+	};
+
+} // namespace Engine
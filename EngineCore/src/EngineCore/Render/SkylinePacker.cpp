@@ -0,0 +1,108 @@
+#include "EngineCore/Render/SkylinePacker.hpp"
+
+#include <algorithm>
+
+namespace Engine {
+
+	SkylinePacker::SkylinePacker(uint32_t width, uint32_t height) {
+		reset(width, height);
+	}
+
+	void SkylinePacker::reset(uint32_t width, uint32_t height) {
+		m_width = width;
+		m_height = height;
+		m_usedArea = 0;
+		m_nodes.clear();
+		m_nodes.push_back({ 0, 0, width });
+	}
+
+	bool SkylinePacker::fits(size_t index, uint32_t width, uint32_t height, uint32_t& y) const noexcept {
+		const uint32_t x = m_nodes[index].x;
+		if (x + width > m_width) {
+			return false;
+		}
+
+		// Прямоугольник лежит на самом высоком из отрезков, которые он перекрывает.
+		y = 0;
+		uint32_t widthLeft = width;
+		for (size_t i = index; widthLeft > 0; ++i) {
+			y = std::max(y, m_nodes[i].y);
+			if (y + height > m_height) {
+				return false;
+			}
+			widthLeft -= std::min(widthLeft, m_nodes[i].width);
+		}
+		return true;
+	}
+
+	bool SkylinePacker::pack(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y, uint32_t alignment) {
+		if (width == 0 || height == 0) {
+			return false;
+		}
+		alignment = std::max<uint32_t>(alignment, 1);
+		width = (width + alignment - 1) / alignment * alignment;
+		height = (height + alignment - 1) / alignment * alignment;
+
+		size_t bestIndex = m_nodes.size();
+		uint32_t bestTop = UINT32_MAX;
+		uint32_t bestWidth = UINT32_MAX;
+		uint32_t bestY = 0;
+
+		for (size_t i = 0; i < m_nodes.size(); ++i) {
+			uint32_t nodeY;
+			if (!fits(i, width, height, nodeY)) {
+				continue;
+			}
+			const uint32_t top = nodeY + height;
+			if (top < bestTop || (top == bestTop && m_nodes[i].width < bestWidth)) {
+				bestIndex = i;
+				bestTop = top;
+				bestWidth = m_nodes[i].width;
+				bestY = nodeY;
+			}
+		}
+
+		if (bestIndex == m_nodes.size()) {
+			return false;
+		}
+
+		x = m_nodes[bestIndex].x;
+		y = bestY;
+
+		// Новый отрезок закрывает перекрытые отрезки целиком или частично.
+		m_nodes.insert(m_nodes.begin() + bestIndex, Node{ x, bestTop, width });
+		const uint32_t right = x + width;
+		size_t i = bestIndex + 1;
+		while (i < m_nodes.size() && m_nodes[i].x < right) {
+			Node& node = m_nodes[i];
+			const uint32_t nodeRight = node.x + node.width;
+			if (nodeRight <= right) {
+				m_nodes.erase(m_nodes.begin() + i);
+				continue;
+			}
+			node.width = nodeRight - right;
+			node.x = right;
+			break;
+		}
+
+		// Соседние отрезки одной высоты сливаются, чтобы список оставался коротким.
+		for (size_t j = 0; j + 1 < m_nodes.size();) {
+			if (m_nodes[j].y == m_nodes[j + 1].y) {
+				m_nodes[j].width += m_nodes[j + 1].width;
+				m_nodes.erase(m_nodes.begin() + j + 1);
+			}
+			else {
+				++j;
+			}
+		}
+
+		m_usedArea += static_cast<uint64_t>(width) * height;
+		return true;
+	}
+
+	float SkylinePacker::getOccupancy() const noexcept {
+		const uint64_t area = static_cast<uint64_t>(m_width) * m_height;
+		return area > 0 ? static_cast<float>(static_cast<double>(m_usedArea) / area) : 0.f;
+	}
+
+} // namespace Engine
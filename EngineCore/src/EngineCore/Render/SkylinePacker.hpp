@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+
+	/**
+	 * @internal
+	 * @brief Упаковщик прямоугольников в область фиксированного размера (алгоритм skyline).
+	 *
+	 * Хранит верхнюю границу занятой области ("линию горизонта") как список
+	 * горизонтальных отрезков. Новый прямоугольник кладётся туда, где его верхний
+	 * край окажется ниже всего (bottom-left), при равенстве - на самый узкий отрезок.
+	 * Поиск линейный по кол-ву отрезков, которых обычно несколько десятков.
+	 *
+	 * Освобождение отдельных прямоугольников не поддерживается: область можно только
+	 * очистить целиком (`reset()`).
+	 */
+	class SkylinePacker {
+	public:
+		SkylinePacker() = default;
+
+		/// @internal
+		/// @param width Ширина области.
+		/// @param height Высота области.
+		SkylinePacker(uint32_t width, uint32_t height);
+
+		/// @internal
+		/// @brief Очищает область, задавая новый размер.
+		void reset(uint32_t width, uint32_t height);
+
+		/// @internal
+		/// @brief Ищет место под прямоугольник.
+		///
+		/// Размеры округляются вверх до кратных `alignment`, поэтому при одинаковом
+		/// `alignment` у всех вызовов позиции тоже выровнены.
+		///
+		/// @param width Ширина прямоугольника.
+		/// @param height Высота прямоугольника.
+		/// @param [out] x Левый край найденного места.
+		/// @param [out] y Нижний край найденного места.
+		/// @param alignment Выравнивание размеров (степень двойки не обязательна, 0 считается как 1).
+		/// @return false, если прямоугольник не помещается.
+		bool pack(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y, uint32_t alignment = 1);
+
+		uint32_t getWidth() const noexcept { return m_width; }
+		uint32_t getHeight() const noexcept { return m_height; }
+
+		/// @internal
+		/// @brief Доля площади, занятой упакованными прямоугольниками.
+		float getOccupancy() const noexcept;
+
+	private:
+		struct Node {
+			uint32_t x;
+			uint32_t y;
+			uint32_t width;
+		};
+
+		bool fits(size_t index, uint32_t width, uint32_t height, uint32_t& y) const noexcept;
+
+		std::vector<Node>	m_nodes;
+		uint32_t			m_width		= 0;
+		uint32_t			m_height	= 0;
+		uint64_t			m_usedArea	= 0;
+	};
+
+} // namespace Engine
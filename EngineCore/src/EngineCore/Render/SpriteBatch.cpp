@@ -0,0 +1,398 @@
+#include "EngineCore/Render/SpriteBatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+#include <glad/glad.h>
+#include <imgui/imgui.h>
+
+#include "EngineCore/Log.hpp"
+#include "EngineCore/Render/OpenGL/IndexBuffer.hpp"
+#include "EngineCore/Render/OpenGL/ShaderProgram.hpp"
+#include "EngineCore/Render/OpenGL/Texture2D.hpp"
+#include "EngineCore/Render/OpenGL/VertexArray.hpp"
+#include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
+#include "EngineCore/Render/OpenGL/VertexLayout.hpp"
+#include "EngineCore/Render/RenderStats.hpp"
+
+namespace Engine {
+
+	/// Вершина спрайта (20 байт).
+	struct SpriteVertex {
+		float		position[2];
+		uint16_t	uv[2];
+		uint32_t	color;
+		int32_t		texture;	///< Текстурный блок или -1 (только цвет).
+	};
+
+	template<>
+	struct VertexLayout<SpriteVertex> {
+		static constexpr VertexAttribute attributes[] = {
+			ENGINE_VERTEX_ATTRIBUTE(SpriteVertex, position,	ShaderDataType::Float2),
+			ENGINE_VERTEX_ATTRIBUTE(SpriteVertex, uv,		ShaderDataType::UNorm16x2),
+			ENGINE_VERTEX_ATTRIBUTE(SpriteVertex, color,	ShaderDataType::UNorm8x4),
+			ENGINE_VERTEX_ATTRIBUTE(SpriteVertex, texture,	ShaderDataType::Int)
+		};
+	};
+
+	static constexpr uint32_t MaxQuadsPerChunk		= 65536 / 4;
+	static constexpr uint32_t MaxTextureSlots		= 32;
+	static constexpr int		ViewProjectionLocation	= 0;
+
+	static const char* s_spriteVertexShader =
+	"#version 460\n"
+	"layout(location = 0) in vec2 vertex_position;\n"
+	"layout(location = 1) in vec2 vertex_uv;\n"
+	"layout(location = 2) in vec4 vertex_color;\n"
+	"layout(location = 3) in int vertex_texture;\n"
+	"layout(location = 0) uniform mat4 u_viewProjection;\n"
+	"out vec2 uv;\n"
+	"out vec4 color;\n"
+	"flat out int textureSlot;\n"
+	"void main() {\n"
+	"	uv = vertex_uv;\n"
+	"	color = vertex_color;\n"
+	"	textureSlot = vertex_texture;\n"
+	"	gl_Position = u_viewProjection * vec4(vertex_position, 0.0, 1.0);\n"
+	"}\n";
+
+	/// @internal
+	/// @brief Собирает фрагментный шейдер под `slotCount` текстурных блоков.
+	///
+	/// Индекс массива сэмплеров должен быть одинаковым для всех фрагментов вызова,
+	/// поэтому текстура выбирается через `switch` с константными индексами.
+	static std::string makeSpriteFragmentShader(const uint32_t slotCount) {
+		std::string source =
+			"#version 460\n"
+			"in vec2 uv;\n"
+			"in vec4 color;\n"
+			"flat in int textureSlot;\n"
+			"layout(binding = 0) uniform sampler2D u_textures[" + std::to_string(slotCount) + "];\n"
+			"out vec4 fragment_color;\n"
+			"void main() {\n"
+			"	vec4 texel = vec4(1.0);\n"
+			"	switch (textureSlot) {\n";
+		for (uint32_t slot = 0; slot < slotCount; ++slot) {
+			const std::string index = std::to_string(slot);
+			source += "	case " + index + ": texel = texture(u_textures[" + index + "], uv); break;\n";
+		}
+		source +=
+			"	default: break;\n"
+			"	}\n"
+			"	fragment_color = texel * color;\n"
+			"}\n";
+		return source;
+	}
+
+	SpriteBatch::SpriteBatch(const SpriteBatchParams& params)
+		: m_params(params)
+	{
+		m_params.quadsPerChunk = std::clamp<uint32_t>(m_params.quadsPerChunk, 1, MaxQuadsPerChunk);
+		if (m_params.chunkCount == 0) {
+			// Кадры идут в кольце подряд и начинаются с середины части, отсюда лишняя часть:
+			// переиспользуемая часть целиком старше кадров, которые ещё может читать GPU.
+			const uint64_t quadsInFlight = static_cast<uint64_t>(m_params.spritesPerFrame) * std::max<uint32_t>(m_params.framesInFlight, 1);
+			m_params.chunkCount = static_cast<uint32_t>((quadsInFlight + m_params.quadsPerChunk - 1) / m_params.quadsPerChunk) + 1;
+		}
+		m_params.chunkCount = std::max<uint32_t>(m_params.chunkCount, 1);
+
+		GLint textureUnits = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &textureUnits);
+		m_slotLimit = std::clamp<uint32_t>(static_cast<uint32_t>(textureUnits), 1, MaxTextureSlots);
+
+		// Шаблон индексов одинаков для всех частей: смещение части задаёт base vertex.
+		std::vector<uint16_t> indices(static_cast<size_t>(m_params.quadsPerChunk) * 6);
+		for (uint32_t quad = 0; quad < m_params.quadsPerChunk; ++quad) {
+			const uint16_t first = static_cast<uint16_t>(quad * 4);
+			uint16_t* pQuad = indices.data() + static_cast<size_t>(quad) * 6;
+			pQuad[0] = first;
+			pQuad[1] = first + 1;
+			pQuad[2] = first + 2;
+			pQuad[3] = first + 2;
+			pQuad[4] = first + 3;
+			pQuad[5] = first;
+		}
+		m_pIndices = std::make_unique<IndexBuffer>(indices.data(), indices.size());
+		m_pIndices->setLabel("Sprite batch indices");
+
+		const size_t vertexCount = static_cast<size_t>(m_params.quadsPerChunk) * m_params.chunkCount * 4;
+		m_pVertices = std::make_unique<VertexBuffer>(
+			static_cast<const SpriteVertex*>(nullptr), vertexCount, VertexBuffer::EUsage::Stream
+		);
+		m_pVertices->setLabel("Sprite batch vertices");
+		m_pMapped = static_cast<SpriteVertex*>(m_pVertices->getMappedData());
+		if (!m_pMapped) {
+			m_staging.resize(static_cast<size_t>(m_params.quadsPerChunk) * 4);
+		}
+		m_fences.resize(m_params.chunkCount, nullptr);
+
+		m_pVertexArray = std::make_unique<VertexArray>();
+		m_pVertexArray->setVertexBuffer(m_pVertexArray->addLayout<SpriteVertex>(), *m_pVertices);
+		m_pVertexArray->setIndexBuffer(*m_pIndices);
+		m_pVertexArray->setLabel("Sprite batch VAO");
+		VertexArray::unbind();
+
+		const std::string fragmentSource = makeSpriteFragmentShader(m_slotLimit);
+		m_pProgram = std::make_unique<ShaderProgram>(s_spriteVertexShader, fragmentSource.c_str());
+		m_pProgram->setLabel("Sprite batch program");
+
+		LOG_INFO(
+			"Sprite batch: {0} chunks of {1} sprites, {2} texture slots, {3}",
+			m_params.chunkCount, m_params.quadsPerChunk, m_slotLimit, m_pMapped ? "persistent mapping" : "buffer updates"
+		);
+	}
+
+	SpriteBatch::~SpriteBatch() {
+		for (void* fence : m_fences) {
+			if (fence) {
+				glDeleteSync(static_cast<GLsync>(fence));
+			}
+		}
+	}
+
+	void SpriteBatch::begin(const Mat4& viewProjection, const ESortMode sortMode) {
+		if (m_bActive) {
+			LOG_WARN("SpriteBatch::begin() called twice without end()");
+			end();
+		}
+
+		m_bActive = true;
+		m_sortMode = sortMode;
+		m_stats = {};
+		m_beginTime = std::chrono::steady_clock::now();
+		m_pProgram->setMatrix4(ViewProjectionLocation, viewProjection.data());
+	}
+
+	void SpriteBatch::draw(const Sprite& sprite, const Texture2D* pTexture) {
+		const unsigned int textureId = pTexture ? pTexture->getId() : 0;
+		if (m_sortMode == ESortMode::Layer) {
+			m_queue.push_back({ sprite, textureId });
+			return;
+		}
+		emit(sprite, textureId);
+	}
+
+	void SpriteBatch::emit(const Sprite& sprite, const unsigned int textureId) {
+		if (m_chunkQuad == m_params.quadsPerChunk) {
+			flush();
+			nextChunk();
+		}
+		const int32_t slot = acquireSlot(textureId);
+
+		const float halfWidth = sprite.width * 0.5f;
+		const float halfHeight = sprite.height * 0.5f;
+		// Оси спрайта: без поворота синус и косинус не вычисляются.
+		float axisX[2] = { halfWidth, 0.f };
+		float axisY[2] = { 0.f, halfHeight };
+		if (sprite.rotation != 0.f) {
+			const float s = std::sin(sprite.rotation);
+			const float c = std::cos(sprite.rotation);
+			axisX[0] = c * halfWidth;
+			axisX[1] = s * halfWidth;
+			axisY[0] = -s * halfHeight;
+			axisY[1] = c * halfHeight;
+		}
+
+		const auto toUNorm16 = [](const float value) {
+			return static_cast<uint16_t>(std::clamp(value, 0.f, 1.f) * 65535.f + 0.5f);
+		};
+		const uint16_t u0 = toUNorm16(sprite.u0), v0 = toUNorm16(sprite.v0);
+		const uint16_t u1 = toUNorm16(sprite.u1), v1 = toUNorm16(sprite.v1);
+
+		// Вершины собираются локально и копируются одним блоком: в отображённую
+		// память (write-combined) лучше писать последовательно, не читая её.
+		const SpriteVertex quad[4] = {
+			{ { sprite.x - axisX[0] - axisY[0], sprite.y - axisX[1] - axisY[1] }, { u0, v0 }, sprite.color, slot },
+			{ { sprite.x + axisX[0] - axisY[0], sprite.y + axisX[1] - axisY[1] }, { u1, v0 }, sprite.color, slot },
+			{ { sprite.x + axisX[0] + axisY[0], sprite.y + axisX[1] + axisY[1] }, { u1, v1 }, sprite.color, slot },
+			{ { sprite.x - axisX[0] + axisY[0], sprite.y - axisX[1] + axisY[1] }, { u0, v1 }, sprite.color, slot }
+		};
+
+		SpriteVertex* pChunk = m_pMapped
+			? m_pMapped + static_cast<size_t>(m_chunk) * m_params.quadsPerChunk * 4
+			: m_staging.data();
+		std::memcpy(pChunk + static_cast<size_t>(m_chunkQuad) * 4, quad, sizeof(quad));
+		++m_chunkQuad;
+		++m_stats.sprites;
+	}
+
+	int32_t SpriteBatch::acquireSlot(const unsigned int textureId) {
+		if (textureId == 0) {
+			return -1;
+		}
+		if (textureId == m_lastTexture) {
+			return m_lastSlot;
+		}
+
+		uint32_t slot = 0;
+		while (slot < m_slotCount && m_slotTextures[slot] != textureId) {
+			++slot;
+		}
+		if (slot == m_slotCount) {
+			if (m_slotCount == m_slotLimit) {
+				// Спрайты с уже привязанными текстурами рисуются, блоки освобождаются.
+				flush();
+				++m_stats.slotFlushes;
+				m_slotCount = 0;
+				slot = 0;
+			}
+			m_slotTextures[m_slotCount++] = textureId;
+		}
+
+		m_lastTexture = textureId;
+		m_lastSlot = static_cast<int32_t>(slot);
+		return m_lastSlot;
+	}
+
+	void SpriteBatch::flush() {
+		const uint32_t quadCount = m_chunkQuad - m_batchStart;
+		if (quadCount == 0) {
+			return;
+		}
+
+		const size_t firstVertex = (static_cast<size_t>(m_chunk) * m_params.quadsPerChunk + m_batchStart) * 4;
+		if (!m_pMapped) {
+			m_pVertices->setData(
+				m_staging.data() + static_cast<size_t>(m_batchStart) * 4,
+				static_cast<size_t>(quadCount) * 4 * sizeof(SpriteVertex),
+				firstVertex * sizeof(SpriteVertex)
+			);
+		}
+
+		if (!m_bStateSet) {
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			glDisable(GL_DEPTH_TEST);
+			m_bStateSet = true;
+		}
+
+		if (m_slotCount > 0) {
+			if (GLAD_GL_VERSION_4_4) {
+				glBindTextures(0, static_cast<GLsizei>(m_slotCount), m_slotTextures);
+			}
+			else {
+				for (uint32_t slot = 0; slot < m_slotCount; ++slot) {
+					glActiveTexture(GL_TEXTURE0 + slot);
+					glBindTexture(GL_TEXTURE_2D, m_slotTextures[slot]);
+				}
+			}
+			RenderStats::addTextureBind(m_slotCount);
+		}
+
+		m_pProgram->bind();
+		m_pVertexArray->bind();
+		glDrawElementsBaseVertex(
+			GL_TRIANGLES,
+			static_cast<GLsizei>(quadCount * 6),
+			m_pIndices->getGLType(),
+			nullptr,
+			static_cast<GLint>(firstVertex)
+		);
+		RenderStats::addDrawCall(static_cast<uint64_t>(quadCount) * 6);
+
+		++m_stats.drawCalls;
+		m_batchStart = m_chunkQuad;
+	}
+
+	void SpriteBatch::nextChunk() {
+		// Fence ставится после последней отрисовки из части.
+		m_fences[m_chunk] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_chunk = (m_chunk + 1) % m_params.chunkCount;
+		m_chunkQuad = 0;
+		m_batchStart = 0;
+
+		GLsync fence = static_cast<GLsync>(m_fences[m_chunk]);
+		if (!fence) {
+			return;
+		}
+		GLenum result = glClientWaitSync(fence, 0, 0);
+		if (result == GL_TIMEOUT_EXPIRED) {
+			// Кольцо обогнало GPU: ждать приходится до освобождения части.
+			++m_stats.chunkWaits;
+			do {
+				result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+			} while (result == GL_TIMEOUT_EXPIRED);
+		}
+		glDeleteSync(fence);
+		m_fences[m_chunk] = nullptr;
+	}
+
+	void SpriteBatch::sortByLayer() {
+		const uint32_t count = static_cast<uint32_t>(m_queue.size());
+		m_order.resize(count);
+		m_orderTemp.resize(count);
+
+		// Устойчивая поразрядная сортировка по 16-битному ключу в два прохода по байту.
+		// Инверсия знакового бита переводит int16 в беззнаковый порядок.
+		uint32_t histograms[2][256] = {};
+		for (const QueuedSprite& queued : m_queue) {
+			const uint16_t key = static_cast<uint16_t>(queued.sprite.layer) ^ 0x8000u;
+			++histograms[0][key & 0xFF];
+			++histograms[1][key >> 8];
+		}
+		for (auto& histogram : histograms) {
+			uint32_t sum = 0;
+			for (uint32_t& bucket : histogram) {
+				const uint32_t bucketCount = bucket;
+				bucket = sum;
+				sum += bucketCount;
+			}
+		}
+
+		for (uint32_t i = 0; i < count; ++i) {
+			const uint16_t key = static_cast<uint16_t>(m_queue[i].sprite.layer) ^ 0x8000u;
+			m_orderTemp[histograms[0][key & 0xFF]++] = i;
+		}
+		for (uint32_t i = 0; i < count; ++i) {
+			const uint32_t index = m_orderTemp[i];
+			const uint16_t key = static_cast<uint16_t>(m_queue[index].sprite.layer) ^ 0x8000u;
+			m_order[histograms[1][key >> 8]++] = index;
+		}
+	}
+
+	void SpriteBatch::end() {
+		if (!m_bActive) {
+			return;
+		}
+
+		if (m_sortMode == ESortMode::Layer && !m_queue.empty()) {
+			sortByLayer();
+			for (const uint32_t index : m_order) {
+				emit(m_queue[index].sprite, m_queue[index].textureId);
+			}
+			m_queue.clear();
+		}
+		flush();
+
+		if (m_bStateSet) {
+			glDisable(GL_BLEND);
+			m_bStateSet = false;
+		}
+		// Привязки текстур между кадрами могли измениться.
+		m_slotCount = 0;
+		m_lastTexture = 0;
+		m_lastSlot = -1;
+		m_bActive = false;
+
+		m_stats.cpuMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_beginTime).count();
+		m_lastStats = m_stats;
+	}
+
+	void SpriteBatch::drawImGuiPanel() {
+		ImGui::Begin("Спрайты");
+
+		ImGui::Text("Спрайтов: %u, вызовов отрисовки: %u", m_lastStats.sprites, m_lastStats.drawCalls);
+		ImGui::Text("Сбросов из-за текстур: %u (блоков: %u)", m_lastStats.slotFlushes, m_slotLimit);
+		ImGui::Text("Ожиданий GPU: %u", m_lastStats.chunkWaits);
+		ImGui::Text("Время CPU: %.2f мс", m_lastStats.cpuMs);
+		ImGui::Text(
+			"Буфер: %u x %u спрайтов, %s", m_params.chunkCount, m_params.quadsPerChunk,
+			m_pMapped ? "постоянное отображение" : "glBufferSubData"
+		);
+
+		ImGui::End();
+	}
+
+} // namespace Engine
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "EngineCore/Math.hpp"
+
+namespace Engine {
+
+	class IndexBuffer;
+	class ShaderProgram;
+	struct SpriteVertex;
+	class Texture2D;
+	class VertexArray;
+	class VertexBuffer;
+
+	/**
+	 * @internal
+	 * @brief Спрайт (прямоугольник с текстурой или цветом) для `SpriteBatch`.
+	 */
+	struct Sprite {
+		float		x			= 0.f;			///< Центр по X.
+		float		y			= 0.f;			///< Центр по Y.
+		float		width		= 1.f;
+		float		height		= 1.f;
+		float		rotation	= 0.f;			///< Поворот вокруг центра в радианах.
+		float		u0			= 0.f;			///< Прямоугольник UV в [0, 1] (хранится в UNorm16).
+		float		v0			= 0.f;
+		float		u1			= 1.f;
+		float		v1			= 1.f;
+		uint32_t	color		= 0xFFFFFFFF;	///< RGBA8, R в младшем байте; умножается на цвет текстуры.
+		int16_t		layer		= 0;			///< Слой для `ESortMode::Layer` (меньшие рисуются раньше).
+	};
+
+	/**
+	 * @internal
+	 * @brief Параметры `SpriteBatch`.
+	 */
+	struct SpriteBatchParams {
+		uint32_t	quadsPerChunk	= 16384;	///< Спрайтов в части буфера (не больше 16384 - индексы 16-битные).
+		uint32_t	spritesPerFrame	= 200000;	///< Спрайтов за кадр, на которые рассчитано кольцо.
+		uint32_t	framesInFlight	= 3;		///< Кадров, на которые GPU может отставать от CPU, включая текущий.
+		uint32_t	chunkCount		= 0;		///< Частей в кольце; 0 - по `spritesPerFrame` и `framesInFlight`.
+	};
+
+	/**
+	 * @internal
+	 * @brief Статистика `SpriteBatch` за кадр (между `begin()` и `end()`).
+	 */
+	struct SpriteBatchStats {
+		uint32_t	sprites			= 0;	///< Нарисовано спрайтов.
+		uint32_t	drawCalls		= 0;	///< Вызовов отрисовки.
+		uint32_t	slotFlushes		= 0;	///< Сбросов из-за нехватки текстурных блоков.
+		uint32_t	chunkWaits		= 0;	///< Ожиданий GPU перед записью в часть буфера.
+		float		cpuMs			= 0.f;	///< Время от `begin()` до `end()` (включая код, добавляющий спрайты).
+	};
+
+	/**
+	 * @internal
+	 * @brief Пакетная отрисовка 2D спрайтов и прямоугольников.
+	 *
+	 * Спрайты записываются по 4 вершины в кольцевой потоковый буфер
+	 * (`VertexBuffer::EUsage::Stream`, постоянно отображённый), индексы квадов
+	 * создаются один раз. Все спрайты рисуются одним вызовом, пока:
+	 * - не кончилась часть кольца (`SpriteBatchParams::quadsPerChunk`);
+	 * - не заняты все текстурные блоки: текстуры разных спрайтов привязываются
+	 *   к разным блокам (до `GL_MAX_TEXTURE_IMAGE_UNITS`, не больше 32), шейдер
+	 *   выбирает текстуру по номеру блока в вершине.
+	 *
+	 * Перед записью в часть кольца ожидается fence её прошлой отрисовки, поэтому
+	 * CPU не перезаписывает вершины, которые ещё читает GPU. По умолчанию кольцо
+	 * вмещает `framesInFlight` кадров по `spritesPerFrame` спрайтов (200k x 3 -
+	 * 38 частей, ~50 МБ), и при такой нагрузке ожиданий нет (`chunkWaits == 0`).
+	 *
+	 * Пример использования
+	 * @code
+	 * batch.begin(Mat4::ortho(0.f, width, height, 0.f, -1.f, 1.f), SpriteBatch::ESortMode::Layer);
+	 * Sprite icon;
+	 * icon.x = 100.f; icon.y = 50.f; icon.width = icon.height = 32.f;
+	 * icon.layer = 1;
+	 * batch.draw(icon, pIconTexture);
+	 * batch.draw(background);	// без текстуры - только цвет
+	 * batch.end();
+	 * @endcode
+	 *
+	 * @note Методы вызываются только из потока с контекстом OpenGL.
+	 */
+	class SpriteBatch {
+	public:
+		/**
+		 * @internal
+		 * @brief Порядок отрисовки спрайтов.
+		 */
+		enum class ESortMode : uint8_t {
+			Submission,	///< В порядке вызовов `draw()`; спрайты пишутся в буфер сразу.
+			Layer		///< По возрастанию `Sprite::layer`, внутри слоя - в порядке вызовов.
+		};
+
+		explicit SpriteBatch(const SpriteBatchParams& params = {});
+		~SpriteBatch();
+
+		SpriteBatch(const SpriteBatch&)				= delete;
+		SpriteBatch& operator=(const SpriteBatch&)	= delete;
+
+		/// @internal
+		/// @brief Начинает кадр спрайтов.
+		/// @param viewProjection Преобразование координат спрайтов в clip space.
+		/// @param sortMode Порядок отрисовки.
+		void begin(const Mat4& viewProjection, ESortMode sortMode = ESortMode::Submission);
+
+		/// @internal
+		/// @brief Добавляет спрайт.
+		/// @param sprite Спрайт.
+		/// @param pTexture Текстура (nullptr - спрайт закрашивается `Sprite::color`).
+		void draw(const Sprite& sprite, const Texture2D* pTexture = nullptr);
+
+		/// @internal
+		/// @brief Рисует оставшиеся спрайты и завершает кадр.
+		void end();
+
+		/// @internal
+		/// @brief Кол-во текстур, которые могут попасть в один вызов отрисовки.
+		uint32_t getTextureSlotCount() const noexcept { return m_slotLimit; }
+
+		/// @internal
+		/// @brief Возвращает статистику последнего завершённого кадра.
+		const SpriteBatchStats& getLastStats() const noexcept { return m_lastStats; }
+
+		/// @internal
+		/// @brief Рисует ImGui окно со статистикой.
+		void drawImGuiPanel();
+
+	private:
+		/// Спрайт, ожидающий сортировки.
+		struct QueuedSprite {
+			Sprite			sprite;
+			unsigned int	textureId;
+		};
+
+		void emit(const Sprite& sprite, unsigned int textureId);
+		int32_t acquireSlot(unsigned int textureId);
+		void flush();
+		void nextChunk();
+		void sortByLayer();
+
+		SpriteBatchParams				m_params;
+		std::unique_ptr<VertexBuffer>	m_pVertices;
+		std::unique_ptr<IndexBuffer>	m_pIndices;
+		std::unique_ptr<VertexArray>	m_pVertexArray;
+		std::unique_ptr<ShaderProgram>	m_pProgram;
+
+		SpriteVertex*					m_pMapped		= nullptr;	///< Отображённый буфер или nullptr.
+		std::vector<SpriteVertex>		m_staging;					///< Вершины текущей части без отображения.
+		std::vector<void*>				m_fences;					///< GLsync последней отрисовки каждой части.
+		uint32_t						m_chunk			= 0;		///< Текущая часть кольца.
+		uint32_t						m_chunkQuad		= 0;		///< Первый свободный спрайт части.
+		uint32_t						m_batchStart	= 0;		///< Первый ещё не нарисованный спрайт части.
+
+		unsigned int					m_slotTextures[32]	= {};
+		uint32_t						m_slotCount		= 0;
+		uint32_t						m_slotLimit		= 0;
+		unsigned int					m_lastTexture	= 0;		///< Текстура последнего спрайта (кэш поиска блока).
+		int32_t							m_lastSlot		= -1;
+
+		ESortMode						m_sortMode		= ESortMode::Submission;
+		std::vector<QueuedSprite>		m_queue;
+		std::vector<uint32_t>			m_order;
+		std::vector<uint32_t>			m_orderTemp;
+
+		bool							m_bActive		= false;
+		bool							m_bStateSet		= false;	///< Включено смешивание в этом кадре.
+		std::chrono::steady_clock::time_point	m_beginTime;
+		SpriteBatchStats				m_stats;
+		SpriteBatchStats				m_lastStats;
+	};
+
+} // namespace Engine
@@ -0,0 +1,268 @@
+#include "EngineCore/Render/TextureAtlas.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <glad/glad.h>
+
+#include <imgui/imgui.h>
+
+#include "EngineCore/Image/Image.hpp"
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	static uint32_t roundUp(uint32_t value, uint32_t alignment) noexcept {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	/// @internal
+	/// @brief Копирует уровень в буфер с отступом `padding`, заполненным краевыми пикселями.
+	static void buildPaddedLevel(
+		const ImageLevel&		level,
+		size_t					bytesPerPixel,
+		uint32_t				padding,
+		std::vector<uint8_t>&	output
+	) {
+		const uint32_t width = level.width + padding * 2;
+		const uint32_t height = level.height + padding * 2;
+		const size_t rowBytes = static_cast<size_t>(width) * bytesPerPixel;
+		const size_t sourceRowBytes = static_cast<size_t>(level.width) * bytesPerPixel;
+		output.resize(rowBytes * height);
+
+		const uint8_t* pSource = level.getData();
+		for (uint32_t y = 0; y < height; ++y) {
+			const uint32_t sourceY = std::min(y > padding ? y - padding : 0, level.height - 1);
+			const uint8_t* pSourceRow = pSource + sourceY * sourceRowBytes;
+			uint8_t* pRow = output.data() + y * rowBytes;
+
+			for (uint32_t x = 0; x < padding; ++x) {
+				std::memcpy(pRow + x * bytesPerPixel, pSourceRow, bytesPerPixel);
+				std::memcpy(pRow + (padding + level.width + x) * bytesPerPixel, pSourceRow + sourceRowBytes - bytesPerPixel, bytesPerPixel);
+			}
+			std::memcpy(pRow + padding * bytesPerPixel, pSourceRow, sourceRowBytes);
+		}
+	}
+
+	TextureAtlas::TextureAtlas(const TextureAtlasParams& params)
+		: m_params(params)
+	{
+		m_params.levels = std::clamp<uint32_t>(m_params.levels, 1, getMipLevelCount(m_params.layerSize, m_params.layerSize));
+		m_params.initialLayers = std::max<uint32_t>(m_params.initialLayers, 1);
+	}
+
+	TextureAtlas::~TextureAtlas() = default;
+
+	AtlasRegion TextureAtlas::add(const std::string& path) {
+		if (const AtlasRegion* pRegion = find(path)) {
+			return *pRegion;
+		}
+
+		Image image;
+		if (!loadImageFile(path, image)) {
+			return {};
+		}
+		return add(std::move(image), path);
+	}
+
+	AtlasRegion TextureAtlas::add(Image image, const std::string& name) {
+		if (const AtlasRegion* pRegion = find(name)) {
+			return *pRegion;
+		}
+
+		if (!image.isValid()) {
+			LOG_ERR("Can not add invalid image '{0}' to texture atlas", name);
+			return {};
+		}
+
+		const uint32_t layerSize = m_params.layerSize;
+		const uint32_t width = image.getWidth();
+		const uint32_t height = image.getHeight();
+		if (width > layerSize || height > layerSize) {
+			LOG_ERR("Image '{0}' ({1}x{2}) is larger than texture atlas layer ({3}x{3})", name, width, height, layerSize);
+			return {};
+		}
+
+		if (image.colorSpace == ColorSpace::Unknown) {
+			image.colorSpace = m_params.bSRGB && image.pixelType == PixelType::UNorm8 ? ColorSpace::SRGB : ColorSpace::Linear;
+		}
+		// RGB и RGBA изображения попадают на одну страницу.
+		expandToRGBA(image);
+
+		const bool bCompressed = image.compression != CompressedFormat::None;
+		const uint32_t levels = m_params.levels;
+		if (!bCompressed && image.levels.size() < levels) {
+			generateMipChain(image, image.colorSpace == ColorSpace::SRGB);
+		}
+
+		const TextureFormat format = chooseTextureFormat(image);
+		const uint32_t uploadLevels = std::min<uint32_t>(levels, static_cast<uint32_t>(image.levels.size()));
+
+		// Сжатые уровни загружаются целыми блоками: резервируется место под блоки каждого уровня,
+		// иначе изображение с размером не кратным блоку залезло бы в соседний регион.
+		uint32_t packedWidth = width;
+		uint32_t packedHeight = height;
+		if (bCompressed) {
+			for (uint32_t levelIndex = 0; levelIndex < uploadLevels; ++levelIndex) {
+				const ImageLevel& level = image.levels[levelIndex];
+				packedWidth = std::max(packedWidth, roundUp(level.width, format.blockWidth) << levelIndex);
+				packedHeight = std::max(packedHeight, roundUp(level.height, format.blockHeight) << levelIndex);
+			}
+		}
+
+		// Позиция и отступ кратны блоку последнего mip-уровня, чтобы на каждом
+		// уровне регион начинался с целого пикселя (и целого блока сжатого формата).
+		const uint32_t alignment = std::max<uint32_t>(format.blockWidth, format.blockHeight) << (levels - 1);
+		uint32_t padding = m_params.padding > 0 ? roundUp(m_params.padding, alignment) : 0;
+		if (packedWidth + padding * 2 > layerSize || packedHeight + padding * 2 > layerSize) {
+			// Изображение размером со слой занимает его целиком и в отступе не нуждается.
+			padding = 0;
+		}
+
+		AtlasRegion region;
+		uint32_t x = 0;
+		uint32_t y = 0;
+		if (!allocateRegion(format, packedWidth + padding * 2, packedHeight + padding * 2, alignment, region.page, region.layer, x, y)) {
+			LOG_ERR("Texture atlas is full, can not add '{0}'", name);
+			return {};
+		}
+
+		Texture2DArray& texture = *m_pages[region.page].pTexture;
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		std::vector<uint8_t> padded;
+		for (uint32_t levelIndex = 0; levelIndex < uploadLevels; ++levelIndex) {
+			const ImageLevel& level = image.levels[levelIndex];
+			if (bCompressed) {
+				// Сжатый уровень загружается целыми блоками, отступ остаётся пустым.
+				texture.upload(
+					region.layer, levelIndex,
+					(x + padding) >> levelIndex, (y + padding) >> levelIndex,
+					roundUp(level.width, format.blockWidth), roundUp(level.height, format.blockHeight),
+					level.getData(), level.getSize()
+				);
+				continue;
+			}
+
+			const uint32_t levelPadding = padding >> levelIndex;
+			buildPaddedLevel(level, image.getBytesPerPixel(), levelPadding, padded);
+			texture.upload(
+				region.layer, levelIndex, x >> levelIndex, y >> levelIndex,
+				level.width + levelPadding * 2, level.height + levelPadding * 2,
+				padded.data(), padded.size()
+			);
+		}
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+		const float scale = 1.f / layerSize;
+		region.u0 = (x + padding) * scale;
+		region.v0 = (y + padding) * scale;
+		region.u1 = (x + padding + width) * scale;
+		region.v1 = (y + padding + height) * scale;
+		region.width = width;
+		region.height = height;
+
+		++m_pages[region.page].regionCount;
+		++m_regionCount;
+		if (!name.empty()) {
+			m_regions.emplace(name, region);
+		}
+		return region;
+	}
+
+	const AtlasRegion* TextureAtlas::find(const std::string& name) const {
+		if (name.empty()) {
+			return nullptr;
+		}
+		const auto it = m_regions.find(name);
+		return it != m_regions.end() ? &it->second : nullptr;
+	}
+
+	void TextureAtlas::bind(uint16_t page, uint32_t slot) const noexcept {
+		m_pages[page].pTexture->bind(slot);
+	}
+
+	bool TextureAtlas::tryPack(Page& page, uint32_t width, uint32_t height, uint32_t alignment, uint16_t& layer, uint32_t& x, uint32_t& y) {
+		for (size_t i = 0; i < page.layers.size(); ++i) {
+			if (page.layers[i].pack(width, height, x, y, alignment)) {
+				layer = static_cast<uint16_t>(i);
+				return true;
+			}
+		}
+
+		// Во всех занятых слоях места нет: начинаем новый слой, при необходимости расширяя массив.
+		Texture2DArray& texture = *page.pTexture;
+		if (page.layers.size() == texture.getLayers()) {
+			const uint32_t layers = std::min(texture.getLayers() * 2, Texture2DArray::getMaxLayers());
+			if (!texture.resize(layers)) {
+				return false;
+			}
+		}
+
+		page.layers.emplace_back(m_params.layerSize, m_params.layerSize);
+		layer = static_cast<uint16_t>(page.layers.size() - 1);
+		return page.layers.back().pack(width, height, x, y, alignment);
+	}
+
+	bool TextureAtlas::allocateRegion(
+		const TextureFormat&	format,
+		uint32_t				width,
+		uint32_t				height,
+		uint32_t				alignment,
+		uint16_t&				pageIndex,
+		uint16_t&				layer,
+		uint32_t&				x,
+		uint32_t&				y
+	) {
+		for (size_t i = 0; i < m_pages.size(); ++i) {
+			Page& page = m_pages[i];
+			if (page.pTexture->getFormat().internalFormat != format.internalFormat) {
+				continue;
+			}
+			if (tryPack(page, width, height, alignment, layer, x, y)) {
+				pageIndex = static_cast<uint16_t>(i);
+				return true;
+			}
+		}
+
+		if (m_pages.size() >= UINT16_MAX) {
+			return false;
+		}
+
+		Page& page = m_pages.emplace_back();
+		page.pTexture = std::make_unique<Texture2DArray>();
+		page.pTexture->setLabel("Texture atlas " + std::to_string(m_pages.size() - 1));
+		page.pTexture->allocate(
+			m_params.layerSize, m_params.layerSize,
+			std::min(m_params.initialLayers, Texture2DArray::getMaxLayers()), m_params.levels, format
+		);
+
+		pageIndex = static_cast<uint16_t>(m_pages.size() - 1);
+		return tryPack(page, width, height, alignment, layer, x, y);
+	}
+
+	void TextureAtlas::drawImGuiPanel() {
+		ImGui::Begin("Атлас текстур");
+
+		ImGui::Text("Регионов: %u, страниц: %u", m_regionCount, getPageCount());
+		for (size_t i = 0; i < m_pages.size(); ++i) {
+			const Page& page = m_pages[i];
+			const Texture2DArray& texture = *page.pTexture;
+			ImGui::Separator();
+			ImGui::Text("Страница %zu: 0x%04X, %ux%u, слоёв %zu/%u, регионов %u, %.1f МБ",
+				i, texture.getFormat().internalFormat, texture.getWidth(), texture.getHeight(),
+				page.layers.size(), texture.getLayers(), page.regionCount,
+				texture.getGpuBytes() / (1024.0 * 1024.0));
+
+			for (size_t layer = 0; layer < page.layers.size(); ++layer) {
+				char label[32];
+				std::snprintf(label, sizeof(label), "Слой %zu", layer);
+				ImGui::ProgressBar(page.layers[layer].getOccupancy(), ImVec2(-1.f, 0.f), label);
+			}
+		}
+
+		ImGui::End();
+	}
+
+} // namespace Engine
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "EngineCore/Render/OpenGL/Texture2DArray.hpp"
+#include "EngineCore/Render/SkylinePacker.hpp"
+
+namespace Engine {
+
+	struct Image;
+
+	/**
+	 * @internal
+	 * @brief Место текстуры в атласе: страница, слой и прямоугольник UV внутри слоя.
+	 *
+	 * Страница - отдельный `Texture2DArray`, поэтому все регионы одной страницы
+	 * рисуются с одной привязкой текстуры.
+	 */
+	struct AtlasRegion {
+		uint16_t	page	= UINT16_MAX;	///< Индекс страницы (массива текстур) атласа.
+		uint16_t	layer	= 0;			///< Слой массива.
+		float		u0		= 0.f;			///< Левый край в UV слоя.
+		float		v0		= 0.f;			///< Первая строка изображения в UV слоя.
+		float		u1		= 0.f;			///< Правый край в UV слоя.
+		float		v1		= 0.f;			///< Край после последней строки в UV слоя.
+		uint32_t	width	= 0;			///< Ширина исходного изображения в пикселях.
+		uint32_t	height	= 0;			///< Высота исходного изображения в пикселях.
+
+		bool isValid() const noexcept { return page != UINT16_MAX; }
+	};
+
+	/**
+	 * @internal
+	 * @brief Параметры атласа текстур.
+	 */
+	struct TextureAtlasParams {
+		uint32_t	layerSize		= 2048;	///< Ширина и высота слоя.
+		uint32_t	initialLayers	= 2;	///< Кол-во слоёв при создании страницы (растёт удвоением).
+		uint32_t	levels			= 1;	///< Кол-во mip-уровней страниц.
+		uint32_t	padding			= 2;	///< Отступ вокруг региона (заполняется краевыми пикселями).
+		bool		bSRGB			= true;	///< Цветовое пространство изображений, в которых оно не указано.
+	};
+
+	/**
+	 * @internal
+	 * @brief Атлас текстур на массивах `GL_TEXTURE_2D_ARRAY`.
+	 *
+	 * Объединяет множество небольших текстур одного формата в несколько страниц,
+	 * чтобы объекты с разными текстурами попадали в один батч:
+	 * - Для каждого формата GPU создаётся страница - массив текстур.
+	 * - Изображения упаковываются в слои страницы алгоритмом skyline (`SkylinePacker`),
+	 *   изображение размером со слой занимает слой целиком.
+	 * - Если слоёв не хватает, массив удваивается с копированием на GPU; при
+	 *   достижении лимита GPU создаётся новая страница.
+	 * - Регион окружается отступом из краевых пикселей, чтобы билинейная фильтрация
+	 *   не захватывала соседей. Для блочно-сжатых форматов отступ остаётся пустым.
+	 *
+	 * Шейдер получает слой и прямоугольник UV региона (например, в атрибутах
+	 * вершины или инстанса) и читает текстуру функцией из `ShaderSource`.
+	 *
+	 * Пример использования
+	 * @code
+	 * AtlasRegion grass = atlas.add("textures/grass.png");
+	 * AtlasRegion stone = atlas.add("textures/stone.png");
+	 * // grass.page == stone.page - оба спрайта рисуются одним вызовом.
+	 * atlas.bind(grass.page, 0);
+	 * @endcode
+	 *
+	 * @note Методы вызываются только из потока с контекстом OpenGL.
+	 */
+	class TextureAtlas {
+	public:
+		/// @internal
+		/// @brief Функция GLSL для чтения региона атласа.
+		///
+		/// `rect` - (u0, v0, u1, v1) региона, `uv` - координаты внутри региона
+		/// (дробная часть, поэтому регион можно повторять). Градиенты передаются
+		/// явно, чтобы на границе повторения не выбирался самый мелкий mip-уровень.
+		static constexpr const char* ShaderSource =
+			"vec4 sampleAtlas(sampler2DArray atlas, vec4 rect, float layer, vec2 uv) {\n"
+			"	vec2 scale = rect.zw - rect.xy;\n"
+			"	vec2 atlasUv = rect.xy + fract(uv) * scale;\n"
+			"	return textureGrad(atlas, vec3(atlasUv, layer), dFdx(uv) * scale, dFdy(uv) * scale);\n"
+			"}\n";
+
+		explicit TextureAtlas(const TextureAtlasParams& params = {});
+		~TextureAtlas();
+
+		TextureAtlas(const TextureAtlas&)				= delete;
+		TextureAtlas& operator=(const TextureAtlas&)	= delete;
+		TextureAtlas(TextureAtlas&&)					= delete;
+		TextureAtlas& operator=(TextureAtlas&&)			= delete;
+
+		/// @internal
+		/// @brief Загружает файл и добавляет изображение в атлас.
+		///
+		/// Повторный вызов с тем же путём возвращает уже добавленный регион.
+		///
+		/// @param path Путь к файлу (также используется как имя региона).
+		/// @return Регион или невалидный регион, если файл не загружен или не помещается в слой.
+		AtlasRegion add(const std::string& path);
+
+		/// @internal
+		/// @brief Добавляет декодированное изображение в атлас.
+		/// @param image Изображение (mip-уровни строятся при необходимости).
+		/// @param name Имя региона для `find()` (пустое - регион без имени).
+		/// @return Регион или невалидный регион, если изображение не помещается в слой.
+		AtlasRegion add(Image image, const std::string& name = {});
+
+		/// @internal
+		/// @brief Ищет регион по имени.
+		/// @return Регион или nullptr.
+		const AtlasRegion* find(const std::string& name) const;
+
+		/// @internal
+		/// @brief Привязывает страницу к текстурному блоку `slot`.
+		void bind(uint16_t page, uint32_t slot = 0) const noexcept;
+
+		const Texture2DArray& getPage(uint16_t page) const noexcept { return *m_pages[page].pTexture; }
+		uint32_t getPageCount() const noexcept { return static_cast<uint32_t>(m_pages.size()); }
+		uint32_t getRegionCount() const noexcept { return m_regionCount; }
+
+		/// @internal
+		/// @brief Отрисовывает ImGui окно с заполненностью страниц.
+		void drawImGuiPanel();
+
+	private:
+		/// Массив текстур одного формата и упаковщики его слоёв.
+		struct Page {
+			std::unique_ptr<Texture2DArray>	pTexture;
+			std::vector<SkylinePacker>		layers;		///< Упаковщики используемых слоёв.
+			uint32_t						regionCount	= 0;
+		};
+
+		bool allocateRegion(const TextureFormat& format, uint32_t width, uint32_t height, uint32_t alignment, uint16_t& pageIndex, uint16_t& layer, uint32_t& x, uint32_t& y);
+		bool tryPack(Page& page, uint32_t width, uint32_t height, uint32_t alignment, uint16_t& layer, uint32_t& x, uint32_t& y);
+
+		TextureAtlasParams								m_params;
+		std::vector<Page>								m_pages;
+		std::unordered_map<std::string, AtlasRegion>	m_regions;
+		uint32_t										m_regionCount	= 0;
+	};
+
+} // namespace Engine
@@ -0,0 +1,497 @@
+#include "EngineCore/Render/TextureLoader.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <glad/glad.h>
+#include <imgui/imgui.h>
+
+#include "EngineCore/Core/JobSystem.hpp"
+#include "EngineCore/Core/MappedFile.hpp"
+#include "EngineCore/Image/BlockCompression.hpp"
+#include "EngineCore/Image/ImageDecoders.hpp"
+#include "EngineCore/Image/Ktx2.hpp"
+#include "EngineCore/Log.hpp"
+#include "EngineCore/Render/OpenGL/GpuResourceRegistry.hpp"
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Объём видеопамяти, который заняли бы уровни изображения без блочного сжатия.
+	static uint64_t getUncompressedBytes(const Image& image) {
+		const uint64_t bytesPerPixel = image.channels == 3 ? 4 : image.channels;
+		uint64_t bytes = 0;
+		for (const ImageLevel& level : image.levels) {
+			bytes += static_cast<uint64_t>(level.width) * level.height * bytesPerPixel;
+		}
+		return bytes;
+	}
+
+	static bool hasExtension(const char* pName) {
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (GLint i = 0; i < count; ++i) {
+			const char* pExtension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+			if (pExtension && std::strcmp(pExtension, pName) == 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	TextureLoader::TextureLoader(
+		JobSystem&			jobSystem,
+		const std::string&	cacheDirectory,
+		size_t				stagingSlotBytes,
+		uint32_t			stagingSlotCount
+	)
+		: m_jobSystem(jobSystem)
+		, m_cache(cacheDirectory)
+		, m_slots(std::max<uint32_t>(stagingSlotCount, 1))
+		, m_slotBytes(stagingSlotBytes)
+	{
+		Texture2D::createPlaceholder();
+
+		// Постоянное отображение требует glBufferStorage (ядро OpenGL 4.4 или ARB_buffer_storage).
+		// Без него буфер отображается на время каждой загрузки в `update()`.
+		m_bPersistentStaging = GLAD_GL_VERSION_4_4 || (hasExtension("GL_ARB_buffer_storage") && glBufferStorage);
+
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		for (size_t i = 0; i < m_slots.size(); ++i) {
+			StagingSlot& slot = m_slots[i];
+			glGenBuffers(1, &slot.bufferId);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.bufferId);
+			if (m_bPersistentStaging) {
+				glBufferStorage(GL_PIXEL_UNPACK_BUFFER, m_slotBytes, nullptr, flags);
+				slot.pMapped = static_cast<uint8_t*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, m_slotBytes, flags));
+			}
+			else {
+				glBufferData(GL_PIXEL_UNPACK_BUFFER, m_slotBytes, nullptr, GL_STREAM_DRAW);
+			}
+
+			GpuResourceRegistry::add(GpuResourceCategory::Buffer, slot.bufferId, m_slotBytes, "staging");
+			GpuResourceRegistry::setLabel(GpuResourceCategory::Buffer, slot.bufferId, "Texture staging " + std::to_string(i));
+		}
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		// RGTC (BC4/BC5) входит в ядро с OpenGL 3.0, BPTC (BC7) - с 4.2.
+		m_bSupportsS3tc = hasExtension("GL_EXT_texture_compression_s3tc");
+		m_bSupportsRgtc = true;
+		m_bSupportsBptc = GLAD_GL_VERSION_4_2 || hasExtension("GL_ARB_texture_compression_bptc");
+		m_bSupportsAstc = hasExtension("GL_KHR_texture_compression_astc_ldr");
+
+		LOG_INFO(
+			"Texture loader: {0} staging buffers of {1} KB (persistent={2}), compression S3TC={3} BPTC={4} ASTC={5}",
+			m_slots.size(), m_slotBytes / 1024, m_bPersistentStaging, m_bSupportsS3tc, m_bSupportsBptc, m_bSupportsAstc
+		);
+	}
+
+	TextureLoader::~TextureLoader() {
+		// Задачи декодирования обращаются к загрузчику, дожидаемся их завершения.
+		m_bShutdown = true;
+		{
+			std::unique_lock<std::mutex> lock(m_decodeMutex);
+			m_decodeDone.wait(lock, [this]() { return m_decodingCount.load() == 0; });
+		}
+
+		for (StagingSlot& slot : m_slots) {
+			if (slot.fence) {
+				glDeleteSync(static_cast<GLsync>(slot.fence));
+			}
+			GpuResourceRegistry::remove(GpuResourceCategory::Buffer, slot.bufferId);
+			if (slot.pMapped) {
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.bufferId);
+				glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+			}
+			glDeleteBuffers(1, &slot.bufferId);
+		}
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		Texture2D::destroyPlaceholder();
+	}
+
+	bool TextureLoader::isFormatSupported(CompressedFormat format) const noexcept {
+		switch (format) {
+		case CompressedFormat::None:		return true;
+		case CompressedFormat::BC1:
+		case CompressedFormat::BC3:			return m_bSupportsS3tc;
+		case CompressedFormat::BC4:
+		case CompressedFormat::BC5:			return m_bSupportsRgtc;
+		case CompressedFormat::BC7:			return m_bSupportsBptc;
+		case CompressedFormat::ASTC_4x4:
+		case CompressedFormat::ASTC_6x6:
+		case CompressedFormat::ASTC_8x8:	return m_bSupportsAstc;
+		}
+		return false;
+	}
+
+	Texture2DPtr TextureLoader::load(const std::string& path, const TextureLoadParams& params) {
+		Texture2DPtr pTexture = std::make_shared<Texture2D>();
+		pTexture->setLabel(path);
+
+		beginDecode();
+		std::weak_ptr<Texture2D> pWeakTexture = pTexture;
+		const Clock::time_point requestTime = Clock::now();
+		m_jobSystem.submit([this, pWeakTexture, path, params, requestTime]() {
+			UploadJob job;
+			job.pTexture = pWeakTexture;
+			job.requestTime = requestTime;
+
+			// Владельцы уже отпустили текстуру - файл можно не читать.
+			bool bDecoded = false;
+			if (!m_bShutdown && !pWeakTexture.expired()) {
+				bDecoded = loadFile(path, params, job);
+				if (!bDecoded) {
+					LOG_ERR("Failed to load texture '{0}'", path);
+				}
+			}
+			finishDecode(std::move(job), bDecoded, params);
+		});
+
+		return pTexture;
+	}
+
+	Texture2DPtr TextureLoader::load(Image image, const TextureLoadParams& params, ESource source) {
+		Texture2DPtr pTexture = std::make_shared<Texture2D>();
+
+		beginDecode();
+		std::weak_ptr<Texture2D> pWeakTexture = pTexture;
+		const Clock::time_point requestTime = Clock::now();
+		m_jobSystem.submit([this, pWeakTexture, image = std::move(image), params, source, requestTime]() mutable {
+			UploadJob job;
+			job.pTexture = pWeakTexture;
+			job.requestTime = requestTime;
+			job.image = std::move(image);
+			job.source = source;
+			const bool bValid = job.image.isValid();
+			finishDecode(std::move(job), bValid, params);
+		});
+
+		return pTexture;
+	}
+
+	void TextureLoader::beginDecode() {
+		++m_pendingCount;
+		++m_decodingCount;
+	}
+
+	bool TextureLoader::loadFile(const std::string& path, const TextureLoadParams& params, UploadJob& job) {
+		auto pFile = std::make_shared<MappedFile>();
+		if (!pFile->open(path)) {
+			LOG_ERR("Can not open image {0}", path);
+			return false;
+		}
+		return prepareImage(std::move(pFile), path, params, job.image, job.source);
+	}
+
+	bool TextureLoader::prepareImage(
+		std::shared_ptr<MappedFile>	pFile,
+		const std::string&			path,
+		const TextureLoadParams&	params,
+		Image&						image,
+		ESource&					source
+	) {
+		if (isKtx2(pFile->getData(), pFile->getSize())) {
+			if (!readKtx2(pFile->getData(), pFile->getSize(), image)) {
+				return false;
+			}
+			image.pStorage = std::move(pFile);
+			source = ESource::Container;
+			return true;
+		}
+
+		const bool bCompress = params.compression != CompressedFormat::None && isFormatSupported(params.compression);
+		if (params.compression != CompressedFormat::None && !bCompress) {
+			LOG_WARN("{0} is not supported by the GPU, '{1}' is loaded uncompressed", getCompressedFormatName(params.compression), path);
+		}
+
+		const ColorSpace colorSpace = params.bSRGB ? ColorSpace::SRGB : ColorSpace::Linear;
+		uint64_t key = 0;
+		if (bCompress) {
+			key = ImageCache::makeKey(pFile->getData(), pFile->getSize(), params.compression, colorSpace, params.bGenerateMips);
+			if (m_cache.load(key, image)) {
+				source = ESource::Cached;
+				return true;
+			}
+		}
+
+		if (!decodeImage(pFile->getData(), pFile->getSize(), image)) {
+			return false;
+		}
+		image.colorSpace = colorSpace;
+		source = ESource::Uncompressed;
+
+		if (!bCompress || image.pixelType != PixelType::UNorm8) {
+			return true;
+		}
+
+		expandToRGBA(image);
+		if (params.bGenerateMips) {
+			generateMipChain(image, params.bSRGB && image.channels == 4);
+		}
+
+		Image compressed;
+		if (!compressImage(image, params.compression, compressed, &m_jobSystem)) {
+			return true;
+		}
+		m_cache.store(key, compressed);
+
+		image = std::move(compressed);
+		source = ESource::Encoded;
+		return true;
+	}
+
+	void TextureLoader::finishDecode(UploadJob&& job, bool bDecoded, const TextureLoadParams& params) {
+		Image& image = job.image;
+		if (bDecoded && !isFormatSupported(image.compression)) {
+			LOG_ERR("Texture format {0} is not supported by the GPU", getCompressedFormatName(image.compression));
+			bDecoded = false;
+		}
+
+		if (bDecoded && !m_bShutdown) {
+			if (image.colorSpace == ColorSpace::Unknown) {
+				image.colorSpace = params.bSRGB ? ColorSpace::SRGB : ColorSpace::Linear;
+			}
+			expandToRGBA(image);
+			if (params.bGenerateMips && image.levels.size() == 1) {
+				generateMipChain(image, image.colorSpace == ColorSpace::SRGB && image.pixelType == PixelType::UNorm8 && image.channels == 4);
+			}
+			job.format = chooseTextureFormat(image);
+		}
+		job.bFailed = !bDecoded;
+		job.prepareMs = std::chrono::duration<double, std::milli>(Clock::now() - job.requestTime).count();
+
+		{
+			std::lock_guard<std::mutex> lock(m_readyMutex);
+			m_ready.push_back(std::move(job));
+		}
+
+		std::lock_guard<std::mutex> lock(m_decodeMutex);
+		--m_decodingCount;
+		m_decodeDone.notify_all();
+	}
+
+	void TextureLoader::finishUpload(UploadJob& job, const Texture2D& texture) {
+		const double latencyMs = std::chrono::duration<double, std::milli>(Clock::now() - job.requestTime).count();
+
+		SourceStats& stats = m_stats[static_cast<size_t>(job.source)];
+		++stats.count;
+		stats.prepareMs += job.prepareMs;
+		stats.latencyMs += latencyMs;
+		stats.gpuBytes += texture.getGpuBytes();
+		stats.uncompressedBytes += job.format.isCompressed() ? getUncompressedBytes(job.image) : texture.getGpuBytes();
+
+		if (job.format.isCompressed()) {
+			LOG_INFO(
+				"Texture '{0}': {1}, {2} KB instead of {3} KB, ready in {4:.1f} ms",
+				texture.getLabel(), getCompressedFormatName(job.image.compression),
+				texture.getGpuBytes() / 1024, getUncompressedBytes(job.image) / 1024, latencyMs
+			);
+		}
+	}
+
+	TextureLoader::StagingSlot* TextureLoader::acquireSlot() {
+		// Буферы используются по кругу, поэтому их fence сигналятся по порядку:
+		// если не освободился следующий буфер, не освободились и остальные.
+		StagingSlot& slot = m_slots[m_nextSlot];
+		if (slot.fence) {
+			const GLenum result = glClientWaitSync(static_cast<GLsync>(slot.fence), 0, 0);
+			if (result == GL_TIMEOUT_EXPIRED) {
+				return nullptr;
+			}
+			glDeleteSync(static_cast<GLsync>(slot.fence));
+			slot.fence = nullptr;
+		}
+
+		m_nextSlot = (m_nextSlot + 1) % m_slots.size();
+		return &slot;
+	}
+
+	void TextureLoader::update() {
+		{
+			std::lock_guard<std::mutex> lock(m_readyMutex);
+			while (!m_ready.empty()) {
+				m_uploads.push_back(std::move(m_ready.front()));
+				m_ready.pop_front();
+			}
+		}
+
+		m_uploadedLastFrame = 0;
+		if (m_uploads.empty()) {
+			return;
+		}
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		size_t budget = m_frameBudget;
+		while (!m_uploads.empty()) {
+			UploadJob& job = m_uploads.front();
+			Texture2DPtr pTexture = job.pTexture.lock();
+
+			if (!pTexture || job.bFailed) {
+				if (pTexture) {
+					pTexture->markFailed();
+				}
+				m_uploads.pop_front();
+				--m_pendingCount;
+				continue;
+			}
+
+			if (budget == 0) {
+				break;
+			}
+
+			const Image& image = job.image;
+			const TextureFormat& format = job.format;
+			const uint32_t levelCount = static_cast<uint32_t>(image.levels.size());
+			if (pTexture->getStorageId() == 0) {
+				pTexture->allocate(image.getWidth(), image.getHeight(), levelCount, format);
+			}
+
+			// Для сжатых форматов "строка" - это строка блоков.
+			const ImageLevel& level = image.levels[job.level];
+			const uint32_t blocksX = (level.width + format.blockWidth - 1) / format.blockWidth;
+			const uint32_t rowCount = (level.height + format.blockHeight - 1) / format.blockHeight;
+			const size_t rowBytes = format.isCompressed()
+				? static_cast<size_t>(blocksX) * format.blockBytes
+				: static_cast<size_t>(level.width) * image.getBytesPerPixel();
+			const uint32_t rowsLeft = rowCount - job.row;
+			const uint8_t* pSource = level.getData() + job.row * rowBytes;
+
+			const void* pUploadData = pSource;
+			uint32_t rows;
+			StagingSlot* pSlot = nullptr;
+			if (rowBytes <= m_slotBytes) {
+				pSlot = acquireSlot();
+				if (!pSlot) {
+					break;
+				}
+
+				const size_t limit = std::min(m_slotBytes, budget);
+				rows = std::min<uint32_t>(rowsLeft, static_cast<uint32_t>(std::max<size_t>(limit / rowBytes, 1)));
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pSlot->bufferId);
+				if (pSlot->pMapped) {
+					std::memcpy(pSlot->pMapped, pSource, rows * rowBytes);
+					pUploadData = nullptr;
+				}
+				else {
+					// Fence буфера уже сигнализирован, поэтому синхронизация при отображении не нужна.
+					void* pMapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, rows * rowBytes,
+						GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+					if (pMapped) {
+						std::memcpy(pMapped, pSource, rows * rowBytes);
+						glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+						pUploadData = nullptr;
+					}
+					else {
+						glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+					}
+				}
+			}
+			else {
+				// Строка не помещается в PBO: загружаем напрямую из памяти процесса.
+				rows = std::min<uint32_t>(rowsLeft, static_cast<uint32_t>(std::max<size_t>(budget / rowBytes, 1)));
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			}
+
+			const uint32_t y = job.row * format.blockHeight;
+			const uint32_t height = std::min(rows * format.blockHeight, level.height - y);
+			const size_t bytes = rows * rowBytes;
+
+			glBindTexture(GL_TEXTURE_2D, pTexture->getStorageId());
+			if (format.isCompressed()) {
+				glCompressedTexSubImage2D(
+					GL_TEXTURE_2D, job.level, 0, y, level.width, height,
+					format.internalFormat, static_cast<GLsizei>(bytes), pUploadData
+				);
+			}
+			else {
+				glTexSubImage2D(
+					GL_TEXTURE_2D, job.level, 0, y, level.width, height,
+					format.dataFormat, format.dataType, pUploadData
+				);
+			}
+			if (pSlot) {
+				pSlot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			}
+
+			budget -= std::min(budget, bytes);
+			m_uploadedLastFrame += bytes;
+			m_uploadedTotal += bytes;
+
+			job.row += rows;
+			if (job.row == rowCount) {
+				job.row = 0;
+				++job.level;
+			}
+
+			if (job.level == levelCount) {
+				pTexture->markReady();
+				finishUpload(job, *pTexture);
+				m_uploads.pop_front();
+				--m_pendingCount;
+			}
+		}
+
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
+	void TextureLoader::drawImGuiPanel() {
+		ImGui::Begin("Загрузка текстур");
+
+		ImGui::Text("В очереди: %u", getPendingCount());
+		ImGui::Text("Передано за кадр: %.1f KB", m_uploadedLastFrame / 1024.0);
+		ImGui::Text("Передано всего: %.1f MB", m_uploadedTotal / (1024.0 * 1024.0));
+
+		int budgetMb = static_cast<int>(m_frameBudget / (1024 * 1024));
+		if (ImGui::SliderInt("Бюджет кадра (MB)", &budgetMb, 1, 256)) {
+			m_frameBudget = static_cast<size_t>(budgetMb) * 1024 * 1024;
+		}
+
+		static const char* s_sourceNames[] = { "Без сжатия", "Сжатие", "Кеш", "KTX2" };
+
+		if (ImGui::BeginTable("TextureLoadStats", 6)) {
+			ImGui::TableSetupColumn("Источник");
+			ImGui::TableSetupColumn("Кол-во");
+			ImGui::TableSetupColumn("Подготовка, мс");
+			ImGui::TableSetupColumn("Готовность, мс");
+			ImGui::TableSetupColumn("VRAM, MB");
+			ImGui::TableSetupColumn("Без сжатия, MB");
+			ImGui::TableHeadersRow();
+
+			uint64_t gpuBytes = 0;
+			uint64_t uncompressedBytes = 0;
+			for (size_t i = 0; i < static_cast<size_t>(ESource::Count); ++i) {
+				const SourceStats& stats = m_stats[i];
+				if (stats.count == 0) {
+					continue;
+				}
+				gpuBytes += stats.gpuBytes;
+				uncompressedBytes += stats.uncompressedBytes;
+
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(s_sourceNames[i]);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", stats.count);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", stats.prepareMs / stats.count);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", stats.latencyMs / stats.count);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", stats.gpuBytes / (1024.0 * 1024.0));
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", stats.uncompressedBytes / (1024.0 * 1024.0));
+			}
+			ImGui::EndTable();
+
+			if (uncompressedBytes > gpuBytes) {
+				ImGui::Text("Сжатие сэкономило %.2f MB видеопамяти", (uncompressedBytes - gpuBytes) / (1024.0 * 1024.0));
+			}
+		}
+
+		ImGui::End();
+	}
+
+} // namespace Engine
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "EngineCore/Image/Image.hpp"
+#include "EngineCore/Image/ImageCache.hpp"
+#include "EngineCore/Render/OpenGL/Texture2D.hpp"
+
+namespace Engine {
+
+	class JobSystem;
+	class MappedFile;
+
+	using Texture2DPtr = std::shared_ptr<Texture2D>;
+
+	/**
+	 * @internal
+	 * @brief Параметры загрузки текстуры.
+	 */
+	struct TextureLoadParams {
+		bool				bSRGB			= true;		///< Цветовые данные в sRGB (GL_SRGB8_ALPHA8, mip-уровни в линейном пространстве).
+		bool				bGenerateMips	= true;		///< Строить цепочку mip-уровней, если файл её не содержит.
+
+		/// Блочный формат, в который сжимается исходное изображение (результат кешируется на диске).
+		/// Если GPU его не поддерживает, текстура загружается без сжатия.
+		CompressedFormat	compression		= CompressedFormat::None;
+	};
+
+	/**
+	 * @internal
+	 * @brief Асинхронный загрузчик 2D текстур.
+	 *
+	 * Загрузка разделена на две стадии:
+	 * 1. Рабочие потоки `JobSystem` читают файл, декодируют изображение
+	 *    (PNG, JPEG, HDR, KTX2) и строят mip-уровни.
+	 * 2. Поток с контекстом OpenGL в `update()` копирует готовые уровни в
+	 *    кольцо постоянно отображённых PBO и запускает `glTexSubImage2D` из них.
+	 *    За кадр передаётся не больше `frameBudget` байт, поэтому большие
+	 *    текстуры загружаются за несколько кадров, не вызывая рывков.
+	 *
+	 * Если в параметрах задан блочный формат (`TextureLoadParams::compression`),
+	 * изображение при первой загрузке сжимается параллельно на рабочих потоках и
+	 * сохраняется в `ImageCache`; при следующих загрузках файл кеша отображается
+	 * в память и сжатые уровни загружаются без декодирования.
+	 *
+	 * До завершения загрузки текстура отдаёт общую заглушку (`Texture2D::getId()`).
+	 * Если все владельцы отпустили текстуру, её декодирование и загрузка пропускаются.
+	 *
+	 * Пример использования
+	 * @code
+	 * TextureLoadParams params;
+	 * params.compression = CompressedFormat::BC7;
+	 * Texture2DPtr pAlbedo = loader.load("textures/brick.png", params);
+	 * // ... каждый кадр:
+	 * loader.update();
+	 * pAlbedo->bind(0);	// заглушка, пока данные не загружены
+	 * @endcode
+	 *
+	 * @note `load()` можно вызывать из любого потока, `update()` - только из потока с контекстом.
+	 */
+	class TextureLoader {
+	public:
+		/**
+		 * @internal
+		 * @brief Способ, которым были получены данные текстуры.
+		 */
+		enum class ESource : uint8_t {
+			Uncompressed,	///< Декодирование без сжатия.
+			Encoded,		///< Декодирование и блочное сжатие (промах кеша).
+			Cached,			///< Сжатые данные из кеша (mmap).
+			Container,		///< Файл KTX2 (mmap).
+			Count
+		};
+
+		/**
+		 * @internal
+		 * @brief Накопленная статистика загрузок одного вида.
+		 */
+		struct SourceStats {
+			uint32_t	count				= 0;
+			double		prepareMs			= 0.0;	///< Суммарное время подготовки на рабочих потоках.
+			double		latencyMs			= 0.0;	///< Суммарное время от запроса до готовности.
+			uint64_t	gpuBytes			= 0;	///< Занятая видеопамять.
+			uint64_t	uncompressedBytes	= 0;	///< Видеопамять, которую заняли бы несжатые данные.
+		};
+
+		/// @internal
+		/// @param jobSystem Пул потоков для декодирования и сжатия.
+		/// @param cacheDirectory Каталог кеша сжатых текстур.
+		/// @param stagingSlotBytes Размер одного PBO в кольце загрузки.
+		/// @param stagingSlotCount Кол-во PBO в кольце.
+		TextureLoader(
+			JobSystem&			jobSystem,
+			const std::string&	cacheDirectory = "cache/textures",
+			size_t				stagingSlotBytes = 4 * 1024 * 1024,
+			uint32_t			stagingSlotCount = 4
+		);
+		~TextureLoader();
+
+		TextureLoader(const TextureLoader&)				= delete;
+		TextureLoader& operator=(const TextureLoader&)	= delete;
+		TextureLoader(TextureLoader&&)					= delete;
+		TextureLoader& operator=(TextureLoader&&)		= delete;
+
+		/// @internal
+		/// @brief Запрашивает асинхронную загрузку текстуры из файла.
+		/// @param path Путь к файлу.
+		/// @param params Параметры загрузки.
+		/// @return Текстура в состоянии `Pending`, которую можно сразу использовать.
+		Texture2DPtr load(const std::string& path, const TextureLoadParams& params = {});
+
+		/// @internal
+		/// @brief Загружает в текстуру уже декодированное изображение.
+		///
+		/// Изображение проходит ту же стадию загрузки через PBO, что и файлы.
+		/// Дополнительные mip-уровни в `image` используются как есть.
+		///
+		/// @param image Изображение (например, подготовленное `prepareImage()`).
+		/// @param params Параметры загрузки.
+		/// @param source Способ получения данных (для статистики).
+		Texture2DPtr load(Image image, const TextureLoadParams& params = {}, ESource source = ESource::Uncompressed);
+
+		/// @internal
+		/// @brief Готовит изображение из отображённого файла так же, как `load(path)`.
+		///
+		/// Читает KTX2 без копирования, берёт сжатые данные из кеша или декодирует и
+		/// сжимает изображение. Может вызываться из любого потока; используется теми,
+		/// кто сам читает файл (например, `AssetManager` для дедупликации по содержимому).
+		///
+		/// @param pFile Отображённый файл (для KTX2 становится владельцем данных уровней).
+		/// @param path Путь к файлу (для сообщений).
+		/// @param params Параметры загрузки.
+		/// @param [out] image Подготовленное изображение.
+		/// @param [out] source Способ получения данных.
+		/// @return false, если файл не удалось декодировать.
+		bool prepareImage(
+			std::shared_ptr<MappedFile>	pFile,
+			const std::string&			path,
+			const TextureLoadParams&	params,
+			Image&						image,
+			ESource&					source
+		);
+
+		/// @internal
+		/// @brief Передаёт на GPU очередную порцию готовых данных.
+		///
+		/// Вызывается каждый кадр в потоке с контекстом OpenGL.
+		void update();
+
+		/// @internal
+		/// @brief Поддерживает ли GPU блочный формат.
+		bool isFormatSupported(CompressedFormat format) const noexcept;
+
+		/// @internal
+		/// @brief Задаёт максимальный объём данных, передаваемых на GPU за кадр.
+		void setFrameBudget(size_t bytes) noexcept { m_frameBudget = bytes; }
+		size_t getFrameBudget() const noexcept { return m_frameBudget; }
+
+		/// @internal
+		/// @brief Кол-во текстур, ожидающих декодирования или загрузки.
+		uint32_t getPendingCount() const noexcept { return m_pendingCount.load(std::memory_order_relaxed); }
+
+		/// @internal
+		/// @brief Объём данных, переданных на GPU в последнем `update()`.
+		size_t getUploadedLastFrame() const noexcept { return m_uploadedLastFrame; }
+
+		/// @internal
+		/// @brief Статистика загрузок по способу получения данных.
+		const SourceStats& getStats(ESource source) const noexcept { return m_stats[static_cast<size_t>(source)]; }
+
+		/// @internal
+		/// @brief Отрисовывает ImGui окно со статистикой загрузки.
+		void drawImGuiPanel();
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		/// Декодированное изображение, ожидающее загрузки на GPU.
+		struct UploadJob {
+			std::weak_ptr<Texture2D>	pTexture;
+			Image						image;
+			TextureFormat				format;
+			ESource						source			= ESource::Uncompressed;
+			Clock::time_point			requestTime;
+			double						prepareMs		= 0.0;
+			uint32_t					level			= 0;	///< Текущий загружаемый уровень.
+			uint32_t					row				= 0;	///< Первая незагруженная строка (блоков) уровня.
+			bool						bFailed			= false;
+		};
+
+		/// Один PBO из кольца загрузки.
+		struct StagingSlot {
+			unsigned int	bufferId	= 0;
+			uint8_t*		pMapped		= nullptr;	///< Постоянное отображение (nullptr без glBufferStorage).
+			void*			fence		= nullptr;	///< GLsync последней загрузки из этого буфера.
+		};
+
+		void beginDecode();
+		bool loadFile(const std::string& path, const TextureLoadParams& params, UploadJob& job);
+		void finishDecode(UploadJob&& job, bool bDecoded, const TextureLoadParams& params);
+		void finishUpload(UploadJob& job, const Texture2D& texture);
+		StagingSlot* acquireSlot();
+
+		JobSystem&					m_jobSystem;
+		ImageCache					m_cache;
+		std::vector<StagingSlot>	m_slots;
+		size_t						m_slotBytes;
+		uint32_t					m_nextSlot			= 0;
+		bool						m_bPersistentStaging	= false;
+
+		// Поддержка форматов GPU (определяется при создании в потоке с контекстом).
+		bool						m_bSupportsS3tc		= false;
+		bool						m_bSupportsRgtc		= false;
+		bool						m_bSupportsBptc		= false;
+		bool						m_bSupportsAstc		= false;
+
+		// Декодированные изображения (заполняются рабочими потоками).
+		std::mutex					m_readyMutex;
+		std::deque<UploadJob>		m_ready;
+
+		// Очередь загрузки (только поток с контекстом).
+		std::deque<UploadJob>		m_uploads;
+
+		// Ожидание завершения фоновых задач при уничтожении.
+		std::mutex					m_decodeMutex;
+		std::condition_variable		m_decodeDone;
+		std::atomic<uint32_t>		m_decodingCount		{ 0 };
+		std::atomic<bool>			m_bShutdown			{ false };
+		std::atomic<uint32_t>		m_pendingCount		{ 0 };
+
+		size_t						m_frameBudget		= 16 * 1024 * 1024;
+		size_t						m_uploadedLastFrame	= 0;
+		uint64_t					m_uploadedTotal		= 0;
+		SourceStats					m_stats[static_cast<size_t>(ESource::Count)];
+	};
+
+} // namespace Engine
@@ -0,0 +1,317 @@
+#include "EngineCore/Render/VertexQuantization.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define ENGINE_QUANTIZE_SSE2 1
+	#include <emmintrin.h>
+	// AVX2 не включает F16C: GCC и Clang требуют `-mf16c`. MSVC не задаёт `__F16C__`,
+	// но с /arch:AVX2 разрешает эти инструкции.
+	#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+		#define ENGINE_QUANTIZE_F16C 1
+		#include <immintrin.h>
+	#endif
+#endif
+
+namespace Engine {
+
+	// Скалярные версии округляют так же, как `_mm_cvtps_epi32` (к ближайшему чётному),
+	// поэтому результат не зависит от того, попал ли элемент в хвост массива.
+
+	static int32_t roundScaled(float value, float minValue, float scale) noexcept {
+		return static_cast<int32_t>(std::lrint(std::clamp(value, minValue, 1.f) * scale));
+	}
+
+	uint16_t floatToHalf(float value) noexcept {
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		const uint32_t sign = bits & 0x80000000u;
+		bits ^= sign;
+
+		uint32_t result;
+		if (bits >= (143u << 23)) {
+			// Переполнение -> бесконечность, NaN остаётся NaN.
+			result = bits > 0x7f800000u ? 0x7e00u : 0x7c00u;
+		}
+		else if (bits < (113u << 23)) {
+			// Денормализованный результат: округление выполняет сложение с "магическим" числом.
+			const uint32_t magicBits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+			float magic;
+			float absolute;
+			std::memcpy(&magic, &magicBits, sizeof(magic));
+			std::memcpy(&absolute, &bits, sizeof(absolute));
+			absolute += magic;
+			std::memcpy(&bits, &absolute, sizeof(bits));
+			result = bits - magicBits;
+		}
+		else {
+			const uint32_t mantissaOdd = (bits >> 13) & 1u;
+			bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xfffu;
+			bits += mantissaOdd;
+			result = bits >> 13;
+		}
+		return static_cast<uint16_t>(result | (sign >> 16));
+	}
+
+	float halfToFloat(uint16_t value) noexcept {
+		const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+		const uint32_t exponent = (value >> 10) & 0x1fu;
+		const uint32_t mantissa = value & 0x3ffu;
+
+		uint32_t bits;
+		if (exponent == 0) {
+			const float result = std::ldexp(static_cast<float>(mantissa), -24);
+			return sign ? -result : result;
+		}
+		if (exponent == 31) {
+			bits = sign | 0x7f800000u | (mantissa << 13);
+		}
+		else {
+			bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+		}
+		float result;
+		std::memcpy(&result, &bits, sizeof(result));
+		return result;
+	}
+
+#if defined(ENGINE_QUANTIZE_SSE2) && !defined(ENGINE_QUANTIZE_F16C)
+	/// @internal
+	/// @brief SSE2 версия `floatToHalf()` для 4 значений (результат в младших 16 битах,
+	/// расширенных знаком, чтобы `_mm_packs_epi32` не насыщал отрицательные).
+	static __m128i floatToHalf4(__m128 value) noexcept {
+		const __m128i f16Max = _mm_set1_epi32((127 + 16) << 23);
+		const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+		const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+		const __m128i normalBias = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+
+		const __m128 sign = _mm_and_ps(value, _mm_set1_ps(-0.f));
+		const __m128 absolute = _mm_xor_ps(value, sign);
+		const __m128i absoluteBits = _mm_castps_si128(absolute);
+
+		const __m128i bNan = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+		const __m128i bRegular = _mm_cmpgt_epi32(f16Max, absoluteBits);
+		const __m128i special = _mm_or_si128(_mm_and_si128(bNan, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7c00));
+
+		const __m128i bSubnormal = _mm_cmpgt_epi32(minNormal, absoluteBits);
+		const __m128 subnormalSum = _mm_add_ps(absolute, _mm_castsi128_ps(subnormalMagic));
+		const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(subnormalSum), subnormalMagic);
+
+		const __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absoluteBits, 31 - 13), 31);
+		const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absoluteBits, normalBias), mantissaOdd), 13);
+
+		const __m128i finite = _mm_or_si128(_mm_and_si128(bSubnormal, subnormal), _mm_andnot_si128(bSubnormal, normal));
+		const __m128i result = _mm_or_si128(_mm_and_si128(bRegular, finite), _mm_andnot_si128(bRegular, special));
+		return _mm_or_si128(result, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+	}
+#endif
+
+	void quantizeHalf(const float* pSource, uint16_t* pOut, size_t count) noexcept {
+		size_t i = 0;
+#if defined(ENGINE_QUANTIZE_F16C)
+		for (; i + 8 <= count; i += 8) {
+			const __m128i low = _mm_cvtps_ph(_mm_loadu_ps(pSource + i), _MM_FROUND_TO_NEAREST_INT);
+			const __m128i high = _mm_cvtps_ph(_mm_loadu_ps(pSource + i + 4), _MM_FROUND_TO_NEAREST_INT);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), _mm_unpacklo_epi64(low, high));
+		}
+#elif defined(ENGINE_QUANTIZE_SSE2)
+		for (; i + 8 <= count; i += 8) {
+			const __m128i low = floatToHalf4(_mm_loadu_ps(pSource + i));
+			const __m128i high = floatToHalf4(_mm_loadu_ps(pSource + i + 4));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), _mm_packs_epi32(low, high));
+		}
+#endif
+		for (; i < count; ++i) {
+			pOut[i] = floatToHalf(pSource[i]);
+		}
+	}
+
+#if defined(ENGINE_QUANTIZE_SSE2)
+	static __m128i scaleAndRound(const float* pSource, __m128 minValue, __m128 scale) noexcept {
+		const __m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(pSource), minValue), _mm_set1_ps(1.f));
+		return _mm_cvtps_epi32(_mm_mul_ps(value, scale));
+	}
+#endif
+
+	void quantizeUNorm8(const float* pSource, uint8_t* pOut, size_t count) noexcept {
+		size_t i = 0;
+#if defined(ENGINE_QUANTIZE_SSE2)
+		const __m128 minValue = _mm_setzero_ps();
+		const __m128 scale = _mm_set1_ps(255.f);
+		for (; i + 16 <= count; i += 16) {
+			const __m128i a = _mm_packs_epi32(scaleAndRound(pSource + i, minValue, scale), scaleAndRound(pSource + i + 4, minValue, scale));
+			const __m128i b = _mm_packs_epi32(scaleAndRound(pSource + i + 8, minValue, scale), scaleAndRound(pSource + i + 12, minValue, scale));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), _mm_packus_epi16(a, b));
+		}
+#endif
+		for (; i < count; ++i) {
+			pOut[i] = static_cast<uint8_t>(roundScaled(pSource[i], 0.f, 255.f));
+		}
+	}
+
+	void quantizeSNorm8(const float* pSource, int8_t* pOut, size_t count) noexcept {
+		size_t i = 0;
+#if defined(ENGINE_QUANTIZE_SSE2)
+		const __m128 minValue = _mm_set1_ps(-1.f);
+		const __m128 scale = _mm_set1_ps(127.f);
+		for (; i + 16 <= count; i += 16) {
+			const __m128i a = _mm_packs_epi32(scaleAndRound(pSource + i, minValue, scale), scaleAndRound(pSource + i + 4, minValue, scale));
+			const __m128i b = _mm_packs_epi32(scaleAndRound(pSource + i + 8, minValue, scale), scaleAndRound(pSource + i + 12, minValue, scale));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), _mm_packs_epi16(a, b));
+		}
+#endif
+		for (; i < count; ++i) {
+			pOut[i] = static_cast<int8_t>(roundScaled(pSource[i], -1.f, 127.f));
+		}
+	}
+
+	void quantizeUNorm16(const float* pSource, uint16_t* pOut, size_t count) noexcept {
+		size_t i = 0;
+#if defined(ENGINE_QUANTIZE_SSE2)
+		// В SSE2 нет беззнаковой упаковки 32 -> 16: значения сдвигаются в знаковый
+		// диапазон, упаковываются и сдвигаются обратно инверсией старшего бита.
+		const __m128 minValue = _mm_setzero_ps();
+		const __m128 scale = _mm_set1_ps(65535.f);
+		const __m128i bias32 = _mm_set1_epi32(32768);
+		const __m128i bias16 = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+		for (; i + 8 <= count; i += 8) {
+			const __m128i a = _mm_sub_epi32(scaleAndRound(pSource + i, minValue, scale), bias32);
+			const __m128i b = _mm_sub_epi32(scaleAndRound(pSource + i + 4, minValue, scale), bias32);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), _mm_xor_si128(_mm_packs_epi32(a, b), bias16));
+		}
+#endif
+		for (; i < count; ++i) {
+			pOut[i] = static_cast<uint16_t>(roundScaled(pSource[i], 0.f, 65535.f));
+		}
+	}
+
+	void quantizeSNorm16(const float* pSource, int16_t* pOut, size_t count) noexcept {
+		size_t i = 0;
+#if defined(ENGINE_QUANTIZE_SSE2)
+		const __m128 minValue = _mm_set1_ps(-1.f);
+		const __m128 scale = _mm_set1_ps(32767.f);
+		for (; i + 8 <= count; i += 8) {
+			const __m128i packed = _mm_packs_epi32(scaleAndRound(pSource + i, minValue, scale), scaleAndRound(pSource + i + 4, minValue, scale));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), packed);
+		}
+#endif
+		for (; i < count; ++i) {
+			pOut[i] = static_cast<int16_t>(roundScaled(pSource[i], -1.f, 32767.f));
+		}
+	}
+
+	void packSNorm10_10_10_2(const float* pSource, size_t components, uint32_t* pOut, size_t count) noexcept {
+		size_t i = 0;
+#if defined(ENGINE_QUANTIZE_SSE2)
+		const __m128 minValue = _mm_set1_ps(-1.f);
+		const __m128 maxValue = _mm_set1_ps(1.f);
+		const __m128 scale = _mm_set1_ps(511.f);
+		const __m128i mask10 = _mm_set1_epi32(0x3ff);
+		for (; i + 4 <= count; i += 4) {
+			// Четыре вектора транспонируются, чтобы каждый регистр содержал одну компоненту.
+			const float* p = pSource + i * components;
+			const size_t c = components;
+			__m128 x = _mm_setr_ps(p[0], p[c], p[c * 2], p[c * 3]);
+			__m128 y = _mm_setr_ps(p[1], p[c + 1], p[c * 2 + 1], p[c * 3 + 1]);
+			__m128 z = _mm_setr_ps(p[2], p[c + 2], p[c * 2 + 2], p[c * 3 + 2]);
+			__m128 w = c >= 4 ? _mm_setr_ps(p[3], p[c + 3], p[c * 2 + 3], p[c * 3 + 3]) : _mm_setzero_ps();
+
+			x = _mm_mul_ps(_mm_min_ps(_mm_max_ps(x, minValue), maxValue), scale);
+			y = _mm_mul_ps(_mm_min_ps(_mm_max_ps(y, minValue), maxValue), scale);
+			z = _mm_mul_ps(_mm_min_ps(_mm_max_ps(z, minValue), maxValue), scale);
+			w = _mm_min_ps(_mm_max_ps(w, minValue), maxValue);
+
+			__m128i packed = _mm_and_si128(_mm_cvtps_epi32(x), mask10);
+			packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_and_si128(_mm_cvtps_epi32(y), mask10), 10));
+			packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_and_si128(_mm_cvtps_epi32(z), mask10), 20));
+			packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_cvtps_epi32(w), 30));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), packed);
+		}
+#endif
+		for (; i < count; ++i) {
+			const float* p = pSource + i * components;
+			const uint32_t x = static_cast<uint32_t>(roundScaled(p[0], -1.f, 511.f)) & 0x3ffu;
+			const uint32_t y = static_cast<uint32_t>(roundScaled(p[1], -1.f, 511.f)) & 0x3ffu;
+			const uint32_t z = static_cast<uint32_t>(roundScaled(p[2], -1.f, 511.f)) & 0x3ffu;
+			const uint32_t w = components >= 4 ? static_cast<uint32_t>(roundScaled(p[3], -1.f, 1.f)) & 0x3u : 0u;
+			pOut[i] = x | (y << 10) | (z << 20) | (w << 30);
+		}
+	}
+
+	/// @internal
+	/// @brief Переводит `vertexCount` вершин атрибута в плотно упакованный массив `pOut`.
+	static void convertAttribute(const float* pSource, size_t vertexCount, const BufferElement& element, uint8_t* pOut) noexcept {
+		const size_t count = vertexCount * element.componentCount;
+		switch (element.type) {
+		case ShaderDataType::Float:
+		case ShaderDataType::Float2:
+		case ShaderDataType::Float3:
+		case ShaderDataType::Float4:
+			std::memcpy(pOut, pSource, count * sizeof(float));
+			break;
+		case ShaderDataType::Int:
+		case ShaderDataType::Int2:
+		case ShaderDataType::Int3:
+		case ShaderDataType::Int4:
+			for (size_t i = 0; i < count; ++i) {
+				const int32_t value = static_cast<int32_t>(std::lrint(pSource[i]));
+				std::memcpy(pOut + i * sizeof(value), &value, sizeof(value));
+			}
+			break;
+		case ShaderDataType::UInt8x4:
+			for (size_t i = 0; i < count; ++i) {
+				pOut[i] = static_cast<uint8_t>(std::clamp<long>(std::lrint(pSource[i]), 0, 255));
+			}
+			break;
+		case ShaderDataType::Half2:
+		case ShaderDataType::Half4:
+			quantizeHalf(pSource, reinterpret_cast<uint16_t*>(pOut), count);
+			break;
+		case ShaderDataType::UNorm8x4:
+			quantizeUNorm8(pSource, pOut, count);
+			break;
+		case ShaderDataType::SNorm8x4:
+			quantizeSNorm8(pSource, reinterpret_cast<int8_t*>(pOut), count);
+			break;
+		case ShaderDataType::UNorm16x2:
+		case ShaderDataType::UNorm16x4:
+			quantizeUNorm16(pSource, reinterpret_cast<uint16_t*>(pOut), count);
+			break;
+		case ShaderDataType::SNorm16x2:
+		case ShaderDataType::SNorm16x4:
+			quantizeSNorm16(pSource, reinterpret_cast<int16_t*>(pOut), count);
+			break;
+		case ShaderDataType::SNorm10_10_10_2:
+			packSNorm10_10_10_2(pSource, 4, reinterpret_cast<uint32_t*>(pOut), vertexCount);
+			break;
+		}
+	}
+
+	void writeVertexAttribute(
+		const float*			pSource,
+		size_t					vertexCount,
+		const BufferElement&	element,
+		void*					pVertices,
+		size_t					stride
+	) noexcept {
+		uint8_t* pOut = static_cast<uint8_t*>(pVertices) + element.offset;
+		if (stride == element.size) {
+			convertAttribute(pSource, vertexCount, element, pOut);
+			return;
+		}
+
+		// Чередующийся буфер: вершины переводятся порциями во временный массив
+		// (ядра работают с плотными данными) и раскладываются с шагом `stride`.
+		constexpr size_t ChunkVertices = 64;
+		alignas(16) uint8_t chunk[ChunkVertices * 4 * sizeof(float)];
+		for (size_t first = 0; first < vertexCount; first += ChunkVertices) {
+			const size_t chunkCount = std::min(ChunkVertices, vertexCount - first);
+			convertAttribute(pSource + first * element.componentCount, chunkCount, element, chunk);
+			for (size_t i = 0; i < chunkCount; ++i) {
+				std::memcpy(pOut + (first + i) * stride, chunk + i * element.size, element.size);
+			}
+		}
+	}
+
+} // namespace Engine
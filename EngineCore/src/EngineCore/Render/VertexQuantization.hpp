@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Переводит float в half float (IEEE 754 binary16, округление к ближайшему чётному).
+	uint16_t floatToHalf(float value) noexcept;
+
+	/// @internal
+	/// @brief Переводит half float в float.
+	float halfToFloat(uint16_t value) noexcept;
+
+	/// @internal
+	/// @brief Переводит `count` значений в half float.
+	void quantizeHalf(const float* pSource, uint16_t* pOut, size_t count) noexcept;
+
+	/// @internal
+	/// @brief Переводит `count` значений из [0, 1] в `round(x * 255)` (значения вне диапазона обрезаются).
+	void quantizeUNorm8(const float* pSource, uint8_t* pOut, size_t count) noexcept;
+
+	/// @internal
+	/// @brief Переводит `count` значений из [-1, 1] в `round(x * 127)`.
+	void quantizeSNorm8(const float* pSource, int8_t* pOut, size_t count) noexcept;
+
+	/// @internal
+	/// @brief Переводит `count` значений из [0, 1] в `round(x * 65535)`.
+	void quantizeUNorm16(const float* pSource, uint16_t* pOut, size_t count) noexcept;
+
+	/// @internal
+	/// @brief Переводит `count` значений из [-1, 1] в `round(x * 32767)`.
+	void quantizeSNorm16(const float* pSource, int16_t* pOut, size_t count) noexcept;
+
+	/// @internal
+	/// @brief Упаковывает векторы из [-1, 1] в `GL_INT_2_10_10_10_REV`.
+	///
+	/// x, y, z занимают по 10 бит, w - 2 бита (-1, 0 или 1, например знак бинормали).
+	///
+	/// @param pSource Векторы по `components` float подряд.
+	/// @param components 3 (w = 0) или 4.
+	/// @param [out] pOut `count` упакованных значений.
+	/// @param count Кол-во векторов.
+	void packSNorm10_10_10_2(const float* pSource, size_t components, uint32_t* pOut, size_t count) noexcept;
+
+	/// @internal
+	/// @brief Записывает поток float-компонентов атрибута в вершинный буфер в формате `element`.
+	///
+	/// Позволяет собирать чередующиеся буферы со сжатыми атрибутами:
+	/// @code
+	/// BufferLayout layout{ ShaderDataType::Float3, ShaderDataType::SNorm10_10_10_2, ShaderDataType::UNorm16x2 };
+	/// std::vector<uint8_t> vertices(layout.getStride() * count);
+	/// writeVertexAttribute(positions, count, layout.getElements()[0], vertices.data(), layout.getStride());
+	/// writeVertexAttribute(normals,   count, layout.getElements()[1], vertices.data(), layout.getStride());
+	/// writeVertexAttribute(uvs,       count, layout.getElements()[2], vertices.data(), layout.getStride());
+	/// @endcode
+	///
+	/// @param pSource `vertexCount` x `element.componentCount` float подряд
+	/// (для `SNorm10_10_10_2` - 4 компонента, для целых типов - значения без масштабирования).
+	/// @param vertexCount Кол-во вершин.
+	/// @param element Атрибут (тип и смещение внутри вершины).
+	/// @param [out] pVertices Начало вершинного буфера.
+	/// @param stride Размер вершины в байтах.
+	void writeVertexAttribute(
+		const float*			pSource,
+		size_t					vertexCount,
+		const BufferElement&	element,
+		void*					pVertices,
+		size_t					stride
+	) noexcept;
+
+} // namespace Engine
@@ -0,0 +1,382 @@
+#include "EngineCore/Scene/TransformHierarchy.hpp"
+
+#include <algorithm>
+
+#include "EngineCore/Core/JobSystem.hpp"
+#include "EngineCore/Log.hpp"
+
+namespace Engine {
+
+	/// @internal
+	/// @brief Значение индекса, обозначающее отсутствие узла (например, родителя у корня).
+	constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+	/// @internal
+	/// @brief Минимальное кол-во узлов в одной задаче при параллельном обновлении уровня.
+	constexpr uint32_t UpdateGrainSize = 4096;
+
+	void TransformHierarchy::reserve(uint32_t count) {
+		m_parentIndex.reserve(count);
+		m_idAt.reserve(count);
+		m_local.reserve(count);
+		m_world.reserve(count);
+		m_flags.reserve(count);
+		m_indexOf.reserve(count);
+	}
+
+	TransformId TransformHierarchy::create(TransformId parent, const LocalTransform& local) {
+		TransformId id;
+		if (!m_freeIds.empty()) {
+			id = m_freeIds.back();
+			m_freeIds.pop_back();
+		}
+		else {
+			id = static_cast<TransformId>(m_indexOf.size());
+			m_indexOf.push_back(0);
+		}
+
+		const uint32_t index = static_cast<uint32_t>(m_world.size());
+		m_indexOf[id] = index;
+
+		m_parentIndex.push_back(parent == InvalidTransformId ? InvalidIndex : m_indexOf[parent]);
+		m_idAt.push_back(id);
+		m_local.push_back(local);
+		m_world.emplace_back();
+		m_flags.push_back(LocalDirty);
+
+		m_bNeedsRebuild = true;
+		return id;
+	}
+
+	void TransformHierarchy::destroy(TransformId id) {
+		if (!isAlive(id)) {
+			LOG_WARN("Attempt to destroy dead transform {0}", id);
+			return;
+		}
+
+		m_flags[m_indexOf[id]] |= Removed;
+		m_bNeedsRebuild = true;
+	}
+
+	bool TransformHierarchy::setParent(TransformId id, TransformId parent) {
+		const uint32_t index = m_indexOf[id];
+
+		if (parent == InvalidTransformId) {
+			m_parentIndex[index] = InvalidIndex;
+		}
+		else {
+			// Новый родитель не должен находиться в поддереве узла.
+			for (uint32_t p = m_indexOf[parent]; p != InvalidIndex; p = m_parentIndex[p]) {
+				if (p == index) {
+					LOG_ERR("Transform {0} can not be parented to its descendant {1}", id, parent);
+					return false;
+				}
+			}
+			m_parentIndex[index] = m_indexOf[parent];
+		}
+
+		m_flags[index] |= LocalDirty;
+		m_bNeedsRebuild = true;
+		return true;
+	}
+
+	void TransformHierarchy::markLocalDirty(TransformId id) {
+		const uint32_t index = m_indexOf[id];
+		if ((m_flags[index] & LocalDirty) == 0) {
+			m_flags[index] |= LocalDirty;
+			m_dirtyIndices.push_back(index);
+		}
+	}
+
+	void TransformHierarchy::setLocal(TransformId id, const LocalTransform& local) {
+		m_local[m_indexOf[id]] = local;
+		markLocalDirty(id);
+	}
+
+	void TransformHierarchy::setPosition(TransformId id, const Vec3& position) {
+		m_local[m_indexOf[id]].position = position;
+		markLocalDirty(id);
+	}
+
+	void TransformHierarchy::setRotation(TransformId id, const Quat& rotation) {
+		m_local[m_indexOf[id]].rotation = rotation;
+		markLocalDirty(id);
+	}
+
+	void TransformHierarchy::setScale(TransformId id, const Vec3& scale) {
+		m_local[m_indexOf[id]].scale = scale;
+		markLocalDirty(id);
+	}
+
+	TransformId TransformHierarchy::getParent(TransformId id) const {
+		const uint32_t parentIndex = m_parentIndex[m_indexOf[id]];
+		return parentIndex == InvalidIndex ? InvalidTransformId : m_idAt[parentIndex];
+	}
+
+	bool TransformHierarchy::isAlive(TransformId id) const noexcept {
+		return id < m_indexOf.size()
+			&& m_indexOf[id] != InvalidIndex
+			&& (m_flags[m_indexOf[id]] & Removed) == 0;
+	}
+
+	void TransformHierarchy::rebuild() {
+		const uint32_t count = static_cast<uint32_t>(m_world.size());
+
+		// Списки детей в формате CSR: дети узла i - [childOffsets[i], childOffsets[i + 1]).
+		std::vector<uint32_t> childOffsets(count + 1, 0);
+		std::vector<uint32_t> roots;
+		for (uint32_t i = 0; i < count; ++i) {
+			if (m_parentIndex[i] == InvalidIndex) {
+				roots.push_back(i);
+			}
+			else {
+				++childOffsets[m_parentIndex[i] + 1];
+			}
+		}
+		for (uint32_t i = 0; i < count; ++i) {
+			childOffsets[i + 1] += childOffsets[i];
+		}
+
+		std::vector<uint32_t> children(childOffsets[count]);
+		{
+			std::vector<uint32_t> cursor(childOffsets.begin(), childOffsets.end() - 1);
+			for (uint32_t i = 0; i < count; ++i) {
+				if (m_parentIndex[i] != InvalidIndex) {
+					children[cursor[m_parentIndex[i]]++] = i;
+				}
+			}
+		}
+
+		// Освобождает идентификаторы удалённого поддерева.
+		std::vector<uint32_t> stack;
+		auto releaseSubtree = [&](uint32_t root) {
+			stack.push_back(root);
+			while (!stack.empty()) {
+				const uint32_t node = stack.back();
+				stack.pop_back();
+
+				m_indexOf[m_idAt[node]] = InvalidIndex;
+				m_freeIds.push_back(m_idAt[node]);
+				for (uint32_t c = childOffsets[node]; c < childOffsets[node + 1]; ++c) {
+					stack.push_back(children[c]);
+				}
+			}
+		};
+
+		// Обход в ширину: уровни выкладываются подряд, дети одного родителя - рядом.
+		std::vector<uint32_t> order;
+		order.reserve(count);
+		for (uint32_t root : roots) {
+			if (m_flags[root] & Removed) {
+				releaseSubtree(root);
+			}
+			else {
+				order.push_back(root);
+			}
+		}
+
+		m_levelOffsets.assign(1, 0);
+		size_t levelBegin = 0;
+		while (levelBegin < order.size()) {
+			const size_t levelEnd = order.size();
+			m_levelOffsets.push_back(static_cast<uint32_t>(levelEnd));
+
+			for (size_t k = levelBegin; k < levelEnd; ++k) {
+				const uint32_t node = order[k];
+				for (uint32_t c = childOffsets[node]; c < childOffsets[node + 1]; ++c) {
+					if (m_flags[children[c]] & Removed) {
+						releaseSubtree(children[c]);
+					}
+					else {
+						order.push_back(children[c]);
+					}
+				}
+			}
+			levelBegin = levelEnd;
+		}
+
+		// Переупорядочивание массивов узлов.
+		const uint32_t newCount = static_cast<uint32_t>(order.size());
+		std::vector<uint32_t> newIndex(count, InvalidIndex);
+		for (uint32_t k = 0; k < newCount; ++k) {
+			newIndex[order[k]] = k;
+		}
+
+		std::vector<uint32_t>		parentIndex(newCount);
+		std::vector<TransformId>	idAt(newCount);
+		std::vector<LocalTransform>	local(newCount);
+		std::vector<Mat4>			world(newCount);
+		std::vector<uint8_t>		flags(newCount);
+
+		m_firstChild.assign(newCount, 0);
+		m_childCount.assign(newCount, 0);
+		m_dirtyIndices.clear();
+
+		for (uint32_t k = 0; k < newCount; ++k) {
+			const uint32_t old = order[k];
+			const uint32_t oldParent = m_parentIndex[old];
+
+			parentIndex[k]	= oldParent == InvalidIndex ? InvalidIndex : newIndex[oldParent];
+			idAt[k]			= m_idAt[old];
+			local[k]		= m_local[old];
+			world[k]		= m_world[old];
+			flags[k]		= m_flags[old];
+
+			// Дети одного родителя идут подряд, поэтому достаточно запомнить первого.
+			if (parentIndex[k] != InvalidIndex && m_childCount[parentIndex[k]]++ == 0) {
+				m_firstChild[parentIndex[k]] = k;
+			}
+
+			if (flags[k] & LocalDirty) {
+				m_dirtyIndices.push_back(k);
+			}
+
+			m_indexOf[idAt[k]] = k;
+		}
+
+		m_parentIndex	= std::move(parentIndex);
+		m_idAt			= std::move(idAt);
+		m_local			= std::move(local);
+		m_world			= std::move(world);
+		m_flags			= std::move(flags);
+
+		m_levelWork.resize(m_levelOffsets.size() - 1);
+
+		m_bNeedsRebuild = false;
+	}
+
+	void TransformHierarchy::removeOverlaps(std::vector<Range>& work) {
+		// Диапазоны детей разных родителей не пересекаются, поэтому после сортировки
+		// достаточно обрезать каждый диапазон по концу предыдущих.
+		std::sort(work.begin(), work.end(), [](const Range& lhs, const Range& rhs) { return lhs.begin < rhs.begin; });
+
+		uint32_t covered = 0;
+		size_t count = 0;
+		for (const Range& range : work) {
+			const uint32_t begin = std::max(range.begin, covered);
+			if (begin < range.end) {
+				work[count++] = { begin, range.end };
+				covered = range.end;
+			}
+		}
+		work.resize(count);
+	}
+
+	void TransformHierarchy::updateLevel(
+		const std::vector<Range>&	work,
+		std::vector<Range>*			pNextWork,
+		JobSystem*					pJobSystem
+	) {
+		uint32_t nodeCount = 0;
+		for (const Range& range : work) {
+			nodeCount += range.end - range.begin;
+		}
+
+		// Разбиение по диапазонам так, чтобы в среднем на задачу приходилось UpdateGrainSize узлов.
+		const uint32_t rangeCount = static_cast<uint32_t>(work.size());
+		const bool bParallel = pJobSystem && nodeCount >= UpdateGrainSize * 2 && rangeCount > 1;
+		uint32_t rangesPerJob = rangeCount;
+		if (bParallel) {
+			const uint64_t averageRange = std::max<uint64_t>(nodeCount / rangeCount, 1);
+			rangesPerJob = static_cast<uint32_t>(std::max<uint64_t>(UpdateGrainSize / averageRange, 1));
+		}
+		const uint32_t jobCount = (rangeCount + rangesPerJob - 1) / rangesPerJob;
+		if (m_jobScratch.size() < jobCount) {
+			m_jobScratch.resize(jobCount);
+		}
+
+		// Части `parallelFor` начинаются с кратных `rangesPerJob`, отсюда номер задачи.
+		auto processRanges = [&](uint32_t rangeBegin, uint32_t rangeEnd) {
+			JobScratch& scratch = m_jobScratch[rangeBegin / rangesPerJob];
+			scratch.nextWork.clear();
+			uint32_t changedBegin = UINT32_MAX;
+			uint32_t changedEnd = 0;
+			uint32_t changedCount = 0;
+
+			for (uint32_t r = rangeBegin; r < rangeEnd; ++r) {
+				for (uint32_t i = work[r].begin; i < work[r].end; ++i) {
+					m_flags[i] &= ~LocalDirty;
+
+					const LocalTransform& local = m_local[i];
+					const Mat4 localMatrix = Mat4::fromTRS(local.position, local.rotation, local.scale);
+					const uint32_t parent = m_parentIndex[i];
+					m_world[i] = parent == InvalidIndex ? localMatrix : multiplyAffine(m_world[parent], localMatrix);
+
+					if (m_childCount[i] > 0) {
+						scratch.nextWork.push_back({ m_firstChild[i], m_firstChild[i] + m_childCount[i] });
+					}
+
+					changedBegin = std::min(changedBegin, i);
+					changedEnd = std::max(changedEnd, i + 1);
+					++changedCount;
+				}
+			}
+
+			scratch.changedBegin = changedBegin;
+			scratch.changedEnd = changedEnd;
+			scratch.changedCount = changedCount;
+		};
+
+		if (bParallel) {
+			pJobSystem->parallelFor(rangeCount, rangesPerJob, processRanges);
+		}
+		else {
+			processRanges(0, rangeCount);
+		}
+
+		for (uint32_t job = 0; job < jobCount; ++job) {
+			const JobScratch& scratch = m_jobScratch[job];
+			if (pNextWork) {
+				pNextWork->insert(pNextWork->end(), scratch.nextWork.begin(), scratch.nextWork.end());
+			}
+			if (scratch.changedCount > 0) {
+				m_changedBegin = std::min(m_changedBegin, scratch.changedBegin);
+				m_changedEnd = std::max(m_changedEnd, scratch.changedEnd);
+				m_changedCount += scratch.changedCount;
+			}
+		}
+	}
+
+	void TransformHierarchy::update(JobSystem* pJobSystem) {
+		const bool bRebuilt = m_bNeedsRebuild;
+		if (m_bNeedsRebuild) {
+			rebuild();
+		}
+
+		m_changedBegin = UINT32_MAX;
+		m_changedEnd = 0;
+		m_changedCount = 0;
+
+		// Изменённые узлы распределяются по спискам работы своих уровней.
+		for (uint32_t index : m_dirtyIndices) {
+			const auto levelIt = std::upper_bound(m_levelOffsets.begin(), m_levelOffsets.end(), index);
+			const size_t level = static_cast<size_t>(levelIt - m_levelOffsets.begin()) - 1;
+			m_levelWork[level].push_back({ index, index + 1 });
+		}
+		m_dirtyIndices.clear();
+
+		// Уровни зависят друг от друга, поэтому обрабатываются строго по порядку.
+		const size_t levelCount = m_levelWork.size();
+		for (size_t level = 0; level < levelCount; ++level) {
+			std::vector<Range>& work = m_levelWork[level];
+			if (work.empty()) {
+				continue;
+			}
+
+			removeOverlaps(work);
+			std::vector<Range>* pNextWork = level + 1 < levelCount ? &m_levelWork[level + 1] : nullptr;
+			updateLevel(work, pNextWork, pJobSystem);
+			work.clear();
+		}
+
+		// После перестроения узлы сменили позиции, поэтому весь массив считается изменённым.
+		if (bRebuilt) {
+			m_changedBegin = 0;
+			m_changedEnd = getCount();
+		}
+		else if (m_changedCount == 0) {
+			m_changedBegin = 0;
+		}
+	}
+
+} // namespace Engine
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "EngineCore/Math.hpp"
+
+namespace Engine {
+
+	class JobSystem;
+
+	using TransformId = uint32_t;
+
+	/// @internal
+	/// @brief Идентификатор, обозначающий отсутствие узла (например, у корня нет родителя).
+	constexpr TransformId InvalidTransformId = UINT32_MAX;
+
+	/**
+	 * @internal
+	 * @brief Локальная трансформация узла относительно родителя.
+	 */
+	struct LocalTransform {
+		Vec3	position	{ 0.f, 0.f, 0.f };	///< Перенос.
+		Quat	rotation;						///< Вращение.
+		Vec3	scale		{ 1.f, 1.f, 1.f };	///< Масштаб.
+	};
+
+	/**
+	 * @internal
+	 * @brief Иерархия трансформаций с инкрементальным пересчётом мировых матриц.
+	 *
+	 * Узлы хранятся в плоских массивах (SoA), отсортированных по глубине:
+	 * все узлы одного уровня лежат подряд, родители всегда раньше детей,
+	 * а дети одного родителя - непрерывным диапазоном. Благодаря этому:
+	 * - Пересчитываются только изменённые узлы и их поддеревья; работа
+	 *   пропорциональна кол-ву изменений, а не размеру иерархии.
+	 * - Изменение распространяется вниз добавлением диапазона детей узла
+	 *   в список работы следующего уровня, без обхода поддеревьев.
+	 * - Узлы одного уровня независимы и обрабатываются параллельно (`JobSystem`).
+	 * - Мировые матрицы лежат непрерывно и готовы к загрузке в instance/uniform буфер.
+	 *
+	 * Пользователь работает со стабильными идентификаторами `TransformId`, а
+	 * позицию узла в массиве мировых матриц возвращает `getIndex()`. Позиции
+	 * меняются только после структурных изменений (создание, удаление, смена родителя).
+	 *
+	 * Пример использования
+	 * @code
+	 * TransformHierarchy hierarchy;
+	 * TransformId root = hierarchy.create();
+	 * TransformId child = hierarchy.create(root);
+	 *
+	 * hierarchy.setPosition(root, { 1.f, 0.f, 0.f });
+	 * hierarchy.update(&jobSystem);
+	 *
+	 * // Загрузка только изменившейся части массива.
+	 * if (hierarchy.getChangedCount() > 0) {
+	 *     uploadMatrices(
+	 *         hierarchy.getWorldMatrices() + hierarchy.getChangedBegin(),
+	 *         hierarchy.getChangedEnd() - hierarchy.getChangedBegin()
+	 *     );
+	 * }
+	 * @endcode
+	 */
+	class TransformHierarchy {
+	public:
+		TransformHierarchy()											= default;
+		TransformHierarchy(const TransformHierarchy&)					= delete;
+		TransformHierarchy& operator=(const TransformHierarchy&)		= delete;
+		TransformHierarchy(TransformHierarchy&&)						= default;
+		TransformHierarchy& operator=(TransformHierarchy&&)				= default;
+
+		/// @internal
+		/// @brief Резервирует память под `count` узлов.
+		void reserve(uint32_t count);
+
+		/// @internal
+		/// @brief Создаёт новый узел.
+		/// @param parent Родительский узел (`InvalidTransformId` - корневой узел).
+		/// @param local Начальная локальная трансформация.
+		/// @return Идентификатор узла.
+		TransformId create(
+			TransformId 			parent = InvalidTransformId,
+			const LocalTransform&	local = {}
+		);
+
+		/// @internal
+		/// @brief Удаляет узел вместе со всем его поддеревом.
+		/// @param id Идентификатор удаляемого узла.
+		void destroy(TransformId id);
+
+		/// @internal
+		/// @brief Меняет родителя узла.
+		/// @param id Идентификатор узла.
+		/// @param parent Новый родитель (`InvalidTransformId` - сделать узел корневым).
+		/// @return false, если смена родителя создала бы цикл.
+		bool setParent(TransformId id, TransformId parent);
+
+		void setLocal(TransformId id, const LocalTransform& local);
+		void setPosition(TransformId id, const Vec3& position);
+		void setRotation(TransformId id, const Quat& rotation);
+		void setScale(TransformId id, const Vec3& scale);
+
+		const LocalTransform& getLocal(TransformId id) const { return m_local[m_indexOf[id]]; }
+		const Mat4& getWorld(TransformId id) const { return m_world[m_indexOf[id]]; }
+		TransformId getParent(TransformId id) const;
+		bool isAlive(TransformId id) const noexcept;
+
+		/// @internal
+		/// @brief Пересчитывает мировые матрицы изменившихся узлов и их поддеревьев.
+		///
+		/// Уровни обрабатываются последовательно, узлы внутри уровня - параллельно,
+		/// если передан `pJobSystem` и объём работы на уровне достаточно велик.
+		///
+		/// @param pJobSystem Пул потоков для параллельного обновления (может быть nullptr).
+		void update(JobSystem* pJobSystem = nullptr);
+
+		/// @internal
+		/// @brief Возвращает позицию узла в массиве мировых матриц.
+		uint32_t getIndex(TransformId id) const { return m_indexOf[id]; }
+
+		/// @internal
+		/// @brief Возвращает непрерывный массив мировых матриц (по одной на узел).
+		const Mat4* getWorldMatrices() const noexcept { return m_world.data(); }
+
+		/// @internal
+		/// @brief Возвращает кол-во живых узлов.
+		uint32_t getCount() const noexcept { return static_cast<uint32_t>(m_world.size()); }
+
+		/// @internal
+		/// @brief Начало диапазона индексов, изменившихся при последнем `update()`.
+		uint32_t getChangedBegin() const noexcept { return m_changedBegin; }
+
+		/// @internal
+		/// @brief Конец (не включительно) диапазона индексов, изменившихся при последнем `update()`.
+		uint32_t getChangedEnd() const noexcept { return m_changedEnd; }
+
+		/// @internal
+		/// @brief Кол-во матриц, пересчитанных при последнем `update()`.
+		uint32_t getChangedCount() const noexcept { return m_changedCount; }
+
+	private:
+		enum EFlags : uint8_t {
+			LocalDirty		= 1 << 0,	///< Локальная трансформация изменена пользователем.
+			Removed			= 1 << 1	///< Узел удалён и будет выброшен при перестроении.
+		};
+
+		/// Диапазон позиций [begin, end), ожидающих пересчёта на одном уровне.
+		struct Range {
+			uint32_t begin;
+			uint32_t end;
+		};
+
+		/// Результат одной задачи `updateLevel()`. Задача пишет только в свой
+		/// элемент, поэтому блокировка не нужна, а списки переиспользуются между кадрами.
+		struct JobScratch {
+			std::vector<Range>	nextWork;
+			uint32_t			changedBegin	= UINT32_MAX;
+			uint32_t			changedEnd		= 0;
+			uint32_t			changedCount	= 0;
+		};
+
+		void markLocalDirty(TransformId id);
+		void rebuild();
+
+		/// Узел может попасть в работу уровня дважды: как изменённый и как ребёнок изменённого.
+		/// Сортирует диапазоны и убирает пересечения, чтобы каждый узел обрабатывала одна задача.
+		static void removeOverlaps(std::vector<Range>& work);
+		void updateLevel(const std::vector<Range>& work, std::vector<Range>* pNextWork, JobSystem* pJobSystem);
+
+		// Данные узлов в порядке обхода по уровням (индекс - позиция в массиве).
+		std::vector<uint32_t>		m_parentIndex;
+		std::vector<TransformId>	m_idAt;
+		std::vector<LocalTransform>	m_local;
+		std::vector<Mat4>			m_world;
+		std::vector<uint8_t>		m_flags;
+		std::vector<uint32_t>		m_firstChild;
+		std::vector<uint32_t>		m_childCount;
+
+		// Границы уровней: узлы глубины d лежат в [m_levelOffsets[d], m_levelOffsets[d + 1]).
+		std::vector<uint32_t>		m_levelOffsets;
+
+		// Позиции узлов, чья локальная трансформация изменилась с прошлого `update()`.
+		std::vector<uint32_t>		m_dirtyIndices;
+
+		// Списки работы по уровням (переиспользуются между кадрами).
+		std::vector<std::vector<Range>>	m_levelWork;
+
+		// Результаты задач обновления уровня (по одному на задачу `parallelFor`).
+		std::vector<JobScratch>		m_jobScratch;
+
+		// Отображение стабильного идентификатора в текущую позицию.
+		std::vector<uint32_t>		m_indexOf;
+		std::vector<TransformId>	m_freeIds;
+
+		uint32_t					m_changedBegin		= 0;
+		uint32_t					m_changedEnd		= 0;
+		uint32_t					m_changedCount		= 0;
+		bool						m_bNeedsRebuild		= false;
+	};
+
+} // namespace Engine
@@ -4,24 +4,46 @@
 #include <GLFW/glfw3.h>
 
 #include <imgui/imgui.h>
-#include <imgui/backends/imgui_impl_opengl3.h>
-#include <imgui/backends/imgui_impl_glfw.h>
 
+#include "EngineCore/Assets/AssetManager.hpp"
+#include "EngineCore/Core/JobSystem.hpp"
 #include "EngineCore/Event.hpp"
 #include "EngineCore/Log.hpp"
-
+#include "EngineCore/Memory/AllocationTracker.hpp"
+
+#include "EngineCore/Render/ClusteredLighting.hpp"
+#include "EngineCore/Render/DebugDraw.hpp"
+#include "EngineCore/Render/FrameCapture.hpp"
+#include "EngineCore/Render/FrameGraph.hpp"
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+#include "EngineCore/Render/OpenGL/GpuResourceRegistry.hpp"
 #include "EngineCore/Render/OpenGL/ShaderProgram.hpp"
 #include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
 #include "EngineCore/Render/OpenGL/VertexArray.hpp"
+#include "EngineCore/Render/OpenGL/VertexLayout.hpp"
+#include "EngineCore/Render/RenderStats.hpp"
+#include "EngineCore/Render/ShaderLibrary.hpp"
+#include "EngineCore/Render/SpriteBatch.hpp"
+#include "EngineCore/Render/TextureAtlas.hpp"
+#include "EngineCore/Render/TextureLoader.hpp"
+#include "EngineCore/Render/VertexQuantization.hpp"
 
 namespace Engine {
 
 	static bool s_glfwInitialized = false;
 
-	GLfloat points[] = {
-		-0.5f, -0.5f, 0.0f,		1.0f, 0.0f, 0.0f,
-		0.0f, 0.5f, 0.0f,		0.0f, 1.0f, 0.0f,
-		0.5f, -0.5f, 0.0f,		0.0f, 0.0f, 1.0f
+	/// Вершина треугольника: позиция и цвет в UNorm8x4 (16 байт).
+	struct ColorVertex {
+		GLfloat		position[3];
+		uint8_t		color[4];
+	};
+
+	template<>
+	struct VertexLayout<ColorVertex> {
+		static constexpr VertexAttribute attributes[] = {
+			ENGINE_VERTEX_ATTRIBUTE(ColorVertex, position,	ShaderDataType::Float3),
+			ENGINE_VERTEX_ATTRIBUTE(ColorVertex, color,		ShaderDataType::UNorm8x4)
+		};
 	};
 
 	GLfloat verteces[] = {
@@ -31,18 +53,18 @@ namespace Engine {
 	};
 
 	GLfloat colors[] = {
-		1.0f, 0.0f, 0.0f,
-		0.0f, 1.0f, 0.0f,
-		0.0f, 0.0f, 1.0f	
+		1.0f, 0.0f, 0.0f, 1.0f,
+		0.0f, 1.0f, 0.0f, 1.0f,
+		0.0f, 0.0f, 1.0f, 1.0f
 	};
 
 	const char* vertexShader = 
 	"#version 460\n"
 	"layout(location = 0) in vec3 vertex_position;\n"
-	"layout(location = 1) in vec3 vertex_color;\n"
+	"layout(location = 1) in vec4 vertex_color;\n"
 	"out vec3 color;\n"
 	"void main() {\n"
-	"	color = vertex_color;\n"
+	"	color = vertex_color.rgb;\n"
 	"	gl_Position = vec4(vertex_position, 1.0f);\n"
 	"}\n";
 
@@ -67,15 +89,7 @@ namespace Engine {
 			std::move(name)
 		})
 	{
-		int8_t resultCode = init();
-
-		// ImGui инициализация.
-		IMGUI_CHECKVERSION();
-		ImGui::CreateContext();
-		ImGui_ImplOpenGL3_Init();
-		ImGui_ImplGlfw_InitForOpenGL(m_id, true);
-
-		LOG_INFO("ImGui was successfully initialized");
+		m_bInitialized = init() == 0;
 	}
 
 	Window::~Window() {
@@ -99,6 +113,7 @@ namespace Engine {
         {
             LOG_CRIT("FAILED TO CREATE WINDOW {0}!!!", m_data.name);
             glfwTerminate();
+            s_glfwInitialized = false;
             return -1;
         }
 
@@ -109,6 +124,11 @@ namespace Engine {
         // Инициализация GLAD
         if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
             LOG_CRIT("FAILED TO LOAD GLAD!!!");
+            // Без функций OpenGL `shutdown()` не может освобождать GL объекты.
+            glfwDestroyWindow(m_id);
+            m_id = nullptr;
+            glfwTerminate();
+            s_glfwInitialized = false;
             return -1;
         }
         LOG_INFO("GLAD was successfully loaded!");
@@ -157,66 +177,193 @@ namespace Engine {
 			}
 		);
 
-		m_pShaderProgram = std::make_unique<ShaderProgram>(vertexShader, fragmentShader);
-		if (!m_pShaderProgram->isCompiled()) {
-			return -1;
-		}
+		const BufferLayout& layout = getBufferLayout<ColorVertex>();
+		ColorVertex triangle[3];
+		writeVertexAttribute(verteces, 3, layout.getElements()[0], triangle, sizeof(ColorVertex));
+		writeVertexAttribute(colors, 3, layout.getElements()[1], triangle, sizeof(ColorVertex));
 
-		BufferLayout bufferLayoutVerteces{
-			ShaderDataType::Float3,
-			ShaderDataType::Float3
-		};
+		m_VBO = std::make_unique<VertexBuffer>(triangle, 3);
 
-		m_VBO = std::make_unique<VertexBuffer>(
-			points, 
-			sizeof(points), 
-			bufferLayoutVerteces
-		);
+		m_VBO->setLabel("Triangle vertices");
 
 		m_VAO = std::make_unique<VertexArray>();
-		m_VAO->addBuffer(*m_VBO);
+		m_VAO->setVertexBuffer(m_VAO->addLayout<ColorVertex>(), *m_VBO);
+		m_VAO->setLabel("Triangle VAO");
+
+		m_pJobSystem = std::make_unique<JobSystem>();
+		m_pTextureLoader = std::make_unique<TextureLoader>(*m_pJobSystem);
+		m_pAssetManager = std::make_unique<AssetManager>(*m_pJobSystem, *m_pTextureLoader);
+		m_pFrameGraph = std::make_unique<FrameGraph>();
+		m_pFrameCapture = std::make_unique<FrameCapture>(*m_pJobSystem);
+#ifndef NDEBUG
+		DebugDraw::init();
+#endif
+
+		// Старт блокируется только на ресурсах, нужных первому кадру.
+		m_shaderProgram = m_pAssetManager->createShader(
+			"Default color program", vertexShader, fragmentShader, AssetPriority::Critical
+		);
+		m_pAssetManager->waitForCritical();
+		if (!m_shaderProgram.isReady()) {
+			return -1;
+		}
 
         return 0;
 	}
 	
 	void Window::update() {
-		glClearColor(m_bgColor[0], m_bgColor[1], m_bgColor[2], m_bgColor[3]);
-        glClear(GL_COLOR_BUFFER_BIT);
-
-		m_pShaderProgram->bind();
-		m_VAO->bind();
-		glDrawArrays(GL_TRIANGLES, 0, 3);
-
-		// Получаем структуру, хранящую информацию для работы ImGui
-		ImGuiIO& io = ImGui::GetIO();
-		
-		io.DisplaySize.x = static_cast<float>(getWidth());
-		io.DisplaySize.y = static_cast<float>(getHeight());
-
-		// Подготовка нового кадра OpenGL через ImGui
-		ImGui_ImplOpenGL3_NewFrame();
-		// Обработка событий ImGui
-		ImGui_ImplGlfw_NewFrame();
-		// Начало кадра
-		ImGui::NewFrame();
+		AllocationTracker::newFrame();
+		RenderStats::newFrame();
+		m_frameAllocator.beginFrame();
+		GpuResourceRegistry::update();
+		GpuDeletionQueue::update();
+		m_pAssetManager->update();
+		m_pTextureLoader->update();
+		// Варианты из манифеста компилируются по одному за кадр, а не при старте.
+		if (m_pShaderLibrary) {
+			m_pShaderLibrary->prewarm(1);
+		}
+
+		// Граф перестраивается только при изменении размера экрана.
+		int framebufferWidth = 0;
+		int framebufferHeight = 0;
+		glfwGetFramebufferSize(m_id, &framebufferWidth, &framebufferHeight);
+		if (static_cast<uint32_t>(framebufferWidth) != m_frameGraphWidth || static_cast<uint32_t>(framebufferHeight) != m_frameGraphHeight) {
+			buildFrameGraph(static_cast<uint32_t>(framebufferWidth), static_cast<uint32_t>(framebufferHeight));
+		}
+		m_pFrameGraph->execute();
+		// Захват до ImGui: в снимок попадает только сцена.
+		m_pFrameCapture->update(0, static_cast<uint32_t>(framebufferWidth), static_cast<uint32_t>(framebufferHeight));
+	}
 
+	void Window::drawImGuiPanels() {
 		ImGui::Begin("Выбор цвета фона");
 		ImGui::ColorEdit4("Цвет фона", m_bgColor);
 		ImGui::End();
 
-		// Отрисовка кадра 
-		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		AllocationTracker::drawImGuiPanel();
+		GpuResourceRegistry::drawImGuiPanel();
+		m_pTextureLoader->drawImGuiPanel();
+		if (m_pTextureAtlas) {
+			m_pTextureAtlas->drawImGuiPanel();
+		}
+		m_pAssetManager->drawImGuiPanel();
+		if (m_pShaderLibrary) {
+			m_pShaderLibrary->drawImGuiPanel();
+		}
+		if (m_pSpriteBatch) {
+			m_pSpriteBatch->drawImGuiPanel();
+		}
+		m_pFrameGraph->drawImGuiPanel();
+		m_pFrameCapture->drawImGuiPanel();
+		if (m_pClusteredLighting) {
+			m_pClusteredLighting->drawImGuiPanel();
+		}
+#ifndef NDEBUG
+		DebugDraw::drawImGuiPanel();
+#endif
+		RenderStats::drawImGuiOverlay();
+	}
+
+	TextureAtlas& Window::getTextureAtlas() {
+		if (!m_pTextureAtlas) {
+			m_pTextureAtlas = std::make_unique<TextureAtlas>();
+		}
+		return *m_pTextureAtlas;
+	}
+
+	ShaderLibrary& Window::getShaderLibrary() {
+		if (!m_pShaderLibrary) {
+			m_pShaderLibrary = std::make_unique<ShaderLibrary>();
+			m_pShaderLibrary->getPreprocessor().addVirtualFile("engine/atlas.glsl", TextureAtlas::ShaderSource);
+			m_pShaderLibrary->getPreprocessor().addVirtualFile("engine/clustered_lighting.glsl", ClusteredLighting::ShaderSource);
+		}
+		return *m_pShaderLibrary;
+	}
+
+	SpriteBatch& Window::getSpriteBatch() {
+		if (!m_pSpriteBatch) {
+			m_pSpriteBatch = std::make_unique<SpriteBatch>();
+		}
+		return *m_pSpriteBatch;
+	}
+
+	ClusteredLighting& Window::getClusteredLighting() {
+		if (!m_pClusteredLighting) {
+			m_pClusteredLighting = std::make_unique<ClusteredLighting>(LightClusterParams{}, m_pJobSystem.get());
+		}
+		return *m_pClusteredLighting;
+	}
 
+	void Window::present() {
 		glfwSwapBuffers(m_id);
 		glfwPollEvents();
 	}
 
+	void Window::buildFrameGraph(uint32_t width, uint32_t height) {
+		m_frameGraphWidth = width;
+		m_frameGraphHeight = height;
+
+		m_pFrameGraph->reset();
+		const FrameGraphResource backbuffer = m_pFrameGraph->importBackbuffer("Backbuffer", width, height);
+
+		FrameGraph::PassBuilder scene = m_pFrameGraph->addPass("Scene", [this](const FrameGraph&) {
+			glClearColor(m_bgColor[0], m_bgColor[1], m_bgColor[2], m_bgColor[3]);
+			glClear(GL_COLOR_BUFFER_BIT);
+
+			if (ShaderProgram* pProgram = m_shaderProgram.get()) {
+				pProgram->bind();
+				m_VAO->bind();
+				glDrawArrays(GL_TRIANGLES, 0, 3);
+				RenderStats::addDrawCall(3);
+			}
+
+#ifndef NDEBUG
+			DebugDraw::render(m_frameAllocator);
+#endif
+		});
+		scene.write(backbuffer);
+
+		m_pFrameGraph->compile();
+	}
+
 	
 
 	int8_t Window::shutdown() {
+		// Загрузчик освобождает GL объекты, поэтому уничтожается до контекста.
+		// Ссылки на ресурсы отпускаются до уничтожения менеджера.
+		m_shaderProgram.reset();
+		m_pAssetManager.reset();
+		if (m_pShaderLibrary) {
+			m_pShaderLibrary->saveManifest();
+		}
+		m_pShaderLibrary.reset();
+		m_pSpriteBatch.reset();
+		m_pFrameGraph.reset();
+		// Кадры в пути дописываются рабочими потоками, поэтому до JobSystem.
+		m_pFrameCapture.reset();
+		m_pClusteredLighting.reset();
+#ifndef NDEBUG
+		DebugDraw::shutdown();
+#endif
+		m_pTextureAtlas.reset();
+		m_pTextureLoader.reset();
+		m_pJobSystem.reset();
+
+		// Удаление GL объектов откладывается до конца кадра: очередь освобождается до контекста.
+		m_VAO.reset();
+		m_VBO.reset();
+
+		// Окна нет, если `init()` не дошёл до контекста OpenGL или `shutdown()` уже вызывался.
+		if (!m_id) {
+			return 0;
+		}
+		GpuDeletionQueue::flush();
+
 		glfwDestroyWindow(m_id);
+		m_id = nullptr;
 		glfwTerminate();
+		s_glfwInitialized = false;
 
 		return 0;
 	}
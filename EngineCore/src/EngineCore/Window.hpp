@@ -5,19 +5,26 @@
 #include <functional>
 #include <memory>
 
-
+#include "EngineCore/Assets/AssetManager.hpp"
+#include "EngineCore/Memory/FrameAllocator.hpp"
 
 struct GLFWwindow;
 
 namespace Engine {
 
+	class ClusteredLighting;
 	class Event;
-	class ShaderProgram;
+	class FrameCapture;
+	class FrameGraph;
+	class JobSystem;
+	class ShaderLibrary;
+	class SpriteBatch;
+	class TextureAtlas;
+	class TextureLoader;
 	class VertexBuffer;
 	class VertexArray;
 
 	using EventCallback 	= std::function<void(Event&)>;
-	using ShaderProgramPtr 	= std::unique_ptr<ShaderProgram>;
 	using VertexBufferPtr 	= std::unique_ptr<VertexBuffer>;
 	using VertexArrayPtr	= std::unique_ptr<VertexArray>;	
 
@@ -40,7 +47,8 @@ namespace Engine {
 	 * @brief Класс, представляющий окно приложения.
 	 * 
 	 * Класс `Window` инкапсулирует создание окна через GLFW,
-	 * управление его событиями, обработку интерфейса через ImGui.
+	 * управление его событиями и системы рендера. Интерфейс ImGui
+	 * рисуется отдельным слоем `ImGuiLayer`.
 	 * 
 	 * @note Копирование и перемещение запрещено.
 	 */
@@ -71,15 +79,45 @@ namespace Engine {
 		Window(Window&&)					= delete;		
 		Window& operator=(Window&&)			= delete;		
 
+		/**
+		 * @internal
+		 * @brief Созданы ли окно, контекст OpenGL и критичные ресурсы первого кадра.
+		 *
+		 * Если нет, окно нельзя обновлять: `Application::run()` завершается с ошибкой.
+		 */
+		bool isInitialized() const noexcept { return m_bInitialized; }
+
 		/**
 		 * @internal
 		 * @brief Обновляет окно.
 		 * 
-		 * Метод должен вызываться каждый кадр. Он выполняет необходимые настройки,
-		 * изменения, обработку событий окна.
+		 * Метод должен вызываться каждый кадр. Он обновляет системы движка
+		 * и рисует сцену в задний буфер; слои рисуются поверх до `present()`.
 		 */
 		void update();
 
+		/**
+		 * @internal
+		 * @brief Показывает кадр и обрабатывает события окна.
+		 *
+		 * События передаются в callback из `setEventCallback()` внутри этого вызова.
+		 */
+		void present();
+
+		/**
+		 * @internal
+		 * @brief Рисует ImGui панели систем движка.
+		 *
+		 * Вызывается слоем ImGui между `ImGui::NewFrame()` и `ImGui::Render()`.
+		 */
+		void drawImGuiPanels();
+
+		/**
+		 * @internal
+		 * @brief Возвращает окно GLFW.
+		 */
+		GLFWwindow* getNativeWindow() const noexcept { return m_id; }
+
 		/**
 		 * @internal
 		 * @brief Возвращает ширину окна в пикселях.
@@ -109,16 +147,101 @@ namespace Engine {
 		 */
 		void setEventCallback(const EventCallback& callback);
 
+		/**
+		 * @internal
+		 * @brief Возвращает аллокатор временных данных кадра.
+		 *
+		 * Память, выделенная из него, освобождается автоматически
+		 * через кадр в начале `update()`.
+		 */
+		FrameAllocator& getFrameAllocator() noexcept { return m_frameAllocator; }
+
+		/**
+		 * @internal
+		 * @brief Возвращает пул рабочих потоков движка.
+		 */
+		JobSystem& getJobSystem() noexcept { return *m_pJobSystem; }
+
+		/**
+		 * @internal
+		 * @brief Возвращает асинхронный загрузчик текстур.
+		 *
+		 * Загруженные данные передаются на GPU порциями в `update()`.
+		 */
+		TextureLoader& getTextureLoader() noexcept { return *m_pTextureLoader; }
+
+		/**
+		 * @internal
+		 * @brief Возвращает атлас текстур для объединения мелких текстур в батчи.
+		 *
+		 * Создаётся при первом вызове (только из потока с GL контекстом).
+		 */
+		TextureAtlas& getTextureAtlas();
+
+		/**
+		 * @internal
+		 * @brief Возвращает менеджер ресурсов (текстуры и шейдеры с общими ссылками).
+		 */
+		AssetManager& getAssetManager() noexcept { return *m_pAssetManager; }
+
+		/**
+		 * @internal
+		 * @brief Возвращает библиотеку шейдеров с вариантами.
+		 *
+		 * Создаётся при первом вызове вместе с `engine/atlas.glsl` и
+		 * `engine/clustered_lighting.glsl`; манифест прогревается с этого момента.
+		 */
+		ShaderLibrary& getShaderLibrary();
+
+		/**
+		 * @internal
+		 * @brief Возвращает пакетный рендер спрайтов (оверлеи, HUD).
+		 *
+		 * Создаётся при первом вызове, потоковый буфер выделяется только тогда.
+		 */
+		SpriteBatch& getSpriteBatch();
+
+		/**
+		 * @internal
+		 * @brief Возвращает захват кадров (снимки экрана, запись последовательности).
+		 */
+		FrameCapture& getFrameCapture() noexcept { return *m_pFrameCapture; }
+
+		/**
+		 * @internal
+		 * @brief Возвращает кластерное освещение точечными источниками.
+		 *
+		 * Шейдеры подключают `engine/clustered_lighting.glsl`, источники передаются
+		 * каждый кадр в `ClusteredLighting::update()`. Создаётся при первом вызове,
+		 * до этого SSBO кластеров не выделяются.
+		 */
+		ClusteredLighting& getClusteredLighting();
+
 	private:
 		int8_t init();
 		int8_t shutdown();
+		void buildFrameGraph(uint32_t width, uint32_t height);
 
 		GLFWwindow*			m_id 				= nullptr;
 		WindowData			m_data;
+		bool				m_bInitialized		= false;
 		float 				m_bgColor[4]		= {0.f, 0.f, 0.f, 1.f};
-		ShaderProgramPtr	m_pShaderProgram;
+		ShaderRef			m_shaderProgram;
 		VertexBufferPtr		m_VBO;		
 		VertexArrayPtr		m_VAO;	
+		FrameAllocator		m_frameAllocator;
+
+		std::unique_ptr<JobSystem>		m_pJobSystem;
+		std::unique_ptr<TextureLoader>	m_pTextureLoader;
+		std::unique_ptr<TextureAtlas>	m_pTextureAtlas;
+		std::unique_ptr<AssetManager>	m_pAssetManager;
+		std::unique_ptr<ShaderLibrary>	m_pShaderLibrary;
+		std::unique_ptr<SpriteBatch>	m_pSpriteBatch;
+		std::unique_ptr<FrameGraph>		m_pFrameGraph;
+		std::unique_ptr<FrameCapture>	m_pFrameCapture;
+		std::unique_ptr<ClusteredLighting>	m_pClusteredLighting;
+		uint32_t						m_frameGraphWidth	= 0;
+		uint32_t						m_frameGraphHeight	= 0;
 	};
 
 } // namespace Engine 
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <memory>
+#include <string>
 
 #include "EngineCore/Application.hpp"
 
@@ -13,9 +14,32 @@ private:
 	int m_frame = 0;
 };
 
-int main() {
+int main(int argc, char** argv) {
 	auto app = std::make_unique<App>();
 
+	// --record <file>, --replay <file>, --timings <file>
+	for (int i = 1; i < argc; ++i) {
+		const std::string option = argv[i];
+		if (i + 1 >= argc) {
+			std::cerr << "Option " << option << " requires a value" << std::endl;
+			return 1;
+		}
+		const char* value = argv[++i];
+		if (option == "--record") {
+			app->setInputRecording(value);
+		}
+		else if (option == "--replay") {
+			app->setInputReplay(value);
+		}
+		else if (option == "--timings") {
+			app->setFrameTimingDump(value);
+		}
+		else {
+			std::cerr << "Unknown option " << option << std::endl;
+			return 1;
+		}
+	}
+
 	int returnCode = app->run(600, 400, "Test");
 
 	return returnCode;
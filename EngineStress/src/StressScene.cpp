@@ -0,0 +1,219 @@
+#include "StressScene.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include <glad/glad.h>
+
+#include "EngineCore/Render/OpenGL/Framebuffer.hpp"
+#include "EngineCore/Render/OpenGL/ShaderProgram.hpp"
+#include "EngineCore/Render/OpenGL/VertexArray.hpp"
+#include "EngineCore/Render/OpenGL/VertexBuffer.hpp"
+#include "EngineCore/Render/OpenGL/VertexLayout.hpp"
+#include "EngineCore/Render/RenderStats.hpp"
+
+namespace Stress {
+
+	/// Вершина: позиция и цвет (16 байт).
+	struct StressVertex {
+		float		position[3];
+		uint8_t		color[4];
+	};
+
+} // namespace Stress
+
+namespace Engine {
+
+	template<>
+	struct VertexLayout<Stress::StressVertex> {
+		static constexpr VertexAttribute attributes[] = {
+			ENGINE_VERTEX_ATTRIBUTE(Stress::StressVertex, position,	ShaderDataType::Float3),
+			ENGINE_VERTEX_ATTRIBUTE(Stress::StressVertex, color,	ShaderDataType::UNorm8x4)
+		};
+	};
+
+} // namespace Engine
+
+namespace Stress {
+
+	using namespace Engine;
+	using Clock = std::chrono::steady_clock;
+
+	static const char* s_vertexShader =
+		"#version 430 core\n"
+		"layout(location = 0) in vec3 position;\n"
+		"layout(location = 1) in vec4 color;\n"
+		"layout(location = 0) uniform mat4 u_model;\n"
+		"out vec4 vColor;\n"
+		"void main() {\n"
+		"	vColor = color;\n"
+		"	gl_Position = u_model * vec4(position, 1.0);\n"
+		"}\n";
+
+	/// Программы различаются только константой, но для драйвера это разные программы.
+	static const char* s_fragmentShaderFormat =
+		"#version 430 core\n"
+		"in vec4 vColor;\n"
+		"out vec4 fragmentColor;\n"
+		"const vec3 tint = vec3(%.3f, %.3f, %.3f);\n"
+		"void main() {\n"
+		"	fragmentColor = vec4(vColor.rgb * tint, 1.0);\n"
+		"}\n";
+
+	/// Location uniform матрицы модели.
+	static constexpr int ModelLocation = 0;
+
+	static float getMs(const Clock::time_point start, const Clock::time_point end) noexcept {
+		return std::chrono::duration<float, std::milli>(end - start).count();
+	}
+
+	StressScene::StressScene(const StressSceneParams& params)
+		: m_params(params)
+	{
+		m_params.verticesPerObject = std::max<uint32_t>(params.verticesPerObject / 3 * 3, 3);
+		m_params.programCount = std::max<uint32_t>(params.programCount, 1);
+
+		FramebufferSpec spec;
+		spec.width = m_params.width;
+		spec.height = m_params.height;
+		spec.colorFormats = { GL_RGBA8 };
+		spec.depthFormat = GL_DEPTH24_STENCIL8;
+		spec.bResizeWithWindow = false;
+		m_pFramebuffer = std::make_unique<Framebuffer>(spec);
+		m_pFramebuffer->setLabel("Stress scene");
+
+		std::mt19937 random(m_params.seed);
+		std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+		m_programs.reserve(m_params.programCount);
+		for (uint32_t i = 0; i < m_params.programCount; ++i) {
+			char fragmentShader[512];
+			std::snprintf(fragmentShader, sizeof(fragmentShader), s_fragmentShaderFormat,
+				0.5f + 0.5f * unit(random), 0.5f + 0.5f * unit(random), 0.5f + 0.5f * unit(random));
+			m_programs.push_back(std::make_unique<ShaderProgram>(s_vertexShader, fragmentShader));
+			m_programs.back()->setLabel("Stress program " + std::to_string(i));
+		}
+
+		// Мелкие треугольники вокруг центра объекта: нагрузка на вершины, а не на заполнение.
+		std::vector<StressVertex> vertices(m_params.verticesPerObject);
+		m_objects.resize(m_params.objectCount);
+		for (uint32_t i = 0; i < m_params.objectCount; ++i) {
+			for (StressVertex& vertex : vertices) {
+				const float angle = unit(random) * 6.2831853f;
+				const float radius = 0.02f + 0.03f * unit(random);
+				vertex.position[0] = std::cos(angle) * radius;
+				vertex.position[1] = std::sin(angle) * radius;
+				vertex.position[2] = 0.f;
+				vertex.color[0] = static_cast<uint8_t>(unit(random) * 255.f);
+				vertex.color[1] = static_cast<uint8_t>(unit(random) * 255.f);
+				vertex.color[2] = static_cast<uint8_t>(unit(random) * 255.f);
+				vertex.color[3] = 255;
+			}
+
+			Object& object = m_objects[i];
+			object.pVertices = std::make_unique<VertexBuffer>(vertices.data(), vertices.size());
+			object.pVertexArray = std::make_unique<VertexArray>();
+			object.pVertexArray->addBuffer(*object.pVertices);
+			object.program = i % m_params.programCount;
+			object.position = { unit(random) * 1.9f - 0.95f, unit(random) * 1.9f - 0.95f, unit(random) };
+			object.angularSpeed = unit(random) * 4.f - 2.f;
+		}
+
+		// Группировка по программам: K привязок программ за кадр вместо N.
+		std::stable_sort(m_objects.begin(), m_objects.end(), [](const Object& lhs, const Object& rhs) {
+			return lhs.program < rhs.program;
+		});
+	}
+
+	StressScene::~StressScene() = default;
+
+	void StressScene::update(const float time) {
+		for (Object& object : m_objects) {
+			const Quat rotation = Quat::fromAxisAngle({ 0.f, 0.f, 1.f }, object.angularSpeed * time);
+			object.model = Mat4::fromTRS(object.position, rotation, { 1.f, 1.f, 1.f });
+		}
+	}
+
+	void StressScene::submit() {
+		m_pFramebuffer->bind();
+		glEnable(GL_DEPTH_TEST);
+		glClearColor(0.05f, 0.05f, 0.08f, 1.f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		uint32_t boundProgram = UINT32_MAX;
+		for (const Object& object : m_objects) {
+			const ShaderProgram& program = *m_programs[object.program];
+			if (object.program != boundProgram) {
+				program.bind();
+				boundProgram = object.program;
+			}
+			program.setMatrix4(ModelLocation, object.model.data());
+			object.pVertexArray->bind();
+			glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_params.verticesPerObject));
+			RenderStats::addDrawCall(m_params.verticesPerObject);
+		}
+
+		VertexArray::unbind();
+		ShaderProgram::unbind();
+		glDisable(GL_DEPTH_TEST);
+		Framebuffer::bindDefault();
+	}
+
+	StressResult StressScene::run() {
+		StressResult result;
+		result.params = m_params;
+
+		FrameTimingLog log(m_params.frameCount);
+		double updateMs = 0.0;
+		double submitMs = 0.0;
+		double gpuWaitMs = 0.0;
+
+		const uint32_t totalFrames = m_params.warmupFrames + m_params.frameCount;
+		for (uint32_t frame = 0; frame < totalFrames; ++frame) {
+			RenderStats::newFrame();
+
+			// Фиксированный шаг времени: каждый прогон рисует одинаковые кадры.
+			const Clock::time_point frameStart = Clock::now();
+			update(static_cast<float>(frame) / 60.f);
+			const Clock::time_point updateEnd = Clock::now();
+			submit();
+			const Clock::time_point submitEnd = Clock::now();
+			glFinish();
+			const Clock::time_point frameEnd = Clock::now();
+
+			if (frame < m_params.warmupFrames) {
+				continue;
+			}
+
+			FrameTiming timing;
+			timing.frameIndex = frame - m_params.warmupFrames;
+			timing.frameMs = getMs(frameStart, frameEnd);
+			timing.windowMs = getMs(updateEnd, frameEnd);
+			timing.updateMs = getMs(frameStart, updateEnd);
+			log.addFrame(timing);
+
+			updateMs += timing.updateMs;
+			submitMs += getMs(updateEnd, submitEnd);
+			gpuWaitMs += getMs(submitEnd, frameEnd);
+		}
+		// Завершает счётчики последнего кадра.
+		RenderStats::newFrame();
+
+		const RenderFrameStats& stats = RenderStats::getLastFrameStats();
+		const double frames = static_cast<double>(std::max<uint32_t>(m_params.frameCount, 1));
+		result.frame = log.getSummary();
+		result.updateMs = static_cast<float>(updateMs / frames);
+		result.submitMs = static_cast<float>(submitMs / frames);
+		result.gpuWaitMs = static_cast<float>(gpuWaitMs / frames);
+		result.drawCalls = stats.drawCalls;
+		result.programBinds = stats.programBinds;
+		result.vertexArrayBinds = stats.vertexArrayBinds;
+		result.vertices = stats.vertices;
+		return result;
+	}
+
+} // namespace Stress
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "EngineCore/Core/FrameTimingLog.hpp"
+#include "EngineCore/Math.hpp"
+
+namespace Engine {
+	class Framebuffer;
+	class ShaderProgram;
+	class VertexArray;
+	class VertexBuffer;
+}
+
+namespace Stress {
+
+	/**
+	 * @brief Параметры сцены: N объектов x M вершин x K шейдерных программ.
+	 */
+	struct StressSceneParams {
+		uint32_t	objectCount			= 1000;		///< N
+		uint32_t	verticesPerObject	= 300;		///< M (округляется вниз до кратного 3)
+		uint32_t	programCount		= 8;		///< K
+		uint32_t	frameCount			= 300;		///< Измеряемых кадров.
+		uint32_t	warmupFrames		= 30;		///< Кадров до начала измерений.
+		uint32_t	width				= 1280;		///< Размер offscreen FBO.
+		uint32_t	height				= 720;
+		uint32_t	seed				= 1;		///< Генерация сцены детерминирована.
+	};
+
+	/**
+	 * @brief Результат прогона сцены.
+	 *
+	 * Времена подсистем - среднее за кадр на CPU. `gpuWaitMs` - ожидание
+	 * `glFinish()` в конце кадра, т.е. работа GPU, не скрытая за CPU.
+	 */
+	struct StressResult {
+		StressSceneParams			params;
+		Engine::FrameTimingSummary	frame;
+		float						updateMs			= 0.f;	///< Анимация и матрицы объектов.
+		float						submitMs			= 0.f;	///< Вызовы OpenGL отрисовки.
+		float						gpuWaitMs			= 0.f;	///< Ожидание GPU.
+		uint32_t					drawCalls			= 0;	///< За кадр.
+		uint32_t					programBinds		= 0;
+		uint32_t					vertexArrayBinds	= 0;
+		uint64_t					vertices			= 0;
+
+		/// @brief Вершин в миллисекунду по медиане времени кадра.
+		double getThroughput() const noexcept { return frame.p50Ms > 0.f ? static_cast<double>(vertices) / frame.p50Ms : 0.0; }
+	};
+
+	/**
+	 * @brief Процедурная сцена для нагрузочного теста пути отрисовки.
+	 *
+	 * Каждый объект - отдельные VBO и VAO из M вершин (случайные треугольники)
+	 * и одна из K программ, отличающихся константой цвета. Объекты сгруппированы
+	 * по программам, поэтому за кадр выполняется K привязок программ и N привязок VAO.
+	 * Кадры рисуются в offscreen `Framebuffer`, и результат не зависит от окна.
+	 *
+	 * @note Требует текущий контекст OpenGL 4.3+ (явные location uniform).
+	 */
+	class StressScene {
+	public:
+		explicit StressScene(const StressSceneParams& params);
+		~StressScene();
+
+		StressScene(const StressScene&)				= delete;
+		StressScene& operator=(const StressScene&)	= delete;
+
+		/// @brief Рисует `warmupFrames + frameCount` кадров и возвращает статистику.
+		StressResult run();
+
+	private:
+		struct Object {
+			std::unique_ptr<Engine::VertexBuffer>	pVertices;
+			std::unique_ptr<Engine::VertexArray>	pVertexArray;
+			uint32_t								program			= 0;
+			Engine::Vec3							position;
+			float									angularSpeed	= 0.f;
+			Engine::Mat4							model;
+		};
+
+		void update(float time);
+		void submit();
+
+		StressSceneParams								m_params;
+		std::unique_ptr<Engine::Framebuffer>			m_pFramebuffer;
+		std::vector<std::unique_ptr<Engine::ShaderProgram>>	m_programs;
+		std::vector<Object>								m_objects;
+	};
+
+} // namespace Stress
@@ -0,0 +1,290 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "EngineCore/Core/JsonWriter.hpp"
+#include "EngineCore/Render/OpenGL/GpuDeletionQueue.hpp"
+
+#include "StressScene.hpp"
+
+/**
+ * Нагрузочный тест пути отрисовки.
+ *
+ * Параметры:
+ *   --objects <n[,n...]>   число объектов; список задаёт серию прогонов (по умолчанию 1000)
+ *   --vertices <m>         вершин на объект (по умолчанию 300)
+ *   --programs <k>         шейдерных программ (по умолчанию 8)
+ *   --frames <f>           измеряемых кадров (по умолчанию 300)
+ *   --json <file>          записать результаты в JSON
+ *   --save-baseline <file> сохранить результаты как эталон
+ *   --baseline <file>      сравнить с эталоном, код возврата 2 при регрессии,
+ *                          1 - если для сцены нет строки в эталоне
+ *   --threshold <x>        допустимый рост p50/p95/p99 относительно эталона (по умолчанию 0.1)
+ *
+ * Кадры рисуются в FBO скрытого окна. На машине без GPU:
+ * `LIBGL_ALWAYS_SOFTWARE=1 xvfb-run EngineStress --objects 100,1000,10000`.
+ */
+
+/// Строка эталона: параметры сцены и времена кадра.
+struct BaselineEntry {
+	uint32_t	objects		= 0;
+	uint32_t	vertices	= 0;
+	uint32_t	programs	= 0;
+	float		p50Ms		= 0.f;
+	float		p95Ms		= 0.f;
+	float		p99Ms		= 0.f;
+};
+
+static std::vector<uint32_t> parseList(const std::string& text) {
+	std::vector<uint32_t> values;
+	std::stringstream stream(text);
+	std::string item;
+	while (std::getline(stream, item, ',')) {
+		values.push_back(static_cast<uint32_t>(std::strtoul(item.c_str(), nullptr, 10)));
+	}
+	return values;
+}
+
+/// Эталон - текст по строке на сцену: удобно хранить в репозитории и сравнивать в diff.
+static bool saveBaseline(const std::string& path, const std::vector<Stress::StressResult>& results) {
+	std::ofstream file(path);
+	if (!file) {
+		std::fprintf(stderr, "Can not create %s\n", path.c_str());
+		return false;
+	}
+	file << "# objects vertices programs p50Ms p95Ms p99Ms\n";
+	for (const Stress::StressResult& result : results) {
+		file << result.params.objectCount << ' ' << result.params.verticesPerObject << ' ' << result.params.programCount << ' '
+			<< result.frame.p50Ms << ' ' << result.frame.p95Ms << ' ' << result.frame.p99Ms << '\n';
+	}
+	return true;
+}
+
+static bool loadBaseline(const std::string& path, std::vector<BaselineEntry>& entries) {
+	std::ifstream file(path);
+	if (!file) {
+		std::fprintf(stderr, "Can not open %s\n", path.c_str());
+		return false;
+	}
+	std::string line;
+	while (std::getline(file, line)) {
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+		BaselineEntry entry;
+		std::stringstream stream(line);
+		if (stream >> entry.objects >> entry.vertices >> entry.programs >> entry.p50Ms >> entry.p95Ms >> entry.p99Ms) {
+			entries.push_back(entry);
+		}
+	}
+	return true;
+}
+
+/// @param [out] missing Число сцен без строки в эталоне.
+/// @return Число регрессий.
+static uint32_t compareWithBaseline(
+	const std::vector<Stress::StressResult>& results,
+	const std::vector<BaselineEntry>& baseline,
+	const float threshold,
+	uint32_t& missing
+) {
+	uint32_t regressions = 0;
+	missing = 0;
+	for (const Stress::StressResult& result : results) {
+		const Stress::StressSceneParams& params = result.params;
+		const BaselineEntry* pEntry = nullptr;
+		for (const BaselineEntry& entry : baseline) {
+			if (entry.objects == params.objectCount && entry.vertices == params.verticesPerObject && entry.programs == params.programCount) {
+				pEntry = &entry;
+				break;
+			}
+		}
+		if (!pEntry) {
+			std::printf("N=%u vertices=%u programs=%u: no baseline entry\n",
+				params.objectCount, params.verticesPerObject, params.programCount);
+			++missing;
+			continue;
+		}
+
+		const auto check = [&](const char* name, const float value, const float reference) {
+			const float limit = reference * (1.f + threshold);
+			const bool bRegressed = value > limit;
+			std::printf("N=%u %s: %.3f ms, baseline %.3f ms (%+.1f%%)%s\n",
+				params.objectCount, name, value, reference,
+				reference > 0.f ? (value / reference - 1.f) * 100.f : 0.f,
+				bRegressed ? "  REGRESSION" : "");
+			regressions += bRegressed ? 1 : 0;
+		};
+		check("p50", result.frame.p50Ms, pEntry->p50Ms);
+		check("p95", result.frame.p95Ms, pEntry->p95Ms);
+		check("p99", result.frame.p99Ms, pEntry->p99Ms);
+	}
+	return regressions;
+}
+
+static bool writeJson(const std::string& path, const std::vector<Stress::StressResult>& results) {
+	std::ofstream file(path);
+	if (!file) {
+		std::fprintf(stderr, "Can not create %s\n", path.c_str());
+		return false;
+	}
+
+	Engine::JsonWriter json(file);
+	json.beginObject();
+	json.key("glRenderer").value(reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+	json.key("scenes").beginArray();
+	for (const Stress::StressResult& result : results) {
+		json.beginObject();
+		json.key("objects").value(result.params.objectCount);
+		json.key("vertices").value(result.params.verticesPerObject);
+		json.key("programs").value(result.params.programCount);
+		json.key("frames").value(result.frame.frameCount);
+		json.key("averageMs").value(static_cast<double>(result.frame.averageMs));
+		json.key("p50Ms").value(static_cast<double>(result.frame.p50Ms));
+		json.key("p95Ms").value(static_cast<double>(result.frame.p95Ms));
+		json.key("p99Ms").value(static_cast<double>(result.frame.p99Ms));
+		json.key("maxMs").value(static_cast<double>(result.frame.maxMs));
+		json.key("updateMs").value(static_cast<double>(result.updateMs));
+		json.key("submitMs").value(static_cast<double>(result.submitMs));
+		json.key("gpuWaitMs").value(static_cast<double>(result.gpuWaitMs));
+		json.key("drawCalls").value(result.drawCalls);
+		json.key("programBinds").value(result.programBinds);
+		json.key("vertexArrayBinds").value(result.vertexArrayBinds);
+		json.key("verticesPerFrame").value(result.vertices);
+		json.key("verticesPerMs").value(result.getThroughput());
+		json.endObject();
+	}
+	json.endArray();
+	json.endObject();
+	file << '\n';
+	return true;
+}
+
+int main(int argc, char** argv) {
+	Stress::StressSceneParams params;
+	std::vector<uint32_t> objectCounts = { params.objectCount };
+	std::string jsonPath;
+	std::string baselinePath;
+	std::string saveBaselinePath;
+	float threshold = 0.1f;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string option = argv[i];
+		if (i + 1 >= argc) {
+			std::fprintf(stderr, "Option %s requires a value\n", option.c_str());
+			return 1;
+		}
+		const char* value = argv[++i];
+		if (option == "--objects") {
+			objectCounts = parseList(value);
+		}
+		else if (option == "--vertices") {
+			params.verticesPerObject = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+		}
+		else if (option == "--programs") {
+			params.programCount = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+		}
+		else if (option == "--frames") {
+			params.frameCount = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+		}
+		else if (option == "--json") {
+			jsonPath = value;
+		}
+		else if (option == "--baseline") {
+			baselinePath = value;
+		}
+		else if (option == "--save-baseline") {
+			saveBaselinePath = value;
+		}
+		else if (option == "--threshold") {
+			threshold = std::strtof(value, nullptr);
+		}
+		else {
+			std::fprintf(stderr, "Unknown option %s\n", option.c_str());
+			return 1;
+		}
+	}
+
+	if (!glfwInit()) {
+		std::fprintf(stderr, "Failed to initialize GLFW\n");
+		return 1;
+	}
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	GLFWwindow* pWindow = glfwCreateWindow(64, 64, "EngineStress", nullptr, nullptr);
+	if (!pWindow) {
+		std::fprintf(stderr, "Failed to create an OpenGL context\n");
+		glfwTerminate();
+		return 1;
+	}
+	glfwMakeContextCurrent(pWindow);
+	glfwSwapInterval(0);
+	if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress))) {
+		std::fprintf(stderr, "Failed to load OpenGL\n");
+		glfwDestroyWindow(pWindow);
+		glfwTerminate();
+		return 1;
+	}
+	std::printf("%s\n\n", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+
+	std::printf("%8s %8s %6s %9s %9s %9s %9s %9s %9s %7s %7s %12s\n",
+		"Objects", "Vertices", "Progs", "p50 ms", "p95 ms", "p99 ms", "update", "submit", "gpu wait", "draws", "binds", "Mverts/s");
+
+	std::vector<Stress::StressResult> results;
+	double peakThroughput = 0.0;
+	for (const uint32_t objectCount : objectCounts) {
+		params.objectCount = objectCount;
+		Stress::StressResult result;
+		{
+			Stress::StressScene scene(params);
+			result = scene.run();
+		}
+		// Объекты сцены удаляются до следующего прогона, чтобы не влиять на его время.
+		Engine::GpuDeletionQueue::flush();
+		results.push_back(result);
+
+		const double throughput = result.getThroughput();
+		std::printf("%8u %8u %6u %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %7u %7u %12.2f%s\n",
+			result.params.objectCount, result.params.verticesPerObject, result.params.programCount,
+			result.frame.p50Ms, result.frame.p95Ms, result.frame.p99Ms,
+			result.updateMs, result.submitMs, result.gpuWaitMs,
+			result.drawCalls, result.programBinds + result.vertexArrayBinds, throughput / 1000.0,
+			// Спад пропускной способности: дальше рост N упирается в CPU или GPU.
+			peakThroughput > 0.0 && throughput < peakThroughput * 0.75 ? "  <- drop-off" : "");
+		peakThroughput = std::max(peakThroughput, throughput);
+	}
+
+	int exitCode = 0;
+	if (!jsonPath.empty() && !writeJson(jsonPath, results)) {
+		exitCode = 1;
+	}
+	if (!saveBaselinePath.empty() && !saveBaseline(saveBaselinePath, results)) {
+		exitCode = 1;
+	}
+	if (!baselinePath.empty()) {
+		std::vector<BaselineEntry> baseline;
+		uint32_t missing = 0;
+		if (!loadBaseline(baselinePath, baseline)) {
+			exitCode = 1;
+		}
+		else if (compareWithBaseline(results, baseline, threshold, missing) > 0) {
+			std::printf("Frame time regressed by more than %.0f%%\n", threshold * 100.f);
+			exitCode = 2;
+		}
+		// Сцена без эталона не проверена: это ошибка, а не успешное сравнение.
+		if (missing > 0) {
+			std::printf("%u scene(s) have no baseline entry in %s\n", missing, baselinePath.c_str());
+			exitCode = std::max(exitCode, 1);
+		}
+	}
+
+	glfwDestroyWindow(pWindow);
+	glfwTerminate();
+	return exitCode;
+}